@@ -0,0 +1,338 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "Capture/Rship2110FramePool.h"
+#include "Rship2110.h"
+
+namespace
+{
+    /** Frames are page aligned so transmitters and NIC registration can use them directly */
+    constexpr uint32 FrameAlignment = 4096;
+
+    /** Raw frames carry 4-byte pixels (8-bit RGBA/BGRA, 10:10:10:2) */
+    constexpr int32 RawBytesPerPixel = 4;
+}
+
+// ============================================================================
+// FRAME REFERENCE
+// ============================================================================
+
+FRship2110FrameRef::FRship2110FrameRef(FRship2110FramePoolRef InPool, int32 InIndex)
+    : Pool(MoveTemp(InPool))
+    , Index(InIndex)
+{
+}
+
+FRship2110FrameRef::FRship2110FrameRef(const FRship2110FrameRef& Other)
+    : Pool(Other.Pool)
+    , Index(Other.Index)
+{
+    if (IsValid())
+    {
+        Pool->AddRef(Index);
+    }
+}
+
+FRship2110FrameRef::FRship2110FrameRef(FRship2110FrameRef&& Other)
+    : Pool(MoveTemp(Other.Pool))
+    , Index(Other.Index)
+{
+    Other.Pool.Reset();
+    Other.Index = INDEX_NONE;
+}
+
+FRship2110FrameRef& FRship2110FrameRef::operator=(const FRship2110FrameRef& Other)
+{
+    if (this != &Other)
+    {
+        // Take the new reference first; Other may be the last holder of our frame
+        if (Other.IsValid())
+        {
+            Other.Pool->AddRef(Other.Index);
+        }
+        Release();
+        Pool = Other.Pool;
+        Index = Other.Index;
+    }
+    return *this;
+}
+
+FRship2110FrameRef& FRship2110FrameRef::operator=(FRship2110FrameRef&& Other)
+{
+    if (this != &Other)
+    {
+        Release();
+        Pool = MoveTemp(Other.Pool);
+        Index = Other.Index;
+        Other.Pool.Reset();
+        Other.Index = INDEX_NONE;
+    }
+    return *this;
+}
+
+void FRship2110FrameRef::Release()
+{
+    if (IsValid())
+    {
+        Pool->Release(Index);
+        Pool.Reset();
+        Index = INDEX_NONE;
+    }
+}
+
+uint8* FRship2110FrameRef::GetData() const
+{
+    return IsValid() ? Pool->Frames[Index].Data : nullptr;
+}
+
+int64 FRship2110FrameRef::GetSize() const
+{
+    return IsValid() ? Pool->FrameBytes : 0;
+}
+
+const FRshipPTPTimestamp& FRship2110FrameRef::GetTimestamp() const
+{
+    static const FRshipPTPTimestamp Empty;
+    return IsValid() ? Pool->Frames[Index].Timestamp : Empty;
+}
+
+void FRship2110FrameRef::SetTimestamp(const FRshipPTPTimestamp& InTimestamp)
+{
+    if (IsValid())
+    {
+        Pool->Frames[Index].Timestamp = InTimestamp;
+    }
+}
+
+int32 FRship2110FrameRef::GetRefCount() const
+{
+    return IsValid() ? Pool->Frames[Index].RefCount.load(std::memory_order_acquire) : 0;
+}
+
+// ============================================================================
+// FRAME POOL
+// ============================================================================
+
+FRship2110FramePoolRef FRship2110FramePool::Create(int32 NumFrames, int64 FrameBytes)
+{
+    return MakeShareable(new FRship2110FramePool(FMath::Max(NumFrames, 1), FMath::Max<int64>(FrameBytes, 0)));
+}
+
+FRship2110FramePool::FRship2110FramePool(int32 InNumFrames, int64 InFrameBytes)
+    : Frames(MakeUnique<FFrame[]>(InNumFrames))
+    , NumFrames(InNumFrames)
+    , FrameBytes(InFrameBytes)
+{
+    FreeFrames.Reserve(NumFrames);
+    for (int32 i = NumFrames - 1; i >= 0; --i)
+    {
+        Frames[i].Data = static_cast<uint8*>(FMemory::Malloc(FMath::Max<SIZE_T>(FrameBytes, 1), FrameAlignment));
+        FreeFrames.Add(i);
+    }
+
+    UE_LOG(LogRship2110, Verbose, TEXT("FramePool: Allocated %d frames, %lld bytes each"), NumFrames, FrameBytes);
+}
+
+FRship2110FramePool::~FRship2110FramePool()
+{
+    // Every handle holds the pool, so nothing can still reference a frame here
+    for (int32 i = 0; i < NumFrames; ++i)
+    {
+        check(Frames[i].RefCount.load(std::memory_order_relaxed) == 0);
+        FMemory::Free(Frames[i].Data);
+        Frames[i].Data = nullptr;
+    }
+}
+
+FRship2110FrameRef FRship2110FramePool::Acquire()
+{
+    int32 FrameIndex = INDEX_NONE;
+    {
+        FScopeLock Lock(&FreeLock);
+        if (FreeFrames.Num() > 0)
+        {
+            FrameIndex = FreeFrames.Pop(EAllowShrinking::No);
+        }
+    }
+
+    if (FrameIndex == INDEX_NONE)
+    {
+        AcquireFailures.fetch_add(1, std::memory_order_relaxed);
+        return FRship2110FrameRef();
+    }
+
+    FFrame& Frame = Frames[FrameIndex];
+    Frame.RefCount.store(1, std::memory_order_relaxed);
+    Frame.Timestamp = FRshipPTPTimestamp();
+    return FRship2110FrameRef(AsShared(), FrameIndex);
+}
+
+int32 FRship2110FramePool::GetNumFree() const
+{
+    FScopeLock Lock(&FreeLock);
+    return FreeFrames.Num();
+}
+
+void FRship2110FramePool::AddRef(int32 FrameIndex)
+{
+    Frames[FrameIndex].RefCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FRship2110FramePool::Release(int32 FrameIndex)
+{
+    // Release ordering publishes this holder's reads and writes before the frame is reused
+    const int32 Previous = Frames[FrameIndex].RefCount.fetch_sub(1, std::memory_order_acq_rel);
+    check(Previous > 0);
+    if (Previous == 1)
+    {
+        FScopeLock Lock(&FreeLock);
+        FreeFrames.Add(FrameIndex);
+    }
+}
+
+// ============================================================================
+// READBACK RING
+// ============================================================================
+
+bool FRship2110ReadbackRing::Configure(TSharedPtr<IRship2110ReadbackSource, ESPMode::ThreadSafe> InSource,
+                                       const FRship2110VideoFormat& Format, int32 NumFrames, bool bPack)
+{
+    Reset();
+
+    if (!InSource.IsValid() || InSource->GetNumSlots() <= 0)
+    {
+        return false;
+    }
+
+    VideoFormat = Format;
+    bPackFrames = bPack;
+    if (bPackFrames)
+    {
+        if (!PixelConverter.Configure(Format))
+        {
+            return false;
+        }
+        FrameBytes = PixelConverter.GetFrameBytes();
+    }
+    else
+    {
+        FrameBytes = static_cast<int64>(Format.Width) * Format.Height * RawBytesPerPixel;
+    }
+
+    Source = MoveTemp(InSource);
+    Pool = FRship2110FramePool::Create(NumFrames, FrameBytes);
+    InFlight.Reserve(Source->GetNumSlots());
+
+    return true;
+}
+
+void FRship2110ReadbackRing::Reset()
+{
+    Source.Reset();
+    Pool.Reset();
+    InFlight.Reset();
+    NextSlot = 0;
+    FrameBytes = 0;
+}
+
+void FRship2110ReadbackRing::SetPoolSize(int32 NumFrames)
+{
+    if (Pool.IsValid() && Pool->GetNumFrames() != NumFrames)
+    {
+        Pool = FRship2110FramePool::Create(NumFrames, FrameBytes);
+    }
+}
+
+bool FRship2110ReadbackRing::Submit(const FRshipPTPTimestamp& Timestamp, TFunctionRef<bool(int32)> IssueCopy)
+{
+    if (!Source.IsValid())
+    {
+        return false;
+    }
+
+    if (InFlight.Num() >= Source->GetNumSlots())
+    {
+        RingFullDrops++;
+        return false;
+    }
+
+    const int32 Slot = NextSlot;
+    if (!IssueCopy(Slot))
+    {
+        return false;
+    }
+
+    FInFlight& Entry = InFlight.AddDefaulted_GetRef();
+    Entry.Slot = Slot;
+    Entry.Timestamp = Timestamp;
+    NextSlot = (NextSlot + 1) % Source->GetNumSlots();
+
+    return true;
+}
+
+int32 FRship2110ReadbackRing::Poll(TFunctionRef<void(int32, FRship2110FrameRef&&)> OnFrame)
+{
+    if (!Source.IsValid())
+    {
+        return 0;
+    }
+
+    int32 Completed = 0;
+    int32 Consumed = 0;
+
+    // Copies land in the order they were issued; stop at the first still in flight
+    while (Consumed < InFlight.Num() && Source->IsReady(InFlight[Consumed].Slot))
+    {
+        const FInFlight Entry = InFlight[Consumed++];
+
+        FRship2110FrameRef Frame = Pool->Acquire();
+        if (!Frame.IsValid())
+        {
+            PoolEmptyDrops++;
+            continue;
+        }
+
+        if (!ReadSlot(Entry.Slot, Frame.GetData()))
+        {
+            continue;
+        }
+
+        Frame.SetTimestamp(Entry.Timestamp);
+        FramesCompleted++;
+        Completed++;
+        OnFrame(Entry.Slot, MoveTemp(Frame));
+    }
+
+    InFlight.RemoveAt(0, Consumed, EAllowShrinking::No);
+    return Completed;
+}
+
+bool FRship2110ReadbackRing::ReadSlot(int32 Slot, uint8* Dest)
+{
+    int32 Stride = 0;
+    ERship2110PixelInput Input = ERship2110PixelInput::BGRA8;
+    const void* Pixels = Source->Lock(Slot, Stride, Input);
+    if (!Pixels)
+    {
+        return false;
+    }
+
+    bool bRead = false;
+    if (bPackFrames)
+    {
+        bRead = PixelConverter.ConvertFrame(Pixels, Input, Stride, Dest);
+    }
+    else if (FRship2110PixelConverter::GetInputBytesPerPixel(Input) == RawBytesPerPixel)
+    {
+        const int32 LineBytes = VideoFormat.Width * RawBytesPerPixel;
+        const int32 SourceStride = Stride > 0 ? Stride : LineBytes;
+        for (int32 Line = 0; Line < VideoFormat.Height; ++Line)
+        {
+            FMemory::Memcpy(Dest + static_cast<int64>(Line) * LineBytes,
+                            static_cast<const uint8*>(Pixels) + static_cast<int64>(Line) * SourceStride, LineBytes);
+        }
+        bRead = true;
+    }
+
+    Source->Unlock(Slot);
+    return bRead;
+}
@@ -0,0 +1,97 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "Capture/Rship2110GPUReadback.h"
+#include "Rship2110.h"
+#include "RHIGPUReadback.h"
+
+FRship2110GPUReadbackSource::FRship2110GPUReadbackSource(int32 NumSlots)
+{
+    Slots.SetNum(FMath::Max(NumSlots, 1));
+    for (int32 i = 0; i < Slots.Num(); ++i)
+    {
+        Slots[i].Readback = MakeUnique<FRHIGPUTextureReadback>(*FString::Printf(TEXT("Rship2110Readback%d"), i));
+    }
+}
+
+FRship2110GPUReadbackSource::~FRship2110GPUReadbackSource()
+{
+}
+
+bool FRship2110GPUReadbackSource::EnqueueCopy(FRHICommandListImmediate& RHICmdList, FRHITexture* Texture, int32 Slot, FIntPoint ExpectedSize)
+{
+    check(IsInRenderingThread());
+
+    if (!Texture || !Slots.IsValidIndex(Slot))
+    {
+        return false;
+    }
+
+    if (Texture->GetSizeXY() != ExpectedSize)
+    {
+        UE_LOG(LogRship2110, Warning, TEXT("GPUReadback: Texture is %dx%d, stream is %dx%d"),
+               Texture->GetSizeXY().X, Texture->GetSizeXY().Y, ExpectedSize.X, ExpectedSize.Y);
+        return false;
+    }
+
+    ERship2110PixelInput Input;
+    if (!GetPixelInput(Texture->GetFormat(), Input))
+    {
+        UE_LOG(LogRship2110, Warning, TEXT("GPUReadback: Pixel format %s cannot be converted"),
+               GetPixelFormatString(Texture->GetFormat()));
+        return false;
+    }
+
+    Slots[Slot].Input = Input;
+    Slots[Slot].Readback->EnqueueCopy(RHICmdList, Texture);
+    return true;
+}
+
+bool FRship2110GPUReadbackSource::GetPixelInput(EPixelFormat Format, ERship2110PixelInput& OutInput)
+{
+    switch (Format)
+    {
+        case PF_B8G8R8A8:
+            OutInput = ERship2110PixelInput::BGRA8;
+            return true;
+        case PF_R8G8B8A8:
+            OutInput = ERship2110PixelInput::RGBA8;
+            return true;
+        case PF_FloatRGBA:
+            OutInput = ERship2110PixelInput::RGBA16F;
+            return true;
+        case PF_A2B10G10R10:
+            OutInput = ERship2110PixelInput::RGB10A2;
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool FRship2110GPUReadbackSource::IsReady(int32 Slot) const
+{
+    return Slots.IsValidIndex(Slot) && Slots[Slot].Readback->IsReady();
+}
+
+const void* FRship2110GPUReadbackSource::Lock(int32 Slot, int32& OutStride, ERship2110PixelInput& OutInput)
+{
+    check(IsInRenderingThread());
+
+    if (!Slots.IsValidIndex(Slot))
+    {
+        return nullptr;
+    }
+
+    int32 RowPitchInPixels = 0;
+    const void* Pixels = Slots[Slot].Readback->Lock(RowPitchInPixels);
+    OutInput = Slots[Slot].Input;
+    OutStride = RowPitchInPixels * FRship2110PixelConverter::GetInputBytesPerPixel(OutInput);
+    return Pixels;
+}
+
+void FRship2110GPUReadbackSource::Unlock(int32 Slot)
+{
+    if (Slots.IsValidIndex(Slot))
+    {
+        Slots[Slot].Readback->Unlock();
+    }
+}
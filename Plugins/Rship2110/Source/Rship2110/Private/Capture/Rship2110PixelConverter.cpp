@@ -0,0 +1,444 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "Capture/Rship2110PixelConverter.h"
+#include "Rship2110.h"
+#include "Async/ParallelFor.h"
+#include "Math/Float16.h"
+
+namespace
+{
+    // Lines converted per ParallelFor task
+    constexpr int32 LinesPerTask = 32;
+
+    // Decode one source line into normalized float channels.
+    void DecodeLine(const uint8* Source, ERship2110PixelInput Input, int32 Width, float* R, float* G, float* B, float* A)
+    {
+        switch (Input)
+        {
+            case ERship2110PixelInput::RGBA8:
+                for (int32 x = 0; x < Width; x++)
+                {
+                    R[x] = Source[x * 4 + 0] / 255.0f;
+                    G[x] = Source[x * 4 + 1] / 255.0f;
+                    B[x] = Source[x * 4 + 2] / 255.0f;
+                    A[x] = Source[x * 4 + 3] / 255.0f;
+                }
+                break;
+
+            case ERship2110PixelInput::BGRA8:
+                for (int32 x = 0; x < Width; x++)
+                {
+                    B[x] = Source[x * 4 + 0] / 255.0f;
+                    G[x] = Source[x * 4 + 1] / 255.0f;
+                    R[x] = Source[x * 4 + 2] / 255.0f;
+                    A[x] = Source[x * 4 + 3] / 255.0f;
+                }
+                break;
+
+            case ERship2110PixelInput::RGBA16F:
+            {
+                const FFloat16* Halves = reinterpret_cast<const FFloat16*>(Source);
+                for (int32 x = 0; x < Width; x++)
+                {
+                    R[x] = Halves[x * 4 + 0].GetFloat();
+                    G[x] = Halves[x * 4 + 1].GetFloat();
+                    B[x] = Halves[x * 4 + 2].GetFloat();
+                    A[x] = Halves[x * 4 + 3].GetFloat();
+                }
+                break;
+            }
+
+            case ERship2110PixelInput::RGB10A2:
+                for (int32 x = 0; x < Width; x++)
+                {
+                    uint32 Word;
+                    FMemory::Memcpy(&Word, Source + x * 4, sizeof(Word));
+                    R[x] = (Word & 0x3FF) / 1023.0f;
+                    G[x] = ((Word >> 10) & 0x3FF) / 1023.0f;
+                    B[x] = ((Word >> 20) & 0x3FF) / 1023.0f;
+                    A[x] = (Word >> 30) / 3.0f;
+                }
+                break;
+        }
+    }
+
+    // One matrix row. Multiply and add are kept separate so results don't depend on FMA support.
+    FORCEINLINE VectorRegister4Float MatrixRow(
+        const VectorRegister4Float& R, const VectorRegister4Float& G, const VectorRegister4Float& B,
+        const float Row[3], float Offset)
+    {
+        const VectorRegister4Float Sum = VectorAdd(
+            VectorAdd(VectorMultiply(R, VectorSetFloat1(Row[0])), VectorMultiply(G, VectorSetFloat1(Row[1]))),
+            VectorMultiply(B, VectorSetFloat1(Row[2])));
+        return VectorAdd(Sum, VectorSetFloat1(Offset));
+    }
+
+    // RGB to code values (unrounded), four pixels per register. Count is a multiple of 4.
+    void ApplyMatrix(
+        const float* R, const float* G, const float* B, int32 Count,
+        const float Matrix[3][3], const float Offset[3],
+        float* Out0, float* Out1, float* Out2)
+    {
+        for (int32 i = 0; i < Count; i += 4)
+        {
+            const VectorRegister4Float VR = VectorLoad(R + i);
+            const VectorRegister4Float VG = VectorLoad(G + i);
+            const VectorRegister4Float VB = VectorLoad(B + i);
+            VectorStore(MatrixRow(VR, VG, VB, Matrix[0], Offset[0]), Out0 + i);
+            VectorStore(MatrixRow(VR, VG, VB, Matrix[1], Offset[1]), Out1 + i);
+            VectorStore(MatrixRow(VR, VG, VB, Matrix[2], Offset[2]), Out2 + i);
+        }
+    }
+
+    // Round half up and clamp to the legal code range. Count is a multiple of 4.
+    void QuantizePlane(const float* In, int32 Count, float MinCode, float MaxCode, int32* Out)
+    {
+        const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+        const VectorRegister4Float Min = VectorSetFloat1(MinCode);
+        const VectorRegister4Float Max = VectorSetFloat1(MaxCode);
+        for (int32 i = 0; i < Count; i += 4)
+        {
+            const VectorRegister4Float Code = VectorFloor(VectorAdd(VectorLoad(In + i), Half));
+            VectorIntStore(VectorFloatToInt(VectorMin(VectorMax(Code, Min), Max)), Out + i);
+        }
+    }
+
+    // Filter full-width chroma down to Width / 2 samples in place. Output k reads
+    // inputs from 2k - 1 up, so nothing is overwritten before it is read.
+    void SubsampleChroma(float* Chroma, int32 Width, ERship2110ChromaSiting Siting)
+    {
+        const int32 HalfWidth = Width / 2;
+        if (Siting == ERship2110ChromaSiting::Cosited)
+        {
+            // [1 2 1] / 4 centred on the even luma sample, edge replicated
+            for (int32 k = 0; k < HalfWidth; k++)
+            {
+                const float Left = Chroma[FMath::Max(2 * k - 1, 0)];
+                Chroma[k] = 0.25f * Left + 0.5f * Chroma[2 * k] + 0.25f * Chroma[2 * k + 1];
+            }
+        }
+        else
+        {
+            // [1 1] / 2 midway between the pair
+            for (int32 k = 0; k < HalfWidth; k++)
+            {
+                Chroma[k] = 0.5f * (Chroma[2 * k] + Chroma[2 * k + 1]);
+            }
+        }
+    }
+
+    // Pack samples MSB first. NumSamples always fills whole pgroups, so 10-bit
+    // runs are a multiple of 4 samples (5 bytes) and 12-bit a multiple of 2 (3 bytes).
+    void PackSamples(const uint16* Samples, int32 NumSamples, int32 BitDepth, uint8* Dest)
+    {
+        switch (BitDepth)
+        {
+            case 8:
+                for (int32 i = 0; i < NumSamples; i++)
+                {
+                    Dest[i] = static_cast<uint8>(Samples[i]);
+                }
+                break;
+
+            case 10:
+                for (int32 i = 0; i < NumSamples; i += 4, Dest += 5)
+                {
+                    const uint32 S0 = Samples[i + 0];
+                    const uint32 S1 = Samples[i + 1];
+                    const uint32 S2 = Samples[i + 2];
+                    const uint32 S3 = Samples[i + 3];
+                    Dest[0] = static_cast<uint8>(S0 >> 2);
+                    Dest[1] = static_cast<uint8>(((S0 & 0x03) << 6) | (S1 >> 4));
+                    Dest[2] = static_cast<uint8>(((S1 & 0x0F) << 4) | (S2 >> 6));
+                    Dest[3] = static_cast<uint8>(((S2 & 0x3F) << 2) | (S3 >> 8));
+                    Dest[4] = static_cast<uint8>(S3);
+                }
+                break;
+
+            case 12:
+                for (int32 i = 0; i < NumSamples; i += 2, Dest += 3)
+                {
+                    const uint32 S0 = Samples[i + 0];
+                    const uint32 S1 = Samples[i + 1];
+                    Dest[0] = static_cast<uint8>(S0 >> 4);
+                    Dest[1] = static_cast<uint8>(((S0 & 0x0F) << 4) | (S1 >> 8));
+                    Dest[2] = static_cast<uint8>(S1);
+                }
+                break;
+
+            case 16:
+                for (int32 i = 0; i < NumSamples; i++)
+                {
+                    Dest[i * 2 + 0] = static_cast<uint8>(Samples[i] >> 8);
+                    Dest[i * 2 + 1] = static_cast<uint8>(Samples[i]);
+                }
+                break;
+        }
+    }
+}
+
+// Per-task working memory, sized for one line and padded to a whole vector
+struct FRship2110PixelConverter::FLineScratch
+{
+    explicit FLineScratch(int32 Width)
+    {
+        const int32 Padded = Align(Width, 4);
+        for (TArray<float>* Plane : { &R, &G, &B, &A, &C0, &C1, &C2 })
+        {
+            Plane->SetNumZeroed(Padded);
+        }
+        for (TArray<int32>* Plane : { &Q0, &Q1, &Q2, &Q3 })
+        {
+            Plane->SetNumZeroed(Padded);
+        }
+        Samples.SetNumZeroed(Width * 4);
+    }
+
+    // Normalized source channels
+    TArray<float> R, G, B, A;
+
+    // Matrix output in code values before rounding (Y Cb Cr, or R G B)
+    TArray<float> C0, C1, C2;
+
+    // Rounded and clamped codes, alpha last
+    TArray<int32> Q0, Q1, Q2, Q3;
+
+    // Samples in wire order
+    TArray<uint16> Samples;
+};
+
+bool FRship2110PixelConverter::Configure(const FRship2110VideoFormat& InFormat)
+{
+    Format = InFormat;
+    bValid = false;
+    LineBytes = 0;
+
+    const int32 Coverage = Format.GetPGroupCoverage();
+    if (Format.Width <= 0 || Format.Height <= 0 || Format.Width % Coverage != 0)
+    {
+        UE_LOG(LogRship2110, Warning, TEXT("PixelConverter: Width %d is not a whole number of %d-pixel pgroups for %s"),
+               Format.Width, Coverage, *Format.GetSampling());
+        return false;
+    }
+
+    const int32 BitDepth = Format.GetBitDepthInt();
+    const float MaxValue = static_cast<float>((1 << BitDepth) - 1);
+
+    // ITU-R BT.601/709/2020 narrow range, BT.2100 full range
+    float LumaScale, LumaOffset, ChromaScale, ChromaOffset, MinLegal, MaxLegal;
+    if (Format.Range == ERship2110ColorRange::Narrow)
+    {
+        const float Step = static_cast<float>(1 << (BitDepth - 8));
+        LumaScale = 219.0f * Step;
+        LumaOffset = 16.0f * Step;
+        ChromaScale = 224.0f * Step;
+        ChromaOffset = 128.0f * Step;
+
+        // Excludes the codes reserved for timing references (0-3 and 1020-1023 at 10-bit)
+        MinLegal = Step;
+        MaxLegal = MaxValue - Step;
+    }
+    else
+    {
+        LumaScale = MaxValue;
+        LumaOffset = 0.0f;
+        ChromaScale = MaxValue;
+        ChromaOffset = static_cast<float>(1 << (BitDepth - 1));
+        MinLegal = 0.0f;
+        MaxLegal = MaxValue;
+    }
+
+    const bool bYCbCr = Format.ColorFormat == ERship2110ColorFormat::YCbCr_422 ||
+                        Format.ColorFormat == ERship2110ColorFormat::YCbCr_444;
+    if (bYCbCr)
+    {
+        float Kr, Kb;
+        GetLumaCoefficients(Format.Colorimetry, Kr, Kb);
+        const float Kg = 1.0f - Kr - Kb;
+        const float CbDenominator = 2.0f * (1.0f - Kb);
+        const float CrDenominator = 2.0f * (1.0f - Kr);
+
+        const float YRow[3] = { LumaScale * Kr, LumaScale * Kg, LumaScale * Kb };
+        const float CbRow[3] = { -ChromaScale * Kr / CbDenominator, -ChromaScale * Kg / CbDenominator, ChromaScale * 0.5f };
+        const float CrRow[3] = { ChromaScale * 0.5f, -ChromaScale * Kg / CrDenominator, -ChromaScale * Kb / CrDenominator };
+        FMemory::Memcpy(Matrix[0], YRow, sizeof(YRow));
+        FMemory::Memcpy(Matrix[1], CbRow, sizeof(CbRow));
+        FMemory::Memcpy(Matrix[2], CrRow, sizeof(CrRow));
+        Offset[0] = LumaOffset;
+        Offset[1] = ChromaOffset;
+        Offset[2] = ChromaOffset;
+    }
+    else
+    {
+        // RGB components all use the luma quantization
+        FMemory::Memzero(Matrix, sizeof(Matrix));
+        for (int32 Row = 0; Row < 3; Row++)
+        {
+            Matrix[Row][Row] = LumaScale;
+            Offset[Row] = LumaOffset;
+        }
+    }
+
+    for (int32 Row = 0; Row < 3; Row++)
+    {
+        MinCode[Row] = MinLegal;
+        MaxCode[Row] = MaxLegal;
+    }
+    AlphaScale = MaxValue;
+
+    LineBytes = Format.GetBytesPerLine();
+    bValid = true;
+    return true;
+}
+
+bool FRship2110PixelConverter::ConvertFrame(const void* Source, ERship2110PixelInput Input, int32 SourceStride, uint8* Dest) const
+{
+    if (!bValid || !Source || !Dest)
+    {
+        return false;
+    }
+
+    const int32 Stride = SourceStride > 0 ? SourceStride : Format.Width * GetInputBytesPerPixel(Input);
+    const uint8* SourceBytes = static_cast<const uint8*>(Source);
+    const int32 NumTasks = FMath::DivideAndRoundUp(Format.Height, LinesPerTask);
+
+    ParallelFor(NumTasks, [&](int32 Task)
+    {
+        FLineScratch Scratch(Format.Width);
+        const int32 FirstLine = Task * LinesPerTask;
+        const int32 EndLine = FMath::Min(FirstLine + LinesPerTask, Format.Height);
+        for (int32 Line = FirstLine; Line < EndLine; Line++)
+        {
+            ConvertLine(SourceBytes + static_cast<int64>(Line) * Stride, Input,
+                        Dest + static_cast<int64>(Line) * LineBytes, Scratch);
+        }
+    }, NumTasks == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+    return true;
+}
+
+bool FRship2110PixelConverter::ConvertLine(const void* SourceLine, ERship2110PixelInput Input, uint8* DestLine) const
+{
+    if (!bValid || !SourceLine || !DestLine)
+    {
+        return false;
+    }
+
+    FLineScratch Scratch(Format.Width);
+    ConvertLine(static_cast<const uint8*>(SourceLine), Input, DestLine, Scratch);
+    return true;
+}
+
+void FRship2110PixelConverter::ConvertLine(const uint8* SourceLine, ERship2110PixelInput Input, uint8* DestLine, FLineScratch& Scratch) const
+{
+    const int32 Width = Format.Width;
+    const int32 Padded = Align(Width, 4);
+
+    DecodeLine(SourceLine, Input, Width, Scratch.R.GetData(), Scratch.G.GetData(), Scratch.B.GetData(), Scratch.A.GetData());
+    ApplyMatrix(Scratch.R.GetData(), Scratch.G.GetData(), Scratch.B.GetData(), Padded, Matrix, Offset,
+                Scratch.C0.GetData(), Scratch.C1.GetData(), Scratch.C2.GetData());
+
+    // Chroma is filtered before rounding so subsampling adds no rounding error
+    const bool bSubsampled = Format.ColorFormat == ERship2110ColorFormat::YCbCr_422;
+    const int32 ChromaCount = bSubsampled ? Align(Width / 2, 4) : Padded;
+    if (bSubsampled)
+    {
+        SubsampleChroma(Scratch.C1.GetData(), Width, Format.ChromaSiting);
+        SubsampleChroma(Scratch.C2.GetData(), Width, Format.ChromaSiting);
+    }
+
+    QuantizePlane(Scratch.C0.GetData(), Padded, MinCode[0], MaxCode[0], Scratch.Q0.GetData());
+    QuantizePlane(Scratch.C1.GetData(), ChromaCount, MinCode[1], MaxCode[1], Scratch.Q1.GetData());
+    QuantizePlane(Scratch.C2.GetData(), ChromaCount, MinCode[2], MaxCode[2], Scratch.Q2.GetData());
+
+    const int32* Q0 = Scratch.Q0.GetData();
+    const int32* Q1 = Scratch.Q1.GetData();
+    const int32* Q2 = Scratch.Q2.GetData();
+    uint16* Samples = Scratch.Samples.GetData();
+    int32 NumSamples = 0;
+
+    // Interleave in RFC 4175 pgroup order
+    switch (Format.ColorFormat)
+    {
+        case ERship2110ColorFormat::YCbCr_422:
+            for (int32 k = 0; k < Width / 2; k++)
+            {
+                Samples[NumSamples++] = static_cast<uint16>(Q1[k]);          // Cb
+                Samples[NumSamples++] = static_cast<uint16>(Q0[2 * k]);      // Y0
+                Samples[NumSamples++] = static_cast<uint16>(Q2[k]);          // Cr
+                Samples[NumSamples++] = static_cast<uint16>(Q0[2 * k + 1]);  // Y1
+            }
+            break;
+
+        case ERship2110ColorFormat::YCbCr_444:
+            for (int32 x = 0; x < Width; x++)
+            {
+                Samples[NumSamples++] = static_cast<uint16>(Q1[x]);  // Cb
+                Samples[NumSamples++] = static_cast<uint16>(Q0[x]);  // Y
+                Samples[NumSamples++] = static_cast<uint16>(Q2[x]);  // Cr
+            }
+            break;
+
+        case ERship2110ColorFormat::RGB_444:
+            for (int32 x = 0; x < Width; x++)
+            {
+                Samples[NumSamples++] = static_cast<uint16>(Q0[x]);
+                Samples[NumSamples++] = static_cast<uint16>(Q1[x]);
+                Samples[NumSamples++] = static_cast<uint16>(Q2[x]);
+            }
+            break;
+
+        case ERship2110ColorFormat::RGBA_4444:
+        {
+            // Alpha is always full range
+            float* AlphaCodes = Scratch.A.GetData();
+            for (int32 x = 0; x < Padded; x++)
+            {
+                AlphaCodes[x] *= AlphaScale;
+            }
+            QuantizePlane(AlphaCodes, Padded, 0.0f, AlphaScale, Scratch.Q3.GetData());
+
+            const int32* Q3 = Scratch.Q3.GetData();
+            for (int32 x = 0; x < Width; x++)
+            {
+                Samples[NumSamples++] = static_cast<uint16>(Q0[x]);
+                Samples[NumSamples++] = static_cast<uint16>(Q1[x]);
+                Samples[NumSamples++] = static_cast<uint16>(Q2[x]);
+                Samples[NumSamples++] = static_cast<uint16>(Q3[x]);
+            }
+            break;
+        }
+    }
+
+    PackSamples(Samples, NumSamples, Format.GetBitDepthInt(), DestLine);
+}
+
+void FRship2110PixelConverter::GetLumaCoefficients(ERship2110Colorimetry Colorimetry, float& OutKr, float& OutKb)
+{
+    switch (Colorimetry)
+    {
+        case ERship2110Colorimetry::BT601:
+            OutKr = 0.299f;
+            OutKb = 0.114f;
+            break;
+
+        case ERship2110Colorimetry::BT2020:
+        case ERship2110Colorimetry::BT2100:
+            OutKr = 0.2627f;
+            OutKb = 0.0593f;
+            break;
+
+        case ERship2110Colorimetry::BT709:
+        case ERship2110Colorimetry::DCIP3:
+        case ERship2110Colorimetry::ST2065_1:
+        default:
+            OutKr = 0.2126f;
+            OutKb = 0.0722f;
+            break;
+    }
+}
+
+int32 FRship2110PixelConverter::GetInputBytesPerPixel(ERship2110PixelInput Input)
+{
+    return Input == ERship2110PixelInput::RGBA16F ? 8 : 4;
+}
@@ -2,16 +2,121 @@
 
 #include "IPMX/RshipIPMXService.h"
 #include "Rivermax/Rship2110VideoSender.h"
+#include "PTP/RshipPTPService.h"
 #include "Rship2110Subsystem.h"
 #include "Rship2110Settings.h"
 #include "Rship2110.h"
 #include "HttpModule.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "HttpPath.h"
+#include "IHttpRouter.h"
 #include "Interfaces/IHttpRequest.h"
 #include "Interfaces/IHttpResponse.h"
+#include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
+#include "SocketSubsystem.h"
+#include "IPAddress.h"
 #include "Misc/Guid.h"
 
+namespace
+{
+    const TCHAR* NodeAPIRoute = TEXT("/x-nmos/node");
+    const TCHAR* ConnectionAPIRoute = TEXT("/x-nmos/connection");
+    const TCHAR* NodeAPIVersion = TEXT("v1.3");
+    const TCHAR* ConnectionAPIVersion = TEXT("v1.1");
+
+    /** TAI - UTC since 2017-01-01, for activation times without a PTP clock */
+    constexpr int64 TAIOffsetSeconds = 37;
+
+    FString ToJsonString(const TSharedPtr<FJsonObject>& Object)
+    {
+        FString Result;
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Result);
+        FJsonSerializer::Serialize(Object.ToSharedRef(), Writer);
+        return Result;
+    }
+
+    FString ToJsonString(const TArray<TSharedPtr<FJsonValue>>& Array)
+    {
+        FString Result;
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Result);
+        FJsonSerializer::Serialize(Array, Writer);
+        return Result;
+    }
+
+    /** Directory listing, as NMOS APIs return for non-leaf paths */
+    FString MakeListing(std::initializer_list<const TCHAR*> Entries)
+    {
+        TArray<TSharedPtr<FJsonValue>> Values;
+        for (const TCHAR* Entry : Entries)
+        {
+            Values.Add(MakeShared<FJsonValueString>(Entry));
+        }
+        return ToJsonString(Values);
+    }
+
+    /** NMOS error body */
+    int32 MakeError(int32 Code, const FString& Error, FString& OutResponse)
+    {
+        TSharedPtr<FJsonObject> Body = MakeShared<FJsonObject>();
+        Body->SetNumberField(TEXT("code"), Code);
+        Body->SetStringField(TEXT("error"), Error);
+        Body->SetField(TEXT("debug"), MakeShared<FJsonValueNull>());
+        OutResponse = ToJsonString(Body);
+        return Code;
+    }
+
+    FString VerbToString(EHttpServerRequestVerbs Verb)
+    {
+        switch (Verb)
+        {
+            case EHttpServerRequestVerbs::VERB_GET: return TEXT("GET");
+            case EHttpServerRequestVerbs::VERB_POST: return TEXT("POST");
+            case EHttpServerRequestVerbs::VERB_PUT: return TEXT("PUT");
+            case EHttpServerRequestVerbs::VERB_PATCH: return TEXT("PATCH");
+            case EHttpServerRequestVerbs::VERB_DELETE: return TEXT("DELETE");
+            case EHttpServerRequestVerbs::VERB_OPTIONS: return TEXT("OPTIONS");
+            default: return TEXT("");
+        }
+    }
+
+    /** Raw video components for an IS-04 flow */
+    TArray<TSharedPtr<FJsonValue>> BuildComponentsJson(const FRship2110VideoFormat& Format)
+    {
+        TArray<TPair<const TCHAR*, int32>> Components;
+        switch (Format.ColorFormat)
+        {
+            case ERship2110ColorFormat::YCbCr_422:
+                Components = {{TEXT("Y"), Format.Width}, {TEXT("Cb"), Format.Width / 2}, {TEXT("Cr"), Format.Width / 2}};
+                break;
+            case ERship2110ColorFormat::YCbCr_444:
+                Components = {{TEXT("Y"), Format.Width}, {TEXT("Cb"), Format.Width}, {TEXT("Cr"), Format.Width}};
+                break;
+            case ERship2110ColorFormat::RGB_444:
+                Components = {{TEXT("R"), Format.Width}, {TEXT("G"), Format.Width}, {TEXT("B"), Format.Width}};
+                break;
+            case ERship2110ColorFormat::RGBA_4444:
+                Components = {{TEXT("R"), Format.Width}, {TEXT("G"), Format.Width}, {TEXT("B"), Format.Width}, {TEXT("A"), Format.Width}};
+                break;
+        }
+
+        TArray<TSharedPtr<FJsonValue>> Result;
+        for (const TPair<const TCHAR*, int32>& Component : Components)
+        {
+            TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+            Json->SetStringField(TEXT("name"), Component.Key);
+            Json->SetNumberField(TEXT("width"), Component.Value);
+            Json->SetNumberField(TEXT("height"), Format.Height);
+            Json->SetNumberField(TEXT("bit_depth"), Format.GetBitDepthInt());
+            Result.Add(MakeShared<FJsonValueObject>(Json));
+        }
+        return Result;
+    }
+}
+
 bool URshipIPMXService::Initialize(URship2110Subsystem* InSubsystem)
 {
     if (!InSubsystem)
@@ -40,6 +145,7 @@ bool URshipIPMXService::Initialize(URship2110Subsystem* InSubsystem)
         }
         HeartbeatInterval = static_cast<double>(Settings->IPMXHeartbeatIntervalSeconds);
         LocalAPIPort = Settings->IPMXNodeAPIPort;
+        ConnectionAPIPort = Settings->IPMXConnectionAPIPort;
     }
 
     UE_LOG(LogRship2110, Log, TEXT("IPMXService: Initialized with node ID %s"), *NodeConfig.Id);
@@ -57,7 +163,7 @@ void URshipIPMXService::Shutdown()
 
     // Clear registered resources
     RegisteredSenders.Empty();
-    SenderToVideoSenderId.Empty();
+    SenderStates.Empty();
 
     Subsystem = nullptr;
 
@@ -66,12 +172,25 @@ void URshipIPMXService::Shutdown()
 
 void URshipIPMXService::Tick(float DeltaTime)
 {
+    // IS-05 activations run with or without a registry
+    ProcessScheduledActivations();
+
     if (State != ERshipIPMXConnectionState::Registered &&
         State != ERshipIPMXConnectionState::Active)
     {
         return;
     }
 
+    // Send senders whose resources changed (activation, transport)
+    for (TPair<FString, FSenderState>& Pair : SenderStates)
+    {
+        if (Pair.Value.bResourceChanged)
+        {
+            Pair.Value.bResourceChanged = false;
+            RegisterSenderResource(Pair.Key);
+        }
+    }
+
     // Send heartbeat if needed
     double CurrentTime = FPlatformTime::Seconds();
     if (CurrentTime - LastHeartbeatTime >= HeartbeatInterval)
@@ -119,12 +238,15 @@ void URshipIPMXService::DisconnectFromRegistry()
         return;
     }
 
-    // Unregister all senders
-    TArray<FString> SenderIds;
-    RegisteredSenders.GetKeys(SenderIds);
-    for (const FString& SenderId : SenderIds)
+    // Unregister all senders with their flows and sources
+    for (const TPair<FString, FRshipNMOSSender>& Pair : RegisteredSenders)
     {
-        UnregisterResource(TEXT("senders"), SenderId);
+        UnregisterResource(TEXT("senders"), Pair.Key);
+        UnregisterResource(TEXT("flows"), Pair.Value.FlowId);
+        if (const FSenderState* SenderState = SenderStates.Find(Pair.Key))
+        {
+            UnregisterResource(TEXT("sources"), SenderState->SourceId);
+        }
     }
 
     // Unregister device and node
@@ -193,16 +315,23 @@ FString URshipIPMXService::RegisterSender(URship2110VideoSender* VideoSender)
     Sender.DeviceId = DeviceId;
     Sender.FlowId = GenerateUUID();  // Flow created alongside sender
     Sender.Transport = TEXT("urn:x-nmos:transport:rtp.mcast");
+    Sender.bActive = VideoSender->IsStreaming();
+
+    // Source, and the IS-05 state starting from the stream's current transport
+    FSenderState SenderState;
+    SenderState.VideoSender = VideoSender;
+    SenderState.SourceId = GenerateUUID();
+    SenderState.Connection.Initialize(VideoSender->GetTransportParams());
+    SenderState.Connection.SetActiveEnabled(Sender.bActive);
 
     // Store mapping
     RegisteredSenders.Add(SenderId, Sender);
-    SenderToVideoSenderId.Add(SenderId, VideoSender->GetStreamId());
+    SenderStates.Add(SenderId, MoveTemp(SenderState));
 
     // Register with registry if connected
     if (IsConnected() && !RegistryUrl.IsEmpty())
     {
         RegisterSourceAndFlow(SenderId, VideoSender);
-        RegisterSenderResource(SenderId);
     }
 
     UE_LOG(LogRship2110, Log, TEXT("IPMXService: Registered sender %s for stream %s"),
@@ -213,20 +342,26 @@ FString URshipIPMXService::RegisterSender(URship2110VideoSender* VideoSender)
 
 bool URshipIPMXService::UnregisterSender(const FString& SenderId)
 {
-    if (!RegisteredSenders.Contains(SenderId))
+    const FRshipNMOSSender* Sender = RegisteredSenders.Find(SenderId);
+    if (!Sender)
     {
         UE_LOG(LogRship2110, Warning, TEXT("IPMXService: Sender %s not found"), *SenderId);
         return false;
     }
 
-    // Unregister from registry
+    // Unregister from registry, children first
     if (IsConnected() && !RegistryUrl.IsEmpty())
     {
         UnregisterResource(TEXT("senders"), SenderId);
+        UnregisterResource(TEXT("flows"), Sender->FlowId);
+        if (const FSenderState* SenderState = SenderStates.Find(SenderId))
+        {
+            UnregisterResource(TEXT("sources"), SenderState->SourceId);
+        }
     }
 
     RegisteredSenders.Remove(SenderId);
-    SenderToVideoSenderId.Remove(SenderId);
+    SenderStates.Remove(SenderId);
 
     UE_LOG(LogRship2110, Log, TEXT("IPMXService: Unregistered sender %s"), *SenderId);
     return true;
@@ -252,14 +387,37 @@ TArray<FString> URshipIPMXService::GetRegisteredSenderIds() const
 
 bool URshipIPMXService::UpdateSenderTransport(const FString& SenderId, const FRship2110TransportParams& NewParams)
 {
-    FRshipNMOSSender* Sender = RegisteredSenders.Find(SenderId);
-    if (!Sender)
+    FSenderState* SenderState = SenderStates.Find(SenderId);
+    URship2110VideoSender* VideoSender = FindVideoSender(SenderId);
+    if (!SenderState || !VideoSender)
+    {
+        return false;
+    }
+
+    // Addresses only change while the stream is stopped; restart it around the change
+    const FRship2110TransportParams Current = VideoSender->GetTransportParams();
+    const bool bRestart = VideoSender->GetState() != ERship2110StreamState::Stopped &&
+        (NewParams.SourceIP != Current.SourceIP || NewParams.SourcePort != Current.SourcePort ||
+         NewParams.DestinationIP != Current.DestinationIP || NewParams.DestinationPort != Current.DestinationPort);
+
+    if (bRestart)
+    {
+        VideoSender->StopStream();
+    }
+    const bool bUpdated = VideoSender->UpdateTransportParams(NewParams);
+    if (bRestart)
+    {
+        VideoSender->StartStream();
+    }
+
+    if (!bUpdated)
     {
         return false;
     }
 
-    // Update the sender's transport info would go here
-    // This typically involves updating the SDP/manifest
+    // The SDP changed with the transport
+    SenderState->Connection.SetActiveTransport(VideoSender->GetTransportParams());
+    MarkSenderChanged(SenderId);
 
     return true;
 }
@@ -273,16 +431,13 @@ bool URshipIPMXService::ActivateSender(const FString& SenderId)
     }
 
     Sender->bActive = true;
+    SenderStates[SenderId].Connection.SetActiveEnabled(true);
+    MarkSenderChanged(SenderId);
 
     // Start the associated video sender
-    FString* StreamIdPtr = SenderToVideoSenderId.Find(SenderId);
-    if (StreamIdPtr && Subsystem)
+    if (URship2110VideoSender* VideoSender = FindVideoSender(SenderId))
     {
-        URship2110VideoSender* VideoSender = Subsystem->GetVideoSender(*StreamIdPtr);
-        if (VideoSender)
-        {
-            VideoSender->StartStream();
-        }
+        VideoSender->StartStream();
     }
 
     return true;
@@ -297,16 +452,13 @@ bool URshipIPMXService::DeactivateSender(const FString& SenderId)
     }
 
     Sender->bActive = false;
+    SenderStates[SenderId].Connection.SetActiveEnabled(false);
+    MarkSenderChanged(SenderId);
 
     // Stop the associated video sender
-    FString* StreamIdPtr = SenderToVideoSenderId.Find(SenderId);
-    if (StreamIdPtr && Subsystem)
+    if (URship2110VideoSender* VideoSender = FindVideoSender(SenderId))
     {
-        URship2110VideoSender* VideoSender = Subsystem->GetVideoSender(*StreamIdPtr);
-        if (VideoSender)
-        {
-            VideoSender->StopStream();
-        }
+        VideoSender->StopStream();
     }
 
     return true;
@@ -314,19 +466,7 @@ bool URshipIPMXService::DeactivateSender(const FString& SenderId)
 
 FString URshipIPMXService::GetSenderSDP(const FString& SenderId) const
 {
-    const FRshipNMOSSender* Sender = RegisteredSenders.Find(SenderId);
-    if (!Sender)
-    {
-        return TEXT("");
-    }
-
-    const FString* StreamIdPtr = SenderToVideoSenderId.Find(SenderId);
-    if (!StreamIdPtr || !Subsystem)
-    {
-        return TEXT("");
-    }
-
-    URship2110VideoSender* VideoSender = Subsystem->GetVideoSender(*StreamIdPtr);
+    URship2110VideoSender* VideoSender = FindVideoSender(SenderId);
     if (!VideoSender)
     {
         return TEXT("");
@@ -349,13 +489,11 @@ FString URshipIPMXService::GetSenderManifestUrl(const FString& SenderId) const
     }
 
     // Generate local manifest URL
-    FString LocalIP = TEXT("127.0.0.1");
-    // TODO: Get actual local IP
     return FString::Printf(TEXT("http://%s:%d/x-nmos/node/v1.3/senders/%s/sdp"),
-                           *LocalIP, LocalAPIPort, *SenderId);
+                           *GetLocalAPIHost(), LocalAPIPort, *SenderId);
 }
 
-bool URshipIPMXService::StartLocalAPIServer(int32 Port)
+bool URshipIPMXService::StartLocalAPIServer(int32 Port, int32 ConnectionPort)
 {
     if (bLocalAPIRunning)
     {
@@ -364,12 +502,43 @@ bool URshipIPMXService::StartLocalAPIServer(int32 Port)
     }
 
     LocalAPIPort = Port;
+    ConnectionAPIPort = ConnectionPort > 0 ? ConnectionPort : Port;
+
+    FHttpServerModule& HttpServer = FHttpServerModule::Get();
+    NodeRouter = HttpServer.GetHttpRouter(LocalAPIPort, /*bFailOnBindFailure=*/ true);
+    ConnectionRouter = ConnectionAPIPort == LocalAPIPort
+        ? NodeRouter
+        : HttpServer.GetHttpRouter(ConnectionAPIPort, /*bFailOnBindFailure=*/ true);
+
+    if (!NodeRouter.IsValid() || !ConnectionRouter.IsValid())
+    {
+        UE_LOG(LogRship2110, Error, TEXT("IPMXService: Cannot listen on port %d or %d"), LocalAPIPort, ConnectionAPIPort);
+        UnbindLocalAPIRoutes();
+        return false;
+    }
+
+    // Unsupported methods reach the handlers, which answer 405
+    const EHttpServerRequestVerbs Verbs =
+        EHttpServerRequestVerbs::VERB_GET | EHttpServerRequestVerbs::VERB_POST | EHttpServerRequestVerbs::VERB_PUT |
+        EHttpServerRequestVerbs::VERB_PATCH | EHttpServerRequestVerbs::VERB_DELETE;
+
+    NodeRoute = NodeRouter->BindRoute(FHttpPath(NodeAPIRoute), Verbs,
+        FHttpRequestHandler::CreateUObject(this, &URshipIPMXService::HandleHttpRequest, FString(NodeAPIRoute)));
+    ConnectionRoute = ConnectionRouter->BindRoute(FHttpPath(ConnectionAPIRoute), Verbs,
+        FHttpRequestHandler::CreateUObject(this, &URshipIPMXService::HandleHttpRequest, FString(ConnectionAPIRoute)));
+
+    if (!NodeRoute.IsValid() || !ConnectionRoute.IsValid())
+    {
+        UE_LOG(LogRship2110, Error, TEXT("IPMXService: NMOS routes already bound on port %d or %d"), LocalAPIPort, ConnectionAPIPort);
+        UnbindLocalAPIRoutes();
+        return false;
+    }
 
-    // TODO: Implement HTTP server for IS-04/IS-05 APIs
-    // This would typically use FHttpServerModule or a custom TCP server
+    HttpServer.StartAllListeners();
 
     bLocalAPIRunning = true;
-    UE_LOG(LogRship2110, Log, TEXT("IPMXService: Local API server started on port %d"), Port);
+    UE_LOG(LogRship2110, Log, TEXT("IPMXService: Local API server started (Node API on port %d, Connection API on port %d)"),
+           LocalAPIPort, ConnectionAPIPort);
     return true;
 }
 
@@ -380,12 +549,30 @@ void URshipIPMXService::StopLocalAPIServer()
         return;
     }
 
-    // TODO: Stop HTTP server
+    // The listeners belong to the HTTP server module and stay open for other routes
+    UnbindLocalAPIRoutes();
 
     bLocalAPIRunning = false;
     UE_LOG(LogRship2110, Log, TEXT("IPMXService: Local API server stopped"));
 }
 
+void URshipIPMXService::UnbindLocalAPIRoutes()
+{
+    if (NodeRouter.IsValid() && NodeRoute.IsValid())
+    {
+        NodeRouter->UnbindRoute(NodeRoute);
+    }
+    if (ConnectionRouter.IsValid() && ConnectionRoute.IsValid())
+    {
+        ConnectionRouter->UnbindRoute(ConnectionRoute);
+    }
+
+    NodeRoute.Reset();
+    ConnectionRoute.Reset();
+    NodeRouter.Reset();
+    ConnectionRouter.Reset();
+}
+
 void URshipIPMXService::SetState(ERshipIPMXConnectionState NewState)
 {
     if (State != NewState)
@@ -410,8 +597,7 @@ void URshipIPMXService::InitializeNodeConfig()
     // Get hostname
     NodeConfig.Hostname = FPlatformProcess::ComputerName();
 
-    // Generate clock reference
-    // In production, this would come from the PTP service
+    // Clock reference; its state comes from the PTP service
     NodeConfig.Clocks.Add(TEXT("clk0"));
 }
 
@@ -420,6 +606,129 @@ void URshipIPMXService::InitializeDeviceConfig()
     DeviceId = GenerateUUID();
 }
 
+URship2110VideoSender* URshipIPMXService::FindVideoSender(const FString& SenderId) const
+{
+    const FSenderState* SenderState = SenderStates.Find(SenderId);
+    return SenderState ? SenderState->VideoSender.Get() : nullptr;
+}
+
+FString URshipIPMXService::GetLocalAPIHost() const
+{
+    ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+    if (SocketSubsystem)
+    {
+        bool bCanBindAll = false;
+        TSharedRef<FInternetAddr> Address = SocketSubsystem->GetLocalHostAddr(*GLog, bCanBindAll);
+        if (Address->IsValid())
+        {
+            return Address->ToString(false);
+        }
+    }
+    return TEXT("127.0.0.1");
+}
+
+// ============================================================================
+// IS-05 ACTIVATION
+// ============================================================================
+
+FRshipPTPTimestamp URshipIPMXService::GetActivationClock() const
+{
+    // IS-05 times are TAI, which is the PTP timescale
+    URshipPTPService* PTPService = Subsystem ? Subsystem->GetPTPService() : nullptr;
+    if (PTPService && PTPService->GetProvider())
+    {
+        return PTPService->GetPTPTime();
+    }
+
+    const FTimespan SinceEpoch = FDateTime::UtcNow() - FDateTime(1970, 1, 1);
+    return FRshipPTPTimestamp::FromNanoseconds(
+        static_cast<uint64>(SinceEpoch.GetTicks()) * 100ULL + static_cast<uint64>(TAIOffsetSeconds) * 1000000000ULL);
+}
+
+bool URshipIPMXService::ActivateStaged(const FString& SenderId)
+{
+    FSenderState* SenderState = SenderStates.Find(SenderId);
+    if (!SenderState)
+    {
+        return false;
+    }
+
+    FRshipNMOSSenderConnection& Connection = SenderState->Connection;
+    URship2110VideoSender* VideoSender = SenderState->VideoSender.Get();
+    if (!VideoSender)
+    {
+        UE_LOG(LogRship2110, Warning, TEXT("IPMXService: Sender %s has no stream to activate"), *SenderId);
+        Connection.CancelActivation();
+        return false;
+    }
+
+    const FRship2110TransportParams Resolved = Connection.ResolveTransport(VideoSender->GetTransportParams());
+    const bool bEnable = Connection.GetStaged().bMasterEnable && Connection.GetStaged().Transport.bRTPEnabled;
+
+    // Stop before changing addresses, or change them before starting, so the stream restarts at most once
+    if (!bEnable)
+    {
+        DeactivateSender(SenderId);
+    }
+
+    if (!UpdateSenderTransport(SenderId, Resolved))
+    {
+        UE_LOG(LogRship2110, Warning, TEXT("IPMXService: Sender %s refused transport %s:%d"),
+               *SenderId, *Resolved.DestinationIP, Resolved.DestinationPort);
+        Connection.CancelActivation();
+        return false;
+    }
+
+    if (bEnable)
+    {
+        ActivateSender(SenderId);
+    }
+
+    Connection.CompleteActivation(VideoSender->GetTransportParams());
+
+    UE_LOG(LogRship2110, Log, TEXT("IPMXService: Sender %s activated, %s to %s:%d"),
+           *SenderId, bEnable ? TEXT("sending") : TEXT("stopped"), *Resolved.DestinationIP, Resolved.DestinationPort);
+    return true;
+}
+
+void URshipIPMXService::ProcessScheduledActivations()
+{
+    if (SenderStates.Num() == 0)
+    {
+        return;
+    }
+
+    const FRshipPTPTimestamp Now = GetActivationClock();
+
+    TArray<FString> DueSenders;
+    for (const TPair<FString, FSenderState>& Pair : SenderStates)
+    {
+        if (Pair.Value.Connection.GetStaged().Activation.IsScheduled() && Pair.Value.Connection.IsActivationDue(Now))
+        {
+            DueSenders.Add(Pair.Key);
+        }
+    }
+
+    for (const FString& SenderId : DueSenders)
+    {
+        ActivateStaged(SenderId);
+    }
+}
+
+void URshipIPMXService::MarkSenderChanged(const FString& SenderId)
+{
+    // Sent on the next Tick, once however many changes an activation makes
+    FSenderState* SenderState = SenderStates.Find(SenderId);
+    if (SenderState && IsConnected() && !RegistryUrl.IsEmpty())
+    {
+        SenderState->bResourceChanged = true;
+    }
+}
+
+// ============================================================================
+// REGISTRY
+// ============================================================================
+
 void URshipIPMXService::RegisterNode()
 {
     if (RegistryUrl.IsEmpty())
@@ -470,6 +779,15 @@ void URshipIPMXService::RegisterDevice()
                 UE_LOG(LogRship2110, Log, TEXT("IPMXService: Device registered"));
                 SetState(ERshipIPMXConnectionState::Registered);
                 LastHeartbeatTime = FPlatformTime::Seconds();
+
+                // Senders registered before the registry was reached
+                for (const TPair<FString, FSenderState>& Pair : SenderStates)
+                {
+                    if (URship2110VideoSender* VideoSender = Pair.Value.VideoSender.Get())
+                    {
+                        RegisterSourceAndFlow(Pair.Key, VideoSender);
+                    }
+                }
             }
             else
             {
@@ -482,13 +800,15 @@ void URshipIPMXService::RegisterDevice()
 
 void URshipIPMXService::RegisterSourceAndFlow(const FString& SenderId, URship2110VideoSender* VideoSender)
 {
-    // Register source and flow for the sender
-    // These are created alongside the sender in NMOS
+    // Register source, flow and sender in order, each after its parent
 
     TSharedPtr<FJsonObject> SourceJson = BuildSourceJson(SenderId, VideoSender);
     TSharedPtr<FJsonObject> FlowJson = BuildFlowJson(SenderId, VideoSender);
+    if (!SourceJson.IsValid() || !FlowJson.IsValid())
+    {
+        return;
+    }
 
-    // Register source first, then flow
     SendRegistryRequest(
         TEXT("POST"),
         TEXT("/x-nmos/registration/v1.3/resource"),
@@ -502,9 +822,13 @@ void URshipIPMXService::RegisterSourceAndFlow(const FString& SenderId, URship211
                     TEXT("POST"),
                     TEXT("/x-nmos/registration/v1.3/resource"),
                     FlowJson,
-                    [](bool bSuccess2, const FString& Response2)
+                    [this, SenderId](bool bSuccess2, const FString& Response2)
                     {
-                        if (!bSuccess2)
+                        if (bSuccess2)
+                        {
+                            RegisterSenderResource(SenderId);
+                        }
+                        else
                         {
                             UE_LOG(LogRship2110, Warning, TEXT("IPMXService: Flow registration failed"));
                         }
@@ -520,6 +844,10 @@ void URshipIPMXService::RegisterSourceAndFlow(const FString& SenderId, URship211
 void URshipIPMXService::RegisterSenderResource(const FString& SenderId)
 {
     TSharedPtr<FJsonObject> SenderJson = BuildSenderJson(SenderId);
+    if (!SenderJson.IsValid())
+    {
+        return;
+    }
 
     SendRegistryRequest(
         TEXT("POST"),
@@ -632,17 +960,25 @@ void URshipIPMXService::SendRegistryRequest(
     Request->ProcessRequest();
 }
 
+// ============================================================================
+// RESOURCE JSON
+// ============================================================================
+
 TSharedPtr<FJsonObject> URshipIPMXService::BuildNodeJson() const
 {
     TSharedPtr<FJsonObject> Node = MakeShareable(new FJsonObject());
     Node->SetStringField(TEXT("type"), TEXT("node"));
 
+    const FString Host = GetLocalAPIHost();
+
     TSharedPtr<FJsonObject> Data = MakeShareable(new FJsonObject());
     Data->SetStringField(TEXT("id"), NodeConfig.Id);
     Data->SetStringField(TEXT("version"), FString::Printf(TEXT("%lld:0"), FDateTime::UtcNow().ToUnixTimestamp()));
     Data->SetStringField(TEXT("label"), NodeConfig.Label);
     Data->SetStringField(TEXT("description"), NodeConfig.Description);
     Data->SetStringField(TEXT("hostname"), NodeConfig.Hostname);
+    Data->SetStringField(TEXT("href"), FString::Printf(TEXT("http://%s:%d/"), *Host, LocalAPIPort));
+    Data->SetObjectField(TEXT("caps"), MakeShareable(new FJsonObject()));
 
     // Tags
     TSharedPtr<FJsonObject> Tags = MakeShareable(new FJsonObject());
@@ -654,19 +990,46 @@ TSharedPtr<FJsonObject> URshipIPMXService::BuildNodeJson() const
     }
     Data->SetObjectField(TEXT("tags"), Tags);
 
-    // Clocks
+    // Clocks, all following the PTP service
+    URshipPTPService* PTPService = Subsystem ? Subsystem->GetPTPService() : nullptr;
+    const FRshipPTPStatus PTPStatus = PTPService ? PTPService->GetStatus() : FRshipPTPStatus();
+    FString GrandmasterId = PTPStatus.Grandmaster.ClockIdentity.Replace(TEXT(":"), TEXT("-")).ToLower();
+    if (GrandmasterId.IsEmpty())
+    {
+        GrandmasterId = TEXT("00-00-00-00-00-00-00-00");
+    }
+
     TArray<TSharedPtr<FJsonValue>> Clocks;
     for (const FString& Clock : NodeConfig.Clocks)
     {
         TSharedPtr<FJsonObject> ClockObj = MakeShareable(new FJsonObject());
         ClockObj->SetStringField(TEXT("name"), Clock);
         ClockObj->SetStringField(TEXT("ref_type"), TEXT("ptp"));
+        ClockObj->SetBoolField(TEXT("traceable"), false);
+        ClockObj->SetStringField(TEXT("version"), TEXT("IEEE1588-2008"));
+        ClockObj->SetStringField(TEXT("gmid"), GrandmasterId);
+        ClockObj->SetBoolField(TEXT("locked"), PTPStatus.IsLocked());
         Clocks.Add(MakeShareable(new FJsonValueObject(ClockObj)));
     }
     Data->SetArrayField(TEXT("clocks"), Clocks);
 
-    // API endpoints (empty array for now)
-    Data->SetArrayField(TEXT("api"), TArray<TSharedPtr<FJsonValue>>());
+    // Node API endpoint
+    TSharedPtr<FJsonObject> Api = MakeShareable(new FJsonObject());
+    TArray<TSharedPtr<FJsonValue>> Versions;
+    Versions.Add(MakeShareable(new FJsonValueString(NodeAPIVersion)));
+    Api->SetArrayField(TEXT("versions"), Versions);
+
+    TArray<TSharedPtr<FJsonValue>> Endpoints;
+    if (bLocalAPIRunning)
+    {
+        TSharedPtr<FJsonObject> Endpoint = MakeShareable(new FJsonObject());
+        Endpoint->SetStringField(TEXT("host"), Host);
+        Endpoint->SetNumberField(TEXT("port"), LocalAPIPort);
+        Endpoint->SetStringField(TEXT("protocol"), TEXT("http"));
+        Endpoints.Add(MakeShareable(new FJsonValueObject(Endpoint)));
+    }
+    Api->SetArrayField(TEXT("endpoints"), Endpoints);
+    Data->SetObjectField(TEXT("api"), Api);
 
     // Services (empty array)
     Data->SetArrayField(TEXT("services"), TArray<TSharedPtr<FJsonValue>>());
@@ -690,12 +1053,27 @@ TSharedPtr<FJsonObject> URshipIPMXService::BuildDeviceJson() const
     Data->SetStringField(TEXT("description"), TEXT("Video output device"));
     Data->SetStringField(TEXT("node_id"), NodeConfig.Id);
     Data->SetStringField(TEXT("type"), TEXT("urn:x-nmos:device:generic"));
+    Data->SetObjectField(TEXT("tags"), MakeShareable(new FJsonObject()));
 
-    // Empty arrays
-    Data->SetArrayField(TEXT("tags"), TArray<TSharedPtr<FJsonValue>>());
-    Data->SetArrayField(TEXT("senders"), TArray<TSharedPtr<FJsonValue>>());
+    TArray<TSharedPtr<FJsonValue>> Senders;
+    for (const TPair<FString, FRshipNMOSSender>& Pair : RegisteredSenders)
+    {
+        Senders.Add(MakeShareable(new FJsonValueString(Pair.Key)));
+    }
+    Data->SetArrayField(TEXT("senders"), Senders);
     Data->SetArrayField(TEXT("receivers"), TArray<TSharedPtr<FJsonValue>>());
-    Data->SetArrayField(TEXT("controls"), TArray<TSharedPtr<FJsonValue>>());
+
+    // IS-05 Connection API
+    TArray<TSharedPtr<FJsonValue>> Controls;
+    if (bLocalAPIRunning)
+    {
+        TSharedPtr<FJsonObject> Control = MakeShareable(new FJsonObject());
+        Control->SetStringField(TEXT("href"), FString::Printf(TEXT("http://%s:%d%s/%s/"),
+                                                             *GetLocalAPIHost(), ConnectionAPIPort, ConnectionAPIRoute, ConnectionAPIVersion));
+        Control->SetStringField(TEXT("type"), FString::Printf(TEXT("urn:x-nmos:control:sr-ctrl/%s"), ConnectionAPIVersion));
+        Controls.Add(MakeShareable(new FJsonValueObject(Control)));
+    }
+    Data->SetArrayField(TEXT("controls"), Controls);
 
     Device->SetObjectField(TEXT("data"), Data);
     return Device;
@@ -704,7 +1082,8 @@ TSharedPtr<FJsonObject> URshipIPMXService::BuildDeviceJson() const
 TSharedPtr<FJsonObject> URshipIPMXService::BuildSourceJson(const FString& SenderId, URship2110VideoSender* VideoSender) const
 {
     const FRshipNMOSSender* Sender = RegisteredSenders.Find(SenderId);
-    if (!Sender)
+    const FSenderState* SenderState = SenderStates.Find(SenderId);
+    if (!Sender || !SenderState)
     {
         return nullptr;
     }
@@ -713,20 +1092,18 @@ TSharedPtr<FJsonObject> URshipIPMXService::BuildSourceJson(const FString& Sender
     Source->SetStringField(TEXT("type"), TEXT("source"));
 
     TSharedPtr<FJsonObject> Data = MakeShareable(new FJsonObject());
-    FString SourceId = GenerateUUID();
-    Data->SetStringField(TEXT("id"), SourceId);
+    Data->SetStringField(TEXT("id"), SenderState->SourceId);
     Data->SetStringField(TEXT("version"), FString::Printf(TEXT("%lld:0"), FDateTime::UtcNow().ToUnixTimestamp()));
     Data->SetStringField(TEXT("label"), FString::Printf(TEXT("Source for %s"), *Sender->Label));
     Data->SetStringField(TEXT("description"), TEXT("Video source"));
     Data->SetStringField(TEXT("device_id"), DeviceId);
     Data->SetStringField(TEXT("format"), TEXT("urn:x-nmos:format:video"));
+    Data->SetObjectField(TEXT("caps"), MakeShareable(new FJsonObject()));
 
     // Clock reference
-    TSharedPtr<FJsonObject> Clock = MakeShareable(new FJsonObject());
-    Clock->SetStringField(TEXT("name"), TEXT("clk0"));
-    Data->SetObjectField(TEXT("clock_name"), Clock);
+    Data->SetStringField(TEXT("clock_name"), TEXT("clk0"));
 
-    Data->SetArrayField(TEXT("tags"), TArray<TSharedPtr<FJsonValue>>());
+    Data->SetObjectField(TEXT("tags"), MakeShareable(new FJsonObject()));
     Data->SetArrayField(TEXT("parents"), TArray<TSharedPtr<FJsonValue>>());
 
     Source->SetObjectField(TEXT("data"), Data);
@@ -736,7 +1113,8 @@ TSharedPtr<FJsonObject> URshipIPMXService::BuildSourceJson(const FString& Sender
 TSharedPtr<FJsonObject> URshipIPMXService::BuildFlowJson(const FString& SenderId, URship2110VideoSender* VideoSender) const
 {
     const FRshipNMOSSender* Sender = RegisteredSenders.Find(SenderId);
-    if (!Sender || !VideoSender)
+    const FSenderState* SenderState = SenderStates.Find(SenderId);
+    if (!Sender || !SenderState || !VideoSender)
     {
         return nullptr;
     }
@@ -750,6 +1128,7 @@ TSharedPtr<FJsonObject> URshipIPMXService::BuildFlowJson(const FString& SenderId
     Data->SetStringField(TEXT("label"), FString::Printf(TEXT("Flow for %s"), *Sender->Label));
     Data->SetStringField(TEXT("description"), TEXT("Video flow"));
     Data->SetStringField(TEXT("format"), TEXT("urn:x-nmos:format:video"));
+    Data->SetStringField(TEXT("source_id"), SenderState->SourceId);
     Data->SetStringField(TEXT("device_id"), DeviceId);
 
     // Video format info
@@ -757,6 +1136,9 @@ TSharedPtr<FJsonObject> URshipIPMXService::BuildFlowJson(const FString& SenderId
     Data->SetNumberField(TEXT("frame_width"), Format.Width);
     Data->SetNumberField(TEXT("frame_height"), Format.Height);
     Data->SetStringField(TEXT("colorspace"), Format.GetColorimetryString());
+    Data->SetStringField(TEXT("transfer_characteristic"), Format.GetTransferCharacteristicString());
+    Data->SetStringField(TEXT("interlace_mode"), Format.bInterlaced ? TEXT("interlaced_tff") : TEXT("progressive"));
+    Data->SetArrayField(TEXT("components"), BuildComponentsJson(Format));
 
     // Frame rate
     TSharedPtr<FJsonObject> FrameRate = MakeShareable(new FJsonObject());
@@ -766,7 +1148,7 @@ TSharedPtr<FJsonObject> URshipIPMXService::BuildFlowJson(const FString& SenderId
 
     Data->SetStringField(TEXT("media_type"), TEXT("video/raw"));
 
-    Data->SetArrayField(TEXT("tags"), TArray<TSharedPtr<FJsonValue>>());
+    Data->SetObjectField(TEXT("tags"), MakeShareable(new FJsonObject()));
     Data->SetArrayField(TEXT("parents"), TArray<TSharedPtr<FJsonValue>>());
 
     Flow->SetObjectField(TEXT("data"), Data);
@@ -776,7 +1158,8 @@ TSharedPtr<FJsonObject> URshipIPMXService::BuildFlowJson(const FString& SenderId
 TSharedPtr<FJsonObject> URshipIPMXService::BuildSenderJson(const FString& SenderId) const
 {
     const FRshipNMOSSender* Sender = RegisteredSenders.Find(SenderId);
-    if (!Sender)
+    const FSenderState* SenderState = SenderStates.Find(SenderId);
+    if (!Sender || !SenderState)
     {
         return nullptr;
     }
@@ -793,13 +1176,25 @@ TSharedPtr<FJsonObject> URshipIPMXService::BuildSenderJson(const FString& Sender
     Data->SetStringField(TEXT("transport"), Sender->Transport);
     Data->SetStringField(TEXT("device_id"), DeviceId);
     Data->SetStringField(TEXT("manifest_href"), GetSenderManifestUrl(SenderId));
+    Data->SetObjectField(TEXT("caps"), MakeShareable(new FJsonObject()));
 
     // Interface bindings
     Data->SetArrayField(TEXT("interface_bindings"), TArray<TSharedPtr<FJsonValue>>());
-    Data->SetArrayField(TEXT("tags"), TArray<TSharedPtr<FJsonValue>>());
+    Data->SetObjectField(TEXT("tags"), MakeShareable(new FJsonObject()));
 
-    // Subscription (null when not subscribed)
-    Data->SetObjectField(TEXT("subscription"), MakeShareable(new FJsonObject()));
+    // Subscription mirrors the IS-05 active parameters
+    const FRshipNMOSSenderParams& Active = SenderState->Connection.GetActive();
+    TSharedPtr<FJsonObject> Subscription = MakeShareable(new FJsonObject());
+    if (Active.ReceiverId.IsEmpty())
+    {
+        Subscription->SetField(TEXT("receiver_id"), MakeShareable(new FJsonValueNull()));
+    }
+    else
+    {
+        Subscription->SetStringField(TEXT("receiver_id"), Active.ReceiverId);
+    }
+    Subscription->SetBoolField(TEXT("active"), Active.bMasterEnable);
+    Data->SetObjectField(TEXT("subscription"), Subscription);
 
     SenderObj->SetObjectField(TEXT("data"), Data);
     return SenderObj;
@@ -817,92 +1212,396 @@ bool URshipIPMXService::DiscoverRegistryViaMDNS()
     return false;
 }
 
-void URshipIPMXService::HandleAPIRequest(const FString& Path, const FString& Method, const FString& Body, FString& OutResponse)
+// ============================================================================
+// LOCAL API
+// ============================================================================
+
+bool URshipIPMXService::HandleHttpRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete, FString Route)
+{
+    // RelativePath is relative to the bound route
+    const FString Path = Route + Request.RelativePath.GetPath();
+
+    FString Body;
+    if (Request.Body.Num() > 0)
+    {
+        FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Request.Body.GetData()), Request.Body.Num());
+        Body = FString(Converter.Length(), Converter.Get());
+    }
+
+    FString Response;
+    FString ContentType = TEXT("application/json");
+    const int32 Code = HandleAPIRequest(Path, VerbToString(Request.Verb), Body, Response, ContentType);
+
+    UE_LOG(LogRship2110, Verbose, TEXT("IPMXService: %s %s -> %d"), *VerbToString(Request.Verb), *Path, Code);
+
+    // 423 Locked has no EHttpServerResponseCodes enumerator; the code is sent as is
+    TUniquePtr<FHttpServerResponse> HttpResponse = FHttpServerResponse::Create(Response, ContentType);
+    HttpResponse->Code = static_cast<EHttpServerResponseCodes>(Code);
+    OnComplete(MoveTemp(HttpResponse));
+    return true;
+}
+
+int32 URshipIPMXService::HandleAPIRequest(const FString& Path, const FString& Method, const FString& Body, FString& OutResponse, FString& OutContentType)
 {
-    // Handle local IS-04 Node API requests
-    if (Path.StartsWith(TEXT("/x-nmos/node/v1.3")))
+    TArray<FString> Segments;
+    Path.ParseIntoArray(Segments, TEXT("/"), true);
+
+    if (Segments.Num() < 2 || Segments[0] != TEXT("x-nmos"))
     {
-        OutResponse = HandleNodeAPI(Path);
+        return MakeError(404, TEXT("Not Found"), OutResponse);
     }
-    else
+
+    const FString Api = Segments[1];
+    Segments.RemoveAt(0, 2);
+
+    if (Api == TEXT("node"))
+    {
+        if (Method != TEXT("GET"))
+        {
+            return MakeError(405, TEXT("Node API is read-only"), OutResponse);
+        }
+        return HandleNodeAPI(Segments, OutResponse, OutContentType);
+    }
+    if (Api == TEXT("connection"))
     {
-        OutResponse = TEXT("{\"error\": \"Not Found\"}");
+        return HandleConnectionAPI(Segments, Method, Body, OutResponse, OutContentType);
     }
+
+    return MakeError(404, TEXT("Not Found"), OutResponse);
 }
 
-FString URshipIPMXService::HandleNodeAPI(const FString& Path) const
+int32 URshipIPMXService::HandleNodeAPI(const TArray<FString>& Segments, FString& OutResponse, FString& OutContentType) const
 {
     // IS-04 Node API endpoints
-    if (Path.EndsWith(TEXT("/self")))
+    if (Segments.Num() == 0)
+    {
+        OutResponse = MakeListing({TEXT("v1.3/")});
+        return 200;
+    }
+    if (Segments[0] != NodeAPIVersion)
+    {
+        return MakeError(404, FString::Printf(TEXT("Node API version %s is not served"), *Segments[0]), OutResponse);
+    }
+    if (Segments.Num() == 1)
     {
-        // Return node info
-        TSharedPtr<FJsonObject> NodeJson = BuildNodeJson();
-        if (NodeJson.IsValid())
+        OutResponse = MakeListing({TEXT("self/"), TEXT("sources/"), TEXT("flows/"), TEXT("devices/"), TEXT("senders/"), TEXT("receivers/")});
+        return 200;
+    }
+
+    const FString& ResourceType = Segments[1];
+    if (ResourceType == TEXT("self") && Segments.Num() == 2)
+    {
+        OutResponse = ToJsonString(BuildNodeJson()->GetObjectField(TEXT("data")));
+        return 200;
+    }
+
+    // Sender manifest, as advertised in manifest_href
+    if (ResourceType == TEXT("senders") && Segments.Num() == 4 && Segments[3] == TEXT("sdp"))
+    {
+        OutResponse = GetSenderSDP(Segments[2]);
+        if (OutResponse.IsEmpty())
+        {
+            return MakeError(404, TEXT("Sender not found"), OutResponse);
+        }
+        OutContentType = TEXT("application/sdp");
+        return 200;
+    }
+
+    TArray<TSharedPtr<FJsonObject>> Resources;
+    if (Segments.Num() > 3 || !GetNodeResources(ResourceType, Resources))
+    {
+        return MakeError(404, TEXT("Not Found"), OutResponse);
+    }
+
+    if (Segments.Num() == 2)
+    {
+        TArray<TSharedPtr<FJsonValue>> List;
+        for (const TSharedPtr<FJsonObject>& Resource : Resources)
         {
-            FString Result;
-            TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Result);
-            FJsonSerializer::Serialize(NodeJson->GetObjectField(TEXT("data")).ToSharedRef(), Writer);
-            return Result;
+            List.Add(MakeShareable(new FJsonValueObject(Resource)));
         }
+        OutResponse = ToJsonString(List);
+        return 200;
     }
-    else if (Path.Contains(TEXT("/senders")))
+
+    for (const TSharedPtr<FJsonObject>& Resource : Resources)
     {
-        return HandleSendersAPI(Path);
+        if (Resource->GetStringField(TEXT("id")) == Segments[2])
+        {
+            OutResponse = ToJsonString(Resource);
+            return 200;
+        }
     }
 
-    return TEXT("{}");
+    return MakeError(404, FString::Printf(TEXT("No %s with id %s"), *ResourceType, *Segments[2]), OutResponse);
 }
 
-FString URshipIPMXService::HandleSendersAPI(const FString& Path) const
+bool URshipIPMXService::GetNodeResources(const FString& ResourceType, TArray<TSharedPtr<FJsonObject>>& OutResources) const
 {
-    // Check if requesting specific sender
-    int32 SendersIndex = Path.Find(TEXT("/senders/"));
-    if (SendersIndex != INDEX_NONE)
+    // Resource bodies as registered, without the registration wrapper
+    auto AddData = [&OutResources](const TSharedPtr<FJsonObject>& Resource)
     {
-        FString Remainder = Path.Mid(SendersIndex + 9);
-        int32 SlashIndex;
-        if (Remainder.FindChar('/', SlashIndex))
+        if (Resource.IsValid())
         {
-            FString SenderId = Remainder.Left(SlashIndex);
-            if (Remainder.EndsWith(TEXT("/sdp")))
+            OutResources.Add(Resource->GetObjectField(TEXT("data")));
+        }
+    };
+
+    if (ResourceType == TEXT("devices"))
+    {
+        AddData(BuildDeviceJson());
+    }
+    else if (ResourceType == TEXT("senders"))
+    {
+        for (const TPair<FString, FRshipNMOSSender>& Pair : RegisteredSenders)
+        {
+            AddData(BuildSenderJson(Pair.Key));
+        }
+    }
+    else if (ResourceType == TEXT("sources") || ResourceType == TEXT("flows"))
+    {
+        const bool bSources = ResourceType == TEXT("sources");
+        for (const TPair<FString, FSenderState>& Pair : SenderStates)
+        {
+            if (URship2110VideoSender* VideoSender = Pair.Value.VideoSender.Get())
             {
-                // Return SDP
-                return GetSenderSDP(SenderId);
+                AddData(bSources ? BuildSourceJson(Pair.Key, VideoSender) : BuildFlowJson(Pair.Key, VideoSender));
             }
-            return HandleSingleSenderAPI(SenderId);
         }
-        else
+    }
+    else if (ResourceType != TEXT("receivers"))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+int32 URshipIPMXService::HandleConnectionAPI(const TArray<FString>& Segments, const FString& Method, const FString& Body, FString& OutResponse, FString& OutContentType)
+{
+    // IS-05 Connection API endpoints; everything but staged and bulk is read-only
+    const int32 Depth = Segments.Num();
+    const bool bGet = Method == TEXT("GET");
+
+    auto Listing = [&](std::initializer_list<const TCHAR*> Entries)
+    {
+        if (!bGet)
         {
-            return HandleSingleSenderAPI(Remainder);
+            return MakeError(405, TEXT("Method not allowed"), OutResponse);
         }
+        OutResponse = MakeListing(Entries);
+        return 200;
+    };
+
+    if (Depth == 0)
+    {
+        return Listing({TEXT("v1.1/")});
+    }
+    if (Segments[0] != ConnectionAPIVersion)
+    {
+        return MakeError(404, FString::Printf(TEXT("Connection API version %s is not served"), *Segments[0]), OutResponse);
+    }
+    if (Depth == 1)
+    {
+        return Listing({TEXT("bulk/"), TEXT("single/")});
     }
 
-    // Return list of all senders
-    TArray<TSharedPtr<FJsonValue>> SenderList;
-    for (const auto& Pair : RegisteredSenders)
+    if (Segments[1] == TEXT("bulk"))
     {
-        TSharedPtr<FJsonObject> SenderJson = BuildSenderJson(Pair.Key);
-        if (SenderJson.IsValid())
+        if (Depth == 2)
+        {
+            return Listing({TEXT("senders/"), TEXT("receivers/")});
+        }
+        if (Depth == 3 && (Segments[2] == TEXT("senders") || Segments[2] == TEXT("receivers")))
+        {
+            if (Method != TEXT("POST"))
+            {
+                return MakeError(405, TEXT("Bulk endpoints take POST"), OutResponse);
+            }
+            return HandleBulkRequest(Segments[2] == TEXT("senders"), Body, OutResponse);
+        }
+    }
+    else if (Segments[1] == TEXT("single"))
+    {
+        if (Depth == 2)
+        {
+            return Listing({TEXT("senders/"), TEXT("receivers/")});
+        }
+        if (Segments[2] == TEXT("receivers") && Depth == 3)
         {
-            SenderList.Add(MakeShareable(new FJsonValueObject(SenderJson->GetObjectField(TEXT("data")))));
+            return Listing({});
+        }
+        if (Segments[2] == TEXT("senders"))
+        {
+            if (Depth == 3)
+            {
+                if (!bGet)
+                {
+                    return MakeError(405, TEXT("Method not allowed"), OutResponse);
+                }
+
+                TArray<TSharedPtr<FJsonValue>> Ids;
+                for (const TPair<FString, FRshipNMOSSender>& Pair : RegisteredSenders)
+                {
+                    Ids.Add(MakeShareable(new FJsonValueString(Pair.Key + TEXT("/"))));
+                }
+                OutResponse = ToJsonString(Ids);
+                return 200;
+            }
+            if (Depth <= 5)
+            {
+                return HandleSenderConnectionAPI(Segments[3], Depth == 5 ? Segments[4] : FString(), Method, Body, OutResponse, OutContentType);
+            }
         }
     }
 
-    FString Result;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Result);
-    FJsonSerializer::Serialize(SenderList, Writer);
-    return Result;
+    return MakeError(404, TEXT("Not Found"), OutResponse);
 }
 
-FString URshipIPMXService::HandleSingleSenderAPI(const FString& SenderId) const
+int32 URshipIPMXService::HandleSenderConnectionAPI(const FString& SenderId, const FString& Resource, const FString& Method, const FString& Body, FString& OutResponse, FString& OutContentType)
 {
-    TSharedPtr<FJsonObject> SenderJson = BuildSenderJson(SenderId);
-    if (SenderJson.IsValid())
+    FSenderState* SenderState = SenderStates.Find(SenderId);
+    if (!SenderState)
     {
-        FString Result;
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Result);
-        FJsonSerializer::Serialize(SenderJson->GetObjectField(TEXT("data")).ToSharedRef(), Writer);
-        return Result;
+        return MakeError(404, FString::Printf(TEXT("No sender with id %s"), *SenderId), OutResponse);
+    }
+
+    if (Resource == TEXT("staged") && Method == TEXT("PATCH"))
+    {
+        TSharedPtr<FJsonObject> Patch;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Body);
+        if (!FJsonSerializer::Deserialize(Reader, Patch) || !Patch.IsValid())
+        {
+            return MakeError(400, TEXT("Body must be a JSON object"), OutResponse);
+        }
+
+        TSharedPtr<FJsonObject> Staged;
+        FString Error;
+        const int32 Code = PatchSenderStaged(SenderId, Patch, Staged, Error);
+        if (Code >= 400)
+        {
+            return MakeError(Code, Error, OutResponse);
+        }
+
+        OutResponse = ToJsonString(Staged);
+        return Code;
+    }
+
+    if (Method != TEXT("GET"))
+    {
+        return MakeError(405, TEXT("Method not allowed"), OutResponse);
+    }
+
+    if (Resource.IsEmpty())
+    {
+        OutResponse = MakeListing({TEXT("constraints/"), TEXT("staged/"), TEXT("active/"), TEXT("transportfile/"), TEXT("transporttype/")});
+        return 200;
+    }
+    if (Resource == TEXT("staged"))
+    {
+        OutResponse = ToJsonString(SenderState->Connection.GetStagedJson());
+        return 200;
     }
-    return TEXT("{\"error\": \"Sender not found\"}");
+    if (Resource == TEXT("active"))
+    {
+        OutResponse = ToJsonString(SenderState->Connection.GetActiveJson());
+        return 200;
+    }
+    if (Resource == TEXT("constraints"))
+    {
+        OutResponse = ToJsonString(FRshipNMOSSenderConnection::GetConstraintsJson());
+        return 200;
+    }
+    if (Resource == TEXT("transporttype"))
+    {
+        OutResponse = FString::Printf(TEXT("\"%s\""), *RegisteredSenders[SenderId].Transport);
+        return 200;
+    }
+    if (Resource == TEXT("transportfile"))
+    {
+        OutResponse = GetSenderSDP(SenderId);
+        if (OutResponse.IsEmpty())
+        {
+            return MakeError(404, TEXT("Sender has no stream"), OutResponse);
+        }
+        OutContentType = TEXT("application/sdp");
+        return 200;
+    }
+
+    return MakeError(404, TEXT("Not Found"), OutResponse);
+}
+
+int32 URshipIPMXService::HandleBulkRequest(bool bSenders, const FString& Body, FString& OutResponse)
+{
+    TArray<TSharedPtr<FJsonValue>> Entries;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Body);
+    if (!FJsonSerializer::Deserialize(Reader, Entries))
+    {
+        return MakeError(400, TEXT("Body must be an array of {id, params}"), OutResponse);
+    }
+
+    // Each entry succeeds or fails on its own, reported in request order
+    TArray<TSharedPtr<FJsonValue>> Results;
+    for (const TSharedPtr<FJsonValue>& Entry : Entries)
+    {
+        const TSharedPtr<FJsonObject>* EntryObject = nullptr;
+        FString Id;
+        int32 Code = 400;
+        FString Error = TEXT("Entries need id and params");
+
+        if (Entry->TryGetObject(EntryObject) && (*EntryObject)->TryGetStringField(TEXT("id"), Id) &&
+            (*EntryObject)->HasTypedField<EJson::Object>(TEXT("params")))
+        {
+            if (bSenders)
+            {
+                TSharedPtr<FJsonObject> Staged;
+                Code = PatchSenderStaged(Id, (*EntryObject)->GetObjectField(TEXT("params")), Staged, Error);
+            }
+            else
+            {
+                Code = 404;
+                Error = FString::Printf(TEXT("No receiver with id %s"), *Id);
+            }
+        }
+
+        TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject());
+        Result->SetStringField(TEXT("id"), Id);
+        Result->SetNumberField(TEXT("code"), Code);
+        if (Code >= 400)
+        {
+            Result->SetStringField(TEXT("error"), Error);
+            Result->SetField(TEXT("debug"), MakeShareable(new FJsonValueNull()));
+        }
+        Results.Add(MakeShareable(new FJsonValueObject(Result)));
+    }
+
+    OutResponse = ToJsonString(Results);
+    return 200;
+}
+
+int32 URshipIPMXService::PatchSenderStaged(const FString& SenderId, const TSharedPtr<FJsonObject>& Patch, TSharedPtr<FJsonObject>& OutStaged, FString& OutError)
+{
+    FSenderState* SenderState = SenderStates.Find(SenderId);
+    if (!SenderState)
+    {
+        OutError = FString::Printf(TEXT("No sender with id %s"), *SenderId);
+        return 404;
+    }
+
+    const int32 Code = SenderState->Connection.PatchStaged(Patch, GetActivationClock(), OutError);
+    if (Code >= 400)
+    {
+        return Code;
+    }
+
+    // The response carries the activation as requested; an immediate one has completed by then
+    OutStaged = SenderState->Connection.GetStagedJson();
+    if (SenderState->Connection.GetStaged().Activation.Mode == ERshipNMOSActivationMode::Immediate &&
+        !ActivateStaged(SenderId))
+    {
+        OutError = TEXT("Sender could not apply the staged parameters");
+        return 500;
+    }
+
+    return Code;
 }
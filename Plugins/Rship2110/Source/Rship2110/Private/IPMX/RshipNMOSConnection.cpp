@@ -0,0 +1,476 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "IPMX/RshipNMOSConnection.h"
+#include "Interfaces/IPv4/IPv4Address.h"
+
+namespace
+{
+    /** Port range allowed by FRship2110TransportParams and advertised in the constraints */
+    constexpr int32 MinPort = 1024;
+    constexpr int32 MaxPort = 65535;
+
+    constexpr uint64 NanosecondsPerSecond = 1000000000ULL;
+
+    const TCHAR* ActivationModeToString(ERshipNMOSActivationMode Mode)
+    {
+        switch (Mode)
+        {
+            case ERshipNMOSActivationMode::Immediate: return TEXT("activate_immediate");
+            case ERshipNMOSActivationMode::ScheduledAbsolute: return TEXT("activate_scheduled_absolute");
+            case ERshipNMOSActivationMode::ScheduledRelative: return TEXT("activate_scheduled_relative");
+            default: return nullptr;
+        }
+    }
+
+    TSharedPtr<FJsonValue> StringOrNull(const FString& Value)
+    {
+        if (Value.IsEmpty())
+        {
+            return MakeShared<FJsonValueNull>();
+        }
+        return MakeShared<FJsonValueString>(Value);
+    }
+
+    TSharedPtr<FJsonValue> AddressOrAuto(const FString& Address)
+    {
+        return MakeShared<FJsonValueString>(Address.IsEmpty() ? FString(TEXT("auto")) : Address);
+    }
+
+    TSharedPtr<FJsonValue> PortOrAuto(int32 Port)
+    {
+        if (Port == FRshipNMOSSenderTransport::AutoPort)
+        {
+            return MakeShared<FJsonValueString>(TEXT("auto"));
+        }
+        return MakeShared<FJsonValueNumber>(Port);
+    }
+
+    bool ParseAddress(const FString& Key, const FJsonValue& Value, FString& OutAddress, FString& OutError)
+    {
+        FString Text;
+        if (Value.Type != EJson::String || !Value.TryGetString(Text))
+        {
+            OutError = FString::Printf(TEXT("%s must be a string"), *Key);
+            return false;
+        }
+
+        if (Text == TEXT("auto"))
+        {
+            OutAddress.Empty();
+            return true;
+        }
+
+        FIPv4Address Address;
+        if (!FIPv4Address::Parse(Text, Address))
+        {
+            OutError = FString::Printf(TEXT("%s '%s' is not an IPv4 address"), *Key, *Text);
+            return false;
+        }
+
+        OutAddress = Text;
+        return true;
+    }
+
+    bool ParsePort(const FString& Key, const FJsonValue& Value, int32& OutPort, FString& OutError)
+    {
+        FString Text;
+        if (Value.TryGetString(Text) && Text == TEXT("auto"))
+        {
+            OutPort = FRshipNMOSSenderTransport::AutoPort;
+            return true;
+        }
+
+        double Number = 0.0;
+        if (Value.Type != EJson::Number || !Value.TryGetNumber(Number) ||
+            Number != FMath::FloorToDouble(Number) || Number < MinPort || Number > MaxPort)
+        {
+            OutError = FString::Printf(TEXT("%s must be \"auto\" or an integer in [%d, %d]"), *Key, MinPort, MaxPort);
+            return false;
+        }
+
+        OutPort = static_cast<int32>(Number);
+        return true;
+    }
+
+    TSharedPtr<FJsonObject> MakeRangeConstraint(int32 Minimum, int32 Maximum)
+    {
+        TSharedPtr<FJsonObject> Constraint = MakeShared<FJsonObject>();
+        Constraint->SetNumberField(TEXT("minimum"), Minimum);
+        Constraint->SetNumberField(TEXT("maximum"), Maximum);
+        return Constraint;
+    }
+}
+
+// ============================================================================
+// TRANSPORT
+// ============================================================================
+
+FRshipNMOSSenderTransport FRshipNMOSSenderTransport::FromParams(const FRship2110TransportParams& Params)
+{
+    FRshipNMOSSenderTransport Transport;
+    Transport.SourceIP = Params.SourceIP;
+    Transport.DestinationIP = Params.DestinationIP;
+    Transport.SourcePort = Params.SourcePort;
+    Transport.DestinationPort = Params.DestinationPort;
+    return Transport;
+}
+
+// ============================================================================
+// SENDER CONNECTION
+// ============================================================================
+
+void FRshipNMOSSenderConnection::Initialize(const FRship2110TransportParams& Params)
+{
+    Staged = FRshipNMOSSenderParams();
+    Staged.Transport = FRshipNMOSSenderTransport::FromParams(Params);
+    Active = Staged;
+}
+
+int32 FRshipNMOSSenderConnection::PatchStaged(const TSharedPtr<FJsonObject>& Patch, const FRshipPTPTimestamp& Now, FString& OutError)
+{
+    if (!Patch.IsValid())
+    {
+        OutError = TEXT("Body must be a JSON object");
+        return 400;
+    }
+
+    // Work on a copy so a bad request leaves the staged parameters untouched
+    FRshipNMOSSenderParams Next = Staged;
+    bool bHasActivation = false;
+
+    for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Patch->Values)
+    {
+        const FString& Key = Pair.Key;
+        const FJsonValue& Value = *Pair.Value;
+
+        if (Key == TEXT("receiver_id"))
+        {
+            if (Value.IsNull())
+            {
+                Next.ReceiverId.Empty();
+            }
+            else if (Value.Type == EJson::String)
+            {
+                Next.ReceiverId = Value.AsString();
+            }
+            else
+            {
+                OutError = TEXT("receiver_id must be a string or null");
+                return 400;
+            }
+        }
+        else if (Key == TEXT("master_enable"))
+        {
+            if (Value.Type != EJson::Boolean)
+            {
+                OutError = TEXT("master_enable must be a boolean");
+                return 400;
+            }
+            Next.bMasterEnable = Value.AsBool();
+        }
+        else if (Key == TEXT("activation"))
+        {
+            if (Value.Type != EJson::Object || !ParseActivation(*Value.AsObject(), Now, Next.Activation, OutError))
+            {
+                if (OutError.IsEmpty())
+                {
+                    OutError = TEXT("activation must be an object");
+                }
+                return 400;
+            }
+            bHasActivation = true;
+        }
+        else if (Key == TEXT("transport_params"))
+        {
+            if (Value.Type != EJson::Array)
+            {
+                OutError = TEXT("transport_params must be an array");
+                return 400;
+            }
+
+            const TArray<TSharedPtr<FJsonValue>>& Legs = Value.AsArray();
+            if (Legs.Num() != 1 || Legs[0]->Type != EJson::Object)
+            {
+                OutError = TEXT("transport_params must hold one object per leg (this sender has one leg)");
+                return 400;
+            }
+
+            if (!ParseTransportLeg(*Legs[0]->AsObject(), Next.Transport, OutError))
+            {
+                return 400;
+            }
+        }
+        else
+        {
+            OutError = FString::Printf(TEXT("Unknown parameter '%s'"), *Key);
+            return 400;
+        }
+    }
+
+    // A scheduled activation locks the staged parameters until it fires or is cancelled
+    if (Staged.Activation.IsScheduled())
+    {
+        const bool bCancels = bHasActivation && Next.Activation.Mode == ERshipNMOSActivationMode::None;
+        if (!bCancels)
+        {
+            OutError = FString::Printf(TEXT("Activation scheduled for %s is pending"),
+                                       *FormatTime(Staged.Activation.ActivationTime));
+            return 423;
+        }
+    }
+
+    Staged = MoveTemp(Next);
+    return Staged.Activation.IsScheduled() ? 202 : 200;
+}
+
+bool FRshipNMOSSenderConnection::IsActivationDue(const FRshipPTPTimestamp& Now) const
+{
+    return Staged.Activation.Mode != ERshipNMOSActivationMode::None &&
+           Staged.Activation.bHasActivationTime &&
+           Now.ToNanoseconds() >= Staged.Activation.ActivationTime.ToNanoseconds();
+}
+
+FRship2110TransportParams FRshipNMOSSenderConnection::ResolveTransport(const FRship2110TransportParams& Current) const
+{
+    // "auto" keeps whatever the stream already uses
+    FRship2110TransportParams Resolved = Current;
+    const FRshipNMOSSenderTransport& Transport = Staged.Transport;
+
+    if (!Transport.SourceIP.IsEmpty())
+    {
+        Resolved.SourceIP = Transport.SourceIP;
+    }
+    if (!Transport.DestinationIP.IsEmpty())
+    {
+        Resolved.DestinationIP = Transport.DestinationIP;
+    }
+    if (Transport.SourcePort != FRshipNMOSSenderTransport::AutoPort)
+    {
+        Resolved.SourcePort = Transport.SourcePort;
+    }
+    if (Transport.DestinationPort != FRshipNMOSSenderTransport::AutoPort)
+    {
+        Resolved.DestinationPort = Transport.DestinationPort;
+    }
+
+    return Resolved;
+}
+
+void FRshipNMOSSenderConnection::CompleteActivation(const FRship2110TransportParams& Resolved)
+{
+    Active.ReceiverId = Staged.ReceiverId;
+    Active.bMasterEnable = Staged.bMasterEnable;
+    Active.Activation = Staged.Activation;
+    Active.Transport = FRshipNMOSSenderTransport::FromParams(Resolved);
+    Active.Transport.bRTPEnabled = Staged.Transport.bRTPEnabled;
+
+    Staged.Activation = FRshipNMOSActivation();
+}
+
+void FRshipNMOSSenderConnection::CancelActivation()
+{
+    Staged.Activation = FRshipNMOSActivation();
+}
+
+void FRshipNMOSSenderConnection::SetActiveTransport(const FRship2110TransportParams& Params)
+{
+    const bool bRTPEnabled = Active.Transport.bRTPEnabled;
+    Active.Transport = FRshipNMOSSenderTransport::FromParams(Params);
+    Active.Transport.bRTPEnabled = bRTPEnabled;
+}
+
+void FRshipNMOSSenderConnection::SetActiveEnabled(bool bEnabled)
+{
+    Active.bMasterEnable = bEnabled;
+}
+
+TArray<TSharedPtr<FJsonValue>> FRshipNMOSSenderConnection::GetConstraintsJson()
+{
+    // Empty constraints mean any value the schema allows
+    TSharedPtr<FJsonObject> Leg = MakeShared<FJsonObject>();
+    Leg->SetObjectField(TEXT("source_ip"), MakeShared<FJsonObject>());
+    Leg->SetObjectField(TEXT("destination_ip"), MakeShared<FJsonObject>());
+    Leg->SetObjectField(TEXT("source_port"), MakeRangeConstraint(MinPort, MaxPort));
+    Leg->SetObjectField(TEXT("destination_port"), MakeRangeConstraint(MinPort, MaxPort));
+    Leg->SetObjectField(TEXT("rtp_enabled"), MakeShared<FJsonObject>());
+
+    TArray<TSharedPtr<FJsonValue>> Legs;
+    Legs.Add(MakeShared<FJsonValueObject>(Leg));
+    return Legs;
+}
+
+bool FRshipNMOSSenderConnection::ParseTime(const FString& Text, FRshipPTPTimestamp& OutTime)
+{
+    FString SecondsText;
+    FString NanosecondsText;
+    if (!Text.Split(TEXT(":"), &SecondsText, &NanosecondsText))
+    {
+        return false;
+    }
+
+    auto IsDigits = [](const FString& Part, int32 MaxDigits)
+    {
+        if (Part.IsEmpty() || Part.Len() > MaxDigits)
+        {
+            return false;
+        }
+        for (TCHAR Char : Part)
+        {
+            if (!FChar::IsDigit(Char))
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // Nine digits of nanoseconds; seconds short enough not to overflow
+    if (!IsDigits(SecondsText, 18) || !IsDigits(NanosecondsText, 9))
+    {
+        return false;
+    }
+
+    OutTime.Seconds = FCString::Atoi64(*SecondsText);
+    OutTime.Nanoseconds = FCString::Atoi(*NanosecondsText);
+    return true;
+}
+
+FString FRshipNMOSSenderConnection::FormatTime(const FRshipPTPTimestamp& Time)
+{
+    return FString::Printf(TEXT("%lld:%d"), Time.Seconds, Time.Nanoseconds);
+}
+
+bool FRshipNMOSSenderConnection::ParseTransportLeg(const FJsonObject& Leg, FRshipNMOSSenderTransport& InOutTransport, FString& OutError)
+{
+    for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Leg.Values)
+    {
+        const FString& Key = Pair.Key;
+        const FJsonValue& Value = *Pair.Value;
+
+        bool bParsed = false;
+        if (Key == TEXT("source_ip"))
+        {
+            bParsed = ParseAddress(Key, Value, InOutTransport.SourceIP, OutError);
+        }
+        else if (Key == TEXT("destination_ip"))
+        {
+            bParsed = ParseAddress(Key, Value, InOutTransport.DestinationIP, OutError);
+        }
+        else if (Key == TEXT("source_port"))
+        {
+            bParsed = ParsePort(Key, Value, InOutTransport.SourcePort, OutError);
+        }
+        else if (Key == TEXT("destination_port"))
+        {
+            bParsed = ParsePort(Key, Value, InOutTransport.DestinationPort, OutError);
+        }
+        else if (Key == TEXT("rtp_enabled"))
+        {
+            bParsed = Value.Type == EJson::Boolean;
+            if (bParsed)
+            {
+                InOutTransport.bRTPEnabled = Value.AsBool();
+            }
+            else
+            {
+                OutError = TEXT("rtp_enabled must be a boolean");
+            }
+        }
+        else
+        {
+            OutError = FString::Printf(TEXT("Unsupported transport parameter '%s'"), *Key);
+        }
+
+        if (!bParsed)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool FRshipNMOSSenderConnection::ParseActivation(const FJsonObject& Json, const FRshipPTPTimestamp& Now,
+                                                 FRshipNMOSActivation& OutActivation, FString& OutError)
+{
+    FRshipNMOSActivation Activation;
+
+    // A null mode clears the staged activation, cancelling one that is scheduled
+    const TSharedPtr<FJsonValue>* ModeValue = Json.Values.Find(TEXT("mode"));
+    if (!ModeValue || (*ModeValue)->IsNull())
+    {
+        OutActivation = Activation;
+        return true;
+    }
+
+    FString Mode;
+    (*ModeValue)->TryGetString(Mode);
+    if (Mode == TEXT("activate_immediate"))
+    {
+        Activation.Mode = ERshipNMOSActivationMode::Immediate;
+        Activation.ActivationTime = Now;
+        Activation.bHasActivationTime = true;
+        OutActivation = Activation;
+        return true;
+    }
+    else if (Mode == TEXT("activate_scheduled_absolute"))
+    {
+        Activation.Mode = ERshipNMOSActivationMode::ScheduledAbsolute;
+    }
+    else if (Mode == TEXT("activate_scheduled_relative"))
+    {
+        Activation.Mode = ERshipNMOSActivationMode::ScheduledRelative;
+    }
+    else
+    {
+        OutError = TEXT("activation mode must be null, activate_immediate, activate_scheduled_absolute or activate_scheduled_relative");
+        return false;
+    }
+
+    const TSharedPtr<FJsonValue>* TimeValue = Json.Values.Find(TEXT("requested_time"));
+    FRshipPTPTimestamp Requested;
+    if (!TimeValue || !(*TimeValue)->TryGetString(Activation.RequestedTime) ||
+        !ParseTime(Activation.RequestedTime, Requested))
+    {
+        OutError = TEXT("Scheduled activations need requested_time as \"seconds:nanoseconds\"");
+        return false;
+    }
+
+    // Absolute times in the past activate on the next check
+    Activation.ActivationTime = Activation.Mode == ERshipNMOSActivationMode::ScheduledRelative
+        ? FRshipPTPTimestamp::FromNanoseconds(Now.ToNanoseconds() + Requested.ToNanoseconds())
+        : Requested;
+    Activation.bHasActivationTime = true;
+
+    OutActivation = Activation;
+    return true;
+}
+
+TSharedPtr<FJsonObject> FRshipNMOSSenderConnection::ParamsToJson(const FRshipNMOSSenderParams& Params)
+{
+    TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetField(TEXT("receiver_id"), StringOrNull(Params.ReceiverId));
+    Json->SetBoolField(TEXT("master_enable"), Params.bMasterEnable);
+
+    TSharedPtr<FJsonObject> Activation = MakeShared<FJsonObject>();
+    const TCHAR* Mode = ActivationModeToString(Params.Activation.Mode);
+    Activation->SetField(TEXT("mode"), StringOrNull(Mode ? FString(Mode) : FString()));
+    Activation->SetField(TEXT("requested_time"), StringOrNull(Params.Activation.RequestedTime));
+    Activation->SetField(TEXT("activation_time"), StringOrNull(
+        Params.Activation.bHasActivationTime ? FormatTime(Params.Activation.ActivationTime) : FString()));
+    Json->SetObjectField(TEXT("activation"), Activation);
+
+    const FRshipNMOSSenderTransport& Transport = Params.Transport;
+    TSharedPtr<FJsonObject> Leg = MakeShared<FJsonObject>();
+    Leg->SetField(TEXT("source_ip"), AddressOrAuto(Transport.SourceIP));
+    Leg->SetField(TEXT("destination_ip"), AddressOrAuto(Transport.DestinationIP));
+    Leg->SetField(TEXT("source_port"), PortOrAuto(Transport.SourcePort));
+    Leg->SetField(TEXT("destination_port"), PortOrAuto(Transport.DestinationPort));
+    Leg->SetBoolField(TEXT("rtp_enabled"), Transport.bRTPEnabled);
+
+    TArray<TSharedPtr<FJsonValue>> Legs;
+    Legs.Add(MakeShared<FJsonValueObject>(Leg));
+    Json->SetArrayField(TEXT("transport_params"), Legs);
+
+    return Json;
+}
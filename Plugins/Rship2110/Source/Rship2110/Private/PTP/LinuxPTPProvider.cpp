@@ -0,0 +1,731 @@
+// Copyright Rocketship. All Rights Reserved.
+// Linux PTP Provider Implementation
+//
+// Runs FRshipPTPSlave on UDP sockets with kernel timestamps. With a NIC
+// that timestamps PTP (SIOCSHWTSTAMP) and exposes a PTP hardware clock,
+// receive and transmit times come from the NIC and the PHC is the local
+// clock; otherwise the kernel's software timestamps and CLOCK_REALTIME
+// are used. The system clock is never steered: PTP time is read through
+// the slave's clock model.
+
+#include "PTP/IPTPProvider.h"
+#include "PTP/RshipPTPSlave.h"
+#include "Rship2110.h"
+#include "Rship2110Settings.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+
+#if PLATFORM_LINUX
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <ifaddrs.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include <atomic>
+
+// linux/net_tstamp.h, linux/sockios.h, linux/ethtool.h
+#ifndef SO_TIMESTAMPING
+#define SO_TIMESTAMPING 37
+#endif
+#ifndef SCM_TIMESTAMPING
+#define SCM_TIMESTAMPING SO_TIMESTAMPING
+#endif
+#ifndef SIOCETHTOOL
+#define SIOCETHTOOL 0x8946
+#endif
+#ifndef SIOCSHWTSTAMP
+#define SIOCSHWTSTAMP 0x89b0
+#endif
+#ifndef SIOCGHWTSTAMP
+#define SIOCGHWTSTAMP 0x89b1
+#endif
+
+namespace
+{
+    // SOF_TIMESTAMPING_* flags
+    constexpr int TimestampTxHardware = 1 << 0;
+    constexpr int TimestampTxSoftware = 1 << 1;
+    constexpr int TimestampRxHardware = 1 << 2;
+    constexpr int TimestampRxSoftware = 1 << 3;
+    constexpr int TimestampSoftware = 1 << 4;
+    constexpr int TimestampRawHardware = 1 << 6;
+    constexpr int TimestampOptTsOnly = 1 << 11;
+
+    constexpr int HwTimestampTxOn = 1;
+    constexpr int HwFilterNone = 0;
+    constexpr int HwFilterPTPv2L4Event = 6;
+
+    constexpr uint32 EthtoolGetTsInfo = 0x41;
+
+    // struct hwtstamp_config
+    struct FHwTimestampConfig
+    {
+        int Flags;
+        int TxType;
+        int RxFilter;
+    };
+
+    // struct ethtool_ts_info
+    struct FEthtoolTsInfo
+    {
+        uint32 Cmd;
+        uint32 SoTimestamping;
+        int32 PhcIndex;
+        uint32 TxTypes;
+        uint32 TxReserved[3];
+        uint32 RxFilters;
+        uint32 RxReserved[3];
+    };
+
+    // FD_TO_CLOCKID (linux/posix-timers.h)
+    clockid_t FileToClockId(int File)
+    {
+        return static_cast<clockid_t>((~static_cast<unsigned int>(File) << 3) | 3);
+    }
+
+    uint64 ReadClock(clockid_t Clock)
+    {
+        timespec Now;
+        clock_gettime(Clock, &Now);
+        return static_cast<uint64>(Now.tv_sec) * 1000000000ULL + static_cast<uint64>(Now.tv_nsec);
+    }
+
+    bool ParseIPv4(const FString& Address, in_addr& Out)
+    {
+        return inet_pton(AF_INET, TCHAR_TO_ANSI(*Address), &Out) == 1;
+    }
+
+    /** Find the interface that owns an address */
+    FString FindInterfaceName(const in_addr& Address)
+    {
+        FString Name;
+        ifaddrs* Interfaces = nullptr;
+        if (getifaddrs(&Interfaces) != 0)
+        {
+            return Name;
+        }
+
+        for (ifaddrs* Entry = Interfaces; Entry; Entry = Entry->ifa_next)
+        {
+            if (Entry->ifa_addr && Entry->ifa_addr->sa_family == AF_INET &&
+                reinterpret_cast<const sockaddr_in*>(Entry->ifa_addr)->sin_addr.s_addr == Address.s_addr)
+            {
+                Name = ANSI_TO_TCHAR(Entry->ifa_name);
+                break;
+            }
+        }
+
+        freeifaddrs(Interfaces);
+        return Name;
+    }
+
+    void FillRequest(ifreq& Request, const FString& InterfaceName)
+    {
+        FMemory::Memzero(Request);
+        strncpy(Request.ifr_name, TCHAR_TO_ANSI(*InterfaceName), IFNAMSIZ - 1);
+    }
+
+    // Gives up waiting for a Delay_Req transmit timestamp after this long
+    constexpr int TxTimestampTimeoutMs = 10;
+
+    constexpr int PollIntervalMs = 10;
+}
+
+/**
+ * PTP slave on Linux sockets.
+ *
+ * The slave runs on its own thread; the game thread reads a copy of its
+ * clock model and status.
+ */
+class FLinuxPTPProvider : public IPTPProvider, public FRunnable
+{
+public:
+    explicit FLinuxPTPProvider(const FRshipPTPSocketConfig& InSocketConfig)
+        : SocketConfig(InSocketConfig)
+    {
+    }
+
+    virtual ~FLinuxPTPProvider()
+    {
+        Shutdown();
+    }
+
+    virtual bool Initialize(const FString& InterfaceIP, int32 Domain) override
+    {
+        Shutdown();
+
+        ConfiguredDomain = Domain;
+
+        in_addr Interface = {};
+        Interface.s_addr = htonl(INADDR_ANY);
+        if (!InterfaceIP.IsEmpty() && !ParseIPv4(InterfaceIP, Interface))
+        {
+            UE_LOG(LogRship2110, Warning, TEXT("LinuxPTPProvider: Invalid interface IP: %s"), *InterfaceIP);
+            return false;
+        }
+        InterfaceName = InterfaceIP.IsEmpty() ? FString() : FindInterfaceName(Interface);
+
+        in_addr Group = {};
+        if (!ParseIPv4(SocketConfig.MulticastGroup, Group))
+        {
+            UE_LOG(LogRship2110, Warning, TEXT("LinuxPTPProvider: Invalid multicast group: %s"), *SocketConfig.MulticastGroup);
+            return false;
+        }
+
+        const FString& DestinationIP = SocketConfig.DestinationIP.IsEmpty() ? SocketConfig.MulticastGroup : SocketConfig.DestinationIP;
+        Destination = {};
+        Destination.sin_family = AF_INET;
+        Destination.sin_port = htons(static_cast<uint16>(SocketConfig.DestinationPort > 0 ? SocketConfig.DestinationPort : SocketConfig.EventPort));
+        if (!ParseIPv4(DestinationIP, Destination.sin_addr))
+        {
+            UE_LOG(LogRship2110, Warning, TEXT("LinuxPTPProvider: Invalid destination IP: %s"), *DestinationIP);
+            return false;
+        }
+
+        EventSocket = OpenSocket(SocketConfig.EventPort, Interface, Group);
+        GeneralSocket = OpenSocket(SocketConfig.GeneralPort, Interface, Group);
+        if (EventSocket < 0 || GeneralSocket < 0)
+        {
+            Shutdown();
+            return false;
+        }
+
+        if (!(SocketConfig.bHardwareTimestamping && EnableHardwareTimestamping()) && !EnableSoftwareTimestamping())
+        {
+            Shutdown();
+            return false;
+        }
+
+        FRshipPTPSlave::FConfig SlaveConfig;
+        SlaveConfig.Domain = static_cast<uint8>(Domain);
+        SlaveConfig.ClockIdentity = MakeClockIdentity();
+        if (URship2110Settings* Settings = URship2110Settings::Get())
+        {
+            SlaveConfig.LockThresholdNs = Settings->PTPSyncThresholdNs;
+            MaxHoldoverNs = static_cast<uint64>(Settings->PTPMaxHoldoverSeconds) * 1000000000ULL;
+        }
+        Slave.Configure(SlaveConfig);
+
+        // Until the first step, PTP time reads as the local clock
+        Snapshot = FSnapshot();
+        HoldoverStartLocalNs = 0;
+        PublishSnapshot(ReadClock(LocalClock));
+
+        bShouldStop = false;
+        Thread = FRunnableThread::Create(this, TEXT("RshipPTPSlaveThread"), 0, TPri_AboveNormal);
+        if (!Thread)
+        {
+            Shutdown();
+            return false;
+        }
+
+        UE_LOG(LogRship2110, Log, TEXT("LinuxPTPProvider: Initialized on %s, domain %d, %s timestamps, identity %s"),
+               InterfaceName.IsEmpty() ? TEXT("all interfaces") : *InterfaceName, Domain,
+               bHardwareTimestamping ? TEXT("hardware") : TEXT("software"),
+               *FRshipPTPMessage::FormatClockIdentity(SlaveConfig.ClockIdentity));
+        return true;
+    }
+
+    virtual void Shutdown() override
+    {
+        if (Thread)
+        {
+            Stop();
+            Thread->WaitForCompletion();
+            delete Thread;
+            Thread = nullptr;
+            UE_LOG(LogRship2110, Log, TEXT("LinuxPTPProvider: Shutdown"));
+        }
+
+        for (int* Descriptor : { &EventSocket, &GeneralSocket, &PhcFile })
+        {
+            if (*Descriptor >= 0)
+            {
+                close(*Descriptor);
+                *Descriptor = -1;
+            }
+        }
+
+        bHardwareTimestamping = false;
+        LocalClock = CLOCK_REALTIME;
+
+        FScopeLock Lock(&SnapshotLock);
+        Snapshot.State = ERshipPTPState::Disabled;
+    }
+
+    virtual void Tick(float DeltaTime) override
+    {
+        // The slave runs on its own thread
+    }
+
+    virtual FRshipPTPTimestamp GetPTPTime() const override
+    {
+        FScopeLock Lock(&SnapshotLock);
+        return FRshipPTPTimestamp::FromNanoseconds(Snapshot.Clock.ToPTP(ReadClock(LocalClock)));
+    }
+
+    virtual ERshipPTPState GetState() const override
+    {
+        FScopeLock Lock(&SnapshotLock);
+        return Snapshot.State;
+    }
+
+    virtual FRshipPTPStatus GetStatus() const override
+    {
+        FScopeLock Lock(&SnapshotLock);
+
+        FRshipPTPStatus Status;
+        Status.State = Snapshot.State;
+        Status.CurrentTime = FRshipPTPTimestamp::FromNanoseconds(Snapshot.Clock.ToPTP(ReadClock(LocalClock)));
+        Status.OffsetFromSystemNs = static_cast<int64>(Status.CurrentTime.ToNanoseconds() - ReadClock(CLOCK_REALTIME));
+        Status.PathDelayNs = Snapshot.MeanPathDelayNs;
+        Status.DriftPPB = Snapshot.Clock.FrequencyPPB;
+        Status.JitterNs = Snapshot.JitterNs;
+
+        Status.Grandmaster.Domain = static_cast<uint8>(ConfiguredDomain);
+        if (Snapshot.bHasMaster)
+        {
+            Status.Grandmaster.ClockIdentity = FRshipPTPMessage::FormatClockIdentity(Snapshot.Master.GrandmasterIdentity);
+            Status.Grandmaster.Priority1 = Snapshot.Master.Priority1;
+            Status.Grandmaster.Priority2 = Snapshot.Master.Priority2;
+            Status.Grandmaster.Quality = Snapshot.Master.Quality;
+            Status.Grandmaster.StepsRemoved = Snapshot.Master.StepsRemoved + 1;
+        }
+
+        return Status;
+    }
+
+    virtual int64 GetOffsetFromSystemNs() const override
+    {
+        return static_cast<int64>(GetPTPTime().ToNanoseconds() - ReadClock(CLOCK_REALTIME));
+    }
+
+    virtual FRshipPTPTimestamp GetNextFrameBoundary(
+        uint64 FrameDurationNs,
+        const FRshipPTPTimestamp* CurrentPTPTime) const override
+    {
+        const uint64 CurrentNs = (CurrentPTPTime ? *CurrentPTPTime : GetPTPTime()).ToNanoseconds();
+        return FRshipPTPTimestamp::FromNanoseconds((CurrentNs / FrameDurationNs + 1) * FrameDurationNs);
+    }
+
+    virtual uint32 GetRTPTimestamp(
+        const FRshipPTPTimestamp& PTPTime,
+        uint32 ClockRate) const override
+    {
+        const uint64 TotalTicks = static_cast<uint64>(PTPTime.Seconds) * ClockRate +
+                                  static_cast<uint64>(PTPTime.Nanoseconds) * ClockRate / 1000000000ULL;
+        return static_cast<uint32>(TotalTicks);
+    }
+
+    virtual bool IsHardwareTimestampingEnabled() const override
+    {
+        return bHardwareTimestamping;
+    }
+
+    virtual FString GetProviderName() const override
+    {
+        return bHardwareTimestamping ? TEXT("Linux PTP (hardware timestamps)") : TEXT("Linux PTP (software timestamps)");
+    }
+
+    // FRunnable interface
+    virtual uint32 Run() override
+    {
+        pollfd Files[2] = {};
+        Files[0].fd = EventSocket;
+        Files[0].events = POLLIN;
+        Files[1].fd = GeneralSocket;
+        Files[1].events = POLLIN;
+
+        while (!bShouldStop)
+        {
+            poll(Files, 2, PollIntervalMs);
+
+            ReceiveAll(EventSocket);
+            ReceiveAll(GeneralSocket);
+
+            const uint64 NowLocalNs = ReadClock(LocalClock);
+            Slave.Update(NowLocalNs);
+
+            FRshipPTPMessage Request;
+            if (Slave.PollDelayRequest(NowLocalNs, Request))
+            {
+                SendDelayRequest(Request);
+            }
+
+            PublishSnapshot(ReadClock(LocalClock));
+        }
+
+        return 0;
+    }
+
+    virtual void Stop() override
+    {
+        bShouldStop = true;
+    }
+
+private:
+    /** What the game thread reads */
+    struct FSnapshot
+    {
+        FRshipPTPClockModel Clock;
+        ERshipPTPState State = ERshipPTPState::Listening;
+        int64 MeanPathDelayNs = 0;
+        double JitterNs = 0.0;
+        bool bHasMaster = false;
+        FRshipPTPMessage Master;
+    };
+
+    int OpenSocket(int32 Port, const in_addr& Interface, const in_addr& Group)
+    {
+        const int Socket = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, IPPROTO_UDP);
+        if (Socket < 0)
+        {
+            UE_LOG(LogRship2110, Warning, TEXT("LinuxPTPProvider: socket() failed: %s"), ANSI_TO_TCHAR(strerror(errno)));
+            return -1;
+        }
+
+        // ptp4l or another slave may share the ports
+        const int Reuse = 1;
+        setsockopt(Socket, SOL_SOCKET, SO_REUSEADDR, &Reuse, sizeof(Reuse));
+
+        sockaddr_in Local = {};
+        Local.sin_family = AF_INET;
+        Local.sin_port = htons(static_cast<uint16>(Port));
+        Local.sin_addr.s_addr = htonl(INADDR_ANY);
+        if (bind(Socket, reinterpret_cast<const sockaddr*>(&Local), sizeof(Local)) != 0)
+        {
+            UE_LOG(LogRship2110, Warning, TEXT("LinuxPTPProvider: Could not bind port %d: %s"), Port, ANSI_TO_TCHAR(strerror(errno)));
+            close(Socket);
+            return -1;
+        }
+
+        ip_mreq Membership = {};
+        Membership.imr_multiaddr = Group;
+        Membership.imr_interface = Interface;
+        if (setsockopt(Socket, IPPROTO_IP, IP_ADD_MEMBERSHIP, &Membership, sizeof(Membership)) != 0)
+        {
+            UE_LOG(LogRship2110, Warning, TEXT("LinuxPTPProvider: Could not join %s on port %d: %s"),
+                   *SocketConfig.MulticastGroup, Port, ANSI_TO_TCHAR(strerror(errno)));
+        }
+
+        // SMPTE 2059-2: one hop, expedited forwarding
+        const int TTL = 1;
+        setsockopt(Socket, IPPROTO_IP, IP_MULTICAST_TTL, &TTL, sizeof(TTL));
+        setsockopt(Socket, IPPROTO_IP, IP_MULTICAST_IF, &Interface, sizeof(Interface));
+        const int TOS = 46 << 2;
+        setsockopt(Socket, IPPROTO_IP, IP_TOS, &TOS, sizeof(TOS));
+
+        return Socket;
+    }
+
+    bool EnableHardwareTimestamping()
+    {
+        if (InterfaceName.IsEmpty())
+        {
+            return false;
+        }
+
+        // Ask the driver to timestamp PTP event packets; another daemon may have done it already
+        ifreq Request;
+        FHwTimestampConfig HwConfig = { 0, HwTimestampTxOn, HwFilterPTPv2L4Event };
+        FillRequest(Request, InterfaceName);
+        Request.ifr_data = reinterpret_cast<char*>(&HwConfig);
+        if (ioctl(EventSocket, SIOCSHWTSTAMP, &Request) != 0)
+        {
+            HwConfig = { 0, 0, 0 };
+            if (ioctl(EventSocket, SIOCGHWTSTAMP, &Request) != 0 || HwConfig.TxType != HwTimestampTxOn || HwConfig.RxFilter == HwFilterNone)
+            {
+                UE_LOG(LogRship2110, Log, TEXT("LinuxPTPProvider: No hardware timestamping on %s"), *InterfaceName);
+                return false;
+            }
+        }
+
+        // The PHC the NIC stamps with becomes the local clock
+        FEthtoolTsInfo TsInfo = {};
+        TsInfo.Cmd = EthtoolGetTsInfo;
+        FillRequest(Request, InterfaceName);
+        Request.ifr_data = reinterpret_cast<char*>(&TsInfo);
+        if (ioctl(EventSocket, SIOCETHTOOL, &Request) != 0 || TsInfo.PhcIndex < 0)
+        {
+            UE_LOG(LogRship2110, Log, TEXT("LinuxPTPProvider: %s has no PTP hardware clock"), *InterfaceName);
+            return false;
+        }
+
+        char PhcPath[32];
+        snprintf(PhcPath, sizeof(PhcPath), "/dev/ptp%d", TsInfo.PhcIndex);
+        PhcFile = open(PhcPath, O_RDONLY | O_CLOEXEC);
+        if (PhcFile < 0)
+        {
+            UE_LOG(LogRship2110, Log, TEXT("LinuxPTPProvider: Could not open %s: %s"), ANSI_TO_TCHAR(PhcPath), ANSI_TO_TCHAR(strerror(errno)));
+            return false;
+        }
+
+        const int Flags = TimestampTxHardware | TimestampRxHardware | TimestampRawHardware | TimestampOptTsOnly;
+        if (setsockopt(EventSocket, SOL_SOCKET, SO_TIMESTAMPING, &Flags, sizeof(Flags)) != 0)
+        {
+            close(PhcFile);
+            PhcFile = -1;
+            return false;
+        }
+
+        LocalClock = FileToClockId(PhcFile);
+        bHardwareTimestamping = true;
+        return true;
+    }
+
+    bool EnableSoftwareTimestamping()
+    {
+        const int Flags = TimestampTxSoftware | TimestampRxSoftware | TimestampSoftware | TimestampOptTsOnly;
+        if (setsockopt(EventSocket, SOL_SOCKET, SO_TIMESTAMPING, &Flags, sizeof(Flags)) != 0)
+        {
+            UE_LOG(LogRship2110, Warning, TEXT("LinuxPTPProvider: SO_TIMESTAMPING failed: %s"), ANSI_TO_TCHAR(strerror(errno)));
+            return false;
+        }
+
+        LocalClock = CLOCK_REALTIME;
+        bHardwareTimestamping = false;
+        return true;
+    }
+
+    /** EUI-64 from the interface MAC, random if it has none */
+    uint64 MakeClockIdentity() const
+    {
+        uint8 Mac[6] = {};
+        if (!InterfaceName.IsEmpty())
+        {
+            ifreq Request;
+            FillRequest(Request, InterfaceName);
+            if (ioctl(EventSocket, SIOCGIFHWADDR, &Request) == 0)
+            {
+                FMemory::Memcpy(Mac, Request.ifr_hwaddr.sa_data, sizeof(Mac));
+            }
+        }
+
+        if (!(Mac[0] | Mac[1] | Mac[2] | Mac[3] | Mac[4] | Mac[5]))
+        {
+            // Locally administered, unicast
+            for (uint8& Byte : Mac)
+            {
+                Byte = static_cast<uint8>(FMath::Rand());
+            }
+            Mac[0] = (Mac[0] | 0x02) & ~0x01;
+        }
+
+        return (static_cast<uint64>(Mac[0]) << 56) | (static_cast<uint64>(Mac[1]) << 48) | (static_cast<uint64>(Mac[2]) << 40) |
+               (0xFFFEULL << 24) | (static_cast<uint64>(Mac[3]) << 16) | (static_cast<uint64>(Mac[4]) << 8) | Mac[5];
+    }
+
+    /** Read the timestamp out of a message's control data */
+    bool GetTimestamp(msghdr& Header, uint64& OutNs) const
+    {
+        for (cmsghdr* Control = CMSG_FIRSTHDR(&Header); Control; Control = CMSG_NXTHDR(&Header, Control))
+        {
+            if (Control->cmsg_level == SOL_SOCKET && Control->cmsg_type == SCM_TIMESTAMPING)
+            {
+                // [0] software, [2] raw hardware
+                timespec Stamps[3];
+                FMemory::Memcpy(Stamps, CMSG_DATA(Control), sizeof(Stamps));
+                const timespec& Stamp = Stamps[bHardwareTimestamping ? 2 : 0];
+                if (Stamp.tv_sec == 0 && Stamp.tv_nsec == 0)
+                {
+                    return false;
+                }
+                OutNs = static_cast<uint64>(Stamp.tv_sec) * 1000000000ULL + static_cast<uint64>(Stamp.tv_nsec);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void ReceiveAll(int Socket)
+    {
+        uint8 Buffer[256];
+        alignas(cmsghdr) uint8 ControlBuffer[256];
+
+        while (true)
+        {
+            iovec Vector = { Buffer, sizeof(Buffer) };
+            msghdr Header = {};
+            Header.msg_iov = &Vector;
+            Header.msg_iovlen = 1;
+            Header.msg_control = ControlBuffer;
+            Header.msg_controllen = sizeof(ControlBuffer);
+
+            const ssize_t Received = recvmsg(Socket, &Header, MSG_DONTWAIT);
+            if (Received < 0)
+            {
+                return;
+            }
+
+            FRshipPTPMessage Message;
+            if (!Message.Decode(Buffer, static_cast<int32>(Received)))
+            {
+                continue;
+            }
+
+            // General messages carry no timestamp; the receive time only feeds timeouts
+            uint64 RxLocalNs = 0;
+            if (!GetTimestamp(Header, RxLocalNs))
+            {
+                RxLocalNs = ReadClock(LocalClock);
+            }
+            Slave.HandleMessage(Message, RxLocalNs);
+        }
+    }
+
+    void SendDelayRequest(const FRshipPTPMessage& Request)
+    {
+        uint8 Buffer[FRshipPTPMessage::MaxSize];
+        const int32 Size = Request.Encode(Buffer);
+
+        // Stale timestamps from an earlier request must not be taken for this one
+        DrainErrorQueue();
+
+        const uint64 BeforeSendNs = ReadClock(LocalClock);
+        if (sendto(EventSocket, Buffer, Size, 0, reinterpret_cast<const sockaddr*>(&Destination), sizeof(Destination)) != Size)
+        {
+            UE_LOG(LogRship2110, Verbose, TEXT("LinuxPTPProvider: Delay_Req send failed: %s"), ANSI_TO_TCHAR(strerror(errno)));
+            return;
+        }
+
+        // The kernel loops the transmit time back on the error queue
+        uint64 TxLocalNs = 0;
+        if (!ReadTxTimestamp(TxLocalNs))
+        {
+            TxLocalNs = BeforeSendNs;
+        }
+        Slave.OnDelayRequestSent(Request.SequenceId, TxLocalNs);
+    }
+
+    bool ReadTxTimestamp(uint64& OutNs)
+    {
+        pollfd File = { EventSocket, POLLPRI, 0 };
+        const uint64 DeadlineNs = ReadClock(CLOCK_MONOTONIC) + TxTimestampTimeoutMs * 1000000ULL;
+
+        while (true)
+        {
+            if (ReadErrorQueue(OutNs) > 0)
+            {
+                return true;
+            }
+
+            const uint64 NowNs = ReadClock(CLOCK_MONOTONIC);
+            if (NowNs >= DeadlineNs)
+            {
+                return false;
+            }
+            // POLLERR is always reported; the events mask only keeps POLLIN out
+            poll(&File, 1, static_cast<int>((DeadlineNs - NowNs) / 1000000ULL) + 1);
+        }
+    }
+
+    void DrainErrorQueue()
+    {
+        uint64 Ignored = 0;
+        for (int32 Count = 0; Count < 16 && ReadErrorQueue(Ignored) >= 0; ++Count)
+        {
+        }
+    }
+
+    /**
+     * Take one entry off the event socket's error queue.
+     * @return -1 if the queue is empty, 1 if it held a timestamp, 0 otherwise
+     */
+    int32 ReadErrorQueue(uint64& OutNs)
+    {
+        uint8 Buffer[256];
+        alignas(cmsghdr) uint8 ControlBuffer[256];
+        iovec Vector = { Buffer, sizeof(Buffer) };
+        msghdr Header = {};
+        Header.msg_iov = &Vector;
+        Header.msg_iovlen = 1;
+        Header.msg_control = ControlBuffer;
+        Header.msg_controllen = sizeof(ControlBuffer);
+
+        if (recvmsg(EventSocket, &Header, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+        {
+            return -1;
+        }
+        return GetTimestamp(Header, OutNs) ? 1 : 0;
+    }
+
+    void PublishSnapshot(uint64 NowLocalNs)
+    {
+        ERshipPTPState State = Slave.GetState();
+
+        // Holdover is only trusted for PTPMaxHoldoverSeconds
+        if (State == ERshipPTPState::Holdover)
+        {
+            if (HoldoverStartLocalNs == 0)
+            {
+                HoldoverStartLocalNs = NowLocalNs;
+            }
+            else if (MaxHoldoverNs > 0 && NowLocalNs - HoldoverStartLocalNs > MaxHoldoverNs)
+            {
+                State = ERshipPTPState::Listening;
+            }
+        }
+        else
+        {
+            HoldoverStartLocalNs = 0;
+        }
+
+        if (State != LastLoggedState)
+        {
+            UE_LOG(LogRship2110, Log, TEXT("LinuxPTPProvider: State %d -> %d (offset %lld ns, path delay %lld ns)"),
+                   static_cast<int32>(LastLoggedState), static_cast<int32>(State),
+                   Slave.GetLastOffsetNs(), Slave.GetMeanPathDelayNs());
+            LastLoggedState = State;
+        }
+
+        FScopeLock Lock(&SnapshotLock);
+        Snapshot.Clock = Slave.GetClock();
+        Snapshot.State = State;
+        Snapshot.MeanPathDelayNs = Slave.GetMeanPathDelayNs();
+        Snapshot.JitterNs = Slave.GetJitterNs();
+        Snapshot.bHasMaster = Slave.HasMaster();
+        Snapshot.Master = Slave.GetMasterAnnounce();
+    }
+
+    // Configuration
+    FRshipPTPSocketConfig SocketConfig;
+    int32 ConfiguredDomain = 127;
+    FString InterfaceName;
+    sockaddr_in Destination = {};
+    uint64 MaxHoldoverNs = 0;
+
+    // Sockets and clock
+    int EventSocket = -1;
+    int GeneralSocket = -1;
+    int PhcFile = -1;
+    clockid_t LocalClock = CLOCK_REALTIME;
+    bool bHardwareTimestamping = false;
+
+    // Slave thread only
+    FRshipPTPSlave Slave;
+    uint64 HoldoverStartLocalNs = 0;
+    ERshipPTPState LastLoggedState = ERshipPTPState::Listening;
+
+    FRunnableThread* Thread = nullptr;
+    std::atomic<bool> bShouldStop{false};
+
+    FSnapshot Snapshot;
+    mutable FCriticalSection SnapshotLock;
+};
+
+TUniquePtr<IPTPProvider> CreateLinuxPTPProvider(const FRshipPTPSocketConfig& SocketConfig)
+{
+    return MakeUnique<FLinuxPTPProvider>(SocketConfig);
+}
+
+#endif  // PLATFORM_LINUX
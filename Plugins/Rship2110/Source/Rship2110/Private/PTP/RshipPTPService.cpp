@@ -40,8 +40,15 @@ bool URshipPTPService::Initialize(URship2110Subsystem* InSubsystem)
     // Initialize the provider
     if (!Provider->Initialize(ConfiguredInterfaceIP, ConfiguredDomain))
     {
-        UE_LOG(LogRship2110, Warning, TEXT("PTPService: Provider initialization failed"));
-        // Continue anyway - may be able to sync later
+        UE_LOG(LogRship2110, Warning, TEXT("PTPService: Provider %s initialization failed"), *Provider->GetProviderName());
+
+        // A slave that cannot open its sockets (ports 319/320 need privileges) never syncs
+        if (Provider->GetState() == ERshipPTPState::Disabled)
+        {
+            Provider = FPTPProviderFactory::CreateFallback();
+            Provider->Initialize(ConfiguredInterfaceIP, ConfiguredDomain);
+        }
+        // Otherwise continue anyway - may be able to sync later
     }
 
     UE_LOG(LogRship2110, Log, TEXT("PTPService: Initialized with provider %s, domain %d"),
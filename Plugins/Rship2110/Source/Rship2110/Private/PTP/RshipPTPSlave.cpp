@@ -0,0 +1,623 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "PTP/RshipPTPSlave.h"
+
+namespace
+{
+    void WriteBE16(uint8* Dest, uint32 Value)
+    {
+        Dest[0] = static_cast<uint8>(Value >> 8);
+        Dest[1] = static_cast<uint8>(Value);
+    }
+
+    void WriteBE32(uint8* Dest, uint32 Value)
+    {
+        WriteBE16(Dest, Value >> 16);
+        WriteBE16(Dest + 2, Value);
+    }
+
+    void WriteBE64(uint8* Dest, uint64 Value)
+    {
+        WriteBE32(Dest, static_cast<uint32>(Value >> 32));
+        WriteBE32(Dest + 4, static_cast<uint32>(Value));
+    }
+
+    uint32 ReadBE16(const uint8* Source)
+    {
+        return (static_cast<uint32>(Source[0]) << 8) | Source[1];
+    }
+
+    uint32 ReadBE32(const uint8* Source)
+    {
+        return (ReadBE16(Source) << 16) | ReadBE16(Source + 2);
+    }
+
+    uint64 ReadBE64(const uint8* Source)
+    {
+        return (static_cast<uint64>(ReadBE32(Source)) << 32) | ReadBE32(Source + 4);
+    }
+
+    /** 10-byte PTP timestamp: 48-bit seconds, 32-bit nanoseconds */
+    void WriteTimestamp(uint8* Dest, const FRshipPTPTimestamp& Timestamp)
+    {
+        const uint64 Seconds = static_cast<uint64>(Timestamp.Seconds);
+        WriteBE16(Dest, static_cast<uint32>(Seconds >> 32));
+        WriteBE32(Dest + 2, static_cast<uint32>(Seconds));
+        WriteBE32(Dest + 6, static_cast<uint32>(Timestamp.Nanoseconds));
+    }
+
+    FRshipPTPTimestamp ReadTimestamp(const uint8* Source)
+    {
+        FRshipPTPTimestamp Timestamp;
+        Timestamp.Seconds = static_cast<int64>((static_cast<uint64>(ReadBE16(Source)) << 32) | ReadBE32(Source + 2));
+        Timestamp.Nanoseconds = static_cast<int32>(ReadBE32(Source + 6));
+        return Timestamp;
+    }
+
+    constexpr int32 HeaderSize = 34;
+
+    int32 GetMessageLength(FRshipPTPMessage::EType Type)
+    {
+        switch (Type)
+        {
+        case FRshipPTPMessage::EType::Sync:
+        case FRshipPTPMessage::EType::DelayReq:
+        case FRshipPTPMessage::EType::FollowUp:
+            return 44;
+        case FRshipPTPMessage::EType::DelayResp:
+            return 54;
+        case FRshipPTPMessage::EType::Announce:
+            return 64;
+        }
+        return 0;
+    }
+
+    /** controlField values for PTPv1 hardware (IEEE 1588-2008 Table 23) */
+    uint8 GetControlField(FRshipPTPMessage::EType Type)
+    {
+        switch (Type)
+        {
+        case FRshipPTPMessage::EType::Sync:      return 0;
+        case FRshipPTPMessage::EType::DelayReq:  return 1;
+        case FRshipPTPMessage::EType::FollowUp:  return 2;
+        case FRshipPTPMessage::EType::DelayResp: return 3;
+        default:                                 return 5;
+        }
+    }
+
+    constexpr uint64 NsPerSecond = 1000000000ULL;
+
+    uint64 SecondsToNs(double Seconds)
+    {
+        return static_cast<uint64>(Seconds * 1e9);
+    }
+
+    // Offset history for jitter
+    constexpr int32 JitterWindow = 32;
+}
+
+// ============================================================================
+// MESSAGE CODEC
+// ============================================================================
+
+int32 FRshipPTPMessage::Encode(uint8* Out) const
+{
+    const int32 Length = GetMessageLength(Type);
+    FMemory::Memzero(Out, Length);
+
+    // Common header
+    Out[0] = static_cast<uint8>(Type) & 0x0F;
+    Out[1] = 2;
+    WriteBE16(Out + 2, Length);
+    Out[4] = Domain;
+    Out[6] = (Type == EType::Sync && bTwoStep) ? 0x02 : 0x00;
+    Out[7] = Type == EType::Announce ? 0x08 : 0x00;  // ptpTimescale
+    WriteBE64(Out + 8, static_cast<uint64>(CorrectionNs) << 16);
+    WriteBE64(Out + 20, SourceClockIdentity);
+    WriteBE16(Out + 28, SourcePort);
+    WriteBE16(Out + 30, SequenceId);
+    Out[32] = GetControlField(Type);
+    Out[33] = static_cast<uint8>(LogMessageInterval);
+
+    WriteTimestamp(Out + HeaderSize, Timestamp);
+
+    if (Type == EType::DelayResp)
+    {
+        WriteBE64(Out + 44, RequestingClockIdentity);
+        WriteBE16(Out + 52, RequestingPort);
+    }
+    else if (Type == EType::Announce)
+    {
+        WriteBE16(Out + 44, static_cast<uint16>(CurrentUtcOffset));
+        Out[47] = Priority1;
+        Out[48] = Quality.ClockClass;
+        Out[49] = Quality.ClockAccuracy;
+        WriteBE16(Out + 50, static_cast<uint32>(Quality.OffsetScaledLogVariance));
+        Out[52] = Priority2;
+        WriteBE64(Out + 53, GrandmasterIdentity);
+        WriteBE16(Out + 61, StepsRemoved);
+        Out[63] = 0xA0;  // timeSource: internal oscillator
+    }
+
+    return Length;
+}
+
+bool FRshipPTPMessage::Decode(const uint8* Data, int32 Size)
+{
+    if (!Data || Size < HeaderSize || (Data[1] & 0x0F) != 2)
+    {
+        return false;
+    }
+
+    const uint8 RawType = Data[0] & 0x0F;
+    if (RawType != 0x0 && RawType != 0x1 && RawType != 0x8 && RawType != 0x9 && RawType != 0xB)
+    {
+        return false;
+    }
+    Type = static_cast<EType>(RawType);
+
+    const int32 Length = static_cast<int32>(ReadBE16(Data + 2));
+    if (Length < GetMessageLength(Type) || Length > Size)
+    {
+        return false;
+    }
+
+    Domain = Data[4];
+    bTwoStep = (Data[6] & 0x02) != 0;
+    CorrectionNs = static_cast<int64>(ReadBE64(Data + 8)) >> 16;
+    SourceClockIdentity = ReadBE64(Data + 20);
+    SourcePort = static_cast<uint16>(ReadBE16(Data + 28));
+    SequenceId = static_cast<uint16>(ReadBE16(Data + 30));
+    LogMessageInterval = static_cast<int8>(Data[33]);
+    Timestamp = ReadTimestamp(Data + HeaderSize);
+
+    if (Type == EType::DelayResp)
+    {
+        RequestingClockIdentity = ReadBE64(Data + 44);
+        RequestingPort = static_cast<uint16>(ReadBE16(Data + 52));
+    }
+    else if (Type == EType::Announce)
+    {
+        CurrentUtcOffset = static_cast<int16>(ReadBE16(Data + 44));
+        Priority1 = Data[47];
+        Quality.ClockClass = Data[48];
+        Quality.ClockAccuracy = Data[49];
+        Quality.OffsetScaledLogVariance = static_cast<int32>(ReadBE16(Data + 50));
+        Priority2 = Data[52];
+        GrandmasterIdentity = ReadBE64(Data + 53);
+        StepsRemoved = static_cast<uint16>(ReadBE16(Data + 61));
+    }
+
+    return true;
+}
+
+FString FRshipPTPMessage::FormatClockIdentity(uint64 ClockIdentity)
+{
+    FString Result;
+    for (int32 Index = 7; Index >= 0; --Index)
+    {
+        Result += FString::Printf(Index > 0 ? TEXT("%02X:") : TEXT("%02X"), static_cast<uint32>((ClockIdentity >> (8 * Index)) & 0xFF));
+    }
+    return Result;
+}
+
+// ============================================================================
+// PI SERVO
+// ============================================================================
+
+void FRshipPTPServo::Configure(const FConfig& InConfig, double SyncIntervalSeconds)
+{
+    Config = InConfig;
+
+    // linuxptp pi.c: gains scale with the interval, capped so one sample never overcorrects
+    const double Interval = FMath::Max(SyncIntervalSeconds, 1e-3);
+    Kp = FMath::Min(Config.KpScale * FMath::Pow(Interval, Config.KpExponent), Config.KpNormMax / Interval);
+    Ki = FMath::Min(Config.KiScale * FMath::Pow(Interval, Config.KiExponent), Config.KiNormMax / Interval);
+
+    Drift = 0.0;
+    Reset();
+}
+
+void FRshipPTPServo::Reset()
+{
+    // Drift is kept: the clock is still running at it
+    Count = 0;
+}
+
+FRshipPTPServo::EResult FRshipPTPServo::Sample(int64 OffsetNs, uint64 LocalTimeNs, double& OutFrequencyPPB)
+{
+    OutFrequencyPPB = Drift;
+
+    switch (Count)
+    {
+    case 0:
+        FirstOffsetNs = OffsetNs;
+        FirstLocalNs = LocalTimeNs;
+        Count = 1;
+        return EResult::Unlocked;
+
+    case 1:
+    {
+        if (LocalTimeNs <= FirstLocalNs)
+        {
+            Count = 0;
+            return EResult::Unlocked;
+        }
+
+        // Frequency error from the two samples, on top of what the clock already runs at
+        const double Elapsed = static_cast<double>(LocalTimeNs - FirstLocalNs);
+        Drift = FMath::Clamp(Drift + static_cast<double>(OffsetNs - FirstOffsetNs) * 1e9 / Elapsed,
+                             -Config.MaxFrequencyPPB, Config.MaxFrequencyPPB);
+        OutFrequencyPPB = Drift;
+        Count = 2;
+
+        if (Config.FirstStepThresholdNs == 0 || FMath::Abs(OffsetNs) > Config.FirstStepThresholdNs)
+        {
+            return EResult::Jump;
+        }
+        return EResult::Locked;
+    }
+
+    default:
+        break;
+    }
+
+    // Far off once locked: start over and step again
+    if (Config.StepThresholdNs > 0 && FMath::Abs(OffsetNs) > Config.StepThresholdNs)
+    {
+        Count = 0;
+        return EResult::Unlocked;
+    }
+
+    const double KiTerm = Ki * static_cast<double>(OffsetNs);
+    const double Frequency = Kp * static_cast<double>(OffsetNs) + Drift + KiTerm;
+    if (Frequency > Config.MaxFrequencyPPB || Frequency < -Config.MaxFrequencyPPB)
+    {
+        // Saturated: hold the integrator so it does not wind up
+        OutFrequencyPPB = FMath::Clamp(Frequency, -Config.MaxFrequencyPPB, Config.MaxFrequencyPPB);
+    }
+    else
+    {
+        Drift += KiTerm;
+        OutFrequencyPPB = Frequency;
+    }
+    return EResult::Locked;
+}
+
+// ============================================================================
+// ORDINARY SLAVE
+// ============================================================================
+
+void FRshipPTPSlave::Configure(const FConfig& InConfig)
+{
+    Config = InConfig;
+    Config.DelayFilterLength = FMath::Max(Config.DelayFilterLength, 1);
+    SyncIntervalSeconds = Config.SyncIntervalSeconds;
+    Servo.Configure(Config.Servo, SyncIntervalSeconds);
+    Clock = FRshipPTPClockModel();
+    Reset();
+}
+
+void FRshipPTPSlave::Reset()
+{
+    bHasMaster = false;
+    MasterAnnounce = FRshipPTPMessage();
+    State = ERshipPTPState::Listening;
+    ResetTiming();
+}
+
+void FRshipPTPSlave::ResetTiming()
+{
+    Servo.Reset();
+    bSyncPending = false;
+    bHaveSyncPair = false;
+    bDelayReqInFlight = false;
+    NextDelayReqLocalNs = 0;
+    DelaySamples.Reset();
+    DelaySampleIndex = 0;
+    MeanPathDelayNs = 0;
+    bHaveDelay = false;
+    SamplesUnderThreshold = 0;
+    RecentOffsets.Reset();
+    RecentOffsetIndex = 0;
+}
+
+bool FRshipPTPSlave::IsBetterMaster(const FRshipPTPMessage& Candidate, const FRshipPTPMessage& Current) const
+{
+    // IEEE 1588 dataset comparison, first difference wins
+    if (Candidate.GrandmasterIdentity == Current.GrandmasterIdentity)
+    {
+        return Candidate.StepsRemoved < Current.StepsRemoved;
+    }
+    if (Candidate.Priority1 != Current.Priority1)
+    {
+        return Candidate.Priority1 < Current.Priority1;
+    }
+    if (Candidate.Quality.ClockClass != Current.Quality.ClockClass)
+    {
+        return Candidate.Quality.ClockClass < Current.Quality.ClockClass;
+    }
+    if (Candidate.Quality.ClockAccuracy != Current.Quality.ClockAccuracy)
+    {
+        return Candidate.Quality.ClockAccuracy < Current.Quality.ClockAccuracy;
+    }
+    if (Candidate.Quality.OffsetScaledLogVariance != Current.Quality.OffsetScaledLogVariance)
+    {
+        return Candidate.Quality.OffsetScaledLogVariance < Current.Quality.OffsetScaledLogVariance;
+    }
+    if (Candidate.Priority2 != Current.Priority2)
+    {
+        return Candidate.Priority2 < Current.Priority2;
+    }
+    return Candidate.GrandmasterIdentity < Current.GrandmasterIdentity;
+}
+
+bool FRshipPTPSlave::IsFromMaster(const FRshipPTPMessage& Message) const
+{
+    return bHasMaster && Message.SourceClockIdentity == MasterAnnounce.SourceClockIdentity &&
+           Message.SourcePort == MasterAnnounce.SourcePort;
+}
+
+void FRshipPTPSlave::HandleMessage(const FRshipPTPMessage& Message, uint64 RxLocalNs)
+{
+    if (Message.Domain != Config.Domain || Message.SourceClockIdentity == Config.ClockIdentity)
+    {
+        return;
+    }
+
+    switch (Message.Type)
+    {
+    case FRshipPTPMessage::EType::Announce:
+    {
+        if (IsFromMaster(Message))
+        {
+            MasterAnnounce = Message;
+            LastAnnounceLocalNs = RxLocalNs;
+        }
+        else if (!bHasMaster || IsBetterMaster(Message, MasterAnnounce))
+        {
+            // New master: its timescale may differ, so timing starts over (the clock model stays)
+            bHasMaster = true;
+            MasterAnnounce = Message;
+            LastAnnounceLocalNs = RxLocalNs;
+            ResetTiming();
+            if (State == ERshipPTPState::Listening)
+            {
+                State = ERshipPTPState::Acquiring;
+            }
+        }
+        break;
+    }
+
+    case FRshipPTPMessage::EType::Sync:
+    {
+        if (!IsFromMaster(Message))
+        {
+            break;
+        }
+
+        // logMessageInterval 0x7F means "not given"
+        if (Message.LogMessageInterval != 0x7F)
+        {
+            const double Interval = FMath::Pow(2.0, static_cast<double>(Message.LogMessageInterval));
+            if (!FMath::IsNearlyEqual(Interval, SyncIntervalSeconds))
+            {
+                SyncIntervalSeconds = Interval;
+                Servo.Configure(Config.Servo, SyncIntervalSeconds);
+            }
+        }
+
+        LastSyncLocalNs = RxLocalNs;
+        SyncRxLocalNs = RxLocalNs;
+        if (Message.bTwoStep)
+        {
+            bSyncPending = true;
+            SyncSequenceId = Message.SequenceId;
+            SyncCorrectionNs = Message.CorrectionNs;
+        }
+        else
+        {
+            bSyncPending = false;
+            HandleSyncTime(Message.Timestamp.ToNanoseconds(), Message.CorrectionNs);
+        }
+        break;
+    }
+
+    case FRshipPTPMessage::EType::FollowUp:
+    {
+        if (IsFromMaster(Message) && bSyncPending && Message.SequenceId == SyncSequenceId)
+        {
+            bSyncPending = false;
+            HandleSyncTime(Message.Timestamp.ToNanoseconds(), SyncCorrectionNs + Message.CorrectionNs);
+        }
+        break;
+    }
+
+    case FRshipPTPMessage::EType::DelayResp:
+    {
+        if (!IsFromMaster(Message) || !bDelayReqInFlight || !bHaveSyncPair ||
+            Message.SequenceId != DelayReqSequenceId ||
+            Message.RequestingClockIdentity != Config.ClockIdentity || Message.RequestingPort != Config.PortNumber)
+        {
+            break;
+        }
+        bDelayReqInFlight = false;
+
+        // ((t2 - t3) + (t4 - t1)) / 2: each difference is on one clock, so steps cancel out
+        const uint64 T4 = Message.Timestamp.ToNanoseconds() - Message.CorrectionNs;
+        const int64 SlaveSpan = static_cast<int64>(Clock.ToPTP(LastSyncRxLocalNs) - Clock.ToPTP(DelayReqTxLocalNs));
+        const int64 MasterSpan = static_cast<int64>(T4 - LastSyncMasterNs);
+        const int64 Delay = (SlaveSpan + MasterSpan) / 2;
+        if (Delay < 0 || Delay > static_cast<int64>(NsPerSecond))
+        {
+            break;
+        }
+
+        // Moving median over the last DelayFilterLength samples
+        if (DelaySamples.Num() < Config.DelayFilterLength)
+        {
+            DelaySamples.Add(Delay);
+        }
+        else
+        {
+            DelaySamples[DelaySampleIndex] = Delay;
+            DelaySampleIndex = (DelaySampleIndex + 1) % Config.DelayFilterLength;
+        }
+        TArray<int64, TInlineAllocator<16>> Sorted(DelaySamples);
+        Sorted.Sort();
+        MeanPathDelayNs = Sorted.Num() % 2 ? Sorted[Sorted.Num() / 2] : (Sorted[Sorted.Num() / 2 - 1] + Sorted[Sorted.Num() / 2]) / 2;
+        bHaveDelay = true;
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+void FRshipPTPSlave::HandleSyncTime(uint64 MasterNs, int64 CorrectionNs)
+{
+    LastSyncMasterNs = MasterNs + CorrectionNs;
+    LastSyncRxLocalNs = SyncRxLocalNs;
+    bHaveSyncPair = true;
+
+    // The offset needs the path delay; until it is measured, just collect Sync pairs
+    if (!bHaveDelay)
+    {
+        return;
+    }
+
+    const int64 OffsetNs = static_cast<int64>(LastSyncMasterNs + MeanPathDelayNs - Clock.ToPTP(SyncRxLocalNs));
+    ProcessSample(OffsetNs, SyncRxLocalNs);
+}
+
+void FRshipPTPSlave::ProcessSample(int64 OffsetNs, uint64 RxLocalNs)
+{
+    LastOffsetNs = OffsetNs;
+    ++SampleCount;
+
+    if (RecentOffsets.Num() < JitterWindow)
+    {
+        RecentOffsets.Add(OffsetNs);
+    }
+    else
+    {
+        RecentOffsets[RecentOffsetIndex] = OffsetNs;
+        RecentOffsetIndex = (RecentOffsetIndex + 1) % JitterWindow;
+    }
+
+    double FrequencyPPB = 0.0;
+    switch (Servo.Sample(OffsetNs, RxLocalNs, FrequencyPPB))
+    {
+    case FRshipPTPServo::EResult::Unlocked:
+        SamplesUnderThreshold = 0;
+        if (State != ERshipPTPState::Holdover)
+        {
+            State = ERshipPTPState::Acquiring;
+        }
+        return;
+
+    case FRshipPTPServo::EResult::Jump:
+        Clock.Adjust(RxLocalNs, OffsetNs, FrequencyPPB);
+        SamplesUnderThreshold = 0;
+        RecentOffsets.Reset();
+        RecentOffsetIndex = 0;
+        State = ERshipPTPState::Acquiring;
+        return;
+
+    case FRshipPTPServo::EResult::Locked:
+        Clock.Adjust(RxLocalNs, 0, FrequencyPPB);
+        break;
+    }
+
+    // Lock after a run of good samples; once locked, only a clearly bad one drops it
+    const int64 AbsOffset = FMath::Abs(OffsetNs);
+    if (State == ERshipPTPState::Locked)
+    {
+        if (AbsOffset > 4 * Config.LockThresholdNs)
+        {
+            SamplesUnderThreshold = 0;
+            State = ERshipPTPState::Acquiring;
+        }
+        return;
+    }
+
+    SamplesUnderThreshold = AbsOffset < Config.LockThresholdNs ? SamplesUnderThreshold + 1 : 0;
+    State = SamplesUnderThreshold >= Config.LockSamples ? ERshipPTPState::Locked : ERshipPTPState::Acquiring;
+}
+
+bool FRshipPTPSlave::PollDelayRequest(uint64 NowLocalNs, FRshipPTPMessage& OutMessage)
+{
+    if (!bHasMaster || !bHaveSyncPair || NowLocalNs < NextDelayReqLocalNs)
+    {
+        return false;
+    }
+
+    // A lost response is given up on after a second
+    if (bDelayReqInFlight && NowLocalNs - DelayReqTxLocalNs < NsPerSecond)
+    {
+        return false;
+    }
+
+    OutMessage = FRshipPTPMessage();
+    OutMessage.Type = FRshipPTPMessage::EType::DelayReq;
+    OutMessage.Domain = Config.Domain;
+    OutMessage.SourceClockIdentity = Config.ClockIdentity;
+    OutMessage.SourcePort = Config.PortNumber;
+    OutMessage.SequenceId = ++DelayReqSequenceId;
+    OutMessage.LogMessageInterval = 0x7F;
+    OutMessage.Timestamp = FRshipPTPTimestamp::FromNanoseconds(Clock.ToPTP(NowLocalNs));
+
+    bDelayReqInFlight = true;
+    DelayReqTxLocalNs = NowLocalNs;  // Until the transport reports the real time
+    NextDelayReqLocalNs = NowLocalNs + SecondsToNs(Config.DelayRequestIntervalSeconds);
+    return true;
+}
+
+void FRshipPTPSlave::OnDelayRequestSent(uint16 SequenceId, uint64 TxLocalNs)
+{
+    if (bDelayReqInFlight && SequenceId == DelayReqSequenceId)
+    {
+        DelayReqTxLocalNs = TxLocalNs;
+    }
+}
+
+void FRshipPTPSlave::Update(uint64 NowLocalNs)
+{
+    if (bHasMaster && NowLocalNs - LastAnnounceLocalNs > SecondsToNs(Config.AnnounceTimeoutSeconds))
+    {
+        // Master gone: keep free-running on the last frequency if we had lock
+        const bool bWasSynced = State == ERshipPTPState::Locked || State == ERshipPTPState::Holdover;
+        Reset();
+        State = bWasSynced ? ERshipPTPState::Holdover : ERshipPTPState::Listening;
+        return;
+    }
+
+    if (State == ERshipPTPState::Locked && NowLocalNs - LastSyncLocalNs > SecondsToNs(Config.SyncTimeoutSeconds))
+    {
+        State = ERshipPTPState::Holdover;
+    }
+}
+
+double FRshipPTPSlave::GetJitterNs() const
+{
+    if (RecentOffsets.Num() < 2)
+    {
+        return 0.0;
+    }
+
+    double Sum = 0.0;
+    for (int64 Offset : RecentOffsets)
+    {
+        Sum += static_cast<double>(Offset);
+    }
+    const double Mean = Sum / RecentOffsets.Num();
+
+    double SumSquares = 0.0;
+    for (int64 Offset : RecentOffsets)
+    {
+        const double Diff = static_cast<double>(Offset) - Mean;
+        SumSquares += Diff * Diff;
+    }
+    return FMath::Sqrt(SumSquares / RecentOffsets.Num());
+}
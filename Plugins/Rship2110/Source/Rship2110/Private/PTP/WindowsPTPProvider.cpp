@@ -8,6 +8,7 @@
 #include "PTP/IPTPProvider.h"
 #include "Rship2110.h"
 #include "HAL/PlatformTime.h"
+#include "Rship2110Settings.h"
 
 #if PLATFORM_WINDOWS
 #include "Windows/AllowWindowsPlatformTypes.h"
@@ -543,10 +544,22 @@ private:
 // FACTORY IMPLEMENTATION
 // ============================================================================
 
+#if PLATFORM_LINUX
+// LinuxPTPProvider.cpp
+TUniquePtr<IPTPProvider> CreateLinuxPTPProvider(const FRshipPTPSocketConfig& SocketConfig);
+#endif
+
 TUniquePtr<IPTPProvider> FPTPProviderFactory::Create()
 {
 #if PLATFORM_WINDOWS
     return MakeUnique<FWindowsPTPProvider>();
+#elif PLATFORM_LINUX
+    FRshipPTPSocketConfig SocketConfig;
+    if (URship2110Settings* Settings = URship2110Settings::Get())
+    {
+        SocketConfig.bHardwareTimestamping = Settings->bUseHardwareTimestamping;
+    }
+    return CreateLinuxPTPProvider(SocketConfig);
 #else
     // Other platforms use fallback
     return CreateFallback();
@@ -557,3 +570,12 @@ TUniquePtr<IPTPProvider> FPTPProviderFactory::CreateFallback()
 {
     return MakeUnique<FFallbackPTPProvider>();
 }
+
+TUniquePtr<IPTPProvider> FPTPProviderFactory::CreateSlave(const FRshipPTPSocketConfig& SocketConfig)
+{
+#if PLATFORM_LINUX
+    return CreateLinuxPTPProvider(SocketConfig);
+#else
+    return nullptr;
+#endif
+}
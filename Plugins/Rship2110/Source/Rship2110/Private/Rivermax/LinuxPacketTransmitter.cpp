@@ -0,0 +1,410 @@
+// Copyright Rocketship. All Rights Reserved.
+// Linux Packet Transmitter Implementation
+//
+// Sends packet batches with sendmmsg. Runs of equal-size packets are
+// coalesced into single UDP_SEGMENT sends that the kernel (or NIC) splits
+// back into datagrams, and SO_TXTIME attaches per-packet launch times for
+// an ETF qdisc. Each feature is probed at Open and dropped if unsupported.
+
+#include "Rivermax/Rship2110PacketTransmitter.h"
+#include "Rship2110.h"
+
+#if PLATFORM_LINUX
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/ip.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+// Kernel interfaces newer than some glibc headers
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef SO_TXTIME
+#define SO_TXTIME 61
+#endif
+#ifndef SCM_TXTIME
+#define SCM_TXTIME SO_TXTIME
+#endif
+#ifndef CLOCK_TAI
+#define CLOCK_TAI 11
+#endif
+
+namespace
+{
+    // struct sock_txtime (linux/net_tstamp.h)
+    struct FSockTxTime
+    {
+        clockid_t ClockId;
+        uint32 Flags;
+    };
+
+    // UIO_MAXIOV: the most messages sendmmsg takes per call
+    constexpr int32 MaxMessagesPerCall = 1024;
+
+    // UDP_MAX_SEGMENTS on older kernels (newer allow 128)
+    constexpr int32 MaxSegmentsPerSend = 64;
+
+    // Largest IPv4 UDP payload
+    constexpr int32 MaxSendBytes = 65507;
+
+    constexpr int32 ControlBytesPerMessage = CMSG_SPACE(sizeof(uint16)) + CMSG_SPACE(sizeof(uint64));
+
+    bool ParseIPv4(const FString& Address, in_addr& Out)
+    {
+        return inet_pton(AF_INET, TCHAR_TO_ANSI(*Address), &Out) == 1;
+    }
+}
+
+class FLinuxPacketTransmitter : public IRship2110PacketTransmitter
+{
+public:
+    virtual ~FLinuxPacketTransmitter()
+    {
+        Close();
+    }
+
+    virtual bool Open(const FRship2110TransportParams& Params, const FRship2110TransmitOptions& Options) override
+    {
+        Close();
+
+        sockaddr_in Destination = {};
+        Destination.sin_family = AF_INET;
+        Destination.sin_port = htons(static_cast<uint16>(Params.DestinationPort));
+        if (!ParseIPv4(Params.DestinationIP, Destination.sin_addr))
+        {
+            UE_LOG(LogRship2110, Warning, TEXT("LinuxTransmitter: Invalid destination IP: %s"), *Params.DestinationIP);
+            return false;
+        }
+
+        Socket = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, IPPROTO_UDP);
+        if (Socket < 0)
+        {
+            UE_LOG(LogRship2110, Warning, TEXT("LinuxTransmitter: socket() failed: %s"), ANSI_TO_TCHAR(strerror(errno)));
+            return false;
+        }
+
+        // FORCE ignores wmem_max but needs CAP_NET_ADMIN
+        const int SendBuffer = Options.SendBufferBytes;
+        if (setsockopt(Socket, SOL_SOCKET, SO_SNDBUFFORCE, &SendBuffer, sizeof(SendBuffer)) != 0)
+        {
+            setsockopt(Socket, SOL_SOCKET, SO_SNDBUF, &SendBuffer, sizeof(SendBuffer));
+        }
+
+        const int TOS = (Params.DSCP & 0x3F) << 2;
+        setsockopt(Socket, IPPROTO_IP, IP_TOS, &TOS, sizeof(TOS));
+
+        const int TTL = Params.TTL;
+        if (IN_MULTICAST(ntohl(Destination.sin_addr.s_addr)))
+        {
+            setsockopt(Socket, IPPROTO_IP, IP_MULTICAST_TTL, &TTL, sizeof(TTL));
+        }
+        else
+        {
+            setsockopt(Socket, IPPROTO_IP, IP_TTL, &TTL, sizeof(TTL));
+        }
+
+        if (!Params.SourceIP.IsEmpty())
+        {
+            sockaddr_in Source = {};
+            Source.sin_family = AF_INET;
+            Source.sin_port = htons(static_cast<uint16>(Params.SourcePort));
+            if (ParseIPv4(Params.SourceIP, Source.sin_addr))
+            {
+                setsockopt(Socket, IPPROTO_IP, IP_MULTICAST_IF, &Source.sin_addr, sizeof(Source.sin_addr));
+                if (bind(Socket, reinterpret_cast<const sockaddr*>(&Source), sizeof(Source)) != 0)
+                {
+                    UE_LOG(LogRship2110, Warning, TEXT("LinuxTransmitter: Could not bind %s:%d: %s"),
+                           *Params.SourceIP, Params.SourcePort, ANSI_TO_TCHAR(strerror(errno)));
+                }
+            }
+        }
+
+        // Connected, so messages carry no address and the route is looked up once
+        if (connect(Socket, reinterpret_cast<const sockaddr*>(&Destination), sizeof(Destination)) != 0)
+        {
+            UE_LOG(LogRship2110, Warning, TEXT("LinuxTransmitter: connect() failed: %s"), ANSI_TO_TCHAR(strerror(errno)));
+            Close();
+            return false;
+        }
+
+        Capabilities = FRship2110TransmitCapabilities();
+        Capabilities.bBatching = true;
+
+        if (Options.bSegmentationOffload)
+        {
+            // Kernels without UDP GSO (< 4.18) reject the option
+            int Segment = 0;
+            socklen_t Length = sizeof(Segment);
+            Capabilities.bSegmentationOffload = getsockopt(Socket, SOL_UDP, UDP_SEGMENT, &Segment, &Length) == 0;
+        }
+
+        if (Options.bLaunchTime)
+        {
+            const FSockTxTime TxTime = { CLOCK_TAI, 0 };
+            Capabilities.bLaunchTime = setsockopt(Socket, SOL_SOCKET, SO_TXTIME, &TxTime, sizeof(TxTime)) == 0;
+            if (!Capabilities.bLaunchTime)
+            {
+                UE_LOG(LogRship2110, Warning, TEXT("LinuxTransmitter: SO_TXTIME unavailable (%s), sending unpaced"),
+                       ANSI_TO_TCHAR(strerror(errno)));
+            }
+        }
+
+        Messages.SetNumZeroed(MaxMessagesPerCall);
+        MessagePackets.SetNumZeroed(MaxMessagesPerCall);
+        MessageBytes.SetNumZeroed(MaxMessagesPerCall);
+        Control.SetNumZeroed(MaxMessagesPerCall * ControlBytesPerMessage);
+
+        PacketsSent = 0;
+        BytesSent = 0;
+        PacketsFailed = 0;
+        SystemCalls = 0;
+        bLoggedSendError = false;
+
+        UE_LOG(LogRship2110, Log, TEXT("LinuxTransmitter: Opened to %s:%d (GSO %s, launch time %s)"),
+               *Params.DestinationIP, Params.DestinationPort,
+               Capabilities.bSegmentationOffload ? TEXT("on") : TEXT("off"),
+               Capabilities.bLaunchTime ? TEXT("on") : TEXT("off"));
+
+        return true;
+    }
+
+    virtual void Close() override
+    {
+        if (Socket >= 0)
+        {
+            close(Socket);
+            Socket = -1;
+        }
+        Capabilities = FRship2110TransmitCapabilities();
+    }
+
+    virtual bool IsOpen() const override
+    {
+        return Socket >= 0;
+    }
+
+    virtual int32 SendPackets(TConstArrayView<FRship2110Packet> Packets, TConstArrayView<uint64> LaunchTimesNs) override
+    {
+        if (Socket < 0 || Packets.Num() == 0)
+        {
+            return 0;
+        }
+
+        // Grows to the frame's packet count once, then stays
+        if (Vectors.Num() < Packets.Num())
+        {
+            Vectors.SetNumZeroed(Packets.Num());
+        }
+
+        // A coalesced send leaves with one launch time, so timed packets go one per message
+        const bool bTimed = Capabilities.bLaunchTime && LaunchTimesNs.Num() == Packets.Num();
+
+        int32 NumSent = 0;
+        int32 Next = 0;
+        while (Next < Packets.Num())
+        {
+            const bool bCoalesce = Capabilities.bSegmentationOffload && !bTimed;
+            const int32 FirstPacket = Next;
+            const int32 NumMessages = BuildMessages(Packets, LaunchTimesNs, bCoalesce, bTimed, Next);
+
+            int32 Done = 0;
+            while (Done < NumMessages)
+            {
+                const int Result = SendMessages(Done, NumMessages - Done);
+                if (Result > 0)
+                {
+                    for (int32 i = Done; i < Done + Result; ++i)
+                    {
+                        NumSent += MessagePackets[i];
+                        BytesSent.fetch_add(MessageBytes[i], std::memory_order_relaxed);
+                    }
+                    Done += Result;
+                    continue;
+                }
+
+                const int Error = errno;
+                if (Error == EINTR)
+                {
+                    continue;
+                }
+
+                if (bCoalesce && (Error == EIO || Error == EINVAL || Error == EOPNOTSUPP))
+                {
+                    // Segmentation refused by the route or device: resend the rest uncoalesced
+                    UE_LOG(LogRship2110, Warning, TEXT("LinuxTransmitter: UDP_SEGMENT rejected (%s), disabling"),
+                           ANSI_TO_TCHAR(strerror(Error)));
+                    Capabilities.bSegmentationOffload = false;
+                    Next = FirstPacket;
+                    for (int32 i = 0; i < Done; ++i)
+                    {
+                        Next += MessagePackets[i];
+                    }
+                    break;
+                }
+
+                // Drop this message and carry on; ICMP errors on a connected socket land here
+                if (!bLoggedSendError)
+                {
+                    UE_LOG(LogRship2110, Warning, TEXT("LinuxTransmitter: send failed: %s"), ANSI_TO_TCHAR(strerror(Error)));
+                    bLoggedSendError = true;
+                }
+                PacketsFailed.fetch_add(MessagePackets[Done], std::memory_order_relaxed);
+                Done++;
+            }
+        }
+
+        PacketsSent.fetch_add(NumSent, std::memory_order_relaxed);
+        return NumSent;
+    }
+
+    virtual FRship2110TransmitCapabilities GetCapabilities() const override
+    {
+        return Capabilities;
+    }
+
+    virtual bool GetLaunchClockNs(uint64& OutNs) const override
+    {
+        timespec Now;
+        if (clock_gettime(CLOCK_TAI, &Now) != 0)
+        {
+            return false;
+        }
+        OutNs = static_cast<uint64>(Now.tv_sec) * 1000000000ull + static_cast<uint64>(Now.tv_nsec);
+        return true;
+    }
+
+    virtual FRship2110TransmitStats GetStats() const override
+    {
+        FRship2110TransmitStats Stats;
+        Stats.PacketsSent = PacketsSent.load(std::memory_order_relaxed);
+        Stats.BytesSent = BytesSent.load(std::memory_order_relaxed);
+        Stats.PacketsFailed = PacketsFailed.load(std::memory_order_relaxed);
+        Stats.SystemCalls = SystemCalls.load(std::memory_order_relaxed);
+        return Stats;
+    }
+
+    virtual FString GetName() const override
+    {
+        return TEXT("Linux sendmmsg");
+    }
+
+private:
+    /**
+     * Fill up to MaxMessagesPerCall messages starting at packet Next.
+     * @return Number of messages built; Next advances past their packets
+     */
+    int32 BuildMessages(TConstArrayView<FRship2110Packet> Packets, TConstArrayView<uint64> LaunchTimesNs,
+                        bool bCoalesce, bool bTimed, int32& Next)
+    {
+        int32 NumMessages = 0;
+
+        while (Next < Packets.Num() && NumMessages < MaxMessagesPerCall)
+        {
+            const int32 First = Next;
+            const int32 SegmentSize = Packets[First].Size;
+            int32 Bytes = 0;
+
+            // Segments must all be SegmentSize except a shorter last one
+            do
+            {
+                Vectors[Next].iov_base = const_cast<uint8*>(Packets[Next].Data);
+                Vectors[Next].iov_len = Packets[Next].Size;
+                Bytes += Packets[Next].Size;
+                Next++;
+            }
+            while (bCoalesce && Next < Packets.Num() && Next - First < MaxSegmentsPerSend &&
+                   Packets[Next - 1].Size == SegmentSize && Packets[Next].Size <= SegmentSize &&
+                   Bytes + Packets[Next].Size <= MaxSendBytes);
+
+            const int32 Count = Next - First;
+            mmsghdr& Message = Messages[NumMessages];
+            FMemory::Memzero(Message);
+            Message.msg_hdr.msg_iov = &Vectors[First];
+            Message.msg_hdr.msg_iovlen = Count;
+
+            uint8* ControlData = Control.GetData() + NumMessages * ControlBytesPerMessage;
+            size_t ControlUsed = 0;
+
+            if (Count > 1)
+            {
+                cmsghdr* Header = reinterpret_cast<cmsghdr*>(ControlData + ControlUsed);
+                Header->cmsg_level = SOL_UDP;
+                Header->cmsg_type = UDP_SEGMENT;
+                Header->cmsg_len = CMSG_LEN(sizeof(uint16));
+                const uint16 Segment = static_cast<uint16>(SegmentSize);
+                FMemory::Memcpy(CMSG_DATA(Header), &Segment, sizeof(Segment));
+                ControlUsed += CMSG_SPACE(sizeof(uint16));
+            }
+
+            if (bTimed)
+            {
+                cmsghdr* Header = reinterpret_cast<cmsghdr*>(ControlData + ControlUsed);
+                Header->cmsg_level = SOL_SOCKET;
+                Header->cmsg_type = SCM_TXTIME;
+                Header->cmsg_len = CMSG_LEN(sizeof(uint64));
+                const uint64 LaunchTime = LaunchTimesNs[First];
+                FMemory::Memcpy(CMSG_DATA(Header), &LaunchTime, sizeof(LaunchTime));
+                ControlUsed += CMSG_SPACE(sizeof(uint64));
+            }
+
+            Message.msg_hdr.msg_control = ControlUsed > 0 ? ControlData : nullptr;
+            Message.msg_hdr.msg_controllen = ControlUsed;
+
+            MessagePackets[NumMessages] = Count;
+            MessageBytes[NumMessages] = Bytes;
+            NumMessages++;
+        }
+
+        return NumMessages;
+    }
+
+    /** sendmmsg, or sendmsg in a loop where the kernel lacks it */
+    int SendMessages(int32 First, int32 Count)
+    {
+        SystemCalls.fetch_add(1, std::memory_order_relaxed);
+
+        if (Capabilities.bBatching)
+        {
+            const int Result = sendmmsg(Socket, &Messages[First], Count, 0);
+            if (Result >= 0 || errno != ENOSYS)
+            {
+                return Result;
+            }
+            Capabilities.bBatching = false;
+        }
+
+        const ssize_t Result = sendmsg(Socket, &Messages[First].msg_hdr, 0);
+        return Result >= 0 ? 1 : -1;
+    }
+
+    int Socket = -1;
+    FRship2110TransmitCapabilities Capabilities;
+    bool bLoggedSendError = false;
+
+    TArray<mmsghdr> Messages;
+    TArray<int32> MessagePackets;
+    TArray<int32> MessageBytes;
+    TArray<iovec> Vectors;
+    TArray<uint8> Control;
+
+    std::atomic<int64> PacketsSent{0};
+    std::atomic<int64> BytesSent{0};
+    std::atomic<int64> PacketsFailed{0};
+    std::atomic<int64> SystemCalls{0};
+};
+
+TUniquePtr<IRship2110PacketTransmitter> CreateLinuxPacketTransmitter()
+{
+    return MakeUnique<FLinuxPacketTransmitter>();
+}
+
+#endif  // PLATFORM_LINUX
@@ -0,0 +1,581 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "Rivermax/Rship2110AncPacketizer.h"
+
+namespace
+{
+    void WriteBE16(uint8* Dest, uint32 Value)
+    {
+        Dest[0] = static_cast<uint8>(Value >> 8);
+        Dest[1] = static_cast<uint8>(Value);
+    }
+
+    void WriteBE32(uint8* Dest, uint32 Value)
+    {
+        WriteBE16(Dest, Value >> 16);
+        WriteBE16(Dest + 2, Value);
+    }
+
+    uint32 ReadBE16(const uint8* Source)
+    {
+        return (static_cast<uint32>(Source[0]) << 8) | Source[1];
+    }
+
+    uint32 ReadBE32(const uint8* Source)
+    {
+        return (ReadBE16(Source) << 16) | ReadBE16(Source + 2);
+    }
+
+    /** MSB-first bit packing into a zeroed buffer */
+    struct FBitWriter
+    {
+        uint8* Dest;
+        int32 BitPos = 0;
+
+        void Write(uint32 Value, int32 NumBits)
+        {
+            for (int32 Bit = NumBits - 1; Bit >= 0; --Bit)
+            {
+                if ((Value >> Bit) & 1)
+                {
+                    Dest[BitPos >> 3] |= 0x80 >> (BitPos & 7);
+                }
+                ++BitPos;
+            }
+        }
+    };
+
+    /** MSB-first bit reading, bounded by the buffer */
+    struct FBitReader
+    {
+        const uint8* Source;
+        int32 NumBits;
+        int32 BitPos = 0;
+
+        bool CanRead(int32 Bits) const
+        {
+            return BitPos + Bits <= NumBits;
+        }
+
+        uint32 Read(int32 Bits)
+        {
+            uint32 Value = 0;
+            for (int32 Bit = 0; Bit < Bits; ++Bit)
+            {
+                Value = (Value << 1) | ((Source[BitPos >> 3] >> (7 - (BitPos & 7))) & 1);
+                ++BitPos;
+            }
+            return Value;
+        }
+    };
+
+    bool HasValidParity(uint16 Word)
+    {
+        return Word == FRship2110AncPacketizer::AddParity(static_cast<uint8>(Word));
+    }
+
+    // Fixed ST 291 identifiers
+    constexpr uint8 ATC_DID = 0x60;
+    constexpr uint8 ATC_SDID = 0x60;
+    constexpr uint8 CDP_DID = 0x61;
+    constexpr uint8 CDP_SDID = 0x01;
+    constexpr uint8 SCTE104_DID = 0x41;
+    constexpr uint8 SCTE104_SDID = 0x07;
+
+    /** Line 9, the usual home of timecode and captions in HD formats */
+    constexpr uint16 DefaultAncLine = 9;
+}
+
+// ============================================================================
+// PACKETIZER
+// ============================================================================
+
+void FRship2110AncPacketizer::Configure(uint8 InPayloadType, uint32 InSSRC, int32 InMaxPacketSize)
+{
+    PayloadType = InPayloadType & 0x7F;
+    SSRC = InSSRC;
+    MaxPacketSize = InMaxPacketSize;
+}
+
+uint16 FRship2110AncPacketizer::AddParity(uint8 Value)
+{
+    const uint16 EvenParity = FMath::CountBits(Value) & 1;
+    return static_cast<uint16>(Value | (EvenParity << 8) | ((EvenParity ^ 1) << 9));
+}
+
+uint16 FRship2110AncPacketizer::ComputeChecksum(TConstArrayView<uint16> Words)
+{
+    uint32 Sum = 0;
+    for (uint16 Word : Words)
+    {
+        Sum += Word & 0x1FF;
+    }
+    Sum &= 0x1FF;
+    return static_cast<uint16>(Sum | ((~Sum & 0x100) << 1));
+}
+
+int32 FRship2110AncPacketizer::GetEncodedSize(const FRship2110AncPacket& Packet)
+{
+    // 32-bit location header, then DID, SDID, DC, UDWs and checksum as 10-bit words
+    const int32 WordBits = 10 * (Packet.UserData.Num() + 4);
+    return 4 + (WordBits + 31) / 32 * 4;
+}
+
+void FRship2110AncPacketizer::EncodeAncPacket(const FRship2110AncPacket& Packet, uint8* Dest)
+{
+    FMemory::Memzero(Dest, GetEncodedSize(Packet));
+
+    FBitWriter Writer{Dest};
+    Writer.Write(Packet.bColorDifference ? 1 : 0, 1);
+    Writer.Write(Packet.LineNumber, 11);
+    Writer.Write(Packet.HorizontalOffset, 12);
+    Writer.Write(Packet.StreamNum >= 0 ? 1 : 0, 1);
+    Writer.Write(Packet.StreamNum >= 0 ? Packet.StreamNum : 0, 7);
+
+    uint16 Words[258];
+    int32 NumWords = 0;
+    Words[NumWords++] = AddParity(Packet.DID);
+    Words[NumWords++] = AddParity(Packet.SDID);
+    Words[NumWords++] = AddParity(static_cast<uint8>(Packet.UserData.Num()));
+    for (uint8 Value : Packet.UserData)
+    {
+        Words[NumWords++] = AddParity(Value);
+    }
+
+    for (int32 Index = 0; Index < NumWords; ++Index)
+    {
+        Writer.Write(Words[Index], 10);
+    }
+    Writer.Write(ComputeChecksum(MakeArrayView(Words, NumWords)), 10);
+
+    // word_align bits are already zero
+}
+
+TConstArrayView<FRship2110Packet> FRship2110AncPacketizer::PacketizeFrame(TConstArrayView<FRship2110AncPacket> AncPackets, uint32 RTPTimestamp)
+{
+    const int32 HeaderBytes = RTPHeaderSize + PayloadHeaderSize;
+    const int32 MaxAncBytes = MaxPacketSize - HeaderBytes;
+
+    // Plan the split first so the arena is sized once and packet pointers stay put
+    Selected.Reset();
+    GroupStarts.Reset();
+    int32 TotalBytes = 0;
+    int32 GroupBytes = 0;
+    for (int32 Index = 0; Index < AncPackets.Num(); ++Index)
+    {
+        const FRship2110AncPacket& AncPacket = AncPackets[Index];
+        const int32 EncodedSize = GetEncodedSize(AncPacket);
+        if (!AncPacket.IsValid() || EncodedSize > MaxAncBytes)
+        {
+            ++SkippedCount;
+            continue;
+        }
+
+        const int32 GroupCount = GroupStarts.Num() > 0 ? Selected.Num() - GroupStarts.Last() : 0;
+        if (GroupStarts.Num() == 0 || GroupBytes + EncodedSize > MaxAncBytes || GroupCount == 255)
+        {
+            GroupStarts.Add(Selected.Num());
+            TotalBytes += HeaderBytes;
+            GroupBytes = 0;
+        }
+
+        Selected.Add(Index);
+        GroupBytes += EncodedSize;
+        TotalBytes += EncodedSize;
+    }
+
+    // A frame without ANC data still gets one empty packet
+    if (GroupStarts.Num() == 0)
+    {
+        GroupStarts.Add(0);
+        TotalBytes = HeaderBytes;
+    }
+
+    Arena.SetNumUninitialized(TotalBytes, EAllowShrinking::No);
+    Packets.Reset();
+
+    uint8* Cursor = Arena.GetData();
+    for (int32 Group = 0; Group < GroupStarts.Num(); ++Group)
+    {
+        const int32 First = GroupStarts[Group];
+        const int32 End = Group + 1 < GroupStarts.Num() ? GroupStarts[Group + 1] : Selected.Num();
+        const bool bLast = Group + 1 == GroupStarts.Num();
+
+        uint8* Packet = Cursor;
+        uint8* Anc = Packet + HeaderBytes;
+        for (int32 Slot = First; Slot < End; ++Slot)
+        {
+            const FRship2110AncPacket& AncPacket = AncPackets[Selected[Slot]];
+            EncodeAncPacket(AncPacket, Anc);
+            Anc += GetEncodedSize(AncPacket);
+        }
+        const int32 AncBytes = static_cast<int32>(Anc - Packet) - HeaderBytes;
+
+        // RTP header (RFC 3550); marker on the frame's last packet
+        Packet[0] = 0x80;
+        Packet[1] = static_cast<uint8>(PayloadType | (bLast ? 0x80 : 0x00));
+        WriteBE16(Packet + 2, ExtendedSequenceNumber & 0xFFFF);
+        WriteBE32(Packet + 4, RTPTimestamp);
+        WriteBE32(Packet + 8, SSRC);
+
+        // RFC 8331 payload header: ESN, Length, ANC_Count, F = 0, reserved
+        WriteBE16(Packet + 12, ExtendedSequenceNumber >> 16);
+        WriteBE16(Packet + 14, AncBytes);
+        WriteBE32(Packet + 16, static_cast<uint32>(End - First) << 24);
+
+        ++ExtendedSequenceNumber;
+        Packets.Add({Packet, HeaderBytes + AncBytes});
+        Cursor = Anc;
+    }
+
+    return Packets;
+}
+
+// ============================================================================
+// DEPACKETIZER
+// ============================================================================
+
+bool FRship2110AncDepacketizer::ReceivePacket(const uint8* Data, int32 Size)
+{
+    constexpr int32 HeaderBytes = FRship2110AncPacketizer::RTPHeaderSize + FRship2110AncPacketizer::PayloadHeaderSize;
+    if (!Data || Size < HeaderBytes || (Data[0] >> 6) != 2)
+    {
+        ++Stats.PacketsMalformed;
+        return false;
+    }
+
+    ++Stats.PacketsReceived;
+
+    const uint32 SequenceNumber = (ReadBE16(Data + 12) << 16) | ReadBE16(Data + 2);
+    if (bHavePacket)
+    {
+        const uint32 Gap = SequenceNumber - LastSequenceNumber - 1;
+        if (Gap > 0 && Gap < 0x8000)
+        {
+            Stats.PacketsLost += Gap;
+        }
+    }
+    bHavePacket = true;
+    LastSequenceNumber = SequenceNumber;
+
+    const uint32 Timestamp = ReadBE32(Data + 4);
+    if (bFrameComplete || Timestamp != FrameTimestamp)
+    {
+        FramePackets.Reset();
+        FrameTimestamp = Timestamp;
+        bFrameComplete = false;
+    }
+
+    const int32 AncBytes = static_cast<int32>(ReadBE16(Data + 14));
+    const int32 AncCount = Data[16];
+    if (HeaderBytes + AncBytes > Size)
+    {
+        ++Stats.PacketsMalformed;
+        return false;
+    }
+
+    const uint8* Anc = Data + HeaderBytes;
+    int32 Remaining = AncBytes;
+    for (int32 Index = 0; Index < AncCount; ++Index)
+    {
+        const int32 Consumed = DecodeAncPacket(Anc, Remaining);
+        if (Consumed == 0)
+        {
+            ++Stats.PacketsMalformed;
+            break;
+        }
+        Anc += Consumed;
+        Remaining -= Consumed;
+    }
+
+    if (Data[1] & 0x80)
+    {
+        bFrameComplete = true;
+        ++Stats.FramesCompleted;
+        return true;
+    }
+    return false;
+}
+
+int32 FRship2110AncDepacketizer::DecodeAncPacket(const uint8* Data, int32 Size)
+{
+    FBitReader Reader{Data, Size * 8};
+    if (!Reader.CanRead(32 + 30))
+    {
+        return 0;
+    }
+
+    FRship2110AncPacket Packet;
+    Packet.bColorDifference = Reader.Read(1) != 0;
+    Packet.LineNumber = static_cast<uint16>(Reader.Read(11));
+    Packet.HorizontalOffset = static_cast<uint16>(Reader.Read(12));
+    const bool bHasStream = Reader.Read(1) != 0;
+    const int32 StreamNum = static_cast<int32>(Reader.Read(7));
+    Packet.StreamNum = bHasStream ? StreamNum : -1;
+
+    uint16 Words[258];
+    Words[0] = static_cast<uint16>(Reader.Read(10));
+    Words[1] = static_cast<uint16>(Reader.Read(10));
+    Words[2] = static_cast<uint16>(Reader.Read(10));
+    const int32 DataCount = Words[2] & 0xFF;
+    if (!Reader.CanRead(10 * (DataCount + 1)))
+    {
+        return 0;
+    }
+
+    for (int32 Index = 0; Index < DataCount; ++Index)
+    {
+        Words[3 + Index] = static_cast<uint16>(Reader.Read(10));
+    }
+    const uint16 Checksum = static_cast<uint16>(Reader.Read(10));
+
+    // Word-aligned to the next 32 bits
+    const int32 Consumed = (Reader.BitPos + 31) / 32 * 4;
+    const int32 NumWords = 3 + DataCount;
+
+    bool bParityOk = true;
+    for (int32 Index = 0; Index < NumWords; ++Index)
+    {
+        bParityOk &= HasValidParity(Words[Index]);
+    }
+    if (!bParityOk)
+    {
+        ++Stats.ParityErrors;
+        return Consumed;
+    }
+    if (Checksum != FRship2110AncPacketizer::ComputeChecksum(MakeArrayView(Words, NumWords)))
+    {
+        ++Stats.ChecksumErrors;
+        return Consumed;
+    }
+
+    Packet.DID = static_cast<uint8>(Words[0]);
+    Packet.SDID = static_cast<uint8>(Words[1]);
+    Packet.UserData.SetNumUninitialized(DataCount);
+    for (int32 Index = 0; Index < DataCount; ++Index)
+    {
+        Packet.UserData[Index] = static_cast<uint8>(Words[3 + Index]);
+    }
+
+    FramePackets.Add(MoveTemp(Packet));
+    return Consumed;
+}
+
+// ============================================================================
+// PAYLOAD BUILDERS
+// ============================================================================
+
+FRship2110AncPacket FRship2110AncData::MakeTimecode(const FTimecode& Timecode, ETimecodeType Type, uint32 UserBits)
+{
+    auto UserGroup = [UserBits](int32 Group) -> uint64
+    {
+        return (UserBits >> (4 * Group)) & 0xF;
+    };
+
+    // ST 12-1 timecode word, sync word excluded
+    uint64 Bits = 0;
+    Bits |= static_cast<uint64>(Timecode.Frames % 10);
+    Bits |= UserGroup(0) << 4;
+    Bits |= static_cast<uint64>((Timecode.Frames / 10) & 0x3) << 8;
+    Bits |= static_cast<uint64>(Timecode.bDropFrameFormat ? 1 : 0) << 10;
+    Bits |= UserGroup(1) << 12;
+    Bits |= static_cast<uint64>(Timecode.Seconds % 10) << 16;
+    Bits |= UserGroup(2) << 20;
+    Bits |= static_cast<uint64>((Timecode.Seconds / 10) & 0x7) << 24;
+    Bits |= UserGroup(3) << 28;
+    Bits |= static_cast<uint64>(Timecode.Minutes % 10) << 32;
+    Bits |= UserGroup(4) << 36;
+    Bits |= static_cast<uint64>((Timecode.Minutes / 10) & 0x7) << 40;
+    Bits |= UserGroup(5) << 44;
+    Bits |= static_cast<uint64>(Timecode.Hours % 10) << 48;
+    Bits |= UserGroup(6) << 52;
+    Bits |= static_cast<uint64>((Timecode.Hours / 10) & 0x3) << 56;
+    Bits |= UserGroup(7) << 60;
+
+    FRship2110AncPacket Packet;
+    Packet.DID = ATC_DID;
+    Packet.SDID = ATC_SDID;
+    Packet.LineNumber = DefaultAncLine;
+    Packet.UserData.SetNumUninitialized(16);
+
+    // Each UDW carries a nibble in b4-b7; b3 carries DBB1 (UDW 1-8) then DBB2 (UDW 9-16)
+    const uint8 DBB1 = static_cast<uint8>(Type);
+    const uint8 DBB2 = 0;
+    for (int32 Index = 0; Index < 16; ++Index)
+    {
+        const uint8 Nibble = static_cast<uint8>((Bits >> (4 * Index)) & 0xF);
+        const uint8 DBB = Index < 8 ? (DBB1 >> Index) & 1 : (DBB2 >> (Index - 8)) & 1;
+        Packet.UserData[Index] = static_cast<uint8>((Nibble << 4) | (DBB << 3));
+    }
+
+    return Packet;
+}
+
+bool FRship2110AncData::ParseTimecode(const FRship2110AncPacket& Packet, FTimecode& OutTimecode)
+{
+    if (Packet.DID != ATC_DID || Packet.SDID != ATC_SDID || Packet.UserData.Num() != 16)
+    {
+        return false;
+    }
+
+    uint64 Bits = 0;
+    for (int32 Index = 0; Index < 16; ++Index)
+    {
+        Bits |= static_cast<uint64>(Packet.UserData[Index] >> 4) << (4 * Index);
+    }
+
+    auto Field = [Bits](int32 Shift, int32 Width) -> int32
+    {
+        return static_cast<int32>((Bits >> Shift) & ((1ull << Width) - 1));
+    };
+
+    OutTimecode.Frames = Field(8, 2) * 10 + Field(0, 4);
+    OutTimecode.Seconds = Field(24, 3) * 10 + Field(16, 4);
+    OutTimecode.Minutes = Field(40, 3) * 10 + Field(32, 4);
+    OutTimecode.Hours = Field(56, 2) * 10 + Field(48, 4);
+    OutTimecode.bDropFrameFormat = Field(10, 1) != 0;
+    return true;
+}
+
+int32 FRship2110AncData::GetCaptionTripletsPerFrame(const FFrameRate& FrameRate)
+{
+    const double Rate = FrameRate.AsDecimal();
+    if (Rate < 23.0 || Rate > 61.0)
+    {
+        return 0;
+    }
+
+    // CEA-708 cc_count per frame: 9600 bit/s of caption data
+    if (FMath::IsNearlyEqual(Rate, 24000.0 / 1001.0, 0.01) || FMath::IsNearlyEqual(Rate, 24.0, 0.01))
+    {
+        return 25;
+    }
+    if (FMath::IsNearlyEqual(Rate, 25.0, 0.01))
+    {
+        return 24;
+    }
+    if (FMath::IsNearlyEqual(Rate, 30000.0 / 1001.0, 0.01) || FMath::IsNearlyEqual(Rate, 30.0, 0.01))
+    {
+        return 20;
+    }
+    if (FMath::IsNearlyEqual(Rate, 50.0, 0.01))
+    {
+        return 12;
+    }
+    if (FMath::IsNearlyEqual(Rate, 60000.0 / 1001.0, 0.01) || FMath::IsNearlyEqual(Rate, 60.0, 0.01))
+    {
+        return 10;
+    }
+    return 0;
+}
+
+FRship2110AncPacket FRship2110AncData::MakeCaptionCDP(TConstArrayView<uint8> CCData, const FFrameRate& FrameRate, uint16 Sequence)
+{
+    FRship2110AncPacket Packet;
+    Packet.DID = CDP_DID;
+    Packet.SDID = CDP_SDID;
+    Packet.LineNumber = DefaultAncLine;
+
+    // cdp_frame_rate codes, 23.976 through 60
+    static const double Rates[] = {24000.0 / 1001.0, 24.0, 25.0, 30000.0 / 1001.0, 30.0, 50.0, 60000.0 / 1001.0, 60.0};
+    uint8 RateCode = 0;
+    for (int32 Index = 0; Index < UE_ARRAY_COUNT(Rates); ++Index)
+    {
+        if (FMath::IsNearlyEqual(FrameRate.AsDecimal(), Rates[Index], 0.01))
+        {
+            RateCode = static_cast<uint8>(Index + 1);
+        }
+    }
+
+    const int32 CCCount = GetCaptionTripletsPerFrame(FrameRate);
+    if (RateCode == 0 || CCCount == 0)
+    {
+        return Packet;
+    }
+
+    TArray<uint8>& CDP = Packet.UserData;
+    CDP.Reserve(13 + 3 * CCCount);
+
+    // cdp_header
+    CDP.Add(0x96);
+    CDP.Add(0x69);
+    CDP.Add(static_cast<uint8>(13 + 3 * CCCount));
+    CDP.Add(static_cast<uint8>((RateCode << 4) | 0x0F));
+    CDP.Add(0x43);  // ccdata_present, caption_service_active, reserved
+    CDP.Add(static_cast<uint8>(Sequence >> 8));
+    CDP.Add(static_cast<uint8>(Sequence));
+
+    // ccdata_section, padded with invalid DTVCC triplets
+    CDP.Add(0x72);
+    CDP.Add(static_cast<uint8>(0xE0 | CCCount));
+    const int32 Provided = FMath::Min(CCData.Num() / 3, CCCount);
+    CDP.Append(CCData.GetData(), Provided * 3);
+    for (int32 Index = Provided; Index < CCCount; ++Index)
+    {
+        CDP.Add(0xFA);
+        CDP.Add(0x00);
+        CDP.Add(0x00);
+    }
+
+    // cdp_footer; the checksum makes the CDP's bytes sum to zero
+    CDP.Add(0x74);
+    CDP.Add(static_cast<uint8>(Sequence >> 8));
+    CDP.Add(static_cast<uint8>(Sequence));
+    uint8 Sum = 0;
+    for (uint8 Value : CDP)
+    {
+        Sum += Value;
+    }
+    CDP.Add(static_cast<uint8>(-static_cast<int32>(Sum)));
+
+    return Packet;
+}
+
+FRship2110AncPacket FRship2110AncData::MakeSCTE104(TConstArrayView<uint8> Message)
+{
+    FRship2110AncPacket Packet;
+    Packet.DID = SCTE104_DID;
+    Packet.SDID = SCTE104_SDID;
+    Packet.LineNumber = DefaultAncLine;
+
+    // SMPTE 2010 payload descriptor: version 1, single packet
+    Packet.UserData.Reserve(1 + Message.Num());
+    Packet.UserData.Add(0x08);
+    Packet.UserData.Append(Message.GetData(), FMath::Min(Message.Num(), 254));
+    return Packet;
+}
+
+TArray<uint8> FRship2110AncData::MakeSpliceRequest(ESpliceInsertType Type, uint32 SpliceEventId, uint16 UniqueProgramId,
+                                                   uint16 PreRollMs, uint16 BreakDurationTenths, bool bAutoReturn,
+                                                   uint8 MessageNumber)
+{
+    constexpr int32 MessageSize = 30;
+    TArray<uint8> Message;
+    Message.SetNumZeroed(MessageSize);
+    uint8* Bytes = Message.GetData();
+
+    // multiple_operation_message header
+    WriteBE16(Bytes + 0, 0xFFFF);
+    WriteBE16(Bytes + 2, MessageSize);
+    Bytes[4] = 0;                   // protocol_version
+    Bytes[5] = 0;                   // AS_index
+    Bytes[6] = MessageNumber;
+    WriteBE16(Bytes + 7, 0);        // DPI_PID_index
+    Bytes[9] = 0;                   // SCTE35_protocol_version
+    Bytes[10] = 0;                  // timestamp: time_type 0, immediate
+    Bytes[11] = 1;                  // num_ops
+
+    // splice_request_data
+    WriteBE16(Bytes + 12, 0x0101);
+    WriteBE16(Bytes + 14, 14);
+    Bytes[16] = static_cast<uint8>(Type);
+    WriteBE32(Bytes + 17, SpliceEventId);
+    WriteBE16(Bytes + 21, UniqueProgramId);
+    WriteBE16(Bytes + 23, PreRollMs);
+    WriteBE16(Bytes + 25, BreakDurationTenths);
+    Bytes[27] = 0;                  // avail_num
+    Bytes[28] = 0;                  // avails_expected
+    Bytes[29] = bAutoReturn ? 1 : 0;
+
+    return Message;
+}
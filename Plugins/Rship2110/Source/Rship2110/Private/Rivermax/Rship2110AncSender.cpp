@@ -0,0 +1,286 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "Rivermax/Rship2110AncSender.h"
+#include "Rivermax/Rship2110VideoSender.h"
+#include "Rship2110.h"
+#include "Rship2110Settings.h"
+
+// ============================================================================
+// ANCILLARY SENDER IMPLEMENTATION
+// ============================================================================
+
+bool URship2110AncSender::Initialize(URship2110VideoSender* InVideoSender, const FRship2110TransportParams& InTransportParams)
+{
+    VideoSender = InVideoSender;
+    TransportParams = InTransportParams;
+
+    // Generate SSRC if not specified
+    if (TransportParams.SSRC == 0)
+    {
+        TransportParams.SSRC = FMath::Rand();
+    }
+
+    if (VideoSender)
+    {
+        const FRship2110VideoFormat VideoFormat = VideoSender->GetVideoFormat();
+        FrameRate = FFrameRate(VideoFormat.FrameRateNumerator, VideoFormat.FrameRateDenominator);
+        FrameQueuedHandle = VideoSender->OnFrameQueued().AddUObject(this, &URship2110AncSender::SendFrame);
+    }
+
+    URship2110Settings* Settings = URship2110Settings::Get();
+    FRship2110TransmitOptions TransmitOptions;
+    if (Settings)
+    {
+        TransmitOptions.bSegmentationOffload = Settings->bUseSegmentationOffload;
+    }
+
+    Packetizer.Configure(static_cast<uint8>(TransportParams.PayloadType), TransportParams.SSRC);
+    Transmitter = FRship2110TransmitterFactory::CreateOpen(TransportParams, TransmitOptions);
+    if (!Transmitter)
+    {
+        UE_LOG(LogRship2110, Warning, TEXT("AncSender: No socket to %s:%d, ancillary data will not be sent"),
+               *TransportParams.DestinationIP, TransportParams.DestinationPort);
+    }
+
+    State = ERship2110StreamState::Stopped;
+
+    UE_LOG(LogRship2110, Log, TEXT("AncSender: Initialized, %s"),
+           VideoSender ? *FString::Printf(TEXT("following video stream %s"), *VideoSender->GetStreamId()) : TEXT("frames driven externally"));
+
+    return true;
+}
+
+void URship2110AncSender::Shutdown()
+{
+    StopStream();
+
+    if (VideoSender)
+    {
+        VideoSender->OnFrameQueued().Remove(FrameQueuedHandle);
+        FrameQueuedHandle.Reset();
+    }
+
+    {
+        // Waits out a frame in flight on the video thread
+        FScopeLock Lock(&SendLock);
+        Transmitter.Reset();
+    }
+
+    VideoSender = nullptr;
+
+    UE_LOG(LogRship2110, Log, TEXT("AncSender: Shutdown complete"));
+}
+
+bool URship2110AncSender::StartStream()
+{
+    if (State == ERship2110StreamState::Running)
+    {
+        return true;
+    }
+
+    if (!Transmitter)
+    {
+        UE_LOG(LogRship2110, Error, TEXT("AncSender %s: No transmitter, cannot start"), *StreamId);
+        return false;
+    }
+
+    {
+        FScopeLock Lock(&SendLock);
+        Packetizer.SetExtendedSequenceNumber(static_cast<uint32>(FMath::Rand()));
+    }
+
+    SetState(ERship2110StreamState::Running);
+
+    UE_LOG(LogRship2110, Log, TEXT("AncSender %s: Stream started"), *StreamId);
+    return true;
+}
+
+void URship2110AncSender::StopStream()
+{
+    if (State == ERship2110StreamState::Stopped)
+    {
+        return;
+    }
+
+    {
+        FScopeLock Lock(&SendLock);
+        SetState(ERship2110StreamState::Stopped);
+    }
+
+    {
+        FScopeLock Lock(&QueueLock);
+        Queued.Reset();
+    }
+
+    UE_LOG(LogRship2110, Log, TEXT("AncSender %s: Stream stopped"), *StreamId);
+}
+
+void URship2110AncSender::SendFrame(uint32 RTPTimestamp)
+{
+    FScopeLock Lock(&SendLock);
+    if (State != ERship2110StreamState::Running || !Transmitter)
+    {
+        return;
+    }
+
+    // Take the queue; anything queued from here on goes with the next frame
+    Sending.Reset();
+    {
+        FScopeLock QueueScope(&QueueLock);
+        Swap(Sending, Queued);
+    }
+
+    const int64 SkippedBefore = Packetizer.GetSkippedCount();
+    const TConstArrayView<FRship2110Packet> Packets = Packetizer.PacketizeFrame(Sending, RTPTimestamp);
+
+    const int32 Sent = Transmitter->SendPackets(Packets);
+    int64 Bytes = 0;
+    for (int32 Index = 0; Index < Sent; ++Index)
+    {
+        Bytes += Packets[Index].Size;
+    }
+
+    Stats.FramesSent++;
+    Stats.PacketsSent += Sent;
+    Stats.BytesSent += Bytes;
+    Stats.FramesDropped += Packetizer.GetSkippedCount() - SkippedBefore;
+    Stats.LastRTPTimestamp = RTPTimestamp;
+    Stats.LastSequenceNumber = static_cast<uint16>(Packetizer.GetExtendedSequenceNumber() - 1);
+}
+
+// ============================================================================
+// QUEUEING
+// ============================================================================
+
+bool URship2110AncSender::QueuePacket(const FRship2110AncPacket& Packet)
+{
+    if (!Packet.IsValid())
+    {
+        return false;
+    }
+
+    FScopeLock Lock(&QueueLock);
+    Queued.Add(Packet);
+    return true;
+}
+
+void URship2110AncSender::QueueTimecode(const FTimecode& Timecode, ERship2110AncDataType Type)
+{
+    const FRship2110AncData::ETimecodeType TimecodeType = Type == ERship2110AncDataType::Timecode_VITC ?
+        FRship2110AncData::ETimecodeType::VITC1 :
+        FRship2110AncData::ETimecodeType::LTC;
+
+    QueuePacket(FRship2110AncData::MakeTimecode(Timecode, TimecodeType));
+}
+
+bool URship2110AncSender::QueueCaptionData(const TArray<uint8>& CCData)
+{
+    if (FRship2110AncData::GetCaptionTripletsPerFrame(FrameRate) == 0)
+    {
+        UE_LOG(LogRship2110, Warning, TEXT("AncSender %s: CEA-708 has no caption rate for %s fps"),
+               *StreamId, *FString::SanitizeFloat(FrameRate.AsDecimal()));
+        return false;
+    }
+
+    FScopeLock Lock(&QueueLock);
+    Queued.Add(FRship2110AncData::MakeCaptionCDP(CCData, FrameRate, CaptionSequence++));
+    return true;
+}
+
+void URship2110AncSender::QueueSpliceStart(int32 SpliceEventId, int32 PreRollMs, float BreakDurationSeconds, bool bAutoReturn)
+{
+    QueueSplice(PreRollMs > 0 ? FRship2110AncData::ESpliceInsertType::StartNormal : FRship2110AncData::ESpliceInsertType::StartImmediate,
+                SpliceEventId, PreRollMs, BreakDurationSeconds, bAutoReturn);
+}
+
+void URship2110AncSender::QueueSpliceEnd(int32 SpliceEventId, int32 PreRollMs)
+{
+    QueueSplice(PreRollMs > 0 ? FRship2110AncData::ESpliceInsertType::EndNormal : FRship2110AncData::ESpliceInsertType::EndImmediate,
+                SpliceEventId, PreRollMs, 0.0f, false);
+}
+
+void URship2110AncSender::QueueSplice(FRship2110AncData::ESpliceInsertType Type, int32 SpliceEventId, int32 PreRollMs,
+                                      float BreakDurationSeconds, bool bAutoReturn)
+{
+    const uint16 PreRoll = static_cast<uint16>(FMath::Clamp(PreRollMs, 0, 0xFFFF));
+    const uint16 BreakTenths = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt32(BreakDurationSeconds * 10.0f), 0, 0xFFFF));
+
+    FScopeLock Lock(&QueueLock);
+    const TArray<uint8> Message = FRship2110AncData::MakeSpliceRequest(
+        Type, static_cast<uint32>(SpliceEventId), 0, PreRoll, BreakTenths, bAutoReturn, SpliceMessageNumber++);
+    Queued.Add(FRship2110AncData::MakeSCTE104(Message));
+}
+
+bool URship2110AncSender::QueueCustomPacket(int32 DID, int32 SDID, const TArray<uint8>& UserData, int32 LineNumber)
+{
+    if (DID < 0 || DID > 0xFF || SDID < 0 || SDID > 0xFF || LineNumber < 0 || LineNumber > FRship2110AncPacket::AnyLine)
+    {
+        return false;
+    }
+
+    FRship2110AncPacket Packet;
+    Packet.DID = static_cast<uint8>(DID);
+    Packet.SDID = static_cast<uint8>(SDID);
+    Packet.UserData = UserData;
+    Packet.LineNumber = static_cast<uint16>(LineNumber);
+    return QueuePacket(Packet);
+}
+
+int32 URship2110AncSender::GetQueuedCount() const
+{
+    FScopeLock Lock(&QueueLock);
+    return Queued.Num();
+}
+
+// ============================================================================
+// STATISTICS / SDP
+// ============================================================================
+
+FRship2110StreamStats URship2110AncSender::GetStatistics() const
+{
+    FScopeLock Lock(&SendLock);
+    return Stats;
+}
+
+FString URship2110AncSender::GenerateSDP() const
+{
+    // Generate SDP according to ST 2110-40 / RFC 8331
+    FString SDP;
+
+    // Session-level
+    SDP += TEXT("v=0\r\n");
+    SDP += FString::Printf(TEXT("o=- %u 0 IN IP4 %s\r\n"),
+                           TransportParams.SSRC, *TransportParams.SourceIP);
+    SDP += TEXT("s=Unreal Engine SMPTE 2110 Ancillary Stream\r\n");
+    SDP += FString::Printf(TEXT("c=IN IP4 %s/%d\r\n"),
+                           *TransportParams.DestinationIP, TransportParams.TTL);
+    SDP += TEXT("t=0 0\r\n");
+
+    // Media-level for ancillary data
+    SDP += FString::Printf(TEXT("m=video %d RTP/AVP %d\r\n"),
+                           TransportParams.DestinationPort, TransportParams.PayloadType);
+    SDP += FString::Printf(TEXT("a=rtpmap:%d smpte291/90000\r\n"), TransportParams.PayloadType);
+
+    // The packet types this sender builds; custom packets are not listed
+    SDP += FString::Printf(TEXT("a=fmtp:%d DID_SDID={0x60,0x60};DID_SDID={0x61,0x01};DID_SDID={0x41,0x07}\r\n"),
+                           TransportParams.PayloadType);
+
+    // Source filter (RFC 4570)
+    SDP += FString::Printf(TEXT("a=source-filter: incl IN IP4 %s %s\r\n"),
+                           *TransportParams.DestinationIP, *TransportParams.SourceIP);
+
+    // PTP reference
+    SDP += TEXT("a=ts-refclk:ptp=IEEE1588-2008:00-00-00-00-00-00-00-00:127\r\n");
+    SDP += TEXT("a=mediaclk:direct=0\r\n");
+
+    return SDP;
+}
+
+void URship2110AncSender::SetState(ERship2110StreamState NewState)
+{
+    if (State != NewState)
+    {
+        State = NewState;
+        OnStateChanged.Broadcast(StreamId, NewState);
+    }
+}
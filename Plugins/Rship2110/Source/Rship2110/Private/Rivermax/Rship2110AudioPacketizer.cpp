@@ -0,0 +1,256 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "Rivermax/Rship2110AudioPacketizer.h"
+
+namespace
+{
+    void WriteBE16(uint8* Dest, uint32 Value)
+    {
+        Dest[0] = static_cast<uint8>(Value >> 8);
+        Dest[1] = static_cast<uint8>(Value);
+    }
+
+    void WriteBE32(uint8* Dest, uint32 Value)
+    {
+        WriteBE16(Dest, Value >> 16);
+        WriteBE16(Dest + 2, Value);
+    }
+
+    uint32 ReadBE16(const uint8* Source)
+    {
+        return (static_cast<uint32>(Source[0]) << 8) | Source[1];
+    }
+
+    uint32 ReadBE32(const uint8* Source)
+    {
+        return (ReadBE16(Source) << 16) | ReadBE16(Source + 2);
+    }
+}
+
+// ============================================================================
+// PACKETIZER
+// ============================================================================
+
+bool FRship2110AudioPacketizer::Configure(const FRship2110AudioFormat& InFormat, uint8 InPayloadType, uint32 InSSRC, int32 InMaxBatch)
+{
+    bValid = false;
+    if (!InFormat.IsValid() || InMaxBatch < 1)
+    {
+        return false;
+    }
+
+    Format = InFormat;
+    PayloadType = InPayloadType & 0x7F;
+    SSRC = InSSRC;
+    PacketSize = RTPHeaderSize + Format.GetPayloadBytes();
+    MaxBatch = InMaxBatch;
+
+    Arena.SetNumZeroed(PacketSize * MaxBatch);
+    NextSlot = 0;
+
+    bValid = true;
+    return true;
+}
+
+int32 FRship2110AudioPacketizer::FloatToPCM(float Sample, int32 BitsPerSample)
+{
+    const int32 FullScale = 1 << (BitsPerSample - 1);
+    const int32 Value = FMath::RoundToInt32(static_cast<double>(Sample) * FullScale);
+    return FMath::Clamp(Value, -FullScale, FullScale - 1);
+}
+
+float FRship2110AudioPacketizer::PCMToFloat(int32 Sample, int32 BitsPerSample)
+{
+    return static_cast<float>(static_cast<double>(Sample) / (1 << (BitsPerSample - 1)));
+}
+
+FRship2110Packet FRship2110AudioPacketizer::PacketizePacket(const float* Samples, uint32 RTPTimestamp)
+{
+    check(bValid);
+
+    uint8* Packet = Arena.GetData() + NextSlot * PacketSize;
+    NextSlot = (NextSlot + 1) % MaxBatch;
+
+    // RTP header (RFC 3550); no marker, no extensions
+    Packet[0] = 0x80;
+    Packet[1] = PayloadType;
+    WriteBE16(Packet + 2, SequenceNumber++);
+    WriteBE32(Packet + 4, RTPTimestamp);
+    WriteBE32(Packet + 8, SSRC);
+
+    // Interleaved big-endian PCM
+    const int32 Bits = Format.BitsPerSample;
+    const int32 NumSamples = Format.GetSamplesPerPacket() * Format.NumChannels;
+    uint8* Dest = Packet + RTPHeaderSize;
+    if (Bits == 24)
+    {
+        for (int32 i = 0; i < NumSamples; ++i, Dest += 3)
+        {
+            const uint32 Value = static_cast<uint32>(FloatToPCM(Samples[i], 24));
+            Dest[0] = static_cast<uint8>(Value >> 16);
+            Dest[1] = static_cast<uint8>(Value >> 8);
+            Dest[2] = static_cast<uint8>(Value);
+        }
+    }
+    else
+    {
+        for (int32 i = 0; i < NumSamples; ++i, Dest += 2)
+        {
+            WriteBE16(Dest, static_cast<uint32>(FloatToPCM(Samples[i], 16)));
+        }
+    }
+
+    return { Packet, PacketSize };
+}
+
+// ============================================================================
+// DEPACKETIZER
+// ============================================================================
+
+bool FRship2110AudioDepacketizer::Configure(const FRship2110AudioFormat& InFormat)
+{
+    bValid = InFormat.IsValid();
+    Format = InFormat;
+    Samples.Reset();
+    bHavePacket = false;
+    Stats = FStats();
+    return bValid;
+}
+
+bool FRship2110AudioDepacketizer::ReceivePacket(const uint8* Data, int32 Size)
+{
+    if (!bValid || !Data || Size != FRship2110AudioPacketizer::RTPHeaderSize + Format.GetPayloadBytes() ||
+        (Data[0] & 0xC0) != 0x80)
+    {
+        Stats.PacketsMalformed++;
+        return false;
+    }
+
+    const uint16 SequenceNumber = static_cast<uint16>(ReadBE16(Data + 2));
+    const uint32 Timestamp = ReadBE32(Data + 4);
+
+    if (bHavePacket)
+    {
+        const uint16 Gap = static_cast<uint16>(SequenceNumber - LastSequenceNumber - 1);
+        // Treat a jump backwards as reordering rather than 65k lost packets
+        if (Gap < 0x8000)
+        {
+            Stats.PacketsLost += Gap;
+        }
+
+        const uint32 ExpectedTimestamp = LastTimestamp + static_cast<uint32>(Format.GetSamplesPerPacket()) * (Gap + 1);
+        if (Gap < 0x8000 && Timestamp != ExpectedTimestamp)
+        {
+            Stats.TimestampJumps++;
+        }
+    }
+
+    bHavePacket = true;
+    LastSequenceNumber = SequenceNumber;
+    LastTimestamp = Timestamp;
+    Stats.PacketsReceived++;
+
+    const int32 Bits = Format.BitsPerSample;
+    const int32 NumSamples = Format.GetSamplesPerPacket() * Format.NumChannels;
+    const uint8* Source = Data + FRship2110AudioPacketizer::RTPHeaderSize;
+    const int32 FirstSample = Samples.AddUninitialized(NumSamples);
+    int32* Dest = Samples.GetData() + FirstSample;
+    if (Bits == 24)
+    {
+        for (int32 i = 0; i < NumSamples; ++i, Source += 3)
+        {
+            // Sign-extend from bit 23
+            const int32 Value = (static_cast<int32>(Source[0]) << 24) | (static_cast<int32>(Source[1]) << 16) |
+                                (static_cast<int32>(Source[2]) << 8);
+            Dest[i] = Value >> 8;
+        }
+    }
+    else
+    {
+        for (int32 i = 0; i < NumSamples; ++i, Source += 2)
+        {
+            Dest[i] = static_cast<int16>(ReadBE16(Source));
+        }
+    }
+
+    return true;
+}
+
+// ============================================================================
+// SAMPLE RING
+// ============================================================================
+
+void FRship2110AudioRing::Configure(int32 InNumChannels, int32 MinFrames)
+{
+    NumChannels = FMath::Max(InNumChannels, 1);
+    Capacity = static_cast<int32>(FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max(MinFrames, 1))));
+    Buffer.SetNumZeroed(Capacity * NumChannels);
+    Reset();
+}
+
+void FRship2110AudioRing::Reset()
+{
+    WriteIndex.store(0, std::memory_order_relaxed);
+    ReadIndex.store(0, std::memory_order_relaxed);
+    DroppedFrames.store(0, std::memory_order_relaxed);
+}
+
+int32 FRship2110AudioRing::Write(const float* Samples, int32 NumFrames, int32 SourceChannels)
+{
+    if (Capacity == 0 || !Samples || NumFrames <= 0 || SourceChannels <= 0)
+    {
+        return 0;
+    }
+
+    const uint64 Write = WriteIndex.load(std::memory_order_relaxed);
+    const uint64 Read = ReadIndex.load(std::memory_order_acquire);
+    const int32 Free = Capacity - static_cast<int32>(Write - Read);
+    const int32 ToWrite = FMath::Min(NumFrames, Free);
+
+    const int32 CopyChannels = FMath::Min(SourceChannels, NumChannels);
+    const uint64 Mask = static_cast<uint64>(Capacity - 1);
+    for (int32 Frame = 0; Frame < ToWrite; ++Frame)
+    {
+        float* Dest = Buffer.GetData() + ((Write + Frame) & Mask) * NumChannels;
+        const float* Source = Samples + static_cast<int64>(Frame) * SourceChannels;
+        FMemory::Memcpy(Dest, Source, CopyChannels * sizeof(float));
+        if (CopyChannels < NumChannels)
+        {
+            FMemory::Memzero(Dest + CopyChannels, (NumChannels - CopyChannels) * sizeof(float));
+        }
+    }
+
+    // Release publishes the samples before the index
+    WriteIndex.store(Write + ToWrite, std::memory_order_release);
+
+    if (ToWrite < NumFrames)
+    {
+        DroppedFrames.fetch_add(NumFrames - ToWrite, std::memory_order_relaxed);
+    }
+    return ToWrite;
+}
+
+int32 FRship2110AudioRing::Read(float* OutSamples, int32 NumFrames)
+{
+    if (Capacity == 0 || !OutSamples || NumFrames <= 0)
+    {
+        return 0;
+    }
+
+    const uint64 Read = ReadIndex.load(std::memory_order_relaxed);
+    const uint64 Write = WriteIndex.load(std::memory_order_acquire);
+    const int32 ToRead = FMath::Min(NumFrames, static_cast<int32>(Write - Read));
+
+    // Copy in at most two runs, split where the ring wraps
+    const int32 Start = static_cast<int32>(Read & static_cast<uint64>(Capacity - 1));
+    const int32 FirstRun = FMath::Min(ToRead, Capacity - Start);
+    FMemory::Memcpy(OutSamples, Buffer.GetData() + Start * NumChannels, FirstRun * NumChannels * sizeof(float));
+    if (ToRead > FirstRun)
+    {
+        FMemory::Memcpy(OutSamples + FirstRun * NumChannels, Buffer.GetData(), (ToRead - FirstRun) * NumChannels * sizeof(float));
+    }
+
+    // Release hands the space back to the writer after the copy
+    ReadIndex.store(Read + ToRead, std::memory_order_release);
+    return ToRead;
+}
@@ -0,0 +1,336 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "Rivermax/Rship2110AudioSender.h"
+#include "PTP/RshipPTPService.h"
+#include "Rship2110.h"
+#include "Rship2110Settings.h"
+#include "AudioDevice.h"
+#include "ISubmixBufferListener.h"
+#include "Sound/SoundSubmix.h"
+#include "Engine/Engine.h"
+
+// ============================================================================
+// SUBMIX LISTENER
+// Runs on the audio render thread; the only writer of the sample ring
+// ============================================================================
+
+class FRship2110SubmixListener : public ISubmixBufferListener
+{
+public:
+    FRship2110SubmixListener(const FString& InName, int32 InSampleRate)
+        : Name(InName)
+        , SampleRate(InSampleRate)
+    {
+    }
+
+    /** Point the listener at a ring, or at nothing. Blocks while a buffer is being written. */
+    void SetRing(FRship2110AudioRing* InRing)
+    {
+        FScopeLock Lock(&RingLock);
+        Ring = InRing;
+    }
+
+    virtual void OnNewSubmixBuffer(const USoundSubmix* OwningSubmix, float* AudioData, int32 NumSamples,
+                                   int32 NumChannels, const int32 InSampleRate, double AudioClock) override
+    {
+        if (InSampleRate != SampleRate)
+        {
+            if (!bWarnedSampleRate)
+            {
+                UE_LOG(LogRship2110, Warning, TEXT("AudioSender %s: Submix runs at %d Hz, stream at %d Hz; not sending"),
+                       *Name, InSampleRate, SampleRate);
+                bWarnedSampleRate = true;
+            }
+            return;
+        }
+
+        if (NumChannels <= 0)
+        {
+            return;
+        }
+
+        // Uncontended except while the stream starts or stops
+        FScopeLock Lock(&RingLock);
+        if (Ring)
+        {
+            Ring->Write(AudioData, NumSamples / NumChannels, NumChannels);
+        }
+    }
+
+    virtual const FString& GetListenerName() const override
+    {
+        return Name;
+    }
+
+private:
+    FString Name;
+    int32 SampleRate;
+    bool bWarnedSampleRate = false;
+
+    FRship2110AudioRing* Ring = nullptr;
+    FCriticalSection RingLock;
+};
+
+// ============================================================================
+// AUDIO SENDER IMPLEMENTATION
+// ============================================================================
+
+bool URship2110AudioSender::Initialize(
+    URshipPTPService* InPTPService,
+    const FRship2110AudioFormat& InAudioFormat,
+    const FRship2110TransportParams& InTransportParams)
+{
+    if (!InAudioFormat.IsValid())
+    {
+        UE_LOG(LogRship2110, Error, TEXT("AudioSender: %s/%d/%d with %g ms packets does not fit a 2110-30 packet"),
+               *InAudioFormat.GetEncodingName(), InAudioFormat.SampleRate, InAudioFormat.NumChannels,
+               InAudioFormat.PacketTimeUs / 1000.0);
+        return false;
+    }
+
+    PTPService = InPTPService;
+    AudioFormat = InAudioFormat;
+    TransportParams = InTransportParams;
+
+    // Generate SSRC if not specified
+    if (TransportParams.SSRC == 0)
+    {
+        TransportParams.SSRC = FMath::Rand();
+    }
+
+    URship2110Settings* Settings = URship2110Settings::Get();
+    FRship2110TransmitOptions TransmitOptions;
+    int32 BufferMs = 30;
+    if (Settings)
+    {
+        TransmitOptions.bSegmentationOffload = Settings->bUseSegmentationOffload;
+        BufferMs = Settings->AudioBufferMs;
+    }
+
+    TransmitThread = MakeUnique<FRship2110AudioTransmitThread>(FRship2110TransmitterFactory::CreateOpen(TransportParams, TransmitOptions));
+    TransmitThread->Configure(AudioFormat, static_cast<uint8>(TransportParams.PayloadType), TransportParams.SSRC,
+                              AudioFormat.SampleRate / 1000 * BufferMs);
+
+    if (!TransmitThread->GetTransmitter())
+    {
+        UE_LOG(LogRship2110, Warning, TEXT("AudioSender: No socket to %s:%d, audio will not be sent"),
+               *TransportParams.DestinationIP, TransportParams.DestinationPort);
+    }
+
+    State = ERship2110StreamState::Stopped;
+
+    UE_LOG(LogRship2110, Log, TEXT("AudioSender: Initialized %s/%d/%d, %s ms packets"),
+           *AudioFormat.GetEncodingName(), AudioFormat.SampleRate, AudioFormat.NumChannels,
+           *AudioFormat.GetPacketTimeString());
+
+    return true;
+}
+
+void URship2110AudioSender::Shutdown()
+{
+    DetachFromSubmix();
+    StopStream();
+
+    // Joins the transmit thread and closes its socket
+    TransmitThread.Reset();
+    PacingClock.Reset();
+
+    PTPService = nullptr;
+
+    UE_LOG(LogRship2110, Log, TEXT("AudioSender: Shutdown complete"));
+}
+
+bool URship2110AudioSender::StartStream()
+{
+    if (State == ERship2110StreamState::Running)
+    {
+        return true;
+    }
+
+    if (!TransmitThread || !TransmitThread->GetTransmitter())
+    {
+        UE_LOG(LogRship2110, Error, TEXT("AudioSender %s: No transmitter, cannot start"), *StreamId);
+        return false;
+    }
+
+    // Timestamps follow the PTP media clock; without PTP the stream still runs, untraceable
+    const IPTPProvider* Provider = PTPService ? PTPService->GetProvider() : nullptr;
+    if (Provider)
+    {
+        PacingClock = MakeUnique<FRship2110ProviderPacingClock>(*Provider);
+    }
+    else
+    {
+        UE_LOG(LogRship2110, Warning, TEXT("AudioSender %s: No PTP provider, timestamps follow the local clock"), *StreamId);
+        PacingClock = MakeUnique<FRship2110LocalPacingClock>();
+    }
+
+    URship2110Settings* Settings = URship2110Settings::Get();
+    if (!TransmitThread->Start(*PacingClock, static_cast<uint16>(FMath::Rand()), Settings ? Settings->TransmitThreadCore : -1))
+    {
+        PacingClock.Reset();
+        return false;
+    }
+
+    if (SubmixListener)
+    {
+        SubmixListener->SetRing(&TransmitThread->GetRing());
+    }
+
+    SetState(ERship2110StreamState::Running);
+
+    UE_LOG(LogRship2110, Log, TEXT("AudioSender %s: Stream started"), *StreamId);
+    return true;
+}
+
+void URship2110AudioSender::StopStream()
+{
+    if (State == ERship2110StreamState::Stopped)
+    {
+        return;
+    }
+
+    // The listener must let go of the ring before the thread resets it
+    if (SubmixListener)
+    {
+        SubmixListener->SetRing(nullptr);
+    }
+
+    if (TransmitThread)
+    {
+        TransmitThread->Shutdown();
+    }
+    PacingClock.Reset();
+
+    SetState(ERship2110StreamState::Stopped);
+
+    UE_LOG(LogRship2110, Log, TEXT("AudioSender %s: Stream stopped"), *StreamId);
+}
+
+bool URship2110AudioSender::AttachToSubmix(USoundSubmix* Submix)
+{
+    DetachFromSubmix();
+
+    FAudioDeviceHandle AudioDevice = GEngine ? GEngine->GetMainAudioDevice() : FAudioDeviceHandle();
+    if (!AudioDevice.IsValid())
+    {
+        UE_LOG(LogRship2110, Warning, TEXT("AudioSender %s: No audio device to listen to"), *StreamId);
+        return false;
+    }
+
+    USoundSubmix& Target = Submix ? *Submix : AudioDevice->GetMainSubmixObject();
+
+    SubmixListener = MakeShared<FRship2110SubmixListener, ESPMode::ThreadSafe>(
+        FString::Printf(TEXT("Rship2110Audio_%s"), *StreamId), AudioFormat.SampleRate);
+    if (State == ERship2110StreamState::Running && TransmitThread)
+    {
+        SubmixListener->SetRing(&TransmitThread->GetRing());
+    }
+
+    AudioDevice->RegisterSubmixBufferListener(SubmixListener.ToSharedRef(), Target);
+    AttachedSubmix = &Target;
+
+    UE_LOG(LogRship2110, Log, TEXT("AudioSender %s: Listening to submix %s"), *StreamId, *Target.GetName());
+    return true;
+}
+
+void URship2110AudioSender::DetachFromSubmix()
+{
+    if (!SubmixListener)
+    {
+        return;
+    }
+
+    // Buffers may still be in flight on the audio thread; after this they are ignored
+    SubmixListener->SetRing(nullptr);
+
+    FAudioDeviceHandle AudioDevice = GEngine ? GEngine->GetMainAudioDevice() : FAudioDeviceHandle();
+    if (AudioDevice.IsValid() && AttachedSubmix)
+    {
+        AudioDevice->UnregisterSubmixBufferListener(SubmixListener.ToSharedRef(), *AttachedSubmix);
+    }
+
+    SubmixListener.Reset();
+    AttachedSubmix = nullptr;
+}
+
+int32 URship2110AudioSender::SubmitSamples(const float* Samples, int32 NumFrames, int32 SourceChannels)
+{
+    if (State != ERship2110StreamState::Running || !TransmitThread || SubmixListener)
+    {
+        return 0;
+    }
+
+    return TransmitThread->GetRing().Write(Samples, NumFrames, SourceChannels);
+}
+
+FRship2110AudioStreamStats URship2110AudioSender::GetStatistics() const
+{
+    FRship2110AudioStreamStats Stats;
+    if (!TransmitThread)
+    {
+        return Stats;
+    }
+
+    Stats.PacketsSent = TransmitThread->GetPacketsSent();
+    Stats.Underruns = TransmitThread->GetUnderruns();
+    Stats.SilentFrames = TransmitThread->GetSilentFrames();
+    Stats.OverflowFrames = TransmitThread->GetRing().GetDroppedFrames();
+    Stats.BufferedFrames = TransmitThread->GetRing().GetAvailable();
+    if (IRship2110PacketTransmitter* Transmitter = TransmitThread->GetTransmitter())
+    {
+        Stats.BytesSent = Transmitter->GetStats().BytesSent;
+    }
+    return Stats;
+}
+
+double URship2110AudioSender::GetBitrateMbps() const
+{
+    const double PacketsPerSecond = static_cast<double>(AudioFormat.SampleRate) / AudioFormat.GetSamplesPerPacket();
+    const double PacketBits = (FRship2110AudioPacketizer::RTPHeaderSize + AudioFormat.GetPayloadBytes()) * 8.0;
+    return PacketsPerSecond * PacketBits / 1000000.0;
+}
+
+FString URship2110AudioSender::GenerateSDP() const
+{
+    // Generate SDP according to ST 2110-30 / AES67
+    FString SDP;
+
+    // Session-level
+    SDP += TEXT("v=0\r\n");
+    SDP += FString::Printf(TEXT("o=- %u 0 IN IP4 %s\r\n"),
+                           TransportParams.SSRC, *TransportParams.SourceIP);
+    SDP += TEXT("s=Unreal Engine SMPTE 2110 Audio Stream\r\n");
+    SDP += FString::Printf(TEXT("c=IN IP4 %s/%d\r\n"),
+                           *TransportParams.DestinationIP, TransportParams.TTL);
+    SDP += TEXT("t=0 0\r\n");
+
+    // Media-level for audio
+    SDP += FString::Printf(TEXT("m=audio %d RTP/AVP %d\r\n"),
+                           TransportParams.DestinationPort, TransportParams.PayloadType);
+
+    // RTP map: encoding/rate/channels
+    SDP += FString::Printf(TEXT("a=rtpmap:%d %s/%d/%d\r\n"),
+                           TransportParams.PayloadType, *AudioFormat.GetEncodingName(),
+                           AudioFormat.SampleRate, AudioFormat.NumChannels);
+    SDP += FString::Printf(TEXT("a=ptime:%s\r\n"), *AudioFormat.GetPacketTimeString());
+
+    // Source filter (RFC 4570)
+    SDP += FString::Printf(TEXT("a=source-filter: incl IN IP4 %s %s\r\n"),
+                           *TransportParams.DestinationIP, *TransportParams.SourceIP);
+
+    // PTP reference
+    SDP += TEXT("a=ts-refclk:ptp=IEEE1588-2008:00-00-00-00-00-00-00-00:127\r\n");
+    SDP += TEXT("a=mediaclk:direct=0\r\n");
+
+    return SDP;
+}
+
+void URship2110AudioSender::SetState(ERship2110StreamState NewState)
+{
+    if (State != NewState)
+    {
+        State = NewState;
+        OnStateChanged.Broadcast(StreamId, NewState);
+    }
+}
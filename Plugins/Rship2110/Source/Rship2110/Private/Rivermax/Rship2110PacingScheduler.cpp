@@ -0,0 +1,202 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "Rivermax/Rship2110PacingScheduler.h"
+#include "PTP/IPTPProvider.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+    /** Lines in the raster, active lines and the default first-packet offset, in lines */
+    struct FRasterTiming
+    {
+        int32 TotalLines;
+        int32 ActiveLines;
+        int32 TROLines;
+    };
+
+    // ST 2110-21 RACTIVE and TROdefault for progressive rasters. UHD and 8K
+    // scale the 1125-line timing. Other heights have no defined blanking and
+    // are paced over the whole frame.
+    FRasterTiming GetRasterTiming(int32 Height)
+    {
+        if (Height == 720)
+        {
+            return { 750, 720, 28 };
+        }
+        if (Height > 0 && Height % 1080 == 0)
+        {
+            return { 1125, 1080, 43 };
+        }
+        return { 1, 1, 0 };
+    }
+}
+
+// ============================================================================
+// PACING CLOCKS
+// ============================================================================
+
+uint64 FRship2110ProviderPacingClock::GetTimeNs() const
+{
+    return Provider.GetPTPTime().ToNanoseconds();
+}
+
+uint64 FRship2110ProviderPacingClock::GetNextFrameBoundaryNs(uint64 FrameDurationNs, uint64 AfterNs) const
+{
+    const FRshipPTPTimestamp After = FRshipPTPTimestamp::FromNanoseconds(AfterNs);
+    return Provider.GetNextFrameBoundary(FrameDurationNs, &After).ToNanoseconds();
+}
+
+uint32 FRship2110ProviderPacingClock::GetRTPTimestamp(uint64 TimeNs, uint32 ClockRate) const
+{
+    return Provider.GetRTPTimestamp(FRshipPTPTimestamp::FromNanoseconds(TimeNs), ClockRate);
+}
+
+uint64 FRship2110LocalPacingClock::GetTimeNs() const
+{
+    return static_cast<uint64>(FPlatformTime::Cycles64() * FPlatformTime::GetSecondsPerCycle64() * 1e9);
+}
+
+// ============================================================================
+// SCHEDULER
+// ============================================================================
+
+bool FRship2110PacingScheduler::Configure(const FRship2110VideoFormat& Format, int32 InPacketsPerFrame)
+{
+    Reset();
+
+    if (InPacketsPerFrame <= 0 || Format.FrameRateNumerator <= 0 || Format.FrameRateDenominator <= 0)
+    {
+        return false;
+    }
+
+    SenderType = Format.SenderType;
+    PacketsPerFrame = InPacketsPerFrame;
+    FrameDurationNs = 1e9 * Format.FrameRateDenominator / Format.FrameRateNumerator;
+    BoundaryDurationNs = Format.GetFrameDurationNs();
+
+    const double FrameSeconds = FrameDurationNs * 1e-9;
+    const FRasterTiming Raster = GetRasterTiming(Format.Height);
+
+    if (SenderType == ERship2110SenderType::NarrowLinear)
+    {
+        RActive = 1.0;
+        TROffsetNs = 0.0;
+    }
+    else
+    {
+        RActive = static_cast<double>(Raster.ActiveLines) / Raster.TotalLines;
+        TROffsetNs = FrameDurationNs * Raster.TROLines / Raster.TotalLines;
+    }
+    TRSNs = FrameDurationNs * RActive / PacketsPerFrame;
+    TDrainNs = FrameDurationNs / PacketsPerFrame / Beta;
+
+    if (SenderType == ERship2110SenderType::Wide)
+    {
+        CMax = FMath::Max(16, static_cast<int32>(PacketsPerFrame / (21600.0 * FrameSeconds)));
+        VRXFull = FMath::Max(720, static_cast<int32>(PacketsPerFrame / (300.0 * FrameSeconds)));
+        // Half the bucket, so a burst never fills it
+        BurstPackets = CMax / 2;
+    }
+    else
+    {
+        CMax = FMath::Max(4, static_cast<int32>(PacketsPerFrame / (43200.0 * RActive * FrameSeconds)));
+        VRXFull = FMath::Max(8, static_cast<int32>(PacketsPerFrame / (27000.0 * FrameSeconds)));
+        BurstPackets = 1;
+    }
+
+    return true;
+}
+
+void FRship2110PacingScheduler::Reset()
+{
+    *this = FRship2110PacingScheduler();
+}
+
+uint64 FRship2110PacingScheduler::GetNextFrameStartNs(const IRship2110PacingClock& Clock)
+{
+    check(IsValid());
+
+    const uint64 AfterNs = FMath::Max(Clock.GetTimeNs(), LastFrameStartNs);
+    LastFrameStartNs = Clock.GetNextFrameBoundaryNs(BoundaryDurationNs, AfterNs);
+    return LastFrameStartNs;
+}
+
+uint64 FRship2110PacingScheduler::GetLaunchTimeNs(uint64 FrameStartNs, int32 PacketIndex) const
+{
+    const int32 SlotIndex = (PacketIndex / BurstPackets) * BurstPackets;
+    return FrameStartNs + static_cast<uint64>(FMath::RoundToDouble(TROffsetNs + SlotIndex * TRSNs));
+}
+
+void FRship2110PacingScheduler::ComputeLaunchTimes(uint64 FrameStartNs, TArray<uint64>& OutLaunchTimesNs) const
+{
+    OutLaunchTimesNs.SetNumUninitialized(PacketsPerFrame, EAllowShrinking::No);
+    for (int32 i = 0; i < PacketsPerFrame; ++i)
+    {
+        OutLaunchTimesNs[i] = GetLaunchTimeNs(FrameStartNs, i);
+    }
+}
+
+// ============================================================================
+// CONFORMANCE CHECKER
+// ============================================================================
+
+void FRship2110PacingChecker::Configure(const FRship2110PacingScheduler& Scheduler)
+{
+    TRSNs = Scheduler.GetTRSNs();
+    TROffsetNs = Scheduler.GetTROffsetNs();
+    TDrainNs = Scheduler.GetTDrainNs();
+
+    Reset();
+    Report.CMax = Scheduler.GetCMax();
+    Report.VRXFull = Scheduler.GetVRXFull();
+}
+
+void FRship2110PacingChecker::Reset()
+{
+    const int32 CMax = Report.CMax;
+    const int32 VRXFull = Report.VRXFull;
+
+    Report = FRship2110PacingReport();
+    Report.CMax = CMax;
+    Report.VRXFull = VRXFull;
+    BucketDrainedNs = 0.0;
+}
+
+void FRship2110PacingChecker::AddFrame(uint64 FrameStartNs, TConstArrayView<uint64> PacketTimesNs)
+{
+    if (TRSNs <= 0.0 || TDrainNs <= 0.0)
+    {
+        return;
+    }
+
+    // Slack for launch times rounded to whole nanoseconds
+    constexpr double RoundingNs = 1.0;
+
+    const double FirstReadNs = static_cast<double>(FrameStartNs) + TROffsetNs;
+    const int32 NumPackets = PacketTimesNs.Num();
+
+    for (int32 j = 0; j < NumPackets; ++j)
+    {
+        const double ArrivalNs = static_cast<double>(PacketTimesNs[j]);
+
+        // Network compatibility: packets still queued in the bucket, plus this one
+        const int32 Queued = BucketDrainedNs > ArrivalNs + RoundingNs ?
+            FMath::CeilToInt32((BucketDrainedNs - ArrivalNs - RoundingNs) / TDrainNs) : 0;
+        Report.CInstMax = FMath::Max(Report.CInstMax, Queued + 1);
+        BucketDrainedNs = FMath::Max(BucketDrainedNs, ArrivalNs) + TDrainNs;
+
+        // Virtual receiver: packets read strictly before this arrival
+        const double ReadNs = FirstReadNs + j * TRSNs;
+        if (ArrivalNs > ReadNs + RoundingNs)
+        {
+            Report.LatePackets++;
+        }
+
+        const int32 Read = ArrivalNs > FirstReadNs ?
+            FMath::Clamp(FMath::CeilToInt32((ArrivalNs - FirstReadNs - RoundingNs) / TRSNs), 0, j) : 0;
+        Report.VRXMax = FMath::Max(Report.VRXMax, j + 1 - Read);
+    }
+
+    Report.FramesChecked++;
+    Report.PacketsChecked += NumPackets;
+}
@@ -0,0 +1,703 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "Rivermax/Rship2110PacketTransmitter.h"
+#include "Rship2110.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+#include "IPAddress.h"
+#include "SocketSubsystem.h"
+#include "Sockets.h"
+
+#if PLATFORM_LINUX
+// LinuxPacketTransmitter.cpp
+TUniquePtr<IRship2110PacketTransmitter> CreateLinuxPacketTransmitter();
+#endif
+
+namespace
+{
+    int64 GetLocalTimeNs()
+    {
+        return static_cast<int64>(FPlatformTime::Cycles64() * FPlatformTime::GetSecondsPerCycle64() * 1e9);
+    }
+}
+
+// ============================================================================
+// SOCKET FALLBACK TRANSMITTER
+// One FSocket::SendTo per packet
+// ============================================================================
+
+class FSocketPacketTransmitter : public IRship2110PacketTransmitter
+{
+public:
+    virtual ~FSocketPacketTransmitter()
+    {
+        Close();
+    }
+
+    virtual bool Open(const FRship2110TransportParams& Params, const FRship2110TransmitOptions& Options) override
+    {
+        Close();
+
+        ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+        if (!SocketSubsystem)
+        {
+            return false;
+        }
+
+        DestinationAddr = SocketSubsystem->CreateInternetAddr();
+        bool bIsValid = false;
+        DestinationAddr->SetIp(*Params.DestinationIP, bIsValid);
+        DestinationAddr->SetPort(Params.DestinationPort);
+        if (!bIsValid)
+        {
+            UE_LOG(LogRship2110, Warning, TEXT("SocketTransmitter: Invalid destination IP: %s"), *Params.DestinationIP);
+            DestinationAddr.Reset();
+            return false;
+        }
+
+        Socket = SocketSubsystem->CreateSocket(NAME_DGram, TEXT("Rship2110Transmit"), false);
+        if (!Socket)
+        {
+            DestinationAddr.Reset();
+            return false;
+        }
+
+        // The transmit thread may block; the kernel queue is the pacing buffer
+        Socket->SetNonBlocking(false);
+        Socket->SetBroadcast(true);
+        Socket->SetMulticastTtl(static_cast<uint8>(Params.TTL));
+
+        int32 ActualSize = 0;
+        Socket->SetSendBufferSize(Options.SendBufferBytes, ActualSize);
+
+        if (!Params.SourceIP.IsEmpty())
+        {
+            TSharedRef<FInternetAddr> SourceAddr = SocketSubsystem->CreateInternetAddr();
+            bool bSourceValid = false;
+            SourceAddr->SetIp(*Params.SourceIP, bSourceValid);
+            SourceAddr->SetPort(Params.SourcePort);
+            if (bSourceValid && !Socket->Bind(*SourceAddr))
+            {
+                UE_LOG(LogRship2110, Warning, TEXT("SocketTransmitter: Could not bind %s:%d"), *Params.SourceIP, Params.SourcePort);
+            }
+            if (bSourceValid)
+            {
+                Socket->SetMulticastInterface(*SourceAddr);
+            }
+        }
+
+        PacketsSent = 0;
+        BytesSent = 0;
+        PacketsFailed = 0;
+        return true;
+    }
+
+    virtual void Close() override
+    {
+        if (Socket)
+        {
+            Socket->Close();
+            ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+            Socket = nullptr;
+        }
+        DestinationAddr.Reset();
+    }
+
+    virtual bool IsOpen() const override
+    {
+        return Socket != nullptr;
+    }
+
+    virtual int32 SendPackets(TConstArrayView<FRship2110Packet> Packets, TConstArrayView<uint64> LaunchTimesNs) override
+    {
+        if (!Socket || !DestinationAddr.IsValid())
+        {
+            return 0;
+        }
+
+        int32 NumSent = 0;
+        for (const FRship2110Packet& Packet : Packets)
+        {
+            int32 Sent = 0;
+            if (Socket->SendTo(Packet.Data, Packet.Size, Sent, *DestinationAddr) && Sent == Packet.Size)
+            {
+                NumSent++;
+                BytesSent.fetch_add(Sent, std::memory_order_relaxed);
+            }
+            else
+            {
+                PacketsFailed.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        PacketsSent.fetch_add(NumSent, std::memory_order_relaxed);
+        return NumSent;
+    }
+
+    virtual FRship2110TransmitCapabilities GetCapabilities() const override
+    {
+        return FRship2110TransmitCapabilities();
+    }
+
+    virtual FRship2110TransmitStats GetStats() const override
+    {
+        FRship2110TransmitStats Stats;
+        Stats.PacketsSent = PacketsSent.load(std::memory_order_relaxed);
+        Stats.BytesSent = BytesSent.load(std::memory_order_relaxed);
+        Stats.PacketsFailed = PacketsFailed.load(std::memory_order_relaxed);
+        Stats.SystemCalls = Stats.PacketsSent + Stats.PacketsFailed;
+        return Stats;
+    }
+
+    virtual FString GetName() const override
+    {
+        return TEXT("Socket");
+    }
+
+private:
+    FSocket* Socket = nullptr;
+    TSharedPtr<FInternetAddr> DestinationAddr;
+
+    std::atomic<int64> PacketsSent{0};
+    std::atomic<int64> BytesSent{0};
+    std::atomic<int64> PacketsFailed{0};
+};
+
+// ============================================================================
+// FACTORY IMPLEMENTATION
+// ============================================================================
+
+TUniquePtr<IRship2110PacketTransmitter> FRship2110TransmitterFactory::Create()
+{
+#if PLATFORM_LINUX
+    return CreateLinuxPacketTransmitter();
+#else
+    // Other platforms use fallback
+    return CreateFallback();
+#endif
+}
+
+TUniquePtr<IRship2110PacketTransmitter> FRship2110TransmitterFactory::CreateFallback()
+{
+    return MakeUnique<FSocketPacketTransmitter>();
+}
+
+TUniquePtr<IRship2110PacketTransmitter> FRship2110TransmitterFactory::CreateOpen(const FRship2110TransportParams& Params,
+                                                                                 const FRship2110TransmitOptions& Options)
+{
+    TUniquePtr<IRship2110PacketTransmitter> Transmitter = Create();
+    if (Transmitter->Open(Params, Options))
+    {
+        return Transmitter;
+    }
+
+    UE_LOG(LogRship2110, Warning, TEXT("Transmitter: %s transmitter failed to open, using socket fallback"), *Transmitter->GetName());
+
+    Transmitter = CreateFallback();
+    if (Transmitter->Open(Params, Options))
+    {
+        return Transmitter;
+    }
+
+    return nullptr;
+}
+
+// ============================================================================
+// TRANSMIT THREAD
+// ============================================================================
+
+FRship2110TransmitThread::FRship2110TransmitThread(TUniquePtr<IRship2110PacketTransmitter> InTransmitter)
+    : Transmitter(MoveTemp(InTransmitter))
+{
+    WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+}
+
+FRship2110TransmitThread::~FRship2110TransmitThread()
+{
+    Shutdown();
+
+    if (WakeEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+        WakeEvent = nullptr;
+    }
+}
+
+bool FRship2110TransmitThread::Configure(const FRship2110VideoFormat& Format, uint8 PayloadType, uint32 SSRC, int32 NumSlots)
+{
+    check(!Thread);
+
+    if (!Packetizer.Configure(Format, PayloadType, SSRC) ||
+        !Pacing.Configure(Format, Packetizer.GetPacketsPerFrame()))
+    {
+        return false;
+    }
+
+    // Copy buffers are sized on first use; senders queuing pooled frames never need them
+    Slots.SetNum(FMath::Max(NumSlots, 1));
+    FreeSlots.Reset();
+    ReadySlots.Reset();
+    for (int32 i = 0; i < Slots.Num(); ++i)
+    {
+        Slots[i].Data.Reset();
+        Slots[i].Frame.Release();
+        FreeSlots.Add(i);
+    }
+    SendingSlot = INDEX_NONE;
+
+    return true;
+}
+
+void FRship2110TransmitThread::SetPacingClock(const IRship2110PacingClock* InClock)
+{
+    check(!Thread);
+    PacingClock = InClock;
+}
+
+bool FRship2110TransmitThread::Start(uint32 FirstSequenceNumber, int32 CpuCore)
+{
+    if (Thread)
+    {
+        return true;
+    }
+
+    if (!Transmitter || !Transmitter->IsOpen() || !Packetizer.IsValid())
+    {
+        return false;
+    }
+
+    Packetizer.SetExtendedSequenceNumber(FirstSequenceNumber);
+    bShouldStop = false;
+
+    const uint64 AffinityMask = CpuCore >= 0 ? (uint64(1) << CpuCore) : FPlatformAffinity::GetNoAffinityMask();
+    Thread = FRunnableThread::Create(this, TEXT("Rship2110TransmitThread"), 0, TPri_TimeCritical, AffinityMask);
+
+    if (Thread)
+    {
+        UE_LOG(LogRship2110, Log, TEXT("TransmitThread: Started with %s transmitter%s"), *Transmitter->GetName(),
+               CpuCore >= 0 ? *FString::Printf(TEXT(" on core %d"), CpuCore) : TEXT(""));
+    }
+
+    return Thread != nullptr;
+}
+
+void FRship2110TransmitThread::Shutdown()
+{
+    if (!Thread)
+    {
+        return;
+    }
+
+    Stop();
+    Thread->WaitForCompletion();
+    delete Thread;
+    Thread = nullptr;
+
+    FScopeLock Lock(&SlotLock);
+    for (int32 SlotIndex : ReadySlots)
+    {
+        Slots[SlotIndex].Frame.Release();
+    }
+    FreeSlots.Append(ReadySlots);
+    ReadySlots.Reset();
+}
+
+bool FRship2110TransmitThread::Enqueue(const uint8* FrameData, int64 Size, uint32 RTPTimestamp)
+{
+    if (!Thread || !FrameData || Size != Packetizer.GetFrameBytes())
+    {
+        return false;
+    }
+
+    const int32 SlotIndex = AcquireSlot();
+    if (SlotIndex == INDEX_NONE)
+    {
+        return false;
+    }
+
+    // Only this thread touches a slot between leaving FreeSlots and entering ReadySlots
+    FSlot& Slot = Slots[SlotIndex];
+    if (Slot.Data.Num() != Size)
+    {
+        Slot.Data.SetNumUninitialized(static_cast<int32>(Size));
+    }
+    FMemory::Memcpy(Slot.Data.GetData(), FrameData, Size);
+
+    QueueSlot(SlotIndex, RTPTimestamp);
+    return true;
+}
+
+bool FRship2110TransmitThread::Enqueue(FRship2110FrameRef Frame, uint32 RTPTimestamp)
+{
+    if (!Thread || !Frame.IsValid() || Frame.GetSize() != Packetizer.GetFrameBytes())
+    {
+        return false;
+    }
+
+    const int32 SlotIndex = AcquireSlot();
+    if (SlotIndex == INDEX_NONE)
+    {
+        return false;
+    }
+
+    Slots[SlotIndex].Frame = MoveTemp(Frame);
+
+    QueueSlot(SlotIndex, RTPTimestamp);
+    return true;
+}
+
+int32 FRship2110TransmitThread::AcquireSlot()
+{
+    int32 SlotIndex = INDEX_NONE;
+    {
+        FScopeLock Lock(&SlotLock);
+        if (FreeSlots.Num() > 0)
+        {
+            SlotIndex = FreeSlots.Pop(EAllowShrinking::No);
+        }
+    }
+
+    if (SlotIndex == INDEX_NONE)
+    {
+        FramesDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    return SlotIndex;
+}
+
+void FRship2110TransmitThread::QueueSlot(int32 SlotIndex, uint32 RTPTimestamp)
+{
+    FSlot& Slot = Slots[SlotIndex];
+    Slot.RTPTimestamp = RTPTimestamp;
+    Slot.FrameStartNs = 0;
+    Slot.bHasLaunchClock = false;
+    if (PacingClock)
+    {
+        Slot.FrameStartNs = Pacing.GetNextFrameStartNs(*PacingClock);
+        const int64 ClockNowNs = static_cast<int64>(PacingClock->GetTimeNs());
+        Slot.ClockToLocalNs = ClockNowNs - GetLocalTimeNs();
+
+        // The provider reads PTP time without steering the system clock, so
+        // launch times need the current offset to the kernel's CLOCK_TAI
+        uint64 LaunchNowNs = 0;
+        if (Transmitter->GetCapabilities().bLaunchTime && Transmitter->GetLaunchClockNs(LaunchNowNs))
+        {
+            Slot.ClockToLaunchNs = static_cast<int64>(LaunchNowNs) - ClockNowNs;
+            Slot.bHasLaunchClock = true;
+        }
+    }
+
+    {
+        FScopeLock Lock(&SlotLock);
+        ReadySlots.Add(SlotIndex);
+    }
+    WakeEvent->Trigger();
+}
+
+bool FRship2110TransmitThread::WaitUntilIdle(double TimeoutSeconds)
+{
+    const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+    for (;;)
+    {
+        {
+            FScopeLock Lock(&SlotLock);
+            if (ReadySlots.Num() == 0 && SendingSlot == INDEX_NONE)
+            {
+                return true;
+            }
+        }
+
+        if (!Thread || FPlatformTime::Seconds() > Deadline)
+        {
+            return false;
+        }
+        FPlatformProcess::Sleep(0.0005f);
+    }
+}
+
+uint32 FRship2110TransmitThread::Run()
+{
+    while (!bShouldStop)
+    {
+        int32 SlotIndex = INDEX_NONE;
+        {
+            FScopeLock Lock(&SlotLock);
+            if (ReadySlots.Num() > 0)
+            {
+                SlotIndex = ReadySlots[0];
+                ReadySlots.RemoveAt(0, EAllowShrinking::No);
+                SendingSlot = SlotIndex;
+            }
+        }
+
+        if (SlotIndex == INDEX_NONE)
+        {
+            WakeEvent->Wait(1);
+            continue;
+        }
+
+        FSlot& Slot = Slots[SlotIndex];
+        const uint8* FrameData = Slot.Frame.IsValid() ? Slot.Frame.GetData() : Slot.Data.GetData();
+        const TConstArrayView<FRship2110Packet> Packets = Packetizer.PacketizeFrame(FrameData, Slot.RTPTimestamp);
+        if (Slot.FrameStartNs == 0)
+        {
+            Transmitter->SendPackets(Packets);
+        }
+        else
+        {
+            Pacing.ComputeLaunchTimes(Slot.FrameStartNs, LaunchTimes);
+            if (Slot.bHasLaunchClock)
+            {
+                for (uint64& LaunchTimeNs : LaunchTimes)
+                {
+                    LaunchTimeNs = static_cast<uint64>(static_cast<int64>(LaunchTimeNs) + Slot.ClockToLaunchNs);
+                }
+                Transmitter->SendPackets(Packets, LaunchTimes);
+            }
+            else
+            {
+                SendPaced(Packets, Slot.ClockToLocalNs);
+            }
+        }
+        FramesSent.fetch_add(1, std::memory_order_relaxed);
+
+        // Hand a pooled frame back as soon as its packets are out
+        Slot.Frame.Release();
+
+        FScopeLock Lock(&SlotLock);
+        SendingSlot = INDEX_NONE;
+        FreeSlots.Add(SlotIndex);
+    }
+
+    return 0;
+}
+
+void FRship2110TransmitThread::SendPaced(TConstArrayView<FRship2110Packet> Packets, int64 ClockToLocalNs)
+{
+    // Sleep until this close to a launch time, then spin; sleeps are capped so Stop is seen
+    constexpr int64 SpinNs = 200000;
+    // A late thread catches up in bursts the network compatibility bucket can absorb
+    const int32 MaxBurst = FMath::Max(Pacing.GetBurstPackets(), Pacing.GetCMax() / 2);
+
+    int32 Next = 0;
+    while (Next < Packets.Num() && !bShouldStop)
+    {
+        const int64 DueNs = static_cast<int64>(LaunchTimes[Next]) - ClockToLocalNs;
+        int64 NowNs = GetLocalTimeNs();
+        while (NowNs < DueNs && !bShouldStop)
+        {
+            if (DueNs - NowNs > SpinNs)
+            {
+                FPlatformProcess::Sleep(static_cast<float>(FMath::Min<int64>(DueNs - NowNs - SpinNs, 10000000) * 1e-9));
+            }
+            else
+            {
+                FPlatformProcess::YieldThread();
+            }
+            NowNs = GetLocalTimeNs();
+        }
+
+        const uint64 ClockNowNs = static_cast<uint64>(NowNs + ClockToLocalNs);
+        const int32 Limit = FMath::Min(Packets.Num(), Next + MaxBurst);
+        int32 End = Next + 1;
+        while (End < Limit && LaunchTimes[End] <= ClockNowNs)
+        {
+            End++;
+        }
+
+        Transmitter->SendPackets(Packets.Slice(Next, End - Next));
+        Next = End;
+    }
+}
+
+void FRship2110TransmitThread::Stop()
+{
+    bShouldStop = true;
+    if (WakeEvent)
+    {
+        WakeEvent->Trigger();
+    }
+}
+
+// ============================================================================
+// AUDIO TRANSMIT THREAD
+// ============================================================================
+
+FRship2110AudioTransmitThread::FRship2110AudioTransmitThread(TUniquePtr<IRship2110PacketTransmitter> InTransmitter)
+    : Transmitter(MoveTemp(InTransmitter))
+{
+}
+
+FRship2110AudioTransmitThread::~FRship2110AudioTransmitThread()
+{
+    Shutdown();
+}
+
+bool FRship2110AudioTransmitThread::Configure(const FRship2110AudioFormat& Format, uint8 PayloadType, uint32 SSRC, int32 InPrerollFrames)
+{
+    check(!Thread);
+
+    if (!Packetizer.Configure(Format, PayloadType, SSRC))
+    {
+        return false;
+    }
+
+    const int32 FramesPerPacket = Format.GetSamplesPerPacket();
+    PrerollFrames = FMath::Max(InPrerollFrames, FramesPerPacket);
+    PacketTimeNs = static_cast<uint64>(Format.PacketTimeUs) * 1000;
+
+    // Room for the preroll plus a late audio callback's worth on top
+    Ring.Configure(Format.NumChannels, PrerollFrames * 4);
+
+    Samples.SetNumZeroed(Packetizer.GetMaxBatch() * FramesPerPacket * Format.NumChannels);
+    Batch.Reserve(Packetizer.GetMaxBatch());
+
+    return true;
+}
+
+bool FRship2110AudioTransmitThread::Start(const IRship2110PacingClock& InClock, uint16 FirstSequenceNumber, int32 CpuCore)
+{
+    if (Thread)
+    {
+        return true;
+    }
+
+    if (!Transmitter || !Transmitter->IsOpen() || !Packetizer.IsValid())
+    {
+        return false;
+    }
+
+    Clock = &InClock;
+    Packetizer.SetSequenceNumber(FirstSequenceNumber);
+    ClockToLocalNs = static_cast<int64>(Clock->GetTimeNs()) - GetLocalTimeNs();
+    Anchor(Clock->GetTimeNs());
+    bPriming = true;
+    bShouldStop = false;
+
+    const uint64 AffinityMask = CpuCore >= 0 ? (uint64(1) << CpuCore) : FPlatformAffinity::GetNoAffinityMask();
+    Thread = FRunnableThread::Create(this, TEXT("Rship2110AudioTransmitThread"), 0, TPri_TimeCritical, AffinityMask);
+
+    if (Thread)
+    {
+        UE_LOG(LogRship2110, Log, TEXT("AudioTransmitThread: Started with %s transmitter%s"), *Transmitter->GetName(),
+               CpuCore >= 0 ? *FString::Printf(TEXT(" on core %d"), CpuCore) : TEXT(""));
+    }
+
+    return Thread != nullptr;
+}
+
+void FRship2110AudioTransmitThread::Shutdown()
+{
+    if (!Thread)
+    {
+        return;
+    }
+
+    Stop();
+    Thread->WaitForCompletion();
+    delete Thread;
+    Thread = nullptr;
+
+    Ring.Reset();
+    Clock = nullptr;
+}
+
+void FRship2110AudioTransmitThread::Anchor(uint64 AfterNs)
+{
+    StartNs = Clock->GetNextFrameBoundaryNs(PacketTimeNs, AfterNs);
+    NextPacket = 0;
+    NextTimestamp = Clock->GetRTPTimestamp(StartNs, static_cast<uint32>(Packetizer.GetFormat().SampleRate));
+}
+
+uint64 FRship2110AudioTransmitThread::GetPacketDueNs(uint64 Packet) const
+{
+    // Exact in samples, so 333 us packets (16 samples at 48 kHz) do not drift from their timestamps
+    const uint64 SampleRate = static_cast<uint64>(Packetizer.GetFormat().SampleRate);
+    const uint64 Sample = Packet * Packetizer.GetFormat().GetSamplesPerPacket();
+    return StartNs + (Sample / SampleRate) * 1000000000ULL + (Sample % SampleRate) * 1000000000ULL / SampleRate;
+}
+
+void FRship2110AudioTransmitThread::FillPacket(float* OutSamples)
+{
+    const int32 FramesPerPacket = Packetizer.GetFormat().GetSamplesPerPacket();
+    const int32 NumChannels = Packetizer.GetFormat().NumChannels;
+
+    if (bPriming && Ring.GetAvailable() >= PrerollFrames)
+    {
+        bPriming = false;
+    }
+
+    int32 FramesRead = 0;
+    if (!bPriming)
+    {
+        FramesRead = Ring.Read(OutSamples, FramesPerPacket);
+        if (FramesRead < FramesPerPacket)
+        {
+            Underruns.fetch_add(1, std::memory_order_relaxed);
+            bPriming = true;
+        }
+    }
+
+    if (FramesRead < FramesPerPacket)
+    {
+        FMemory::Memzero(OutSamples + FramesRead * NumChannels, (FramesPerPacket - FramesRead) * NumChannels * sizeof(float));
+        SilentFrames.fetch_add(FramesPerPacket - FramesRead, std::memory_order_relaxed);
+    }
+}
+
+uint32 FRship2110AudioTransmitThread::Run()
+{
+    const int32 FramesPerPacket = Packetizer.GetFormat().GetSamplesPerPacket();
+    const int32 SamplesPerPacket = FramesPerPacket * Packetizer.GetFormat().NumChannels;
+    int64 NextClockResyncNs = GetLocalTimeNs() + ClockResyncIntervalNs;
+
+    while (!bShouldStop)
+    {
+        const int64 LocalNs = GetLocalTimeNs();
+        if (LocalNs >= NextClockResyncNs)
+        {
+            ClockToLocalNs = static_cast<int64>(Clock->GetTimeNs()) - GetLocalTimeNs();
+            NextClockResyncNs = LocalNs + ClockResyncIntervalNs;
+        }
+
+        const uint64 NowNs = static_cast<uint64>(LocalNs + ClockToLocalNs);
+        const int64 ErrorNs = static_cast<int64>(NowNs - GetPacketDueNs(NextPacket));
+
+        // The clock stepped (PTP lock, grandmaster change): start a new timeline
+        if (ErrorNs > ResyncThresholdNs || ErrorNs < -ResyncThresholdNs)
+        {
+            UE_LOG(LogRship2110, Warning, TEXT("AudioTransmitThread: Clock moved %.1f ms, re-anchoring stream"), ErrorNs * 1e-6);
+            Anchor(NowNs);
+            continue;
+        }
+
+        if (ErrorNs < 0)
+        {
+            FPlatformProcess::Sleep(static_cast<float>(FMath::Min<int64>(-ErrorNs, 1000000) * 1e-9));
+            continue;
+        }
+
+        // Everything due now, in one call when the transmitter batches
+        Batch.Reset();
+        while (Batch.Num() < Packetizer.GetMaxBatch() && GetPacketDueNs(NextPacket) <= NowNs)
+        {
+            float* PacketSamples = Samples.GetData() + Batch.Num() * SamplesPerPacket;
+            FillPacket(PacketSamples);
+            Batch.Add(Packetizer.PacketizePacket(PacketSamples, NextTimestamp));
+            NextTimestamp += FramesPerPacket;
+            NextPacket++;
+        }
+
+        // Sent when due rather than ahead with launch times; an ETF qdisc drops packets whose time has passed
+        Transmitter->SendPackets(Batch);
+        PacketsSent.fetch_add(Batch.Num(), std::memory_order_relaxed);
+    }
+
+    return 0;
+}
+
+void FRship2110AudioTransmitThread::Stop()
+{
+    bShouldStop = true;
+}
@@ -0,0 +1,711 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "Rivermax/Rship2110StreamReceiver.h"
+#include "Rship2110.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+#include "IPAddress.h"
+#include "SocketSubsystem.h"
+#include "Sockets.h"
+
+namespace
+{
+    constexpr int32 RTPHeaderSize = 12;
+
+    FORCEINLINE uint32 ReadBE16(const uint8* Source)
+    {
+        return (static_cast<uint32>(Source[0]) << 8) | Source[1];
+    }
+
+    FORCEINLINE uint32 ReadBE32(const uint8* Source)
+    {
+        return (static_cast<uint32>(Source[0]) << 24) | (static_cast<uint32>(Source[1]) << 16) |
+               (static_cast<uint32>(Source[2]) << 8) | Source[3];
+    }
+
+    /** Add a depacketizer counter's growth since the last packet to a report counter */
+    FORCEINLINE void FoldCounter(int64& ReportCounter, int64& Folded, int64 Current)
+    {
+        ReportCounter += Current - Folded;
+        Folded = Current;
+    }
+
+    /** Seconds of audio kept for comparison */
+    constexpr int32 KeptAudioSeconds = 10;
+}
+
+// ============================================================================
+// REPORT
+// ============================================================================
+
+FString FRship2110ValidationReport::ToString() const
+{
+    FString Result = FString::Printf(
+        TEXT("%lld packets, %lld lost, %lld out of order, %lld malformed, %lld header errors; ")
+        TEXT("%lld frames, %lld incomplete, %lld marker errors, %lld timestamp errors, %lld frames skipped; ")
+        TEXT("%lld payload errors"),
+        PacketsReceived, PacketsLost, PacketsOutOfOrder, PacketsMalformed, HeaderErrors,
+        FramesReceived, FramesIncomplete, MarkerErrors, TimestampErrors, TimestampGaps,
+        PayloadErrors);
+
+    if (Pacing.FramesChecked > 0)
+    {
+        Result += FString::Printf(TEXT("; pacing %s (CINST %d/%d, VRX %d/%d over %lld frames)"),
+                                  Pacing.IsCompliant() ? TEXT("compliant") : TEXT("NOT compliant"),
+                                  Pacing.CInstMax, Pacing.CMax, Pacing.VRXMax, Pacing.VRXFull, Pacing.FramesChecked);
+    }
+
+    return Result;
+}
+
+// ============================================================================
+// VALIDATOR
+// ============================================================================
+
+bool FRship2110StreamValidator::Configure(const FRship2110ReceiverConfig& InConfig)
+{
+    Config = InConfig;
+
+    const FRship2110VideoFormat& Video = Config.VideoFormat;
+    TicksPerFrame = Video.FrameRateNumerator > 0 && Video.FrameRateDenominator > 0 ?
+        90000.0 * Video.FrameRateDenominator / Video.FrameRateNumerator : 0.0;
+    MaxSamples = Config.AudioFormat.SampleRate * Config.AudioFormat.NumChannels * KeptAudioSeconds;
+
+    Reset();
+    return bValid;
+}
+
+void FRship2110StreamValidator::Reset()
+{
+    switch (Config.StreamType)
+    {
+        case ERship2110StreamType::Video_2110_20:
+            bValid = VideoDepacketizer.Configure(Config.VideoFormat) && TicksPerFrame > 0.0;
+            break;
+        case ERship2110StreamType::Audio_2110_30:
+            bValid = AudioDepacketizer.Configure(Config.AudioFormat);
+            break;
+        case ERship2110StreamType::Ancillary_2110_40:
+            AncDepacketizer = FRship2110AncDepacketizer();
+            bValid = TicksPerFrame > 0.0;
+            break;
+        default:
+            bValid = false;
+            break;
+    }
+
+    bHaveHeader = false;
+    PayloadType = 0;
+    SSRC = 0;
+
+    BaseSequence = 0;
+    SequenceCycles = 0;
+    MaxSequence = 0;
+    PacketsInSequence = 0;
+
+    bFrameOpen = false;
+    bFrameClosed = false;
+    bFrameHadLoss = false;
+    FrameTimestamp = 0;
+    FrameArrivals.Reset();
+
+    bHaveAudioTimestamp = false;
+    LastAudioTimestamp = 0;
+
+    Pacing.Reset();
+    PacingChecker = FRship2110PacingChecker();
+
+    DepacketizerMalformed = 0;
+    AncPayloadErrors = 0;
+
+    LastFrame.Reset();
+    LastFrameTimestamp = 0;
+    Samples.Reset();
+    LastAncPackets.Reset();
+
+    Report = FRship2110ValidationReport();
+}
+
+bool FRship2110StreamValidator::ReceivePacket(const uint8* Data, int32 Size, uint64 ArrivalNs)
+{
+    if (!bValid)
+    {
+        return false;
+    }
+
+    if (!Data || Size < RTPHeaderSize || (Data[0] >> 6) != 2)
+    {
+        Report.PacketsMalformed++;
+        return false;
+    }
+
+    const uint8 PacketPayloadType = Data[1] & 0x7F;
+    const bool bMarker = (Data[1] & 0x80) != 0;
+    const uint16 SequenceNumber = static_cast<uint16>(ReadBE16(Data + 2));
+    const uint32 Timestamp = ReadBE32(Data + 4);
+    const uint32 PacketSSRC = ReadBE32(Data + 8);
+
+    if (!bHaveHeader)
+    {
+        PayloadType = Config.PayloadType >= 0 ? static_cast<uint8>(Config.PayloadType) : PacketPayloadType;
+        SSRC = PacketSSRC;
+        bHaveHeader = true;
+    }
+
+    // Another stream sharing the port; keep it out of the sequence accounting
+    if (PacketPayloadType != PayloadType)
+    {
+        Report.HeaderErrors++;
+        return false;
+    }
+    if (PacketSSRC != SSRC)
+    {
+        Report.HeaderErrors++;
+        SSRC = PacketSSRC;
+    }
+
+    Report.PacketsReceived++;
+    const int32 Skipped = UpdateSequence(SequenceNumber);
+
+    if (Config.StreamType == ERship2110StreamType::Audio_2110_30)
+    {
+        const bool bParsed = AudioDepacketizer.ReceivePacket(Data, Size);
+        FoldCounter(Report.PacketsMalformed, DepacketizerMalformed, AudioDepacketizer.GetStats().PacketsMalformed);
+        if (!bParsed)
+        {
+            return false;
+        }
+
+        TrackAudio(Timestamp, Skipped);
+
+        if (Config.bKeepMedia)
+        {
+            Samples.Append(AudioDepacketizer.GetSamples());
+            if (Samples.Num() > MaxSamples)
+            {
+                // Drop the oldest half at once so trimming stays cheap
+                Samples.RemoveAt(0, Samples.Num() - MaxSamples / 2, EAllowShrinking::No);
+            }
+        }
+        AudioDepacketizer.ClearSamples();
+        return false;
+    }
+
+    // A late packet from a finished frame would restart the depacketizer's frame
+    if (Skipped < 0 && bFrameOpen && (Timestamp != FrameTimestamp || bFrameClosed))
+    {
+        return false;
+    }
+
+    bool bDataComplete = true;
+    if (Config.StreamType == ERship2110StreamType::Video_2110_20)
+    {
+        const bool bEnded = VideoDepacketizer.ReceivePacket(Data, Size);
+        FoldCounter(Report.PacketsMalformed, DepacketizerMalformed, VideoDepacketizer.GetStats().PacketsMalformed);
+        bDataComplete = bEnded && VideoDepacketizer.IsFrameComplete();
+    }
+    else
+    {
+        AncDepacketizer.ReceivePacket(Data, Size);
+        const FRship2110AncDepacketizer::FStats& AncStats = AncDepacketizer.GetStats();
+        FoldCounter(Report.PacketsMalformed, DepacketizerMalformed, AncStats.PacketsMalformed);
+        FoldCounter(Report.PayloadErrors, AncPayloadErrors, AncStats.ParityErrors + AncStats.ChecksumErrors);
+    }
+
+    return TrackFrame(Timestamp, bMarker, Skipped, ArrivalNs, bDataComplete);
+}
+
+void FRship2110StreamValidator::TakeSamples(TArray<int32>& OutSamples)
+{
+    OutSamples = MoveTemp(Samples);
+    Samples.Reset();
+}
+
+int32 FRship2110StreamValidator::UpdateSequence(uint16 SequenceNumber)
+{
+    if (PacketsInSequence == 0)
+    {
+        BaseSequence = SequenceNumber;
+        MaxSequence = SequenceNumber;
+        SequenceCycles = 0;
+        PacketsInSequence = 1;
+        return 0;
+    }
+
+    PacketsInSequence++;
+
+    // RFC 3550 A.1: a forward step under half the space is in order, anything else is late or duplicate
+    int32 Skipped = -1;
+    const uint16 Delta = static_cast<uint16>(SequenceNumber - MaxSequence);
+    if (Delta != 0 && Delta < 0x8000)
+    {
+        if (SequenceNumber < MaxSequence)
+        {
+            SequenceCycles += 0x10000;
+        }
+        MaxSequence = SequenceNumber;
+        Skipped = Delta - 1;
+    }
+    else
+    {
+        Report.PacketsOutOfOrder++;
+    }
+
+    const int64 Expected = SequenceCycles + MaxSequence - static_cast<int64>(BaseSequence) + 1;
+    Report.PacketsLost = FMath::Max<int64>(0, Expected - PacketsInSequence);
+    return Skipped;
+}
+
+bool FRship2110StreamValidator::TrackFrame(uint32 Timestamp, bool bMarker, int32 Skipped, uint64 ArrivalNs,
+                                           bool bDataComplete)
+{
+    if (bFrameOpen && Timestamp == FrameTimestamp)
+    {
+        if (bFrameClosed)
+        {
+            Report.MarkerErrors++;
+            return false;
+        }
+
+        // Loss or reordering inside the frame; its timing no longer says anything
+        if (Skipped != 0)
+        {
+            bFrameHadLoss = true;
+        }
+        if (Skipped >= 0)
+        {
+            FrameArrivals.Add(ArrivalNs);
+        }
+    }
+    else
+    {
+        if (bFrameOpen)
+        {
+            if (!bFrameClosed)
+            {
+                // The marker may have been among the lost packets
+                Report.FramesIncomplete++;
+                if (!bFrameHadLoss && Skipped == 0)
+                {
+                    Report.MarkerErrors++;
+                }
+            }
+
+            const uint32 Delta = Timestamp - FrameTimestamp;
+            const int64 Periods = Delta < 0x80000000u ? FMath::RoundToInt64(Delta / TicksPerFrame) : 0;
+            if (Periods >= 1 && FMath::Abs(static_cast<double>(Delta) - Periods * TicksPerFrame) <= 1.0)
+            {
+                Report.TimestampGaps += Periods - 1;
+            }
+            else
+            {
+                Report.TimestampErrors++;
+            }
+        }
+
+        bFrameOpen = true;
+        bFrameClosed = false;
+        bFrameHadLoss = Skipped != 0;
+        FrameTimestamp = Timestamp;
+        FrameArrivals.Reset();
+        FrameArrivals.Add(ArrivalNs);
+    }
+
+    if (!bMarker)
+    {
+        return false;
+    }
+
+    // ANC has no byte count to go on, so any loss in the frame leaves it incomplete
+    CloseFrame(bDataComplete && (Config.StreamType == ERship2110StreamType::Video_2110_20 || !bFrameHadLoss));
+    return true;
+}
+
+void FRship2110StreamValidator::CloseFrame(bool bComplete)
+{
+    bFrameClosed = true;
+    Report.FramesReceived++;
+
+    if (!bComplete)
+    {
+        Report.FramesIncomplete++;
+        return;
+    }
+
+    if (Config.StreamType == ERship2110StreamType::Video_2110_20)
+    {
+        if (Config.bKeepMedia)
+        {
+            LastFrame = VideoDepacketizer.GetFrame();
+        }
+        LastFrameTimestamp = FrameTimestamp;
+
+        if (Config.bCheckPacing && !bFrameHadLoss)
+        {
+            CheckPacing();
+        }
+    }
+    else if (Config.bKeepMedia)
+    {
+        LastAncPackets = AncDepacketizer.GetFramePackets();
+    }
+}
+
+void FRship2110StreamValidator::CheckPacing()
+{
+    const int32 NumPackets = FrameArrivals.Num();
+    if (!Pacing.IsValid())
+    {
+        if (!Pacing.Configure(Config.VideoFormat, NumPackets))
+        {
+            return;
+        }
+        PacingChecker.Configure(Pacing);
+    }
+    if (NumPackets != Pacing.GetPacketsPerFrame())
+    {
+        return;
+    }
+
+    // Latest frame start that has every packet in by its read time
+    const double TRSNs = Pacing.GetTRSNs();
+    const double TROffsetNs = Pacing.GetTROffsetNs();
+    double StartNs = static_cast<double>(FrameArrivals[0]) - TROffsetNs;
+    for (int32 j = 1; j < NumPackets; ++j)
+    {
+        StartNs = FMath::Max(StartNs, static_cast<double>(FrameArrivals[j]) - TROffsetNs - j * TRSNs);
+    }
+
+    PacingChecker.AddFrame(static_cast<uint64>(FMath::Max(0.0, FMath::CeilToDouble(StartNs))), FrameArrivals);
+    Report.Pacing = PacingChecker.GetReport();
+}
+
+void FRship2110StreamValidator::TrackAudio(uint32 Timestamp, int32 Skipped)
+{
+    // Late packets were already accounted for by the packets that overtook them
+    if (Skipped < 0)
+    {
+        return;
+    }
+
+    if (bHaveAudioTimestamp)
+    {
+        const uint32 Expected = LastAudioTimestamp + static_cast<uint32>(Config.AudioFormat.GetSamplesPerPacket()) * (Skipped + 1);
+        if (Timestamp != Expected)
+        {
+            Report.TimestampErrors++;
+        }
+    }
+
+    bHaveAudioTimestamp = true;
+    LastAudioTimestamp = Timestamp;
+}
+
+FRship2110FrameComparison FRship2110StreamValidator::CompareFrames(const FRship2110VideoFormat& Format,
+                                                                   TConstArrayView<uint8> Expected,
+                                                                   TConstArrayView<uint8> Received)
+{
+    FRship2110FrameComparison Result;
+
+    const int32 LineBytes = Format.GetBytesPerLine();
+    const int32 PGroupSize = Format.GetPGroupSize();
+    const int32 PGroupCoverage = Format.GetPGroupCoverage();
+    if (LineBytes <= 0 || PGroupSize <= 0 || Format.Height <= 0)
+    {
+        return Result;
+    }
+
+    const int32 PGroupsPerLine = LineBytes / PGroupSize;
+    const int64 FrameBytes = static_cast<int64>(LineBytes) * Format.Height;
+    if (Expected.Num() != Received.Num() || Expected.Num() < FrameBytes)
+    {
+        Result.MismatchedPGroups = static_cast<int64>(PGroupsPerLine) * Format.Height;
+        Result.FirstRow = 0;
+        Result.FirstPixel = 0;
+        return Result;
+    }
+
+    for (int32 Row = 0; Row < Format.Height; ++Row)
+    {
+        const uint8* ExpectedLine = Expected.GetData() + static_cast<int64>(Row) * LineBytes;
+        const uint8* ReceivedLine = Received.GetData() + static_cast<int64>(Row) * LineBytes;
+        if (FMemory::Memcmp(ExpectedLine, ReceivedLine, LineBytes) == 0)
+        {
+            continue;
+        }
+
+        for (int32 PGroup = 0; PGroup < PGroupsPerLine; ++PGroup)
+        {
+            if (FMemory::Memcmp(ExpectedLine + PGroup * PGroupSize, ReceivedLine + PGroup * PGroupSize, PGroupSize) != 0)
+            {
+                if (Result.MismatchedPGroups == 0)
+                {
+                    Result.FirstRow = Row;
+                    Result.FirstPixel = PGroup * PGroupCoverage;
+                }
+                Result.MismatchedPGroups++;
+            }
+        }
+    }
+
+    return Result;
+}
+
+// ============================================================================
+// RECEIVE THREAD
+// ============================================================================
+
+FRship2110StreamReceiver::FRship2110StreamReceiver()
+{
+    Batch.SetNumUninitialized(BatchSize * MaxDatagramSize);
+}
+
+FRship2110StreamReceiver::~FRship2110StreamReceiver()
+{
+    Close();
+}
+
+bool FRship2110StreamReceiver::Open(const FRship2110ReceiverConfig& InConfig, const FString& Address, int32 Port,
+                                    const FString& InterfaceIP)
+{
+    Close();
+
+    if (!Validator.Configure(InConfig))
+    {
+        UE_LOG(LogRship2110, Warning, TEXT("StreamReceiver: Unsupported stream configuration"));
+        return false;
+    }
+
+    ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+    if (!SocketSubsystem)
+    {
+        return false;
+    }
+
+    TSharedRef<FInternetAddr> StreamAddr = SocketSubsystem->CreateInternetAddr();
+    bool bIsValid = false;
+    StreamAddr->SetIp(*Address, bIsValid);
+    if (!bIsValid)
+    {
+        UE_LOG(LogRship2110, Warning, TEXT("StreamReceiver: Invalid address: %s"), *Address);
+        return false;
+    }
+
+    // 224.0.0.0/4
+    const int32 FirstOctet = FCString::Atoi(*Address);
+    const bool bMulticast = FirstOctet >= 224 && FirstOctet <= 239;
+
+    Socket = SocketSubsystem->CreateSocket(NAME_DGram, TEXT("Rship2110Receive"), false);
+    if (!Socket)
+    {
+        return false;
+    }
+
+    Socket->SetReuseAddr(true);
+    Socket->SetNonBlocking(true);
+    int32 ActualSize = 0;
+    Socket->SetReceiveBufferSize(32 * 1024 * 1024, ActualSize);
+
+    // Multicast binds the wildcard address so the group's traffic is delivered
+    TSharedRef<FInternetAddr> BindAddr = SocketSubsystem->CreateInternetAddr();
+    if (bMulticast)
+    {
+        BindAddr->SetAnyAddress();
+    }
+    else
+    {
+        BindAddr->SetIp(*Address, bIsValid);
+    }
+    BindAddr->SetPort(Port);
+    if (!Socket->Bind(*BindAddr))
+    {
+        UE_LOG(LogRship2110, Warning, TEXT("StreamReceiver: Could not bind %s:%d"), *Address, Port);
+        Close();
+        return false;
+    }
+
+    if (bMulticast)
+    {
+        bool bJoined = false;
+        if (!InterfaceIP.IsEmpty())
+        {
+            TSharedRef<FInternetAddr> InterfaceAddr = SocketSubsystem->CreateInternetAddr();
+            bool bInterfaceValid = false;
+            InterfaceAddr->SetIp(*InterfaceIP, bInterfaceValid);
+            bJoined = bInterfaceValid && Socket->JoinMulticastGroup(*StreamAddr, *InterfaceAddr);
+        }
+        else
+        {
+            bJoined = Socket->JoinMulticastGroup(*StreamAddr);
+        }
+
+        if (!bJoined)
+        {
+            UE_LOG(LogRship2110, Warning, TEXT("StreamReceiver: Could not join %s on %s"), *Address,
+                   InterfaceIP.IsEmpty() ? TEXT("the default interface") : *InterfaceIP);
+            Close();
+            return false;
+        }
+    }
+
+    BoundPort = Socket->GetPortNo();
+    UE_LOG(LogRship2110, Log, TEXT("StreamReceiver: Listening on %s:%d"), *Address, BoundPort);
+    return true;
+}
+
+void FRship2110StreamReceiver::Close()
+{
+    Shutdown();
+
+    if (Socket)
+    {
+        Socket->Close();
+        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+        Socket = nullptr;
+    }
+    BoundPort = 0;
+}
+
+bool FRship2110StreamReceiver::Start()
+{
+    if (Thread)
+    {
+        return true;
+    }
+
+    if (!Socket)
+    {
+        return false;
+    }
+
+    bShouldStop = false;
+    Thread = FRunnableThread::Create(this, TEXT("Rship2110StreamReceiver"), 0, TPri_AboveNormal);
+    return Thread != nullptr;
+}
+
+void FRship2110StreamReceiver::Shutdown()
+{
+    if (!Thread)
+    {
+        return;
+    }
+
+    Stop();
+    Thread->WaitForCompletion();
+    delete Thread;
+    Thread = nullptr;
+}
+
+void FRship2110StreamReceiver::Reset()
+{
+    FScopeLock Lock(&ValidatorLock);
+    Validator.Reset();
+}
+
+FRship2110ValidationReport FRship2110StreamReceiver::GetReport() const
+{
+    FScopeLock Lock(&ValidatorLock);
+    return Validator.GetReport();
+}
+
+bool FRship2110StreamReceiver::CopyLastFrame(TArray<uint8>& OutFrame) const
+{
+    FScopeLock Lock(&ValidatorLock);
+    OutFrame = Validator.GetLastFrame();
+    return OutFrame.Num() > 0;
+}
+
+void FRship2110StreamReceiver::TakeSamples(TArray<int32>& OutSamples)
+{
+    FScopeLock Lock(&ValidatorLock);
+    Validator.TakeSamples(OutSamples);
+}
+
+void FRship2110StreamReceiver::CopyLastAncPackets(TArray<FRship2110AncPacket>& OutPackets) const
+{
+    FScopeLock Lock(&ValidatorLock);
+    OutPackets = Validator.GetLastAncPackets();
+}
+
+bool FRship2110StreamReceiver::WaitForFrames(int64 Count, double TimeoutSeconds) const
+{
+    const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+    for (;;)
+    {
+        {
+            FScopeLock Lock(&ValidatorLock);
+            if (Validator.GetReport().FramesReceived >= Count)
+            {
+                return true;
+            }
+        }
+
+        if (!Thread || FPlatformTime::Seconds() > Deadline)
+        {
+            return false;
+        }
+        FPlatformProcess::Sleep(0.0005f);
+    }
+}
+
+bool FRship2110StreamReceiver::WaitForPackets(int64 Count, double TimeoutSeconds) const
+{
+    const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+    for (;;)
+    {
+        {
+            FScopeLock Lock(&ValidatorLock);
+            if (Validator.GetReport().PacketsReceived >= Count)
+            {
+                return true;
+            }
+        }
+
+        if (!Thread || FPlatformTime::Seconds() > Deadline)
+        {
+            return false;
+        }
+        FPlatformProcess::Sleep(0.0005f);
+    }
+}
+
+uint32 FRship2110StreamReceiver::Run()
+{
+    FRship2110LocalPacingClock Clock;
+
+    while (!bShouldStop)
+    {
+        if (!Socket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromMilliseconds(100)))
+        {
+            continue;
+        }
+
+        // Read and timestamp a batch before taking the lock, so readers of the report never hold up the socket
+        int32 Count = 0;
+        while (Count < BatchSize)
+        {
+            int32 BytesRead = 0;
+            if (!Socket->Recv(Batch.GetData() + Count * MaxDatagramSize, MaxDatagramSize, BytesRead) || BytesRead <= 0)
+            {
+                break;
+            }
+            BatchSizes[Count] = BytesRead;
+            BatchTimes[Count] = Clock.GetTimeNs();
+            Count++;
+        }
+
+        FScopeLock Lock(&ValidatorLock);
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            Validator.ReceivePacket(Batch.GetData() + Index * MaxDatagramSize, BatchSizes[Index], BatchTimes[Index]);
+        }
+    }
+
+    return 0;
+}
+
+void FRship2110StreamReceiver::Stop()
+{
+    bShouldStop = true;
+}
@@ -0,0 +1,405 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "Rivermax/Rship2110VideoPacketizer.h"
+#include "Rship2110.h"
+
+namespace
+{
+    FORCEINLINE void WriteBE16(uint8* Dest, uint32 Value)
+    {
+        Dest[0] = static_cast<uint8>(Value >> 8);
+        Dest[1] = static_cast<uint8>(Value);
+    }
+
+    FORCEINLINE void WriteBE32(uint8* Dest, uint32 Value)
+    {
+        Dest[0] = static_cast<uint8>(Value >> 24);
+        Dest[1] = static_cast<uint8>(Value >> 16);
+        Dest[2] = static_cast<uint8>(Value >> 8);
+        Dest[3] = static_cast<uint8>(Value);
+    }
+
+    FORCEINLINE uint32 ReadBE16(const uint8* Source)
+    {
+        return (static_cast<uint32>(Source[0]) << 8) | Source[1];
+    }
+
+    FORCEINLINE uint32 ReadBE32(const uint8* Source)
+    {
+        return (static_cast<uint32>(Source[0]) << 24) | (static_cast<uint32>(Source[1]) << 16) |
+               (static_cast<uint32>(Source[2]) << 8) | Source[3];
+    }
+
+    // Row number and pixel offset are 15-bit fields
+    constexpr int32 MaxSRDField = 0x7FFF;
+}
+
+// ============================================================================
+// PACKETIZER
+// ============================================================================
+
+bool FRship2110VideoPacketizer::Configure(const FRship2110VideoFormat& InFormat, uint8 InPayloadType, uint32 InSSRC,
+                                          int32 InMaxPacketSize)
+{
+    Reset();
+
+    Format = InFormat;
+    PayloadType = InPayloadType & 0x7F;
+    SSRC = InSSRC;
+    MaxPacketSize = InMaxPacketSize;
+    LineBytes = Format.GetBytesPerLine();
+    PGroupSize = Format.GetPGroupSize();
+    PGroupCoverage = Format.GetPGroupCoverage();
+
+    if (Format.Width <= 0 || Format.Height <= 0 || PGroupSize <= 0 || Format.Width % PGroupCoverage != 0)
+    {
+        UE_LOG(LogRship2110, Warning, TEXT("VideoPacketizer: Width %d is not a whole number of %d-pixel pgroups"),
+               Format.Width, PGroupCoverage);
+        return false;
+    }
+
+    if (Format.Width - 1 > MaxSRDField || Format.Height - 1 > MaxSRDField)
+    {
+        UE_LOG(LogRship2110, Warning, TEXT("VideoPacketizer: %dx%d exceeds the SRD row/offset range"),
+               Format.Width, Format.Height);
+        return false;
+    }
+
+    const int32 MinPacketSize = RTPHeaderSize + PayloadHeaderSize + SRDHeaderSize + PGroupSize;
+    if (MaxPacketSize < MinPacketSize)
+    {
+        UE_LOG(LogRship2110, Warning, TEXT("VideoPacketizer: Packet size %d cannot hold a pgroup"), MaxPacketSize);
+        return false;
+    }
+
+    if (Format.PackingMode == ERship2110PackingMode::BPM)
+    {
+        if (BPMBlockSize % PGroupSize != 0)
+        {
+            UE_LOG(LogRship2110, Warning, TEXT("VideoPacketizer: BPM needs a pgroup size dividing %d bytes (have %d)"),
+                   BPMBlockSize, PGroupSize);
+            return false;
+        }
+
+        const int32 BPMPacketSize = RTPHeaderSize + PayloadHeaderSize + SRDHeaderSize * MaxSRDsPerPacket + BPMPacketDataSize;
+        if (MaxPacketSize < BPMPacketSize)
+        {
+            UE_LOG(LogRship2110, Warning, TEXT("VideoPacketizer: BPM needs %d-byte packets (limit %d)"),
+                   BPMPacketSize, MaxPacketSize);
+            return false;
+        }
+    }
+
+    if (!PlanPackets())
+    {
+        Reset();
+        return false;
+    }
+
+    // Every packet gets a MaxPacketSize slot, so a frame never allocates
+    Arena.SetNumZeroed(Plan.Num() * MaxPacketSize);
+    Packets.SetNum(Plan.Num());
+
+    WireBytesPerFrame = 0;
+    for (int32 PacketIndex = 0; PacketIndex < Plan.Num(); ++PacketIndex)
+    {
+        const FPlannedPacket& Planned = Plan[PacketIndex];
+        int32 Size = RTPHeaderSize + PayloadHeaderSize + SRDHeaderSize * Planned.NumSegments;
+        for (int32 i = 0; i < Planned.NumSegments; ++i)
+        {
+            Size += Segments[Planned.FirstSegment + i].Length;
+        }
+
+        Packets[PacketIndex].Data = Arena.GetData() + static_cast<int64>(PacketIndex) * MaxPacketSize;
+        Packets[PacketIndex].Size = Size;
+        WireBytesPerFrame += Size;
+    }
+
+    bValid = true;
+
+    UE_LOG(LogRship2110, Verbose, TEXT("VideoPacketizer: %dx%d %s, %d packets per frame"),
+           Format.Width, Format.Height, *Format.GetPackingModeString(), Plan.Num());
+
+    return true;
+}
+
+void FRship2110VideoPacketizer::Reset()
+{
+    bValid = false;
+    WireBytesPerFrame = 0;
+    Segments.Empty();
+    Plan.Empty();
+    Packets.Empty();
+    Arena.Empty();
+}
+
+bool FRship2110VideoPacketizer::PlanPackets()
+{
+    const bool bBlockMode = Format.PackingMode == ERship2110PackingMode::BPM;
+    const int32 Capacity = MaxPacketSize - RTPHeaderSize - PayloadHeaderSize;
+
+    int32 Row = 0;
+    int32 LineOffset = 0;
+
+    while (Row < Format.Height)
+    {
+        FPlannedPacket& Planned = Plan.AddDefaulted_GetRef();
+        Planned.FirstSegment = Segments.Num();
+
+        int32 Used = 0;
+        int32 DataBytes = 0;
+
+        while (Row < Format.Height && Planned.NumSegments < MaxSRDsPerPacket)
+        {
+            const int32 LineRemaining = LineBytes - LineOffset;
+            int32 Length = 0;
+
+            if (bBlockMode)
+            {
+                // 1260 is a multiple of the pgroup size, so the cut lands on a pgroup
+                Length = FMath::Min(BPMPacketDataSize - DataBytes, LineRemaining);
+            }
+            else
+            {
+                const int32 Room = Capacity - Used - SRDHeaderSize;
+                Length = FMath::Min((Room / PGroupSize) * PGroupSize, LineRemaining);
+            }
+
+            if (Length <= 0)
+            {
+                break;
+            }
+
+            FSegment& Segment = Segments.AddDefaulted_GetRef();
+            Segment.Row = Row;
+            Segment.PixelOffset = (LineOffset / PGroupSize) * PGroupCoverage;
+            Segment.Length = Length;
+            Segment.FrameOffset = static_cast<int64>(Row) * LineBytes + LineOffset;
+
+            Planned.NumSegments++;
+            Used += SRDHeaderSize + Length;
+            DataBytes += Length;
+
+            LineOffset += Length;
+            if (LineOffset == LineBytes)
+            {
+                LineOffset = 0;
+                Row++;
+            }
+
+            if (bBlockMode && DataBytes == BPMPacketDataSize)
+            {
+                break;
+            }
+        }
+
+        // Configure guarantees room for one pgroup, so this means a planning bug
+        if (Planned.NumSegments == 0)
+        {
+            UE_LOG(LogRship2110, Warning, TEXT("VideoPacketizer: Could not place sample data for row %d"), Row);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+TConstArrayView<FRship2110Packet> FRship2110VideoPacketizer::PacketizeFrame(const uint8* FrameData, uint32 RTPTimestamp)
+{
+    if (!bValid || !FrameData)
+    {
+        return TConstArrayView<FRship2110Packet>();
+    }
+
+    const int32 LastPacket = Plan.Num() - 1;
+
+    for (int32 PacketIndex = 0; PacketIndex <= LastPacket; ++PacketIndex)
+    {
+        const FPlannedPacket& Planned = Plan[PacketIndex];
+        uint8* Out = Arena.GetData() + static_cast<int64>(PacketIndex) * MaxPacketSize;
+
+        // RTP header: V=2, no padding/extension/CSRC; marker on the frame's last packet
+        Out[0] = 0x80;
+        Out[1] = PayloadType | (PacketIndex == LastPacket ? 0x80 : 0x00);
+        WriteBE16(Out + 2, ExtendedSequenceNumber & 0xFFFF);
+        WriteBE32(Out + 4, RTPTimestamp);
+        WriteBE32(Out + 8, SSRC);
+
+        // Payload header: high half of the 32-bit sequence number
+        WriteBE16(Out + RTPHeaderSize, ExtendedSequenceNumber >> 16);
+        ExtendedSequenceNumber++;
+
+        uint8* Header = Out + RTPHeaderSize + PayloadHeaderSize;
+        uint8* Payload = Header + SRDHeaderSize * Planned.NumSegments;
+
+        for (int32 i = 0; i < Planned.NumSegments; ++i)
+        {
+            const FSegment& Segment = Segments[Planned.FirstSegment + i];
+            const bool bContinuation = i + 1 < Planned.NumSegments;
+
+            WriteBE16(Header, Segment.Length);
+            WriteBE16(Header + 2, Segment.Row);  // F bit clear: progressive
+            WriteBE16(Header + 4, Segment.PixelOffset | (bContinuation ? 0x8000 : 0));
+            Header += SRDHeaderSize;
+
+            FMemory::Memcpy(Payload, FrameData + Segment.FrameOffset, Segment.Length);
+            Payload += Segment.Length;
+        }
+    }
+
+    return Packets;
+}
+
+// ============================================================================
+// DEPACKETIZER
+// ============================================================================
+
+bool FRship2110VideoDepacketizer::Configure(const FRship2110VideoFormat& InFormat)
+{
+    Format = InFormat;
+    LineBytes = Format.GetBytesPerLine();
+    PGroupSize = Format.GetPGroupSize();
+    PGroupCoverage = Format.GetPGroupCoverage();
+
+    bValid = Format.Width > 0 && Format.Height > 0 && PGroupSize > 0 && Format.Width % PGroupCoverage == 0;
+    Frame.SetNumZeroed(bValid ? static_cast<int32>(Format.GetFrameSizeBytes()) : 0);
+
+    FrameBytesReceived = 0;
+    bFrameStarted = false;
+    bFrameComplete = false;
+    FrameTimestamp = 0;
+    bHaveSequence = false;
+    LastSequenceNumber = 0;
+    Stats = FStats();
+
+    return bValid;
+}
+
+bool FRship2110VideoDepacketizer::ReceivePacket(const uint8* Data, int32 Size)
+{
+    constexpr int32 RTPHeaderSize = FRship2110VideoPacketizer::RTPHeaderSize;
+    constexpr int32 PayloadHeaderSize = FRship2110VideoPacketizer::PayloadHeaderSize;
+    constexpr int32 SRDHeaderSize = FRship2110VideoPacketizer::SRDHeaderSize;
+
+    if (!bValid || !Data || Size < RTPHeaderSize || (Data[0] >> 6) != 2)
+    {
+        Stats.PacketsMalformed++;
+        return false;
+    }
+
+    // Skip CSRCs and header extension, drop padding
+    int32 End = Size;
+    if (Data[0] & 0x20)
+    {
+        End -= Data[Size - 1];
+    }
+    int32 Cursor = RTPHeaderSize + 4 * (Data[0] & 0x0F);
+    if ((Data[0] & 0x10) && Cursor + 4 <= End)
+    {
+        Cursor += 4 + 4 * static_cast<int32>(ReadBE16(Data + Cursor + 2));
+    }
+    if (Cursor + PayloadHeaderSize + SRDHeaderSize > End)
+    {
+        Stats.PacketsMalformed++;
+        return false;
+    }
+
+    const bool bMarker = (Data[1] & 0x80) != 0;
+    const uint32 Timestamp = ReadBE32(Data + 4);
+    const uint32 Sequence = (ReadBE16(Data + Cursor) << 16) | ReadBE16(Data + 2);
+    Cursor += PayloadHeaderSize;
+
+    Stats.PacketsReceived++;
+
+    if (bHaveSequence)
+    {
+        // Forward gaps are losses; late or duplicate packets are not
+        const int32 Gap = static_cast<int32>(Sequence - (LastSequenceNumber + 1));
+        if (Gap > 0)
+        {
+            Stats.PacketsLost += Gap;
+        }
+    }
+    if (!bHaveSequence || static_cast<int32>(Sequence - LastSequenceNumber) > 0)
+    {
+        LastSequenceNumber = Sequence;
+    }
+    bHaveSequence = true;
+
+    // A new timestamp without a marker in between means the last frame was cut short
+    if (bFrameStarted && Timestamp != FrameTimestamp)
+    {
+        Stats.FramesIncomplete++;
+        bFrameStarted = false;
+    }
+    if (!bFrameStarted)
+    {
+        bFrameStarted = true;
+        bFrameComplete = false;
+        FrameTimestamp = Timestamp;
+        FrameBytesReceived = 0;
+    }
+
+    // SRD headers run until one has the continuation bit clear
+    struct FSRD
+    {
+        int32 Length;
+        int32 Row;
+        int32 Offset;
+    };
+    FSRD SRDs[16];
+    int32 NumSRDs = 0;
+    bool bContinuation = true;
+
+    while (bContinuation)
+    {
+        if (NumSRDs == UE_ARRAY_COUNT(SRDs) || Cursor + SRDHeaderSize > End)
+        {
+            Stats.PacketsMalformed++;
+            return false;
+        }
+
+        FSRD& SRD = SRDs[NumSRDs++];
+        SRD.Length = static_cast<int32>(ReadBE16(Data + Cursor));
+        SRD.Row = static_cast<int32>(ReadBE16(Data + Cursor + 2) & 0x7FFF);
+        const uint32 OffsetField = ReadBE16(Data + Cursor + 4);
+        SRD.Offset = static_cast<int32>(OffsetField & 0x7FFF);
+        bContinuation = (OffsetField & 0x8000) != 0;
+        Cursor += SRDHeaderSize;
+    }
+
+    for (int32 i = 0; i < NumSRDs; ++i)
+    {
+        const FSRD& SRD = SRDs[i];
+        const int32 LineOffset = (SRD.Offset / PGroupCoverage) * PGroupSize;
+
+        if (SRD.Row >= Format.Height || SRD.Offset % PGroupCoverage != 0 || SRD.Length % PGroupSize != 0 ||
+            LineOffset + SRD.Length > LineBytes || Cursor + SRD.Length > End)
+        {
+            Stats.PacketsMalformed++;
+            return false;
+        }
+
+        FMemory::Memcpy(Frame.GetData() + static_cast<int64>(SRD.Row) * LineBytes + LineOffset, Data + Cursor, SRD.Length);
+        Cursor += SRD.Length;
+        FrameBytesReceived += SRD.Length;
+    }
+
+    if (!bMarker)
+    {
+        return false;
+    }
+
+    bFrameStarted = false;
+    bFrameComplete = FrameBytesReceived == Frame.Num();
+    if (bFrameComplete)
+    {
+        Stats.FramesComplete++;
+    }
+    else
+    {
+        Stats.FramesIncomplete++;
+    }
+
+    return true;
+}
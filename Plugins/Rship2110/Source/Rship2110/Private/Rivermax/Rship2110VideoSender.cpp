@@ -2,14 +2,16 @@
 
 #include "Rivermax/Rship2110VideoSender.h"
 #include "Rivermax/RivermaxManager.h"
+#include "Capture/Rship2110GPUReadback.h"
 #include "PTP/RshipPTPService.h"
 #include "Rship2110.h"
+#include "Rship2110Settings.h"
 #include "RenderGraphBuilder.h"
 #include "RenderGraphUtils.h"
 #include "Engine/TextureRenderTarget2D.h"
-#include "SocketSubsystem.h"
-#include "Sockets.h"
-#include "IPAddress.h"
+#include "Engine/Texture2D.h"
+#include "RenderingThread.h"
+#include "TextureResource.h"
 
 #if RSHIP_RIVERMAX_AVAILABLE
 #if PLATFORM_WINDOWS
@@ -29,24 +31,51 @@
 
 int32 FRship2110VideoFormat::GetBytesPerLine() const
 {
-    int32 BitsPerPixel = 0;
-    int32 BitsPerSample = GetBitDepthInt();
+    // Lines are sent as whole pgroups
+    const int32 Coverage = GetPGroupCoverage();
+    return ((Width + Coverage - 1) / Coverage) * GetPGroupSize();
+}
+
+int32 FRship2110VideoFormat::GetPGroupSize() const
+{
+    int32 SamplesPerPGroup = 0;
 
     switch (ColorFormat)
     {
         case ERship2110ColorFormat::YCbCr_422:
-            BitsPerPixel = BitsPerSample * 2;  // 2 samples per pixel average
+            SamplesPerPGroup = GetPGroupCoverage() * 2;  // Cb Y Cr Y
             break;
         case ERship2110ColorFormat::YCbCr_444:
         case ERship2110ColorFormat::RGB_444:
-            BitsPerPixel = BitsPerSample * 3;
+            SamplesPerPGroup = GetPGroupCoverage() * 3;
             break;
         case ERship2110ColorFormat::RGBA_4444:
-            BitsPerPixel = BitsPerSample * 4;
+            SamplesPerPGroup = GetPGroupCoverage() * 4;
             break;
     }
 
-    return (Width * BitsPerPixel + 7) / 8;
+    return SamplesPerPGroup * GetBitDepthInt() / 8;
+}
+
+int32 FRship2110VideoFormat::GetPGroupCoverage() const
+{
+    // Smallest run of pixels whose samples end on a byte boundary
+    switch (ColorFormat)
+    {
+        case ERship2110ColorFormat::YCbCr_422:
+            return 2;
+        case ERship2110ColorFormat::YCbCr_444:
+        case ERship2110ColorFormat::RGB_444:
+            switch (BitDepth)
+            {
+                case ERship2110BitDepth::Bits_10: return 4;
+                case ERship2110BitDepth::Bits_12: return 2;
+                default: return 1;
+            }
+        case ERship2110ColorFormat::RGBA_4444:
+        default:
+            return 1;
+    }
 }
 
 int64 FRship2110VideoFormat::GetFrameSizeBytes() const
@@ -111,27 +140,10 @@ bool URship2110VideoSender::Initialize(
         return false;
     }
 
-    // Create UDP socket for fallback transmission
-    ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
-    if (SocketSubsystem)
+    if (!CreateTransmitThread())
     {
-        UDPSocket = SocketSubsystem->CreateSocket(NAME_DGram, TEXT("Rship2110VideoSender"), false);
-        if (UDPSocket)
-        {
-            UDPSocket->SetNonBlocking(true);
-            UDPSocket->SetBroadcast(true);
-
-            // Set up destination address
-            DestinationAddr = SocketSubsystem->CreateInternetAddr();
-            bool bIsValid = false;
-            DestinationAddr->SetIp(*TransportParams.DestinationIP, bIsValid);
-            DestinationAddr->SetPort(TransportParams.DestinationPort);
-
-            if (!bIsValid)
-            {
-                UE_LOG(LogRship2110, Warning, TEXT("VideoSender: Invalid destination IP: %s"), *TransportParams.DestinationIP);
-            }
-        }
+        FreeBuffers();
+        return false;
     }
 
 #if RSHIP_RIVERMAX_AVAILABLE
@@ -158,14 +170,9 @@ void URship2110VideoSender::Shutdown()
     DestroyRivermaxStream();
 #endif
 
-    // Clean up UDP socket
-    if (UDPSocket)
-    {
-        UDPSocket->Close();
-        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(UDPSocket);
-        UDPSocket = nullptr;
-    }
-    DestinationAddr.Reset();
+    // Joins the transmit thread and closes its socket
+    TransmitThread.Reset();
+    PacingClock.Reset();
 
     FreeBuffers();
 
@@ -210,6 +217,21 @@ bool URship2110VideoSender::StartStream()
         CurrentRTPTimestamp = FMath::Rand();
     }
 
+    if (TransmitThread && TransmitThread->GetTransmitter())
+    {
+        URship2110Settings* Settings = URship2110Settings::Get();
+
+        // Anchor packets to PTP frame boundaries
+        const IPTPProvider* Provider = PTPService ? PTPService->GetProvider() : nullptr;
+        if (Provider && (!Settings || Settings->bEnablePacing))
+        {
+            PacingClock = MakeUnique<FRship2110ProviderPacingClock>(*Provider);
+        }
+        TransmitThread->SetPacingClock(PacingClock.Get());
+
+        TransmitThread->Start(CurrentSequenceNumber, Settings ? Settings->TransmitThreadCore : -1);
+    }
+
     SetState(ERship2110StreamState::Running);
 
     UE_LOG(LogRship2110, Log, TEXT("VideoSender %s: Stream started"), *StreamId);
@@ -223,6 +245,13 @@ void URship2110VideoSender::StopStream()
         return;
     }
 
+    if (TransmitThread)
+    {
+        TransmitThread->Shutdown();
+        TransmitThread->SetPacingClock(nullptr);
+    }
+    PacingClock.Reset();
+
     SetState(ERship2110StreamState::Stopped);
 
     UE_LOG(LogRship2110, Log, TEXT("VideoSender %s: Stream stopped"), *StreamId);
@@ -274,36 +303,96 @@ bool URship2110VideoSender::SubmitFrame(const void* FrameData, int64 DataSize, c
 #if RSHIP_RIVERMAX_AVAILABLE
     return SendFrameViaRivermax(FrameData, DataSize, PTPTimestamp);
 #else
-    // Stub mode - simulate successful send
-    Stats.FramesSent++;
-    Stats.BytesSent += DataSize;
-    return true;
+    return SendFrameViaSoftware(FrameData, DataSize, PTPTimestamp);
 #endif
 }
 
 bool URship2110VideoSender::SubmitFrameFromTexture(UTexture2D* SourceTexture, const FRshipPTPTimestamp& PTPTimestamp)
 {
-    // TODO: Implement GPU texture copy path
-    UE_LOG(LogRship2110, Warning, TEXT("VideoSender: SubmitFrameFromTexture not yet implemented"));
-    return false;
+    if (State != ERship2110StreamState::Running)
+    {
+        return false;
+    }
+
+    if (!SourceTexture || !SourceTexture->GetResource())
+    {
+        UE_LOG(LogRship2110, Warning, TEXT("VideoSender: Texture has no render resource"));
+        return false;
+    }
+
+    return EnqueueReadback(SourceTexture->GetResource(), PTPTimestamp);
+}
+
+bool URship2110VideoSender::SubmitFramePixels(const void* Pixels, ERship2110PixelInput Input, int32 SourceStride, const FRshipPTPTimestamp& PTPTimestamp)
+{
+    if (State != ERship2110StreamState::Running)
+    {
+        return false;
+    }
+
+    if (!Pixels || !PixelConverter.IsValid() || !PixelFramePool.IsValid())
+    {
+        UE_LOG(LogRship2110, Warning, TEXT("VideoSender: Cannot convert pixels for %dx%d %s"),
+               VideoFormat.Width, VideoFormat.Height, *VideoFormat.GetSampling());
+        return false;
+    }
+
+    // Every frame is still queued or sending
+    FRship2110FrameRef Frame = PixelFramePool->Acquire();
+    if (!Frame.IsValid())
+    {
+        Stats.FramesDropped++;
+        return false;
+    }
+
+    PixelConverter.ConvertFrame(Pixels, Input, SourceStride, Frame.GetData());
+    Frame.SetTimestamp(PTPTimestamp);
+    return SendPooledFrame(MoveTemp(Frame));
 }
 
 bool URship2110VideoSender::UpdateTransportParams(const FRship2110TransportParams& NewParams)
 {
-    // Some params can be updated while streaming
-    TransportParams.DSCP = NewParams.DSCP;
-    TransportParams.TTL = NewParams.TTL;
+    const bool bAddressChanged =
+        NewParams.SourceIP != TransportParams.SourceIP ||
+        NewParams.SourcePort != TransportParams.SourcePort ||
+        NewParams.DestinationIP != TransportParams.DestinationIP ||
+        NewParams.DestinationPort != TransportParams.DestinationPort;
 
-    // Changing destination requires stream restart
-    if (NewParams.DestinationIP != TransportParams.DestinationIP ||
-        NewParams.DestinationPort != TransportParams.DestinationPort)
+    // Changing addresses requires stream restart
+    if (bAddressChanged && State != ERship2110StreamState::Stopped)
     {
         UE_LOG(LogRship2110, Warning,
                TEXT("VideoSender: Destination change requires stream restart"));
         return false;
     }
 
-    return true;
+    // Some params can be updated while streaming
+    TransportParams.DSCP = NewParams.DSCP;
+    TransportParams.TTL = NewParams.TTL;
+
+    if (!bAddressChanged)
+    {
+        return true;
+    }
+
+    TransportParams.SourceIP = NewParams.SourceIP;
+    TransportParams.SourcePort = NewParams.SourcePort;
+    TransportParams.DestinationIP = NewParams.DestinationIP;
+    TransportParams.DestinationPort = NewParams.DestinationPort;
+
+#if RSHIP_RIVERMAX_AVAILABLE
+    DestroyRivermaxStream();
+    if (!CreateRivermaxStream())
+    {
+        UE_LOG(LogRship2110, Warning, TEXT("VideoSender: Failed to create Rivermax stream, using stub"));
+    }
+#endif
+
+    UE_LOG(LogRship2110, Log, TEXT("VideoSender %s: Sending to %s:%d"),
+           *StreamId, *TransportParams.DestinationIP, TransportParams.DestinationPort);
+
+    // Reopen the socket for the new addresses
+    return CreateTransmitThread();
 }
 
 void URship2110VideoSender::ResetStatistics()
@@ -343,14 +432,18 @@ FString URship2110VideoSender::GenerateSDP() const
 
     // Format parameters (ST 2110-20)
     SDP += FString::Printf(
-        TEXT("a=fmtp:%d sampling=%s; width=%d; height=%d; exactframerate=%d/%d; depth=%d; colorimetry=BT709; PM=2110GPM; SSN=ST2110-20:2017\r\n"),
+        TEXT("a=fmtp:%d sampling=%s; width=%d; height=%d; exactframerate=%d/%d; depth=%d; colorimetry=%s; RANGE=%s; PM=%s; SSN=ST2110-20:2017; TP=%s\r\n"),
         TransportParams.PayloadType,
         *VideoFormat.GetSampling(),
         VideoFormat.Width,
         VideoFormat.Height,
         VideoFormat.FrameRateNumerator,
         VideoFormat.FrameRateDenominator,
-        VideoFormat.GetBitDepthInt());
+        VideoFormat.GetBitDepthInt(),
+        *VideoFormat.GetColorimetryString(),
+        *VideoFormat.GetRangeString(),
+        *VideoFormat.GetPackingModeString(),
+        *VideoFormat.GetSenderTypeString());
 
     // Source filter (RFC 4570)
     SDP += FString::Printf(TEXT("a=source-filter: incl IN IP4 %s %s\r\n"),
@@ -396,9 +489,7 @@ void URship2110VideoSender::CaptureFrame()
         case ERship2110CaptureSource::RenderTarget:
             if (SourceRenderTarget)
             {
-                // Read render target
-                // TODO: Implement async readback
-                UE_LOG(LogRship2110, VeryVerbose, TEXT("VideoSender: Capturing from render target"));
+                EnqueueReadback(SourceRenderTarget->GameThread_GetRenderTargetResource(), FrameTimestamp);
             }
             break;
 
@@ -419,109 +510,138 @@ void URship2110VideoSender::CaptureFrame()
     LastFrameTime = FrameTimestamp;
 }
 
+bool URship2110VideoSender::EnqueueReadback(FTextureResource* Resource, const FRshipPTPTimestamp& Timestamp)
+{
+    if (!Resource || !ReadbackSource.IsValid())
+    {
+        return false;
+    }
+
+    const FIntPoint Size(VideoFormat.Width, VideoFormat.Height);
+    ENQUEUE_RENDER_COMMAND(Rship2110SenderReadback)(
+        [this, Resource, Size, Timestamp](FRHICommandListImmediate& RHICmdList)
+        {
+            // Free the slots of copies that have landed before taking another
+            PollReadbacks_RenderThread();
+
+            FRHITexture* Texture = Resource->TextureRHI;
+            Readback.Submit(Timestamp, [&](int32 Slot)
+            {
+                return ReadbackSource->EnqueueCopy(RHICmdList, Texture, Slot, Size);
+            });
+        });
+
+    return true;
+}
+
+void URship2110VideoSender::PollReadbacks_RenderThread()
+{
+    check(IsInRenderingThread());
+
+    Readback.Poll([this](int32 Slot, FRship2110FrameRef&& Frame)
+    {
+        FScopeLock Lock(&CompletedLock);
+        CompletedFrames.Add(MoveTemp(Frame));
+    });
+}
+
 void URship2110VideoSender::TransmitFrame()
 {
-    // Get current buffer
-    if (CurrentBufferIndex < 0 || CurrentBufferIndex >= FrameBuffers.Num())
+    // Collect readbacks that have landed; they are queued by the next Tick
+    if (ReadbackSource.IsValid())
     {
-        return;
+        ENQUEUE_RENDER_COMMAND(Rship2110SenderPollReadbacks)(
+            [this](FRHICommandListImmediate& RHICmdList)
+            {
+                PollReadbacks_RenderThread();
+            });
     }
 
-    FFrameBuffer& Buffer = FrameBuffers[CurrentBufferIndex];
-    if (!Buffer.Data || !Buffer.bInUse)
+    TArray<FRship2110FrameRef> Frames;
     {
-        return;
+        FScopeLock Lock(&CompletedLock);
+        Frames = MoveTemp(CompletedFrames);
+        CompletedFrames.Reset();
     }
 
-#if RSHIP_RIVERMAX_AVAILABLE
-    SendFrameViaRivermax(Buffer.Data, Buffer.Size, Buffer.Timestamp);
-#else
-    // Stub mode - simulate transmission
-    double CurrentTime = FPlatformTime::Seconds();
-    double FrameDuration = 1.0 / VideoFormat.GetFrameRateDecimal();
+    // Frames go to the transmit thread by reference; it releases them once sent
+    for (FRship2110FrameRef& Frame : Frames)
+    {
+        SendPooledFrame(MoveTemp(Frame));
+    }
+}
 
-    if (CurrentTime - LastSendTime >= FrameDuration)
+bool URship2110VideoSender::CreateTransmitThread()
+{
+    // Software transmit path; the socket falls back to FSocket if the platform one will not open
+    URship2110Settings* Settings = URship2110Settings::Get();
+    FRship2110TransmitOptions TransmitOptions;
+    if (Settings)
     {
-        Stats.FramesSent++;
-        Stats.BytesSent += Buffer.Size;
-        Stats.PacketsSent += CalculatePacketsPerFrame();
+        TransmitOptions.bSegmentationOffload = Settings->bUseSegmentationOffload;
+        TransmitOptions.bLaunchTime = Settings->bUseLaunchTime;
+    }
 
-        // Update RTP state
-        CurrentRTPTimestamp += PTPService ?
-            PTPService->GetRTPTimestampIncrement(
-                FFrameRate(VideoFormat.FrameRateNumerator, VideoFormat.FrameRateDenominator), 90000) :
-            static_cast<int32>(90000.0 / VideoFormat.GetFrameRateDecimal());
+    TransmitThread = MakeUnique<FRship2110TransmitThread>(FRship2110TransmitterFactory::CreateOpen(TransportParams, TransmitOptions));
+    if (!TransmitThread->Configure(VideoFormat, static_cast<uint8>(TransportParams.PayloadType), SSRC))
+    {
+        UE_LOG(LogRship2110, Error, TEXT("VideoSender: Format cannot be packetized as %s"),
+               *VideoFormat.GetPackingModeString());
+        TransmitThread.Reset();
+        return false;
+    }
 
-        LastSendTime = CurrentTime;
-        FrameCounter++;
+    if (!TransmitThread->GetTransmitter())
+    {
+        UE_LOG(LogRship2110, Warning, TEXT("VideoSender: No socket to %s:%d, frames will not be sent"),
+               *TransportParams.DestinationIP, TransportParams.DestinationPort);
     }
-#endif
 
-    // Move to next buffer
-    Buffer.bInUse = false;
-    CurrentBufferIndex = (CurrentBufferIndex + 1) % FrameBuffers.Num();
+    return true;
 }
 
 bool URship2110VideoSender::AllocateBuffers()
 {
-    int64 FrameSize = VideoFormat.GetFrameSizeBytes();
-
-    FrameBuffers.SetNum(NumFrameBuffers);
-    for (int32 i = 0; i < NumFrameBuffers; i++)
+    if (!PixelConverter.Configure(VideoFormat))
     {
-        if (Manager)
-        {
-            FrameBuffers[i].Data = Manager->AllocateStreamMemory(FrameSize, 4096);
-        }
-        else
-        {
-            FrameBuffers[i].Data = FMemory::Malloc(FrameSize, 4096);
-        }
-
-        if (!FrameBuffers[i].Data)
-        {
-            UE_LOG(LogRship2110, Error, TEXT("VideoSender: Failed to allocate buffer %d"), i);
-            FreeBuffers();
-            return false;
-        }
-
-        FrameBuffers[i].Size = FrameSize;
-        FrameBuffers[i].bInUse = false;
+        UE_LOG(LogRship2110, Warning, TEXT("VideoSender: %dx%d %s cannot be converted, pixel and texture submission disabled"),
+               VideoFormat.Width, VideoFormat.Height, *VideoFormat.GetSampling());
+        return true;
     }
 
-    // Allocate packet buffer
-    PacketBuffer.SetNumZeroed(CalculatePacketPayloadSize() + 64);  // Extra for headers
+    // Converted frames for SubmitFramePixels
+    PixelFramePool = FRship2110FramePool::Create(NumFrameBuffers, PixelConverter.GetFrameBytes());
 
-    // Allocate capture buffer if needed
-    CaptureBuffer.SetNumZeroed(VideoFormat.Width * VideoFormat.Height * 4);  // RGBA
+    // Readback ring for render targets and textures, with its own frames
+    ReadbackSource = MakeShared<FRship2110GPUReadbackSource, ESPMode::ThreadSafe>(NumReadbackSlots);
+    if (!Readback.Configure(ReadbackSource, VideoFormat, NumFrameBuffers))
+    {
+        ReadbackSource.Reset();
+    }
 
-    UE_LOG(LogRship2110, Log, TEXT("VideoSender: Allocated %d buffers, %lld bytes each"),
-           NumFrameBuffers, FrameSize);
+    UE_LOG(LogRship2110, Log, TEXT("VideoSender: Allocated %d frames, %lld bytes each, %d readback slots"),
+           NumFrameBuffers, PixelConverter.GetFrameBytes(), NumReadbackSlots);
 
     return true;
 }
 
 void URship2110VideoSender::FreeBuffers()
 {
-    for (FFrameBuffer& Buffer : FrameBuffers)
+    // Readbacks in flight reference the ring and this sender
+    if (ReadbackSource.IsValid())
     {
-        if (Buffer.Data)
-        {
-            if (Manager)
-            {
-                Manager->FreeStreamMemory(Buffer.Data);
-            }
-            else
-            {
-                FMemory::Free(Buffer.Data);
-            }
-            Buffer.Data = nullptr;
-        }
+        FlushRenderingCommands();
     }
-    FrameBuffers.Empty();
+    Readback.Reset();
+    ReadbackSource.Reset();
 
-    PacketBuffer.Empty();
-    CaptureBuffer.Empty();
+    {
+        FScopeLock Lock(&CompletedLock);
+        CompletedFrames.Empty();
+    }
+
+    // Frames still held by the transmit thread keep the pool alive until sent
+    PixelFramePool.Reset();
 }
 
 void URship2110VideoSender::SetState(ERship2110StreamState NewState)
@@ -535,39 +655,7 @@ void URship2110VideoSender::SetState(ERship2110StreamState NewState)
 
 int32 URship2110VideoSender::CalculatePacketsPerFrame() const
 {
-    // ST 2110-20 typically uses ~1400 byte payloads
-    int64 FrameSize = VideoFormat.GetFrameSizeBytes();
-    int32 PayloadSize = CalculatePacketPayloadSize();
-    return static_cast<int32>((FrameSize + PayloadSize - 1) / PayloadSize);
-}
-
-int32 URship2110VideoSender::CalculatePacketPayloadSize() const
-{
-    // Max payload size based on MTU (1500) minus headers
-    // IP(20) + UDP(8) + RTP(12) + ST2110 payload header(varies)
-    return 1400;
-}
-
-int32 URship2110VideoSender::CalculatePixelsPerPacket() const
-{
-    int32 PayloadSize = CalculatePacketPayloadSize();
-    int32 BitsPerPixel = 0;
-
-    switch (VideoFormat.ColorFormat)
-    {
-        case ERship2110ColorFormat::YCbCr_422:
-            BitsPerPixel = VideoFormat.GetBitDepthInt() * 2;
-            break;
-        case ERship2110ColorFormat::YCbCr_444:
-        case ERship2110ColorFormat::RGB_444:
-            BitsPerPixel = VideoFormat.GetBitDepthInt() * 3;
-            break;
-        case ERship2110ColorFormat::RGBA_4444:
-            BitsPerPixel = VideoFormat.GetBitDepthInt() * 4;
-            break;
-    }
-
-    return (PayloadSize * 8) / BitsPerPixel;
+    return TransmitThread ? TransmitThread->GetPacketizer().GetPacketsPerFrame() : 0;
 }
 
 void URship2110VideoSender::UpdateStatistics(int64 BytesSent, bool bLateFrame)
@@ -584,89 +672,6 @@ void URship2110VideoSender::UpdateStatistics(int64 BytesSent, bool bLateFrame)
     // TODO: Implement proper bitrate calculation
 }
 
-// Color space conversion helpers
-void URship2110VideoSender::ConvertRGBAToYCbCr422(const uint8* RGBAData, uint8* YCbCrData, int32 Width, int32 Height)
-{
-    // BT.709 coefficients
-    const float Kr = 0.2126f;
-    const float Kb = 0.0722f;
-    const float Kg = 1.0f - Kr - Kb;
-
-    for (int32 y = 0; y < Height; y++)
-    {
-        for (int32 x = 0; x < Width; x += 2)
-        {
-            int32 RGBAOffset = (y * Width + x) * 4;
-            int32 YCbCrOffset = (y * Width + x) * 2;
-
-            // First pixel
-            float R0 = RGBAData[RGBAOffset + 0] / 255.0f;
-            float G0 = RGBAData[RGBAOffset + 1] / 255.0f;
-            float B0 = RGBAData[RGBAOffset + 2] / 255.0f;
-
-            // Second pixel
-            float R1 = RGBAData[RGBAOffset + 4] / 255.0f;
-            float G1 = RGBAData[RGBAOffset + 5] / 255.0f;
-            float B1 = RGBAData[RGBAOffset + 6] / 255.0f;
-
-            // Calculate Y for both pixels
-            float Y0 = Kr * R0 + Kg * G0 + Kb * B0;
-            float Y1 = Kr * R1 + Kg * G1 + Kb * B1;
-
-            // Calculate Cb and Cr (averaged for 4:2:2)
-            float Cb = 0.5f * ((B0 - Y0) / (1.0f - Kb) + (B1 - Y1) / (1.0f - Kb));
-            float Cr = 0.5f * ((R0 - Y0) / (1.0f - Kr) + (R1 - Y1) / (1.0f - Kr));
-
-            // Scale to 10-bit range [64-940] for Y, [64-960] for C
-            int32 Y0_10 = FMath::Clamp(static_cast<int32>(Y0 * 876.0f + 64.0f), 64, 940);
-            int32 Y1_10 = FMath::Clamp(static_cast<int32>(Y1 * 876.0f + 64.0f), 64, 940);
-            int32 Cb_10 = FMath::Clamp(static_cast<int32>(Cb * 448.0f + 512.0f), 64, 960);
-            int32 Cr_10 = FMath::Clamp(static_cast<int32>(Cr * 448.0f + 512.0f), 64, 960);
-
-            // Pack into YCbCr 4:2:2 (Cb Y0 Cr Y1 pattern for 10-bit)
-            // TODO: Proper 10-bit packing
-            YCbCrData[YCbCrOffset + 0] = static_cast<uint8>(Cb_10 >> 2);
-            YCbCrData[YCbCrOffset + 1] = static_cast<uint8>(Y0_10 >> 2);
-            YCbCrData[YCbCrOffset + 2] = static_cast<uint8>(Cr_10 >> 2);
-            YCbCrData[YCbCrOffset + 3] = static_cast<uint8>(Y1_10 >> 2);
-        }
-    }
-}
-
-void URship2110VideoSender::ConvertRGBAToYCbCr444(const uint8* RGBAData, uint8* YCbCrData, int32 Width, int32 Height)
-{
-    // Similar to 422 but no chroma subsampling
-    const float Kr = 0.2126f;
-    const float Kb = 0.0722f;
-    const float Kg = 1.0f - Kr - Kb;
-
-    for (int32 y = 0; y < Height; y++)
-    {
-        for (int32 x = 0; x < Width; x++)
-        {
-            int32 RGBAOffset = (y * Width + x) * 4;
-            int32 YCbCrOffset = (y * Width + x) * 3;
-
-            float R = RGBAData[RGBAOffset + 0] / 255.0f;
-            float G = RGBAData[RGBAOffset + 1] / 255.0f;
-            float B = RGBAData[RGBAOffset + 2] / 255.0f;
-
-            float Y = Kr * R + Kg * G + Kb * B;
-            float Cb = (B - Y) / (1.0f - Kb) * 0.5f;
-            float Cr = (R - Y) / (1.0f - Kr) * 0.5f;
-
-            // Scale to 10-bit
-            int32 Y_10 = FMath::Clamp(static_cast<int32>(Y * 876.0f + 64.0f), 64, 940);
-            int32 Cb_10 = FMath::Clamp(static_cast<int32>(Cb * 448.0f + 512.0f), 64, 960);
-            int32 Cr_10 = FMath::Clamp(static_cast<int32>(Cr * 448.0f + 512.0f), 64, 960);
-
-            YCbCrData[YCbCrOffset + 0] = static_cast<uint8>(Y_10 >> 2);
-            YCbCrData[YCbCrOffset + 1] = static_cast<uint8>(Cb_10 >> 2);
-            YCbCrData[YCbCrOffset + 2] = static_cast<uint8>(Cr_10 >> 2);
-        }
-    }
-}
-
 #if RSHIP_RIVERMAX_AVAILABLE
 
 bool URship2110VideoSender::CreateRivermaxStream()
@@ -694,76 +699,75 @@ void URship2110VideoSender::DestroyRivermaxStream()
 bool URship2110VideoSender::SendFrameViaRivermax(const void* FrameData, int64 DataSize, const FRshipPTPTimestamp& Timestamp)
 {
     // TODO: Implement with actual Rivermax SDK 1.8+ chunk-based output API
-    // For now, fall back to UDP socket transmission
+    // For now, fall back to the software transmit path
 
     if (!RivermaxStream)
     {
         return false;
     }
 
-    // Pack frame into RTP packets and send
-    const uint8* DataPtr = static_cast<const uint8*>(FrameData);
-    int64 RemainingBytes = DataSize;
-    int32 PacketPayloadSize = CalculatePacketPayloadSize();
-
-    while (RemainingBytes > 0)
-    {
-        // Build RTP header
-        uint8 RTPHeader[12];
-        RTPHeader[0] = 0x80;  // Version 2, no padding, no extension, no CSRC
-        RTPHeader[1] = (RemainingBytes <= PacketPayloadSize) ? (0x80 | TransportParams.PayloadType) : TransportParams.PayloadType;
+    return SendFrameViaSoftware(FrameData, DataSize, Timestamp);
+}
 
-        // Sequence number
-        RTPHeader[2] = (CurrentSequenceNumber >> 8) & 0xFF;
-        RTPHeader[3] = CurrentSequenceNumber & 0xFF;
-        CurrentSequenceNumber++;
+#endif  // RSHIP_RIVERMAX_AVAILABLE
 
-        // RTP timestamp (from PTP)
-        uint32 RTPTimestamp = PTPService ?
-            static_cast<uint32>(PTPService->GetRTPTimestampForTime(Timestamp, 90000)) :
-            CurrentRTPTimestamp;
-        RTPHeader[4] = (RTPTimestamp >> 24) & 0xFF;
-        RTPHeader[5] = (RTPTimestamp >> 16) & 0xFF;
-        RTPHeader[6] = (RTPTimestamp >> 8) & 0xFF;
-        RTPHeader[7] = RTPTimestamp & 0xFF;
+bool URship2110VideoSender::SendFrameViaSoftware(const void* FrameData, int64 DataSize, const FRshipPTPTimestamp& Timestamp)
+{
+    const uint32 RTPTimestamp = GetRTPTimestampForFrame(Timestamp);
 
-        // SSRC
-        RTPHeader[8] = (SSRC >> 24) & 0xFF;
-        RTPHeader[9] = (SSRC >> 16) & 0xFF;
-        RTPHeader[10] = (SSRC >> 8) & 0xFF;
-        RTPHeader[11] = SSRC & 0xFF;
+    // Copied into a transmit slot; packetized and sent on the transmit thread
+    if (!TransmitThread || !TransmitThread->Enqueue(static_cast<const uint8*>(FrameData), DataSize, RTPTimestamp))
+    {
+        Stats.FramesDropped++;
+        return false;
+    }
 
-        int32 PayloadSize = FMath::Min(static_cast<int64>(PacketPayloadSize), RemainingBytes);
+    OnFrameEnqueued(RTPTimestamp, DataSize);
+    return true;
+}
 
-        // Build packet with header + payload
-        TArray<uint8> Packet;
-        Packet.Reserve(12 + PayloadSize);
-        Packet.Append(RTPHeader, 12);
-        Packet.Append(DataPtr, PayloadSize);
+bool URship2110VideoSender::SendPooledFrame(FRship2110FrameRef Frame)
+{
+#if RSHIP_RIVERMAX_AVAILABLE
+    // SendFrameViaRivermax forwards to the software path; match its gate
+    if (!RivermaxStream)
+    {
+        return false;
+    }
+#endif
 
-        // Send via UDP socket (fallback until Rivermax API is implemented)
-        SendPacket(Packet.GetData(), Packet.Num());
+    const uint32 RTPTimestamp = GetRTPTimestampForFrame(Frame.GetTimestamp());
+    const int64 DataSize = Frame.GetSize();
 
-        DataPtr += PayloadSize;
-        RemainingBytes -= PayloadSize;
-        Stats.PacketsSent++;
+    // Queued by reference; the transmit thread releases the frame once sent
+    if (!TransmitThread || !TransmitThread->Enqueue(MoveTemp(Frame), RTPTimestamp))
+    {
+        Stats.FramesDropped++;
+        return false;
     }
 
-    Stats.FramesSent++;
-    Stats.BytesSent += DataSize;
-
+    OnFrameEnqueued(RTPTimestamp, DataSize);
     return true;
 }
 
-#endif  // RSHIP_RIVERMAX_AVAILABLE
+uint32 URship2110VideoSender::GetRTPTimestampForFrame(const FRshipPTPTimestamp& Timestamp) const
+{
+    // RTP timestamp (from PTP)
+    return PTPService ?
+        static_cast<uint32>(PTPService->GetRTPTimestampForTime(Timestamp, 90000)) :
+        CurrentRTPTimestamp;
+}
 
-void URship2110VideoSender::SendPacket(const void* PacketData, int32 PacketSize)
+void URship2110VideoSender::OnFrameEnqueued(uint32 RTPTimestamp, int64 DataSize)
 {
-    if (!UDPSocket || !DestinationAddr.IsValid())
-    {
-        return;
-    }
+    const int32 PacketsPerFrame = CalculatePacketsPerFrame();
+    CurrentSequenceNumber += PacketsPerFrame;
+
+    Stats.FramesSent++;
+    Stats.PacketsSent += PacketsPerFrame;
+    Stats.BytesSent += DataSize;
+    Stats.LastRTPTimestamp = RTPTimestamp;
+    Stats.LastSequenceNumber = static_cast<uint16>(CurrentSequenceNumber - 1);
 
-    int32 BytesSent = 0;
-    UDPSocket->SendTo(static_cast<const uint8*>(PacketData), PacketSize, BytesSent, *DestinationAddr);
+    FrameQueuedEvent.Broadcast(RTPTimestamp);
 }
@@ -7,8 +7,12 @@
 #include "PTP/RshipPTPService.h"
 #include "Rivermax/RivermaxManager.h"
 #include "Rivermax/Rship2110VideoSender.h"
+#include "Rivermax/Rship2110AudioSender.h"
+#include "Rivermax/Rship2110AncSender.h"
+#include "Rivermax/Rship2110StreamReceiver.h"
 #include "IPMX/RshipIPMXService.h"
 #include "HAL/IConsoleManager.h"
+#include "Containers/Ticker.h"
 
 // ============================================================================
 // PTP COMMANDS
@@ -246,6 +250,109 @@ static FAutoConsoleCommand Rship2110StreamStopCmd(
         }
     }));
 
+/** Receivers started by rship.stream.validate, by stream ID */
+static TMap<FString, TSharedPtr<FRship2110StreamReceiver>> Rship2110ActiveValidations;
+
+static FAutoConsoleCommand Rship2110StreamValidateCmd(
+    TEXT("rship.stream.validate"),
+    TEXT("Receive a local stream and check it against ST 2110 - Usage: rship.stream.validate <stream_id> [seconds]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        if (Args.Num() < 1)
+        {
+            UE_LOG(LogRship2110, Log, TEXT("Usage: rship.stream.validate <stream_id> [seconds]"));
+            return;
+        }
+
+        URship2110Subsystem* Subsystem = GEngine ? GEngine->GetEngineSubsystem<URship2110Subsystem>() : nullptr;
+        if (!Subsystem)
+        {
+            UE_LOG(LogRship2110, Log, TEXT("2110 subsystem not available"));
+            return;
+        }
+
+        const FString StreamId = Args[0];
+        if (Rship2110ActiveValidations.Contains(StreamId))
+        {
+            UE_LOG(LogRship2110, Warning, TEXT("Already validating stream: %s"), *StreamId);
+            return;
+        }
+
+        FRship2110ReceiverConfig Config;
+        Config.bKeepMedia = false;
+        FRship2110TransportParams Transport;
+        if (URship2110VideoSender* VideoSender = Subsystem->GetVideoSender(StreamId))
+        {
+            Config.StreamType = ERship2110StreamType::Video_2110_20;
+            Config.VideoFormat = VideoSender->GetVideoFormat();
+            Transport = VideoSender->GetTransportParams();
+        }
+        else if (URship2110AudioSender* AudioSender = Subsystem->GetAudioSender(StreamId))
+        {
+            Config.StreamType = ERship2110StreamType::Audio_2110_30;
+            Config.AudioFormat = AudioSender->GetAudioFormat();
+            Transport = AudioSender->GetTransportParams();
+        }
+        else if (URship2110AncSender* AncSender = Subsystem->GetAncSender(StreamId))
+        {
+            if (!AncSender->GetVideoSender())
+            {
+                UE_LOG(LogRship2110, Warning, TEXT("ANC stream %s has no video stream to take its frame rate from"), *StreamId);
+                return;
+            }
+            Config.StreamType = ERship2110StreamType::Ancillary_2110_40;
+            Config.VideoFormat = AncSender->GetVideoSender()->GetVideoFormat();
+            Transport = AncSender->GetTransportParams();
+        }
+        else
+        {
+            UE_LOG(LogRship2110, Warning, TEXT("Stream not found: %s"), *StreamId);
+            return;
+        }
+        Config.PayloadType = Transport.PayloadType;
+
+        const float Seconds = Args.Num() > 1 ? FMath::Max(FCString::Atof(*Args[1]), 0.1f) : 5.0f;
+
+        TSharedPtr<FRship2110StreamReceiver> Receiver = MakeShared<FRship2110StreamReceiver>();
+        if (!Receiver->Open(Config, Transport.DestinationIP, Transport.DestinationPort, Transport.SourceIP) || !Receiver->Start())
+        {
+            UE_LOG(LogRship2110, Error, TEXT("Could not receive %s:%d"), *Transport.DestinationIP, Transport.DestinationPort);
+            return;
+        }
+        Rship2110ActiveValidations.Add(StreamId, Receiver);
+
+        UE_LOG(LogRship2110, Log, TEXT("Validating %s on %s:%d for %.1f s"), *StreamId, *Transport.DestinationIP,
+               Transport.DestinationPort, Seconds);
+
+        FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([StreamId](float)
+        {
+            TSharedPtr<FRship2110StreamReceiver> Finished;
+            if (!Rship2110ActiveValidations.RemoveAndCopyValue(StreamId, Finished))
+            {
+                return false;
+            }
+
+            Finished->Shutdown();
+            const FRship2110ValidationReport Report = Finished->GetReport();
+            const bool bPacingOk = Report.Pacing.FramesChecked == 0 || Report.Pacing.IsCompliant();
+            UE_LOG(LogRship2110, Log, TEXT("=== Validation: %s ==="), *StreamId);
+            UE_LOG(LogRship2110, Log, TEXT("  %s"), *Report.ToString());
+            if (Report.PacketsReceived == 0)
+            {
+                UE_LOG(LogRship2110, Warning, TEXT("  No packets received (is multicast loopback enabled?)"));
+            }
+            else if (Report.HasErrors() || !bPacingOk)
+            {
+                UE_LOG(LogRship2110, Warning, TEXT("  FAILED"));
+            }
+            else
+            {
+                UE_LOG(LogRship2110, Log, TEXT("  PASSED"));
+            }
+            return false;
+        }), Seconds);
+    }));
+
 // ============================================================================
 // IPMX COMMANDS
 // ============================================================================
@@ -372,6 +479,7 @@ static FAutoConsoleCommand Rship2110HelpCmd(
         UE_LOG(LogRship2110, Log, TEXT("  rship.stream.list      - List active streams"));
         UE_LOG(LogRship2110, Log, TEXT("  rship.stream.starttest - Start test 1080p60 stream"));
         UE_LOG(LogRship2110, Log, TEXT("  rship.stream.stop <id> - Stop stream by ID"));
+        UE_LOG(LogRship2110, Log, TEXT("  rship.stream.validate <id> [s] - Receive and check a stream"));
         UE_LOG(LogRship2110, Log, TEXT(""));
         UE_LOG(LogRship2110, Log, TEXT("IPMX Commands:"));
         UE_LOG(LogRship2110, Log, TEXT("  rship.ipmx.status          - Display IPMX status"));
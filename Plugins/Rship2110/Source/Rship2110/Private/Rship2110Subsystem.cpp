@@ -6,6 +6,8 @@
 #include "PTP/RshipPTPService.h"
 #include "Rivermax/RivermaxManager.h"
 #include "Rivermax/Rship2110VideoSender.h"
+#include "Rivermax/Rship2110AudioSender.h"
+#include "Rivermax/Rship2110AncSender.h"
 #include "IPMX/RshipIPMXService.h"
 #include "Capture/Rship2110VideoCapture.h"
 
@@ -61,6 +63,24 @@ void URship2110Subsystem::Deinitialize()
     bIsInitialized = false;
 
     // Shutdown in reverse order
+    for (const TPair<FString, URship2110AncSender*>& Pair : AncSenders)
+    {
+        if (Pair.Value)
+        {
+            Pair.Value->Shutdown();
+        }
+    }
+    AncSenders.Empty();
+
+    for (const TPair<FString, URship2110AudioSender*>& Pair : AudioSenders)
+    {
+        if (Pair.Value)
+        {
+            Pair.Value->Shutdown();
+        }
+    }
+    AudioSenders.Empty();
+
     if (VideoCapture)
     {
         VideoCapture->Shutdown();
@@ -207,6 +227,103 @@ URship2110VideoSender* URship2110Subsystem::GetVideoSender(const FString& Stream
     return RivermaxManager ? RivermaxManager->GetVideoSender(StreamId) : nullptr;
 }
 
+FString URship2110Subsystem::CreateAudioStream(
+    const FRship2110AudioFormat& AudioFormat,
+    const FRship2110TransportParams& TransportParams,
+    USoundSubmix* Submix)
+{
+    URship2110AudioSender* Sender = NewObject<URship2110AudioSender>(this);
+    if (!Sender->Initialize(PTPService, AudioFormat, TransportParams))
+    {
+        UE_LOG(LogRship2110, Error, TEXT("Rship2110Subsystem: Failed to initialize audio sender"));
+        return TEXT("");
+    }
+
+    const FString StreamId = FString::Printf(TEXT("audio_%d_%d"), ++AudioStreamCounter, FMath::Rand());
+    Sender->SetStreamId(StreamId);
+    Sender->OnStateChanged.AddDynamic(this, &URship2110Subsystem::OnStreamStateChangedInternal);
+    AudioSenders.Add(StreamId, Sender);
+
+    Sender->AttachToSubmix(Submix);
+    if (!Sender->StartStream())
+    {
+        DestroyAudioStream(StreamId);
+        return TEXT("");
+    }
+
+    return StreamId;
+}
+
+bool URship2110Subsystem::DestroyAudioStream(const FString& StreamId)
+{
+    URship2110AudioSender* Sender = nullptr;
+    if (!AudioSenders.RemoveAndCopyValue(StreamId, Sender) || !Sender)
+    {
+        UE_LOG(LogRship2110, Warning, TEXT("Rship2110Subsystem: Audio stream %s not found"), *StreamId);
+        return false;
+    }
+
+    Sender->Shutdown();
+    return true;
+}
+
+URship2110AudioSender* URship2110Subsystem::GetAudioSender(const FString& StreamId) const
+{
+    URship2110AudioSender* const* SenderPtr = AudioSenders.Find(StreamId);
+    return SenderPtr ? *SenderPtr : nullptr;
+}
+
+FString URship2110Subsystem::CreateAncStream(
+    const FString& VideoStreamId,
+    const FRship2110TransportParams& TransportParams)
+{
+    URship2110VideoSender* VideoSender = GetVideoSender(VideoStreamId);
+    if (!VideoSender)
+    {
+        UE_LOG(LogRship2110, Error, TEXT("Rship2110Subsystem: Video stream %s not found for ancillary data"), *VideoStreamId);
+        return TEXT("");
+    }
+
+    URship2110AncSender* Sender = NewObject<URship2110AncSender>(this);
+    if (!Sender->Initialize(VideoSender, TransportParams))
+    {
+        UE_LOG(LogRship2110, Error, TEXT("Rship2110Subsystem: Failed to initialize ancillary sender"));
+        return TEXT("");
+    }
+
+    const FString StreamId = FString::Printf(TEXT("anc_%d_%d"), ++AncStreamCounter, FMath::Rand());
+    Sender->SetStreamId(StreamId);
+    Sender->OnStateChanged.AddDynamic(this, &URship2110Subsystem::OnStreamStateChangedInternal);
+    AncSenders.Add(StreamId, Sender);
+
+    if (!Sender->StartStream())
+    {
+        DestroyAncStream(StreamId);
+        return TEXT("");
+    }
+
+    return StreamId;
+}
+
+bool URship2110Subsystem::DestroyAncStream(const FString& StreamId)
+{
+    URship2110AncSender* Sender = nullptr;
+    if (!AncSenders.RemoveAndCopyValue(StreamId, Sender) || !Sender)
+    {
+        UE_LOG(LogRship2110, Warning, TEXT("Rship2110Subsystem: Ancillary stream %s not found"), *StreamId);
+        return false;
+    }
+
+    Sender->Shutdown();
+    return true;
+}
+
+URship2110AncSender* URship2110Subsystem::GetAncSender(const FString& StreamId) const
+{
+    URship2110AncSender* const* SenderPtr = AncSenders.Find(StreamId);
+    return SenderPtr ? *SenderPtr : nullptr;
+}
+
 TArray<FString> URship2110Subsystem::GetActiveStreamIds() const
 {
     return RivermaxManager ? RivermaxManager->GetActiveStreamIds() : TArray<FString>();
@@ -338,6 +455,13 @@ void URship2110Subsystem::InitializeIPMXService()
     {
         IPMXService->OnStateChanged.AddDynamic(this, &URship2110Subsystem::OnIPMXStateChangedInternal);
         UE_LOG(LogRship2110, Log, TEXT("Rship2110Subsystem: IPMX service initialized"));
+
+        // Node and Connection APIs, so controllers can find and patch senders
+        URship2110Settings* Settings = URship2110Settings::Get();
+        if (Settings)
+        {
+            IPMXService->StartLocalAPIServer(Settings->IPMXNodeAPIPort, Settings->IPMXConnectionAPIPort);
+        }
     }
     else
     {
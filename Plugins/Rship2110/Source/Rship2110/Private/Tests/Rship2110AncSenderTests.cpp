@@ -0,0 +1,231 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "Rivermax/Rship2110AncPacketizer.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+namespace Rship2110AncSenderTests
+{
+    constexpr uint8 PayloadType = 100;
+    constexpr uint32 SSRC = 0x21104000;
+
+    FRship2110AncPacket MakePacket(uint8 DID, uint8 SDID, TArray<uint8> UserData)
+    {
+        FRship2110AncPacket Packet;
+        Packet.DID = DID;
+        Packet.SDID = SDID;
+        Packet.UserData = MoveTemp(UserData);
+        Packet.LineNumber = 9;
+        return Packet;
+    }
+
+    TArray<uint8> Encode(const FRship2110AncPacket& Packet)
+    {
+        TArray<uint8> Bytes;
+        Bytes.SetNumUninitialized(FRship2110AncPacketizer::GetEncodedSize(Packet));
+        FRship2110AncPacketizer::EncodeAncPacket(Packet, Bytes.GetData());
+        return Bytes;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110AncWordsTest,
+    "Rship.2110.Anc.Words",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110AncWordsTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110AncSenderTests;
+
+    // ST 291 parity: b8 even parity of b0-b7, b9 its inverse
+    TestEqual(TEXT("ATC DID"), static_cast<int32>(FRship2110AncPacketizer::AddParity(0x60)), 0x260);
+    TestEqual(TEXT("CDP DID"), static_cast<int32>(FRship2110AncPacketizer::AddParity(0x61)), 0x161);
+    TestEqual(TEXT("CDP SDID"), static_cast<int32>(FRship2110AncPacketizer::AddParity(0x01)), 0x101);
+    TestEqual(TEXT("SCTE-104 DID"), static_cast<int32>(FRship2110AncPacketizer::AddParity(0x41)), 0x241);
+    TestEqual(TEXT("SCTE-104 SDID"), static_cast<int32>(FRship2110AncPacketizer::AddParity(0x07)), 0x107);
+    TestEqual(TEXT("Zero"), static_cast<int32>(FRship2110AncPacketizer::AddParity(0x00)), 0x200);
+    TestEqual(TEXT("All ones"), static_cast<int32>(FRship2110AncPacketizer::AddParity(0xFF)), 0x2FF);
+
+    // Checksum: 0x041 + 0x107 + 0x101 + 0x108 = 0x251, nine bits 0x051, b9 = !b8
+    const uint16 Words[] = {0x241, 0x107, 0x101, 0x108};
+    TestEqual(TEXT("Checksum"), static_cast<int32>(FRship2110AncPacketizer::ComputeChecksum(Words)), 0x251);
+
+    // Reference encodings, bit-packed independently of the packetizer
+    const uint8 SCTE104Expected[] = {0x00, 0x9F, 0xFF, 0x00, 0x90, 0x50, 0x74, 0x05, 0x08, 0x54, 0x40, 0x00};
+    const TArray<uint8> SCTE104Bytes = Encode(MakePacket(0x41, 0x07, {0x08}));
+    TestEqual(TEXT("One UDW packs into 12 bytes"), SCTE104Bytes.Num(), 12);
+    TestTrue(TEXT("One UDW packet bits"), SCTE104Bytes.Num() == 12 && FMemory::Memcmp(SCTE104Bytes.GetData(), SCTE104Expected, 12) == 0);
+
+    FRship2110AncPacket Located = MakePacket(0x61, 0x01, {0x96, 0x69});
+    Located.LineNumber = 12;
+    Located.HorizontalOffset = 0;
+    Located.bColorDifference = true;
+    Located.StreamNum = 3;
+    const uint8 LocatedExpected[] = {0x80, 0xC0, 0x00, 0x83, 0x58, 0x50, 0x14, 0x0A, 0x96, 0x9A, 0x66, 0x30};
+    const TArray<uint8> LocatedBytes = Encode(Located);
+    TestTrue(TEXT("C, line, offset and stream bits"), LocatedBytes.Num() == 12 && FMemory::Memcmp(LocatedBytes.GetData(), LocatedExpected, 12) == 0);
+
+    // 4 header bytes + (4 + UDW count) words of 10 bits, rounded up to 32 bits
+    TestEqual(TEXT("No UDWs"), FRship2110AncPacketizer::GetEncodedSize(MakePacket(0x50, 0x01, {})), 12);
+    FRship2110AncPacket Largest = MakePacket(0x50, 0x01, {});
+    Largest.UserData.SetNumZeroed(255);
+    TestEqual(TEXT("255 UDWs"), FRship2110AncPacketizer::GetEncodedSize(Largest), 4 + 324);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110AncPayloadsTest,
+    "Rship.2110.Anc.Payloads",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110AncPayloadsTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110AncSenderTests;
+
+    // ATC: one timecode nibble per UDW in b4-b7, DBB1 in b3 of the first eight
+    const FTimecode Timecode(1, 2, 3, 4, true);
+    const FRship2110AncPacket ATC = FRship2110AncData::MakeTimecode(Timecode, FRship2110AncData::ETimecodeType::VITC1);
+    TestEqual(TEXT("ATC DID"), static_cast<int32>(ATC.DID), 0x60);
+    TestEqual(TEXT("ATC SDID"), static_cast<int32>(ATC.SDID), 0x60);
+    TestEqual(TEXT("ATC UDWs"), ATC.UserData.Num(), 16);
+    if (ATC.UserData.Num() == 16)
+    {
+        TestEqual(TEXT("Frame units, DBB1 bit 0"), static_cast<int32>(ATC.UserData[0]), 0x48);
+        TestEqual(TEXT("Frame tens with drop frame"), static_cast<int32>(ATC.UserData[2]), 0x40);
+        TestEqual(TEXT("Seconds units"), static_cast<int32>(ATC.UserData[4]), 0x30);
+        TestEqual(TEXT("Minutes units"), static_cast<int32>(ATC.UserData[8]), 0x20);
+        TestEqual(TEXT("Hours units"), static_cast<int32>(ATC.UserData[12]), 0x10);
+    }
+
+    FTimecode Parsed;
+    TestTrue(TEXT("ATC parses"), FRship2110AncData::ParseTimecode(ATC, Parsed));
+    TestTrue(TEXT("ATC round trip"), Parsed == Timecode);
+
+    // CEA-708 CDP at 29.97: 20 triplets, bytes sum to zero
+    const uint8 Triplets[] = {0xFC, 0x94, 0x20, 0xFC, 0xC1, 0xC2};
+    const FRship2110AncPacket CDP = FRship2110AncData::MakeCaptionCDP(Triplets, FFrameRate(30000, 1001), 0x1234);
+    TestEqual(TEXT("CDP DID"), static_cast<int32>(CDP.DID), 0x61);
+    TestEqual(TEXT("CDP SDID"), static_cast<int32>(CDP.SDID), 0x01);
+    TestEqual(TEXT("CDP length"), CDP.UserData.Num(), 13 + 3 * 20);
+    if (CDP.UserData.Num() == 13 + 3 * 20)
+    {
+        TestEqual(TEXT("cdp_identifier"), static_cast<int32>(CDP.UserData[0]), 0x96);
+        TestEqual(TEXT("cdp_length"), static_cast<int32>(CDP.UserData[2]), 73);
+        TestEqual(TEXT("29.97 rate code"), static_cast<int32>(CDP.UserData[3]), 0x4F);
+        TestEqual(TEXT("cc_count"), static_cast<int32>(CDP.UserData[8]), 0xE0 | 20);
+        TestEqual(TEXT("First triplet"), static_cast<int32>(CDP.UserData[9]), 0xFC);
+        TestEqual(TEXT("Padding triplet"), static_cast<int32>(CDP.UserData[15]), 0xFA);
+        TestEqual(TEXT("Footer"), static_cast<int32>(CDP.UserData[69]), 0x74);
+
+        uint8 Sum = 0;
+        for (uint8 Value : CDP.UserData)
+        {
+            Sum += Value;
+        }
+        TestEqual(TEXT("CDP checksum"), static_cast<int32>(Sum), 0);
+    }
+    TestEqual(TEXT("59.94 carries 10 triplets"), FRship2110AncData::GetCaptionTripletsPerFrame(FFrameRate(60000, 1001)), 10);
+    TestEqual(TEXT("25 carries 24 triplets"), FRship2110AncData::GetCaptionTripletsPerFrame(FFrameRate(25, 1)), 24);
+    TestEqual(TEXT("120 is not a caption rate"), FRship2110AncData::GetCaptionTripletsPerFrame(FFrameRate(120, 1)), 0);
+
+    // SCTE-104 splice_request_data
+    const TArray<uint8> Message = FRship2110AncData::MakeSpliceRequest(
+        FRship2110AncData::ESpliceInsertType::StartNormal, 0x01020304, 0x0506, 4000, 300, true, 7);
+    const uint8 MessageExpected[] = {
+        0xFF, 0xFF, 0x00, 0x1E, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x01,
+        0x01, 0x01, 0x00, 0x0E, 0x01, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x0F,
+        0xA0, 0x01, 0x2C, 0x00, 0x00, 0x01};
+    TestTrue(TEXT("Splice request bytes"), Message.Num() == 30 && FMemory::Memcmp(Message.GetData(), MessageExpected, 30) == 0);
+
+    const FRship2110AncPacket SCTE104 = FRship2110AncData::MakeSCTE104(Message);
+    TestEqual(TEXT("SCTE-104 DID"), static_cast<int32>(SCTE104.DID), 0x41);
+    TestEqual(TEXT("SCTE-104 SDID"), static_cast<int32>(SCTE104.SDID), 0x07);
+    TestEqual(TEXT("Payload descriptor"), static_cast<int32>(SCTE104.UserData.Num() > 0 ? SCTE104.UserData[0] : 0), 0x08);
+    TestEqual(TEXT("SCTE-104 UDWs"), SCTE104.UserData.Num(), 31);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110AncRoundTripTest,
+    "Rship.2110.Anc.RoundTrip",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110AncRoundTripTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110AncSenderTests;
+
+    TArray<FRship2110AncPacket> AncPackets;
+    AncPackets.Add(FRship2110AncData::MakeTimecode(FTimecode(10, 0, 0, 12, false)));
+    AncPackets.Add(FRship2110AncData::MakeCaptionCDP({}, FFrameRate(60, 1), 1));
+    AncPackets.Add(FRship2110AncData::MakeSCTE104(FRship2110AncData::MakeSpliceRequest(
+        FRship2110AncData::ESpliceInsertType::EndImmediate, 42, 0, 0, 0, false)));
+    FRship2110AncPacket Custom = MakePacket(0x51, 0x02, {});
+    Custom.UserData.SetNumUninitialized(255);
+    for (int32 Index = 0; Index < 255; ++Index)
+    {
+        Custom.UserData[Index] = static_cast<uint8>(Index * 37);
+    }
+    Custom.StreamNum = 1;
+    Custom.bColorDifference = true;
+    Custom.HorizontalOffset = 100;
+    AncPackets.Add(Custom);
+
+    // A small limit forces the frame across several RTP packets
+    FRship2110AncPacketizer Packetizer;
+    Packetizer.Configure(PayloadType, SSRC, 400);
+    Packetizer.SetExtendedSequenceNumber(0x0001FFFF);
+
+    const uint32 Timestamp = 0x89ABCDEF;
+    const TConstArrayView<FRship2110Packet> Packets = Packetizer.PacketizeFrame(AncPackets, Timestamp);
+    TestTrue(TEXT("Frame split across packets"), Packets.Num() >= 2);
+    TestEqual(TEXT("Nothing skipped"), Packetizer.GetSkippedCount(), static_cast<int64>(0));
+
+    FRship2110AncDepacketizer Depacketizer;
+    int32 Completed = 0;
+    for (int32 Index = 0; Index < Packets.Num(); ++Index)
+    {
+        const FRship2110Packet& Packet = Packets[Index];
+        TestTrue(TEXT("Packet fits the limit"), Packet.Size <= 400);
+        TestEqual(TEXT("Marker only on the last packet"), (Packet.Data[1] & 0x80) != 0, Index == Packets.Num() - 1);
+        TestEqual(TEXT("ESN carries the high sequence bits"), (static_cast<uint32>(Packet.Data[12]) << 8) | Packet.Data[13],
+                  (0x0001FFFFu + Index) >> 16);
+        Completed += Depacketizer.ReceivePacket(Packet.Data, Packet.Size) ? 1 : 0;
+    }
+
+    TestEqual(TEXT("One frame completed"), Completed, 1);
+    TestEqual(TEXT("Frame timestamp"), Depacketizer.GetFrameTimestamp(), Timestamp);
+    TestEqual(TEXT("No loss across the ESN wrap"), Depacketizer.GetStats().PacketsLost, static_cast<int64>(0));
+    TestEqual(TEXT("ANC packets received"), Depacketizer.GetFramePackets().Num(), AncPackets.Num());
+    for (int32 Index = 0; Index < FMath::Min(AncPackets.Num(), Depacketizer.GetFramePackets().Num()); ++Index)
+    {
+        TestTrue(FString::Printf(TEXT("ANC packet %d intact"), Index), Depacketizer.GetFramePackets()[Index] == AncPackets[Index]);
+    }
+
+    // An empty frame is still one packet, with the marker
+    const TConstArrayView<FRship2110Packet> Empty = Packetizer.PacketizeFrame({}, Timestamp + 1501);
+    TestEqual(TEXT("Empty frame is one packet"), Empty.Num(), 1);
+    TestEqual(TEXT("Empty packet size"), Empty.Num() == 1 ? Empty[0].Size : 0, 20);
+    TestTrue(TEXT("Empty frame completes"), Empty.Num() == 1 && Depacketizer.ReceivePacket(Empty[0].Data, Empty[0].Size));
+    TestEqual(TEXT("Empty frame has no ANC"), Depacketizer.GetFramePackets().Num(), 0);
+
+    // A flipped UDW bit fails parity and is dropped
+    const TConstArrayView<FRship2110Packet> Single = Packetizer.PacketizeFrame(MakeArrayView(&AncPackets[0], 1), Timestamp + 3003);
+    TArray<uint8> Corrupt(Single[0].Data, Single[0].Size);
+    Corrupt[20 + 8] ^= 0x04;
+    TestTrue(TEXT("Corrupt frame completes"), Depacketizer.ReceivePacket(Corrupt.GetData(), Corrupt.Num()));
+    TestEqual(TEXT("Corrupt packet dropped"), Depacketizer.GetFramePackets().Num(), 0);
+    TestEqual(TEXT("Parity error counted"), Depacketizer.GetStats().ParityErrors, static_cast<int64>(1));
+
+    // Invalid packets are skipped, not sent
+    FRship2110AncPacket Invalid = MakePacket(0x51, 0x02, {});
+    Invalid.LineNumber = 0x800;
+    Packetizer.PacketizeFrame(MakeArrayView(&Invalid, 1), Timestamp + 4504);
+    TestEqual(TEXT("Invalid packet skipped"), Packetizer.GetSkippedCount(), static_cast<int64>(1));
+
+    return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
@@ -0,0 +1,338 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "Rivermax/Rship2110AudioPacketizer.h"
+#include "Rivermax/Rship2110PacketTransmitter.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Rship2110LoopbackReceiver.h"
+
+namespace Rship2110AudioSenderTests
+{
+    constexpr uint8 PayloadType = 97;
+    constexpr uint32 SSRC = 0x2110A0D0;
+
+    FRship2110AudioFormat MakeFormat(int32 BitsPerSample, int32 NumChannels, int32 PacketTimeUs)
+    {
+        FRship2110AudioFormat Format;
+        Format.BitsPerSample = BitsPerSample;
+        Format.NumChannels = NumChannels;
+        Format.PacketTimeUs = PacketTimeUs;
+        return Format;
+    }
+
+    /** Test signal on the PCM grid, never zero so silence can be told apart */
+    int32 SignalPCM(int64 Frame, int32 Channel, int32 BitsPerSample)
+    {
+        const int32 FullScale = 1 << (BitsPerSample - 1);
+        const int32 Value = static_cast<int32>((Frame * 7919 + Channel * 104729) % (2 * FullScale - 2)) - (FullScale - 1);
+        return Value != 0 ? Value : 1;
+    }
+
+    /** Feed every queued datagram to the depacketizer; returns packets read */
+    int32 DrainPackets(FRship2110LoopbackReceiver& Receiver, FRship2110AudioDepacketizer& Depacketizer, TArray<uint32>& OutTimestamps)
+    {
+        return Receiver.Drain([&](const uint8* Data, int32 Size)
+        {
+            if (Depacketizer.ReceivePacket(Data, Size))
+            {
+                OutTimestamps.Add(Depacketizer.GetLastTimestamp());
+            }
+        });
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110AudioFormatTest,
+    "Rship.2110.Audio.Format",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110AudioFormatTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110AudioSenderTests;
+
+    TestEqual(TEXT("1 ms at 48 kHz"), MakeFormat(24, 2, 1000).GetSamplesPerPacket(), 48);
+    TestEqual(TEXT("125 us at 48 kHz"), MakeFormat(24, 2, 125).GetSamplesPerPacket(), 6);
+    TestEqual(TEXT("333 us at 48 kHz"), MakeFormat(24, 2, 333).GetSamplesPerPacket(), 16);
+    TestEqual(TEXT("L24 encoding"), MakeFormat(24, 2, 1000).GetEncodingName(), FString(TEXT("L24")));
+    TestEqual(TEXT("125 us ptime"), MakeFormat(24, 2, 125).GetPacketTimeString(), FString(TEXT("0.125")));
+
+    TestTrue(TEXT("L24 8 ch at 1 ms fits"), MakeFormat(24, 8, 1000).IsValid());
+    TestTrue(TEXT("L16 8 ch at 1 ms fits"), MakeFormat(16, 8, 1000).IsValid());
+    TestTrue(TEXT("L24 64 ch at 125 us fits"), MakeFormat(24, 64, 125).IsValid());
+    TestFalse(TEXT("L24 64 ch at 1 ms exceeds the payload"), MakeFormat(24, 64, 1000).IsValid());
+    TestFalse(TEXT("L24 16 ch at 1 ms exceeds the payload"), MakeFormat(24, 16, 1000).IsValid());
+    TestFalse(TEXT("32-bit samples rejected"), MakeFormat(32, 2, 1000).IsValid());
+
+    FRship2110AudioFormat Rate = MakeFormat(24, 2, 1000);
+    Rate.SampleRate = 44100;
+    TestFalse(TEXT("44.1 kHz rejected"), Rate.IsValid());
+
+    FRship2110AudioPacketizer Packetizer;
+    TestFalse(TEXT("Packetizer rejects an oversized format"), Packetizer.Configure(MakeFormat(24, 64, 1000), PayloadType, SSRC));
+
+    // Media clock counts from the PTP epoch
+    FRship2110VirtualPacingClock Clock;
+    TestEqual(TEXT("RTP timestamp at 1.5 s"), Clock.GetRTPTimestamp(1500000000ULL, 48000), 72000u);
+    TestEqual(TEXT("RTP timestamp wraps"), Clock.GetRTPTimestamp(100000ULL * 1000000000ULL, 48000),
+              static_cast<uint32>(4800000000ULL));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110AudioRoundTripTest,
+    "Rship.2110.Audio.RoundTrip",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110AudioRoundTripTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110AudioSenderTests;
+
+    const FRship2110AudioFormat Formats[] = {
+        MakeFormat(16, 2, 1000),
+        MakeFormat(24, 2, 1000),
+        MakeFormat(24, 8, 1000),
+        MakeFormat(16, 8, 125),
+        MakeFormat(24, 64, 125),
+    };
+
+    for (const FRship2110AudioFormat& Format : Formats)
+    {
+        const FString Name = FString::Printf(TEXT("%s/%d ch/%s ms"), *Format.GetEncodingName(), Format.NumChannels,
+                                             *Format.GetPacketTimeString());
+        constexpr int32 NumPackets = 5;
+        const int32 FramesPerPacket = Format.GetSamplesPerPacket();
+
+        FRship2110AudioPacketizer Packetizer;
+        FRship2110AudioDepacketizer Depacketizer;
+        if (!TestTrue(Name + TEXT(": configure"), Packetizer.Configure(Format, PayloadType, SSRC) && Depacketizer.Configure(Format)))
+        {
+            continue;
+        }
+        Packetizer.SetSequenceNumber(0xFFFE);
+
+        TArray<int32> Expected;
+        TArray<float> Samples;
+        Samples.SetNumUninitialized(FramesPerPacket * Format.NumChannels);
+        for (int32 PacketIndex = 0; PacketIndex < NumPackets; ++PacketIndex)
+        {
+            for (int32 Frame = 0; Frame < FramesPerPacket; ++Frame)
+            {
+                for (int32 Channel = 0; Channel < Format.NumChannels; ++Channel)
+                {
+                    const int32 Value = SignalPCM(PacketIndex * FramesPerPacket + Frame, Channel, Format.BitsPerSample);
+                    Samples[Frame * Format.NumChannels + Channel] = FRship2110AudioPacketizer::PCMToFloat(Value, Format.BitsPerSample);
+                    Expected.Add(Value);
+                }
+            }
+
+            const FRship2110Packet Packet = Packetizer.PacketizePacket(Samples.GetData(), 1000u + PacketIndex * FramesPerPacket);
+            TestEqual(Name + TEXT(": packet size"), Packet.Size, FRship2110AudioPacketizer::RTPHeaderSize + Format.GetPayloadBytes());
+            TestTrue(Name + TEXT(": payload within limit"), Packet.Size - FRship2110AudioPacketizer::RTPHeaderSize <= FRship2110AudioFormat::MaxPayloadBytes);
+            TestEqual(Name + TEXT(": payload type"), static_cast<int32>(Packet.Data[1]), static_cast<int32>(PayloadType));
+            Depacketizer.ReceivePacket(Packet.Data, Packet.Size);
+        }
+
+        TestEqual(Name + TEXT(": packets"), Depacketizer.GetStats().PacketsReceived, static_cast<int64>(NumPackets));
+        TestEqual(Name + TEXT(": no loss across the sequence wrap"), Depacketizer.GetStats().PacketsLost, static_cast<int64>(0));
+        TestEqual(Name + TEXT(": continuous timestamps"), Depacketizer.GetStats().TimestampJumps, static_cast<int64>(0));
+        TestTrue(Name + TEXT(": samples exact"), Depacketizer.GetSamples() == Expected);
+    }
+
+    // Out-of-range input clips rather than wrapping
+    TestEqual(TEXT("Clip high"), FRship2110AudioPacketizer::FloatToPCM(1.5f, 24), (1 << 23) - 1);
+    TestEqual(TEXT("Clip low"), FRship2110AudioPacketizer::FloatToPCM(-1.5f, 16), -(1 << 15));
+
+    // A gap in sequence numbers is loss, and the timestamp is expected to skip with it
+    const FRship2110AudioFormat Format = MakeFormat(24, 2, 1000);
+    FRship2110AudioPacketizer Packetizer;
+    FRship2110AudioDepacketizer Depacketizer;
+    Packetizer.Configure(Format, PayloadType, SSRC);
+    Depacketizer.Configure(Format);
+    TArray<float> Silence;
+    Silence.SetNumZeroed(Format.GetSamplesPerPacket() * Format.NumChannels);
+    for (int32 PacketIndex = 0; PacketIndex < 4; ++PacketIndex)
+    {
+        const FRship2110Packet Packet = Packetizer.PacketizePacket(Silence.GetData(), PacketIndex * 48u);
+        if (PacketIndex != 2)
+        {
+            Depacketizer.ReceivePacket(Packet.Data, Packet.Size);
+        }
+    }
+    TestEqual(TEXT("Lost packet counted"), Depacketizer.GetStats().PacketsLost, static_cast<int64>(1));
+    TestEqual(TEXT("Timestamp follows the loss"), Depacketizer.GetStats().TimestampJumps, static_cast<int64>(0));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110AudioRingTest,
+    "Rship.2110.Audio.Ring",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110AudioRingTest::RunTest(const FString& Parameters)
+{
+    FRship2110AudioRing Ring;
+    Ring.Configure(2, 100);
+    TestEqual(TEXT("Capacity rounds to a power of two"), Ring.GetCapacity(), 128);
+
+    // Four channels in, two kept
+    TArray<float> Input;
+    for (int32 Frame = 0; Frame < 100; ++Frame)
+    {
+        Input.Append({ float(Frame), float(-Frame), 99.0f, 99.0f });
+    }
+
+    TArray<float> Output;
+    Output.SetNumZeroed(128 * 2);
+    bool bMatch = true;
+    for (int32 Pass = 0; Pass < 5; ++Pass)
+    {
+        // 100 in, 100 out, so the read and write positions wrap
+        TestEqual(TEXT("Write"), Ring.Write(Input.GetData(), 100, 4), 100);
+        TestEqual(TEXT("Read"), Ring.Read(Output.GetData(), 128), 100);
+        for (int32 Frame = 0; Frame < 100; ++Frame)
+        {
+            bMatch &= Output[Frame * 2] == float(Frame) && Output[Frame * 2 + 1] == float(-Frame);
+        }
+    }
+    TestTrue(TEXT("Frames survive wrapping"), bMatch);
+
+    // One channel in, second channel silent
+    const float Mono[] = { 0.5f, 0.25f };
+    Ring.Write(Mono, 2, 1);
+    Ring.Read(Output.GetData(), 2);
+    TestTrue(TEXT("Missing channel is silent"), Output[0] == 0.5f && Output[1] == 0.0f && Output[2] == 0.25f && Output[3] == 0.0f);
+
+    // Overflow drops the excess
+    TestEqual(TEXT("Fill"), Ring.Write(Input.GetData(), 100, 4), 100);
+    TestEqual(TEXT("Overflow writes what fits"), Ring.Write(Input.GetData(), 100, 4), 28);
+    TestEqual(TEXT("Overflow counted"), Ring.GetDroppedFrames(), static_cast<int64>(72));
+    TestEqual(TEXT("Available"), Ring.GetAvailable(), 128);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110AudioLoopbackTest,
+    "Rship.2110.Audio.Loopback",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110AudioLoopbackTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110AudioSenderTests;
+
+    // Two bursts of signal with a stall between them long enough to drain the buffer
+    constexpr int32 FramesPerBurst = 9600;
+    constexpr double StallSeconds = 0.05;
+    constexpr int32 PrerollFrames = 240;
+
+    const FRship2110AudioFormat Format = MakeFormat(24, 4, 1000);
+
+    FRship2110LoopbackReceiver Receiver(TEXT("Rship2110AudioTest"), 8 * 1024 * 1024);
+    if (!Receiver.IsValid())
+    {
+        AddError(TEXT("Could not bind a loopback receiver"));
+        return false;
+    }
+
+    TUniquePtr<IRship2110PacketTransmitter> Transmitter = FRship2110TransmitterFactory::CreateOpen(Receiver.MakeParams(PayloadType, SSRC), FRship2110TransmitOptions());
+    if (!Transmitter)
+    {
+        AddError(TEXT("No transmitter opened"));
+        return false;
+    }
+
+    FRship2110AudioTransmitThread Thread(MoveTemp(Transmitter));
+    TestTrue(TEXT("Configure"), Thread.Configure(Format, PayloadType, SSRC, PrerollFrames));
+
+    FRship2110LocalPacingClock Clock;
+    if (!TestTrue(TEXT("Start"), Thread.Start(Clock, 0xFFF0)))
+    {
+        return false;
+    }
+
+    FRship2110AudioDepacketizer Depacketizer;
+    Depacketizer.Configure(Format);
+    TArray<uint32> Timestamps;
+
+    TArray<int32> Sent;
+    TArray<float> Chunk;
+    int64 NextFrame = 0;
+    for (int32 Burst = 0; Burst < 2; ++Burst)
+    {
+        int32 Remaining = FramesPerBurst;
+        while (Remaining > 0)
+        {
+            // Producer writes whatever fits, like an audio callback running ahead of the network
+            const int32 Frames = FMath::Min(Remaining, Thread.GetRing().GetCapacity() - Thread.GetRing().GetAvailable());
+            Chunk.SetNumUninitialized(Frames * Format.NumChannels, EAllowShrinking::No);
+            for (int32 Frame = 0; Frame < Frames; ++Frame)
+            {
+                for (int32 Channel = 0; Channel < Format.NumChannels; ++Channel)
+                {
+                    const int32 Value = SignalPCM(NextFrame + Frame, Channel, Format.BitsPerSample);
+                    Chunk[Frame * Format.NumChannels + Channel] = FRship2110AudioPacketizer::PCMToFloat(Value, Format.BitsPerSample);
+                    Sent.Add(Value);
+                }
+            }
+            Thread.GetRing().Write(Chunk.GetData(), Frames, Format.NumChannels);
+            NextFrame += Frames;
+            Remaining -= Frames;
+
+            DrainPackets(Receiver, Depacketizer, Timestamps);
+            FPlatformProcess::Sleep(0.001f);
+        }
+
+        // Stall past the buffered audio so the thread underruns
+        const double StallEnd = FPlatformTime::Seconds() + StallSeconds + Thread.GetRing().GetCapacity() / double(Format.SampleRate);
+        while (FPlatformTime::Seconds() < StallEnd)
+        {
+            DrainPackets(Receiver, Depacketizer, Timestamps);
+            FPlatformProcess::Sleep(0.001f);
+        }
+    }
+
+    Thread.Shutdown();
+    FPlatformProcess::Sleep(0.01f);
+    DrainPackets(Receiver, Depacketizer, Timestamps);
+
+    TestEqual(TEXT("Every packet sent was received"), Depacketizer.GetStats().PacketsReceived, Thread.GetPacketsSent());
+    TestEqual(TEXT("No packets lost across the sequence wrap"), Depacketizer.GetStats().PacketsLost, static_cast<int64>(0));
+    TestEqual(TEXT("No malformed packets"), Depacketizer.GetStats().PacketsMalformed, static_cast<int64>(0));
+    TestEqual(TEXT("Timestamps continuous across underruns"), Depacketizer.GetStats().TimestampJumps, static_cast<int64>(0));
+    TestTrue(TEXT("Underruns occurred"), Thread.GetUnderruns() >= 2);
+    TestEqual(TEXT("Nothing dropped by the ring"), Thread.GetRing().GetDroppedFrames(), static_cast<int64>(0));
+
+    if (Timestamps.Num() > 0)
+    {
+        TestEqual(TEXT("First packet on a packet-time boundary"), Timestamps[0] % Format.GetSamplesPerPacket(), 0u);
+    }
+
+    // Strip the silence; what is left must be the signal, sample for sample
+    const TArray<int32>& Received = Depacketizer.GetSamples();
+    TArray<int32> Signal;
+    for (int32 Frame = 0; Frame + Format.NumChannels <= Received.Num(); Frame += Format.NumChannels)
+    {
+        bool bSilent = true;
+        for (int32 Channel = 0; Channel < Format.NumChannels; ++Channel)
+        {
+            bSilent &= Received[Frame + Channel] == 0;
+        }
+        if (!bSilent)
+        {
+            Signal.Append(&Received[Frame], Format.NumChannels);
+        }
+    }
+
+    TestEqual(TEXT("All signal frames received"), Signal.Num(), Sent.Num());
+    TestTrue(TEXT("Signal reconstructed exactly"), Signal == Sent);
+
+    return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
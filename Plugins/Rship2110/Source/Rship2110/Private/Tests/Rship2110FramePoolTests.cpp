@@ -0,0 +1,586 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "Capture/Rship2110FramePool.h"
+#include "Rivermax/Rship2110PacketTransmitter.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "HAL/PlatformProcess.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Math/RandomStream.h"
+
+namespace Rship2110FramePoolTests
+{
+    /**
+     * Readback source with no GPU behind it. Issue() stands in for the copy:
+     * it fills a slot's BGRA pixels and says how many Tick() calls the copy
+     * takes to land. Lines are padded like a staging texture's row pitch.
+     */
+    class FFakeReadbackSource : public IRship2110ReadbackSource
+    {
+    public:
+        FFakeReadbackSource(int32 InNumSlots, int32 Width, int32 Height)
+            : Stride(Width * 4 + 64)
+        {
+            Slots.SetNum(InNumSlots);
+            for (FSlot& Slot : Slots)
+            {
+                Slot.Pixels.SetNumZeroed(Stride * Height);
+            }
+        }
+
+        /** Start a copy whose every channel byte is Value. A landed copy the ring dropped may be overwritten. */
+        bool Issue(int32 Slot, uint8 Value, int32 LatencyTicks)
+        {
+            if (bFailNextIssue)
+            {
+                bFailNextIssue = false;
+                return false;
+            }
+            if (!Slots.IsValidIndex(Slot) || Slots[Slot].bLocked || (Slots[Slot].bIssued && !IsReady(Slot)))
+            {
+                IssueErrors++;
+                return false;
+            }
+            FMemory::Memset(Slots[Slot].Pixels.GetData(), Value, Slots[Slot].Pixels.Num());
+            Slots[Slot].bIssued = true;
+            Slots[Slot].TicksLeft = LatencyTicks;
+            return true;
+        }
+
+        /** Let a frame's worth of GPU time pass */
+        void Tick()
+        {
+            for (FSlot& Slot : Slots)
+            {
+                Slot.TicksLeft = FMath::Max(Slot.TicksLeft - 1, 0);
+            }
+        }
+
+        /** Make the next Issue fail, as a copy from a mismatched texture would */
+        void FailNextIssue() { bFailNextIssue = true; }
+
+        int32 GetLocks() const { return Locks; }
+        int32 GetUnlocks() const { return Unlocks; }
+        int32 GetLockErrors() const { return LockErrors; }
+        int32 GetIssueErrors() const { return IssueErrors; }
+
+        virtual int32 GetNumSlots() const override { return Slots.Num(); }
+
+        virtual bool IsReady(int32 Slot) const override
+        {
+            return Slots[Slot].bIssued && Slots[Slot].TicksLeft == 0;
+        }
+
+        virtual const void* Lock(int32 Slot, int32& OutStride, ERship2110PixelInput& OutInput) override
+        {
+            if (!IsReady(Slot) || Slots[Slot].bLocked)
+            {
+                LockErrors++;
+                return nullptr;
+            }
+            Slots[Slot].bLocked = true;
+            Locks++;
+            OutStride = Stride;
+            OutInput = ERship2110PixelInput::BGRA8;
+            return Slots[Slot].Pixels.GetData();
+        }
+
+        virtual void Unlock(int32 Slot) override
+        {
+            Slots[Slot].bLocked = false;
+            Slots[Slot].bIssued = false;
+            Unlocks++;
+        }
+
+    private:
+        struct FSlot
+        {
+            TArray<uint8> Pixels;
+            bool bIssued = false;
+            bool bLocked = false;
+            int32 TicksLeft = 0;
+        };
+
+        TArray<FSlot> Slots;
+        int32 Stride = 0;
+        bool bFailNextIssue = false;
+        int32 Locks = 0;
+        int32 Unlocks = 0;
+        int32 LockErrors = 0;
+        int32 IssueErrors = 0;
+    };
+
+    FRship2110VideoFormat MakeFormat(int32 Width, int32 Height)
+    {
+        FRship2110VideoFormat Format;
+        Format.Width = Width;
+        Format.Height = Height;
+        Format.ColorFormat = ERship2110ColorFormat::YCbCr_422;
+        Format.BitDepth = ERship2110BitDepth::Bits_10;
+        Format.PackingMode = ERship2110PackingMode::GPM;
+        return Format;
+    }
+
+    FRshipPTPTimestamp MakeTimestamp(int32 Sequence)
+    {
+        FRshipPTPTimestamp Timestamp;
+        Timestamp.Seconds = 1000;
+        Timestamp.Nanoseconds = Sequence;
+        return Timestamp;
+    }
+
+    /** Check that every byte of a raw frame still holds its fill value */
+    bool IsFilledWith(const FRship2110FrameRef& Frame, uint8 Value)
+    {
+        const uint8* Data = Frame.GetData();
+        for (int64 i = 0; i < Frame.GetSize(); ++i)
+        {
+            if (Data[i] != Value)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Worker standing in for a packetizer: takes frames from the producer,
+     * holds a few for a while, shares some with a second holder and checks
+     * that nothing rewrote a frame it still referenced.
+     */
+    class FFrameConsumer : public FRunnable
+    {
+    public:
+        void Push(FRship2110FrameRef&& Frame)
+        {
+            FScopeLock Lock(&QueueLock);
+            Queue.Add(MoveTemp(Frame));
+        }
+
+        void Finish() { bFinished = true; }
+
+        int32 GetFramesConsumed() const { return FramesConsumed.load(); }
+        int32 GetCorruptFrames() const { return CorruptFrames.load(); }
+        int32 GetOutOfOrderFrames() const { return OutOfOrderFrames.load(); }
+
+        virtual uint32 Run() override
+        {
+            FRandomStream Random(2110);
+            TArray<FRship2110FrameRef> Held;
+            TArray<FRship2110FrameRef> Shared;
+            int32 LastSequence = -1;
+
+            for (;;)
+            {
+                TArray<FRship2110FrameRef> Incoming;
+                {
+                    FScopeLock Lock(&QueueLock);
+                    Incoming = MoveTemp(Queue);
+                    Queue.Reset();
+                }
+
+                if (Incoming.Num() == 0 && bFinished)
+                {
+                    break;
+                }
+
+                for (FRship2110FrameRef& Frame : Incoming)
+                {
+                    const int32 Sequence = Frame.GetTimestamp().Nanoseconds;
+                    OutOfOrderFrames += Sequence <= LastSequence ? 1 : 0;
+                    LastSequence = Sequence;
+                    CorruptFrames += IsFilledWith(Frame, static_cast<uint8>(Sequence)) ? 0 : 1;
+
+                    if (Random.RandHelper(4) == 0)
+                    {
+                        Shared.Add(Frame);
+                    }
+                    Held.Add(MoveTemp(Frame));
+                }
+
+                // Release in a scrambled order, re-checking each frame before it goes back
+                while (Held.Num() > 0 && (Held.Num() > 2 || Random.RandHelper(2) == 0))
+                {
+                    const int32 Index = Random.RandHelper(Held.Num());
+                    CorruptFrames += IsFilledWith(Held[Index], static_cast<uint8>(Held[Index].GetTimestamp().Nanoseconds)) ? 0 : 1;
+                    Held.RemoveAtSwap(Index);
+                    FramesConsumed++;
+                }
+                if (Shared.Num() > 1)
+                {
+                    Shared.RemoveAt(0);
+                }
+
+                FPlatformProcess::Sleep(Random.RandHelper(16) == 0 ? 0.0001f : 0.0f);
+            }
+
+            FramesConsumed += Held.Num();
+            return 0;
+        }
+
+    private:
+        TArray<FRship2110FrameRef> Queue;
+        FCriticalSection QueueLock;
+        std::atomic<bool> bFinished{false};
+        std::atomic<int32> FramesConsumed{0};
+        std::atomic<int32> CorruptFrames{0};
+        std::atomic<int32> OutOfOrderFrames{0};
+    };
+
+    /** Transmitter that decodes what it is given and can hold the thread in SendPackets */
+    class FCapturingTransmitter : public IRship2110PacketTransmitter
+    {
+    public:
+        explicit FCapturingTransmitter(const FRship2110VideoFormat& Format)
+        {
+            Depacketizer.Configure(Format);
+        }
+
+        virtual bool Open(const FRship2110TransportParams& Params, const FRship2110TransmitOptions& Options) override { bOpen = true; return true; }
+        virtual void Close() override { bOpen = false; }
+        virtual bool IsOpen() const override { return bOpen; }
+
+        virtual int32 SendPackets(TConstArrayView<FRship2110Packet> Packets, TConstArrayView<uint64> LaunchTimesNs = {}) override
+        {
+            while (bHold)
+            {
+                FPlatformProcess::Sleep(0.0001f);
+            }
+            for (const FRship2110Packet& Packet : Packets)
+            {
+                if (Depacketizer.ReceivePacket(Packet.Data, Packet.Size))
+                {
+                    Frames.Add(Depacketizer.GetFrame());
+                }
+            }
+            return Packets.Num();
+        }
+
+        virtual FRship2110TransmitCapabilities GetCapabilities() const override { return FRship2110TransmitCapabilities(); }
+        virtual FRship2110TransmitStats GetStats() const override { return FRship2110TransmitStats(); }
+        virtual FString GetName() const override { return TEXT("Capturing"); }
+
+        std::atomic<bool> bHold{false};
+        FRship2110VideoDepacketizer Depacketizer;
+        TArray<TArray<uint8>> Frames;
+
+    private:
+        bool bOpen = false;
+    };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110FramePoolAcquireReleaseTest,
+    "Rship.2110.FramePool.AcquireRelease",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110FramePoolAcquireReleaseTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110FramePoolTests;
+
+    FRship2110FramePoolPtr Pool = FRship2110FramePool::Create(3, 5000);
+    TestEqual(TEXT("Frames"), Pool->GetNumFrames(), 3);
+    TestEqual(TEXT("All free"), Pool->GetNumFree(), 3);
+
+    FRship2110FrameRef A = Pool->Acquire();
+    FRship2110FrameRef B = Pool->Acquire();
+    FRship2110FrameRef C = Pool->Acquire();
+    TestTrue(TEXT("Three frames acquired"), A.IsValid() && B.IsValid() && C.IsValid());
+    TestTrue(TEXT("Frames are distinct"), A.GetData() != B.GetData() && B.GetData() != C.GetData() && A.GetData() != C.GetData());
+    TestEqual(TEXT("Frames are page aligned"), static_cast<int32>(reinterpret_cast<UPTRINT>(A.GetData()) % 4096), 0);
+    TestTrue(TEXT("Frame size"), A.GetSize() == 5000);
+    TestEqual(TEXT("One reference each"), A.GetRefCount(), 1);
+
+    FRship2110FrameRef Exhausted = Pool->Acquire();
+    TestFalse(TEXT("Fourth acquire fails"), Exhausted.IsValid());
+    TestEqual(TEXT("Failure counted"), Pool->GetAcquireFailures(), static_cast<int64>(1));
+
+    // A copy keeps the frame out of the pool after the original goes
+    A.SetTimestamp(MakeTimestamp(7));
+    FMemory::Memset(A.GetData(), 0x5A, A.GetSize());
+    FRship2110FrameRef ACopy = A;
+    TestEqual(TEXT("Copy adds a reference"), ACopy.GetRefCount(), 2);
+    uint8* AData = A.GetData();
+    A.Release();
+    TestFalse(TEXT("Released handle is empty"), A.IsValid());
+    TestEqual(TEXT("Still held by the copy"), Pool->GetNumFree(), 0);
+    TestTrue(TEXT("Copy sees the same frame"), ACopy.GetData() == AData && IsFilledWith(ACopy, 0x5A));
+    TestEqual(TEXT("Copy sees the timestamp"), ACopy.GetTimestamp().Nanoseconds, 7);
+    ACopy.Release();
+    TestEqual(TEXT("Last release frees the frame"), Pool->GetNumFree(), 1);
+
+    // Moves transfer the reference without touching the count
+    FRship2110FrameRef BMoved = MoveTemp(B);
+    TestFalse(TEXT("Moved-from handle is empty"), B.IsValid());
+    TestEqual(TEXT("Move keeps one reference"), BMoved.GetRefCount(), 1);
+    BMoved = MoveTemp(C);
+    TestEqual(TEXT("Move assignment released the old frame"), Pool->GetNumFree(), 2);
+
+    // Self and same-frame assignment must not drop the last reference
+    FRship2110FrameRef& Alias = BMoved;
+    BMoved = Alias;
+    TestEqual(TEXT("Self assignment keeps the reference"), BMoved.GetRefCount(), 1);
+    FRship2110FrameRef Second = BMoved;
+    BMoved = Second;
+    TestEqual(TEXT("Same-frame assignment keeps both references"), Second.GetRefCount(), 2);
+    BMoved.Release();
+    Second.Release();
+    TestEqual(TEXT("All frames back"), Pool->GetNumFree(), 3);
+
+    // A new acquire starts with a clean timestamp
+    FRship2110FrameRef Reused = Pool->Acquire();
+    TestEqual(TEXT("Timestamp cleared on reuse"), Reused.GetTimestamp().Nanoseconds, 0);
+
+    // Frames outlive the pool owner's reference
+    Pool.Reset();
+    TestTrue(TEXT("Frame valid after the pool is dropped"), Reused.IsValid() && Reused.GetData() != nullptr);
+    FMemory::Memset(Reused.GetData(), 0xA5, Reused.GetSize());
+    TestTrue(TEXT("Frame still writable"), IsFilledWith(Reused, 0xA5));
+    Reused.Release();
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110FramePoolReadbackRingTest,
+    "Rship.2110.FramePool.ReadbackRing",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110FramePoolReadbackRingTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110FramePoolTests;
+
+    const FRship2110VideoFormat Format = MakeFormat(64, 8);
+    TSharedPtr<FFakeReadbackSource, ESPMode::ThreadSafe> Source = MakeShared<FFakeReadbackSource, ESPMode::ThreadSafe>(3, Format.Width, Format.Height);
+
+    FRship2110ReadbackRing Ring;
+    if (!TestTrue(TEXT("Configure"), Ring.Configure(Source, Format, 2)))
+    {
+        return false;
+    }
+
+    FRship2110PixelConverter Converter(Format);
+    TestTrue(TEXT("Frames are packed frames"), Ring.GetFrameBytes() == Converter.GetFrameBytes());
+
+    TArray<FRship2110FrameRef> Delivered;
+    auto Collect = [&Delivered](int32 Slot, FRship2110FrameRef&& Frame)
+    {
+        Delivered.Add(MoveTemp(Frame));
+    };
+
+    // Slot 0 lands after slot 1; frames still come out in submission order
+    TestTrue(TEXT("Submit 0"), Ring.Submit(MakeTimestamp(0), [&](int32 Slot) { return Source->Issue(Slot, 0x10, 2); }));
+    TestTrue(TEXT("Submit 1"), Ring.Submit(MakeTimestamp(1), [&](int32 Slot) { return Source->Issue(Slot, 0x80, 0); }));
+    TestEqual(TEXT("Nothing before the oldest lands"), Ring.Poll(Collect), 0);
+    Source->Tick();
+    TestEqual(TEXT("Still waiting on the oldest"), Ring.Poll(Collect), 0);
+    Source->Tick();
+    TestEqual(TEXT("Both delivered together"), Ring.Poll(Collect), 2);
+    TestEqual(TEXT("Nothing in flight"), Ring.GetNumInFlight(), 0);
+
+    if (TestEqual(TEXT("Two frames"), Delivered.Num(), 2))
+    {
+        TestEqual(TEXT("First frame is the first submitted"), Delivered[0].GetTimestamp().Nanoseconds, 0);
+        TestEqual(TEXT("Second frame is the second submitted"), Delivered[1].GetTimestamp().Nanoseconds, 1);
+
+        // Converted straight from the padded readback into the pooled frame
+        TArray<uint8> Pixels;
+        Pixels.Init(0x80, (Format.Width * 4 + 64) * Format.Height);
+        TArray<uint8> Expected;
+        Expected.SetNumUninitialized(static_cast<int32>(Converter.GetFrameBytes()));
+        Converter.ConvertFrame(Pixels.GetData(), ERship2110PixelInput::BGRA8, Format.Width * 4 + 64, Expected.GetData());
+        TestTrue(TEXT("Frame holds the converted readback"),
+                 FMemory::Memcmp(Delivered[1].GetData(), Expected.GetData(), Expected.Num()) == 0);
+    }
+
+    // Every slot in flight: the next submit is refused without issuing a copy
+    for (int32 i = 0; i < 3; ++i)
+    {
+        Ring.Submit(MakeTimestamp(2 + i), [&](int32 Slot) { return Source->Issue(Slot, 0x20, 1); });
+    }
+    bool bIssued = false;
+    TestFalse(TEXT("Ring full"), Ring.Submit(MakeTimestamp(5), [&](int32 Slot) { bIssued = true; return true; }));
+    TestFalse(TEXT("No copy issued when full"), bIssued);
+    TestEqual(TEXT("Ring-full drop counted"), Ring.GetRingFullDrops(), static_cast<int64>(1));
+
+    // Both pool frames are still held, so landed readbacks are dropped and their slots recycled
+    Source->Tick();
+    TestEqual(TEXT("Nothing delivered with the pool empty"), Ring.Poll(Collect), 0);
+    TestEqual(TEXT("Pool-empty drops counted"), Ring.GetPoolEmptyDrops(), static_cast<int64>(3));
+    TestEqual(TEXT("Slots recycled"), Ring.GetNumInFlight(), 0);
+
+    // Releasing a frame lets the next readback through
+    Delivered.Reset();
+    Source->FailNextIssue();
+    TestFalse(TEXT("Failed copy is not in flight"), Ring.Submit(MakeTimestamp(6), [&](int32 Slot) { return Source->Issue(Slot, 0x30, 0); }));
+    TestEqual(TEXT("Failed copy took no slot"), Ring.GetNumInFlight(), 0);
+    TestTrue(TEXT("Submit after release"), Ring.Submit(MakeTimestamp(7), [&](int32 Slot) { return Source->Issue(Slot, 0x30, 0); }));
+    TestEqual(TEXT("Delivered after release"), Ring.Poll(Collect), 1);
+
+    // A new pool size applies to new frames; the delivered one stays valid
+    Ring.SetPoolSize(5);
+    TestEqual(TEXT("New pool size"), Ring.GetPool()->GetNumFrames(), 5);
+    TestTrue(TEXT("Old frame still valid"), Delivered.Num() == 1 && Delivered[0].GetTimestamp().Nanoseconds == 7);
+
+    TestEqual(TEXT("Every lock unlocked"), Source->GetLocks(), Source->GetUnlocks());
+    TestEqual(TEXT("No bad locks"), Source->GetLockErrors(), 0);
+    TestEqual(TEXT("No copy issued into a slot in flight"), Source->GetIssueErrors(), 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110FramePoolStressTest,
+    "Rship.2110.FramePool.Stress",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110FramePoolStressTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110FramePoolTests;
+
+    // Raw frames, so each can be checked byte for byte against its fill value
+    const FRship2110VideoFormat Format = MakeFormat(128, 16);
+    constexpr int32 NumSlots = 4;
+    constexpr int32 NumFrames = 5;
+    constexpr int32 Iterations = 20000;
+
+    TSharedPtr<FFakeReadbackSource, ESPMode::ThreadSafe> Source = MakeShared<FFakeReadbackSource, ESPMode::ThreadSafe>(NumSlots, Format.Width, Format.Height);
+    FRship2110ReadbackRing Ring;
+    if (!TestTrue(TEXT("Configure"), Ring.Configure(Source, Format, NumFrames, false)))
+    {
+        return false;
+    }
+
+    FFrameConsumer Consumer;
+    FRunnableThread* Thread = FRunnableThread::Create(&Consumer, TEXT("Rship2110FramePoolConsumer"));
+    if (!TestNotNull(TEXT("Consumer thread"), Thread))
+    {
+        return false;
+    }
+
+    FRandomStream Random(45);
+    int32 Sequence = 0;
+    int64 Submitted = 0;
+    auto Deliver = [&Consumer](int32 Slot, FRship2110FrameRef&& Frame)
+    {
+        Consumer.Push(MoveTemp(Frame));
+    };
+
+    for (int32 i = 0; i < Iterations; ++i)
+    {
+        Source->Tick();
+        Ring.Poll(Deliver);
+
+        const int32 Latency = Random.RandHelper(4);
+        const uint8 Value = static_cast<uint8>(Sequence);
+        if (Ring.Submit(MakeTimestamp(Sequence), [&](int32 Slot) { return Source->Issue(Slot, Value, Latency); }))
+        {
+            Submitted++;
+            Sequence++;
+        }
+
+        // The pool changes size mid-stream; frames out keep their old pool
+        if (i == Iterations / 2)
+        {
+            Ring.SetPoolSize(NumFrames + 2);
+        }
+
+        // Give the consumer a moment when it holds everything, as a frame interval would
+        for (int32 Wait = 0; Wait < 50 && Ring.GetPool()->GetNumFree() == 0; ++Wait)
+        {
+            FPlatformProcess::Sleep(0.00002f);
+        }
+    }
+
+    // Land and deliver what is still in flight
+    while (Ring.GetNumInFlight() > 0)
+    {
+        Source->Tick();
+        Ring.Poll(Deliver);
+        FPlatformProcess::Sleep(0.0001f);
+    }
+
+    Consumer.Finish();
+    Thread->WaitForCompletion();
+    delete Thread;
+
+    TestTrue(TEXT("Most submits accepted"), Submitted > Iterations / 4);
+    TestTrue(FString::Printf(TEXT("Every submitted readback delivered or dropped (%lld + %lld of %lld)"),
+                             Ring.GetFramesCompleted(), Ring.GetPoolEmptyDrops(), Submitted),
+             Ring.GetFramesCompleted() + Ring.GetPoolEmptyDrops() == Submitted);
+    TestTrue(TEXT("Consumer saw every delivered frame"), static_cast<int64>(Consumer.GetFramesConsumed()) == Ring.GetFramesCompleted());
+    TestEqual(TEXT("No frame rewritten while referenced"), Consumer.GetCorruptFrames(), 0);
+    TestEqual(TEXT("Frames delivered in order"), Consumer.GetOutOfOrderFrames(), 0);
+    TestEqual(TEXT("Every frame back in the pool"), Ring.GetPool()->GetNumFree(), Ring.GetPool()->GetNumFrames());
+    TestEqual(TEXT("Every lock unlocked"), Source->GetLocks(), Source->GetUnlocks());
+    TestEqual(TEXT("No bad locks"), Source->GetLockErrors(), 0);
+    TestEqual(TEXT("No copy issued into a slot in flight"), Source->GetIssueErrors(), 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110FramePoolTransmitTest,
+    "Rship.2110.FramePool.Transmit",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110FramePoolTransmitTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110FramePoolTests;
+
+    const FRship2110VideoFormat Format = MakeFormat(320, 24);
+    TUniquePtr<FCapturingTransmitter> Owned = MakeUnique<FCapturingTransmitter>(Format);
+    FCapturingTransmitter* Transmitter = Owned.Get();
+    Transmitter->Open(FRship2110TransportParams(), FRship2110TransmitOptions());
+
+    FRship2110TransmitThread Thread(MoveTemp(Owned));
+    if (!TestTrue(TEXT("Configure"), Thread.Configure(Format, 96, 1, 3)))
+    {
+        return false;
+    }
+
+    FRship2110FramePoolPtr Pool = FRship2110FramePool::Create(5, Thread.GetPacketizer().GetFrameBytes());
+    TestFalse(TEXT("Refused before start"), Thread.Enqueue(Pool->Acquire(), 0));
+    TestEqual(TEXT("Refused frame released"), Pool->GetNumFree(), 5);
+
+    TestTrue(TEXT("Start"), Thread.Start(0));
+
+    // Hold the thread in its transmitter: three slots take three frames, the fourth is dropped
+    Transmitter->bHold = true;
+    int32 Queued = 0;
+    for (int32 i = 0; i < 4; ++i)
+    {
+        FRship2110FrameRef Frame = Pool->Acquire();
+        FMemory::Memset(Frame.GetData(), static_cast<uint8>(0x11 * (i + 1)), Frame.GetSize());
+        Queued += Thread.Enqueue(MoveTemp(Frame), i * 1500) ? 1 : 0;
+    }
+    TestEqual(TEXT("Three frames queued"), Queued, 3);
+    TestEqual(TEXT("Fourth dropped"), Thread.GetFramesDropped(), static_cast<int64>(1));
+    TestEqual(TEXT("Queued frames held by the thread"), Pool->GetNumFree(), 2);
+
+    Transmitter->bHold = false;
+    TestTrue(TEXT("Queue drained"), Thread.WaitUntilIdle(2.0));
+    Thread.Shutdown();
+
+    TestEqual(TEXT("Frames released once sent"), Pool->GetNumFree(), 5);
+    if (TestEqual(TEXT("Three frames received"), Transmitter->Frames.Num(), 3))
+    {
+        for (int32 i = 0; i < 3; ++i)
+        {
+            const TArray<uint8>& Received = Transmitter->Frames[i];
+            bool bMatches = Received.Num() == Thread.GetPacketizer().GetFrameBytes();
+            for (int32 Byte = 0; bMatches && Byte < Received.Num(); ++Byte)
+            {
+                bMatches = Received[Byte] == static_cast<uint8>(0x11 * (i + 1));
+            }
+            TestTrue(FString::Printf(TEXT("Frame %d sent from the pooled buffer"), i), bMatches);
+        }
+    }
+
+    return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
@@ -0,0 +1,106 @@
+// Copyright Rocketship. All Rights Reserved.
+// Loopback Receiver for Transmit Tests
+//
+// Receives what a sender under test puts on the wire, without leaving
+// the machine.
+//
+// Key features:
+// - Non-blocking UDP socket on 127.0.0.1, ephemeral port
+// - Caller-sized kernel receive queue
+// - Drains queued datagrams into any decoder
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IPAddress.h"
+#include "Rship2110Types.h"
+#include "SocketSubsystem.h"
+#include "Sockets.h"
+
+/** UDP socket on 127.0.0.1 with an ephemeral port */
+class FRship2110LoopbackReceiver
+{
+public:
+    /**
+     * @param SocketName Debug name of the socket
+     * @param ReceiveBufferBytes Requested kernel receive queue; deep enough to hold what the test sends between drains
+     */
+    FRship2110LoopbackReceiver(const TCHAR* SocketName, int32 ReceiveBufferBytes)
+    {
+        ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+        Socket = SocketSubsystem->CreateSocket(NAME_DGram, SocketName, false);
+        if (!Socket)
+        {
+            return;
+        }
+
+        int32 ActualSize = 0;
+        Socket->SetReceiveBufferSize(ReceiveBufferBytes, ActualSize);
+        Socket->SetNonBlocking(true);
+
+        TSharedRef<FInternetAddr> Addr = SocketSubsystem->CreateInternetAddr();
+        bool bIsValid = false;
+        Addr->SetIp(TEXT("127.0.0.1"), bIsValid);
+        Addr->SetPort(0);
+        if (!Socket->Bind(*Addr))
+        {
+            Close();
+            return;
+        }
+        Port = Socket->GetPortNo();
+    }
+
+    ~FRship2110LoopbackReceiver()
+    {
+        Close();
+    }
+
+    FRship2110LoopbackReceiver(const FRship2110LoopbackReceiver&) = delete;
+    FRship2110LoopbackReceiver& operator=(const FRship2110LoopbackReceiver&) = delete;
+
+    bool IsValid() const { return Socket != nullptr && Port != 0; }
+
+    /** Transport parameters that send to this receiver */
+    FRship2110TransportParams MakeParams(uint8 PayloadType, uint32 SSRC) const
+    {
+        FRship2110TransportParams Params;
+        Params.DestinationIP = TEXT("127.0.0.1");
+        Params.DestinationPort = Port;
+        Params.PayloadType = PayloadType;
+        Params.SSRC = SSRC;
+        return Params;
+    }
+
+    /**
+     * Hand every queued datagram to OnDatagram without blocking.
+     * @return Number of datagrams read
+     */
+    int32 Drain(TFunctionRef<void(const uint8* Data, int32 Size)> OnDatagram)
+    {
+        int32 Datagrams = 0;
+        int32 BytesRead = 0;
+        while (Socket->Recv(Buffer, sizeof(Buffer), BytesRead) && BytesRead > 0)
+        {
+            OnDatagram(Buffer, BytesRead);
+            Datagrams++;
+        }
+        return Datagrams;
+    }
+
+private:
+    void Close()
+    {
+        if (Socket)
+        {
+            Socket->Close();
+            ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+            Socket = nullptr;
+        }
+    }
+
+    FSocket* Socket = nullptr;
+    int32 Port = 0;
+
+    /** Largest UDP datagram */
+    uint8 Buffer[65536];
+};
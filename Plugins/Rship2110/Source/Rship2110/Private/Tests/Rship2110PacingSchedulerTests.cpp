@@ -0,0 +1,471 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "Rivermax/Rship2110PacingScheduler.h"
+#include "Rivermax/Rship2110PacketTransmitter.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "IPAddress.h"
+#include "Misc/ScopeExit.h"
+#include "SocketSubsystem.h"
+#include "Sockets.h"
+
+namespace Rship2110PacingSchedulerTests
+{
+    FRship2110VideoFormat MakeFormat(int32 Width, int32 Height, int32 RateNum, int32 RateDen, ERship2110SenderType SenderType)
+    {
+        FRship2110VideoFormat Format;
+        Format.Width = Width;
+        Format.Height = Height;
+        Format.FrameRateNumerator = RateNum;
+        Format.FrameRateDenominator = RateDen;
+        Format.SenderType = SenderType;
+        return Format;
+    }
+
+    int32 GetPacketsPerFrame(const FRship2110VideoFormat& Format)
+    {
+        FRship2110VideoPacketizer Packetizer;
+        Packetizer.Configure(Format, 96, 1);
+        return Packetizer.GetPacketsPerFrame();
+    }
+
+    /** Transmitter that claims launch-time support and records what it is given */
+    class FLaunchTimeTransmitter : public IRship2110PacketTransmitter
+    {
+    public:
+        virtual bool Open(const FRship2110TransportParams& Params, const FRship2110TransmitOptions& Options) override { return true; }
+        virtual void Close() override {}
+        virtual bool IsOpen() const override { return true; }
+
+        virtual int32 SendPackets(TConstArrayView<FRship2110Packet> Packets, TConstArrayView<uint64> LaunchTimesNs = {}) override
+        {
+            PacketsSent += Packets.Num();
+            LaunchTimes.Append(LaunchTimesNs.GetData(), LaunchTimesNs.Num());
+            return Packets.Num();
+        }
+
+        virtual FRship2110TransmitCapabilities GetCapabilities() const override
+        {
+            FRship2110TransmitCapabilities Capabilities;
+            Capabilities.bLaunchTime = true;
+            return Capabilities;
+        }
+
+        virtual bool GetLaunchClockNs(uint64& OutNs) const override
+        {
+            OutNs = LaunchClockNs;
+            return bHasLaunchClock;
+        }
+
+        virtual FRship2110TransmitStats GetStats() const override { return FRship2110TransmitStats(); }
+        virtual FString GetName() const override { return TEXT("LaunchTime"); }
+
+        bool bHasLaunchClock = true;
+        uint64 LaunchClockNs = 0;
+        int32 PacketsSent = 0;
+        TArray<uint64> LaunchTimes;
+    };
+
+    const TCHAR* Describe(ERship2110SenderType SenderType)
+    {
+        switch (SenderType)
+        {
+            case ERship2110SenderType::NarrowLinear: return TEXT("narrow linear");
+            case ERship2110SenderType::Wide: return TEXT("wide");
+            default: return TEXT("narrow gapped");
+        }
+    }
+
+    constexpr ERship2110SenderType SenderTypes[] =
+    {
+        ERship2110SenderType::NarrowGapped,
+        ERship2110SenderType::NarrowLinear,
+        ERship2110SenderType::Wide,
+    };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110PacingTimingTest,
+    "Rship.2110.Pacing.Timing",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110PacingTimingTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110PacingSchedulerTests;
+
+    const double FrameNs = 1e9 / 60.0;
+
+    // 1080p60 narrow gapped: active over 1080 of 1125 lines, first packet after 43 lines
+    FRship2110VideoFormat Format = MakeFormat(1920, 1080, 60, 1, ERship2110SenderType::NarrowGapped);
+    const int32 Packets = GetPacketsPerFrame(Format);
+    FRship2110PacingScheduler Scheduler;
+    TestTrue(TEXT("Configure 1080p60"), Scheduler.Configure(Format, Packets));
+    TestEqual(TEXT("Gapped RACTIVE"), Scheduler.GetRActive(), 1080.0 / 1125.0, 1e-12);
+    TestEqual(TEXT("Gapped TRS"), Scheduler.GetTRSNs(), FrameNs * 1080.0 / 1125.0 / Packets, 1e-6);
+    TestEqual(TEXT("Gapped TRoffset"), Scheduler.GetTROffsetNs(), FrameNs * 43.0 / 1125.0, 1e-6);
+    TestEqual(TEXT("TDRAIN"), Scheduler.GetTDrainNs(), FrameNs / Packets / 1.1, 1e-6);
+    TestEqual(TEXT("Narrow CMAX"), Scheduler.GetCMax(),
+              FMath::Max(4, static_cast<int32>(Packets / (43200.0 * (1080.0 / 1125.0) / 60.0))));
+    TestEqual(TEXT("Narrow VRX_FULL"), Scheduler.GetVRXFull(), FMath::Max(8, static_cast<int32>(Packets / (27000.0 / 60.0))));
+    TestEqual(TEXT("Narrow burst"), Scheduler.GetBurstPackets(), 1);
+
+    // Linear: whole frame from the boundary
+    Format.SenderType = ERship2110SenderType::NarrowLinear;
+    TestTrue(TEXT("Configure linear"), Scheduler.Configure(Format, Packets));
+    TestEqual(TEXT("Linear TRS"), Scheduler.GetTRSNs(), FrameNs / Packets, 1e-6);
+    TestEqual(TEXT("Linear TRoffset"), Scheduler.GetTROffsetNs(), 0.0);
+
+    // Wide: gapped spacing, bigger models, bursts of half the bucket
+    Format.SenderType = ERship2110SenderType::Wide;
+    TestTrue(TEXT("Configure wide"), Scheduler.Configure(Format, Packets));
+    TestEqual(TEXT("Wide TRS"), Scheduler.GetTRSNs(), FrameNs * 1080.0 / 1125.0 / Packets, 1e-6);
+    TestEqual(TEXT("Wide CMAX"), Scheduler.GetCMax(), 16);
+    TestEqual(TEXT("Wide VRX_FULL"), Scheduler.GetVRXFull(), FMath::Max(720, static_cast<int32>(Packets / (300.0 / 60.0))));
+    TestEqual(TEXT("Wide burst"), Scheduler.GetBurstPackets(), 8);
+
+    // 720p uses the 750-line raster
+    const FRship2110VideoFormat Format720 = MakeFormat(1280, 720, 50, 1, ERship2110SenderType::NarrowGapped);
+    TestTrue(TEXT("Configure 720p50"), Scheduler.Configure(Format720, GetPacketsPerFrame(Format720)));
+    TestEqual(TEXT("720p TRoffset"), Scheduler.GetTROffsetNs(), (1e9 / 50.0) * 28.0 / 750.0, 1e-6);
+
+    // 59.94 keeps the exact period; boundaries use the provider's whole-ns duration
+    const FRship2110VideoFormat Format5994 = MakeFormat(1920, 1080, 60000, 1001, ERship2110SenderType::NarrowGapped);
+    TestTrue(TEXT("Configure 1080p59.94"), Scheduler.Configure(Format5994, GetPacketsPerFrame(Format5994)));
+    TestEqual(TEXT("59.94 period"), Scheduler.GetFrameDurationNs(), 1e9 * 1001.0 / 60000.0, 1e-6);
+    TestEqual(TEXT("59.94 boundary duration"), Scheduler.GetBoundaryDurationNs(), Format5994.GetFrameDurationNs());
+
+    TestFalse(TEXT("Reject zero packets"), Scheduler.Configure(Format, 0));
+    TestFalse(TEXT("Rejected scheduler is invalid"), Scheduler.IsValid());
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110PacingAnchorTest,
+    "Rship.2110.Pacing.Anchor",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110PacingAnchorTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110PacingSchedulerTests;
+
+    for (const ERship2110SenderType SenderType : SenderTypes)
+    {
+        const FRship2110VideoFormat Format = MakeFormat(1920, 1080, 50, 1, SenderType);
+        FRship2110PacingScheduler Scheduler;
+        Scheduler.Configure(Format, GetPacketsPerFrame(Format));
+        const uint64 Duration = Scheduler.GetBoundaryDurationNs();
+        const FString Label = Describe(SenderType);
+
+        FRship2110VirtualPacingClock Clock(1000 * Duration + 12345);
+        TestEqual(Label + TEXT(": next boundary"), Scheduler.GetNextFrameStartNs(Clock), 1001 * Duration);
+        TestEqual(Label + TEXT(": frames queued early take later boundaries"), Scheduler.GetNextFrameStartNs(Clock), 1002 * Duration);
+
+        Clock.SetTimeNs(1010 * Duration);
+        TestEqual(Label + TEXT(": a frame on a boundary waits for the next"), Scheduler.GetNextFrameStartNs(Clock), 1011 * Duration);
+
+        const uint64 FrameStart = 1011 * Duration;
+        TArray<uint64> LaunchTimes;
+        Scheduler.ComputeLaunchTimes(FrameStart, LaunchTimes);
+        TestEqual(Label + TEXT(": one launch time per packet"), LaunchTimes.Num(), Scheduler.GetPacketsPerFrame());
+        TestEqual(Label + TEXT(": first packet at TRoffset"), LaunchTimes[0],
+                  FrameStart + static_cast<uint64>(FMath::RoundToDouble(Scheduler.GetTROffsetNs())));
+        TestTrue(Label + TEXT(": last packet inside the frame"), LaunchTimes.Last() < FrameStart + Duration);
+
+        bool bOrdered = true;
+        for (int32 i = 1; i < LaunchTimes.Num(); ++i)
+        {
+            const bool bBurstStart = (i % Scheduler.GetBurstPackets()) == 0;
+            if (bBurstStart ? LaunchTimes[i] <= LaunchTimes[i - 1] : LaunchTimes[i] != LaunchTimes[i - 1])
+            {
+                bOrdered = false;
+                break;
+            }
+        }
+        TestTrue(Label + TEXT(": packets advance once per burst"), bOrdered);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110PacingConformanceTest,
+    "Rship.2110.Pacing.Conformance",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110PacingConformanceTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110PacingSchedulerTests;
+
+    struct FRasterCase
+    {
+        int32 Width;
+        int32 Height;
+        int32 RateNum;
+        int32 RateDen;
+        ERship2110PackingMode PackingMode;
+    };
+    const FRasterCase Cases[] =
+    {
+        { 1920, 1080, 60, 1, ERship2110PackingMode::GPM },
+        { 1920, 1080, 60000, 1001, ERship2110PackingMode::BPM },
+        { 3840, 2160, 50, 1, ERship2110PackingMode::GPM },
+        { 1280, 720, 60, 1, ERship2110PackingMode::BPM },
+        { 256, 64, 30, 1, ERship2110PackingMode::GPM },
+    };
+
+    for (const FRasterCase& Case : Cases)
+    {
+        for (const ERship2110SenderType SenderType : SenderTypes)
+        {
+            FRship2110VideoFormat Format = MakeFormat(Case.Width, Case.Height, Case.RateNum, Case.RateDen, SenderType);
+            Format.PackingMode = Case.PackingMode;
+
+            FRship2110PacingScheduler Scheduler;
+            Scheduler.Configure(Format, GetPacketsPerFrame(Format));
+            FRship2110PacingChecker Checker;
+            Checker.Configure(Scheduler);
+
+            FRship2110VirtualPacingClock Clock(5000000000ULL);
+            TArray<uint64> LaunchTimes;
+            for (int32 Frame = 0; Frame < 4; ++Frame)
+            {
+                const uint64 FrameStart = Scheduler.GetNextFrameStartNs(Clock);
+                Scheduler.ComputeLaunchTimes(FrameStart, LaunchTimes);
+                Checker.AddFrame(FrameStart, LaunchTimes);
+            }
+
+            const FRship2110PacingReport& Report = Checker.GetReport();
+            const FString Label = FString::Printf(TEXT("%dx%d@%d/%d %s %s"), Case.Width, Case.Height, Case.RateNum,
+                                                  Case.RateDen, *Format.GetPackingModeString(), Describe(SenderType));
+            TestTrue(Label + FString::Printf(TEXT(": CINST %d <= CMAX %d"), Report.CInstMax, Report.CMax), Report.CInstMax <= Report.CMax);
+            TestTrue(Label + FString::Printf(TEXT(": VRX %d <= VRX_FULL %d"), Report.VRXMax, Report.VRXFull), Report.VRXMax <= Report.VRXFull);
+            TestEqual(Label + TEXT(": late packets"), Report.LatePackets, static_cast<int64>(0));
+            TestEqual(Label + TEXT(": packets checked"), Report.PacketsChecked, static_cast<int64>(4) * Scheduler.GetPacketsPerFrame());
+            TestTrue(Label + TEXT(": compliant"), Report.IsCompliant());
+        }
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110PacingViolationTest,
+    "Rship.2110.Pacing.Violation",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110PacingViolationTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110PacingSchedulerTests;
+
+    const FRship2110VideoFormat Format = MakeFormat(1920, 1080, 60, 1, ERship2110SenderType::NarrowGapped);
+    FRship2110PacingScheduler Scheduler;
+    Scheduler.Configure(Format, GetPacketsPerFrame(Format));
+    const uint64 FrameStart = 1000 * Scheduler.GetBoundaryDurationNs();
+
+    FRship2110PacingChecker Checker;
+    Checker.Configure(Scheduler);
+
+    // Unpaced: the whole frame at line rate as soon as it is ready
+    TArray<uint64> Times;
+    Times.Init(FrameStart, Scheduler.GetPacketsPerFrame());
+    Checker.AddFrame(FrameStart, Times);
+    TestTrue(TEXT("Unpaced frame overflows CMAX"), Checker.GetReport().CInstMax > Checker.GetReport().CMax);
+    TestTrue(TEXT("Unpaced frame overflows VRX_FULL"), Checker.GetReport().VRXMax > Checker.GetReport().VRXFull);
+    TestFalse(TEXT("Unpaced frame is not compliant"), Checker.GetReport().IsCompliant());
+
+    // On schedule but a few packets behind
+    Checker.Reset();
+    Scheduler.ComputeLaunchTimes(FrameStart, Times);
+    const uint64 DelayNs = static_cast<uint64>(Scheduler.GetTRSNs() * 4);
+    for (uint64& Time : Times)
+    {
+        Time += DelayNs;
+    }
+    Checker.AddFrame(FrameStart, Times);
+    TestEqual(TEXT("Delayed frame is late throughout"), Checker.GetReport().LatePackets, static_cast<int64>(Times.Num()));
+    TestTrue(TEXT("Delayed frame keeps the bucket"), Checker.GetReport().CInstMax <= Checker.GetReport().CMax);
+
+    // A linear schedule checked against the gapped receiver runs late
+    FRship2110VideoFormat LinearFormat = Format;
+    LinearFormat.SenderType = ERship2110SenderType::NarrowLinear;
+    FRship2110PacingScheduler Linear;
+    Linear.Configure(LinearFormat, Scheduler.GetPacketsPerFrame());
+    Linear.ComputeLaunchTimes(FrameStart, Times);
+    Checker.Reset();
+    Checker.AddFrame(FrameStart, Times);
+    TestTrue(TEXT("Linear timing fails the gapped receiver"), Checker.GetReport().LatePackets > 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110PacingTransmitTest,
+    "Rship.2110.Pacing.Transmit",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110PacingTransmitTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110PacingSchedulerTests;
+
+    ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+    FSocket* Receiver = SocketSubsystem->CreateSocket(NAME_DGram, TEXT("Rship2110PacingTest"), false);
+    if (!Receiver)
+    {
+        AddError(TEXT("Could not create a receiver"));
+        return false;
+    }
+    ON_SCOPE_EXIT
+    {
+        Receiver->Close();
+        SocketSubsystem->DestroySocket(Receiver);
+    };
+
+    TSharedRef<FInternetAddr> Addr = SocketSubsystem->CreateInternetAddr();
+    bool bIsValid = false;
+    Addr->SetIp(TEXT("127.0.0.1"), bIsValid);
+    Addr->SetPort(0);
+    int32 ActualSize = 0;
+    Receiver->SetReceiveBufferSize(4 * 1024 * 1024, ActualSize);
+    Receiver->SetNonBlocking(true);
+    if (!Receiver->Bind(*Addr))
+    {
+        AddError(TEXT("Could not bind a receiver"));
+        return false;
+    }
+
+    FRship2110TransportParams Params;
+    Params.DestinationIP = TEXT("127.0.0.1");
+    Params.DestinationPort = Receiver->GetPortNo();
+
+    // Fallback transmitter: no launch-time support, so the thread paces in software
+    const FRship2110VideoFormat Format = MakeFormat(256, 64, 30, 1, ERship2110SenderType::NarrowLinear);
+    TUniquePtr<IRship2110PacketTransmitter> Transmitter = FRship2110TransmitterFactory::CreateFallback();
+    if (!Transmitter->Open(Params, FRship2110TransmitOptions()))
+    {
+        AddError(TEXT("Fallback transmitter did not open"));
+        return false;
+    }
+
+    FRship2110TransmitThread Thread(MoveTemp(Transmitter));
+    Thread.Configure(Format, 96, 1);
+
+    // The thread maps the clock onto its own when the frame is queued, so any epoch works
+    FRship2110VirtualPacingClock Clock(5000000000ULL);
+    Thread.SetPacingClock(&Clock);
+    Thread.Start(0);
+
+    TArray<uint8> Frame;
+    Frame.SetNumZeroed(static_cast<int32>(Thread.GetPacketizer().GetFrameBytes()));
+    TestTrue(TEXT("Frame queued"), Thread.Enqueue(Frame.GetData(), Frame.Num(), 0));
+
+    const int32 Packets = Thread.GetPacketizer().GetPacketsPerFrame();
+    double FirstArrival = 0.0;
+    double LastArrival = 0.0;
+    int32 Received = 0;
+    uint8 Buffer[2048];
+    const double Deadline = FPlatformTime::Seconds() + 2.0;
+    while (Received < Packets && FPlatformTime::Seconds() < Deadline)
+    {
+        int32 BytesRead = 0;
+        if (Receiver->Recv(Buffer, sizeof(Buffer), BytesRead) && BytesRead > 0)
+        {
+            LastArrival = FPlatformTime::Seconds();
+            FirstArrival = Received == 0 ? LastArrival : FirstArrival;
+            Received++;
+        }
+        else
+        {
+            FPlatformProcess::Sleep(0.0001f);
+        }
+    }
+
+    Thread.WaitUntilIdle(1.0);
+    Thread.Shutdown();
+
+    TestEqual(TEXT("Packets received"), Received, Packets);
+
+    // Paced sends can only be late, so the frame spreads over nearly its planned
+    // span; unpaced, it would arrive within a fraction of a millisecond
+    const double PlannedSeconds = Thread.GetPacing().GetTRSNs() * (Packets - 1) * 1e-9;
+    TestTrue(FString::Printf(TEXT("Frame spread over %.1f ms of a planned %.1f ms"),
+                             (LastArrival - FirstArrival) * 1e3, PlannedSeconds * 1e3),
+             LastArrival - FirstArrival > PlannedSeconds * 0.5);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110PacingLaunchClockTest,
+    "Rship.2110.Pacing.LaunchClock",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110PacingLaunchClockTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110PacingSchedulerTests;
+
+    const FRship2110VideoFormat Format = MakeFormat(256, 64, 30, 1, ERship2110SenderType::NarrowGapped);
+    const uint64 PTPNowNs = 5000000000ULL;
+
+    // PTP time and the transmitter's launch clock are 37 s plus a bit apart
+    {
+        TUniquePtr<FLaunchTimeTransmitter> Owned = MakeUnique<FLaunchTimeTransmitter>();
+        FLaunchTimeTransmitter* Transmitter = Owned.Get();
+        Transmitter->LaunchClockNs = PTPNowNs + 37000000123ULL;
+
+        FRship2110TransmitThread Thread(MoveTemp(Owned));
+        Thread.Configure(Format, 96, 1);
+        FRship2110VirtualPacingClock Clock(PTPNowNs);
+        Thread.SetPacingClock(&Clock);
+
+        FRship2110PacingScheduler Expected = Thread.GetPacing();
+        TArray<uint64> ExpectedTimes;
+        Expected.ComputeLaunchTimes(Expected.GetNextFrameStartNs(Clock), ExpectedTimes);
+
+        Thread.Start(0);
+        TArray<uint8> Frame;
+        Frame.SetNumZeroed(static_cast<int32>(Thread.GetPacketizer().GetFrameBytes()));
+        TestTrue(TEXT("Frame queued"), Thread.Enqueue(Frame.GetData(), Frame.Num(), 0));
+        TestTrue(TEXT("Frame sent"), Thread.WaitUntilIdle(1.0));
+        Thread.Shutdown();
+
+        TestEqual(TEXT("Every packet has a launch time"), Transmitter->LaunchTimes.Num(), ExpectedTimes.Num());
+        if (Transmitter->LaunchTimes.Num() == ExpectedTimes.Num() && ExpectedTimes.Num() > 0)
+        {
+            TestTrue(TEXT("First launch time is on the launch clock"),
+                     Transmitter->LaunchTimes[0] == ExpectedTimes[0] + 37000000123ULL);
+            TestTrue(TEXT("Last launch time is on the launch clock"),
+                     Transmitter->LaunchTimes.Last() == ExpectedTimes.Last() + 37000000123ULL);
+        }
+    }
+
+    // Without a readable launch clock the thread paces the frame itself
+    {
+        TUniquePtr<FLaunchTimeTransmitter> Owned = MakeUnique<FLaunchTimeTransmitter>();
+        FLaunchTimeTransmitter* Transmitter = Owned.Get();
+        Transmitter->bHasLaunchClock = false;
+
+        FRship2110TransmitThread Thread(MoveTemp(Owned));
+        Thread.Configure(Format, 96, 1);
+        FRship2110VirtualPacingClock Clock(PTPNowNs);
+        Thread.SetPacingClock(&Clock);
+        Thread.Start(0);
+
+        TArray<uint8> Frame;
+        Frame.SetNumZeroed(static_cast<int32>(Thread.GetPacketizer().GetFrameBytes()));
+        TestTrue(TEXT("Frame queued"), Thread.Enqueue(Frame.GetData(), Frame.Num(), 0));
+        TestTrue(TEXT("Frame sent"), Thread.WaitUntilIdle(1.0));
+        Thread.Shutdown();
+
+        TestEqual(TEXT("Every packet sent"), Transmitter->PacketsSent, Thread.GetPacketizer().GetPacketsPerFrame());
+        TestEqual(TEXT("No launch times passed on"), Transmitter->LaunchTimes.Num(), 0);
+    }
+
+    return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
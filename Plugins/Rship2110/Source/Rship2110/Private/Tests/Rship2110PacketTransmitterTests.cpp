@@ -0,0 +1,271 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "Rivermax/Rship2110PacketTransmitter.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Rship2110LoopbackReceiver.h"
+
+#if PLATFORM_LINUX
+#include <time.h>
+#endif
+
+namespace Rship2110PacketTransmitterTests
+{
+    constexpr uint8 PayloadType = 96;
+    constexpr uint32 SSRC = 0x2110FEED;
+
+    /** Feed every queued datagram to the depacketizer; returns frames it closed */
+    int32 DrainFrames(FRship2110LoopbackReceiver& Receiver, FRship2110VideoDepacketizer& Depacketizer, TFunctionRef<void()> OnFrame)
+    {
+        int32 Frames = 0;
+        Receiver.Drain([&](const uint8* Data, int32 Size)
+        {
+            if (Depacketizer.ReceivePacket(Data, Size))
+            {
+                OnFrame();
+                Frames++;
+            }
+        });
+        return Frames;
+    }
+
+    FRship2110VideoFormat MakeFormat(int32 Width, int32 Height)
+    {
+        FRship2110VideoFormat Format;
+        Format.Width = Width;
+        Format.Height = Height;
+        Format.ColorFormat = ERship2110ColorFormat::YCbCr_422;
+        Format.BitDepth = ERship2110BitDepth::Bits_10;
+        Format.PackingMode = ERship2110PackingMode::GPM;
+        return Format;
+    }
+
+    TArray<uint8> MakeFrame(int64 Bytes, int32 Seed)
+    {
+        TArray<uint8> Frame;
+        Frame.SetNumUninitialized(static_cast<int32>(Bytes));
+        FRandomStream Random(Seed);
+        for (uint8& Byte : Frame)
+        {
+            Byte = static_cast<uint8>(Random.RandHelper(256));
+        }
+        return Frame;
+    }
+
+    /** CPU time of the calling thread where the platform exposes it, wall time elsewhere */
+    double GetThreadSeconds()
+    {
+#if PLATFORM_LINUX
+        timespec Now;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &Now);
+        return static_cast<double>(Now.tv_sec) + static_cast<double>(Now.tv_nsec) * 1e-9;
+#else
+        return FPlatformTime::Seconds();
+#endif
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110PacketTransmitterLoopbackTest,
+    "Rship.2110.PacketTransmitter.Loopback",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110PacketTransmitterLoopbackTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110PacketTransmitterTests;
+
+    constexpr int32 NumFrames = 8;
+    // Just below a 16-bit wrap so the extended sequence number carries mid-stream
+    constexpr uint32 FirstSequence = 0x0001FF00;
+    const FRship2110VideoFormat Format = MakeFormat(256, 64);
+
+    for (const bool bFallback : { false, true })
+    {
+        FRship2110LoopbackReceiver Receiver(TEXT("Rship2110TransmitTest"), 64 * 1024 * 1024);
+        if (!Receiver.IsValid())
+        {
+            AddError(TEXT("Could not bind a loopback receiver"));
+            return false;
+        }
+
+        TUniquePtr<IRship2110PacketTransmitter> Transmitter =
+            bFallback ? FRship2110TransmitterFactory::CreateFallback() : FRship2110TransmitterFactory::Create();
+        if (!Transmitter->Open(Receiver.MakeParams(PayloadType, SSRC), FRship2110TransmitOptions()))
+        {
+            AddError(FString::Printf(TEXT("%s transmitter did not open"), *Transmitter->GetName()));
+            continue;
+        }
+
+        const FString Name = Transmitter->GetName();
+#if PLATFORM_LINUX
+        if (!bFallback)
+        {
+            TestTrue(TEXT("Linux transmitter batches sends"), Transmitter->GetCapabilities().bBatching);
+        }
+#endif
+
+        FRship2110TransmitThread Thread(MoveTemp(Transmitter));
+        TestTrue(FString::Printf(TEXT("%s: configure"), *Name), Thread.Configure(Format, PayloadType, SSRC));
+        TestTrue(FString::Printf(TEXT("%s: start"), *Name), Thread.Start(FirstSequence));
+
+        FRship2110VideoDepacketizer Depacketizer;
+        Depacketizer.Configure(Format);
+
+        const int32 PacketsPerFrame = Thread.GetPacketizer().GetPacketsPerFrame();
+        int32 FramesMatched = 0;
+        for (int32 FrameIndex = 0; FrameIndex < NumFrames; FrameIndex++)
+        {
+            const TArray<uint8> Frame = MakeFrame(Thread.GetPacketizer().GetFrameBytes(), FrameIndex + 1);
+            const uint32 RTPTimestamp = 1500u * FrameIndex;
+
+            if (!Thread.Enqueue(Frame.GetData(), Frame.Num(), RTPTimestamp))
+            {
+                AddError(FString::Printf(TEXT("%s: frame %d dropped"), *Name, FrameIndex));
+                break;
+            }
+            TestTrue(FString::Printf(TEXT("%s: frame %d sent"), *Name, FrameIndex), Thread.WaitUntilIdle(5.0));
+
+            DrainFrames(Receiver, Depacketizer, [&]()
+            {
+                if (Depacketizer.IsFrameComplete() && Depacketizer.GetFrameTimestamp() == RTPTimestamp &&
+                    Depacketizer.GetFrame() == Frame)
+                {
+                    FramesMatched++;
+                }
+            });
+        }
+
+        Thread.Shutdown();
+
+        const FRship2110VideoDepacketizer::FStats& RxStats = Depacketizer.GetStats();
+        TestEqual(FString::Printf(TEXT("%s: frames bit-exact"), *Name), FramesMatched, NumFrames);
+        TestEqual(FString::Printf(TEXT("%s: packets received"), *Name), RxStats.PacketsReceived, static_cast<int64>(NumFrames) * PacketsPerFrame);
+        TestEqual(FString::Printf(TEXT("%s: packets lost"), *Name), RxStats.PacketsLost, static_cast<int64>(0));
+        TestEqual(FString::Printf(TEXT("%s: packets malformed"), *Name), RxStats.PacketsMalformed, static_cast<int64>(0));
+        TestEqual(FString::Printf(TEXT("%s: last sequence"), *Name), Depacketizer.GetLastSequenceNumber(),
+                  FirstSequence + static_cast<uint32>(NumFrames * PacketsPerFrame) - 1);
+        TestEqual(FString::Printf(TEXT("%s: frames sent"), *Name), Thread.GetFramesSent(), static_cast<int64>(NumFrames));
+
+        const FRship2110TransmitStats TxStats = Thread.GetTransmitter()->GetStats();
+        TestEqual(FString::Printf(TEXT("%s: transmitter packets"), *Name), TxStats.PacketsSent, static_cast<int64>(NumFrames) * PacketsPerFrame);
+        TestEqual(FString::Printf(TEXT("%s: transmitter failures"), *Name), TxStats.PacketsFailed, static_cast<int64>(0));
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110PacketTransmitterDropTest,
+    "Rship.2110.PacketTransmitter.Drop",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110PacketTransmitterDropTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110PacketTransmitterTests;
+
+    const FRship2110VideoFormat Format = MakeFormat(256, 64);
+
+    // No transmitter: configures, but never starts, and refuses frames
+    FRship2110TransmitThread Thread(nullptr);
+    TestTrue(TEXT("Configure without a transmitter"), Thread.Configure(Format, PayloadType, SSRC));
+    TestFalse(TEXT("Start without a transmitter"), Thread.Start(0));
+
+    const TArray<uint8> Frame = MakeFrame(Thread.GetPacketizer().GetFrameBytes(), 1);
+    TestFalse(TEXT("Enqueue while stopped"), Thread.Enqueue(Frame.GetData(), Frame.Num(), 0));
+
+    // Wrong frame size is refused even when running
+    FRship2110LoopbackReceiver Receiver(TEXT("Rship2110TransmitTest"), 64 * 1024 * 1024);
+    FRship2110TransmitThread Running(FRship2110TransmitterFactory::CreateOpen(Receiver.MakeParams(PayloadType, SSRC), FRship2110TransmitOptions()));
+    if (Receiver.IsValid() && Running.GetTransmitter())
+    {
+        Running.Configure(Format, PayloadType, SSRC);
+        Running.Start(0);
+        TestFalse(TEXT("Enqueue short frame"), Running.Enqueue(Frame.GetData(), Frame.Num() - 1, 0));
+        TestTrue(TEXT("Enqueue whole frame"), Running.Enqueue(Frame.GetData(), Frame.Num(), 0));
+        TestTrue(TEXT("Queue drains"), Running.WaitUntilIdle(5.0));
+        Running.Shutdown();
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110PacketTransmitterBenchmark,
+    "Rship.2110.PacketTransmitter.Benchmark",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FRship2110PacketTransmitterBenchmark::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110PacketTransmitterTests;
+
+    constexpr int32 NumFrames = 60;
+    const FRship2110VideoFormat Format = MakeFormat(1920, 1080);
+
+    // The receiver stays bound but undrained: the kernel drops the overflow
+    // quietly instead of answering with port-unreachable errors
+    FRship2110LoopbackReceiver Receiver(TEXT("Rship2110TransmitTest"), 64 * 1024 * 1024);
+    if (!Receiver.IsValid())
+    {
+        AddError(TEXT("Could not bind a loopback receiver"));
+        return false;
+    }
+
+    struct FCase
+    {
+        const TCHAR* Label;
+        bool bFallback;
+        bool bSegmentationOffload;
+    };
+    const FCase Cases[] =
+    {
+        { TEXT("FSocket SendTo"), true, false },
+        { TEXT("Platform, no offload"), false, false },
+        { TEXT("Platform, offload"), false, true },
+    };
+
+    for (const FCase& Case : Cases)
+    {
+        TUniquePtr<IRship2110PacketTransmitter> Transmitter =
+            Case.bFallback ? FRship2110TransmitterFactory::CreateFallback() : FRship2110TransmitterFactory::Create();
+
+        FRship2110TransmitOptions Options;
+        Options.bSegmentationOffload = Case.bSegmentationOffload;
+        if (!Transmitter->Open(Receiver.MakeParams(PayloadType, SSRC), Options))
+        {
+            AddWarning(FString::Printf(TEXT("%s: transmitter did not open"), Case.Label));
+            continue;
+        }
+
+        FRship2110VideoPacketizer Packetizer;
+        Packetizer.Configure(Format, PayloadType, SSRC);
+        const TArray<uint8> Frame = MakeFrame(Packetizer.GetFrameBytes(), 1);
+
+        const double WallStart = FPlatformTime::Seconds();
+        const double CpuStart = GetThreadSeconds();
+        for (int32 i = 0; i < NumFrames; i++)
+        {
+            Transmitter->SendPackets(Packetizer.PacketizeFrame(Frame.GetData(), 1500u * i));
+        }
+        const double CpuSeconds = GetThreadSeconds() - CpuStart;
+        const double WallSeconds = FPlatformTime::Seconds() - WallStart;
+
+        const FRship2110TransmitStats Stats = Transmitter->GetStats();
+        const FRship2110TransmitCapabilities Capabilities = Transmitter->GetCapabilities();
+        const double Gbits = Stats.BytesSent * 8.0 / 1e9;
+
+        AddInfo(FString::Printf(TEXT("%s (%s%s): %.0f packets/s, %.2f Gbit/s, %.3f CPU s per Gbit, %.1f packets per call"),
+            Case.Label, *Transmitter->GetName(), Capabilities.bSegmentationOffload ? TEXT(" +GSO") : TEXT(""),
+            Stats.PacketsSent / WallSeconds, Gbits / WallSeconds, Gbits > 0.0 ? CpuSeconds / Gbits : 0.0,
+            Stats.SystemCalls > 0 ? static_cast<double>(Stats.PacketsSent) / Stats.SystemCalls : 0.0));
+
+        Transmitter->Close();
+    }
+
+    return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
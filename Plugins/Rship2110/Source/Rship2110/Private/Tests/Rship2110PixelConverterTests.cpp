@@ -0,0 +1,412 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "Capture/Rship2110PixelConverter.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "HAL/PlatformTime.h"
+#include "Math/Float16.h"
+#include "Math/RandomStream.h"
+
+namespace Rship2110PixelConverterTests
+{
+    struct FRGB8
+    {
+        uint8 R, G, B;
+    };
+
+    // Expected codes for a solid color, from ITU-R BT.601/709/2020 (narrow) and BT.2100 (full)
+    struct FGoldenVector
+    {
+        ERship2110Colorimetry Colorimetry;
+        ERship2110ColorRange Range;
+        ERship2110BitDepth BitDepth;
+        FRGB8 Color;
+        uint16 Y, Cb, Cr;
+    };
+
+    const FGoldenVector GoldenVectors[] =
+    {
+        // 100% primaries at 10-bit, every matrix and range
+        { ERship2110Colorimetry::BT601,  ERship2110ColorRange::Narrow, ERship2110BitDepth::Bits_10, { 255, 0, 0 }, 326, 361, 960 },
+        { ERship2110Colorimetry::BT601,  ERship2110ColorRange::Narrow, ERship2110BitDepth::Bits_10, { 0, 255, 0 }, 578, 215, 137 },
+        { ERship2110Colorimetry::BT601,  ERship2110ColorRange::Narrow, ERship2110BitDepth::Bits_10, { 0, 0, 255 }, 164, 960, 439 },
+        { ERship2110Colorimetry::BT601,  ERship2110ColorRange::Full,   ERship2110BitDepth::Bits_10, { 255, 0, 0 }, 306, 339, 1023 },
+        { ERship2110Colorimetry::BT601,  ERship2110ColorRange::Full,   ERship2110BitDepth::Bits_10, { 0, 255, 0 }, 601, 173, 84 },
+        { ERship2110Colorimetry::BT601,  ERship2110ColorRange::Full,   ERship2110BitDepth::Bits_10, { 0, 0, 255 }, 117, 1023, 429 },
+        { ERship2110Colorimetry::BT709,  ERship2110ColorRange::Narrow, ERship2110BitDepth::Bits_10, { 255, 0, 0 }, 250, 409, 960 },
+        { ERship2110Colorimetry::BT709,  ERship2110ColorRange::Narrow, ERship2110BitDepth::Bits_10, { 0, 255, 0 }, 691, 167, 105 },
+        { ERship2110Colorimetry::BT709,  ERship2110ColorRange::Narrow, ERship2110BitDepth::Bits_10, { 0, 0, 255 }, 127, 960, 471 },
+        { ERship2110Colorimetry::BT709,  ERship2110ColorRange::Full,   ERship2110BitDepth::Bits_10, { 255, 0, 0 }, 217, 395, 1023 },
+        { ERship2110Colorimetry::BT709,  ERship2110ColorRange::Full,   ERship2110BitDepth::Bits_10, { 0, 255, 0 }, 732, 118, 47 },
+        { ERship2110Colorimetry::BT709,  ERship2110ColorRange::Full,   ERship2110BitDepth::Bits_10, { 0, 0, 255 }, 74, 1023, 465 },
+        { ERship2110Colorimetry::BT2020, ERship2110ColorRange::Narrow, ERship2110BitDepth::Bits_10, { 255, 0, 0 }, 294, 387, 960 },
+        { ERship2110Colorimetry::BT2020, ERship2110ColorRange::Narrow, ERship2110BitDepth::Bits_10, { 0, 255, 0 }, 658, 189, 100 },
+        { ERship2110Colorimetry::BT2020, ERship2110ColorRange::Narrow, ERship2110BitDepth::Bits_10, { 0, 0, 255 }, 116, 960, 476 },
+        { ERship2110Colorimetry::BT2020, ERship2110ColorRange::Full,   ERship2110BitDepth::Bits_10, { 255, 0, 0 }, 269, 369, 1023 },
+        { ERship2110Colorimetry::BT2020, ERship2110ColorRange::Full,   ERship2110BitDepth::Bits_10, { 0, 255, 0 }, 694, 143, 42 },
+        { ERship2110Colorimetry::BT2020, ERship2110ColorRange::Full,   ERship2110BitDepth::Bits_10, { 0, 0, 255 }, 61, 1023, 471 },
+
+        // 8 and 12-bit scaling
+        { ERship2110Colorimetry::BT601,  ERship2110ColorRange::Narrow, ERship2110BitDepth::Bits_8,  { 255, 0, 0 }, 81, 90, 240 },
+        { ERship2110Colorimetry::BT709,  ERship2110ColorRange::Narrow, ERship2110BitDepth::Bits_8,  { 0, 255, 0 }, 173, 42, 26 },
+        { ERship2110Colorimetry::BT2020, ERship2110ColorRange::Full,   ERship2110BitDepth::Bits_8,  { 0, 255, 0 }, 173, 36, 11 },
+        { ERship2110Colorimetry::BT709,  ERship2110ColorRange::Narrow, ERship2110BitDepth::Bits_12, { 255, 0, 0 }, 1001, 1637, 3840 },
+        { ERship2110Colorimetry::BT709,  ERship2110ColorRange::Full,   ERship2110BitDepth::Bits_12, { 0, 255, 0 }, 2929, 470, 188 },
+        { ERship2110Colorimetry::BT2020, ERship2110ColorRange::Narrow, ERship2110BitDepth::Bits_12, { 0, 0, 255 }, 464, 3840, 1904 },
+
+        // White and black at every depth
+        { ERship2110Colorimetry::BT709,  ERship2110ColorRange::Narrow, ERship2110BitDepth::Bits_8,  { 255, 255, 255 }, 235, 128, 128 },
+        { ERship2110Colorimetry::BT709,  ERship2110ColorRange::Narrow, ERship2110BitDepth::Bits_10, { 0, 0, 0 }, 64, 512, 512 },
+        { ERship2110Colorimetry::BT709,  ERship2110ColorRange::Narrow, ERship2110BitDepth::Bits_12, { 255, 255, 255 }, 3760, 2048, 2048 },
+        { ERship2110Colorimetry::BT709,  ERship2110ColorRange::Narrow, ERship2110BitDepth::Bits_16, { 255, 255, 255 }, 60160, 32768, 32768 },
+        { ERship2110Colorimetry::BT2020, ERship2110ColorRange::Full,   ERship2110BitDepth::Bits_10, { 255, 255, 255 }, 1023, 512, 512 },
+        { ERship2110Colorimetry::BT2020, ERship2110ColorRange::Full,   ERship2110BitDepth::Bits_12, { 0, 0, 0 }, 0, 2048, 2048 },
+    };
+
+    FRship2110VideoFormat MakeFormat(ERship2110ColorFormat ColorFormat, ERship2110BitDepth BitDepth, int32 Width, int32 Height = 1)
+    {
+        FRship2110VideoFormat Format;
+        Format.ColorFormat = ColorFormat;
+        Format.BitDepth = BitDepth;
+        Format.Width = Width;
+        Format.Height = Height;
+        return Format;
+    }
+
+    TArray<uint8> MakeRGBA8(TConstArrayView<FRGB8> Pixels, uint8 Alpha = 255)
+    {
+        TArray<uint8> Bytes;
+        for (const FRGB8& Pixel : Pixels)
+        {
+            Bytes.Append({ Pixel.R, Pixel.G, Pixel.B, Alpha });
+        }
+        return Bytes;
+    }
+
+    // Read big-endian samples back out of packed pgroups
+    TArray<uint16> UnpackSamples(TConstArrayView<uint8> Packed, int32 BitDepth, int32 NumSamples)
+    {
+        TArray<uint16> Samples;
+        int64 Bit = 0;
+        for (int32 i = 0; i < NumSamples; i++)
+        {
+            uint32 Value = 0;
+            for (int32 b = 0; b < BitDepth; b++, Bit++)
+            {
+                Value = (Value << 1) | ((Packed[Bit / 8] >> (7 - Bit % 8)) & 1);
+            }
+            Samples.Add(static_cast<uint16>(Value));
+        }
+        return Samples;
+    }
+
+    TArray<uint8> ConvertLine(const FRship2110VideoFormat& Format, const void* Source, ERship2110PixelInput Input)
+    {
+        FRship2110PixelConverter Converter(Format);
+        TArray<uint8> Packed;
+        Packed.SetNumZeroed(Converter.GetLineBytes());
+        Converter.ConvertLine(Source, Input, Packed.GetData());
+        return Packed;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110PixelConverterGoldenTest,
+    "Rship.2110.PixelConverter.GoldenVectors",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110PixelConverterGoldenTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110PixelConverterTests;
+
+    for (const FGoldenVector& Golden : GoldenVectors)
+    {
+        const FRGB8 Line[4] = { Golden.Color, Golden.Color, Golden.Color, Golden.Color };
+        const TArray<uint8> Source = MakeRGBA8(Line);
+
+        FRship2110VideoFormat Format = MakeFormat(ERship2110ColorFormat::YCbCr_444, Golden.BitDepth, 4);
+        Format.Colorimetry = Golden.Colorimetry;
+        Format.Range = Golden.Range;
+        const int32 BitDepth = Format.GetBitDepthInt();
+        const FString What = FString::Printf(TEXT("%s %s %d-bit (%d, %d, %d)"),
+            *Format.GetColorimetryString(), *Format.GetRangeString(), BitDepth, Golden.Color.R, Golden.Color.G, Golden.Color.B);
+
+        // 4:4:4 pgroups carry Cb Y Cr per pixel
+        const TArray<uint16> Full = UnpackSamples(ConvertLine(Format, Source.GetData(), ERship2110PixelInput::RGBA8), BitDepth, 12);
+        for (int32 x = 0; x < 4; x++)
+        {
+            TestEqual(What + TEXT(" 4:4:4 Cb"), Full[x * 3 + 0], Golden.Cb);
+            TestEqual(What + TEXT(" 4:4:4 Y"), Full[x * 3 + 1], Golden.Y);
+            TestEqual(What + TEXT(" 4:4:4 Cr"), Full[x * 3 + 2], Golden.Cr);
+        }
+
+        // 4:2:2 pgroups carry Cb Y Cr Y per pixel pair; a solid line filters to the same chroma
+        Format.ColorFormat = ERship2110ColorFormat::YCbCr_422;
+        const TArray<uint16> Half = UnpackSamples(ConvertLine(Format, Source.GetData(), ERship2110PixelInput::RGBA8), BitDepth, 8);
+        for (int32 k = 0; k < 2; k++)
+        {
+            TestEqual(What + TEXT(" 4:2:2 Cb"), Half[k * 4 + 0], Golden.Cb);
+            TestEqual(What + TEXT(" 4:2:2 Y0"), Half[k * 4 + 1], Golden.Y);
+            TestEqual(What + TEXT(" 4:2:2 Cr"), Half[k * 4 + 2], Golden.Cr);
+            TestEqual(What + TEXT(" 4:2:2 Y1"), Half[k * 4 + 3], Golden.Y);
+        }
+    }
+
+    // RGB uses luma quantization on every component
+    const FRGB8 Ramp[4] = { { 255, 0, 0 }, { 0, 255, 0 }, { 0, 0, 255 }, { 255, 255, 255 } };
+    const TArray<uint8> Source = MakeRGBA8(Ramp);
+    const TArray<uint16> RGB = UnpackSamples(
+        ConvertLine(MakeFormat(ERship2110ColorFormat::RGB_444, ERship2110BitDepth::Bits_10, 4), Source.GetData(), ERship2110PixelInput::RGBA8), 10, 12);
+    const uint16 ExpectedRGB[12] = { 940, 64, 64, 64, 940, 64, 64, 64, 940, 940, 940, 940 };
+    for (int32 i = 0; i < 12; i++)
+    {
+        TestEqual(TEXT("Narrow 10-bit RGB"), RGB[i], ExpectedRGB[i]);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110PixelConverterPGroupTest,
+    "Rship.2110.PixelConverter.PGroupPacking",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110PixelConverterPGroupTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110PixelConverterTests;
+
+    // ST 2110-20 pgroup size / coverage
+    struct FPGroup
+    {
+        ERship2110ColorFormat ColorFormat;
+        ERship2110BitDepth BitDepth;
+        int32 Size;
+        int32 Coverage;
+    };
+    const FPGroup PGroups[] =
+    {
+        { ERship2110ColorFormat::YCbCr_422, ERship2110BitDepth::Bits_8, 4, 2 },
+        { ERship2110ColorFormat::YCbCr_422, ERship2110BitDepth::Bits_10, 5, 2 },
+        { ERship2110ColorFormat::YCbCr_422, ERship2110BitDepth::Bits_12, 6, 2 },
+        { ERship2110ColorFormat::YCbCr_422, ERship2110BitDepth::Bits_16, 8, 2 },
+        { ERship2110ColorFormat::YCbCr_444, ERship2110BitDepth::Bits_8, 3, 1 },
+        { ERship2110ColorFormat::YCbCr_444, ERship2110BitDepth::Bits_10, 15, 4 },
+        { ERship2110ColorFormat::YCbCr_444, ERship2110BitDepth::Bits_12, 9, 2 },
+        { ERship2110ColorFormat::RGB_444, ERship2110BitDepth::Bits_16, 6, 1 },
+        { ERship2110ColorFormat::RGBA_4444, ERship2110BitDepth::Bits_10, 5, 1 },
+    };
+    for (const FPGroup& PGroup : PGroups)
+    {
+        const FRship2110VideoFormat Format = MakeFormat(PGroup.ColorFormat, PGroup.BitDepth, 1920);
+        const FString What = FString::Printf(TEXT("%s %d-bit"), *Format.GetSampling(), Format.GetBitDepthInt());
+        TestEqual(What + TEXT(" pgroup size"), Format.GetPGroupSize(), PGroup.Size);
+        TestEqual(What + TEXT(" pgroup coverage"), Format.GetPGroupCoverage(), PGroup.Coverage);
+        TestEqual(What + TEXT(" line bytes"), Format.GetBytesPerLine(), 1920 / PGroup.Coverage * PGroup.Size);
+    }
+
+    // Narrow range white, Cb Y Cr Y = 512 940 512 940 at 10-bit, as wire bytes
+    const FRGB8 White[2] = { { 255, 255, 255 }, { 255, 255, 255 } };
+    const TArray<uint8> Source = MakeRGBA8(White);
+
+    const TArray<uint8> Packed8 = ConvertLine(MakeFormat(ERship2110ColorFormat::YCbCr_422, ERship2110BitDepth::Bits_8, 2), Source.GetData(), ERship2110PixelInput::RGBA8);
+    TestTrue(TEXT("8-bit pgroup"), Packed8 == TArray<uint8>({ 0x80, 0xEB, 0x80, 0xEB }));
+
+    const TArray<uint8> Packed10 = ConvertLine(MakeFormat(ERship2110ColorFormat::YCbCr_422, ERship2110BitDepth::Bits_10, 2), Source.GetData(), ERship2110PixelInput::RGBA8);
+    TestTrue(TEXT("10-bit pgroup is 5 bytes"), Packed10 == TArray<uint8>({ 0x80, 0x3A, 0xC8, 0x03, 0xAC }));
+
+    const TArray<uint8> Packed12 = ConvertLine(MakeFormat(ERship2110ColorFormat::YCbCr_422, ERship2110BitDepth::Bits_12, 2), Source.GetData(), ERship2110PixelInput::RGBA8);
+    TestTrue(TEXT("12-bit pgroup is 6 bytes"), Packed12 == TArray<uint8>({ 0x80, 0x0E, 0xB0, 0x80, 0x0E, 0xB0 }));
+
+    const TArray<uint8> Packed16 = ConvertLine(MakeFormat(ERship2110ColorFormat::YCbCr_422, ERship2110BitDepth::Bits_16, 2), Source.GetData(), ERship2110PixelInput::RGBA8);
+    TestTrue(TEXT("16-bit pgroup is big-endian"), Packed16 == TArray<uint8>({ 0x80, 0x00, 0xEB, 0x00, 0x80, 0x00, 0xEB, 0x00 }));
+
+    // Widths that split a pgroup are rejected
+    FRship2110PixelConverter Converter;
+    TestFalse(TEXT("10-bit 4:4:4 needs multiples of 4 pixels"), Converter.Configure(MakeFormat(ERship2110ColorFormat::YCbCr_444, ERship2110BitDepth::Bits_10, 6)));
+    TestFalse(TEXT("4:2:2 needs pixel pairs"), Converter.Configure(MakeFormat(ERship2110ColorFormat::YCbCr_422, ERship2110BitDepth::Bits_10, 7)));
+    uint8 Dest[16];
+    TestFalse(TEXT("Unconfigured converter refuses frames"), Converter.ConvertFrame(Source.GetData(), ERship2110PixelInput::RGBA8, 0, Dest));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110PixelConverterInputsTest,
+    "Rship.2110.PixelConverter.InputLayouts",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110PixelConverterInputsTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110PixelConverterTests;
+
+    // Every corner of the RGB cube, exact in all input layouts
+    TArray<FRGB8> Corners;
+    for (int32 i = 0; i < 8; i++)
+    {
+        Corners.Add({ static_cast<uint8>(i & 1 ? 255 : 0), static_cast<uint8>(i & 2 ? 255 : 0), static_cast<uint8>(i & 4 ? 255 : 0) });
+    }
+
+    const TArray<uint8> RGBA8 = MakeRGBA8(Corners);
+    TArray<uint8> BGRA8;
+    TArray<FFloat16> RGBA16F;
+    TArray<uint32> RGB10A2;
+    for (const FRGB8& Pixel : Corners)
+    {
+        BGRA8.Append({ Pixel.B, Pixel.G, Pixel.R, 255 });
+        RGBA16F.Append({ FFloat16(Pixel.R / 255.0f), FFloat16(Pixel.G / 255.0f), FFloat16(Pixel.B / 255.0f), FFloat16(1.0f) });
+        RGB10A2.Add((Pixel.R ? 0x3FFu : 0u) | (Pixel.G ? 0x3FFu << 10 : 0u) | (Pixel.B ? 0x3FFu << 20 : 0u) | (3u << 30));
+    }
+
+    for (const ERship2110ColorFormat ColorFormat : { ERship2110ColorFormat::YCbCr_422, ERship2110ColorFormat::RGBA_4444 })
+    {
+        const FRship2110VideoFormat Format = MakeFormat(ColorFormat, ERship2110BitDepth::Bits_12, Corners.Num());
+        const FString What = Format.GetSampling();
+        const TArray<uint8> Expected = ConvertLine(Format, RGBA8.GetData(), ERship2110PixelInput::RGBA8);
+        TestTrue(What + TEXT(" from BGRA8"), ConvertLine(Format, BGRA8.GetData(), ERship2110PixelInput::BGRA8) == Expected);
+        TestTrue(What + TEXT(" from RGBA16F"), ConvertLine(Format, RGBA16F.GetData(), ERship2110PixelInput::RGBA16F) == Expected);
+        TestTrue(What + TEXT(" from RGB10A2"), ConvertLine(Format, RGB10A2.GetData(), ERship2110PixelInput::RGB10A2) == Expected);
+    }
+
+    // Alpha is full range regardless of the color range
+    const TArray<uint8> Transparent = MakeRGBA8(Corners, 0);
+    const FRship2110VideoFormat RGBA = MakeFormat(ERship2110ColorFormat::RGBA_4444, ERship2110BitDepth::Bits_12, Corners.Num());
+    const TArray<uint16> Opaque = UnpackSamples(ConvertLine(RGBA, RGBA8.GetData(), ERship2110PixelInput::RGBA8), 12, Corners.Num() * 4);
+    const TArray<uint16> Clear = UnpackSamples(ConvertLine(RGBA, Transparent.GetData(), ERship2110PixelInput::RGBA8), 12, Corners.Num() * 4);
+    TestEqual(TEXT("Opaque alpha"), Opaque[3], static_cast<uint16>(4095));
+    TestEqual(TEXT("Transparent alpha"), Clear[3], static_cast<uint16>(0));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110PixelConverterSitingTest,
+    "Rship.2110.PixelConverter.ChromaSiting",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110PixelConverterSitingTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110PixelConverterTests;
+
+    // Blue pairs alternating with black pairs: Cb 960 and 512 at BT.709 narrow 10-bit
+    const FRGB8 Blue = { 0, 0, 255 };
+    const FRGB8 Black = { 0, 0, 0 };
+    const FRGB8 Line[8] = { Blue, Blue, Black, Black, Blue, Blue, Black, Black };
+    const TArray<uint8> Source = MakeRGBA8(Line);
+
+    FRship2110VideoFormat Format = MakeFormat(ERship2110ColorFormat::YCbCr_422, ERship2110BitDepth::Bits_10, 8);
+
+    // Co-sited: [1 2 1] / 4 on each even pixel, the left edge replicated
+    Format.ChromaSiting = ERship2110ChromaSiting::Cosited;
+    const TArray<uint16> Cosited = UnpackSamples(ConvertLine(Format, Source.GetData(), ERship2110PixelInput::RGBA8), 10, 16);
+    const uint16 ExpectedCosited[4] = { 960, 624, 848, 624 };
+
+    // Interstitial: mean of each pair
+    Format.ChromaSiting = ERship2110ChromaSiting::Interstitial;
+    const TArray<uint16> Interstitial = UnpackSamples(ConvertLine(Format, Source.GetData(), ERship2110PixelInput::RGBA8), 10, 16);
+    const uint16 ExpectedInterstitial[4] = { 960, 512, 960, 512 };
+
+    for (int32 k = 0; k < 4; k++)
+    {
+        TestEqual(FString::Printf(TEXT("Co-sited Cb %d"), k), Cosited[k * 4], ExpectedCosited[k]);
+        TestEqual(FString::Printf(TEXT("Interstitial Cb %d"), k), Interstitial[k * 4], ExpectedInterstitial[k]);
+        TestEqual(TEXT("Luma is not filtered"), Cosited[k * 4 + 1], Interstitial[k * 4 + 1]);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110PixelConverterFrameTest,
+    "Rship.2110.PixelConverter.FrameMatchesLines",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110PixelConverterFrameTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110PixelConverterTests;
+
+    // Enough lines for several parallel tasks, with padding between source lines
+    constexpr int32 Width = 200;
+    constexpr int32 Height = 97;
+    constexpr int32 Stride = Width * 4 + 64;
+
+    FRandomStream Random(41);
+    TArray<uint8> Source;
+    Source.SetNumUninitialized(Stride * Height);
+    for (uint8& Byte : Source)
+    {
+        Byte = static_cast<uint8>(Random.RandHelper(256));
+    }
+
+    for (const ERship2110ColorFormat ColorFormat : { ERship2110ColorFormat::YCbCr_422, ERship2110ColorFormat::YCbCr_444 })
+    {
+        FRship2110VideoFormat Format = MakeFormat(ColorFormat, ERship2110BitDepth::Bits_10, Width, Height);
+        Format.Colorimetry = ERship2110Colorimetry::BT2020;
+
+        const FRship2110PixelConverter Converter(Format);
+        TArray<uint8> Frame;
+        Frame.SetNumZeroed(static_cast<int32>(Converter.GetFrameBytes()));
+        TestTrue(TEXT("Frame converted"), Converter.ConvertFrame(Source.GetData(), ERship2110PixelInput::RGBA8, Stride, Frame.GetData()));
+        TestEqual(TEXT("Frame size matches the format"), static_cast<int64>(Frame.Num()), Format.GetFrameSizeBytes());
+
+        TArray<uint8> Line;
+        Line.SetNumZeroed(Converter.GetLineBytes());
+        for (int32 y = 0; y < Height; y++)
+        {
+            Converter.ConvertLine(Source.GetData() + y * Stride, ERship2110PixelInput::RGBA8, Line.GetData());
+            if (FMemory::Memcmp(Line.GetData(), Frame.GetData() + y * Converter.GetLineBytes(), Line.Num()) != 0)
+            {
+                AddError(FString::Printf(TEXT("%s line %d differs from the frame"), *Format.GetSampling(), y));
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110PixelConverterBenchmark,
+    "Rship.2110.PixelConverter.Benchmark",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FRship2110PixelConverterBenchmark::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110PixelConverterTests;
+
+    constexpr int32 NumFrames = 30;
+    const FIntPoint Resolutions[] = { { 1280, 720 }, { 1920, 1080 }, { 3840, 2160 } };
+
+    for (const FIntPoint& Resolution : Resolutions)
+    {
+        TArray<uint8> Source;
+        Source.SetNumUninitialized(Resolution.X * Resolution.Y * 4);
+        FRandomStream Random(Resolution.X);
+        for (uint8& Byte : Source)
+        {
+            Byte = static_cast<uint8>(Random.RandHelper(256));
+        }
+
+        for (const ERship2110ColorFormat ColorFormat : { ERship2110ColorFormat::YCbCr_422, ERship2110ColorFormat::YCbCr_444 })
+        {
+            const FRship2110PixelConverter Converter(MakeFormat(ColorFormat, ERship2110BitDepth::Bits_10, Resolution.X, Resolution.Y));
+            TArray<uint8> Frame;
+            Frame.SetNumUninitialized(static_cast<int32>(Converter.GetFrameBytes()));
+
+            const double Start = FPlatformTime::Seconds();
+            for (int32 i = 0; i < NumFrames; i++)
+            {
+                Converter.ConvertFrame(Source.GetData(), ERship2110PixelInput::BGRA8, 0, Frame.GetData());
+            }
+            const double FrameMs = (FPlatformTime::Seconds() - Start) * 1000.0 / NumFrames;
+
+            AddInfo(FString::Printf(TEXT("%dx%d %s 10-bit: %.2f ms/frame (%.0f%% of a 60p frame)"),
+                Resolution.X, Resolution.Y, *Converter.GetFormat().GetSampling(), FrameMs, FrameMs * 100.0 / (1000.0 / 60.0)));
+        }
+    }
+
+    return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
@@ -0,0 +1,632 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "Rivermax/Rship2110StreamReceiver.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Rivermax/Rship2110PacketTransmitter.h"
+
+namespace Rship2110StreamReceiverTests
+{
+    constexpr uint8 VideoPayloadType = 96;
+    constexpr uint8 AudioPayloadType = 97;
+    constexpr uint8 AncPayloadType = 100;
+    constexpr uint32 SSRC = 0x2110FEED;
+
+    /** Copies of one frame's packets, in send order */
+    using FPacketList = TArray<TArray<uint8>>;
+
+    FRship2110VideoFormat MakeVideoFormat(int32 Width, int32 Height)
+    {
+        FRship2110VideoFormat Format;
+        Format.Width = Width;
+        Format.Height = Height;
+        Format.FrameRateNumerator = 60;
+        Format.FrameRateDenominator = 1;
+        Format.ColorFormat = ERship2110ColorFormat::YCbCr_422;
+        Format.BitDepth = ERship2110BitDepth::Bits_10;
+        Format.SenderType = ERship2110SenderType::NarrowGapped;
+        return Format;
+    }
+
+    FRship2110AudioFormat MakeAudioFormat()
+    {
+        FRship2110AudioFormat Format;
+        Format.BitsPerSample = 24;
+        Format.NumChannels = 2;
+        Format.PacketTimeUs = 1000;
+        return Format;
+    }
+
+    TArray<uint8> MakeFrame(int64 Bytes, int32 Seed)
+    {
+        TArray<uint8> Frame;
+        Frame.SetNumUninitialized(static_cast<int32>(Bytes));
+        FRandomStream Random(Seed);
+        for (uint8& Byte : Frame)
+        {
+            Byte = static_cast<uint8>(Random.RandHelper(256));
+        }
+        return Frame;
+    }
+
+    /** Test signal on the PCM grid, never zero so silence can be told apart */
+    int32 SignalPCM(int64 Frame, int32 Channel, int32 BitsPerSample)
+    {
+        const int32 FullScale = 1 << (BitsPerSample - 1);
+        const int32 Value = static_cast<int32>((Frame * 7919 + Channel * 104729) % (2 * FullScale - 2)) - (FullScale - 1);
+        return Value != 0 ? Value : 1;
+    }
+
+    FPacketList CopyPackets(TConstArrayView<FRship2110Packet> Packets)
+    {
+        FPacketList Result;
+        for (const FRship2110Packet& Packet : Packets)
+        {
+            Result.Emplace(Packet.Data, Packet.Size);
+        }
+        return Result;
+    }
+
+    /**
+     * Packetize frames at the given timestamps, let Mutate alter each frame's
+     * packets, and feed them at their ST 2110-21 launch times plus a fixed delay.
+     */
+    void RunFrames(FRship2110StreamValidator& Validator, const TArray<TArray<uint8>>& Frames,
+                   TConstArrayView<uint32> Timestamps, TFunctionRef<void(int32, FPacketList&)> Mutate)
+    {
+        const FRship2110VideoFormat& Format = Validator.GetConfig().VideoFormat;
+        FRship2110VideoPacketizer Packetizer;
+        Packetizer.Configure(Format, VideoPayloadType, SSRC);
+
+        FRship2110PacingScheduler Scheduler;
+        Scheduler.Configure(Format, Packetizer.GetPacketsPerFrame());
+
+        constexpr uint64 BaseNs = 1000000000ULL;
+        constexpr uint64 NetworkDelayNs = 30000;
+
+        TArray<uint64> LaunchTimes;
+        for (int32 FrameIndex = 0; FrameIndex < Frames.Num(); ++FrameIndex)
+        {
+            FPacketList Packets = CopyPackets(Packetizer.PacketizeFrame(Frames[FrameIndex].GetData(), Timestamps[FrameIndex]));
+            Mutate(FrameIndex, Packets);
+
+            Scheduler.ComputeLaunchTimes(BaseNs + FrameIndex * Scheduler.GetBoundaryDurationNs(), LaunchTimes);
+            for (int32 Index = 0; Index < Packets.Num(); ++Index)
+            {
+                const uint64 ArrivalNs = LaunchTimes[FMath::Min(Index, LaunchTimes.Num() - 1)] + NetworkDelayNs;
+                Validator.ReceivePacket(Packets[Index].GetData(), Packets[Index].Num(), ArrivalNs);
+            }
+        }
+    }
+
+    void SetMarker(TArray<uint8>& Packet, bool bMarker)
+    {
+        Packet[1] = bMarker ? (Packet[1] | 0x80) : (Packet[1] & 0x7F);
+    }
+
+    /** Receiver on 127.0.0.1 with an ephemeral port, running for the fixture's lifetime */
+    class FLoopbackFixture
+    {
+    public:
+        bool Open(const FRship2110ReceiverConfig& Config)
+        {
+            return Receiver.Open(Config, TEXT("127.0.0.1"), 0) && Receiver.Start();
+        }
+
+        FRship2110TransportParams MakeParams(uint8 PayloadType) const
+        {
+            FRship2110TransportParams Params;
+            Params.DestinationIP = TEXT("127.0.0.1");
+            Params.DestinationPort = Receiver.GetPort();
+            Params.PayloadType = PayloadType;
+            Params.SSRC = SSRC;
+            return Params;
+        }
+
+        FRship2110StreamReceiver Receiver;
+    };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110ReceiverVideoTest,
+    "Rship.2110.Receiver.Video",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110ReceiverVideoTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110StreamReceiverTests;
+
+    const FRship2110VideoFormat Format = MakeVideoFormat(256, 64);
+
+    FRship2110ReceiverConfig Config;
+    Config.StreamType = ERship2110StreamType::Video_2110_20;
+    Config.VideoFormat = Format;
+    Config.PayloadType = VideoPayloadType;
+
+    TArray<TArray<uint8>> Frames;
+    for (int32 Index = 0; Index < 3; ++Index)
+    {
+        Frames.Add(MakeFrame(Format.GetFrameSizeBytes(), Index + 1));
+    }
+
+    const uint32 Cadence[] = { 0, 1500, 3000 };
+    auto NoChange = [](int32, FPacketList&) {};
+
+    FRship2110StreamValidator Validator;
+    if (!TestTrue(TEXT("Configure"), Validator.Configure(Config)))
+    {
+        return false;
+    }
+
+    // Clean stream
+    RunFrames(Validator, Frames, Cadence, NoChange);
+    const FRship2110ValidationReport& Clean = Validator.GetReport();
+    TestFalse(TEXT("Clean stream has no errors"), Clean.HasErrors());
+    TestEqual(TEXT("Clean stream frames"), Clean.FramesReceived, static_cast<int64>(3));
+    TestEqual(TEXT("Every frame paced"), Clean.Pacing.FramesChecked, static_cast<int64>(3));
+    TestTrue(TEXT("Launch-time arrivals are compliant"), Clean.Pacing.IsCompliant());
+    TestEqual(TEXT("Last frame timestamp"), Validator.GetLastFrameTimestamp(), 3000u);
+    TestTrue(TEXT("Last frame reconstructed exactly"),
+             FRship2110StreamValidator::CompareFrames(Format, Frames[2], Validator.GetLastFrame()).IsIdentical());
+
+    const int32 PacketsPerFrame = static_cast<int32>(Clean.PacketsReceived / 3);
+
+    // A lost packet leaves its frame incomplete but does not look like a marker problem
+    Validator.Reset();
+    RunFrames(Validator, Frames, Cadence, [](int32 FrameIndex, FPacketList& Packets)
+    {
+        if (FrameIndex == 1)
+        {
+            Packets.RemoveAt(5);
+        }
+    });
+    TestEqual(TEXT("Loss: packets lost"), Validator.GetReport().PacketsLost, static_cast<int64>(1));
+    TestEqual(TEXT("Loss: frames incomplete"), Validator.GetReport().FramesIncomplete, static_cast<int64>(1));
+    TestEqual(TEXT("Loss: no marker errors"), Validator.GetReport().MarkerErrors, static_cast<int64>(0));
+    TestEqual(TEXT("Loss: lossy frame not paced"), Validator.GetReport().Pacing.FramesChecked, static_cast<int64>(2));
+
+    // Reordering is not loss, and the frame still reassembles
+    Validator.Reset();
+    RunFrames(Validator, Frames, Cadence, [](int32 FrameIndex, FPacketList& Packets)
+    {
+        if (FrameIndex == 1)
+        {
+            Packets.Swap(4, 5);
+        }
+    });
+    TestEqual(TEXT("Reorder: packets lost"), Validator.GetReport().PacketsLost, static_cast<int64>(0));
+    TestEqual(TEXT("Reorder: out of order"), Validator.GetReport().PacketsOutOfOrder, static_cast<int64>(1));
+    TestEqual(TEXT("Reorder: frames incomplete"), Validator.GetReport().FramesIncomplete, static_cast<int64>(0));
+
+    // Frame that never sets its marker
+    Validator.Reset();
+    RunFrames(Validator, Frames, Cadence, [](int32 FrameIndex, FPacketList& Packets)
+    {
+        if (FrameIndex == 0)
+        {
+            SetMarker(Packets.Last(), false);
+        }
+    });
+    TestEqual(TEXT("No marker: marker errors"), Validator.GetReport().MarkerErrors, static_cast<int64>(1));
+    TestEqual(TEXT("No marker: frames incomplete"), Validator.GetReport().FramesIncomplete, static_cast<int64>(1));
+    TestEqual(TEXT("No marker: frames closed"), Validator.GetReport().FramesReceived, static_cast<int64>(2));
+
+    // Marker set part way through a frame
+    Validator.Reset();
+    RunFrames(Validator, Frames, Cadence, [](int32 FrameIndex, FPacketList& Packets)
+    {
+        if (FrameIndex == 2)
+        {
+            SetMarker(Packets[3], true);
+        }
+    });
+    TestEqual(TEXT("Early marker: packets after it"), Validator.GetReport().MarkerErrors, static_cast<int64>(PacketsPerFrame - 4));
+    TestEqual(TEXT("Early marker: frame incomplete"), Validator.GetReport().FramesIncomplete, static_cast<int64>(1));
+
+    // Timestamps off the 60p cadence, and a skipped frame period
+    Validator.Reset();
+    const uint32 OffCadence[] = { 0, 1500, 3100 };
+    RunFrames(Validator, Frames, OffCadence, NoChange);
+    TestEqual(TEXT("Off cadence: timestamp errors"), Validator.GetReport().TimestampErrors, static_cast<int64>(1));
+    TestEqual(TEXT("Off cadence: gaps"), Validator.GetReport().TimestampGaps, static_cast<int64>(0));
+
+    Validator.Reset();
+    const uint32 Skipped[] = { 0, 1500, 4500 };
+    RunFrames(Validator, Frames, Skipped, NoChange);
+    TestEqual(TEXT("Skipped period: timestamp errors"), Validator.GetReport().TimestampErrors, static_cast<int64>(0));
+    TestEqual(TEXT("Skipped period: gaps"), Validator.GetReport().TimestampGaps, static_cast<int64>(1));
+
+    // Another payload type on the same port
+    Validator.Reset();
+    RunFrames(Validator, Frames, Cadence, [](int32 FrameIndex, FPacketList& Packets)
+    {
+        if (FrameIndex == 1)
+        {
+            Packets[2][1] = (Packets[2][1] & 0x80) | 111;
+        }
+    });
+    TestEqual(TEXT("Foreign payload type: header errors"), Validator.GetReport().HeaderErrors, static_cast<int64>(1));
+
+    // Pixel comparison at pgroup granularity
+    TArray<uint8> Damaged = Frames[0];
+    Damaged[10 * Format.GetBytesPerLine() + 7 * Format.GetPGroupSize()] ^= 0x01;
+    const FRship2110FrameComparison Comparison = FRship2110StreamValidator::CompareFrames(Format, Frames[0], Damaged);
+    TestEqual(TEXT("One pgroup differs"), Comparison.MismatchedPGroups, static_cast<int64>(1));
+    TestEqual(TEXT("Difference row"), Comparison.FirstRow, 10);
+    TestEqual(TEXT("Difference pixel"), Comparison.FirstPixel, 7 * Format.GetPGroupCoverage());
+    TestFalse(TEXT("Short frame differs"),
+              FRship2110StreamValidator::CompareFrames(Format, Frames[0], MakeArrayView(Frames[0].GetData(), 100)).IsIdentical());
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110ReceiverPacingTest,
+    "Rship.2110.Receiver.Pacing",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110ReceiverPacingTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110StreamReceiverTests;
+
+    const FRship2110VideoFormat Format = MakeVideoFormat(256, 64);
+
+    FRship2110VideoPacketizer Packetizer;
+    Packetizer.Configure(Format, VideoPayloadType, SSRC);
+    const TArray<uint8> Frame = MakeFrame(Format.GetFrameSizeBytes(), 7);
+
+    FRship2110ReceiverConfig Config;
+    Config.VideoFormat = Format;
+
+    // Whole frame in one burst, the way an unpaced sender writes it
+    FRship2110StreamValidator Validator;
+    Validator.Configure(Config);
+    for (int32 FrameIndex = 0; FrameIndex < 3; ++FrameIndex)
+    {
+        const uint64 BurstNs = 1000000000ULL + FrameIndex * Format.GetFrameDurationNs();
+        for (const FRship2110Packet& Packet : Packetizer.PacketizeFrame(Frame.GetData(), FrameIndex * 1500))
+        {
+            Validator.ReceivePacket(Packet.Data, Packet.Size, BurstNs);
+        }
+    }
+
+    const FRship2110PacingReport& Burst = Validator.GetReport().Pacing;
+    TestFalse(TEXT("Burst stream has no integrity errors"), Validator.GetReport().HasErrors());
+    TestEqual(TEXT("Burst frames checked"), Burst.FramesChecked, static_cast<int64>(3));
+    TestFalse(TEXT("Burst is not compliant"), Burst.IsCompliant());
+    TestEqual(TEXT("Burst fills the VRX with the whole frame"), Burst.VRXMax, Packetizer.GetPacketsPerFrame());
+    TestTrue(TEXT("Burst overflows CMAX"), Burst.CInstMax > Burst.CMax);
+    TestEqual(TEXT("Receiver anchoring leaves nothing late"), Burst.LatePackets, static_cast<int64>(0));
+
+    // The same frames on the scheduler's timing, with a constant network delay
+    Validator.Reset();
+    TArray<TArray<uint8>> Frames = { Frame, Frame, Frame };
+    const uint32 Cadence[] = { 0, 1500, 3000 };
+    RunFrames(Validator, Frames, Cadence, [](int32, FPacketList&) {});
+
+    const FRship2110PacingReport& Paced = Validator.GetReport().Pacing;
+    TestTrue(TEXT("Paced is compliant"), Paced.IsCompliant());
+    TestTrue(TEXT("Paced VRX stays small"), Paced.VRXMax <= 2);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110ReceiverAudioTest,
+    "Rship.2110.Receiver.Audio",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110ReceiverAudioTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110StreamReceiverTests;
+
+    const FRship2110AudioFormat Format = MakeAudioFormat();
+    const int32 SamplesPerPacket = Format.GetSamplesPerPacket();
+
+    FRship2110AudioPacketizer Packetizer;
+    Packetizer.Configure(Format, AudioPayloadType, SSRC);
+
+    FRship2110ReceiverConfig Config;
+    Config.StreamType = ERship2110StreamType::Audio_2110_30;
+    Config.AudioFormat = Format;
+
+    FRship2110StreamValidator Validator;
+    if (!TestTrue(TEXT("Configure"), Validator.Configure(Config)))
+    {
+        return false;
+    }
+
+    // Packet 10 is lost; from packet 15 the timestamps jump one sample ahead
+    constexpr int32 NumPackets = 20;
+    TArray<float> Chunk;
+    Chunk.SetNumUninitialized(SamplesPerPacket * Format.NumChannels);
+    for (int32 PacketIndex = 0; PacketIndex < NumPackets; ++PacketIndex)
+    {
+        for (int32 Frame = 0; Frame < SamplesPerPacket; ++Frame)
+        {
+            for (int32 Channel = 0; Channel < Format.NumChannels; ++Channel)
+            {
+                const int32 Value = SignalPCM(PacketIndex * SamplesPerPacket + Frame, Channel, Format.BitsPerSample);
+                Chunk[Frame * Format.NumChannels + Channel] = FRship2110AudioPacketizer::PCMToFloat(Value, Format.BitsPerSample);
+            }
+        }
+
+        const uint32 Timestamp = PacketIndex * SamplesPerPacket + (PacketIndex >= 15 ? 1 : 0);
+        const FRship2110Packet Packet = Packetizer.PacketizePacket(Chunk.GetData(), Timestamp);
+        if (PacketIndex != 10)
+        {
+            Validator.ReceivePacket(Packet.Data, Packet.Size, PacketIndex * 1000000ULL);
+        }
+    }
+
+    const FRship2110ValidationReport& Report = Validator.GetReport();
+    TestEqual(TEXT("Packets received"), Report.PacketsReceived, static_cast<int64>(NumPackets - 1));
+    TestEqual(TEXT("Packets lost"), Report.PacketsLost, static_cast<int64>(1));
+    TestEqual(TEXT("The loss keeps the cadence; the jump breaks it once"), Report.TimestampErrors, static_cast<int64>(1));
+    TestEqual(TEXT("No malformed packets"), Report.PacketsMalformed, static_cast<int64>(0));
+
+    const TArray<int32>& Samples = Validator.GetSamples();
+    TestEqual(TEXT("Samples kept"), Samples.Num(), (NumPackets - 1) * SamplesPerPacket * Format.NumChannels);
+    if (Samples.Num() > 0)
+    {
+        TestEqual(TEXT("First sample"), Samples[0], SignalPCM(0, 0, Format.BitsPerSample));
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110ReceiverLoopbackVideoTest,
+    "Rship.2110.Receiver.LoopbackVideo",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110ReceiverLoopbackVideoTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110StreamReceiverTests;
+
+    constexpr int32 NumFrames = 8;
+    const FRship2110VideoFormat Format = MakeVideoFormat(640, 480);
+
+    FRship2110ReceiverConfig Config;
+    Config.StreamType = ERship2110StreamType::Video_2110_20;
+    Config.VideoFormat = Format;
+    Config.PayloadType = VideoPayloadType;
+
+    FLoopbackFixture Fixture;
+    if (!Fixture.Open(Config))
+    {
+        AddError(TEXT("Could not start a loopback receiver"));
+        return false;
+    }
+
+    TUniquePtr<IRship2110PacketTransmitter> Transmitter =
+        FRship2110TransmitterFactory::CreateOpen(Fixture.MakeParams(VideoPayloadType), FRship2110TransmitOptions());
+    if (!Transmitter)
+    {
+        AddError(TEXT("No transmitter opened"));
+        return false;
+    }
+
+    FRship2110TransmitThread Thread(MoveTemp(Transmitter));
+    TestTrue(TEXT("Configure"), Thread.Configure(Format, VideoPayloadType, SSRC));
+
+    // Paced in software; the 16-bit RTP sequence wraps during the run
+    FRship2110LocalPacingClock Clock;
+    Thread.SetPacingClock(&Clock);
+    if (!TestTrue(TEXT("Start"), Thread.Start(0x0001FF00)))
+    {
+        return false;
+    }
+
+    TArray<TArray<uint8>> Frames;
+    for (int32 Index = 0; Index < NumFrames; ++Index)
+    {
+        Frames.Add(MakeFrame(Format.GetFrameSizeBytes(), 100 + Index));
+        TestTrue(TEXT("Frame queued"), Thread.Enqueue(Frames[Index].GetData(), Frames[Index].Num(), Index * 1500));
+        Thread.WaitUntilIdle(1.0);
+    }
+
+    TestTrue(TEXT("All frames arrived"), Fixture.Receiver.WaitForFrames(NumFrames, 2.0));
+    Thread.Shutdown();
+    Fixture.Receiver.Shutdown();
+
+    const FRship2110ValidationReport Report = Fixture.Receiver.GetReport();
+    TestEqual(TEXT("Frames received"), Report.FramesReceived, static_cast<int64>(NumFrames));
+    TestEqual(TEXT("Packets received"), Report.PacketsReceived, static_cast<int64>(NumFrames) * Thread.GetPacketizer().GetPacketsPerFrame());
+    TestFalse(TEXT("No integrity errors"), Report.HasErrors());
+
+    TArray<uint8> Received;
+    if (TestTrue(TEXT("A frame completed"), Fixture.Receiver.CopyLastFrame(Received)))
+    {
+        const FRship2110FrameComparison Comparison = FRship2110StreamValidator::CompareFrames(Format, Frames.Last(), Received);
+        TestTrue(TEXT("Last frame bit-exact"), Comparison.IsIdentical());
+    }
+
+    // Software pacing over loopback is at the mercy of the scheduler, so it is reported rather than asserted
+    AddInfo(FString::Printf(TEXT("Loopback video: %s"), *Report.ToString()));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110ReceiverLoopbackAudioTest,
+    "Rship.2110.Receiver.LoopbackAudio",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110ReceiverLoopbackAudioTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110StreamReceiverTests;
+
+    constexpr int32 SignalFrames = 4800;
+    constexpr int32 PrerollFrames = 240;
+    const FRship2110AudioFormat Format = MakeAudioFormat();
+
+    FRship2110ReceiverConfig Config;
+    Config.StreamType = ERship2110StreamType::Audio_2110_30;
+    Config.AudioFormat = Format;
+    Config.PayloadType = AudioPayloadType;
+
+    FLoopbackFixture Fixture;
+    if (!Fixture.Open(Config))
+    {
+        AddError(TEXT("Could not start a loopback receiver"));
+        return false;
+    }
+
+    TUniquePtr<IRship2110PacketTransmitter> Transmitter =
+        FRship2110TransmitterFactory::CreateOpen(Fixture.MakeParams(AudioPayloadType), FRship2110TransmitOptions());
+    if (!Transmitter)
+    {
+        AddError(TEXT("No transmitter opened"));
+        return false;
+    }
+
+    FRship2110AudioTransmitThread Thread(MoveTemp(Transmitter));
+    TestTrue(TEXT("Configure"), Thread.Configure(Format, AudioPayloadType, SSRC, PrerollFrames));
+
+    FRship2110LocalPacingClock Clock;
+    if (!TestTrue(TEXT("Start"), Thread.Start(Clock, 0xFF00)))
+    {
+        return false;
+    }
+
+    TArray<int32> Sent;
+    TArray<float> Chunk;
+    int64 NextFrame = 0;
+    while (NextFrame < SignalFrames)
+    {
+        const int32 Frames = FMath::Min(static_cast<int32>(SignalFrames - NextFrame),
+                                        Thread.GetRing().GetCapacity() - Thread.GetRing().GetAvailable());
+        Chunk.SetNumUninitialized(Frames * Format.NumChannels, EAllowShrinking::No);
+        for (int32 Frame = 0; Frame < Frames; ++Frame)
+        {
+            for (int32 Channel = 0; Channel < Format.NumChannels; ++Channel)
+            {
+                const int32 Value = SignalPCM(NextFrame + Frame, Channel, Format.BitsPerSample);
+                Chunk[Frame * Format.NumChannels + Channel] = FRship2110AudioPacketizer::PCMToFloat(Value, Format.BitsPerSample);
+                Sent.Add(Value);
+            }
+        }
+        Thread.GetRing().Write(Chunk.GetData(), Frames, Format.NumChannels);
+        NextFrame += Frames;
+        FPlatformProcess::Sleep(0.001f);
+    }
+
+    // Let the ring drain onto the wire
+    const double DrainEnd = FPlatformTime::Seconds() + 0.05 + Thread.GetRing().GetCapacity() / double(Format.SampleRate);
+    while (FPlatformTime::Seconds() < DrainEnd)
+    {
+        FPlatformProcess::Sleep(0.001f);
+    }
+    Thread.Shutdown();
+
+    TestTrue(TEXT("Every packet arrived"), Fixture.Receiver.WaitForPackets(Thread.GetPacketsSent(), 1.0));
+    Fixture.Receiver.Shutdown();
+
+    const FRship2110ValidationReport Report = Fixture.Receiver.GetReport();
+    TestEqual(TEXT("Packets received"), Report.PacketsReceived, Thread.GetPacketsSent());
+    TestFalse(TEXT("No integrity errors"), Report.HasErrors());
+
+    // Strip the silence around the signal
+    TArray<int32> Received;
+    Fixture.Receiver.TakeSamples(Received);
+    TArray<int32> Signal;
+    for (int32 Frame = 0; Frame + Format.NumChannels <= Received.Num(); Frame += Format.NumChannels)
+    {
+        bool bSilent = true;
+        for (int32 Channel = 0; Channel < Format.NumChannels; ++Channel)
+        {
+            bSilent &= Received[Frame + Channel] == 0;
+        }
+        if (!bSilent)
+        {
+            Signal.Append(&Received[Frame], Format.NumChannels);
+        }
+    }
+    TestTrue(TEXT("Signal reconstructed exactly"), Signal == Sent);
+
+    AddInfo(FString::Printf(TEXT("Loopback audio: %s"), *Report.ToString()));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110ReceiverLoopbackAncTest,
+    "Rship.2110.Receiver.LoopbackAnc",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110ReceiverLoopbackAncTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110StreamReceiverTests;
+
+    constexpr int32 NumFrames = 5;
+
+    FRship2110ReceiverConfig Config;
+    Config.StreamType = ERship2110StreamType::Ancillary_2110_40;
+    Config.VideoFormat = MakeVideoFormat(1920, 1080);
+    Config.PayloadType = AncPayloadType;
+
+    FLoopbackFixture Fixture;
+    if (!Fixture.Open(Config))
+    {
+        AddError(TEXT("Could not start a loopback receiver"));
+        return false;
+    }
+
+    TUniquePtr<IRship2110PacketTransmitter> Transmitter =
+        FRship2110TransmitterFactory::CreateOpen(Fixture.MakeParams(AncPayloadType), FRship2110TransmitOptions());
+    if (!Transmitter)
+    {
+        AddError(TEXT("No transmitter opened"));
+        return false;
+    }
+
+    // Small RTP packets so each frame spans three of them
+    FRship2110AncPacketizer Packetizer;
+    Packetizer.Configure(AncPayloadType, SSRC, 200);
+
+    TArray<FRship2110AncPacket> AncPackets;
+    for (int32 FrameIndex = 0; FrameIndex < NumFrames; ++FrameIndex)
+    {
+        AncPackets.Reset();
+        AncPackets.Add(FRship2110AncData::MakeTimecode(FTimecode(10, 0, 0, FrameIndex, false)));
+        for (int32 Index = 0; Index < 3; ++Index)
+        {
+            FRship2110AncPacket Payload;
+            Payload.DID = 0x50;
+            Payload.SDID = static_cast<uint8>(Index + 1);
+            Payload.LineNumber = static_cast<uint16>(12 + Index);
+            for (int32 Word = 0; Word < 100; ++Word)
+            {
+                Payload.UserData.Add(static_cast<uint8>(Word + FrameIndex));
+            }
+            AncPackets.Add(Payload);
+        }
+
+        Transmitter->SendPackets(Packetizer.PacketizeFrame(AncPackets, FrameIndex * 1500));
+        FPlatformProcess::Sleep(0.001f);
+    }
+
+    TestTrue(TEXT("All frames arrived"), Fixture.Receiver.WaitForFrames(NumFrames, 2.0));
+    Fixture.Receiver.Shutdown();
+
+    const FRship2110ValidationReport Report = Fixture.Receiver.GetReport();
+    TestEqual(TEXT("Frames received"), Report.FramesReceived, static_cast<int64>(NumFrames));
+    TestTrue(TEXT("Frames span several packets"), Report.PacketsReceived > NumFrames);
+    TestFalse(TEXT("No integrity errors"), Report.HasErrors());
+
+    TArray<FRship2110AncPacket> Received;
+    Fixture.Receiver.CopyLastAncPackets(Received);
+    TestTrue(TEXT("Last frame's ANC packets intact"), Received == AncPackets);
+
+    AddInfo(FString::Printf(TEXT("Loopback ANC: %s"), *Report.ToString()));
+
+    return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
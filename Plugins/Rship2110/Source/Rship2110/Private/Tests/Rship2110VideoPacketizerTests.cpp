@@ -0,0 +1,359 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "Rivermax/Rship2110VideoPacketizer.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Math/RandomStream.h"
+
+namespace Rship2110VideoPacketizerTests
+{
+    constexpr uint8 PayloadType = 96;
+    constexpr uint32 SSRC = 0x2110C0DE;
+
+    struct FFormatCase
+    {
+        int32 Width;
+        int32 Height;
+        ERship2110ColorFormat ColorFormat;
+        ERship2110BitDepth BitDepth;
+        ERship2110PackingMode PackingMode;
+    };
+
+    const FFormatCase FormatCases[] =
+    {
+        { 1920, 1080, ERship2110ColorFormat::YCbCr_422, ERship2110BitDepth::Bits_10, ERship2110PackingMode::GPM },
+        { 1920, 1080, ERship2110ColorFormat::YCbCr_422, ERship2110BitDepth::Bits_10, ERship2110PackingMode::BPM },
+        { 3840, 2160, ERship2110ColorFormat::YCbCr_422, ERship2110BitDepth::Bits_10, ERship2110PackingMode::GPM },
+        { 1280, 720,  ERship2110ColorFormat::YCbCr_422, ERship2110BitDepth::Bits_8,  ERship2110PackingMode::BPM },
+        { 720,  486,  ERship2110ColorFormat::YCbCr_444, ERship2110BitDepth::Bits_12, ERship2110PackingMode::BPM },
+        { 1280, 720,  ERship2110ColorFormat::RGB_444,   ERship2110BitDepth::Bits_10, ERship2110PackingMode::GPM },
+        { 2048, 1080, ERship2110ColorFormat::RGB_444,   ERship2110BitDepth::Bits_8,  ERship2110PackingMode::GPM },
+        { 640,  480,  ERship2110ColorFormat::RGBA_4444, ERship2110BitDepth::Bits_16, ERship2110PackingMode::GPM },
+    };
+
+    FRship2110VideoFormat MakeFormat(const FFormatCase& Case)
+    {
+        FRship2110VideoFormat Format;
+        Format.Width = Case.Width;
+        Format.Height = Case.Height;
+        Format.ColorFormat = Case.ColorFormat;
+        Format.BitDepth = Case.BitDepth;
+        Format.PackingMode = Case.PackingMode;
+        return Format;
+    }
+
+    FString Describe(const FRship2110VideoFormat& Format)
+    {
+        return FString::Printf(TEXT("%dx%d %s %d-bit %s"), Format.Width, Format.Height, *Format.GetSampling(),
+                               Format.GetBitDepthInt(), *Format.GetPackingModeString());
+    }
+
+    TArray<uint8> MakeFrame(int64 Bytes, int32 Seed)
+    {
+        TArray<uint8> Frame;
+        Frame.SetNumUninitialized(static_cast<int32>(Bytes));
+        FRandomStream Random(Seed);
+        for (uint8& Byte : Frame)
+        {
+            Byte = static_cast<uint8>(Random.RandHelper(256));
+        }
+        return Frame;
+    }
+
+    uint32 ReadBE16(const uint8* Source)
+    {
+        return (static_cast<uint32>(Source[0]) << 8) | Source[1];
+    }
+
+    uint32 ReadBE32(const uint8* Source)
+    {
+        return (ReadBE16(Source) << 16) | ReadBE16(Source + 2);
+    }
+
+    uint32 GetSequenceNumber(const FRship2110Packet& Packet)
+    {
+        return (ReadBE16(Packet.Data + FRship2110VideoPacketizer::RTPHeaderSize) << 16) | ReadBE16(Packet.Data + 2);
+    }
+
+    // Check one packet's headers against the format; returns its sample data bytes, or -1
+    int32 CheckPacket(FAutomationTestBase& Test, const FString& What, const FRship2110VideoFormat& Format,
+                      const FRship2110Packet& Packet, bool bLast, uint32 Timestamp)
+    {
+        using FPacketizer = FRship2110VideoPacketizer;
+        const uint8* Data = Packet.Data;
+
+        if (Packet.Size > FPacketizer::DefaultMaxPacketSize || (Data[0] >> 6) != 2 || (Data[1] & 0x7F) != PayloadType ||
+            ReadBE32(Data + 4) != Timestamp || ReadBE32(Data + 8) != SSRC)
+        {
+            Test.AddError(FString::Printf(TEXT("%s: bad RTP header"), *What));
+            return -1;
+        }
+        if (((Data[1] & 0x80) != 0) != bLast)
+        {
+            Test.AddError(FString::Printf(TEXT("%s: marker bit must be set on the last packet only"), *What));
+            return -1;
+        }
+
+        int32 Cursor = FPacketizer::RTPHeaderSize + FPacketizer::PayloadHeaderSize;
+        int32 NumSRDs = 0;
+        int32 DataBytes = 0;
+        bool bContinuation = true;
+        while (bContinuation)
+        {
+            const int32 Length = static_cast<int32>(ReadBE16(Data + Cursor));
+            const uint32 RowField = ReadBE16(Data + Cursor + 2);
+            const uint32 OffsetField = ReadBE16(Data + Cursor + 4);
+            bContinuation = (OffsetField & 0x8000) != 0;
+
+            if (RowField & 0x8000)
+            {
+                Test.AddError(FString::Printf(TEXT("%s: field bit set on a progressive frame"), *What));
+                return -1;
+            }
+            if (Length <= 0 || Length % Format.GetPGroupSize() != 0 || (OffsetField & 0x7FFF) % Format.GetPGroupCoverage() != 0)
+            {
+                Test.AddError(FString::Printf(TEXT("%s: SRD not on a pgroup boundary"), *What));
+                return -1;
+            }
+
+            DataBytes += Length;
+            Cursor += FPacketizer::SRDHeaderSize;
+            NumSRDs++;
+        }
+
+        if (NumSRDs > FPacketizer::MaxSRDsPerPacket || Cursor + DataBytes != Packet.Size)
+        {
+            Test.AddError(FString::Printf(TEXT("%s: %d SRDs, %d data bytes in a %d-byte packet"), *What, NumSRDs, DataBytes, Packet.Size));
+            return -1;
+        }
+
+        return DataBytes;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110VideoPacketizerLoopbackTest,
+    "Rship.2110.VideoPacketizer.Loopback",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110VideoPacketizerLoopbackTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110VideoPacketizerTests;
+
+    for (int32 CaseIndex = 0; CaseIndex < UE_ARRAY_COUNT(FormatCases); ++CaseIndex)
+    {
+        const FRship2110VideoFormat Format = MakeFormat(FormatCases[CaseIndex]);
+        const FString What = Describe(Format);
+
+        FRship2110VideoPacketizer Packetizer;
+        FRship2110VideoDepacketizer Depacketizer;
+        if (!TestTrue(What + TEXT(" configures"), Packetizer.Configure(Format, PayloadType, SSRC)) ||
+            !TestTrue(What + TEXT(" depacketizer configures"), Depacketizer.Configure(Format)))
+        {
+            continue;
+        }
+        TestEqual(What + TEXT(" frame size"), Packetizer.GetFrameBytes(), Format.GetFrameSizeBytes());
+
+        constexpr uint32 FirstSequence = 0x0003FF00;
+        Packetizer.SetExtendedSequenceNumber(FirstSequence);
+
+        // Two frames through the same arena, the second with fresh content
+        for (int32 FrameIndex = 0; FrameIndex < 2; ++FrameIndex)
+        {
+            const TArray<uint8> Frame = MakeFrame(Format.GetFrameSizeBytes(), CaseIndex * 2 + FrameIndex);
+            const uint32 Timestamp = 0x12345678u + FrameIndex * 1500;
+            const TConstArrayView<FRship2110Packet> Packets = Packetizer.PacketizeFrame(Frame.GetData(), Timestamp);
+
+            TestEqual(What + TEXT(" packet count"), Packets.Num(), Packetizer.GetPacketsPerFrame());
+
+            int64 TotalData = 0;
+            bool bHeadersValid = true;
+            for (int32 i = 0; i < Packets.Num(); ++i)
+            {
+                const uint32 Expected = FirstSequence + FrameIndex * Packets.Num() + i;
+                if (GetSequenceNumber(Packets[i]) != Expected)
+                {
+                    AddError(FString::Printf(TEXT("%s: packet %d has sequence %08x, expected %08x"), *What, i, GetSequenceNumber(Packets[i]), Expected));
+                    bHeadersValid = false;
+                    break;
+                }
+
+                const int32 DataBytes = CheckPacket(*this, What, Format, Packets[i], i == Packets.Num() - 1, Timestamp);
+                if (DataBytes < 0)
+                {
+                    bHeadersValid = false;
+                    break;
+                }
+                TotalData += DataBytes;
+
+                if (Format.PackingMode == ERship2110PackingMode::BPM && i < Packets.Num() - 1 &&
+                    DataBytes != FRship2110VideoPacketizer::BPMPacketDataSize)
+                {
+                    AddError(FString::Printf(TEXT("%s: BPM packet %d carries %d bytes"), *What, i, DataBytes));
+                    bHeadersValid = false;
+                    break;
+                }
+            }
+            if (!bHeadersValid)
+            {
+                break;
+            }
+            TestEqual(What + TEXT(" every sample sent once"), TotalData, Format.GetFrameSizeBytes());
+
+            // Deliver out of order; only the marker packet has to come last
+            for (int32 i = Packets.Num() - 2; i >= 0; --i)
+            {
+                TestFalse(What + TEXT(" no frame before the marker"), Depacketizer.ReceivePacket(Packets[i].Data, Packets[i].Size));
+            }
+            const FRship2110Packet& Last = Packets.Last();
+            TestTrue(What + TEXT(" marker ends the frame"), Depacketizer.ReceivePacket(Last.Data, Last.Size));
+            TestTrue(What + TEXT(" frame complete"), Depacketizer.IsFrameComplete());
+            TestEqual(What + TEXT(" timestamp"), Depacketizer.GetFrameTimestamp(), Timestamp);
+            TestTrue(What + TEXT(" reassembled bit-exact"),
+                Depacketizer.GetFrame().Num() == Frame.Num() &&
+                FMemory::Memcmp(Depacketizer.GetFrame().GetData(), Frame.GetData(), Frame.Num()) == 0);
+        }
+
+        TestEqual(What + TEXT(" no loss"), Depacketizer.GetStats().PacketsLost, int64(0));
+        TestEqual(What + TEXT(" nothing malformed"), Depacketizer.GetStats().PacketsMalformed, int64(0));
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110VideoPacketizerSequenceTest,
+    "Rship.2110.VideoPacketizer.ExtendedSequence",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110VideoPacketizerSequenceTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110VideoPacketizerTests;
+
+    const FRship2110VideoFormat Format = MakeFormat({ 1280, 720, ERship2110ColorFormat::YCbCr_422, ERship2110BitDepth::Bits_10, ERship2110PackingMode::GPM });
+    FRship2110VideoPacketizer Packetizer;
+    FRship2110VideoDepacketizer Depacketizer;
+    if (!TestTrue(TEXT("Configured"), Packetizer.Configure(Format, PayloadType, SSRC) && Depacketizer.Configure(Format)))
+    {
+        return false;
+    }
+
+    // The RTP sequence number wraps mid-frame; the payload header carries into the high half
+    constexpr uint32 FirstSequence = 0x0001FFF0;
+    Packetizer.SetExtendedSequenceNumber(FirstSequence);
+    const TArray<uint8> Frame = MakeFrame(Format.GetFrameSizeBytes(), 7);
+    const TConstArrayView<FRship2110Packet> Packets = Packetizer.PacketizeFrame(Frame.GetData(), 0);
+
+    TestEqual(TEXT("Low half before the wrap"), ReadBE16(Packets[15].Data + 2), 0xFFFFu);
+    TestEqual(TEXT("High half before the wrap"), ReadBE16(Packets[15].Data + 12), 0x0001u);
+    TestEqual(TEXT("Low half after the wrap"), ReadBE16(Packets[16].Data + 2), 0x0000u);
+    TestEqual(TEXT("High half after the wrap"), ReadBE16(Packets[16].Data + 12), 0x0002u);
+    TestEqual(TEXT("Next sequence number"), Packetizer.GetExtendedSequenceNumber(), FirstSequence + Packets.Num());
+
+    for (const FRship2110Packet& Packet : Packets)
+    {
+        Depacketizer.ReceivePacket(Packet.Data, Packet.Size);
+    }
+    TestTrue(TEXT("Frame complete across the wrap"), Depacketizer.IsFrameComplete());
+    TestEqual(TEXT("No loss across the wrap"), Depacketizer.GetStats().PacketsLost, int64(0));
+    TestEqual(TEXT("Last sequence number"), Depacketizer.GetLastSequenceNumber(), FirstSequence + Packets.Num() - 1);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110VideoPacketizerLossTest,
+    "Rship.2110.VideoPacketizer.Loss",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110VideoPacketizerLossTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110VideoPacketizerTests;
+
+    const FRship2110VideoFormat Format = MakeFormat({ 1920, 1080, ERship2110ColorFormat::YCbCr_422, ERship2110BitDepth::Bits_10, ERship2110PackingMode::BPM });
+    FRship2110VideoPacketizer Packetizer;
+    FRship2110VideoDepacketizer Depacketizer;
+    if (!TestTrue(TEXT("Configured"), Packetizer.Configure(Format, PayloadType, SSRC) && Depacketizer.Configure(Format)))
+    {
+        return false;
+    }
+
+    const TArray<uint8> Frame = MakeFrame(Format.GetFrameSizeBytes(), 11);
+
+    // Drop one packet from the first frame
+    TConstArrayView<FRship2110Packet> Packets = Packetizer.PacketizeFrame(Frame.GetData(), 1000);
+    for (int32 i = 0; i < Packets.Num(); ++i)
+    {
+        if (i != 100)
+        {
+            Depacketizer.ReceivePacket(Packets[i].Data, Packets[i].Size);
+        }
+    }
+    TestFalse(TEXT("Frame with a hole is incomplete"), Depacketizer.IsFrameComplete());
+    TestEqual(TEXT("One packet lost"), Depacketizer.GetStats().PacketsLost, int64(1));
+
+    // Lose the marker of the second frame; the third frame's first packet closes it
+    Packets = Packetizer.PacketizeFrame(Frame.GetData(), 2500);
+    for (int32 i = 0; i < Packets.Num() - 1; ++i)
+    {
+        Depacketizer.ReceivePacket(Packets[i].Data, Packets[i].Size);
+    }
+
+    Packets = Packetizer.PacketizeFrame(Frame.GetData(), 4000);
+    for (const FRship2110Packet& Packet : Packets)
+    {
+        Depacketizer.ReceivePacket(Packet.Data, Packet.Size);
+    }
+    TestTrue(TEXT("Clean frame after losses is complete"), Depacketizer.IsFrameComplete());
+    TestEqual(TEXT("Two packets lost"), Depacketizer.GetStats().PacketsLost, int64(2));
+    TestEqual(TEXT("One frame complete"), Depacketizer.GetStats().FramesComplete, int64(1));
+    TestEqual(TEXT("Two frames incomplete"), Depacketizer.GetStats().FramesIncomplete, int64(2));
+
+    // Truncated packet
+    TestFalse(TEXT("Truncated packet rejected"), Depacketizer.ReceivePacket(Packets[0].Data, 16));
+    TestEqual(TEXT("Malformed counted"), Depacketizer.GetStats().PacketsMalformed, int64(1));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRship2110VideoPacketizerConfigureTest,
+    "Rship.2110.VideoPacketizer.Configure",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRship2110VideoPacketizerConfigureTest::RunTest(const FString& Parameters)
+{
+    using namespace Rship2110VideoPacketizerTests;
+
+    FRship2110VideoPacketizer Packetizer;
+
+    // 1080p 4:2:2 10-bit BPM: 5,184,000 bytes in 1260-byte packets
+    TestTrue(TEXT("BPM 4:2:2 10-bit"), Packetizer.Configure(
+        MakeFormat({ 1920, 1080, ERship2110ColorFormat::YCbCr_422, ERship2110BitDepth::Bits_10, ERship2110PackingMode::BPM }), PayloadType, SSRC));
+    TestEqual(TEXT("BPM packets per frame"), Packetizer.GetPacketsPerFrame(), 4115);
+
+    // 16-bit 4:2:2 pgroups are 8 bytes, which do not tile a 180-byte block
+    TestFalse(TEXT("BPM rejects 8-byte pgroups"), Packetizer.Configure(
+        MakeFormat({ 1920, 1080, ERship2110ColorFormat::YCbCr_422, ERship2110BitDepth::Bits_16, ERship2110PackingMode::BPM }), PayloadType, SSRC));
+    TestFalse(TEXT("Rejected packetizer is invalid"), Packetizer.IsValid());
+
+    TestFalse(TEXT("Width must be whole pgroups"), Packetizer.Configure(
+        MakeFormat({ 1918, 1080, ERship2110ColorFormat::RGB_444, ERship2110BitDepth::Bits_10, ERship2110PackingMode::GPM }), PayloadType, SSRC));
+
+    TestFalse(TEXT("BPM needs room for three SRDs"), Packetizer.Configure(
+        MakeFormat({ 1920, 1080, ERship2110ColorFormat::YCbCr_422, ERship2110BitDepth::Bits_10, ERship2110PackingMode::BPM }), PayloadType, SSRC, 1200));
+
+    // Jumbo frames: GPM grows packets to the limit
+    const FRship2110VideoFormat Format = MakeFormat({ 1920, 1080, ERship2110ColorFormat::YCbCr_422, ERship2110BitDepth::Bits_10, ERship2110PackingMode::GPM });
+    TestTrue(TEXT("GPM standard"), Packetizer.Configure(Format, PayloadType, SSRC));
+    const int32 StandardPackets = Packetizer.GetPacketsPerFrame();
+    TestTrue(TEXT("GPM jumbo"), Packetizer.Configure(Format, PayloadType, SSRC, 8960));
+    TestTrue(TEXT("Jumbo packets are fewer"), Packetizer.GetPacketsPerFrame() * 5 < StandardPackets);
+    TestTrue(TEXT("Wire overhead is small"), Packetizer.GetWireBytesPerFrame() < Format.GetFrameSizeBytes() * 101 / 100);
+
+    return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
@@ -0,0 +1,597 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "IPMX/RshipIPMXService.h"
+#include "IPMX/RshipNMOSConnection.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Rivermax/Rship2110VideoSender.h"
+#include "Rivermax/RivermaxManager.h"
+#include "Rship2110Subsystem.h"
+#include "Engine/Engine.h"
+#include "HttpModule.h"
+#include "HttpPath.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace RshipIPMXServiceTests
+{
+    /** Out of the way of a running node's 3212/3215 */
+    constexpr int32 TestAPIPort = 38212;
+
+    /** Port for the mock IS-04 registry */
+    constexpr int32 TestRegistryPort = 38235;
+
+    constexpr double RequestTimeoutSeconds = 10.0;
+
+    TSharedPtr<FJsonObject> ParseObject(const FString& Text)
+    {
+        TSharedPtr<FJsonObject> Object;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
+        FJsonSerializer::Deserialize(Reader, Object);
+        return Object;
+    }
+
+    TArray<TSharedPtr<FJsonValue>> ParseArray(const FString& Text)
+    {
+        TArray<TSharedPtr<FJsonValue>> Array;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
+        FJsonSerializer::Deserialize(Reader, Array);
+        return Array;
+    }
+
+    FRshipPTPTimestamp MakeTime(int64 Seconds, int32 Nanoseconds)
+    {
+        FRshipPTPTimestamp Time;
+        Time.Seconds = Seconds;
+        Time.Nanoseconds = Nanoseconds;
+        return Time;
+    }
+
+    FRship2110TransportParams MakeParams()
+    {
+        FRship2110TransportParams Params;
+        Params.SourceIP = TEXT("127.0.0.1");
+        Params.DestinationIP = TEXT("127.0.0.1");
+        Params.SourcePort = 39004;
+        Params.DestinationPort = 39006;
+        return Params;
+    }
+
+    int32 Patch(FRshipNMOSSenderConnection& Connection, const FString& Body, const FRshipPTPTimestamp& Now)
+    {
+        FString Error;
+        return Connection.PatchStaged(ParseObject(Body), Now, Error);
+    }
+
+    /**
+     * Sends one request to the local API and hands the status and body to
+     * Check once it completes. Code is 0 if no response came in time.
+     */
+    class FAPIRequestCommand : public IAutomationLatentCommand
+    {
+    public:
+        FAPIRequestCommand(const FString& InVerb, const FString& InPath, const FString& InBody,
+                           TFunction<void(int32, const FString&)> InCheck)
+            : Verb(InVerb), Path(InPath), Body(InBody), Check(MoveTemp(InCheck))
+        {
+        }
+
+        virtual bool Update() override
+        {
+            if (!Request.IsValid())
+            {
+                Request = FHttpModule::Get().CreateRequest();
+                Request->SetURL(FString::Printf(TEXT("http://127.0.0.1:%d%s"), TestAPIPort, *Path));
+                Request->SetVerb(Verb);
+                if (!Body.IsEmpty())
+                {
+                    Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+                    Request->SetContentAsString(Body);
+                }
+                Request->ProcessRequest();
+                return false;
+            }
+
+            if (!EHttpRequestStatus::IsFinished(Request->GetStatus()))
+            {
+                if (GetCurrentRunTime() < RequestTimeoutSeconds)
+                {
+                    return false;
+                }
+                Request->CancelRequest();
+                Check(0, FString());
+                return true;
+            }
+
+            FHttpResponsePtr Response = Request->GetResponse();
+            Check(Response.IsValid() ? Response->GetResponseCode() : 0,
+                  Response.IsValid() ? Response->GetContentAsString() : FString());
+            return true;
+        }
+
+    private:
+        FString Verb;
+        FString Path;
+        FString Body;
+        TFunction<void(int32, const FString&)> Check;
+        TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> Request;
+    };
+
+    /**
+     * Stand-in for an IS-04 Registration API. Accepts every request and
+     * records resource POSTs in arrival order.
+     */
+    class FMockRegistry
+    {
+    public:
+        struct FPost
+        {
+            FString Type;
+            TSharedPtr<FJsonObject> Data;
+        };
+
+        ~FMockRegistry()
+        {
+            Stop();
+        }
+
+        bool Start()
+        {
+            Router = FHttpServerModule::Get().GetHttpRouter(TestRegistryPort, /*bFailOnBindFailure=*/ true);
+            if (!Router.IsValid())
+            {
+                return false;
+            }
+
+            Route = Router->BindRoute(FHttpPath(TEXT("/x-nmos/registration")),
+                EHttpServerRequestVerbs::VERB_POST | EHttpServerRequestVerbs::VERB_DELETE,
+                FHttpRequestHandler::CreateLambda([this](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+                {
+                    return HandleRequest(Request, OnComplete);
+                }));
+            if (!Route.IsValid())
+            {
+                return false;
+            }
+
+            FHttpServerModule::Get().StartAllListeners();
+            return true;
+        }
+
+        void Stop()
+        {
+            if (Router.IsValid() && Route.IsValid())
+            {
+                Router->UnbindRoute(Route);
+            }
+            Route.Reset();
+        }
+
+        FString GetUrl() const
+        {
+            return FString::Printf(TEXT("http://127.0.0.1:%d"), TestRegistryPort);
+        }
+
+        int32 CountPosts(const FString& Type) const
+        {
+            return Posts.FilterByPredicate([&Type](const FPost& Post) { return Post.Type == Type; }).Num();
+        }
+
+        /** Data of the latest POST of a type, or null */
+        TSharedPtr<FJsonObject> FindLast(const FString& Type) const
+        {
+            for (int32 Index = Posts.Num() - 1; Index >= 0; --Index)
+            {
+                if (Posts[Index].Type == Type)
+                {
+                    return Posts[Index].Data;
+                }
+            }
+            return nullptr;
+        }
+
+        TArray<FPost> Posts;
+        int32 Heartbeats = 0;
+
+    private:
+        bool HandleRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+        {
+            const FString Path = Request.RelativePath.GetPath();
+            if (Request.Verb == EHttpServerRequestVerbs::VERB_POST && Path.EndsWith(TEXT("/resource")))
+            {
+                FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Request.Body.GetData()), Request.Body.Num());
+                TSharedPtr<FJsonObject> Body = ParseObject(FString(Converter.Length(), Converter.Get()));
+
+                FPost& Post = Posts.AddDefaulted_GetRef();
+                if (Body.IsValid())
+                {
+                    Post.Type = Body->GetStringField(TEXT("type"));
+                    const TSharedPtr<FJsonObject>* Data = nullptr;
+                    Post.Data = Body->TryGetObjectField(TEXT("data"), Data) ? *Data : nullptr;
+                }
+            }
+            else if (Request.Verb == EHttpServerRequestVerbs::VERB_POST && Path.Contains(TEXT("/health/nodes/")))
+            {
+                ++Heartbeats;
+            }
+
+            OnComplete(FHttpServerResponse::Create(TEXT("{}"), TEXT("application/json")));
+            return true;
+        }
+
+        TSharedPtr<IHttpRouter> Router;
+        FHttpRouteHandle Route;
+    };
+
+    /** Ticks the service until Condition holds or the timeout passes */
+    class FTickServiceCommand : public IAutomationLatentCommand
+    {
+    public:
+        FTickServiceCommand(URshipIPMXService* InService, TFunction<bool()> InCondition)
+            : Service(InService), Condition(MoveTemp(InCondition))
+        {
+        }
+
+        virtual bool Update() override
+        {
+            Service->Tick(0.0f);
+            return Condition() || GetCurrentRunTime() >= RequestTimeoutSeconds;
+        }
+
+    private:
+        URshipIPMXService* Service;
+        TFunction<bool()> Condition;
+    };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipIPMXConnectionTest,
+    "Rship.2110.IPMX.Connection",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipIPMXConnectionTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipIPMXServiceTests;
+
+    const FRshipPTPTimestamp Now = MakeTime(100, 0);
+
+    FRshipNMOSSenderConnection Connection;
+    Connection.Initialize(MakeParams());
+    TestFalse(TEXT("Starts disabled"), Connection.GetActive().bMasterEnable);
+    TestEqual(TEXT("Starts from the stream's destination"), Connection.GetActive().Transport.DestinationPort, 39006);
+
+    // Staging without an activation changes nothing active
+    TestEqual(TEXT("Stage"), Patch(Connection,
+        TEXT("{\"master_enable\":true,\"transport_params\":[{\"destination_ip\":\"239.1.2.3\",\"destination_port\":5010,\"source_port\":\"auto\"}]}"), Now), 200);
+    TestTrue(TEXT("Staged enable"), Connection.GetStaged().bMasterEnable);
+    TestFalse(TEXT("Active untouched"), Connection.GetActive().bMasterEnable);
+    TestFalse(TEXT("Nothing due"), Connection.IsActivationDue(Now));
+
+    // Invalid requests leave the staged parameters as they were
+    TestEqual(TEXT("Two legs"), Patch(Connection, TEXT("{\"transport_params\":[{},{}]}"), Now), 400);
+    TestEqual(TEXT("Unknown key"), Patch(Connection, TEXT("{\"colour\":\"red\"}"), Now), 400);
+    TestEqual(TEXT("Port below range"), Patch(Connection, TEXT("{\"transport_params\":[{\"destination_port\":80}]}"), Now), 400);
+    TestEqual(TEXT("Bad address"), Patch(Connection, TEXT("{\"transport_params\":[{\"destination_ip\":\"239.1.2\"}]}"), Now), 400);
+    TestEqual(TEXT("Numeric receiver"), Patch(Connection, TEXT("{\"receiver_id\":5}"), Now), 400);
+    TestEqual(TEXT("Bad mode"), Patch(Connection, TEXT("{\"activation\":{\"mode\":\"activate_later\"}}"), Now), 400);
+    TestEqual(TEXT("Bad time"), Patch(Connection,
+        TEXT("{\"activation\":{\"mode\":\"activate_scheduled_relative\",\"requested_time\":\"2.5\"}}"), Now), 400);
+    TestEqual(TEXT("Staged port kept"), Connection.GetStaged().Transport.DestinationPort, 5010);
+
+    // "auto" resolves to the stream's current value
+    const FRship2110TransportParams Resolved = Connection.ResolveTransport(MakeParams());
+    TestEqual(TEXT("Resolved destination"), Resolved.DestinationIP, FString(TEXT("239.1.2.3")));
+    TestEqual(TEXT("Resolved auto source port"), Resolved.SourcePort, 39004);
+
+    // Immediate activations are due at once
+    TestEqual(TEXT("Immediate"), Patch(Connection, TEXT("{\"activation\":{\"mode\":\"activate_immediate\"}}"), Now), 200);
+    TestTrue(TEXT("Immediate is due"), Connection.IsActivationDue(Now));
+    Connection.CompleteActivation(Resolved);
+    TestTrue(TEXT("Active enable"), Connection.GetActive().bMasterEnable);
+    TestEqual(TEXT("Active port"), Connection.GetActive().Transport.DestinationPort, 5010);
+    TestTrue(TEXT("Staged activation cleared"), Connection.GetStaged().Activation.Mode == ERshipNMOSActivationMode::None);
+
+    TSharedPtr<FJsonObject> ActiveJson = Connection.GetActiveJson();
+    TestEqual(TEXT("Active JSON mode"), ActiveJson->GetObjectField(TEXT("activation"))->GetStringField(TEXT("mode")),
+              FString(TEXT("activate_immediate")));
+    TestEqual(TEXT("Active JSON time"), ActiveJson->GetObjectField(TEXT("activation"))->GetStringField(TEXT("activation_time")),
+              FString(TEXT("100:0")));
+
+    // Relative activations are offset from now and lock the staged parameters
+    TestEqual(TEXT("Relative"), Patch(Connection,
+        TEXT("{\"master_enable\":false,\"activation\":{\"mode\":\"activate_scheduled_relative\",\"requested_time\":\"2:500000000\"}}"), Now), 202);
+    TestEqual(TEXT("Relative activation time"),
+              FRshipNMOSSenderConnection::FormatTime(Connection.GetStaged().Activation.ActivationTime), FString(TEXT("102:500000000")));
+    TestFalse(TEXT("Not yet due"), Connection.IsActivationDue(MakeTime(102, 499999999)));
+    TestTrue(TEXT("Due on time"), Connection.IsActivationDue(MakeTime(102, 500000000)));
+    TestEqual(TEXT("Locked while pending"), Patch(Connection, TEXT("{\"master_enable\":true}"), Now), 423);
+
+    // A null mode cancels it
+    TestEqual(TEXT("Cancel"), Patch(Connection, TEXT("{\"activation\":{\"mode\":null}}"), Now), 200);
+    TestFalse(TEXT("Cancelled"), Connection.IsActivationDue(MakeTime(200, 0)));
+
+    // Absolute times already past are due at once
+    TestEqual(TEXT("Absolute"), Patch(Connection,
+        TEXT("{\"activation\":{\"mode\":\"activate_scheduled_absolute\",\"requested_time\":\"50:0\"}}"), Now), 202);
+    TestTrue(TEXT("Past absolute is due"), Connection.IsActivationDue(Now));
+    Connection.CancelActivation();
+
+    FRshipPTPTimestamp Parsed;
+    TestTrue(TEXT("Parse"), FRshipNMOSSenderConnection::ParseTime(TEXT("1700000000:123456789"), Parsed));
+    TestEqual(TEXT("Round trip"), FRshipNMOSSenderConnection::FormatTime(Parsed), FString(TEXT("1700000000:123456789")));
+    TestFalse(TEXT("Nanoseconds overflow"), FRshipNMOSSenderConnection::ParseTime(TEXT("1:1000000000"), Parsed));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipIPMXLocalAPITest,
+    "Rship.2110.IPMX.LocalAPI",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipIPMXLocalAPITest::RunTest(const FString& Parameters)
+{
+    using namespace RshipIPMXServiceTests;
+
+    FRship2110VideoFormat Format;
+    Format.Width = 64;
+    Format.Height = 36;
+
+    URivermaxManager* Manager = NewObject<URivermaxManager>();
+    URship2110VideoSender* VideoSender = NewObject<URship2110VideoSender>();
+    URshipIPMXService* Service = NewObject<URshipIPMXService>();
+    Manager->AddToRoot();
+    VideoSender->AddToRoot();
+    Service->AddToRoot();
+
+    // The service only needs the subsystem for settings and the PTP clock
+    if (!TestTrue(TEXT("Sender initializes"), VideoSender->Initialize(Manager, nullptr, Format, MakeParams())) ||
+        !TestTrue(TEXT("Service initializes"), Service->Initialize(GEngine->GetEngineSubsystem<URship2110Subsystem>())) ||
+        !TestTrue(TEXT("API listens"), Service->StartLocalAPIServer(TestAPIPort)))
+    {
+        Service->Shutdown();
+        VideoSender->Shutdown();
+        Service->RemoveFromRoot();
+        VideoSender->RemoveFromRoot();
+        Manager->RemoveFromRoot();
+        return false;
+    }
+
+    const FString SenderId = Service->RegisterSender(VideoSender);
+    const FString SenderPath = FString::Printf(TEXT("/x-nmos/connection/v1.1/single/senders/%s"), *SenderId);
+
+    // IS-04 Node API
+    ADD_LATENT_AUTOMATION_COMMAND(FAPIRequestCommand(TEXT("GET"), TEXT("/x-nmos/node/v1.3/self"), FString(),
+        [this, Service](int32 Code, const FString& Body)
+        {
+            TestEqual(TEXT("self"), Code, 200);
+            TSharedPtr<FJsonObject> Self = ParseObject(Body);
+            if (TestTrue(TEXT("self is an object"), Self.IsValid()))
+            {
+                TestEqual(TEXT("self id"), Self->GetStringField(TEXT("id")), Service->GetNodeId());
+                TestEqual(TEXT("self endpoints"), Self->GetObjectField(TEXT("api"))->GetArrayField(TEXT("endpoints")).Num(), 1);
+            }
+        }));
+
+    ADD_LATENT_AUTOMATION_COMMAND(FAPIRequestCommand(TEXT("GET"), TEXT("/x-nmos/node/v1.3/senders"), FString(),
+        [this, SenderId](int32 Code, const FString& Body)
+        {
+            TestEqual(TEXT("senders"), Code, 200);
+            TArray<TSharedPtr<FJsonValue>> Senders = ParseArray(Body);
+            if (TestEqual(TEXT("one sender"), Senders.Num(), 1))
+            {
+                TestEqual(TEXT("sender id"), Senders[0]->AsObject()->GetStringField(TEXT("id")), SenderId);
+            }
+        }));
+
+    ADD_LATENT_AUTOMATION_COMMAND(FAPIRequestCommand(TEXT("GET"), TEXT("/x-nmos/node/v1.3/flows"), FString(),
+        [this](int32 Code, const FString& Body)
+        {
+            TestEqual(TEXT("flows"), Code, 200);
+            TArray<TSharedPtr<FJsonValue>> Flows = ParseArray(Body);
+            if (TestEqual(TEXT("one flow"), Flows.Num(), 1))
+            {
+                TestEqual(TEXT("flow width"), static_cast<int32>(Flows[0]->AsObject()->GetNumberField(TEXT("frame_width"))), 64);
+                TestEqual(TEXT("flow components"), Flows[0]->AsObject()->GetArrayField(TEXT("components")).Num(), 3);
+            }
+        }));
+
+    ADD_LATENT_AUTOMATION_COMMAND(FAPIRequestCommand(TEXT("GET"), TEXT("/x-nmos/node/v1.3/widgets"), FString(),
+        [this](int32 Code, const FString& Body)
+        {
+            TestEqual(TEXT("unknown resource"), Code, 404);
+        }));
+
+    ADD_LATENT_AUTOMATION_COMMAND(FAPIRequestCommand(TEXT("PUT"), TEXT("/x-nmos/node/v1.3/self"), TEXT("{}"),
+        [this](int32 Code, const FString& Body)
+        {
+            TestEqual(TEXT("Node API is read-only"), Code, 405);
+        }));
+
+    // IS-05 immediate activation moves and starts the stream
+    ADD_LATENT_AUTOMATION_COMMAND(FAPIRequestCommand(TEXT("PATCH"), SenderPath + TEXT("/staged"),
+        TEXT("{\"master_enable\":true,\"transport_params\":[{\"destination_port\":39010}],\"activation\":{\"mode\":\"activate_immediate\"}}"),
+        [this, VideoSender](int32 Code, const FString& Body)
+        {
+            TestEqual(TEXT("immediate PATCH"), Code, 200);
+            TSharedPtr<FJsonObject> Staged = ParseObject(Body);
+            if (TestTrue(TEXT("staged is an object"), Staged.IsValid()))
+            {
+                TestFalse(TEXT("activation time reported"),
+                          Staged->GetObjectField(TEXT("activation"))->HasTypedField<EJson::Null>(TEXT("activation_time")));
+            }
+            TestEqual(TEXT("stream moved"), VideoSender->GetTransportParams().DestinationPort, 39010);
+            TestTrue(TEXT("stream started"), VideoSender->IsStreaming());
+        }));
+
+    ADD_LATENT_AUTOMATION_COMMAND(FAPIRequestCommand(TEXT("GET"), SenderPath + TEXT("/active"), FString(),
+        [this](int32 Code, const FString& Body)
+        {
+            TestEqual(TEXT("active"), Code, 200);
+            TSharedPtr<FJsonObject> Active = ParseObject(Body);
+            if (TestTrue(TEXT("active is an object"), Active.IsValid()))
+            {
+                TestTrue(TEXT("active enabled"), Active->GetBoolField(TEXT("master_enable")));
+                TestEqual(TEXT("active port"), static_cast<int32>(
+                    Active->GetArrayField(TEXT("transport_params"))[0]->AsObject()->GetNumberField(TEXT("destination_port"))), 39010);
+            }
+        }));
+
+    ADD_LATENT_AUTOMATION_COMMAND(FAPIRequestCommand(TEXT("GET"), SenderPath + TEXT("/transportfile"), FString(),
+        [this](int32 Code, const FString& Body)
+        {
+            TestEqual(TEXT("transportfile"), Code, 200);
+            TestTrue(TEXT("SDP has the new port"), Body.Contains(TEXT("m=video 39010")));
+        }));
+
+    // Bulk entries succeed or fail on their own
+    ADD_LATENT_AUTOMATION_COMMAND(FAPIRequestCommand(TEXT("POST"), TEXT("/x-nmos/connection/v1.1/bulk/senders"),
+        FString::Printf(TEXT("[{\"id\":\"%s\",\"params\":{\"receiver_id\":null}},{\"id\":\"missing\",\"params\":{}}]"), *SenderId),
+        [this](int32 Code, const FString& Body)
+        {
+            TestEqual(TEXT("bulk"), Code, 200);
+            TArray<TSharedPtr<FJsonValue>> Results = ParseArray(Body);
+            if (TestEqual(TEXT("bulk results"), Results.Num(), 2))
+            {
+                TestEqual(TEXT("known sender"), static_cast<int32>(Results[0]->AsObject()->GetNumberField(TEXT("code"))), 200);
+                TestEqual(TEXT("unknown sender"), static_cast<int32>(Results[1]->AsObject()->GetNumberField(TEXT("code"))), 404);
+            }
+        }));
+
+    // Scheduled deactivation is accepted, then applied by Tick
+    ADD_LATENT_AUTOMATION_COMMAND(FAPIRequestCommand(TEXT("PATCH"), SenderPath + TEXT("/staged"),
+        TEXT("{\"master_enable\":false,\"activation\":{\"mode\":\"activate_scheduled_relative\",\"requested_time\":\"0:100000000\"}}"),
+        [this](int32 Code, const FString& Body)
+        {
+            TestEqual(TEXT("scheduled PATCH"), Code, 202);
+        }));
+
+    ADD_LATENT_AUTOMATION_COMMAND(FTickServiceCommand(Service, [VideoSender]() { return !VideoSender->IsStreaming(); }));
+
+    ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Service, VideoSender, Manager]()
+    {
+        TestFalse(TEXT("scheduled activation stopped the stream"), VideoSender->IsStreaming());
+
+        Service->Shutdown();
+        VideoSender->Shutdown();
+        Service->RemoveFromRoot();
+        VideoSender->RemoveFromRoot();
+        Manager->RemoveFromRoot();
+        return true;
+    }));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipIPMXRegistryTest,
+    "Rship.2110.IPMX.Registry",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipIPMXRegistryTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipIPMXServiceTests;
+
+    FRship2110VideoFormat Format;
+    Format.Width = 64;
+    Format.Height = 36;
+
+    TSharedRef<FMockRegistry> Registry = MakeShared<FMockRegistry>();
+    URivermaxManager* Manager = NewObject<URivermaxManager>();
+    URship2110VideoSender* VideoSender = NewObject<URship2110VideoSender>();
+    URshipIPMXService* Service = NewObject<URshipIPMXService>();
+    Manager->AddToRoot();
+    VideoSender->AddToRoot();
+    Service->AddToRoot();
+
+    auto Cleanup = [Registry, Service, VideoSender, Manager]()
+    {
+        Service->Shutdown();
+        VideoSender->Shutdown();
+        Service->RemoveFromRoot();
+        VideoSender->RemoveFromRoot();
+        Manager->RemoveFromRoot();
+        Registry->Stop();
+    };
+
+    if (!TestTrue(TEXT("Registry listens"), Registry->Start()) ||
+        !TestTrue(TEXT("Sender initializes"), VideoSender->Initialize(Manager, nullptr, Format, MakeParams())) ||
+        !TestTrue(TEXT("Service initializes"), Service->Initialize(GEngine->GetEngineSubsystem<URship2110Subsystem>())) ||
+        !TestTrue(TEXT("API listens"), Service->StartLocalAPIServer(TestAPIPort)))
+    {
+        Cleanup();
+        return false;
+    }
+
+    // A sender added before the registry is reached is posted once the device is
+    const FString SenderId = Service->RegisterSender(VideoSender);
+    TestTrue(TEXT("Connect"), Service->ConnectToRegistry(Registry->GetUrl()));
+
+    ADD_LATENT_AUTOMATION_COMMAND(FTickServiceCommand(Service, [Registry]() { return Registry->CountPosts(TEXT("sender")) > 0; }));
+
+    ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Registry, Service, SenderId]()
+    {
+        TArray<FString> Types;
+        for (const FMockRegistry::FPost& Post : Registry->Posts)
+        {
+            Types.Add(Post.Type);
+        }
+        TestEqual(TEXT("Resources posted parent first"), FString::Join(Types, TEXT(",")), FString(TEXT("node,device,source,flow,sender")));
+
+        const TSharedPtr<FJsonObject> Node = Registry->FindLast(TEXT("node"));
+        const TSharedPtr<FJsonObject> Device = Registry->FindLast(TEXT("device"));
+        const TSharedPtr<FJsonObject> Source = Registry->FindLast(TEXT("source"));
+        const TSharedPtr<FJsonObject> Flow = Registry->FindLast(TEXT("flow"));
+        const TSharedPtr<FJsonObject> Sender = Registry->FindLast(TEXT("sender"));
+        if (!TestTrue(TEXT("Every POST has data"), Node && Device && Source && Flow && Sender))
+        {
+            return true;
+        }
+
+        TestEqual(TEXT("node id"), Node->GetStringField(TEXT("id")), Service->GetNodeId());
+        TestEqual(TEXT("device under node"), Device->GetStringField(TEXT("node_id")), Service->GetNodeId());
+        TestEqual(TEXT("source under device"), Source->GetStringField(TEXT("device_id")), Device->GetStringField(TEXT("id")));
+        TestEqual(TEXT("flow from source"), Flow->GetStringField(TEXT("source_id")), Source->GetStringField(TEXT("id")));
+        TestEqual(TEXT("flow width"), static_cast<int32>(Flow->GetNumberField(TEXT("frame_width"))), 64);
+        TestEqual(TEXT("sender id"), Sender->GetStringField(TEXT("id")), SenderId);
+        TestEqual(TEXT("sender carries the flow"), Sender->GetStringField(TEXT("flow_id")), Flow->GetStringField(TEXT("id")));
+        TestFalse(TEXT("sender starts inactive"), Sender->GetObjectField(TEXT("subscription"))->GetBoolField(TEXT("active")));
+        return true;
+    }));
+
+    // An IS-05 activation changes the sender, which is posted again on the next Tick
+    ADD_LATENT_AUTOMATION_COMMAND(FAPIRequestCommand(TEXT("PATCH"),
+        FString::Printf(TEXT("/x-nmos/connection/v1.1/single/senders/%s/staged"), *SenderId),
+        TEXT("{\"master_enable\":true,\"activation\":{\"mode\":\"activate_immediate\"}}"),
+        [this](int32 Code, const FString& Body)
+        {
+            TestEqual(TEXT("immediate PATCH"), Code, 200);
+        }));
+
+    ADD_LATENT_AUTOMATION_COMMAND(FTickServiceCommand(Service, [Registry]() { return Registry->CountPosts(TEXT("sender")) > 1; }));
+
+    ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Registry, Cleanup]()
+    {
+        TestEqual(TEXT("sender re-posted once"), Registry->CountPosts(TEXT("sender")), 2);
+        TestEqual(TEXT("nothing else re-posted"), Registry->Posts.Num(), 6);
+        if (const TSharedPtr<FJsonObject> Sender = Registry->FindLast(TEXT("sender")))
+        {
+            TestTrue(TEXT("re-post carries the activation"), Sender->GetObjectField(TEXT("subscription"))->GetBoolField(TEXT("active")));
+        }
+
+        Cleanup();
+        return true;
+    }));
+
+    return true;
+}
+
+#endif  // WITH_AUTOMATION_TESTS
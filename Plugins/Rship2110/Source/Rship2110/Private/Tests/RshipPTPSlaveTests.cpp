@@ -0,0 +1,663 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "PTP/RshipPTPSlave.h"
+#include "PTP/IPTPProvider.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "HAL/PlatformProcess.h"
+#include "Math/RandomStream.h"
+#include "Misc/ScopeExit.h"
+#include "Rship2110Settings.h"
+
+#if PLATFORM_LINUX
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace RshipPTPSlaveTests
+{
+    constexpr uint64 MasterIdentity = 0x001122FFFE334455ULL;
+    constexpr uint64 SlaveIdentity = 0x66778899AABBCCDDULL;
+    constexpr uint8 Domain = 127;
+
+    FRshipPTPMessage MakeAnnounce(uint16 SequenceId)
+    {
+        FRshipPTPMessage Message;
+        Message.Type = FRshipPTPMessage::EType::Announce;
+        Message.Domain = Domain;
+        Message.SourceClockIdentity = MasterIdentity;
+        Message.SourcePort = 1;
+        Message.SequenceId = SequenceId;
+        Message.LogMessageInterval = 0;
+        Message.CurrentUtcOffset = 37;
+        Message.Priority1 = 128;
+        Message.Priority2 = 127;
+        Message.Quality.ClockClass = 6;
+        Message.Quality.ClockAccuracy = 0x21;
+        Message.Quality.OffsetScaledLogVariance = 0x4E5D;
+        Message.GrandmasterIdentity = MasterIdentity;
+        return Message;
+    }
+
+    FRshipPTPMessage MakeMasterMessage(FRshipPTPMessage::EType Type, uint16 SequenceId, uint64 TimeNs, int8 LogInterval)
+    {
+        FRshipPTPMessage Message;
+        Message.Type = Type;
+        Message.Domain = Domain;
+        Message.bTwoStep = Type == FRshipPTPMessage::EType::Sync;
+        Message.SourceClockIdentity = MasterIdentity;
+        Message.SourcePort = 1;
+        Message.SequenceId = SequenceId;
+        Message.LogMessageInterval = LogInterval;
+        Message.Timestamp = FRshipPTPTimestamp::FromNanoseconds(TimeNs);
+        return Message;
+    }
+
+    /**
+     * Two-step grandmaster and a network between it and the slave.
+     * Time is master time; the slave's local clock runs off it with a
+     * frequency error and an initial offset.
+     */
+    struct FSimulation
+    {
+        static constexpr uint64 StartNs = 1700000000ULL * 1000000000ULL;
+        static constexpr uint64 SyncIntervalNs = 125000000;
+
+        double SlaveErrorPPM = 100.0;
+        int64 SlaveInitialOffsetNs = -1000000;
+        int64 PathDelayNs = 50000;
+        int64 DelayJitterNs = 2000;
+
+        FRshipPTPSlave Slave;
+        FRandomStream Random{2059};
+        uint16 SequenceId = 0;
+        uint64 NowNs = StartNs;
+
+        /** Slave local clock reading at a master time */
+        uint64 ToLocal(uint64 MasterNs) const
+        {
+            const double Elapsed = static_cast<double>(MasterNs - StartNs);
+            return static_cast<uint64>(static_cast<int64>(MasterNs) + SlaveInitialOffsetNs + static_cast<int64>(Elapsed * SlaveErrorPPM * 1e-6));
+        }
+
+        int64 Delay()
+        {
+            return PathDelayNs + static_cast<int64>(Random.FRandRange(-1.0f, 1.0f) * DelayJitterNs);
+        }
+
+        /** One sync interval: Announce each second, Sync + Follow_Up, then the delay exchange */
+        void Step()
+        {
+            if (SequenceId % 8 == 0)
+            {
+                Slave.HandleMessage(MakeAnnounce(SequenceId / 8), ToLocal(NowNs));
+            }
+
+            const uint64 T1 = NowNs;
+            const uint64 T2 = T1 + Delay();
+            Slave.HandleMessage(MakeMasterMessage(FRshipPTPMessage::EType::Sync, SequenceId, 0, -3), ToLocal(T2));
+            Slave.HandleMessage(MakeMasterMessage(FRshipPTPMessage::EType::FollowUp, SequenceId, T1, -3), ToLocal(T2 + 100000));
+
+            const uint64 T3 = T1 + 10000000;
+            FRshipPTPMessage Request;
+            if (Slave.PollDelayRequest(ToLocal(T3), Request))
+            {
+                Slave.OnDelayRequestSent(Request.SequenceId, ToLocal(T3));
+
+                FRshipPTPMessage Response = MakeMasterMessage(FRshipPTPMessage::EType::DelayResp, Request.SequenceId, T3 + Delay(), -3);
+                Response.RequestingClockIdentity = Request.SourceClockIdentity;
+                Response.RequestingPort = Request.SourcePort;
+                Slave.HandleMessage(Response, ToLocal(T3 + 200000));
+            }
+
+            NowNs += SyncIntervalNs;
+            Slave.Update(ToLocal(NowNs));
+            SequenceId++;
+        }
+
+        /** Slave's estimate of master time minus the real thing */
+        int64 GetClockErrorNs() const
+        {
+            return static_cast<int64>(Slave.GetClock().ToPTP(ToLocal(NowNs)) - NowNs);
+        }
+    };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipPTPMessagesTest,
+    "Rship.2110.PTP.Messages",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipPTPMessagesTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipPTPSlaveTests;
+
+    uint8 Buffer[FRshipPTPMessage::MaxSize];
+
+    // Two-step Sync header, checked byte for byte
+    FRshipPTPMessage Sync = MakeMasterMessage(FRshipPTPMessage::EType::Sync, 0x1234, 0, -3);
+    Sync.CorrectionNs = 5;
+    TestEqual(TEXT("Sync size"), Sync.Encode(Buffer), 44);
+    TestEqual(TEXT("messageType"), static_cast<int32>(Buffer[0]), 0x00);
+    TestEqual(TEXT("versionPTP"), static_cast<int32>(Buffer[1]), 2);
+    TestEqual(TEXT("messageLength"), static_cast<int32>(Buffer[3]), 44);
+    TestEqual(TEXT("domainNumber"), static_cast<int32>(Buffer[4]), 127);
+    TestEqual(TEXT("twoStepFlag"), static_cast<int32>(Buffer[6]), 0x02);
+    TestEqual(TEXT("correctionField is scaled by 2^16"), static_cast<int32>(Buffer[13]), 0x05);
+    TestEqual(TEXT("correctionField fraction"), static_cast<int32>(Buffer[14]) | Buffer[15], 0);
+    TestEqual(TEXT("clockIdentity"), static_cast<int32>(Buffer[20]), 0x00);
+    TestEqual(TEXT("clockIdentity FF"), static_cast<int32>(Buffer[23]), 0xFF);
+    TestEqual(TEXT("sequenceId"), static_cast<int32>(Buffer[30]) << 8 | Buffer[31], 0x1234);
+    TestEqual(TEXT("controlField"), static_cast<int32>(Buffer[32]), 0);
+    TestEqual(TEXT("logMessageInterval"), static_cast<int32>(Buffer[33]), 0xFD);
+
+    FRshipPTPMessage Decoded;
+    TestTrue(TEXT("Sync decodes"), Decoded.Decode(Buffer, 44));
+    TestTrue(TEXT("Sync type"), Decoded.Type == FRshipPTPMessage::EType::Sync);
+    TestTrue(TEXT("Sync two-step"), Decoded.bTwoStep);
+    TestEqual(TEXT("Sync correction"), Decoded.CorrectionNs, static_cast<int64>(5));
+    TestEqual(TEXT("Sync interval"), static_cast<int32>(Decoded.LogMessageInterval), -3);
+    TestTrue(TEXT("Sync is an event message"), Decoded.IsEvent());
+
+    // Timestamps use all 48 bits of seconds
+    const uint64 FollowUpTime = 0x123456789ULL * 1000000000ULL + 999999999ULL;
+    FRshipPTPMessage FollowUp = MakeMasterMessage(FRshipPTPMessage::EType::FollowUp, 7, FollowUpTime, -3);
+    TestEqual(TEXT("Follow_Up size"), FollowUp.Encode(Buffer), 44);
+    TestEqual(TEXT("Follow_Up messageType"), static_cast<int32>(Buffer[0]), 0x08);
+    TestEqual(TEXT("Follow_Up controlField"), static_cast<int32>(Buffer[32]), 2);
+    TestEqual(TEXT("Seconds high byte"), static_cast<int32>(Buffer[34]), 0x00);
+    TestEqual(TEXT("Seconds bit 32"), static_cast<int32>(Buffer[35]), 0x01);
+    TestEqual(TEXT("Seconds bits 24-31"), static_cast<int32>(Buffer[36]), 0x23);
+    TestTrue(TEXT("Follow_Up decodes"), Decoded.Decode(Buffer, 44));
+    TestTrue(TEXT("Follow_Up time"), Decoded.Timestamp.ToNanoseconds() == FollowUpTime);
+    TestFalse(TEXT("Follow_Up is a general message"), Decoded.IsEvent());
+
+    FRshipPTPMessage Response = MakeMasterMessage(FRshipPTPMessage::EType::DelayResp, 9, FollowUpTime, -3);
+    Response.RequestingClockIdentity = SlaveIdentity;
+    Response.RequestingPort = 3;
+    TestEqual(TEXT("Delay_Resp size"), Response.Encode(Buffer), 54);
+    TestTrue(TEXT("Delay_Resp decodes"), Decoded.Decode(Buffer, 54));
+    TestTrue(TEXT("Requesting identity"), Decoded.RequestingClockIdentity == SlaveIdentity);
+    TestEqual(TEXT("Requesting port"), static_cast<int32>(Decoded.RequestingPort), 3);
+
+    const FRshipPTPMessage Announce = MakeAnnounce(4);
+    TestEqual(TEXT("Announce size"), Announce.Encode(Buffer), 64);
+    TestEqual(TEXT("Announce ptpTimescale"), static_cast<int32>(Buffer[7]), 0x08);
+    TestTrue(TEXT("Announce decodes"), Decoded.Decode(Buffer, 64));
+    TestEqual(TEXT("UTC offset"), static_cast<int32>(Decoded.CurrentUtcOffset), 37);
+    TestEqual(TEXT("Priority1"), static_cast<int32>(Decoded.Priority1), 128);
+    TestEqual(TEXT("Priority2"), static_cast<int32>(Decoded.Priority2), 127);
+    TestEqual(TEXT("Clock class"), static_cast<int32>(Decoded.Quality.ClockClass), 6);
+    TestEqual(TEXT("Clock accuracy"), static_cast<int32>(Decoded.Quality.ClockAccuracy), 0x21);
+    TestEqual(TEXT("Variance"), Decoded.Quality.OffsetScaledLogVariance, 0x4E5D);
+    TestTrue(TEXT("Grandmaster"), Decoded.GrandmasterIdentity == MasterIdentity);
+
+    // Rejects what it cannot handle
+    TestFalse(TEXT("Truncated"), Decoded.Decode(Buffer, 40));
+    Buffer[1] = 1;
+    TestFalse(TEXT("PTPv1"), Decoded.Decode(Buffer, 64));
+    Buffer[1] = 2;
+    Buffer[0] = 0x0C;
+    TestFalse(TEXT("Signaling"), Decoded.Decode(Buffer, 64));
+
+    TestEqual(TEXT("Identity format"), FRshipPTPMessage::FormatClockIdentity(MasterIdentity), FString(TEXT("00:11:22:FF:FE:33:44:55")));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipPTPServoTest,
+    "Rship.2110.PTP.Servo",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipPTPServoTest::RunTest(const FString& Parameters)
+{
+    // A local clock 100 ppm fast and 1 ms behind, sampled at 8 Hz with 200 ns of measurement noise
+    constexpr double Interval = 0.125;
+    constexpr uint64 IntervalNs = 125000000;
+    constexpr double ErrorPPB = -100000.0;
+
+    FRshipPTPServo Servo;
+    Servo.Configure(FRshipPTPServo::FConfig(), Interval);
+    TestTrue(TEXT("Kp scaled to the interval"), FMath::IsNearlyEqual(Servo.GetKp(), 0.7 * FMath::Pow(Interval, -0.3), 1e-9));
+    TestTrue(TEXT("Ki scaled to the interval"), FMath::IsNearlyEqual(Servo.GetKi(), 0.3 * FMath::Pow(Interval, 0.4), 1e-9));
+
+    // Master time at local time L: L + (L - Start) * ErrorPPB + 1 ms
+    FRshipPTPClockModel Clock;
+    FRandomStream Random(1588);
+    const uint64 StartLocalNs = 1000000000000ULL;
+    uint64 LocalNs = StartLocalNs;
+    int32 Jumps = 0;
+    int64 MaxSteadyOffsetNs = 0;
+
+    for (int32 Sample = 0; Sample < 480; ++Sample)
+    {
+        const uint64 MasterNs = LocalNs + 1000000 + static_cast<int64>(static_cast<double>(LocalNs - StartLocalNs) * ErrorPPB * 1e-9);
+        const int64 Noise = static_cast<int64>(Random.FRandRange(-200.0f, 200.0f));
+        const int64 OffsetNs = static_cast<int64>(MasterNs - Clock.ToPTP(LocalNs)) + Noise;
+
+        double FrequencyPPB = 0.0;
+        switch (Servo.Sample(OffsetNs, LocalNs, FrequencyPPB))
+        {
+        case FRshipPTPServo::EResult::Jump:
+            Clock.Adjust(LocalNs, OffsetNs, FrequencyPPB);
+            Jumps++;
+            break;
+        case FRshipPTPServo::EResult::Locked:
+            Clock.Adjust(LocalNs, 0, FrequencyPPB);
+            break;
+        default:
+            break;
+        }
+
+        // The last 30 seconds
+        if (Sample >= 240)
+        {
+            MaxSteadyOffsetNs = FMath::Max(MaxSteadyOffsetNs, FMath::Abs(OffsetNs));
+        }
+        LocalNs += IntervalNs;
+    }
+
+    TestEqual(TEXT("Steps once"), Jumps, 1);
+    TestTrue(FString::Printf(TEXT("Steady-state offset %lld ns under 1 us"), MaxSteadyOffsetNs), MaxSteadyOffsetNs < 1000);
+    TestTrue(FString::Printf(TEXT("Frequency %.0f ppb within 1 ppm of %.0f"), Servo.GetDriftPPB(), ErrorPPB),
+             FMath::Abs(Servo.GetDriftPPB() - ErrorPPB) < 1000.0);
+    TestTrue(TEXT("Clock runs at the estimate"), FMath::Abs(Clock.FrequencyPPB - ErrorPPB) < 1000.0);
+
+    // A large error once locked restarts the servo rather than slewing
+    double FrequencyPPB = 0.0;
+    TestTrue(TEXT("Step threshold unlocks"), Servo.Sample(5000000, LocalNs, FrequencyPPB) == FRshipPTPServo::EResult::Unlocked);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipPTPSlaveConvergenceTest,
+    "Rship.2110.PTP.SlaveConvergence",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipPTPSlaveConvergenceTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipPTPSlaveTests;
+
+    FSimulation Simulation;
+    FRshipPTPSlave::FConfig Config;
+    Config.ClockIdentity = SlaveIdentity;
+    Config.LockThresholdNs = 5000;
+    Simulation.Slave.Configure(Config);
+
+    TestTrue(TEXT("Listening before any Announce"), Simulation.Slave.GetState() == ERshipPTPState::Listening);
+
+    // One Announce + Sync picks the master
+    Simulation.Step();
+    TestTrue(TEXT("Master selected"), Simulation.Slave.HasMaster());
+    TestTrue(TEXT("Master identity"), Simulation.Slave.GetMasterAnnounce().GrandmasterIdentity == MasterIdentity);
+    TestTrue(TEXT("Acquiring"), Simulation.Slave.GetState() == ERshipPTPState::Acquiring);
+
+    int32 LockedAtStep = -1;
+    int64 MaxLockedErrorNs = 0;
+    for (int32 Step = 1; Step < 480; ++Step)
+    {
+        Simulation.Step();
+        if (Simulation.Slave.GetState() == ERshipPTPState::Locked)
+        {
+            if (LockedAtStep < 0)
+            {
+                LockedAtStep = Step;
+            }
+            // Allow five seconds for the frequency loop to settle after lock
+            if (Step > LockedAtStep + 40)
+            {
+                MaxLockedErrorNs = FMath::Max(MaxLockedErrorNs, FMath::Abs(Simulation.GetClockErrorNs()));
+            }
+        }
+        else if (LockedAtStep >= 0)
+        {
+            AddError(FString::Printf(TEXT("Lost lock at step %d (offset %lld ns)"), Step, Simulation.Slave.GetLastOffsetNs()));
+            break;
+        }
+    }
+
+    TestTrue(TEXT("Locks"), LockedAtStep >= 0);
+    TestTrue(FString::Printf(TEXT("Locks within 10 s (step %d)"), LockedAtStep), LockedAtStep >= 0 && LockedAtStep < 80);
+    TestTrue(FString::Printf(TEXT("Path delay %lld ns"), Simulation.Slave.GetMeanPathDelayNs()),
+             FMath::Abs(Simulation.Slave.GetMeanPathDelayNs() - Simulation.PathDelayNs) < 1000);
+    TestTrue(FString::Printf(TEXT("Clock error %lld ns once settled"), MaxLockedErrorNs), MaxLockedErrorNs < 3000);
+    // Includes the proportional term, so it moves with the last sample's jitter
+    TestTrue(FString::Printf(TEXT("Frequency %.0f ppb"), Simulation.Slave.GetClock().FrequencyPPB),
+             FMath::Abs(Simulation.Slave.GetClock().FrequencyPPB + Simulation.SlaveErrorPPM * 1000.0) < 5000.0);
+
+    // Master goes quiet: holdover, then lost once its Announce times out
+    for (int32 Tick = 0; Tick < 24; ++Tick)
+    {
+        Simulation.NowNs += FSimulation::SyncIntervalNs;
+        Simulation.Slave.Update(Simulation.ToLocal(Simulation.NowNs));
+    }
+    TestTrue(TEXT("Holdover without Sync"), Simulation.Slave.GetState() == ERshipPTPState::Holdover);
+
+    for (int32 Tick = 0; Tick < 40; ++Tick)
+    {
+        Simulation.NowNs += FSimulation::SyncIntervalNs;
+        Simulation.Slave.Update(Simulation.ToLocal(Simulation.NowNs));
+    }
+    TestFalse(TEXT("Master dropped after Announce timeout"), Simulation.Slave.HasMaster());
+    TestTrue(TEXT("Still holding over"), Simulation.Slave.GetState() == ERshipPTPState::Holdover);
+
+    // Messages for another domain or another port are ignored
+    FRshipPTPSlave Other;
+    Other.Configure(Config);
+    FRshipPTPMessage Foreign = MakeAnnounce(0);
+    Foreign.Domain = 0;
+    Other.HandleMessage(Foreign, 0);
+    TestFalse(TEXT("Other domain ignored"), Other.HasMaster());
+
+    // A better clock takes over
+    Other.HandleMessage(MakeAnnounce(0), 0);
+    FRshipPTPMessage Better = MakeAnnounce(0);
+    Better.SourceClockIdentity = Better.GrandmasterIdentity = 0x0000000000000001ULL;
+    Better.Priority1 = 100;
+    Other.HandleMessage(Better, 0);
+    TestTrue(TEXT("Better master selected"), Other.GetMasterAnnounce().GrandmasterIdentity == 0x0000000000000001ULL);
+
+    FRshipPTPMessage Worse = MakeAnnounce(0);
+    Worse.SourceClockIdentity = Worse.GrandmasterIdentity = 0x0000000000000002ULL;
+    Worse.Quality.ClockClass = 248;
+    Other.HandleMessage(Worse, 0);
+    TestTrue(TEXT("Worse master ignored"), Other.GetMasterAnnounce().GrandmasterIdentity == 0x0000000000000001ULL);
+
+    return true;
+}
+
+#if PLATFORM_LINUX
+
+namespace RshipPTPSlaveTests
+{
+    uint64 RealtimeNs()
+    {
+        timespec Now;
+        clock_gettime(CLOCK_REALTIME, &Now);
+        return static_cast<uint64>(Now.tv_sec) * 1000000000ULL + static_cast<uint64>(Now.tv_nsec);
+    }
+
+    /**
+     * Grandmaster on loopback. Its clock runs off CLOCK_REALTIME with an
+     * offset and a frequency error; a path delay with jitter is added by
+     * moving t1 earlier and t4 later.
+     */
+    class FLoopbackGrandmaster
+    {
+    public:
+        static constexpr int64 OffsetNs = 37000000000LL + 123456;
+        static constexpr double ErrorPPM = 20.0;
+        static constexpr int64 AddedDelayNs = 30000;
+        static constexpr int32 AddedJitterNs = 2000;
+
+        FLoopbackGrandmaster()
+        {
+            StartNs = RealtimeNs();
+            EventSocket = OpenSocket(EventPort);
+            GeneralSocket = OpenSocket(GeneralPort);
+
+            // Kernel transmit times for t1 and receive times for t4 (SOF_TIMESTAMPING_TX/RX_SOFTWARE, SOFTWARE, OPT_TSONLY)
+            const int Flags = (1 << 1) | (1 << 3) | (1 << 4) | (1 << 11);
+            setsockopt(EventSocket, SOL_SOCKET, SO_TIMESTAMPING, &Flags, sizeof(Flags));
+        }
+
+        ~FLoopbackGrandmaster()
+        {
+            for (int Socket : { EventSocket, GeneralSocket })
+            {
+                if (Socket >= 0)
+                {
+                    close(Socket);
+                }
+            }
+        }
+
+        bool IsValid() const { return EventSocket >= 0 && GeneralSocket >= 0; }
+        int32 GetEventPort() const { return EventPort; }
+
+        uint64 GetTimeNs(uint64 Realtime) const
+        {
+            const double Elapsed = static_cast<double>(Realtime - StartNs);
+            return Realtime + OffsetNs + static_cast<int64>(Elapsed * ErrorPPM * 1e-6);
+        }
+
+        /** Announce, Sync + Follow_Up to the slave's ports */
+        void SendSync(int32 SlaveEventPort, int32 SlaveGeneralPort)
+        {
+            if (SequenceId % 16 == 0)
+            {
+                Send(GeneralSocket, MakeAnnounce(SequenceId / 16), SlaveGeneralPort);
+            }
+
+            const uint64 BeforeSendNs = RealtimeNs();
+            Send(EventSocket, MakeMasterMessage(FRshipPTPMessage::EType::Sync, SequenceId, 0, -4), SlaveEventPort);
+            const uint64 T1 = GetTimeNs(ReadTxTimestamp(BeforeSendNs)) - AddedDelay();
+            Send(GeneralSocket, MakeMasterMessage(FRshipPTPMessage::EType::FollowUp, SequenceId, T1, -4), SlaveGeneralPort);
+            SequenceId++;
+        }
+
+        /** Answer any Delay_Req waiting */
+        void ServeDelayRequests(int32 SlaveGeneralPort)
+        {
+            uint8 Buffer[128];
+            alignas(cmsghdr) uint8 ControlBuffer[128];
+            while (true)
+            {
+                iovec Vector = { Buffer, sizeof(Buffer) };
+                msghdr Header = {};
+                Header.msg_iov = &Vector;
+                Header.msg_iovlen = 1;
+                Header.msg_control = ControlBuffer;
+                Header.msg_controllen = sizeof(ControlBuffer);
+                const ssize_t Received = recvmsg(EventSocket, &Header, MSG_DONTWAIT);
+                if (Received < 0)
+                {
+                    return;
+                }
+
+                uint64 ReceivedNs = RealtimeNs();
+                ReadKernelTimestamp(Header, ReceivedNs);
+
+                FRshipPTPMessage Request;
+                if (!Request.Decode(Buffer, static_cast<int32>(Received)) || Request.Type != FRshipPTPMessage::EType::DelayReq)
+                {
+                    continue;
+                }
+
+                FRshipPTPMessage Response = MakeMasterMessage(FRshipPTPMessage::EType::DelayResp, Request.SequenceId,
+                                                              GetTimeNs(ReceivedNs) + AddedDelay(), -4);
+                Response.RequestingClockIdentity = Request.SourceClockIdentity;
+                Response.RequestingPort = Request.SourcePort;
+                Send(GeneralSocket, Response, SlaveGeneralPort);
+                DelayRequests++;
+            }
+        }
+
+        int32 GetDelayRequests() const { return DelayRequests; }
+
+    private:
+        int64 AddedDelay()
+        {
+            return AddedDelayNs + Random.RandRange(-AddedJitterNs, AddedJitterNs);
+        }
+
+        static void ReadKernelTimestamp(msghdr& Header, uint64& InOutNs)
+        {
+            for (cmsghdr* Control = CMSG_FIRSTHDR(&Header); Control; Control = CMSG_NXTHDR(&Header, Control))
+            {
+                if (Control->cmsg_level == SOL_SOCKET && Control->cmsg_type == SCM_TIMESTAMPING)
+                {
+                    timespec Stamp;
+                    FMemory::Memcpy(&Stamp, CMSG_DATA(Control), sizeof(Stamp));
+                    InOutNs = static_cast<uint64>(Stamp.tv_sec) * 1000000000ULL + static_cast<uint64>(Stamp.tv_nsec);
+                }
+            }
+        }
+
+        /** Sync's transmit time off the error queue, as a two-step master reports it */
+        uint64 ReadTxTimestamp(uint64 FallbackNs)
+        {
+            uint8 Buffer[128];
+            alignas(cmsghdr) uint8 ControlBuffer[128];
+            pollfd File = { EventSocket, POLLPRI, 0 };
+            for (int32 Attempt = 0; Attempt < 10; ++Attempt)
+            {
+                iovec Vector = { Buffer, sizeof(Buffer) };
+                msghdr Header = {};
+                Header.msg_iov = &Vector;
+                Header.msg_iovlen = 1;
+                Header.msg_control = ControlBuffer;
+                Header.msg_controllen = sizeof(ControlBuffer);
+                if (recvmsg(EventSocket, &Header, MSG_ERRQUEUE | MSG_DONTWAIT) >= 0)
+                {
+                    uint64 SentNs = FallbackNs;
+                    ReadKernelTimestamp(Header, SentNs);
+                    return SentNs;
+                }
+                poll(&File, 1, 1);
+            }
+            return FallbackNs;
+        }
+
+        int OpenSocket(int32& OutPort)
+        {
+            const int Socket = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+            sockaddr_in Local = {};
+            Local.sin_family = AF_INET;
+            Local.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            socklen_t Length = sizeof(Local);
+            if (Socket < 0 || bind(Socket, reinterpret_cast<const sockaddr*>(&Local), sizeof(Local)) != 0 ||
+                getsockname(Socket, reinterpret_cast<sockaddr*>(&Local), &Length) != 0)
+            {
+                if (Socket >= 0)
+                {
+                    close(Socket);
+                }
+                return -1;
+            }
+            OutPort = ntohs(Local.sin_port);
+            return Socket;
+        }
+
+        void Send(int Socket, const FRshipPTPMessage& Message, int32 Port)
+        {
+            uint8 Buffer[FRshipPTPMessage::MaxSize];
+            const int32 Size = Message.Encode(Buffer);
+            sockaddr_in Destination = {};
+            Destination.sin_family = AF_INET;
+            Destination.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            Destination.sin_port = htons(static_cast<uint16>(Port));
+            sendto(Socket, Buffer, Size, 0, reinterpret_cast<const sockaddr*>(&Destination), sizeof(Destination));
+        }
+
+        FRandomStream Random{1588};
+        uint64 StartNs = 0;
+        int EventSocket = -1;
+        int GeneralSocket = -1;
+        int32 EventPort = 0;
+        int32 GeneralPort = 0;
+        uint16 SequenceId = 0;
+        int32 DelayRequests = 0;
+    };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipPTPLinuxLoopbackTest,
+    "Rship.2110.PTP.LinuxLoopback",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipPTPLinuxLoopbackTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipPTPSlaveTests;
+
+    FLoopbackGrandmaster Grandmaster;
+    if (!Grandmaster.IsValid())
+    {
+        AddWarning(TEXT("No loopback sockets, skipping"));
+        return true;
+    }
+
+    // Software timestamps on loopback jitter by microseconds; relax the lock threshold for the test
+    URship2110Settings* Settings = URship2110Settings::Get();
+    const int32 SavedThresholdNs = Settings ? Settings->PTPSyncThresholdNs : 0;
+    if (Settings)
+    {
+        Settings->PTPSyncThresholdNs = 20000;
+    }
+    ON_SCOPE_EXIT
+    {
+        if (Settings)
+        {
+            Settings->PTPSyncThresholdNs = SavedThresholdNs;
+        }
+    };
+
+    // Unprivileged ports for the slave, retried if taken
+    FRandomStream Random(static_cast<int32>(RealtimeNs()));
+    FRshipPTPSocketConfig SocketConfig;
+    SocketConfig.DestinationIP = TEXT("127.0.0.1");
+    SocketConfig.DestinationPort = Grandmaster.GetEventPort();
+    SocketConfig.bHardwareTimestamping = false;
+
+    TUniquePtr<IPTPProvider> Provider;
+    for (int32 Attempt = 0; Attempt < 8 && !Provider; ++Attempt)
+    {
+        SocketConfig.EventPort = Random.RandRange(20000, 59998);
+        SocketConfig.GeneralPort = SocketConfig.EventPort + 1;
+        Provider = FPTPProviderFactory::CreateSlave(SocketConfig);
+        if (!Provider->Initialize(TEXT("127.0.0.1"), 127))
+        {
+            Provider.Reset();
+        }
+    }
+    if (!TestTrue(TEXT("Slave starts"), Provider.IsValid()))
+    {
+        return false;
+    }
+    TestFalse(TEXT("Software timestamps on loopback"), Provider->IsHardwareTimestampingEnabled());
+
+    // 16 Hz sync until locked, at most 30 seconds
+    const uint64 DeadlineNs = RealtimeNs() + 30000000000ULL;
+    uint64 NextSyncNs = 0;
+    while (Provider->GetState() != ERshipPTPState::Locked && RealtimeNs() < DeadlineNs)
+    {
+        if (RealtimeNs() >= NextSyncNs)
+        {
+            Grandmaster.SendSync(SocketConfig.EventPort, SocketConfig.GeneralPort);
+            NextSyncNs = RealtimeNs() + 62500000;
+        }
+        Grandmaster.ServeDelayRequests(SocketConfig.GeneralPort);
+        FPlatformProcess::Sleep(0.001f);
+    }
+
+    const FRshipPTPStatus Status = Provider->GetStatus();
+    TestTrue(FString::Printf(TEXT("Locked (state %d after %d Delay_Req)"), static_cast<int32>(Status.State), Grandmaster.GetDelayRequests()),
+             Status.State == ERshipPTPState::Locked);
+    TestEqual(TEXT("Grandmaster reported"), Status.Grandmaster.ClockIdentity, FRshipPTPMessage::FormatClockIdentity(MasterIdentity));
+    TestTrue(FString::Printf(TEXT("Path delay %lld ns includes the added %lld ns"), Status.PathDelayNs, FLoopbackGrandmaster::AddedDelayNs),
+             Status.PathDelayNs >= FLoopbackGrandmaster::AddedDelayNs - FLoopbackGrandmaster::AddedJitterNs && Status.PathDelayNs < FLoopbackGrandmaster::AddedDelayNs + 100000);
+
+    const uint64 ProviderNs = Provider->GetPTPTime().ToNanoseconds();
+    const uint64 MasterNs = Grandmaster.GetTimeNs(RealtimeNs());
+    const int64 ErrorNs = static_cast<int64>(ProviderNs - MasterNs);
+    TestTrue(FString::Printf(TEXT("PTP time within 50 us of the grandmaster (%lld ns)"), ErrorNs), FMath::Abs(ErrorNs) < 50000);
+    TestTrue(TEXT("Offset from the system clock is the grandmaster's"),
+             FMath::Abs(Provider->GetOffsetFromSystemNs() - FLoopbackGrandmaster::OffsetNs) < 1000000);
+
+    Provider->Shutdown();
+    TestTrue(TEXT("Disabled after shutdown"), Provider->GetState() == ERshipPTPState::Disabled);
+
+    return true;
+}
+
+#endif  // PLATFORM_LINUX
+
+#endif  // WITH_AUTOMATION_TESTS
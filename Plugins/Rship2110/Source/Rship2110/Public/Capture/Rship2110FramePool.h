@@ -0,0 +1,281 @@
+// Copyright Rocketship. All Rights Reserved.
+// Pooled Frame Buffers and Readback Ring
+//
+// Owns the packed 2110-20 frames that travel from GPU readback to the
+// transmit thread, so a frame is converted once and never copied again.
+//
+// Key features:
+// - Fixed set of page-aligned frames, handed out by refcounted handles
+// - Explicit acquire/release; the last handle returns the frame to the pool
+// - Handles keep their pool alive, so a pool can be replaced while frames are in flight
+// - Readback ring over any source of GPU copies (RHI, or a fake in tests)
+// - Frames leave the ring in submission order, converted to the stream's pgroups
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Rship2110Types.h"
+#include "Capture/Rship2110PixelConverter.h"
+#include <atomic>
+
+class FRship2110FramePool;
+
+using FRship2110FramePoolRef = TSharedRef<FRship2110FramePool, ESPMode::ThreadSafe>;
+using FRship2110FramePoolPtr = TSharedPtr<FRship2110FramePool, ESPMode::ThreadSafe>;
+
+/**
+ * Counted reference to one pooled frame.
+ *
+ * Copying adds a reference and destroying or Release() drops one; the
+ * frame goes back to its pool when the last reference is dropped, on
+ * whichever thread drops it. Metadata is written by the producer before
+ * the first copy is handed on; after that a frame is read-only.
+ */
+class RSHIP2110_API FRship2110FrameRef
+{
+public:
+    FRship2110FrameRef() = default;
+    FRship2110FrameRef(const FRship2110FrameRef& Other);
+    FRship2110FrameRef(FRship2110FrameRef&& Other);
+    FRship2110FrameRef& operator=(const FRship2110FrameRef& Other);
+    FRship2110FrameRef& operator=(FRship2110FrameRef&& Other);
+    ~FRship2110FrameRef() { Release(); }
+
+    /** Drop this reference; the handle is empty afterwards */
+    void Release();
+
+    /** Check whether the handle refers to a frame */
+    bool IsValid() const { return Index != INDEX_NONE; }
+
+    /** Get the frame's bytes */
+    uint8* GetData() const;
+
+    /** Get bytes in the frame */
+    int64 GetSize() const;
+
+    /** Get the capture time the producer stamped on the frame */
+    const FRshipPTPTimestamp& GetTimestamp() const;
+
+    /** Stamp the capture time (producer only, before sharing) */
+    void SetTimestamp(const FRshipPTPTimestamp& InTimestamp);
+
+    /** Get the frame's slot in its pool */
+    int32 GetIndex() const { return Index; }
+
+    /** Get references held on the frame, this one included */
+    int32 GetRefCount() const;
+
+private:
+    friend class FRship2110FramePool;
+
+    FRship2110FrameRef(FRship2110FramePoolRef InPool, int32 InIndex);
+
+    FRship2110FramePoolPtr Pool;
+    int32 Index = INDEX_NONE;
+};
+
+/**
+ * Fixed set of equally sized frame buffers.
+ *
+ * Acquire hands out a free frame with one reference, or an empty handle
+ * when every frame is held. Thread-safe. The pool's size never changes;
+ * to resize, create a new pool and drop the old one, whose frames stay
+ * valid until their last references go.
+ */
+class RSHIP2110_API FRship2110FramePool : public TSharedFromThis<FRship2110FramePool, ESPMode::ThreadSafe>
+{
+public:
+    /**
+     * Allocate a pool.
+     * @param NumFrames Frames in the pool (at least 1)
+     * @param FrameBytes Bytes per frame
+     * @return New pool
+     */
+    static FRship2110FramePoolRef Create(int32 NumFrames, int64 FrameBytes);
+
+    ~FRship2110FramePool();
+
+    /**
+     * Take a free frame.
+     * @return Frame with one reference, or an empty handle if none is free
+     */
+    FRship2110FrameRef Acquire();
+
+    /** Get frames in the pool */
+    int32 GetNumFrames() const { return NumFrames; }
+
+    /** Get frames not currently referenced */
+    int32 GetNumFree() const;
+
+    /** Get bytes per frame */
+    int64 GetFrameBytes() const { return FrameBytes; }
+
+    /** Get Acquire calls that found every frame held */
+    int64 GetAcquireFailures() const { return AcquireFailures.load(std::memory_order_relaxed); }
+
+private:
+    friend class FRship2110FrameRef;
+
+    struct FFrame
+    {
+        uint8* Data = nullptr;
+        std::atomic<int32> RefCount{0};
+        FRshipPTPTimestamp Timestamp;
+    };
+
+    FRship2110FramePool(int32 InNumFrames, int64 InFrameBytes);
+
+    void AddRef(int32 FrameIndex);
+    void Release(int32 FrameIndex);
+
+    TUniquePtr<FFrame[]> Frames;
+    int32 NumFrames = 0;
+    int64 FrameBytes = 0;
+
+    TArray<int32> FreeFrames;
+    mutable FCriticalSection FreeLock;
+
+    std::atomic<int64> AcquireFailures{0};
+};
+
+/**
+ * Ring of GPU-to-CPU copies.
+ *
+ * A source owns GetNumSlots() staging buffers; the owner issues a copy
+ * into a slot by whatever means the source provides (an RHI command, a
+ * test writing pixels) and FRship2110ReadbackRing then reads the slot back
+ * once IsReady reports it has landed. Slots are reused in order. All calls
+ * come from the thread that drives the ring.
+ */
+class RSHIP2110_API IRship2110ReadbackSource
+{
+public:
+    virtual ~IRship2110ReadbackSource() = default;
+
+    /**
+     * Get copies that can be in flight at once.
+     * @return Slot count
+     */
+    virtual int32 GetNumSlots() const = 0;
+
+    /**
+     * Check whether the copy into a slot has landed.
+     * @param Slot Slot index
+     * @return true if Lock will not stall
+     */
+    virtual bool IsReady(int32 Slot) const = 0;
+
+    /**
+     * Map a landed slot for reading.
+     * @param Slot Slot index
+     * @param OutStride Receives bytes between source lines
+     * @param OutInput Receives the pixel layout of the copy
+     * @return First line of pixels, or nullptr if the slot cannot be mapped
+     */
+    virtual const void* Lock(int32 Slot, int32& OutStride, ERship2110PixelInput& OutInput) = 0;
+
+    /**
+     * Unmap a slot after Lock.
+     * @param Slot Slot index
+     */
+    virtual void Unlock(int32 Slot) = 0;
+};
+
+/**
+ * Turns completed readbacks into pooled frames.
+ *
+ * Submit reserves the next source slot and asks the caller to issue the
+ * copy into it; Poll takes landed slots in submission order, converts each
+ * into a frame from the pool and hands it on. Conversion is the only copy
+ * between the GPU and the wire. A readback finding the pool empty is
+ * dropped and its slot recycled, so a slow consumer costs frames, not
+ * latency.
+ *
+ * Not thread-safe: Submit and Poll run on one thread (the render thread
+ * for RHI sources). Frames handed out may be released anywhere.
+ */
+class RSHIP2110_API FRship2110ReadbackRing
+{
+public:
+    /**
+     * Set up for a source and stream format. Drops readbacks in flight.
+     * @param InSource Source of GPU copies
+     * @param Format Video format of the frames produced
+     * @param NumFrames Frames in the pool
+     * @param bPack Convert to the format's pgroups; otherwise frames hold the raw pixels
+     * @return false if the format cannot be converted or the source has no slots
+     */
+    bool Configure(TSharedPtr<IRship2110ReadbackSource, ESPMode::ThreadSafe> InSource,
+                   const FRship2110VideoFormat& Format, int32 NumFrames, bool bPack = true);
+
+    /** Drop the source, the pool reference and readbacks in flight */
+    void Reset();
+
+    /**
+     * Replace the pool with one of a new size. Frames already handed out
+     * stay valid and return to the old pool.
+     * @param NumFrames Frames in the new pool
+     */
+    void SetPoolSize(int32 NumFrames);
+
+    /**
+     * Start a readback.
+     * @param Timestamp Capture time carried by the frame
+     * @param IssueCopy Issues the copy into the given slot; returns false if it could not
+     * @return false if every slot is in flight or the copy was not issued
+     */
+    bool Submit(const FRshipPTPTimestamp& Timestamp, TFunctionRef<bool(int32 /*Slot*/)> IssueCopy);
+
+    /**
+     * Collect landed readbacks in submission order.
+     * @param OnFrame Receives each slot and its converted frame
+     * @return Frames handed out
+     */
+    int32 Poll(TFunctionRef<void(int32 /*Slot*/, FRship2110FrameRef&& /*Frame*/)> OnFrame);
+
+    /** Get the source */
+    IRship2110ReadbackSource* GetSource() const { return Source.Get(); }
+
+    /** Get the current pool */
+    FRship2110FramePoolPtr GetPool() const { return Pool; }
+
+    /** Get bytes per produced frame */
+    int64 GetFrameBytes() const { return FrameBytes; }
+
+    /** Get readbacks submitted and not yet polled */
+    int32 GetNumInFlight() const { return InFlight.Num(); }
+
+    /** Get frames handed out by Poll */
+    int64 GetFramesCompleted() const { return FramesCompleted; }
+
+    /** Get Submit calls refused because every slot was in flight */
+    int64 GetRingFullDrops() const { return RingFullDrops; }
+
+    /** Get landed readbacks dropped because the pool was empty */
+    int64 GetPoolEmptyDrops() const { return PoolEmptyDrops; }
+
+private:
+    struct FInFlight
+    {
+        int32 Slot = INDEX_NONE;
+        FRshipPTPTimestamp Timestamp;
+    };
+
+    /** Copy or convert a mapped slot into a frame */
+    bool ReadSlot(int32 Slot, uint8* Dest);
+
+    TSharedPtr<IRship2110ReadbackSource, ESPMode::ThreadSafe> Source;
+    FRship2110FramePoolPtr Pool;
+    FRship2110PixelConverter PixelConverter;
+    FRship2110VideoFormat VideoFormat;
+    bool bPackFrames = true;
+    int64 FrameBytes = 0;
+
+    // Oldest first; slots are issued round-robin
+    TArray<FInFlight> InFlight;
+    int32 NextSlot = 0;
+
+    int64 FramesCompleted = 0;
+    int64 RingFullDrops = 0;
+    int64 PoolEmptyDrops = 0;
+};
@@ -0,0 +1,66 @@
+// Copyright Rocketship. All Rights Reserved.
+// RHI Readback Source for the Capture Ring
+//
+// Backs FRship2110ReadbackRing with a ring of FRHIGPUTextureReadback
+// objects, so captures never stall the render thread waiting on the GPU.
+//
+// Key features:
+// - One staging readback per slot, reused once the ring has read it
+// - Copies issued on the render thread, polled without blocking
+// - 8-bit RGBA/BGRA, 16-bit float and 10:10:10:2 render targets
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Capture/Rship2110FramePool.h"
+#include "RHI.h"
+#include "RHIResources.h"
+
+class FRHIGPUTextureReadback;
+
+/**
+ * Readback source over FRHIGPUTextureReadback. Render thread only.
+ */
+class RSHIP2110_API FRship2110GPUReadbackSource : public IRship2110ReadbackSource
+{
+public:
+    /**
+     * Create the readbacks.
+     * @param NumSlots Copies that may be in flight at once
+     */
+    explicit FRship2110GPUReadbackSource(int32 NumSlots);
+    virtual ~FRship2110GPUReadbackSource();
+
+    /**
+     * Copy a texture into a slot.
+     * @param RHICmdList Render thread command list
+     * @param Texture Source texture
+     * @param Slot Slot reserved by FRship2110ReadbackRing::Submit
+     * @param ExpectedSize Frame size the ring was configured for
+     * @return false if the texture does not match the size or cannot be read back
+     */
+    bool EnqueueCopy(FRHICommandListImmediate& RHICmdList, FRHITexture* Texture, int32 Slot, FIntPoint ExpectedSize);
+
+    /**
+     * Map a texture format onto a converter input.
+     * @param Format Pixel format of the texture
+     * @param OutInput Receives the converter input
+     * @return false if the converter cannot read the format
+     */
+    static bool GetPixelInput(EPixelFormat Format, ERship2110PixelInput& OutInput);
+
+    // IRship2110ReadbackSource interface
+    virtual int32 GetNumSlots() const override { return Slots.Num(); }
+    virtual bool IsReady(int32 Slot) const override;
+    virtual const void* Lock(int32 Slot, int32& OutStride, ERship2110PixelInput& OutInput) override;
+    virtual void Unlock(int32 Slot) override;
+
+private:
+    struct FSlot
+    {
+        TUniquePtr<FRHIGPUTextureReadback> Readback;
+        ERship2110PixelInput Input = ERship2110PixelInput::BGRA8;
+    };
+
+    TArray<FSlot> Slots;
+};
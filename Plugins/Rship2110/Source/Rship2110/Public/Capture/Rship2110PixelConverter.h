@@ -0,0 +1,121 @@
+// Copyright Rocketship. All Rights Reserved.
+// SMPTE ST 2110-20 Pixel Conversion and pgroup Packing
+//
+// Converts rendered frames into the packed sample payload a 2110-20
+// receiver expects for the stream's video format.
+//
+// Key features:
+// - 8-bit RGBA/BGRA, 16-bit float RGBA and 10:10:10:2 inputs
+// - Y'CbCr matrix selected from colorimetry (BT.601 / BT.709 / BT.2020)
+// - Narrow or full quantization range
+// - 4:2:2 chroma filtered for co-sited or interstitial siting
+// - Big-endian pgroup packing at 8, 10, 12 and 16 bits per sample
+// - Matrix stage runs four pixels per vector register, lines in parallel
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Rship2110Types.h"
+
+/**
+ * Memory layout of the source pixels handed to the converter.
+ */
+enum class ERship2110PixelInput : uint8
+{
+    /** 8 bits per channel, R G B A byte order (PF_R8G8B8A8) */
+    RGBA8,
+
+    /** 8 bits per channel, B G R A byte order (PF_B8G8R8A8) */
+    BGRA8,
+
+    /** 16-bit float per channel, R G B A (PF_FloatRGBA) */
+    RGBA16F,
+
+    /** 32-bit little-endian word, R in bits 0-9, G 10-19, B 20-29, A 30-31 (PF_A2B10G10R10) */
+    RGB10A2
+};
+
+/**
+ * Converts frames to ST 2110-20 payload for one video format.
+ *
+ * Samples are quantized per ITU-R BT.601/709/2020 (narrow) or BT.2100 (full)
+ * and packed into pgroups in RFC 4175 sample order: Cb Y Cr Y for 4:2:2,
+ * Cb Y Cr for 4:4:4, R G B (A) for RGB. Narrow range keeps the footroom and
+ * headroom codes but never emits the reserved timing reference codes.
+ * Source RGB must already be in the stream's primaries and transfer function.
+ *
+ * Configure once per format; ConvertFrame is const and may be called from
+ * any thread.
+ */
+class RSHIP2110_API FRship2110PixelConverter
+{
+public:
+    FRship2110PixelConverter() = default;
+    explicit FRship2110PixelConverter(const FRship2110VideoFormat& InFormat) { Configure(InFormat); }
+
+    /**
+     * Set up coefficients and packing for a video format.
+     * @param InFormat Video format to produce
+     * @return false if the width is not a whole number of pgroups
+     */
+    bool Configure(const FRship2110VideoFormat& InFormat);
+
+    /** Check whether Configure succeeded */
+    bool IsValid() const { return bValid; }
+
+    /** Get the configured video format */
+    const FRship2110VideoFormat& GetFormat() const { return Format; }
+
+    /** Get packed bytes per line */
+    int32 GetLineBytes() const { return LineBytes; }
+
+    /** Get packed bytes per frame */
+    int64 GetFrameBytes() const { return static_cast<int64>(LineBytes) * Format.Height; }
+
+    /**
+     * Convert and pack a frame.
+     * @param Source First source line
+     * @param Input Source pixel layout
+     * @param SourceStride Bytes between source lines (0 = tightly packed)
+     * @param Dest Destination, GetFrameBytes() long; lines packed back to back
+     * @return false if the converter is not configured
+     */
+    bool ConvertFrame(const void* Source, ERship2110PixelInput Input, int32 SourceStride, uint8* Dest) const;
+
+    /**
+     * Convert and pack a single line.
+     * @param SourceLine Source pixels, Width long
+     * @param Input Source pixel layout
+     * @param DestLine Destination, GetLineBytes() long
+     * @return false if the converter is not configured
+     */
+    bool ConvertLine(const void* SourceLine, ERship2110PixelInput Input, uint8* DestLine) const;
+
+    /**
+     * Get the luma coefficients for a colorimetry.
+     * DCI-P3 and ACES define no Y'CbCr encoding and use BT.709.
+     * @param Colorimetry Colorimetry of the stream
+     * @param OutKr Red luma weight
+     * @param OutKb Blue luma weight
+     */
+    static void GetLumaCoefficients(ERship2110Colorimetry Colorimetry, float& OutKr, float& OutKb);
+
+    /** Get bytes per source pixel for an input layout */
+    static int32 GetInputBytesPerPixel(ERship2110PixelInput Input);
+
+private:
+    struct FLineScratch;
+
+    void ConvertLine(const uint8* SourceLine, ERship2110PixelInput Input, uint8* DestLine, FLineScratch& Scratch) const;
+
+    FRship2110VideoFormat Format;
+    bool bValid = false;
+    int32 LineBytes = 0;
+
+    // Normalized RGB to code value, rows Y/Cb/Cr (or R/G/B for RGB output)
+    float Matrix[3][3] = {};
+    float Offset[3] = {};
+    float AlphaScale = 0.0f;
+    float MinCode[3] = {};
+    float MaxCode[3] = {};
+};
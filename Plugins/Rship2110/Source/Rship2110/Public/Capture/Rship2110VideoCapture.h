@@ -7,9 +7,9 @@
 // - Scene capture component integration
 //
 // Handles:
-// - GPU readback with minimal latency
+// - Asynchronous GPU readback through a ring of FRHIGPUTextureReadback
 // - Format conversion (RGBA to YCbCr)
-// - Double/triple buffering for pipelining
+// - Pooled, refcounted frames sized by the buffer count
 // - GPUDirect RDMA integration points
 
 #pragma once
@@ -17,6 +17,8 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "Rship2110Types.h"
+#include "Capture/Rship2110PixelConverter.h"
+#include "Capture/Rship2110FramePool.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "RHI.h"
 #include "RHIResources.h"
@@ -32,11 +34,14 @@ using FRship2110TextureRHIRef = FTexture2DRHIRef;
 
 class URship2110VideoSender;
 class URshipColorManagementSubsystem;
+class FRship2110GPUReadbackSource;
+class FTextureResource;
 class USceneCaptureComponent2D;
 struct FRshipColorConfig;
 
 /**
- * Capture completion delegate
+ * Capture completion delegate. Runs on the game thread; FrameData is only
+ * valid during the call (take GetLastFrame() to keep it without copying).
  */
 DECLARE_DELEGATE_ThreeParams(FOnFrameCaptured, const void* /*FrameData*/, int64 /*DataSize*/, const FRshipPTPTimestamp& /*Timestamp*/);
 
@@ -96,6 +101,7 @@ public:
 
     /**
      * Process pending captures (call from game thread).
+     * Issues requested readbacks and delivers frames whose copies have landed.
      */
     void ProcessPendingCaptures();
 
@@ -120,7 +126,7 @@ public:
      * When enabled, converts RGBA to YCbCr as specified by video format.
      * @param bEnable true to enable conversion
      */
-    void SetColorConversionEnabled(bool bEnable) { bDoColorConversion = bEnable; }
+    void SetColorConversionEnabled(bool bEnable);
 
     /**
      * Check if color conversion is enabled.
@@ -130,6 +136,8 @@ public:
 
     /**
      * Set number of capture buffers (for pipelining).
+     * Sizes both the readback ring and the frame pool; frames already
+     * delivered stay valid.
      * @param NumBuffers Number of buffers (2-8)
      */
     void SetBufferCount(int32 NumBuffers);
@@ -138,7 +146,14 @@ public:
      * Get number of capture buffers.
      * @return Buffer count
      */
-    int32 GetBufferCount() const { return CaptureBuffers.Num(); }
+    int32 GetBufferCount() const { return BufferCount; }
+
+    /**
+     * Get the most recently delivered frame.
+     * Holding the reference keeps the frame out of the pool.
+     * @return Frame, or an empty handle before the first capture
+     */
+    FRship2110FrameRef GetLastFrame() const;
 
     // ========================================================================
     // COLOR MANAGEMENT INTEGRATION
@@ -160,7 +175,7 @@ public:
     void SyncColorimetryFromColorManagement(UWorld* World);
 
     /**
-     * Set colorimetry and reinitialize color conversion LUTs.
+     * Set colorimetry and reconfigure color conversion.
      * @param NewColorimetry New colorimetry to use
      */
     void SetColorimetry(ERship2110Colorimetry NewColorimetry);
@@ -232,24 +247,19 @@ private:
     bool bGPUDirectEnabled = false;
     bool bIsInitialized = false;
 
-    // Buffer pool
-    struct FCaptureBuffer
+    // Readback ring and frame pool (ring driven on the render thread)
+    TSharedPtr<FRship2110GPUReadbackSource, ESPMode::ThreadSafe> ReadbackSource;
+    FRship2110ReadbackRing Readback;
+    static constexpr int32 DefaultBufferCount = 3;
+    int32 BufferCount = DefaultBufferCount;
+
+    // Per readback slot, render thread only
+    struct FSlotRequest
     {
-        TArray<uint8> Data;
-        FRshipPTPTimestamp Timestamp;
-        bool bInUse = false;
-        bool bReadyForRead = false;
-        double CaptureStartTime = 0.0;
         FOnFrameCaptured Callback;
-
-        // GPU resources for async readback
-        FRship2110TextureRHIRef StagingTexture;
-        void* MappedPtr = nullptr;
-        bool bGPUReadbackPending = false;
+        double CaptureStartTime = 0.0;
     };
-    TArray<FCaptureBuffer> CaptureBuffers;
-    int32 CurrentCaptureIndex = 0;
-    static constexpr int32 DefaultBufferCount = 3;
+    TArray<FSlotRequest> SlotRequests;
 
     // Pending capture requests
     struct FPendingCapture
@@ -260,41 +270,34 @@ private:
         UTexture2D* Texture = nullptr;
         FRshipPTPTimestamp Timestamp;
         FOnFrameCaptured Callback;
-        int32 BufferIndex = -1;
     };
     TArray<FPendingCapture> PendingCaptures;
+
+    // Frames read back and waiting for the game thread
+    struct FCompletedCapture
+    {
+        FRship2110FrameRef Frame;
+        FOnFrameCaptured Callback;
+        double CaptureStartTime = 0.0;
+    };
+    TArray<FCompletedCapture> CompletedCaptures;
     FCriticalSection CaptureLock;
 
+    FRship2110FrameRef LastFrame;
+
     // Statistics
     int64 TotalFramesCaptured = 0;
     TArray<double> CaptureLatencies;
     static constexpr int32 MaxLatencySamples = 100;
 
-    // Color conversion LUTs (for fast CPU conversion)
-    TArray<int32> RtoYLUT;
-    TArray<int32> GtoYLUT;
-    TArray<int32> BtoYLUT;
-    TArray<int32> RtoCbLUT;
-    TArray<int32> GtoCbLUT;
-    TArray<int32> BtoCbLUT;
-    TArray<int32> RtoCrLUT;
-    TArray<int32> GtoCrLUT;
-    TArray<int32> BtoCrLUT;
-
     // Internal methods
     bool AllocateBuffers();
     void FreeBuffers();
-    int32 AcquireBuffer();
-    void ReleaseBuffer(int32 Index);
-
-    void InitializeColorLUTs();
-    void ConvertRGBAToYCbCr422_CPU(const uint8* RGBA, uint8* YCbCr, int32 Width, int32 Height);
-    void ConvertRGBAToYCbCr444_CPU(const uint8* RGBA, uint8* YCbCr, int32 Width, int32 Height);
 
     // GPU capture methods
-    void CaptureViewport_RenderThread(FRHICommandListImmediate& RHICmdList, int32 BufferIndex, const FRshipPTPTimestamp& Timestamp);
-    void CaptureRenderTarget_RenderThread(FRHICommandListImmediate& RHICmdList, UTextureRenderTarget2D* RT, int32 BufferIndex, const FRshipPTPTimestamp& Timestamp);
-    void CompleteAsyncReadback(int32 BufferIndex);
+    void CaptureViewport_RenderThread(FRHICommandListImmediate& RHICmdList, const FRshipPTPTimestamp& Timestamp, const FOnFrameCaptured& Callback);
+    void CaptureTexture_RenderThread(FRHICommandListImmediate& RHICmdList, FTextureResource* Resource, const FRshipPTPTimestamp& Timestamp, const FOnFrameCaptured& Callback);
+    void PollReadbacks_RenderThread();
 
     // Render thread delegates
     FDelegateHandle ViewportCaptureHandle;
@@ -8,7 +8,8 @@
 // Key features:
 // - Node/Device/Sender resource registration with NMOS registry
 // - SDP manifest generation and serving
-// - Connection management (sender-side)
+// - IS-04 Node API and IS-05 Connection API served over HTTP
+// - Sender-side connection management, with activations scheduled on PTP time
 // - mDNS-SD discovery fallback
 // - Heartbeat maintenance
 
@@ -17,11 +18,16 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "Rship2110Types.h"
+#include "IPMX/RshipNMOSConnection.h"
 #include "Http.h"
+#include "HttpRouteHandle.h"
+#include "HttpResultCallback.h"
 #include "RshipIPMXService.generated.h"
 
 class URship2110Subsystem;
 class URship2110VideoSender;
+class IHttpRouter;
+struct FHttpServerRequest;
 
 /**
  * IPMX / NMOS Discovery and Registration Service.
@@ -36,7 +42,7 @@ class RSHIP2110_API URshipIPMXService : public UObject
 
 public:
     /**
-     * Initialize the IPMX service.
+     * Initialize the IPMX service. The local API server is started separately.
      * @param InSubsystem Parent subsystem
      * @return true if initialization succeeded
      */
@@ -48,7 +54,7 @@ public:
     void Shutdown();
 
     /**
-     * Tick update for heartbeats and registry maintenance.
+     * Tick update for scheduled activations, heartbeats and registry maintenance.
      * @param DeltaTime Time since last tick
      */
     void Tick(float DeltaTime);
@@ -169,7 +175,8 @@ public:
     TArray<FString> GetRegisteredSenderIds() const;
 
     /**
-     * Update sender transport parameters.
+     * Update sender transport parameters. A streaming sender is restarted
+     * if its addresses change.
      * @param SenderId Sender ID
      * @param NewParams New transport parameters
      * @return true if updated
@@ -219,11 +226,12 @@ public:
 
     /**
      * Start local HTTP API server for IS-04/IS-05.
-     * @param Port Port to listen on
+     * @param Port Port for the IS-04 Node API
+     * @param ConnectionPort Port for the IS-05 Connection API (0 = same as Port)
      * @return true if started
      */
     UFUNCTION(BlueprintCallable, Category = "Rship|IPMX")
-    bool StartLocalAPIServer(int32 Port);
+    bool StartLocalAPIServer(int32 Port, int32 ConnectionPort = 0);
 
     /**
      * Stop local API server.
@@ -238,6 +246,13 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Rship|IPMX")
     bool IsLocalAPIRunning() const { return bLocalAPIRunning; }
 
+    /**
+     * Get the port serving the Node API.
+     * @return Port number
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|IPMX")
+    int32 GetLocalAPIPort() const { return LocalAPIPort; }
+
     // ========================================================================
     // EVENTS
     // ========================================================================
@@ -260,14 +275,31 @@ private:
     FRshipNMOSNode NodeConfig;
     FString DeviceId;
 
+    /** State kept alongside each registered sender */
+    struct FSenderState
+    {
+        TWeakObjectPtr<URship2110VideoSender> VideoSender;
+        FString SourceId;
+
+        /** IS-05 staged and active parameters */
+        FRshipNMOSSenderConnection Connection;
+
+        /** Resource changed since it was last sent to the registry */
+        bool bResourceChanged = false;
+    };
+
     // Registered resources
     TMap<FString, FRshipNMOSSender> RegisteredSenders;
-    TMap<FString, FString> SenderToVideoSenderId;  // Maps NMOS sender ID to video sender stream ID
+    TMap<FString, FSenderState> SenderStates;
 
-    // Local API server
+    // Local API server (IS-04 Node API and IS-05 Connection API)
     bool bLocalAPIRunning = false;
     int32 LocalAPIPort = 3212;
-    // HTTP server would be initialized here (using FHttpServerModule or custom)
+    int32 ConnectionAPIPort = 3215;
+    TSharedPtr<IHttpRouter> NodeRouter;
+    TSharedPtr<IHttpRouter> ConnectionRouter;
+    FHttpRouteHandle NodeRoute;
+    FHttpRouteHandle ConnectionRoute;
 
     // Heartbeat tracking
     double HeartbeatInterval = 5.0;
@@ -281,6 +313,15 @@ private:
     FString GenerateUUID() const;
     void InitializeNodeConfig();
     void InitializeDeviceConfig();
+    URship2110VideoSender* FindVideoSender(const FString& SenderId) const;
+    FString GetLocalAPIHost() const;
+    void UnbindLocalAPIRoutes();
+
+    // IS-05 activation
+    FRshipPTPTimestamp GetActivationClock() const;
+    bool ActivateStaged(const FString& SenderId);
+    void ProcessScheduledActivations();
+    void MarkSenderChanged(const FString& SenderId);
 
     // Registry API calls
     void RegisterNode();
@@ -304,11 +345,19 @@ private:
     TSharedPtr<FJsonObject> BuildFlowJson(const FString& SenderId, URship2110VideoSender* VideoSender) const;
     TSharedPtr<FJsonObject> BuildSenderJson(const FString& SenderId) const;
 
-    // Local API handlers (IS-04 Node API)
-    void HandleAPIRequest(const FString& Path, const FString& Method, const FString& Body, FString& OutResponse);
-    FString HandleNodeAPI(const FString& Path) const;
-    FString HandleSendersAPI(const FString& Path) const;
-    FString HandleSingleSenderAPI(const FString& SenderId) const;
+    // Local API handlers; each returns the HTTP status code
+    bool HandleHttpRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete, FString Route);
+    int32 HandleAPIRequest(const FString& Path, const FString& Method, const FString& Body, FString& OutResponse, FString& OutContentType);
+
+    // IS-04 Node API
+    int32 HandleNodeAPI(const TArray<FString>& Segments, FString& OutResponse, FString& OutContentType) const;
+    bool GetNodeResources(const FString& ResourceType, TArray<TSharedPtr<FJsonObject>>& OutResources) const;
+
+    // IS-05 Connection API
+    int32 HandleConnectionAPI(const TArray<FString>& Segments, const FString& Method, const FString& Body, FString& OutResponse, FString& OutContentType);
+    int32 HandleSenderConnectionAPI(const FString& SenderId, const FString& Resource, const FString& Method, const FString& Body, FString& OutResponse, FString& OutContentType);
+    int32 HandleBulkRequest(bool bSenders, const FString& Body, FString& OutResponse);
+    int32 PatchSenderStaged(const FString& SenderId, const TSharedPtr<FJsonObject>& Patch, TSharedPtr<FJsonObject>& OutStaged, FString& OutError);
 
     // mDNS discovery (fallback)
     bool DiscoverRegistryViaMDNS();
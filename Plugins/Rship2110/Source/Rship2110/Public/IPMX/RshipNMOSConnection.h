@@ -0,0 +1,184 @@
+// Copyright Rocketship. All Rights Reserved.
+// IS-05 Connection State for One Sender
+//
+// Staged and active parameters of an RTP sender as the AMWA IS-05
+// Connection API sees them, independent of the HTTP server that serves
+// them and of the stream they control.
+//
+// Key features:
+// - Atomic PATCH of staged parameters with schema and constraint checks
+// - Immediate, absolute and relative activations on the PTP (TAI) timeline
+// - "auto" transport parameters resolved against the stream at activation
+// - Staged, active and constraints resources rendered as IS-05 JSON
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Rship2110Types.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+/**
+ * IS-05 activation modes.
+ */
+enum class ERshipNMOSActivationMode : uint8
+{
+    None,
+    Immediate,
+    ScheduledAbsolute,
+    ScheduledRelative
+};
+
+/**
+ * One leg of RTP sender transport parameters. Empty addresses and
+ * AutoPort stand for "auto".
+ */
+struct RSHIP2110_API FRshipNMOSSenderTransport
+{
+    static constexpr int32 AutoPort = -1;
+
+    FString SourceIP;
+    FString DestinationIP;
+    int32 SourcePort = AutoPort;
+    int32 DestinationPort = AutoPort;
+    bool bRTPEnabled = true;
+
+    /** Take every parameter from a stream's transport */
+    static FRshipNMOSSenderTransport FromParams(const FRship2110TransportParams& Params);
+};
+
+/**
+ * A staged or active activation.
+ */
+struct RSHIP2110_API FRshipNMOSActivation
+{
+    ERshipNMOSActivationMode Mode = ERshipNMOSActivationMode::None;
+
+    /** Time as sent by the client, "seconds:nanoseconds" (absolute TAI or an offset) */
+    FString RequestedTime;
+
+    /** TAI time the activation happens or happened; valid when bHasActivationTime */
+    FRshipPTPTimestamp ActivationTime;
+    bool bHasActivationTime = false;
+
+    /** Check whether an activation is waiting for its time */
+    bool IsScheduled() const
+    {
+        return Mode == ERshipNMOSActivationMode::ScheduledAbsolute ||
+               Mode == ERshipNMOSActivationMode::ScheduledRelative;
+    }
+};
+
+/**
+ * Sender parameters as carried by the staged and active resources.
+ */
+struct RSHIP2110_API FRshipNMOSSenderParams
+{
+    /** Receiver the sender is connected to; empty for null */
+    FString ReceiverId;
+    bool bMasterEnable = false;
+    FRshipNMOSActivation Activation;
+    FRshipNMOSSenderTransport Transport;
+};
+
+/**
+ * IS-05 staged/active state for one RTP sender.
+ *
+ * PatchStaged validates a request and stages it; the owner then activates
+ * once IsActivationDue reports the activation time has arrived, applying
+ * ResolveTransport to the stream and calling CompleteActivation (or
+ * CancelActivation if the stream refused). Times are TAI, as carried by PTP.
+ * Not thread-safe.
+ */
+class RSHIP2110_API FRshipNMOSSenderConnection
+{
+public:
+    /**
+     * Start from a stream's current transport, disabled, with nothing staged.
+     * @param Params Stream transport parameters
+     */
+    void Initialize(const FRship2110TransportParams& Params);
+
+    /**
+     * Validate and stage a PATCH request. Nothing changes unless it succeeds.
+     * @param Patch Request body
+     * @param Now Current TAI time
+     * @param OutError Receives the reason for a 400 or 423
+     * @return HTTP status: 200 (staged, or activated immediately), 202 (scheduled), 400 or 423
+     */
+    int32 PatchStaged(const TSharedPtr<FJsonObject>& Patch, const FRshipPTPTimestamp& Now, FString& OutError);
+
+    /**
+     * Check whether the staged parameters should be made active.
+     * @param Now Current TAI time
+     * @return true if an activation is staged and its time has come
+     */
+    bool IsActivationDue(const FRshipPTPTimestamp& Now) const;
+
+    /**
+     * Resolve the staged transport against the stream's current parameters.
+     * @param Current Stream transport parameters
+     * @return Parameters to apply, with every "auto" value filled in
+     */
+    FRship2110TransportParams ResolveTransport(const FRship2110TransportParams& Current) const;
+
+    /**
+     * Make the staged parameters active and clear the staged activation.
+     * @param Resolved Transport that was applied to the stream
+     */
+    void CompleteActivation(const FRship2110TransportParams& Resolved);
+
+    /** Clear the staged activation without changing the active parameters */
+    void CancelActivation();
+
+    /**
+     * Record a transport change made outside IS-05.
+     * @param Params Stream transport parameters
+     */
+    void SetActiveTransport(const FRship2110TransportParams& Params);
+
+    /**
+     * Record a stream started or stopped outside IS-05.
+     * @param bEnabled Whether the stream is sending
+     */
+    void SetActiveEnabled(bool bEnabled);
+
+    /** Get the staged parameters */
+    const FRshipNMOSSenderParams& GetStaged() const { return Staged; }
+
+    /** Get the active parameters */
+    const FRshipNMOSSenderParams& GetActive() const { return Active; }
+
+    /** Render the staged resource */
+    TSharedPtr<FJsonObject> GetStagedJson() const { return ParamsToJson(Staged); }
+
+    /** Render the active resource */
+    TSharedPtr<FJsonObject> GetActiveJson() const { return ParamsToJson(Active); }
+
+    /** Render the constraints resource (one entry per leg) */
+    static TArray<TSharedPtr<FJsonValue>> GetConstraintsJson();
+
+    /**
+     * Parse an IS-05 time, "seconds:nanoseconds".
+     * @param Text Time string
+     * @param OutTime Receives the time
+     * @return false if the string is malformed
+     */
+    static bool ParseTime(const FString& Text, FRshipPTPTimestamp& OutTime);
+
+    /**
+     * Format an IS-05 time.
+     * @param Time TAI time or offset
+     * @return "seconds:nanoseconds"
+     */
+    static FString FormatTime(const FRshipPTPTimestamp& Time);
+
+private:
+    static bool ParseTransportLeg(const FJsonObject& Leg, FRshipNMOSSenderTransport& InOutTransport, FString& OutError);
+    static bool ParseActivation(const FJsonObject& Json, const FRshipPTPTimestamp& Now,
+                                FRshipNMOSActivation& OutActivation, FString& OutError);
+    static TSharedPtr<FJsonObject> ParamsToJson(const FRshipNMOSSenderParams& Params);
+
+    FRshipNMOSSenderParams Staged;
+    FRshipNMOSSenderParams Active;
+};
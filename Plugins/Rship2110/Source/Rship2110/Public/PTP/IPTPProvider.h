@@ -3,7 +3,7 @@
 //
 // This allows swapping PTP implementations based on platform:
 // - Windows: Uses Windows PTP client APIs
-// - Linux: Uses linuxptp / ptp4l integration
+// - Linux: Built-in PTPv2 slave on kernel (SO_TIMESTAMPING) timestamps
 // - Fallback: System clock with offset estimation
 
 #pragma once
@@ -97,6 +97,31 @@ public:
     virtual FString GetProviderName() const = 0;
 };
 
+/**
+ * Network setup for the built-in PTP slave.
+ * Defaults are SMPTE 2059-2 over UDP/IPv4 multicast.
+ */
+struct RSHIP2110_API FRshipPTPSocketConfig
+{
+    /** Local port for event messages (Sync, Delay_Req) */
+    int32 EventPort = 319;
+
+    /** Local port for general messages (Follow_Up, Delay_Resp, Announce) */
+    int32 GeneralPort = 320;
+
+    /** Group joined for the master's messages */
+    FString MulticastGroup = TEXT("224.0.1.129");
+
+    /** Where Delay_Req goes (empty = MulticastGroup) */
+    FString DestinationIP;
+
+    /** Port Delay_Req goes to (0 = EventPort) */
+    int32 DestinationPort = 0;
+
+    /** Use NIC timestamps and the PTP hardware clock when the driver has them */
+    bool bHardwareTimestamping = true;
+};
+
 /**
  * Factory for creating platform-appropriate PTP providers.
  */
@@ -115,4 +140,12 @@ public:
      * @return Unique pointer to fallback provider
      */
     static TUniquePtr<IPTPProvider> CreateFallback();
+
+    /**
+     * Create the built-in PTPv2 slave with explicit network settings.
+     * Linux only.
+     * @param SocketConfig Ports, addresses and timestamping
+     * @return Unique pointer to provider, or nullptr on other platforms
+     */
+    static TUniquePtr<IPTPProvider> CreateSlave(const FRshipPTPSocketConfig& SocketConfig);
 };
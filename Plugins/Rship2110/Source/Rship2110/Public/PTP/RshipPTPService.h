@@ -190,6 +190,12 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Rship|PTP")
     FRshipPTPGrandmaster GetGrandmaster() const;
 
+    /**
+     * Get the platform provider, for timing code that needs it directly.
+     * @return Provider, or nullptr before Initialize / after Shutdown
+     */
+    const IPTPProvider* GetProvider() const { return Provider.Get(); }
+
     // ========================================================================
     // CONTROL
     // ========================================================================
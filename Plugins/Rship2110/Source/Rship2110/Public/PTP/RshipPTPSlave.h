@@ -0,0 +1,342 @@
+// Copyright Rocketship. All Rights Reserved.
+// IEEE 1588-2008 Ordinary Slave
+//
+// Platform-independent PTPv2 protocol engine. Transports feed it messages
+// with their receive timestamps and send the Delay_Req it asks for; it
+// disciplines a software clock that maps the local timestamp clock onto
+// the grandmaster's timescale.
+//
+// Key features:
+// - PTPv2 message codec: Sync, Follow_Up, Delay_Req, Delay_Resp, Announce
+// - One- and two-step masters, correctionField applied
+// - Best master selection from Announce (priority1, class, accuracy, variance, priority2, identity)
+// - Moving-median path delay filter
+// - PI servo with linuxptp's sync-interval scaling, phase step on large offsets
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Rship2110Types.h"
+
+/**
+ * One PTPv2 message. Fields not used by a message type are ignored.
+ */
+struct RSHIP2110_API FRshipPTPMessage
+{
+    enum class EType : uint8
+    {
+        Sync = 0x0,
+        DelayReq = 0x1,
+        FollowUp = 0x8,
+        DelayResp = 0x9,
+        Announce = 0xB,
+    };
+
+    /** Largest encoded message (Announce) */
+    static constexpr int32 MaxSize = 64;
+
+    EType Type = EType::Sync;
+    uint8 Domain = 0;
+
+    /** Sync sent by a two-step master; the time follows in Follow_Up */
+    bool bTwoStep = false;
+
+    /** correctionField, nanoseconds (sub-nanosecond part dropped) */
+    int64 CorrectionNs = 0;
+
+    uint64 SourceClockIdentity = 0;
+    uint16 SourcePort = 0;
+    uint16 SequenceId = 0;
+    int8 LogMessageInterval = 0;
+
+    /** originTimestamp, preciseOriginTimestamp or receiveTimestamp */
+    FRshipPTPTimestamp Timestamp;
+
+    // Delay_Resp
+    uint64 RequestingClockIdentity = 0;
+    uint16 RequestingPort = 0;
+
+    // Announce
+    int16 CurrentUtcOffset = 0;
+    uint8 Priority1 = 128;
+    uint8 Priority2 = 128;
+    FRshipPTPClockQuality Quality;
+    uint64 GrandmasterIdentity = 0;
+    uint16 StepsRemoved = 0;
+
+    /**
+     * Encode for the wire.
+     * @param Out Receives up to MaxSize bytes
+     * @return Bytes written
+     */
+    int32 Encode(uint8* Out) const;
+
+    /**
+     * Decode a received message.
+     * @return false if it is not a PTPv2 message this engine handles
+     */
+    bool Decode(const uint8* Data, int32 Size);
+
+    /** Event messages are timestamped and use port 319 */
+    bool IsEvent() const { return Type == EType::Sync || Type == EType::DelayReq; }
+
+    /** Format a clock identity as PTP tools print it (xx:xx:xx:xx:xx:xx:xx:xx) */
+    static FString FormatClockIdentity(uint64 ClockIdentity);
+};
+
+/**
+ * PI clock servo.
+ *
+ * Takes offset samples (master minus slave) and returns the frequency
+ * correction that drives them to zero. The first two samples estimate the
+ * frequency error and step the phase; from then on the PI loop runs, with
+ * gains scaled to the sync interval as linuxptp does.
+ */
+class RSHIP2110_API FRshipPTPServo
+{
+public:
+    enum class EResult : uint8
+    {
+        /** Not enough samples yet; leave the clock alone */
+        Unlocked,
+
+        /** Step the phase by the offset, then apply the frequency */
+        Jump,
+
+        /** Apply the frequency */
+        Locked,
+    };
+
+    struct FConfig
+    {
+        // linuxptp hardware-timestamping defaults
+        double KpScale = 0.7;
+        double KpExponent = -0.3;
+        double KpNormMax = 0.7;
+        double KiScale = 0.3;
+        double KiExponent = 0.4;
+        double KiNormMax = 0.3;
+
+        /** Step instead of slewing once locked (0 = never) */
+        int64 StepThresholdNs = 1000000;
+
+        /** Step on the first lock if the offset is larger (0 = always) */
+        int64 FirstStepThresholdNs = 20000;
+
+        /** Largest frequency correction */
+        double MaxFrequencyPPB = 500000.0;
+    };
+
+    /**
+     * Set gains for a sync interval. Resets the servo.
+     * @param InConfig Gain constants
+     * @param SyncIntervalSeconds Seconds between samples
+     */
+    void Configure(const FConfig& InConfig, double SyncIntervalSeconds);
+
+    /** Forget all samples */
+    void Reset();
+
+    /**
+     * Feed one offset sample.
+     * @param OffsetNs Master minus slave
+     * @param LocalTimeNs Slave time of the sample
+     * @param OutFrequencyPPB Receives the frequency correction to apply (positive = run faster)
+     * @return What to do with the clock
+     */
+    EResult Sample(int64 OffsetNs, uint64 LocalTimeNs, double& OutFrequencyPPB);
+
+    double GetKp() const { return Kp; }
+    double GetKi() const { return Ki; }
+
+    /** Integrated frequency estimate */
+    double GetDriftPPB() const { return Drift; }
+
+private:
+    FConfig Config;
+    double Kp = 0.7;
+    double Ki = 0.3;
+
+    int32 Count = 0;
+    int64 FirstOffsetNs = 0;
+    uint64 FirstLocalNs = 0;
+    double Drift = 0.0;
+};
+
+/**
+ * Software clock steered by the servo.
+ * PTP = Local + Offset + (Local - Reference) * Frequency.
+ */
+struct RSHIP2110_API FRshipPTPClockModel
+{
+    uint64 ReferenceLocalNs = 0;
+    int64 OffsetNs = 0;
+    double FrequencyPPB = 0.0;
+
+    /** Map a local timestamp onto the PTP timescale */
+    uint64 ToPTP(uint64 LocalNs) const
+    {
+        const double Elapsed = static_cast<double>(static_cast<int64>(LocalNs - ReferenceLocalNs));
+        return LocalNs + OffsetNs + static_cast<int64>(Elapsed * FrequencyPPB * 1e-9);
+    }
+
+    /** Re-anchor at a local time, then apply a step and a new frequency */
+    void Adjust(uint64 LocalNs, int64 StepNs, double NewFrequencyPPB)
+    {
+        OffsetNs = static_cast<int64>(ToPTP(LocalNs) - LocalNs) + StepNs;
+        ReferenceLocalNs = LocalNs;
+        FrequencyPPB = NewFrequencyPPB;
+    }
+};
+
+/**
+ * IEEE 1588 ordinary clock in the slave state.
+ *
+ * Drive it from one thread: HandleMessage for every received message,
+ * PollDelayRequest / OnDelayRequestSent for the delay mechanism. Local
+ * timestamps must all come from the same clock (PHC or system).
+ */
+class RSHIP2110_API FRshipPTPSlave
+{
+public:
+    struct FConfig
+    {
+        uint8 Domain = 127;
+
+        /** This port's identity */
+        uint64 ClockIdentity = 0;
+        uint16 PortNumber = 1;
+
+        /** Seconds between Delay_Req; SMPTE 2059-2 allows down to the sync interval */
+        double DelayRequestIntervalSeconds = 0.125;
+
+        /** Sync interval assumed until the master's logMessageInterval is seen */
+        double SyncIntervalSeconds = 0.125;
+
+        /** Offset below which a sample counts towards lock */
+        int64 LockThresholdNs = 1000;
+
+        /** Consecutive samples under the threshold to declare lock */
+        int32 LockSamples = 8;
+
+        /** No Sync for this long while locked = holdover */
+        double SyncTimeoutSeconds = 2.0;
+
+        /** No Announce for this long = master lost */
+        double AnnounceTimeoutSeconds = 6.0;
+
+        /** Path delay samples in the moving median */
+        int32 DelayFilterLength = 9;
+
+        FRshipPTPServo::FConfig Servo;
+    };
+
+    void Configure(const FConfig& InConfig);
+
+    /** Drop the master and all timing state; the clock model is kept */
+    void Reset();
+
+    /**
+     * Process a received message.
+     * @param Message Decoded message
+     * @param RxLocalNs Receive timestamp on the local clock (event messages)
+     */
+    void HandleMessage(const FRshipPTPMessage& Message, uint64 RxLocalNs);
+
+    /**
+     * Check whether a Delay_Req is due and build it.
+     * @param NowLocalNs Local time
+     * @param OutMessage Receives the Delay_Req to send
+     * @return true if one should be sent now
+     */
+    bool PollDelayRequest(uint64 NowLocalNs, FRshipPTPMessage& OutMessage);
+
+    /**
+     * Report when a Delay_Req left.
+     * @param SequenceId Its sequence ID
+     * @param TxLocalNs Transmit timestamp on the local clock
+     */
+    void OnDelayRequestSent(uint16 SequenceId, uint64 TxLocalNs);
+
+    /**
+     * Advance timeouts (holdover, master loss).
+     * @param NowLocalNs Local time
+     */
+    void Update(uint64 NowLocalNs);
+
+    // ========================================================================
+    // RESULTS
+    // ========================================================================
+
+    const FRshipPTPClockModel& GetClock() const { return Clock; }
+    ERshipPTPState GetState() const { return State; }
+
+    /** Last measured offset, master minus slave */
+    int64 GetLastOffsetNs() const { return LastOffsetNs; }
+
+    /** Filtered one-way path delay */
+    int64 GetMeanPathDelayNs() const { return MeanPathDelayNs; }
+
+    /** Standard deviation of recent offsets */
+    double GetJitterNs() const;
+
+    /** Offset samples taken */
+    int64 GetSampleCount() const { return SampleCount; }
+
+    /** Selected master, if any */
+    bool HasMaster() const { return bHasMaster; }
+    const FRshipPTPMessage& GetMasterAnnounce() const { return MasterAnnounce; }
+
+private:
+    /** Pair Sync with its Follow_Up (or take a one-step Sync) */
+    void HandleSyncTime(uint64 MasterNs, int64 CorrectionNs);
+
+    /** Run one offset sample through the servo */
+    void ProcessSample(int64 OffsetNs, uint64 RxLocalNs);
+
+    /** Forget timing from the previous master */
+    void ResetTiming();
+
+    bool IsBetterMaster(const FRshipPTPMessage& Candidate, const FRshipPTPMessage& Current) const;
+    bool IsFromMaster(const FRshipPTPMessage& Message) const;
+
+    FConfig Config;
+    FRshipPTPServo Servo;
+    FRshipPTPClockModel Clock;
+    ERshipPTPState State = ERshipPTPState::Listening;
+
+    // Master
+    bool bHasMaster = false;
+    FRshipPTPMessage MasterAnnounce;
+    uint64 LastAnnounceLocalNs = 0;
+    double SyncIntervalSeconds = 0.125;
+
+    // Sync in flight (two-step)
+    bool bSyncPending = false;
+    uint16 SyncSequenceId = 0;
+    uint64 SyncRxLocalNs = 0;
+    int64 SyncCorrectionNs = 0;
+    uint64 LastSyncLocalNs = 0;
+
+    // Last Sync time pair: t1 + correction, and its local receive time
+    bool bHaveSyncPair = false;
+    uint64 LastSyncMasterNs = 0;
+    uint64 LastSyncRxLocalNs = 0;
+
+    // Delay mechanism
+    uint16 DelayReqSequenceId = 0;
+    bool bDelayReqInFlight = false;
+    uint64 DelayReqTxLocalNs = 0;
+    uint64 NextDelayReqLocalNs = 0;
+    TArray<int64> DelaySamples;
+    int32 DelaySampleIndex = 0;
+    int64 MeanPathDelayNs = 0;
+    bool bHaveDelay = false;
+
+    // Servo state
+    int32 SamplesUnderThreshold = 0;
+    int64 LastOffsetNs = 0;
+    int64 SampleCount = 0;
+    TArray<int64> RecentOffsets;
+    int32 RecentOffsetIndex = 0;
+};
@@ -0,0 +1,277 @@
+// Copyright Rocketship. All Rights Reserved.
+// SMPTE ST 2110-40 / RFC 8331 Ancillary Data Packetizer
+//
+// Carries SMPTE ST 291-1 ancillary data packets over RTP, and builds the
+// payloads most shows need.
+//
+// Key features:
+// - 10-bit DID / SDID / Data_Count / UDW words with ST 291 parity (b8 even, b9 = !b8)
+// - ST 291 checksum word
+// - Line, horizontal offset, C and StreamNum location fields, 32-bit word alignment
+// - Extended sequence number, marker bit on the last packet of each frame
+// - ATC timecode (ST 12-2), CEA-708 caption CDP (ST 334-2), SCTE-104 splice requests
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Timecode.h"
+#include "Misc/FrameRate.h"
+#include "Rivermax/Rship2110VideoPacketizer.h"
+
+/**
+ * One ST 291-1 ancillary data packet.
+ * Words are given as their 8-bit values; parity bits are added on the wire.
+ */
+struct RSHIP2110_API FRship2110AncPacket
+{
+    /** Line number value meaning "no specific line" */
+    static constexpr uint16 AnyLine = 0x7FF;
+
+    /** Horizontal offset value meaning "no specific position" */
+    static constexpr uint16 AnyOffset = 0xFFF;
+
+    /** Data identifier */
+    uint8 DID = 0;
+
+    /** Secondary data identifier (type 2 packets) */
+    uint8 SDID = 0;
+
+    /** User data words, at most 255 */
+    TArray<uint8> UserData;
+
+    /** Line the packet belongs on (11 bits) */
+    uint16 LineNumber = AnyLine;
+
+    /** Horizontal position in the line (12 bits) */
+    uint16 HorizontalOffset = AnyOffset;
+
+    /** Carried in the colour-difference data stream (C bit) */
+    bool bColorDifference = false;
+
+    /** Link or stream the packet belongs to (0-127), or -1 when unspecified (S bit clear) */
+    int32 StreamNum = -1;
+
+    /** Check the fields fit their wire widths */
+    bool IsValid() const
+    {
+        return UserData.Num() <= 255 && LineNumber <= 0x7FF && HorizontalOffset <= 0xFFF && StreamNum <= 127;
+    }
+
+    bool operator==(const FRship2110AncPacket& Other) const
+    {
+        return DID == Other.DID && SDID == Other.SDID && UserData == Other.UserData &&
+               LineNumber == Other.LineNumber && HorizontalOffset == Other.HorizontalOffset &&
+               bColorDifference == Other.bColorDifference && StreamNum == Other.StreamNum;
+    }
+};
+
+/**
+ * Packetizes ancillary data for one 2110-40 stream.
+ *
+ * Each frame's ANC packets go out in as few RTP packets as fit the size
+ * limit, all with the frame's RTP timestamp; the last carries the marker
+ * bit. A frame with no ANC data still sends one empty packet so receivers
+ * see the frame. Frames are sent progressive (F = 0).
+ *
+ * Not thread-safe; one packetizer per stream.
+ */
+class RSHIP2110_API FRship2110AncPacketizer
+{
+public:
+    static constexpr int32 RTPHeaderSize = 12;
+    static constexpr int32 PayloadHeaderSize = 8;
+
+    /** ST 2110-10 standard UDP size limit */
+    static constexpr int32 DefaultMaxPacketSize = 1460;
+
+    /**
+     * Set the RTP identity.
+     * @param InPayloadType RTP payload type
+     * @param InSSRC RTP synchronization source
+     * @param InMaxPacketSize Largest UDP payload to emit; must hold the largest ANC packet
+     */
+    void Configure(uint8 InPayloadType, uint32 InSSRC, int32 InMaxPacketSize = DefaultMaxPacketSize);
+
+    /**
+     * Build the RTP packets for one frame.
+     * @param AncPackets ANC packets for the frame; invalid ones are skipped
+     * @param RTPTimestamp 90 kHz timestamp of the video frame they belong to
+     * @return Packets in send order, valid until the next call
+     */
+    TConstArrayView<FRship2110Packet> PacketizeFrame(TConstArrayView<FRship2110AncPacket> AncPackets, uint32 RTPTimestamp);
+
+    /** Get the 32-bit sequence number of the next packet */
+    uint32 GetExtendedSequenceNumber() const { return ExtendedSequenceNumber; }
+
+    /** Set the 32-bit sequence number of the next packet */
+    void SetExtendedSequenceNumber(uint32 InSequenceNumber) { ExtendedSequenceNumber = InSequenceNumber; }
+
+    /** Get the ANC packets skipped for being invalid or too large to fit a packet */
+    int64 GetSkippedCount() const { return SkippedCount; }
+
+    /**
+     * Get the bytes one ANC packet takes in an RTP payload, alignment included.
+     * @param Packet ANC packet
+     * @return Encoded size, a multiple of 4
+     */
+    static int32 GetEncodedSize(const FRship2110AncPacket& Packet);
+
+    /**
+     * Encode one ANC packet as RFC 8331 packs it.
+     * @param Packet ANC packet; must be IsValid()
+     * @param Dest Receives GetEncodedSize(Packet) bytes
+     */
+    static void EncodeAncPacket(const FRship2110AncPacket& Packet, uint8* Dest);
+
+    /** Add ST 291 parity to an 8-bit word: b8 makes b0-b8 even, b9 = !b8 */
+    static uint16 AddParity(uint8 Value);
+
+    /** Compute the checksum word: 9-bit sum of DID, SDID, DC and UDWs, b9 = !b8 */
+    static uint16 ComputeChecksum(TConstArrayView<uint16> Words);
+
+private:
+    uint8 PayloadType = 100;
+    uint32 SSRC = 0;
+    int32 MaxPacketSize = DefaultMaxPacketSize;
+    uint32 ExtendedSequenceNumber = 0;
+    int64 SkippedCount = 0;
+
+    TArray<uint8> Arena;
+    TArray<FRship2110Packet> Packets;
+
+    // Per-frame plan: which ANC packets go out, and where each RTP packet starts
+    TArray<int32> Selected;
+    TArray<int32> GroupStarts;
+};
+
+/**
+ * Reassembles a 2110-40 stream into ANC packets, checking every word.
+ */
+class RSHIP2110_API FRship2110AncDepacketizer
+{
+public:
+    /** Receive counters */
+    struct FStats
+    {
+        int64 PacketsReceived = 0;
+        int64 PacketsLost = 0;
+        int64 PacketsMalformed = 0;
+        int64 FramesCompleted = 0;
+
+        /** ANC packets with a parity error in any word */
+        int64 ParityErrors = 0;
+
+        /** ANC packets whose checksum word did not match */
+        int64 ChecksumErrors = 0;
+    };
+
+    /**
+     * Consume one RTP packet. ANC packets that fail parity or checksum are dropped.
+     * @param Data UDP payload
+     * @param Size Bytes in the payload
+     * @return true if this packet completed a frame (marker bit set)
+     */
+    bool ReceivePacket(const uint8* Data, int32 Size);
+
+    /** Get the ANC packets of the current frame */
+    const TArray<FRship2110AncPacket>& GetFramePackets() const { return FramePackets; }
+
+    /** Get the RTP timestamp of the current frame */
+    uint32 GetFrameTimestamp() const { return FrameTimestamp; }
+
+    /** Get receive counters */
+    const FStats& GetStats() const { return Stats; }
+
+private:
+    /** Decode one ANC packet; returns bytes consumed, or 0 if it runs past the end */
+    int32 DecodeAncPacket(const uint8* Data, int32 Size);
+
+    TArray<FRship2110AncPacket> FramePackets;
+    uint32 FrameTimestamp = 0;
+    bool bFrameComplete = false;
+
+    bool bHavePacket = false;
+    uint32 LastSequenceNumber = 0;
+
+    FStats Stats;
+};
+
+/**
+ * Builders for common ancillary payloads.
+ */
+struct RSHIP2110_API FRship2110AncData
+{
+    /** ATC payload types (DBB1) */
+    enum class ETimecodeType : uint8
+    {
+        LTC = 0x00,
+        VITC1 = 0x01,
+        VITC2 = 0x02,
+    };
+
+    /** SCTE-104 splice_insert_type values */
+    enum class ESpliceInsertType : uint8
+    {
+        StartNormal = 1,
+        StartImmediate = 2,
+        EndNormal = 3,
+        EndImmediate = 4,
+        Cancel = 5,
+    };
+
+    /**
+     * Build an ATC timecode packet (DID 0x60, SDID 0x60).
+     * Frame counts must fit the 30-frame count; for 50/60p pass the frame pair.
+     * @param Timecode Time to send; bDropFrameFormat sets the drop-frame flag
+     * @param Type LTC or VITC
+     * @param UserBits Binary groups 1-8, group 1 in the low nibble
+     * @return ANC packet on line 9
+     */
+    static FRship2110AncPacket MakeTimecode(const FTimecode& Timecode, ETimecodeType Type = ETimecodeType::LTC, uint32 UserBits = 0);
+
+    /**
+     * Read an ATC timecode packet back.
+     * @param Packet ANC packet
+     * @param OutTimecode Receives the time
+     * @return false if the packet is not ATC
+     */
+    static bool ParseTimecode(const FRship2110AncPacket& Packet, FTimecode& OutTimecode);
+
+    /**
+     * Build a CEA-708 caption distribution packet (DID 0x61, SDID 0x01).
+     * @param CCData cc_data triplets (marker/valid/type, data 1, data 2); padded to the
+     *               frame rate's cc_count, extra triplets dropped
+     * @param FrameRate Video frame rate; must be one CEA-708 defines
+     * @param Sequence cdp_hdr_sequence_cntr
+     * @return ANC packet on line 9, or a packet with no data if the rate is not supported
+     */
+    static FRship2110AncPacket MakeCaptionCDP(TConstArrayView<uint8> CCData, const FFrameRate& FrameRate, uint16 Sequence);
+
+    /**
+     * Get the cc_data triplets one frame carries at a frame rate.
+     * @return Triplet count, or 0 if CEA-708 does not define the rate
+     */
+    static int32 GetCaptionTripletsPerFrame(const FFrameRate& FrameRate);
+
+    /**
+     * Build a SCTE-104 packet (DID 0x41, SDID 0x07) holding one message.
+     * @param Message SCTE-104 message, at most 254 bytes
+     * @return ANC packet on line 9
+     */
+    static FRship2110AncPacket MakeSCTE104(TConstArrayView<uint8> Message);
+
+    /**
+     * Build a SCTE-104 multiple_operation_message with one splice_request_data.
+     * @param Type Splice insert type
+     * @param SpliceEventId splice_event_id
+     * @param UniqueProgramId unique_program_id
+     * @param PreRollMs Time to the splice point in milliseconds
+     * @param BreakDurationTenths Break length in tenths of a second (0 = none)
+     * @param bAutoReturn Return from the break automatically
+     * @param MessageNumber message_number
+     * @return Message bytes
+     */
+    static TArray<uint8> MakeSpliceRequest(ESpliceInsertType Type, uint32 SpliceEventId, uint16 UniqueProgramId,
+                                           uint16 PreRollMs, uint16 BreakDurationTenths, bool bAutoReturn,
+                                           uint8 MessageNumber = 0);
+};
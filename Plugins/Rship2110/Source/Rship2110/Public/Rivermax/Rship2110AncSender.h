@@ -1,20 +1,27 @@
 // Copyright Rocketship. All Rights Reserved.
-// SMPTE ST 2110-40 Ancillary Data Sender (Stub)
+// SMPTE ST 2110-40 Ancillary Data Sender
 //
-// Placeholder for future ancillary data streaming implementation.
-// Will support:
-// - Timecodes (VITC, LTC)
-// - Closed captions
-// - Active format description
-// - Custom metadata
+// Sends ST 291 ancillary data alongside a 2110-20 video stream. Packets
+// queued between frames go out with the next video frame's RTP timestamp,
+// so receivers line them up with the picture they belong to.
+//
+// Key features:
+// - Timecode (ATC LTC / VITC)
+// - CEA-708 closed captions (CDP)
+// - SCTE-104 splice requests
+// - Custom DID/SDID packets
 
 #pragma once
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "Rship2110Types.h"
+#include "Rivermax/Rship2110AncPacketizer.h"
+#include "Rivermax/Rship2110PacketTransmitter.h"
 #include "Rship2110AncSender.generated.h"
 
+class URship2110VideoSender;
+
 /**
  * Ancillary data type
  */
@@ -25,17 +32,18 @@ enum class ERship2110AncDataType : uint8
     Timecode_LTC    UMETA(DisplayName = "Timecode (LTC)"),
     ClosedCaption   UMETA(DisplayName = "Closed Captions"),
     AFD             UMETA(DisplayName = "Active Format Description"),
-    Custom          UMETA(DisplayName = "Custom Metadata")
+    Custom          UMETA(DisplayName = "Custom Metadata"),
+    SCTE104         UMETA(DisplayName = "SCTE-104 Splice")
 };
 
 /**
- * SMPTE ST 2110-40 Ancillary Data Sender (Stub Implementation).
+ * SMPTE ST 2110-40 Ancillary Data Sender.
  *
- * This class is a placeholder for future ancillary data support.
- * When fully implemented, it will handle:
- * - Packing timecodes and metadata into 2110-40 packets
- * - Synchronizing with video frames
- * - Supporting multiple ancillary data types
+ * Bound to a video sender, it sends one RTP frame per video frame; with
+ * nothing queued the frame is a single empty packet. Without a video
+ * sender, call SendFrame with the timestamps yourself.
+ *
+ * Queue functions may be called from any thread.
  */
 UCLASS(BlueprintType)
 class RSHIP2110_API URship2110AncSender : public UObject
@@ -43,9 +51,212 @@ class RSHIP2110_API URship2110AncSender : public UObject
     GENERATED_BODY()
 
 public:
-    // TODO: Implement ancillary sender methods
+    /**
+     * Initialize the ancillary sender.
+     * @param InVideoSender Video stream to follow (nullptr = frames driven by SendFrame)
+     * @param InTransportParams Transport parameters
+     * @return true if initialization succeeded
+     */
+    bool Initialize(URship2110VideoSender* InVideoSender, const FRship2110TransportParams& InTransportParams);
+
+    /**
+     * Shutdown and release resources.
+     */
+    void Shutdown();
+
+    // ========================================================================
+    // STREAM CONTROL
+    // ========================================================================
+
+    /**
+     * Start streaming.
+     * @return true if started successfully
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    bool StartStream();
+
+    /**
+     * Stop streaming. Queued packets are discarded.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    void StopStream();
+
+    /**
+     * Get current stream state.
+     * @return Stream state
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    ERship2110StreamState GetState() const { return State; }
+
+    /**
+     * Check if currently streaming.
+     * @return true if streaming
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    bool IsStreaming() const { return State == ERship2110StreamState::Running; }
+
+    /**
+     * Send everything queued as one frame.
+     * Called for each video frame when bound to a video sender.
+     * @param RTPTimestamp 90 kHz timestamp of the video frame
+     */
+    void SendFrame(uint32 RTPTimestamp);
+
+    // ========================================================================
+    // QUEUEING
+    // ========================================================================
+
+    /**
+     * Queue a timecode for the next frame.
+     * @param Timecode Time to send
+     * @param Type Timecode_LTC or Timecode_VITC
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    void QueueTimecode(const FTimecode& Timecode, ERship2110AncDataType Type = ERship2110AncDataType::Timecode_LTC);
+
+    /**
+     * Queue CEA-708 caption data for the next frame.
+     * @param CCData cc_data triplets; padded or trimmed to the video frame rate's count
+     * @return false if the frame rate has no CEA-708 mapping
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    bool QueueCaptionData(const TArray<uint8>& CCData);
+
+    /**
+     * Queue a SCTE-104 splice start (out of network).
+     * @param SpliceEventId Event identifier
+     * @param PreRollMs Time to the splice point (0 = immediate)
+     * @param BreakDurationSeconds Break length (0 = open-ended)
+     * @param bAutoReturn Return to network when the break ends
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    void QueueSpliceStart(int32 SpliceEventId, int32 PreRollMs, float BreakDurationSeconds, bool bAutoReturn = true);
+
+    /**
+     * Queue a SCTE-104 splice end (return to network).
+     * @param SpliceEventId Event identifier of the break
+     * @param PreRollMs Time to the splice point (0 = immediate)
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    void QueueSpliceEnd(int32 SpliceEventId, int32 PreRollMs = 0);
+
+    /**
+     * Queue a custom ANC packet.
+     * @param DID Data identifier (0-255)
+     * @param SDID Secondary data identifier (0-255)
+     * @param UserData Up to 255 user data words
+     * @param LineNumber Line to place it on
+     * @return false if the packet does not fit ST 291
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    bool QueueCustomPacket(int32 DID, int32 SDID, const TArray<uint8>& UserData, int32 LineNumber = 9);
 
-    /** Check if ancillary sending is supported (stub returns false) */
+    /**
+     * Queue any ANC packet for the next frame.
+     * @return false if the packet does not fit ST 291
+     */
+    bool QueuePacket(const FRship2110AncPacket& Packet);
+
+    /**
+     * Get packets waiting for the next frame.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    int32 GetQueuedCount() const;
+
+    // ========================================================================
+    // CONFIGURATION
+    // ========================================================================
+
+    /**
+     * Get transport parameters.
+     * @return Current transport parameters
+     */
     UFUNCTION(BlueprintCallable, Category = "Rship|2110")
-    static bool IsSupported() { return false; }
+    FRship2110TransportParams GetTransportParams() const { return TransportParams; }
+
+    /**
+     * Get the video sender this stream follows.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    URship2110VideoSender* GetVideoSender() const { return VideoSender; }
+
+    /**
+     * Get stream ID.
+     * @return Unique stream identifier
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    FString GetStreamId() const { return StreamId; }
+
+    /**
+     * Set stream ID (called by subsystem).
+     */
+    void SetStreamId(const FString& InStreamId) { StreamId = InStreamId; }
+
+    // ========================================================================
+    // STATISTICS
+    // ========================================================================
+
+    /**
+     * Get stream statistics. FramesDropped counts ANC packets skipped as invalid.
+     * @return Current statistics
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    FRship2110StreamStats GetStatistics() const;
+
+    // ========================================================================
+    // SDP
+    // ========================================================================
+
+    /**
+     * Generate SDP (Session Description Protocol) for this stream.
+     * @return SDP string
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    FString GenerateSDP() const;
+
+    /**
+     * Check if ancillary sending is supported.
+     * Always true; ANC data goes out on the software transmit path.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    static bool IsSupported() { return true; }
+
+    // ========================================================================
+    // EVENTS
+    // ========================================================================
+
+    /** Fired when stream state changes */
+    UPROPERTY(BlueprintAssignable, Category = "Rship|2110")
+    FOn2110StreamStateChanged OnStateChanged;
+
+private:
+    // References
+    UPROPERTY()
+    URship2110VideoSender* VideoSender = nullptr;
+
+    // Configuration
+    FRship2110TransportParams TransportParams;
+    FString StreamId;
+    FFrameRate FrameRate = FFrameRate(60, 1);
+
+    // State
+    ERship2110StreamState State = ERship2110StreamState::Stopped;
+    FRship2110StreamStats Stats;
+    FDelegateHandle FrameQueuedHandle;
+
+    // Packets for the next frame; guarded by QueueLock
+    TArray<FRship2110AncPacket> Queued;
+    mutable FCriticalSection QueueLock;
+    uint16 CaptionSequence = 0;
+    uint8 SpliceMessageNumber = 0;
+
+    // Used only by SendFrame, one frame at a time
+    TArray<FRship2110AncPacket> Sending;
+    FRship2110AncPacketizer Packetizer;
+    TUniquePtr<IRship2110PacketTransmitter> Transmitter;
+    mutable FCriticalSection SendLock;
+
+    void QueueSplice(FRship2110AncData::ESpliceInsertType Type, int32 SpliceEventId, int32 PreRollMs,
+                     float BreakDurationSeconds, bool bAutoReturn);
+    void SetState(ERship2110StreamState NewState);
 };
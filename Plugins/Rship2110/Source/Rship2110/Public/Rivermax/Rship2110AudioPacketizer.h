@@ -0,0 +1,203 @@
+// Copyright Rocketship. All Rights Reserved.
+// ST 2110-30 / AES67 Packetizer and Sample Ring
+//
+// Builds RTP packets of interleaved big-endian PCM and takes them apart
+// again, plus the ring that carries samples from the audio renderer to
+// the transmit thread.
+//
+// Key features:
+// - L16 / L24, 1-64 channels, any packet time the format allows
+// - Float to PCM with clipping; exact for samples on the PCM grid
+// - Depacketizer checks sequence and timestamp continuity
+// - Lock-free single-producer single-consumer sample ring
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Rship2110Types.h"
+#include "Rivermax/Rship2110VideoPacketizer.h"
+#include <atomic>
+
+/**
+ * Packs sample frames into 2110-30 RTP packets.
+ *
+ * One packet holds GetSamplesPerPacket() frames of interleaved samples.
+ * Packets are written into a small arena so a batch can be handed to the
+ * transmitter at once; a slot is reused after GetMaxBatch() packets.
+ */
+class RSHIP2110_API FRship2110AudioPacketizer
+{
+public:
+    static constexpr int32 RTPHeaderSize = 12;
+
+    /**
+     * Set the format and RTP identity.
+     * @param InFormat Audio format; must be IsValid()
+     * @param InPayloadType RTP payload type
+     * @param InSSRC RTP synchronization source
+     * @param InMaxBatch Packets that may be outstanding at once
+     * @return false if the format is not valid
+     */
+    bool Configure(const FRship2110AudioFormat& InFormat, uint8 InPayloadType, uint32 InSSRC, int32 InMaxBatch = 16);
+
+    /** Check whether Configure succeeded */
+    bool IsValid() const { return bValid; }
+
+    /**
+     * Build the next packet.
+     * @param Samples GetSamplesPerPacket() x channels interleaved floats in [-1, 1]
+     * @param RTPTimestamp Media clock time of the first sample
+     * @return Packet in the arena, valid for the next GetMaxBatch() - 1 calls
+     */
+    FRship2110Packet PacketizePacket(const float* Samples, uint32 RTPTimestamp);
+
+    /** Get the format */
+    const FRship2110AudioFormat& GetFormat() const { return Format; }
+
+    /** Get packets the arena holds before slots are reused */
+    int32 GetMaxBatch() const { return MaxBatch; }
+
+    /** Get bytes on the wire per packet (RTP header + payload) */
+    int32 GetPacketSize() const { return PacketSize; }
+
+    /** Get/set the sequence number of the next packet */
+    uint16 GetSequenceNumber() const { return SequenceNumber; }
+    void SetSequenceNumber(uint16 InSequenceNumber) { SequenceNumber = InSequenceNumber; }
+
+    /** Convert a float sample to signed PCM, rounding and clipping to the bit depth */
+    static int32 FloatToPCM(float Sample, int32 BitsPerSample);
+
+    /** Convert signed PCM to a float sample */
+    static float PCMToFloat(int32 Sample, int32 BitsPerSample);
+
+private:
+    FRship2110AudioFormat Format;
+    bool bValid = false;
+    uint8 PayloadType = 96;
+    uint32 SSRC = 0;
+    int32 PacketSize = 0;
+    int32 MaxBatch = 0;
+
+    TArray<uint8> Arena;
+    int32 NextSlot = 0;
+    uint16 SequenceNumber = 0;
+};
+
+/**
+ * Reassembles a 2110-30 stream into PCM samples.
+ */
+class RSHIP2110_API FRship2110AudioDepacketizer
+{
+public:
+    /** Receive counters */
+    struct FStats
+    {
+        int64 PacketsReceived = 0;
+        int64 PacketsLost = 0;
+        int64 PacketsMalformed = 0;
+
+        /** Packets whose timestamp did not follow the previous packet's */
+        int64 TimestampJumps = 0;
+    };
+
+    /**
+     * Set the expected format.
+     * @param InFormat Audio format of the stream
+     * @return false if the format is not valid
+     */
+    bool Configure(const FRship2110AudioFormat& InFormat);
+
+    /**
+     * Consume one RTP packet, appending its samples.
+     * @param Data UDP payload
+     * @param Size Bytes in the payload
+     * @return false if the packet was malformed
+     */
+    bool ReceivePacket(const uint8* Data, int32 Size);
+
+    /** Get received samples, interleaved, as signed PCM */
+    const TArray<int32>& GetSamples() const { return Samples; }
+
+    /** Drop received samples */
+    void ClearSamples() { Samples.Reset(); }
+
+    /** Get the RTP timestamp of the last packet */
+    uint32 GetLastTimestamp() const { return LastTimestamp; }
+
+    /** Get receive counters */
+    const FStats& GetStats() const { return Stats; }
+
+private:
+    FRship2110AudioFormat Format;
+    bool bValid = false;
+
+    TArray<int32> Samples;
+
+    bool bHavePacket = false;
+    uint16 LastSequenceNumber = 0;
+    uint32 LastTimestamp = 0;
+
+    FStats Stats;
+};
+
+/**
+ * Lock-free ring of interleaved float sample frames.
+ *
+ * Exactly one thread may write (the submix listener) and one may read
+ * (the transmit thread). Frames that do not fit are dropped and counted.
+ */
+class RSHIP2110_API FRship2110AudioRing
+{
+public:
+    /**
+     * Allocate the ring. Not thread-safe; call before either side runs.
+     * @param InNumChannels Channels per frame
+     * @param MinFrames Capacity in frames, rounded up to a power of two
+     */
+    void Configure(int32 InNumChannels, int32 MinFrames);
+
+    /** Drop everything queued. Not thread-safe. */
+    void Reset();
+
+    /**
+     * Append frames (writer thread only).
+     * Channels beyond the ring's are dropped; missing channels are silent.
+     * @param Samples Interleaved frames
+     * @param NumFrames Frames in Samples
+     * @param SourceChannels Channels per frame in Samples
+     * @return Frames written
+     */
+    int32 Write(const float* Samples, int32 NumFrames, int32 SourceChannels);
+
+    /**
+     * Take frames (reader thread only).
+     * @param OutSamples Receives up to NumFrames interleaved frames
+     * @param NumFrames Frames wanted
+     * @return Frames read
+     */
+    int32 Read(float* OutSamples, int32 NumFrames);
+
+    /** Get frames ready to read */
+    int32 GetAvailable() const
+    {
+        return static_cast<int32>(WriteIndex.load(std::memory_order_acquire) - ReadIndex.load(std::memory_order_acquire));
+    }
+
+    /** Get capacity in frames */
+    int32 GetCapacity() const { return Capacity; }
+
+    /** Get channels per frame */
+    int32 GetNumChannels() const { return NumChannels; }
+
+    /** Get frames dropped because the ring was full */
+    int64 GetDroppedFrames() const { return DroppedFrames.load(std::memory_order_relaxed); }
+
+private:
+    TArray<float> Buffer;
+    int32 NumChannels = 0;
+    int32 Capacity = 0;
+
+    std::atomic<uint64> WriteIndex{0};
+    std::atomic<uint64> ReadIndex{0};
+    std::atomic<int64> DroppedFrames{0};
+};
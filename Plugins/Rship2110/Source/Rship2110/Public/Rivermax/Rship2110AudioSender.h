@@ -1,53 +1,69 @@
 // Copyright Rocketship. All Rights Reserved.
-// SMPTE ST 2110-30 Audio Sender (Stub)
+// SMPTE ST 2110-30 Audio Sender
 //
-// Placeholder for future audio streaming implementation.
-// Will support:
-// - PCM audio (2110-30)
-// - AES3 audio (2110-31)
-// - PTP-aligned audio timing
-// - Multi-channel audio (up to 64 channels)
+// Streams PCM audio from an Unreal submix as SMPTE 2110-30 / AES67 RTP.
+// A submix listener feeds a lock-free ring on the audio render thread;
+// a transmit thread drains it one packet time at a time against PTP.
+//
+// Key features:
+// - L16 / L24 PCM, 48 or 96 kHz, 1-64 channels
+// - 1 ms and 125 us packet times (and the other AES67 values)
+// - RTP timestamps from the PTP media clock (IPTPProvider::GetRTPTimestamp)
+// - Continuous timestamps across underruns; gaps are sent as silence
+// - Any submix, including RshipSpatialAudio speaker feeds
 
 #pragma once
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "Rship2110Types.h"
+#include "Rivermax/Rship2110PacketTransmitter.h"
 #include "Rship2110AudioSender.generated.h"
 
+class URshipPTPService;
+class USoundSubmix;
+class FRship2110SubmixListener;
+
 /**
- * Audio format for 2110-30 streams
+ * Audio stream statistics
  */
 USTRUCT(BlueprintType)
-struct RSHIP2110_API FRship2110AudioFormat
+struct RSHIP2110_API FRship2110AudioStreamStats
 {
     GENERATED_BODY()
 
-    /** Sample rate (typically 48000 or 96000) */
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|2110")
-    int32 SampleRate = 48000;
+    /** Packets sent */
+    UPROPERTY(BlueprintReadOnly, Category = "Rship|2110")
+    int64 PacketsSent = 0;
+
+    /** Bytes sent, RTP headers included */
+    UPROPERTY(BlueprintReadOnly, Category = "Rship|2110")
+    int64 BytesSent = 0;
 
-    /** Bits per sample (16, 24, or 32) */
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|2110")
-    int32 BitsPerSample = 24;
+    /** Times the sample buffer ran dry while streaming */
+    UPROPERTY(BlueprintReadOnly, Category = "Rship|2110")
+    int64 Underruns = 0;
 
-    /** Number of channels */
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|2110")
-    int32 NumChannels = 2;
+    /** Sample frames sent as silence (priming and underruns) */
+    UPROPERTY(BlueprintReadOnly, Category = "Rship|2110")
+    int64 SilentFrames = 0;
 
-    /** Packet time in microseconds (125, 250, 333, 1000, 4000) */
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|2110")
-    int32 PacketTimeUs = 1000;
+    /** Sample frames dropped because the buffer was full */
+    UPROPERTY(BlueprintReadOnly, Category = "Rship|2110")
+    int64 OverflowFrames = 0;
+
+    /** Sample frames waiting to be sent */
+    UPROPERTY(BlueprintReadOnly, Category = "Rship|2110")
+    int32 BufferedFrames = 0;
 };
 
 /**
- * SMPTE ST 2110-30 Audio Sender (Stub Implementation).
+ * SMPTE ST 2110-30 Audio Sender.
  *
- * This class is a placeholder for future audio streaming support.
- * When fully implemented, it will handle:
- * - Capturing audio from UE audio engine
- * - Packing into 2110-30 RTP packets
- * - PTP-aligned transmission
+ * Samples come from an attached submix or from SubmitSamples, never both
+ * at once: the buffer has a single writer. The stream runs at the PTP
+ * media clock; the audio device's own clock is not resampled, so over a
+ * long run its drift shows up as occasional underruns or dropped frames.
  */
 UCLASS(BlueprintType)
 class RSHIP2110_API URship2110AudioSender : public UObject
@@ -55,9 +71,176 @@ class RSHIP2110_API URship2110AudioSender : public UObject
     GENERATED_BODY()
 
 public:
-    // TODO: Implement audio sender methods
+    /**
+     * Initialize the audio sender.
+     * @param InPTPService PTP service reference (nullptr = local clock, not traceable to PTP)
+     * @param InAudioFormat Audio format specification
+     * @param InTransportParams Transport parameters
+     * @return true if initialization succeeded
+     */
+    bool Initialize(
+        URshipPTPService* InPTPService,
+        const FRship2110AudioFormat& InAudioFormat,
+        const FRship2110TransportParams& InTransportParams);
+
+    /**
+     * Shutdown and release resources.
+     */
+    void Shutdown();
+
+    // ========================================================================
+    // STREAM CONTROL
+    // ========================================================================
+
+    /**
+     * Start streaming.
+     * @return true if started successfully
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    bool StartStream();
+
+    /**
+     * Stop streaming.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    void StopStream();
+
+    /**
+     * Get current stream state.
+     * @return Stream state
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    ERship2110StreamState GetState() const { return State; }
+
+    /**
+     * Check if currently streaming.
+     * @return true if streaming
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    bool IsStreaming() const { return State == ERship2110StreamState::Running; }
+
+    // ========================================================================
+    // AUDIO SOURCE
+    // ========================================================================
+
+    /**
+     * Send a submix's output. Channels beyond the stream's are dropped and
+     * missing ones are silent; the submix must run at the stream's sample rate.
+     * @param Submix Submix to listen to (nullptr = main submix)
+     * @return true if the listener was registered
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    bool AttachToSubmix(USoundSubmix* Submix = nullptr);
+
+    /**
+     * Stop listening to the attached submix.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    void DetachFromSubmix();
+
+    /**
+     * Queue samples directly. Call from one thread only, and not while a submix is attached.
+     * @param Samples Interleaved float samples in [-1, 1]
+     * @param NumFrames Sample frames in Samples
+     * @param SourceChannels Channels per frame in Samples
+     * @return Frames queued; the rest were dropped because the buffer was full
+     */
+    int32 SubmitSamples(const float* Samples, int32 NumFrames, int32 SourceChannels);
+
+    // ========================================================================
+    // CONFIGURATION
+    // ========================================================================
+
+    /**
+     * Get audio format.
+     * @return Current audio format
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    FRship2110AudioFormat GetAudioFormat() const { return AudioFormat; }
+
+    /**
+     * Get transport parameters.
+     * @return Current transport parameters
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    FRship2110TransportParams GetTransportParams() const { return TransportParams; }
+
+    /**
+     * Get stream ID.
+     * @return Unique stream identifier
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    FString GetStreamId() const { return StreamId; }
+
+    /**
+     * Set stream ID (called by subsystem).
+     */
+    void SetStreamId(const FString& InStreamId) { StreamId = InStreamId; }
+
+    // ========================================================================
+    // STATISTICS
+    // ========================================================================
+
+    /**
+     * Get stream statistics.
+     * @return Current statistics
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    FRship2110AudioStreamStats GetStatistics() const;
+
+    /**
+     * Get the stream's bitrate, RTP headers included.
+     * @return Bitrate in Mbps
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    double GetBitrateMbps() const;
 
-    /** Check if audio sending is supported (stub returns false) */
+    // ========================================================================
+    // SDP
+    // ========================================================================
+
+    /**
+     * Generate SDP (Session Description Protocol) for this stream.
+     * @return SDP string
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110")
+    FString GenerateSDP() const;
+
+    /**
+     * Check if audio sending is supported.
+     * Always true; without a PTP provider the stream runs on the local clock.
+     */
     UFUNCTION(BlueprintCallable, Category = "Rship|2110")
-    static bool IsSupported() { return false; }
+    static bool IsSupported() { return true; }
+
+    // ========================================================================
+    // EVENTS
+    // ========================================================================
+
+    /** Fired when stream state changes */
+    UPROPERTY(BlueprintAssignable, Category = "Rship|2110")
+    FOn2110StreamStateChanged OnStateChanged;
+
+private:
+    // References
+    UPROPERTY()
+    URshipPTPService* PTPService = nullptr;
+
+    UPROPERTY()
+    USoundSubmix* AttachedSubmix = nullptr;
+
+    // Configuration
+    FRship2110AudioFormat AudioFormat;
+    FRship2110TransportParams TransportParams;
+    FString StreamId;
+
+    // State
+    ERship2110StreamState State = ERship2110StreamState::Stopped;
+
+    // Packetizes and sends on its own thread; the submix listener writes its ring
+    TUniquePtr<FRship2110AudioTransmitThread> TransmitThread;
+    TUniquePtr<IRship2110PacingClock> PacingClock;  // Media clock while running
+    TSharedPtr<FRship2110SubmixListener, ESPMode::ThreadSafe> SubmixListener;
+
+    void SetState(ERship2110StreamState NewState);
 };
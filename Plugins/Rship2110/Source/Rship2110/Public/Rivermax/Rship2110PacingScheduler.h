@@ -0,0 +1,284 @@
+// Copyright Rocketship. All Rights Reserved.
+// ST 2110-21 Traffic Shaping for 2110-20 Video
+//
+// Plans when each packet of a frame leaves the sender so the stream fits
+// the ST 2110-21 timing models, and checks a schedule against them.
+//
+// Key features:
+// - TRS / TRoffset for narrow gapped, narrow linear and wide senders
+// - Frames anchored to PTP frame boundaries (IPTPProvider::GetNextFrameBoundary)
+// - Clock interface with a virtual clock for deterministic tests
+// - CMAX (network compatibility) and VRX (virtual receiver buffer) checker
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Rship2110Types.h"
+
+class IPTPProvider;
+
+/**
+ * Time source for pacing, in PTP (TAI) nanoseconds.
+ */
+class RSHIP2110_API IRship2110PacingClock
+{
+public:
+    virtual ~IRship2110PacingClock() = default;
+
+    /**
+     * Get the current time.
+     * @return PTP time in nanoseconds
+     */
+    virtual uint64 GetTimeNs() const = 0;
+
+    /**
+     * Get the first frame boundary after a time.
+     * @param FrameDurationNs Frame duration in nanoseconds
+     * @param AfterNs Time to search from
+     * @return PTP time of the boundary in nanoseconds
+     */
+    virtual uint64 GetNextFrameBoundaryNs(uint64 FrameDurationNs, uint64 AfterNs) const = 0;
+
+    /**
+     * Get the RTP media clock at a time, counted from the PTP epoch.
+     * @param TimeNs PTP time in nanoseconds
+     * @param ClockRate Media clock rate in Hz
+     * @return RTP timestamp (wraps at 32 bits)
+     */
+    virtual uint32 GetRTPTimestamp(uint64 TimeNs, uint32 ClockRate) const
+    {
+        const uint64 Seconds = TimeNs / 1000000000ULL;
+        const uint64 Nanos = TimeNs % 1000000000ULL;
+        return static_cast<uint32>(Seconds * ClockRate + Nanos * ClockRate / 1000000000ULL);
+    }
+};
+
+/**
+ * Pacing clock backed by a PTP provider.
+ * The provider must outlive the clock.
+ */
+class RSHIP2110_API FRship2110ProviderPacingClock : public IRship2110PacingClock
+{
+public:
+    explicit FRship2110ProviderPacingClock(const IPTPProvider& InProvider)
+        : Provider(InProvider)
+    {
+    }
+
+    virtual uint64 GetTimeNs() const override;
+    virtual uint64 GetNextFrameBoundaryNs(uint64 FrameDurationNs, uint64 AfterNs) const override;
+    virtual uint32 GetRTPTimestamp(uint64 TimeNs, uint32 ClockRate) const override;
+
+private:
+    const IPTPProvider& Provider;
+};
+
+/**
+ * Pacing clock that follows the local monotonic clock.
+ * For streams with no PTP provider; times are not traceable to PTP.
+ */
+class RSHIP2110_API FRship2110LocalPacingClock : public IRship2110PacingClock
+{
+public:
+    virtual uint64 GetTimeNs() const override;
+
+    virtual uint64 GetNextFrameBoundaryNs(uint64 FrameDurationNs, uint64 AfterNs) const override
+    {
+        return (AfterNs / FrameDurationNs + 1) * FrameDurationNs;
+    }
+};
+
+/**
+ * Pacing clock that only moves when told to.
+ * Boundaries are aligned to the epoch, like the PTP providers'.
+ */
+class RSHIP2110_API FRship2110VirtualPacingClock : public IRship2110PacingClock
+{
+public:
+    explicit FRship2110VirtualPacingClock(uint64 InTimeNs = 0)
+        : TimeNs(InTimeNs)
+    {
+    }
+
+    void SetTimeNs(uint64 InTimeNs) { TimeNs = InTimeNs; }
+    void AdvanceNs(uint64 DeltaNs) { TimeNs += DeltaNs; }
+
+    virtual uint64 GetTimeNs() const override { return TimeNs; }
+
+    virtual uint64 GetNextFrameBoundaryNs(uint64 FrameDurationNs, uint64 AfterNs) const override
+    {
+        return (AfterNs / FrameDurationNs + 1) * FrameDurationNs;
+    }
+
+private:
+    uint64 TimeNs;
+};
+
+/**
+ * ST 2110-21 packet schedule for one video format.
+ *
+ * Packet j of a frame starting at T leaves at T + TRoffset + j * TRS.
+ * Gapped and wide senders spread the frame over the active lines
+ * (TRS = Tframe * RACTIVE / Npackets) and start after the vertical blanking
+ * interval (TRoffset = TROdefault). Linear senders spread it over the whole
+ * frame from the boundary. Wide senders release packets in bursts of
+ * GetBurstPackets(), each at the time of its first packet.
+ *
+ * Frames are timed as progressive, matching the packetizer.
+ */
+class RSHIP2110_API FRship2110PacingScheduler
+{
+public:
+    /** Network compatibility model drain rate over the average packet rate */
+    static constexpr double Beta = 1.1;
+
+    /**
+     * Compute timing for a format.
+     * @param Format Video format; SenderType selects the model
+     * @param InPacketsPerFrame Packets the packetizer emits per frame
+     * @return false if the frame rate or packet count is invalid
+     */
+    bool Configure(const FRship2110VideoFormat& Format, int32 InPacketsPerFrame);
+
+    /** Clear timing and the frame anchor */
+    void Reset();
+
+    /** Check whether Configure succeeded */
+    bool IsValid() const { return PacketsPerFrame > 0; }
+
+    /**
+     * Pick the start of the next frame: the first PTP frame boundary after
+     * now and after the previous frame's start.
+     * @param Clock Time source
+     * @return Frame start in PTP nanoseconds
+     */
+    uint64 GetNextFrameStartNs(const IRship2110PacingClock& Clock);
+
+    /**
+     * Get one packet's launch time.
+     * @param FrameStartNs Frame start from GetNextFrameStartNs
+     * @param PacketIndex Packet index within the frame
+     * @return Launch time in PTP nanoseconds
+     */
+    uint64 GetLaunchTimeNs(uint64 FrameStartNs, int32 PacketIndex) const;
+
+    /**
+     * Fill launch times for a whole frame.
+     * @param FrameStartNs Frame start from GetNextFrameStartNs
+     * @param OutLaunchTimesNs Receives GetPacketsPerFrame() times
+     */
+    void ComputeLaunchTimes(uint64 FrameStartNs, TArray<uint64>& OutLaunchTimesNs) const;
+
+    ERship2110SenderType GetSenderType() const { return SenderType; }
+    int32 GetPacketsPerFrame() const { return PacketsPerFrame; }
+
+    /** Get the exact frame period in nanoseconds */
+    double GetFrameDurationNs() const { return FrameDurationNs; }
+
+    /** Get the frame duration used to find PTP frame boundaries */
+    uint64 GetBoundaryDurationNs() const { return BoundaryDurationNs; }
+
+    /** Get the active fraction of the frame period */
+    double GetRActive() const { return RActive; }
+
+    /** Get the spacing between packets in nanoseconds */
+    double GetTRSNs() const { return TRSNs; }
+
+    /** Get the first packet's offset from the frame boundary in nanoseconds */
+    double GetTROffsetNs() const { return TROffsetNs; }
+
+    /** Get the network compatibility model drain period in nanoseconds */
+    double GetTDrainNs() const { return TDrainNs; }
+
+    /** Get the network compatibility bucket size the sender must stay within */
+    int32 GetCMax() const { return CMax; }
+
+    /** Get the virtual receiver buffer size the sender must stay within */
+    int32 GetVRXFull() const { return VRXFull; }
+
+    /** Get the largest run of packets released together (1 for narrow senders) */
+    int32 GetBurstPackets() const { return BurstPackets; }
+
+private:
+    ERship2110SenderType SenderType = ERship2110SenderType::NarrowGapped;
+    int32 PacketsPerFrame = 0;
+    double FrameDurationNs = 0.0;
+    uint64 BoundaryDurationNs = 0;
+    double RActive = 1.0;
+    double TRSNs = 0.0;
+    double TROffsetNs = 0.0;
+    double TDrainNs = 0.0;
+    int32 CMax = 0;
+    int32 VRXFull = 0;
+    int32 BurstPackets = 1;
+
+    uint64 LastFrameStartNs = 0;
+};
+
+/**
+ * Result of checking a schedule against the ST 2110-21 models.
+ */
+struct FRship2110PacingReport
+{
+    int64 FramesChecked = 0;
+    int64 PacketsChecked = 0;
+
+    /** Largest network compatibility bucket occupancy seen, against CMax */
+    int32 CInstMax = 0;
+    int32 CMax = 0;
+
+    /** Largest virtual receiver buffer occupancy seen, against VRXFull */
+    int32 VRXMax = 0;
+    int32 VRXFull = 0;
+
+    /** Packets that reached the virtual receiver after it needed them */
+    int64 LatePackets = 0;
+
+    bool IsCompliant() const
+    {
+        return CInstMax <= CMax && VRXMax <= VRXFull && LatePackets == 0;
+    }
+};
+
+/**
+ * Measures a packet schedule (planned launch times or captured arrival
+ * times) against the ST 2110-21 network compatibility and virtual receiver
+ * buffer models.
+ *
+ * The network compatibility bucket drains one packet every TDRAIN and
+ * carries over between frames. The virtual receiver reads packet j of each
+ * frame at T + TRoffset + j * TRS; a packet arriving after its read time is
+ * late, and packets held before it is read count against VRXFull.
+ */
+class RSHIP2110_API FRship2110PacingChecker
+{
+public:
+    /**
+     * Take the models' parameters from a configured scheduler and clear the report.
+     * @param Scheduler Scheduler for the stream being checked
+     */
+    void Configure(const FRship2110PacingScheduler& Scheduler);
+
+    /** Clear the report and the bucket */
+    void Reset();
+
+    /**
+     * Check one frame's packets.
+     * @param FrameStartNs Frame boundary the packets belong to
+     * @param PacketTimesNs Packet times in order
+     */
+    void AddFrame(uint64 FrameStartNs, TConstArrayView<uint64> PacketTimesNs);
+
+    /** Get results so far */
+    const FRship2110PacingReport& GetReport() const { return Report; }
+
+private:
+    double TRSNs = 0.0;
+    double TROffsetNs = 0.0;
+    double TDrainNs = 0.0;
+
+    /** Time the bucket's last queued packet finishes draining */
+    double BucketDrainedNs = 0.0;
+
+    FRship2110PacingReport Report;
+};
@@ -0,0 +1,420 @@
+// Copyright Rocketship. All Rights Reserved.
+// Software UDP Transmit Path for 2110 Streams
+//
+// Sends packetized 2110 streams through the OS network stack when
+// Rivermax is not carrying them.
+//
+// Key features:
+// - Platform transmitters behind one interface (like IPTPProvider)
+// - Linux: batched sendmmsg, UDP_SEGMENT offload, SO_TXTIME launch times
+// - Portable FSocket fallback, one SendTo per packet
+// - Dedicated transmit thread, optionally pinned to a core
+// - ST 2110-21 pacing via kernel launch times or a timed software loop
+// - ST 2110-30 audio thread sending one packet per packet time
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Rship2110Types.h"
+#include "Rivermax/Rship2110VideoPacketizer.h"
+#include "Rivermax/Rship2110PacingScheduler.h"
+#include "Rivermax/Rship2110AudioPacketizer.h"
+#include "Capture/Rship2110FramePool.h"
+#include <atomic>
+
+class FRunnableThread;
+class FEvent;
+
+/**
+ * Features a transmitter tries to enable when it opens.
+ */
+struct FRship2110TransmitOptions
+{
+    /** Coalesce equal-size packets into UDP_SEGMENT sends */
+    bool bSegmentationOffload = true;
+
+    /** Honour per-packet launch times (SO_TXTIME, CLOCK_TAI; needs an ETF qdisc) */
+    bool bLaunchTime = false;
+
+    /** Requested socket send buffer */
+    int32 SendBufferBytes = 8 * 1024 * 1024;
+};
+
+/**
+ * Features a transmitter actually enabled.
+ */
+struct FRship2110TransmitCapabilities
+{
+    /** Many packets per system call */
+    bool bBatching = false;
+
+    /** Kernel splits coalesced sends into packets */
+    bool bSegmentationOffload = false;
+
+    /** Kernel holds packets until their launch time */
+    bool bLaunchTime = false;
+};
+
+/**
+ * Transmit counters.
+ */
+struct FRship2110TransmitStats
+{
+    int64 PacketsSent = 0;
+    int64 BytesSent = 0;
+    int64 PacketsFailed = 0;
+    int64 SystemCalls = 0;
+};
+
+/**
+ * Sends RTP packets to one destination.
+ * Implementations are used from a single thread at a time.
+ */
+class RSHIP2110_API IRship2110PacketTransmitter
+{
+public:
+    virtual ~IRship2110PacketTransmitter() = default;
+
+    /**
+     * Open a socket to the stream's destination.
+     * @param Params Source/destination addresses, DSCP and TTL
+     * @param Options Features to try to enable
+     * @return true if the socket is ready to send
+     */
+    virtual bool Open(const FRship2110TransportParams& Params, const FRship2110TransmitOptions& Options) = 0;
+
+    /**
+     * Close the socket.
+     */
+    virtual void Close() = 0;
+
+    /**
+     * Check whether the transmitter is open.
+     * @return true if Open succeeded and Close has not been called
+     */
+    virtual bool IsOpen() const = 0;
+
+    /**
+     * Send packets in order, blocking until the kernel has taken them.
+     * @param Packets Packets to send
+     * @param LaunchTimesNs Per-packet launch times in CLOCK_TAI nanoseconds, or empty to send now.
+     *                      Ignored unless GetCapabilities().bLaunchTime.
+     * @return Number of packets handed to the kernel
+     */
+    virtual int32 SendPackets(TConstArrayView<FRship2110Packet> Packets, TConstArrayView<uint64> LaunchTimesNs = {}) = 0;
+
+    /**
+     * Get the features enabled by Open.
+     * @return Enabled features
+     */
+    virtual FRship2110TransmitCapabilities GetCapabilities() const = 0;
+
+    /**
+     * Read the clock that launch times are measured against. Safe to call
+     * from any thread.
+     * @param OutNs Receives the current CLOCK_TAI time in nanoseconds
+     * @return false if the transmitter has no launch clock
+     */
+    virtual bool GetLaunchClockNs(uint64& OutNs) const { return false; }
+
+    /**
+     * Get transmit counters.
+     * @return Counters since Open
+     */
+    virtual FRship2110TransmitStats GetStats() const = 0;
+
+    /**
+     * Get transmitter name for logging.
+     * @return Implementation name
+     */
+    virtual FString GetName() const = 0;
+};
+
+/**
+ * Factory for creating platform-appropriate transmitters.
+ */
+class RSHIP2110_API FRship2110TransmitterFactory
+{
+public:
+    /**
+     * Create the fastest transmitter for the current platform.
+     * @return Unique pointer to transmitter (caller owns)
+     */
+    static TUniquePtr<IRship2110PacketTransmitter> Create();
+
+    /**
+     * Create the portable FSocket transmitter.
+     * @return Unique pointer to transmitter (caller owns)
+     */
+    static TUniquePtr<IRship2110PacketTransmitter> CreateFallback();
+
+    /**
+     * Create and open a transmitter, falling back to FSocket if the platform one fails.
+     * @param Params Transport parameters
+     * @param Options Features to try to enable
+     * @return Open transmitter, or nullptr if no socket could be opened
+     */
+    static TUniquePtr<IRship2110PacketTransmitter> CreateOpen(const FRship2110TransportParams& Params,
+                                                              const FRship2110TransmitOptions& Options);
+};
+
+/**
+ * Transmit thread for one video stream.
+ *
+ * Frames are copied into a small ring of slots so the caller's buffer is
+ * free on return, or queued by reference when they come from a frame
+ * pool; the thread packetizes each frame and hands the packets to its
+ * transmitter. A frame arriving with every slot busy is dropped.
+ *
+ * With a pacing clock set, each frame is anchored to the next PTP frame
+ * boundary and its packets follow the ST 2110-21 schedule for the format's
+ * SenderType. Transmitters with launch-time support get the schedule,
+ * moved from PTP time onto their launch clock by the offset between the
+ * two when the frame is queued; otherwise the thread waits out each
+ * packet's time itself and sends whatever is due in one call, at most
+ * half the CMAX bucket.
+ */
+class RSHIP2110_API FRship2110TransmitThread : public FRunnable
+{
+public:
+    explicit FRship2110TransmitThread(TUniquePtr<IRship2110PacketTransmitter> InTransmitter);
+    virtual ~FRship2110TransmitThread();
+
+    /**
+     * Plan packets for a format and allocate frame slots. Call while stopped.
+     * @param Format Video format of the frames
+     * @param PayloadType RTP payload type
+     * @param SSRC RTP synchronization source
+     * @param NumSlots Frames that may be queued at once
+     * @return false if the format cannot be packetized
+     */
+    bool Configure(const FRship2110VideoFormat& Format, uint8 PayloadType, uint32 SSRC, int32 NumSlots = 3);
+
+    /**
+     * Start the thread.
+     * @param FirstSequenceNumber Extended sequence number of the first packet
+     * @param CpuCore Core to pin the thread to (-1 = no affinity)
+     * @return true if the thread is running
+     */
+    bool Start(uint32 FirstSequenceNumber, int32 CpuCore = -1);
+
+    /** Stop the thread, dropping queued frames, and wait for it to exit */
+    void Shutdown();
+
+    /** Check whether the thread is running */
+    bool IsRunning() const { return Thread != nullptr; }
+
+    /**
+     * Pace frames against a clock. Call while stopped. The clock is only
+     * read from the thread calling Enqueue and must outlive its use.
+     * @param InClock PTP clock, or nullptr to send each frame as fast as possible
+     */
+    void SetPacingClock(const IRship2110PacingClock* InClock);
+
+    /**
+     * Queue a packed frame.
+     * @param FrameData Packed frame
+     * @param Size Bytes in the frame; must match the configured format
+     * @param RTPTimestamp 90 kHz timestamp for the frame
+     * @return false if the frame was dropped
+     */
+    bool Enqueue(const uint8* FrameData, int64 Size, uint32 RTPTimestamp);
+
+    /**
+     * Queue a pooled frame without copying it. The thread holds a reference
+     * until the frame's packets are sent, then releases it.
+     * @param Frame Packed frame; its size must match the configured format
+     * @param RTPTimestamp 90 kHz timestamp for the frame
+     * @return false if the frame was dropped
+     */
+    bool Enqueue(FRship2110FrameRef Frame, uint32 RTPTimestamp);
+
+    /**
+     * Wait until every queued frame has been sent.
+     * @param TimeoutSeconds Give up after this long
+     * @return true if the queue drained
+     */
+    bool WaitUntilIdle(double TimeoutSeconds);
+
+    /** Get the packet plan (fixed after Configure) */
+    const FRship2110VideoPacketizer& GetPacketizer() const { return Packetizer; }
+
+    /** Get the ST 2110-21 timing (fixed after Configure) */
+    const FRship2110PacingScheduler& GetPacing() const { return Pacing; }
+
+    /** Get the transmitter */
+    IRship2110PacketTransmitter* GetTransmitter() const { return Transmitter.Get(); }
+
+    /** Get frames sent by the thread */
+    int64 GetFramesSent() const { return FramesSent.load(std::memory_order_relaxed); }
+
+    /** Get frames dropped because every slot was busy */
+    int64 GetFramesDropped() const { return FramesDropped.load(std::memory_order_relaxed); }
+
+    // FRunnable interface
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    struct FSlot
+    {
+        /** Copied frame; allocated on the first copy into the slot */
+        TArray<uint8> Data;
+
+        /** Frame queued by reference; used instead of Data when valid */
+        FRship2110FrameRef Frame;
+
+        uint32 RTPTimestamp = 0;
+
+        /** PTP frame boundary to pace against, or 0 to send at once */
+        uint64 FrameStartNs = 0;
+
+        /** Pacing clock minus the local monotonic clock when queued */
+        int64 ClockToLocalNs = 0;
+
+        /** Transmitter launch clock minus the pacing clock when queued */
+        int64 ClockToLaunchNs = 0;
+
+        /** Whether ClockToLaunchNs was read; if not, the frame is paced locally */
+        bool bHasLaunchClock = false;
+    };
+
+    /** Take a free slot, or count a drop */
+    int32 AcquireSlot();
+
+    /** Stamp a filled slot with its timing and hand it to the thread */
+    void QueueSlot(int32 SlotIndex, uint32 RTPTimestamp);
+
+    /** Send packets at their launch times by waiting on the local clock */
+    void SendPaced(TConstArrayView<FRship2110Packet> Packets, int64 ClockToLocalNs);
+
+    TUniquePtr<IRship2110PacketTransmitter> Transmitter;
+    FRship2110VideoPacketizer Packetizer;
+    FRship2110PacingScheduler Pacing;
+    const IRship2110PacingClock* PacingClock = nullptr;
+    TArray<uint64> LaunchTimes;
+
+    TArray<FSlot> Slots;
+    TArray<int32> FreeSlots;
+    TArray<int32> ReadySlots;
+    int32 SendingSlot = INDEX_NONE;
+    mutable FCriticalSection SlotLock;
+
+    std::atomic<int64> FramesSent{0};
+    std::atomic<int64> FramesDropped{0};
+
+    FThreadSafeBool bShouldStop;
+    FRunnableThread* Thread = nullptr;
+    FEvent* WakeEvent = nullptr;
+};
+
+/**
+ * Transmit thread for one audio stream.
+ *
+ * Samples arrive through GetRing() from the audio renderer. Packet n of
+ * the stream is due at Start + n * packet time, with Start the first
+ * packet-time boundary after Start() on the pacing clock, and carries
+ * RTP timestamp Clock.GetRTPTimestamp(Start) + n * samples per packet.
+ * Timestamps therefore never skip: when the ring runs dry the packet is
+ * completed with silence and the thread waits for the preroll to build
+ * up again before taking samples, so a late producer costs a gap in the
+ * sound, not in the media clock.
+ *
+ * The clock is read from the transmit thread to follow the local clock's
+ * drift against PTP. A step of more than ResyncThresholdNs re-anchors the
+ * stream at the next boundary.
+ */
+class RSHIP2110_API FRship2110AudioTransmitThread : public FRunnable
+{
+public:
+    /** Clock offset re-measured this often */
+    static constexpr int64 ClockResyncIntervalNs = 1000000000;
+
+    /** Schedule error that re-anchors the stream */
+    static constexpr int64 ResyncThresholdNs = 100000000;
+
+    explicit FRship2110AudioTransmitThread(TUniquePtr<IRship2110PacketTransmitter> InTransmitter);
+    virtual ~FRship2110AudioTransmitThread();
+
+    /**
+     * Set up packetization and the sample ring. Call while stopped.
+     * @param Format Audio format
+     * @param PayloadType RTP payload type
+     * @param SSRC RTP synchronization source
+     * @param PrerollFrames Frames buffered before sending starts, and after each underrun
+     * @return false if the format is not valid
+     */
+    bool Configure(const FRship2110AudioFormat& Format, uint8 PayloadType, uint32 SSRC, int32 PrerollFrames);
+
+    /**
+     * Start the thread.
+     * @param InClock PTP clock; must be safe to read from the transmit thread and outlive it
+     * @param FirstSequenceNumber Sequence number of the first packet
+     * @param CpuCore Core to pin the thread to (-1 = no affinity)
+     * @return true if the thread is running
+     */
+    bool Start(const IRship2110PacingClock& InClock, uint16 FirstSequenceNumber, int32 CpuCore = -1);
+
+    /** Stop the thread, dropping queued samples, and wait for it to exit */
+    void Shutdown();
+
+    /** Check whether the thread is running */
+    bool IsRunning() const { return Thread != nullptr; }
+
+    /** Get the ring to write samples into (one writer thread only) */
+    FRship2110AudioRing& GetRing() { return Ring; }
+
+    /** Get the packetizer (fixed after Configure) */
+    const FRship2110AudioPacketizer& GetPacketizer() const { return Packetizer; }
+
+    /** Get the transmitter */
+    IRship2110PacketTransmitter* GetTransmitter() const { return Transmitter.Get(); }
+
+    /** Get packets sent by the thread */
+    int64 GetPacketsSent() const { return PacketsSent.load(std::memory_order_relaxed); }
+
+    /** Get times the ring ran dry while sending */
+    int64 GetUnderruns() const { return Underruns.load(std::memory_order_relaxed); }
+
+    /** Get frames sent as silence, while priming or after an underrun */
+    int64 GetSilentFrames() const { return SilentFrames.load(std::memory_order_relaxed); }
+
+    // FRunnable interface
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    /** Pick the next packet-time boundary and the timestamp that goes with it */
+    void Anchor(uint64 AfterNs);
+
+    /** Get the clock time packet n of the current timeline is due */
+    uint64 GetPacketDueNs(uint64 Packet) const;
+
+    /** Take one packet of samples from the ring, padding with silence */
+    void FillPacket(float* OutSamples);
+
+    TUniquePtr<IRship2110PacketTransmitter> Transmitter;
+    FRship2110AudioPacketizer Packetizer;
+    FRship2110AudioRing Ring;
+    int32 PrerollFrames = 0;
+
+    const IRship2110PacingClock* Clock = nullptr;
+    int64 ClockToLocalNs = 0;
+    uint64 PacketTimeNs = 0;
+    uint64 StartNs = 0;
+    uint64 NextPacket = 0;
+    uint32 NextTimestamp = 0;
+    bool bPriming = true;
+
+    TArray<float> Samples;
+    TArray<FRship2110Packet> Batch;
+
+    std::atomic<int64> PacketsSent{0};
+    std::atomic<int64> Underruns{0};
+    std::atomic<int64> SilentFrames{0};
+
+    FThreadSafeBool bShouldStop;
+    FRunnableThread* Thread = nullptr;
+};
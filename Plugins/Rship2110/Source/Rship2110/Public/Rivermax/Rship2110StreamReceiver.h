@@ -0,0 +1,357 @@
+// Copyright Rocketship. All Rights Reserved.
+// ST 2110 Stream Receiver and Validator
+//
+// Listens to a 2110-20, -30 or -40 stream and checks it the way a strict
+// receiver would, for loopback tests and for checking a sender on the wire.
+//
+// Key features:
+// - RTP header checks: version, payload type, SSRC
+// - Sequence continuity with RFC 3550 loss accounting (reordering is not loss)
+// - Marker placement and RTP timestamp cadence per frame or packet time
+// - ST 2110-21 CMAX / VRX check of captured arrival times (video)
+// - Frames, samples and ANC packets reassembled for bit-exact comparison
+// - UDP receive thread, unicast or multicast
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Rship2110Types.h"
+#include "Rivermax/Rship2110VideoPacketizer.h"
+#include "Rivermax/Rship2110AudioPacketizer.h"
+#include "Rivermax/Rship2110AncPacketizer.h"
+#include "Rivermax/Rship2110PacingScheduler.h"
+
+class FSocket;
+class FRunnableThread;
+
+/**
+ * What a receiver expects on the wire.
+ */
+struct RSHIP2110_API FRship2110ReceiverConfig
+{
+    /** Essence carried: Video_2110_20, Audio_2110_30 or Ancillary_2110_40 */
+    ERship2110StreamType StreamType = ERship2110StreamType::Video_2110_20;
+
+    /** Video format (2110-20), or the frame rate ANC frames follow (2110-40) */
+    FRship2110VideoFormat VideoFormat;
+
+    /** Audio format (2110-30) */
+    FRship2110AudioFormat AudioFormat;
+
+    /** Expected RTP payload type, or -1 to accept the first one seen */
+    int32 PayloadType = -1;
+
+    /** Check video arrival times against the ST 2110-21 models */
+    bool bCheckPacing = true;
+
+    /** Keep the last frame, received samples and last ANC packets for comparison */
+    bool bKeepMedia = true;
+};
+
+/**
+ * Everything a receiver found wrong with a stream, and how much it saw.
+ */
+struct RSHIP2110_API FRship2110ValidationReport
+{
+    int64 PacketsReceived = 0;
+
+    /** Packets expected from the sequence numbers but never received (RFC 3550) */
+    int64 PacketsLost = 0;
+
+    /** Packets arriving behind one with a later sequence number, or duplicated */
+    int64 PacketsOutOfOrder = 0;
+
+    /** Packets the RTP header or the depacketizer could not parse */
+    int64 PacketsMalformed = 0;
+
+    /** Packets with the wrong payload type, or an SSRC change */
+    int64 HeaderErrors = 0;
+
+    /** Frames closed by a marker (video and ANC) */
+    int64 FramesReceived = 0;
+
+    /** Frames closed with data missing, or never closed */
+    int64 FramesIncomplete = 0;
+
+    /** Frames that ended without a marker, or packets after the marker, with no loss to explain it */
+    int64 MarkerErrors = 0;
+
+    /** Timestamps off the frame or packet-time cadence */
+    int64 TimestampErrors = 0;
+
+    /** Whole frame periods skipped between consecutive frames */
+    int64 TimestampGaps = 0;
+
+    /** ANC packets failing parity or checksum */
+    int64 PayloadErrors = 0;
+
+    /** ST 2110-21 result over complete, loss-free video frames */
+    FRship2110PacingReport Pacing;
+
+    /** Check for integrity errors; pacing is reported separately in Pacing */
+    bool HasErrors() const
+    {
+        return PacketsLost > 0 || PacketsOutOfOrder > 0 || PacketsMalformed > 0 || HeaderErrors > 0 ||
+               FramesIncomplete > 0 || MarkerErrors > 0 || TimestampErrors > 0 || TimestampGaps > 0 ||
+               PayloadErrors > 0;
+    }
+
+    /** Format the counters on one line for logs */
+    FString ToString() const;
+};
+
+/**
+ * Where two frames differ, in pgroups.
+ */
+struct RSHIP2110_API FRship2110FrameComparison
+{
+    /** Pgroups whose bytes differ */
+    int64 MismatchedPGroups = 0;
+
+    /** Row and first pixel of the first difference, or -1 */
+    int32 FirstRow = -1;
+    int32 FirstPixel = -1;
+
+    bool IsIdentical() const { return MismatchedPGroups == 0; }
+};
+
+/**
+ * Checks one RTP stream packet by packet.
+ *
+ * Sequence continuity uses the 16-bit RTP sequence number, extended across
+ * wraps; loss is packets expected minus packets received, so a reordered
+ * packet counts as out of order but not lost. Video and ANC frames are
+ * grouped by RTP timestamp: a frame must end in exactly one marker, and
+ * consecutive frames must be a whole number of frame periods apart
+ * (90 kHz x den / num, +-1 tick for the 1001 rates). Audio packets must
+ * advance the timestamp by the samples per packet times the sequence step.
+ *
+ * Pacing has no shared clock to go on, so each frame is anchored at the
+ * latest start that still has every packet arrive by its VRX read time:
+ * max over j of (arrival j - TRoffset - j * TRS). LatePackets is zero by
+ * construction; a bursty or uneven sender shows up in VRXMax and CInstMax.
+ * The packet count per frame is taken from the first complete frame.
+ *
+ * Not thread-safe; FRship2110StreamReceiver serializes access.
+ */
+class RSHIP2110_API FRship2110StreamValidator
+{
+public:
+    /**
+     * Set what the stream should carry and clear the report.
+     * @param InConfig Expected stream
+     * @return false if the stream type is unsupported or its format is invalid
+     */
+    bool Configure(const FRship2110ReceiverConfig& InConfig);
+
+    /** Clear the report, media and stream state, keeping the configuration */
+    void Reset();
+
+    /**
+     * Check one RTP packet.
+     * @param Data UDP payload
+     * @param Size Bytes in the payload
+     * @param ArrivalNs Receive time in nanoseconds on any monotonic clock
+     * @return true if the packet closed a frame (marker bit on video or ANC)
+     */
+    bool ReceivePacket(const uint8* Data, int32 Size, uint64 ArrivalNs);
+
+    /** Get results so far */
+    const FRship2110ValidationReport& GetReport() const { return Report; }
+
+    /** Get the configuration */
+    const FRship2110ReceiverConfig& GetConfig() const { return Config; }
+
+    /** Get the last complete video frame, packed; empty until one arrives */
+    const TArray<uint8>& GetLastFrame() const { return LastFrame; }
+
+    /** Get the RTP timestamp of the last complete video frame */
+    uint32 GetLastFrameTimestamp() const { return LastFrameTimestamp; }
+
+    /** Get received audio samples, interleaved signed PCM (at most ~10 s kept) */
+    const TArray<int32>& GetSamples() const { return Samples; }
+
+    /** Move received audio samples out */
+    void TakeSamples(TArray<int32>& OutSamples);
+
+    /** Get the ANC packets of the last frame closed by a marker */
+    const TArray<FRship2110AncPacket>& GetLastAncPackets() const { return LastAncPackets; }
+
+    /**
+     * Compare two packed frames pgroup by pgroup.
+     * @param Format Video format of both frames
+     * @param Expected Frame that was sent
+     * @param Received Frame that was reassembled
+     * @return Differences; every pgroup mismatches if the sizes differ
+     */
+    static FRship2110FrameComparison CompareFrames(const FRship2110VideoFormat& Format,
+                                                   TConstArrayView<uint8> Expected,
+                                                   TConstArrayView<uint8> Received);
+
+private:
+    /** Track sequence numbers; returns packets skipped ahead, or -1 if out of order */
+    int32 UpdateSequence(uint16 SequenceNumber);
+
+    /** Group a video or ANC packet into its frame and check marker and cadence; true if it closed the frame */
+    bool TrackFrame(uint32 Timestamp, bool bMarker, int32 Skipped, uint64 ArrivalNs, bool bDataComplete);
+
+    /** Close the open frame on its marker */
+    void CloseFrame(bool bComplete);
+
+    /** Check the open video frame's arrival times against ST 2110-21 */
+    void CheckPacing();
+
+    /** Check an audio packet's timestamp against the previous one */
+    void TrackAudio(uint32 Timestamp, int32 Skipped);
+
+    FRship2110ReceiverConfig Config;
+    bool bValid = false;
+
+    FRship2110VideoDepacketizer VideoDepacketizer;
+    FRship2110AudioDepacketizer AudioDepacketizer;
+    FRship2110AncDepacketizer AncDepacketizer;
+
+    // RTP header state
+    bool bHaveHeader = false;
+    uint8 PayloadType = 0;
+    uint32 SSRC = 0;
+
+    // RFC 3550 sequence state
+    uint32 BaseSequence = 0;
+    int64 SequenceCycles = 0;
+    uint16 MaxSequence = 0;
+    int64 PacketsInSequence = 0;
+
+    // Frame grouping (video and ANC)
+    double TicksPerFrame = 0.0;
+    bool bFrameOpen = false;
+    bool bFrameClosed = false;
+    bool bFrameHadLoss = false;
+    uint32 FrameTimestamp = 0;
+    TArray<uint64> FrameArrivals;
+
+    // Audio cadence
+    bool bHaveAudioTimestamp = false;
+    uint32 LastAudioTimestamp = 0;
+    int32 MaxSamples = 0;
+
+    // ST 2110-21 check
+    FRship2110PacingScheduler Pacing;
+    FRship2110PacingChecker PacingChecker;
+
+    // Depacketizer counters already folded into the report
+    int64 DepacketizerMalformed = 0;
+    int64 AncPayloadErrors = 0;
+
+    TArray<uint8> LastFrame;
+    uint32 LastFrameTimestamp = 0;
+    TArray<int32> Samples;
+    TArray<FRship2110AncPacket> LastAncPackets;
+
+    FRship2110ValidationReport Report;
+};
+
+/**
+ * Receive thread feeding one UDP stream to a validator.
+ *
+ * Packets are timestamped on the local monotonic clock as they are read, in
+ * batches, so pacing results include the OS receive path's jitter. Multicast
+ * addresses are joined on the given interface; the socket allows address
+ * reuse so it can share a port with a local sender.
+ */
+class RSHIP2110_API FRship2110StreamReceiver : public FRunnable
+{
+public:
+    FRship2110StreamReceiver();
+    virtual ~FRship2110StreamReceiver();
+
+    /**
+     * Bind the socket and configure the validator. Call while stopped.
+     * @param InConfig Expected stream
+     * @param Address Unicast address to bind, or multicast group to join
+     * @param Port UDP port, or 0 for an ephemeral one (see GetPort)
+     * @param InterfaceIP Local interface for multicast, or empty for the default
+     * @return false if the socket could not be set up or the config is invalid
+     */
+    bool Open(const FRship2110ReceiverConfig& InConfig, const FString& Address, int32 Port,
+              const FString& InterfaceIP = FString());
+
+    /** Stop the thread and close the socket */
+    void Close();
+
+    /** Get the bound port */
+    int32 GetPort() const { return BoundPort; }
+
+    /**
+     * Start receiving.
+     * @return true if the thread is running
+     */
+    bool Start();
+
+    /** Stop the thread and wait for it to exit; the socket stays open */
+    void Shutdown();
+
+    /** Check whether the thread is running */
+    bool IsRunning() const { return Thread != nullptr; }
+
+    /** Clear the report and media, keeping the socket */
+    void Reset();
+
+    /** Get results so far */
+    FRship2110ValidationReport GetReport() const;
+
+    /**
+     * Copy the last complete video frame.
+     * @param OutFrame Receives the packed frame
+     * @return false if no frame has completed
+     */
+    bool CopyLastFrame(TArray<uint8>& OutFrame) const;
+
+    /** Move received audio samples out */
+    void TakeSamples(TArray<int32>& OutSamples);
+
+    /** Copy the ANC packets of the last frame */
+    void CopyLastAncPackets(TArray<FRship2110AncPacket>& OutPackets) const;
+
+    /**
+     * Wait until frames have been received.
+     * @param Count Frames closed by a marker
+     * @param TimeoutSeconds Give up after this long
+     * @return true if the count was reached
+     */
+    bool WaitForFrames(int64 Count, double TimeoutSeconds) const;
+
+    /**
+     * Wait until packets have been received.
+     * @param Count Packets received
+     * @param TimeoutSeconds Give up after this long
+     * @return true if the count was reached
+     */
+    bool WaitForPackets(int64 Count, double TimeoutSeconds) const;
+
+    // FRunnable interface
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    /** Largest datagram read; covers jumbo frames */
+    static constexpr int32 MaxDatagramSize = 9000;
+
+    /** Datagrams read before taking the validator lock */
+    static constexpr int32 BatchSize = 64;
+
+    FSocket* Socket = nullptr;
+    int32 BoundPort = 0;
+
+    FRship2110StreamValidator Validator;
+    mutable FCriticalSection ValidatorLock;
+
+    TArray<uint8> Batch;
+    int32 BatchSizes[BatchSize];
+    uint64 BatchTimes[BatchSize];
+
+    FThreadSafeBool bShouldStop;
+    FRunnableThread* Thread = nullptr;
+};
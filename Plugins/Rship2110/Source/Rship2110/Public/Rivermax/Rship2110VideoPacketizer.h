@@ -0,0 +1,201 @@
+// Copyright Rocketship. All Rights Reserved.
+// SMPTE ST 2110-20 / RFC 4175 RTP Packetizer
+//
+// Splits packed 2110-20 frames into RTP packets with sample row data
+// headers, and reassembles them on the receive side.
+//
+// Key features:
+// - Extended sequence number payload header
+// - Sample row data (SRD) headers split on pgroup boundaries, continuation bit chained
+// - Marker bit on the last packet of each frame
+// - General (GPM) and Block (BPM) packing modes
+// - Packet layout planned once per format; packets written into a preallocated arena
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Rship2110Types.h"
+
+/**
+ * One packet in the packetizer arena.
+ * Valid until the next PacketizeFrame call.
+ */
+struct FRship2110Packet
+{
+    /** RTP header, payload header, SRD headers and sample data */
+    const uint8* Data = nullptr;
+
+    /** Bytes in the packet (UDP payload size) */
+    int32 Size = 0;
+};
+
+/**
+ * Packetizes 2110-20 frames for one video format.
+ *
+ * Frames are the packed layout FRship2110PixelConverter produces: lines back
+ * to back, each GetBytesPerLine() long. Each RTP packet carries the two-byte
+ * extended sequence number followed by up to three SRD headers; every
+ * segment holds whole pgroups. GPM fills packets greedily up to the size
+ * limit, continuing into the next line. BPM carries exactly 1260 bytes of
+ * sample data per packet, except the frame's last, and needs a pgroup size
+ * dividing 180. Frames are sent progressive (F bit clear).
+ *
+ * Not thread-safe; one packetizer per stream.
+ */
+class RSHIP2110_API FRship2110VideoPacketizer
+{
+public:
+    static constexpr int32 RTPHeaderSize = 12;
+    static constexpr int32 PayloadHeaderSize = 2;
+    static constexpr int32 SRDHeaderSize = 6;
+    static constexpr int32 MaxSRDsPerPacket = 3;
+    static constexpr int32 BPMBlockSize = 180;
+    static constexpr int32 BPMPacketDataSize = 1260;
+
+    /** ST 2110-10 standard UDP size limit */
+    static constexpr int32 DefaultMaxPacketSize = 1460;
+
+    /**
+     * Plan the packet layout for a format and allocate the arena.
+     * @param InFormat Video format of the frames
+     * @param InPayloadType RTP payload type
+     * @param InSSRC RTP synchronization source
+     * @param InMaxPacketSize Largest UDP payload to emit
+     * @return false if the format cannot be packetized in the requested mode
+     */
+    bool Configure(const FRship2110VideoFormat& InFormat, uint8 InPayloadType, uint32 InSSRC,
+                   int32 InMaxPacketSize = DefaultMaxPacketSize);
+
+    /** Release the arena and layout */
+    void Reset();
+
+    /** Check whether Configure succeeded */
+    bool IsValid() const { return bValid; }
+
+    /**
+     * Build the packets for one frame.
+     * @param FrameData Packed frame, GetFrameBytes() long
+     * @param RTPTimestamp 90 kHz media clock timestamp shared by all packets
+     * @return Packets in send order, valid until the next call
+     */
+    TConstArrayView<FRship2110Packet> PacketizeFrame(const uint8* FrameData, uint32 RTPTimestamp);
+
+    /** Get packets per frame */
+    int32 GetPacketsPerFrame() const { return Packets.Num(); }
+
+    /** Get packed bytes per frame */
+    int64 GetFrameBytes() const { return static_cast<int64>(LineBytes) * Format.Height; }
+
+    /** Get bytes on the wire per frame (UDP payloads) */
+    int64 GetWireBytesPerFrame() const { return WireBytesPerFrame; }
+
+    /** Get the 32-bit sequence number of the next packet */
+    uint32 GetExtendedSequenceNumber() const { return ExtendedSequenceNumber; }
+
+    /** Set the 32-bit sequence number of the next packet */
+    void SetExtendedSequenceNumber(uint32 InSequenceNumber) { ExtendedSequenceNumber = InSequenceNumber; }
+
+private:
+    /** One SRD: a run of whole pgroups from a single line */
+    struct FSegment
+    {
+        int32 Row = 0;
+        int32 PixelOffset = 0;
+        int32 Length = 0;
+        int64 FrameOffset = 0;
+    };
+
+    /** Segments carried by one packet */
+    struct FPlannedPacket
+    {
+        int32 FirstSegment = 0;
+        int32 NumSegments = 0;
+    };
+
+    bool PlanPackets();
+
+    FRship2110VideoFormat Format;
+    bool bValid = false;
+    uint8 PayloadType = 96;
+    uint32 SSRC = 0;
+    int32 MaxPacketSize = DefaultMaxPacketSize;
+    int32 LineBytes = 0;
+    int32 PGroupSize = 0;
+    int32 PGroupCoverage = 0;
+    int64 WireBytesPerFrame = 0;
+    uint32 ExtendedSequenceNumber = 0;
+
+    TArray<FSegment> Segments;
+    TArray<FPlannedPacket> Plan;
+    TArray<FRship2110Packet> Packets;
+    TArray<uint8> Arena;
+};
+
+/**
+ * Reassembles 2110-20 frames from RTP packets.
+ *
+ * Sample data lands at the row and pixel offset its SRD header names, so
+ * reordered packets still rebuild the frame. A frame is complete when the
+ * marker packet arrives and every sample byte has been written.
+ */
+class RSHIP2110_API FRship2110VideoDepacketizer
+{
+public:
+    /** Receive counters */
+    struct FStats
+    {
+        int64 PacketsReceived = 0;
+        int64 PacketsLost = 0;
+        int64 PacketsMalformed = 0;
+        int64 FramesComplete = 0;
+        int64 FramesIncomplete = 0;
+    };
+
+    /**
+     * Size the frame buffer for a format.
+     * @param InFormat Video format of the stream
+     * @return false if the width is not a whole number of pgroups
+     */
+    bool Configure(const FRship2110VideoFormat& InFormat);
+
+    /**
+     * Consume one RTP packet.
+     * @param Data UDP payload
+     * @param Size Bytes in the payload
+     * @return true if the packet ended a frame (marker bit set)
+     */
+    bool ReceivePacket(const uint8* Data, int32 Size);
+
+    /** Get the frame being assembled, or the last one after a marker */
+    const TArray<uint8>& GetFrame() const { return Frame; }
+
+    /** Check whether the last marker closed a frame with every byte present */
+    bool IsFrameComplete() const { return bFrameComplete; }
+
+    /** Get the RTP timestamp of the last frame */
+    uint32 GetFrameTimestamp() const { return FrameTimestamp; }
+
+    /** Get the 32-bit sequence number of the last packet */
+    uint32 GetLastSequenceNumber() const { return LastSequenceNumber; }
+
+    /** Get receive counters */
+    const FStats& GetStats() const { return Stats; }
+
+private:
+    FRship2110VideoFormat Format;
+    bool bValid = false;
+    int32 LineBytes = 0;
+    int32 PGroupSize = 0;
+    int32 PGroupCoverage = 0;
+
+    TArray<uint8> Frame;
+    int64 FrameBytesReceived = 0;
+    bool bFrameStarted = false;
+    bool bFrameComplete = false;
+    uint32 FrameTimestamp = 0;
+
+    bool bHaveSequence = false;
+    uint32 LastSequenceNumber = 0;
+
+    FStats Stats;
+};
@@ -17,14 +17,22 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "Rship2110Types.h"
+#include "Capture/Rship2110PixelConverter.h"
+#include "Rivermax/Rship2110PacketTransmitter.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "Rship2110VideoSender.generated.h"
 
 class URivermaxManager;
 class URshipPTPService;
 class URship2110Subsystem;
-class FSocket;
-class FInternetAddr;
+class FRship2110GPUReadbackSource;
+class FTextureResource;
+
+/**
+ * Fired for each frame handed to the transmit path, with its 90 kHz RTP timestamp.
+ * Runs on the thread that submitted the frame.
+ */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnRship2110VideoFrameQueued, uint32 /*RTPTimestamp*/);
 
 /**
  * Capture source for video sender
@@ -172,12 +180,25 @@ public:
 
     /**
      * Submit a frame from a texture (GPU copy path).
+     * The texture is read back asynchronously and sent from a later Tick;
+     * it must match the stream's size and stay alive until the render
+     * thread has copied it.
      * @param SourceTexture Source texture to copy
      * @param PTPTimestamp PTP timestamp for this frame
-     * @return true if frame was accepted
+     * @return true if the readback was queued
      */
     bool SubmitFrameFromTexture(UTexture2D* SourceTexture, const FRshipPTPTimestamp& PTPTimestamp);
 
+    /**
+     * Submit unconverted pixels; converted and packed to the stream's pgroups.
+     * @param Pixels First line of source pixels (Width x Height)
+     * @param Input Source pixel layout
+     * @param SourceStride Bytes between source lines (0 = tightly packed)
+     * @param PTPTimestamp PTP timestamp for this frame
+     * @return true if frame was accepted
+     */
+    bool SubmitFramePixels(const void* Pixels, ERship2110PixelInput Input, int32 SourceStride, const FRshipPTPTimestamp& PTPTimestamp);
+
     // ========================================================================
     // FORMAT & TRANSPORT
     // ========================================================================
@@ -197,7 +218,8 @@ public:
     FRship2110TransportParams GetTransportParams() const { return TransportParams; }
 
     /**
-     * Update transport parameters (can be done while streaming).
+     * Update transport parameters. DSCP and TTL can change while streaming;
+     * addresses and ports only while stopped, and reopen the socket.
      * @param NewParams New transport parameters
      * @return true if update succeeded
      */
@@ -266,6 +288,9 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Rship|2110")
     FOn2110StreamStateChanged OnStateChanged;
 
+    /** Fired per queued frame; companion essence (2110-40 ANC) keys its timestamps off it */
+    FOnRship2110VideoFrameQueued& OnFrameQueued() { return FrameQueuedEvent; }
+
 private:
     // References
     UPROPERTY()
@@ -297,26 +322,26 @@ private:
     double LastSendTime = 0.0;
     int64 FrameCounter = 0;
 
-    // Buffers (managed externally or via Rivermax)
-    TArray<uint8> CaptureBuffer;
-    TArray<uint8> PacketBuffer;
-
-    // UDP socket for fallback transmission
-    FSocket* UDPSocket = nullptr;
-    TSharedPtr<FInternetAddr> DestinationAddr;
-
-    // Frame buffer pool for pipelining
-    struct FFrameBuffer
-    {
-        void* Data = nullptr;
-        size_t Size = 0;
-        bool bInUse = false;
-        FRshipPTPTimestamp Timestamp;
-    };
-    TArray<FFrameBuffer> FrameBuffers;
-    int32 CurrentBufferIndex = 0;
+    // Packed frames from SubmitFramePixels, queued to the transmit thread by reference
+    FRship2110PixelConverter PixelConverter;
+    FRship2110FramePoolPtr PixelFramePool;
+
+    FOnRship2110VideoFrameQueued FrameQueuedEvent;
+
+    // Software transmit path: packetizes and sends on its own thread
+    TUniquePtr<FRship2110TransmitThread> TransmitThread;
+    TUniquePtr<FRship2110ProviderPacingClock> PacingClock;  // ST 2110-21 frame anchor while running
+
+    // GPU readback of render targets and textures (ring driven on the render thread)
+    TSharedPtr<FRship2110GPUReadbackSource, ESPMode::ThreadSafe> ReadbackSource;
+    FRship2110ReadbackRing Readback;
+    static constexpr int32 NumReadbackSlots = 3;
     static constexpr int32 NumFrameBuffers = 4;
 
+    // Frames read back and waiting for Tick to queue them
+    TArray<FRship2110FrameRef> CompletedFrames;
+    FCriticalSection CompletedLock;
+
 #if RSHIP_RIVERMAX_AVAILABLE
     // Rivermax stream handle
     void* RivermaxStream = nullptr;
@@ -332,17 +357,18 @@ private:
     void TransmitFrame();
     bool AllocateBuffers();
     void FreeBuffers();
-    void PackRTPPackets(const void* FrameData, int64 DataSize, const FRshipPTPTimestamp& Timestamp);
-    void SendPacket(const void* PacketData, int32 PacketSize);
+    bool CreateTransmitThread();
+    bool SendFrameViaSoftware(const void* FrameData, int64 DataSize, const FRshipPTPTimestamp& Timestamp);
+    bool SendPooledFrame(FRship2110FrameRef Frame);
+    uint32 GetRTPTimestampForFrame(const FRshipPTPTimestamp& Timestamp) const;
+    void OnFrameEnqueued(uint32 RTPTimestamp, int64 DataSize);
+
+    // GPU readback
+    bool EnqueueReadback(FTextureResource* Resource, const FRshipPTPTimestamp& Timestamp);
+    void PollReadbacks_RenderThread();
     void UpdateStatistics(int64 BytesSent, bool bLateFrame);
     void SetState(ERship2110StreamState NewState);
 
-    // Color format conversion
-    void ConvertRGBAToYCbCr422(const uint8* RGBAData, uint8* YCbCrData, int32 Width, int32 Height);
-    void ConvertRGBAToYCbCr444(const uint8* RGBAData, uint8* YCbCrData, int32 Width, int32 Height);
-
     // 2110-20 specific
     int32 CalculatePacketsPerFrame() const;
-    int32 CalculatePacketPayloadSize() const;
-    int32 CalculatePixelsPerPacket() const;
 };
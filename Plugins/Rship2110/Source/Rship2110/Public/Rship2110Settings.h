@@ -167,6 +167,35 @@ public:
         meta = (DisplayName = "Chunks Per Stream", ClampMin = "2", ClampMax = "16"))
     int32 ChunksPerStream = 4;
 
+    // ============================================================================
+    // SOFTWARE TRANSMIT (used when Rivermax is not carrying the stream)
+    // ============================================================================
+
+    /** Coalesce packets into UDP_SEGMENT sends where the kernel supports it (Linux) */
+    UPROPERTY(EditAnywhere, config, Category = "Transmit",
+        meta = (DisplayName = "UDP Segmentation Offload"))
+    bool bUseSegmentationOffload = true;
+
+    /** Hand packets to the kernel with launch times via SO_TXTIME (Linux, needs an ETF qdisc) */
+    UPROPERTY(EditAnywhere, config, Category = "Transmit",
+        meta = (DisplayName = "Kernel Launch Times"))
+    bool bUseLaunchTime = false;
+
+    /** Pace packets to the ST 2110-21 schedule for each stream's sender type */
+    UPROPERTY(EditAnywhere, config, Category = "Transmit",
+        meta = (DisplayName = "ST 2110-21 Pacing"))
+    bool bEnablePacing = true;
+
+    /** CPU core for each stream's transmit thread (-1 = no affinity) */
+    UPROPERTY(EditAnywhere, config, Category = "Transmit",
+        meta = (DisplayName = "Transmit Thread Core", ClampMin = "-1", ClampMax = "63"))
+    int32 TransmitThreadCore = -1;
+
+    /** Audio buffered before a 2110-30 stream starts sending, and after an underrun; at least one submix callback */
+    UPROPERTY(EditAnywhere, config, Category = "Transmit",
+        meta = (DisplayName = "Audio Buffer (ms)", ClampMin = "1", ClampMax = "500"))
+    int32 AudioBufferMs = 30;
+
     // ============================================================================
     // DEFAULT VIDEO FORMAT
     // ============================================================================
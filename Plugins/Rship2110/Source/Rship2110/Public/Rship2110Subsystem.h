@@ -23,6 +23,9 @@ class URshipPTPService;
 class URivermaxManager;
 class URshipIPMXService;
 class URship2110VideoSender;
+class URship2110AudioSender;
+class URship2110AncSender;
+class USoundSubmix;
 class URship2110VideoCapture;
 class URship2110Settings;
 class URshipSubsystem;
@@ -182,6 +185,62 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Rship|2110|Streams")
     bool StopStream(const FString& StreamId);
 
+    /**
+     * Create and start an audio sender stream.
+     * @param AudioFormat Audio format
+     * @param TransportParams Transport parameters
+     * @param Submix Submix to send (nullptr = main submix)
+     * @return Stream ID or empty string on failure
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110|Streams")
+    FString CreateAudioStream(
+        const FRship2110AudioFormat& AudioFormat,
+        const FRship2110TransportParams& TransportParams,
+        USoundSubmix* Submix = nullptr);
+
+    /**
+     * Stop and destroy an audio stream.
+     * @param StreamId Stream to destroy
+     * @return true if destroyed
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110|Streams")
+    bool DestroyAudioStream(const FString& StreamId);
+
+    /**
+     * Get an audio sender by ID.
+     * @param StreamId Stream ID
+     * @return Audio sender or nullptr
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110|Streams")
+    URship2110AudioSender* GetAudioSender(const FString& StreamId) const;
+
+    /**
+     * Create and start an ancillary data stream that follows a video stream.
+     * @param VideoStreamId Video stream whose frames time the ANC data
+     * @param TransportParams Transport parameters
+     * @return Stream ID or empty string on failure
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110|Streams")
+    FString CreateAncStream(
+        const FString& VideoStreamId,
+        const FRship2110TransportParams& TransportParams);
+
+    /**
+     * Stop and destroy an ancillary data stream.
+     * @param StreamId Stream to destroy
+     * @return true if destroyed
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110|Streams")
+    bool DestroyAncStream(const FString& StreamId);
+
+    /**
+     * Get an ancillary data sender by ID.
+     * @param StreamId Stream ID
+     * @return Ancillary sender or nullptr
+     */
+    UFUNCTION(BlueprintCallable, Category = "Rship|2110|Streams")
+    URship2110AncSender* GetAncSender(const FString& StreamId) const;
+
     // ========================================================================
     // QUICK ACCESS - IPMX
     // ========================================================================
@@ -316,6 +375,16 @@ private:
     // State
     bool bIsInitialized = false;
 
+    // Audio streams, keyed by stream ID
+    UPROPERTY()
+    TMap<FString, URship2110AudioSender*> AudioSenders;
+    int32 AudioStreamCounter = 0;
+
+    // Ancillary streams, keyed by stream ID
+    UPROPERTY()
+    TMap<FString, URship2110AncSender*> AncSenders;
+    int32 AncStreamCounter = 0;
+
     // Stream to IPMX mapping
     TMap<FString, FString> StreamToIPMXSender;  // Stream ID -> IPMX Sender ID
 
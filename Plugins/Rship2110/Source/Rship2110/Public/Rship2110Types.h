@@ -202,7 +202,10 @@ enum class ERship2110Colorimetry : uint8
     DCIP3           UMETA(DisplayName = "DCI-P3"),
 
     /** ST 2065-1 - ACES */
-    ST2065_1        UMETA(DisplayName = "ACES (ST 2065-1)")
+    ST2065_1        UMETA(DisplayName = "ACES (ST 2065-1)"),
+
+    /** BT.601 - Standard definition */
+    BT601           UMETA(DisplayName = "BT.601")
 };
 
 /**
@@ -227,6 +230,61 @@ enum class ERship2110TransferFunction : uint8
     sRGB            UMETA(DisplayName = "sRGB")
 };
 
+/**
+ * Quantization range for 2110-20 samples (SDP RANGE parameter)
+ */
+UENUM(BlueprintType)
+enum class ERship2110ColorRange : uint8
+{
+    /** Narrow (video) range - 64-940 luma / 64-960 chroma at 10-bit */
+    Narrow          UMETA(DisplayName = "Narrow"),
+
+    /** Full range - 0 to 2^depth - 1 */
+    Full            UMETA(DisplayName = "Full")
+};
+
+/**
+ * Horizontal siting of subsampled chroma in YCbCr 4:2:2
+ */
+UENUM(BlueprintType)
+enum class ERship2110ChromaSiting : uint8
+{
+    /** Chroma co-sited with even luma samples (BT.709 / BT.2020) */
+    Cosited         UMETA(DisplayName = "Co-sited"),
+
+    /** Chroma midway between luma samples (MPEG-1 / JPEG style) */
+    Interstitial    UMETA(DisplayName = "Interstitial")
+};
+
+/**
+ * Packing mode for 2110-20 packets (SDP PM parameter)
+ */
+UENUM(BlueprintType)
+enum class ERship2110PackingMode : uint8
+{
+    /** General Packing Mode - whole pgroups up to the packet size limit */
+    GPM             UMETA(DisplayName = "General (2110GPM)"),
+
+    /** Block Packing Mode - 1260 bytes of 180-byte blocks per packet */
+    BPM             UMETA(DisplayName = "Block (2110BPM)")
+};
+
+/**
+ * ST 2110-21 sender type (SDP TP parameter)
+ */
+UENUM(BlueprintType)
+enum class ERship2110SenderType : uint8
+{
+    /** Narrow gapped - packets spread over the active lines, silent through vertical blanking */
+    NarrowGapped    UMETA(DisplayName = "Narrow Gapped (2110TPN)"),
+
+    /** Narrow linear - packets spread evenly over the whole frame */
+    NarrowLinear    UMETA(DisplayName = "Narrow Linear (2110TPNL)"),
+
+    /** Wide - gapped timing with short bursts, for receivers with deep buffers */
+    Wide            UMETA(DisplayName = "Wide (2110TPW)")
+};
+
 /**
  * HDR metadata for content light levels (ST.2086 / CTA-861.3)
  */
@@ -424,6 +482,22 @@ struct RSHIP2110_API FRship2110VideoFormat
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|2110|HDR")
     ERship2110TransferFunction TransferFunction = ERship2110TransferFunction::SDR;
 
+    /** Quantization range */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|2110")
+    ERship2110ColorRange Range = ERship2110ColorRange::Narrow;
+
+    /** Chroma siting for 4:2:2 subsampling */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|2110")
+    ERship2110ChromaSiting ChromaSiting = ERship2110ChromaSiting::Cosited;
+
+    /** Packet packing mode */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|2110")
+    ERship2110PackingMode PackingMode = ERship2110PackingMode::GPM;
+
+    /** ST 2110-21 traffic shaping model */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|2110")
+    ERship2110SenderType SenderType = ERship2110SenderType::NarrowGapped;
+
     /** HDR metadata (ST.2086 / CTA-861.3) */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|2110|HDR")
     FRship2110HDRMetadata HDRMetadata;
@@ -440,9 +514,15 @@ struct RSHIP2110_API FRship2110VideoFormat
         return static_cast<uint64>(1000000000.0 * FrameRateDenominator / FrameRateNumerator);
     }
 
-    /** Get bytes per line for given format */
+    /** Get bytes per line for given format (whole pgroups) */
     int32 GetBytesPerLine() const;
 
+    /** Get pgroup size in bytes (ST 2110-20 Table 1 / RFC 4175) */
+    int32 GetPGroupSize() const;
+
+    /** Get number of pixels covered by one pgroup */
+    int32 GetPGroupCoverage() const;
+
     /** Get total frame size in bytes */
     int64 GetFrameSizeBytes() const;
 
@@ -490,10 +570,34 @@ struct RSHIP2110_API FRship2110VideoFormat
             case ERship2110Colorimetry::BT2100: return TEXT("BT2100");
             case ERship2110Colorimetry::DCIP3: return TEXT("DCIP3");
             case ERship2110Colorimetry::ST2065_1: return TEXT("ST2065-1");
+            case ERship2110Colorimetry::BT601: return TEXT("BT601");
             default: return TEXT("BT709");
         }
     }
 
+    /** Get range string for SDP ("NARROW" or "FULL") */
+    FString GetRangeString() const
+    {
+        return Range == ERship2110ColorRange::Full ? TEXT("FULL") : TEXT("NARROW");
+    }
+
+    /** Get packing mode string for SDP ("2110GPM" or "2110BPM") */
+    FString GetPackingModeString() const
+    {
+        return PackingMode == ERship2110PackingMode::BPM ? TEXT("2110BPM") : TEXT("2110GPM");
+    }
+
+    /** Get sender type string for SDP (e.g., "2110TPN") */
+    FString GetSenderTypeString() const
+    {
+        switch (SenderType)
+        {
+            case ERship2110SenderType::NarrowLinear: return TEXT("2110TPNL");
+            case ERship2110SenderType::Wide: return TEXT("2110TPW");
+            default: return TEXT("2110TPN");
+        }
+    }
+
     /** Get transfer characteristic string for SDP (e.g., "SDR", "PQ", "HLG") */
     FString GetTransferCharacteristicString() const
     {
@@ -527,6 +631,71 @@ struct RSHIP2110_API FRship2110VideoFormat
     }
 };
 
+/**
+ * Audio format for 2110-30 / AES67 streams
+ */
+USTRUCT(BlueprintType)
+struct RSHIP2110_API FRship2110AudioFormat
+{
+    GENERATED_BODY()
+
+    /** Largest RTP payload a 2110-30 packet may carry */
+    static constexpr int32 MaxPayloadBytes = 1440;
+
+    /** Sample rate (48000 or 96000) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|2110")
+    int32 SampleRate = 48000;
+
+    /** Bits per sample (16 = L16, 24 = L24) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|2110")
+    int32 BitsPerSample = 24;
+
+    /** Number of channels (1-64; more than 8 needs 125 us packets to fit the payload limit) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|2110",
+        meta = (ClampMin = "1", ClampMax = "64"))
+    int32 NumChannels = 2;
+
+    /** Packet time in microseconds (125, 250, 333, 1000, 4000) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|2110")
+    int32 PacketTimeUs = 1000;
+
+    /** Get bytes per sample */
+    int32 GetBytesPerSample() const { return BitsPerSample / 8; }
+
+    /** Get sample frames per packet (333 us rounds to 16 at 48 kHz, as AES67 does) */
+    int32 GetSamplesPerPacket() const
+    {
+        return FMath::RoundToInt32(static_cast<double>(SampleRate) * PacketTimeUs / 1000000.0);
+    }
+
+    /** Get RTP payload bytes per packet */
+    int32 GetPayloadBytes() const
+    {
+        return GetSamplesPerPacket() * NumChannels * GetBytesPerSample();
+    }
+
+    /** Get RTP encoding name for SDP ("L16" or "L24") */
+    FString GetEncodingName() const
+    {
+        return FString::Printf(TEXT("L%d"), BitsPerSample);
+    }
+
+    /** Get packet time in milliseconds for the SDP ptime attribute (e.g., "1", "0.125") */
+    FString GetPacketTimeString() const
+    {
+        return FString::Printf(TEXT("%g"), PacketTimeUs / 1000.0);
+    }
+
+    /** Check the format can be carried as 2110-30 */
+    bool IsValid() const
+    {
+        return (SampleRate == 48000 || SampleRate == 96000) &&
+               (BitsPerSample == 16 || BitsPerSample == 24) &&
+               NumChannels >= 1 && NumChannels <= 64 &&
+               GetSamplesPerPacket() >= 1 && GetPayloadBytes() <= MaxPayloadBytes;
+    }
+};
+
 /**
  * RTP transport parameters for 2110 streams
  */
@@ -54,6 +54,7 @@ public class Rship2110 : ModuleRules
                 "Json",
                 "JsonUtilities",
                 "HTTP",
+                "HTTPServer",  // IS-04 Node API and IS-05 Connection API
                 "Sockets",
                 "Networking",
                 "RshipExec",  // For integration with existing rship subsystem
@@ -68,6 +69,8 @@ public class Rship2110 : ModuleRules
                 "SlateCore",
                 "Settings",
                 "Projects",  // For plugin version info
+                "AudioMixer",  // Submix listener for 2110-30 audio
+                "AudioMixerCore",
             }
         );
 
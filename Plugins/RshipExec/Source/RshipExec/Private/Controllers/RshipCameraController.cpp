@@ -1,36 +1,51 @@
 #include "Controllers/RshipCameraController.h"
 
+#include "Controllers/RshipPublishScheduler.h"
 #include "RshipSubsystem.h"
 #include "Camera/CameraComponent.h"
 #include "CineCameraComponent.h"
 #include "CineCameraSettings.h"
 #include "GameFramework/Actor.h"
-#include "Dom/JsonObject.h"
 
-void URshipCameraController::OnBeforeRegisterRshipTargets()
+void URshipCameraController::BeginPlay()
 {
-	PrimaryComponentTick.bCanEverTick = true;
-	SetComponentTickEnabled(bPublishStateEmitters);
+	Super::BeginPlay();
+	ApplyPublishRate();
 }
 
-void URshipCameraController::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+#if WITH_EDITOR
+void URshipCameraController::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	Super::PostEditChangeProperty(PropertyChangedEvent);
 
-	if (!bPublishStateEmitters)
+	const FName PropertyName = PropertyChangedEvent.GetMemberPropertyName();
+	if (PropertyName == GET_MEMBER_NAME_CHECKED(URshipCameraController, bPublishStateEmitters)
+		|| PropertyName == GET_MEMBER_NAME_CHECKED(URshipCameraController, PublishRateHz))
 	{
-		return;
+		ApplyPublishRate();
 	}
+}
+#endif
+
+void URshipCameraController::SetPublishStateEmitters(bool bEnable)
+{
+	bPublishStateEmitters = bEnable;
+	ApplyPublishRate();
+}
 
-	const double NowSeconds = FPlatformTime::Seconds();
-	const double PublishInterval = 1.0 / static_cast<double>(FMath::Max(1, PublishRateHz));
-	if (NowSeconds - LastPublishTimeSeconds < PublishInterval)
+void URshipCameraController::SetPublishRateHz(int32 RateHz)
+{
+	PublishRateHz = FMath::Clamp(RateHz, 1, 120);
+	ApplyPublishRate();
+}
+
+void URshipCameraController::ApplyPublishRate()
+{
+	// Publishing starts at BeginPlay; edits before then are picked up there
+	if (HasBegunPlay())
 	{
-		return;
+		SetPublishRate(bPublishStateEmitters ? PublishRateHz : 0);
 	}
-
-	LastPublishTimeSeconds = NowSeconds;
-	PublishState();
 }
 
 FString URshipCameraController::GetTargetId() const
@@ -46,6 +61,7 @@ void URshipCameraController::RegisterOrRefreshTarget()
 	{
 		return;
 	}
+	PublishTargetId = Target.GetId();
 
 	FRshipTargetProxy SensorTarget = Target.AddTarget(TEXT("sensor"), TEXT("Sensor"));
 	FRshipTargetProxy LensTarget = Target.AddTarget(TEXT("lens"), TEXT("Lens"));
@@ -166,64 +182,44 @@ UCineCameraComponent* URshipCameraController::ResolveCineCameraComponent() const
 	return nullptr;
 }
 
-void URshipCameraController::PublishState()
+void URshipCameraController::GatherPublishState(FRshipPublishBatch& Batch)
 {
+	static const TCHAR* const XYZ[] = { TEXT("x"), TEXT("y"), TEXT("z") };
+
+	if (!bPublishStateEmitters)
+	{
+		return;
+	}
+
 	AActor* Owner = GetOwner();
 	UCameraComponent* Camera = ResolveCameraComponent();
 	if (!Owner || !Camera)
 	{
 		return;
 	}
-	URshipSubsystem* Subsystem = ResolveRshipSubsystem();
-	const FString TargetId = GetTargetId();
-	if (!Subsystem || TargetId.IsEmpty())
+
+	if (!Batch.BeginSource(PublishTargetId.IsEmpty() ? GetTargetId() : PublishTargetId))
 	{
 		return;
 	}
 
 	const FVector Location = Owner->GetActorLocation();
-	{
-		TSharedPtr<FJsonObject> Data = MakeShareable(new FJsonObject);
-		Data->SetNumberField(TEXT("x"), Location.X);
-		Data->SetNumberField(TEXT("y"), Location.Y);
-		Data->SetNumberField(TEXT("z"), Location.Z);
-		Subsystem->PulseEmitter(TargetId, TEXT("location"), Data);
-	}
+	Batch.AddVector(TEXT("location"), XYZ, Location.X, Location.Y, Location.Z);
 
 	const FRotator Rotation = Owner->GetActorRotation();
-	{
-		TSharedPtr<FJsonObject> Data = MakeShareable(new FJsonObject);
-		Data->SetNumberField(TEXT("x"), Rotation.Pitch);
-		Data->SetNumberField(TEXT("y"), Rotation.Yaw);
-		Data->SetNumberField(TEXT("z"), Rotation.Roll);
-		Subsystem->PulseEmitter(TargetId, TEXT("rotation"), Data);
-	}
+	Batch.AddVector(TEXT("rotation"), XYZ, Rotation.Pitch, Rotation.Yaw, Rotation.Roll);
 
 	if (UCineCameraComponent* Cine = ResolveCineCameraComponent())
 	{
-		TSharedPtr<FJsonObject> Data = MakeShareable(new FJsonObject);
-		Data->SetNumberField(TEXT("value"), Cine->CurrentFocalLength);
-		Subsystem->PulseEmitter(TargetId, TEXT("focalLength"), Data);
-		Data = MakeShareable(new FJsonObject);
-		Data->SetNumberField(TEXT("value"), Cine->CurrentAperture);
-		Subsystem->PulseEmitter(TargetId, TEXT("aperture"), Data);
-		Data = MakeShareable(new FJsonObject);
-		Data->SetNumberField(TEXT("value"), Cine->CurrentFocusDistance);
-		Subsystem->PulseEmitter(TargetId, TEXT("focusDistance"), Data);
-		Data = MakeShareable(new FJsonObject);
-		Data->SetNumberField(TEXT("value"), Cine->GetHorizontalFieldOfView());
-		Subsystem->PulseEmitter(TargetId, TEXT("horizontalFov"), Data);
-		Data = MakeShareable(new FJsonObject);
-		Data->SetNumberField(TEXT("value"), Cine->GetVerticalFieldOfView());
-		Subsystem->PulseEmitter(TargetId, TEXT("verticalFov"), Data);
+		Batch.AddValue(TEXT("focalLength"), TEXT("value"), Cine->CurrentFocalLength);
+		Batch.AddValue(TEXT("aperture"), TEXT("value"), Cine->CurrentAperture);
+		Batch.AddValue(TEXT("focusDistance"), TEXT("value"), Cine->CurrentFocusDistance);
+		Batch.AddValue(TEXT("horizontalFov"), TEXT("value"), Cine->GetHorizontalFieldOfView());
+		Batch.AddValue(TEXT("verticalFov"), TEXT("value"), Cine->GetVerticalFieldOfView());
 	}
 	else
 	{
-		TSharedPtr<FJsonObject> Data = MakeShareable(new FJsonObject);
-		Data->SetNumberField(TEXT("value"), Camera->FieldOfView);
-		Subsystem->PulseEmitter(TargetId, TEXT("horizontalFov"), Data);
-		Data = MakeShareable(new FJsonObject);
-		Data->SetNumberField(TEXT("value"), Camera->FieldOfView);
-		Subsystem->PulseEmitter(TargetId, TEXT("verticalFov"), Data);
+		Batch.AddValue(TEXT("horizontalFov"), TEXT("value"), Camera->FieldOfView);
+		Batch.AddValue(TEXT("verticalFov"), TEXT("value"), Camera->FieldOfView);
 	}
 }
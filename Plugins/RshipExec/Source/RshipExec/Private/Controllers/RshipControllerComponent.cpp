@@ -1,6 +1,7 @@
 #include "Controllers/RshipControllerComponent.h"
-#include "Containers/Ticker.h"
+#include "Controllers/RshipPublishScheduler.h"
 #include "Engine/Engine.h"
+#include "Engine/World.h"
 #include "GameFramework/Actor.h"
 #include "RshipActorRegistrationComponent.h"
 #include "RshipSubsystem.h"
@@ -9,16 +10,26 @@ void URshipControllerComponent::OnRegister()
 {
 	Super::OnRegister();
 	OnBeforeRegisterRshipTargets();
-	RegisterRshipTargets();
-	ScheduleDeferredRegisterRshipTargets();
+
+	// Registration runs from the subsystem's time-sliced queue after the owner's target exists
+	if (URshipSubsystem* Subsystem = ResolveRshipSubsystem())
+	{
+		Subsystem->QueueTargetRegistration(this);
+	}
 }
 
 void URshipControllerComponent::OnUnregister()
 {
-	ScheduleOwnerRegistrationRefresh();
+	QueueOwnerRegistrationRefresh();
 	Super::OnUnregister();
 }
 
+void URshipControllerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	SetPublishRate(0.0);
+	Super::EndPlay(EndPlayReason);
+}
+
 void URshipControllerComponent::RegisterRshipTargets()
 {
 	RegisterOrRefreshTarget();
@@ -68,25 +79,26 @@ FRshipTargetProxy URshipControllerComponent::ResolveChildTarget(const FString& R
 	return ParentTarget.AddTarget(Suffix, Suffix);
 }
 
-void URshipControllerComponent::ScheduleDeferredRegisterRshipTargets()
+void URshipControllerComponent::SetPublishRate(double RateHz)
 {
-	const TWeakObjectPtr<URshipControllerComponent> WeakThis(this);
-	FTSTicker::GetCoreTicker().AddTicker(
-		FTickerDelegate::CreateLambda([WeakThis](float)
-		{
-			URshipControllerComponent* StrongThis = WeakThis.Get();
-			if (!IsValid(StrongThis))
-			{
-				return false;
-			}
-
-			StrongThis->RegisterRshipTargets();
-			return false;
-		}),
-		0.0f);
+	UWorld* World = GetWorld();
+	URshipPublishScheduler* Scheduler = World ? World->GetSubsystem<URshipPublishScheduler>() : nullptr;
+	if (!Scheduler)
+	{
+		return;
+	}
+
+	if (RateHz > 0.0)
+	{
+		Scheduler->RegisterController(this, RateHz);
+	}
+	else
+	{
+		Scheduler->UnregisterController(this);
+	}
 }
 
-void URshipControllerComponent::ScheduleOwnerRegistrationRefresh()
+void URshipControllerComponent::QueueOwnerRegistrationRefresh()
 {
 	AActor* Owner = GetOwner();
 	if (!IsValid(Owner) || Owner->IsActorBeingDestroyed())
@@ -94,22 +106,14 @@ void URshipControllerComponent::ScheduleOwnerRegistrationRefresh()
 		return;
 	}
 
-	const TWeakObjectPtr<AActor> WeakOwner(Owner);
-	FTSTicker::GetCoreTicker().AddTicker(
-		FTickerDelegate::CreateLambda([WeakOwner](float)
-		{
-			AActor* StrongOwner = WeakOwner.Get();
-			if (!IsValid(StrongOwner) || StrongOwner->IsActorBeingDestroyed())
-			{
-				return false;
-			}
-
-			if (URshipActorRegistrationComponent* Registration = StrongOwner->FindComponentByClass<URshipActorRegistrationComponent>())
-			{
-				Registration->Register();
-			}
-
-			return false;
-		}),
-		0.0f);
+	URshipSubsystem* Subsystem = ResolveRshipSubsystem();
+	if (!Subsystem)
+	{
+		return;
+	}
+
+	if (URshipActorRegistrationComponent* Registration = Owner->FindComponentByClass<URshipActorRegistrationComponent>())
+	{
+		Subsystem->QueueTargetRegistration(Registration);
+	}
 }
@@ -1,6 +1,8 @@
 // Rship Material Controller Implementation
 
 #include "Controllers/RshipMaterialController.h"
+#include "Controllers/RshipPublishScheduler.h"
+#include "RshipSubsystem.h"
 #include "Logs.h"
 #include "GameFramework/Actor.h"
 #include "Components/MeshComponent.h"
@@ -16,8 +18,8 @@
 
 URshipMaterialController::URshipMaterialController()
 {
-    PrimaryComponentTick.bCanEverTick = true;
-    PrimaryComponentTick.bStartWithTickEnabled = false;
+    // State publishing runs through URshipPublishScheduler instead of a component tick
+    PrimaryComponentTick.bCanEverTick = false;
 }
 
 void URshipMaterialController::RegisterOrRefreshTarget()
@@ -27,6 +29,7 @@ void URshipMaterialController::RegisterOrRefreshTarget()
     {
         return;
     }
+    PublishTargetId = Target.GetId();
 
     Target
         .AddAction(this, GET_FUNCTION_NAME_CHECKED(URshipMaterialController, SetScalarParameter), TEXT("SetScalarParameter"))
@@ -75,13 +78,7 @@ void URshipMaterialController::BeginPlay()
     SetupMaterials();
     CacheDefaultValues();
 
-    // Set publish interval from rate
-    PublishInterval = 1.0 / FMath::Max(1, PublishRateHz);
-
-    if (bEnableTick)
-    {
-        SetComponentTickEnabled(true);
-    }
+    SetPublishRate(bEnableTick ? PublishRateHz : 0);
 
     // Registration is handled by URshipControllerComponent::OnRegister through RegisterOrRefreshTarget.
 }
@@ -89,29 +86,18 @@ void URshipMaterialController::BeginPlay()
 void URshipMaterialController::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
     DynamicMaterials.Empty();
+    ParameterCaches.Empty();
 
     Super::EndPlay(EndPlayReason);
 }
 
-void URshipMaterialController::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
-{
-    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-    // Publish state at configured rate
-    double CurrentTime = FPlatformTime::Seconds();
-    if (CurrentTime - LastPublishTime >= PublishInterval)
-    {
-        ReadAndPublishState();
-        LastPublishTime = CurrentTime;
-    }
-}
-
 void URshipMaterialController::SetupMaterials()
 {
     AActor* Owner = GetOwner();
     if (!Owner) return;
 
     DynamicMaterials.Empty();
+    ParameterCaches.Empty();
 
     // Get all mesh components
     TArray<UMeshComponent*> MeshComponents;
@@ -162,15 +148,79 @@ void URshipMaterialController::SetupMaterials()
         }
     }
 
+    // Resolve parameter slots up front so the first action doesn't pay for it
+    ParameterCaches.SetNum(DynamicMaterials.Num());
+    if (bUseParameterCache)
+    {
+        for (int32 i = 0; i < DynamicMaterials.Num(); ++i)
+        {
+            ParameterCaches[i].Build(DynamicMaterials[i]);
+        }
+    }
+
     UE_LOG(LogRshipExec, Log, TEXT("MaterialController: Setup %d dynamic materials on %s"),
         DynamicMaterials.Num(), *Owner->GetName());
 }
 
+void URshipMaterialController::InvalidateParameterCache()
+{
+    for (FRshipMaterialParameterCache& Cache : ParameterCaches)
+    {
+        Cache.Invalidate();
+    }
+}
+
+void URshipMaterialController::WriteScalarParam(ERshipMaterialParam Param, float Value)
+{
+    ParameterCaches.SetNum(DynamicMaterials.Num());
+    for (int32 i = 0; i < DynamicMaterials.Num(); ++i)
+    {
+        UMaterialInstanceDynamic* MID = DynamicMaterials[i];
+        if (!MID) continue;
+
+        if (bUseParameterCache)
+        {
+            ParameterCaches[i].WriteScalar(MID, Param, Value);
+        }
+        else
+        {
+            FRshipMaterialParameterCache::WriteScalarUncached(MID, Param, Value);
+        }
+    }
+}
+
+void URshipMaterialController::WriteVectorParam(ERshipMaterialParam Param, const FLinearColor& Value)
+{
+    ParameterCaches.SetNum(DynamicMaterials.Num());
+    for (int32 i = 0; i < DynamicMaterials.Num(); ++i)
+    {
+        UMaterialInstanceDynamic* MID = DynamicMaterials[i];
+        if (!MID) continue;
+
+        if (bUseParameterCache)
+        {
+            ParameterCaches[i].WriteVector(MID, Param, Value);
+        }
+        else
+        {
+            FRshipMaterialParameterCache::WriteVectorUncached(MID, Param, Value);
+        }
+    }
+}
+
 void URshipMaterialController::SetScalarValue(FName ParameterName, float Value)
 {
-    for (UMaterialInstanceDynamic* MID : DynamicMaterials)
+    ParameterCaches.SetNum(DynamicMaterials.Num());
+    for (int32 i = 0; i < DynamicMaterials.Num(); ++i)
     {
-        if (MID)
+        UMaterialInstanceDynamic* MID = DynamicMaterials[i];
+        if (!MID) continue;
+
+        if (bUseParameterCache)
+        {
+            ParameterCaches[i].WriteScalarByName(MID, ParameterName, Value);
+        }
+        else
         {
             MID->SetScalarParameterValue(ParameterName, Value);
         }
@@ -179,9 +229,17 @@ void URshipMaterialController::SetScalarValue(FName ParameterName, float Value)
 
 void URshipMaterialController::SetVectorValue(FName ParameterName, FLinearColor Value)
 {
-    for (UMaterialInstanceDynamic* MID : DynamicMaterials)
+    ParameterCaches.SetNum(DynamicMaterials.Num());
+    for (int32 i = 0; i < DynamicMaterials.Num(); ++i)
     {
-        if (MID)
+        UMaterialInstanceDynamic* MID = DynamicMaterials[i];
+        if (!MID) continue;
+
+        if (bUseParameterCache)
+        {
+            ParameterCaches[i].WriteVectorByName(MID, ParameterName, Value);
+        }
+        else
         {
             MID->SetVectorParameterValue(ParameterName, Value);
         }
@@ -199,26 +257,13 @@ void URshipMaterialController::RefreshMaterials()
 
 void URshipMaterialController::SetScalarParameter(FName ParameterName, float Value)
 {
-    for (UMaterialInstanceDynamic* MID : DynamicMaterials)
-    {
-        if (MID)
-        {
-            MID->SetScalarParameterValue(ParameterName, Value);
-        }
-    }
+    SetScalarValue(ParameterName, Value);
     OnScalarParameterChanged.Broadcast(ParameterName, Value);
 }
 
 void URshipMaterialController::SetVectorParameter(FName ParameterName, float R, float G, float B, float A)
 {
-    FLinearColor Color(R, G, B, A);
-    for (UMaterialInstanceDynamic* MID : DynamicMaterials)
-    {
-        if (MID)
-        {
-            MID->SetVectorParameterValue(ParameterName, Color);
-        }
-    }
+    SetVectorValue(ParameterName, FLinearColor(R, G, B, A));
     OnVectorParameterChanged.Broadcast(ParameterName, R, G, B, A);
 }
 
@@ -259,14 +304,7 @@ void URshipMaterialController::SetBaseColorWithAlpha(float R, float G, float B,
     FLinearColor Color(R * GlobalTint.R * GlobalIntensityMultiplier,
                        G * GlobalTint.G * GlobalIntensityMultiplier,
                        B * GlobalTint.B * GlobalIntensityMultiplier, A);
-    for (UMaterialInstanceDynamic* MID : DynamicMaterials)
-    {
-        if (MID)
-        {
-            MID->SetVectorParameterValue(TEXT("BaseColor"), Color);
-            MID->SetVectorParameterValue(TEXT("Base Color"), Color);
-        }
-    }
+    WriteVectorParam(ERshipMaterialParam::BaseColor, Color);
     LastBaseColor = FLinearColor(R, G, B, A);
     OnBaseColorChanged.Broadcast(R, G, B);
 }
@@ -280,16 +318,8 @@ void URshipMaterialController::SetEmissiveIntensity(float Intensity)
 {
     LastEmissiveIntensity = Intensity;
     FLinearColor EmissiveColor = LastEmissiveColor * Intensity * GlobalIntensityMultiplier;
-    for (UMaterialInstanceDynamic* MID : DynamicMaterials)
-    {
-        if (MID)
-        {
-            MID->SetVectorParameterValue(TEXT("EmissiveColor"), EmissiveColor);
-            MID->SetVectorParameterValue(TEXT("Emissive Color"), EmissiveColor);
-            MID->SetScalarParameterValue(TEXT("EmissiveIntensity"), Intensity);
-            MID->SetScalarParameterValue(TEXT("Emissive Intensity"), Intensity);
-        }
-    }
+    WriteVectorParam(ERshipMaterialParam::EmissiveColor, EmissiveColor);
+    WriteScalarParam(ERshipMaterialParam::EmissiveIntensity, Intensity);
     OnEmissiveIntensityChanged.Broadcast(Intensity);
 }
 
@@ -300,16 +330,8 @@ void URshipMaterialController::SetEmissive(float R, float G, float B, float Inte
     FLinearColor EmissiveColor(R * Intensity * GlobalIntensityMultiplier,
                                 G * Intensity * GlobalIntensityMultiplier,
                                 B * Intensity * GlobalIntensityMultiplier);
-    for (UMaterialInstanceDynamic* MID : DynamicMaterials)
-    {
-        if (MID)
-        {
-            MID->SetVectorParameterValue(TEXT("EmissiveColor"), EmissiveColor);
-            MID->SetVectorParameterValue(TEXT("Emissive Color"), EmissiveColor);
-            MID->SetScalarParameterValue(TEXT("EmissiveIntensity"), Intensity);
-            MID->SetScalarParameterValue(TEXT("Emissive Intensity"), Intensity);
-        }
-    }
+    WriteVectorParam(ERshipMaterialParam::EmissiveColor, EmissiveColor);
+    WriteScalarParam(ERshipMaterialParam::EmissiveIntensity, Intensity);
     OnEmissiveColorChanged.Broadcast(R, G, B);
     OnEmissiveIntensityChanged.Broadcast(Intensity);
 }
@@ -317,94 +339,46 @@ void URshipMaterialController::SetEmissive(float R, float G, float B, float Inte
 void URshipMaterialController::SetRoughness(float Roughness)
 {
     LastRoughness = FMath::Clamp(Roughness, 0.0f, 1.0f);
-    for (UMaterialInstanceDynamic* MID : DynamicMaterials)
-    {
-        if (MID)
-        {
-            MID->SetScalarParameterValue(TEXT("Roughness"), LastRoughness);
-        }
-    }
+    WriteScalarParam(ERshipMaterialParam::Roughness, LastRoughness);
     OnRoughnessChanged.Broadcast(LastRoughness);
 }
 
 void URshipMaterialController::SetMetallic(float Metallic)
 {
     LastMetallic = FMath::Clamp(Metallic, 0.0f, 1.0f);
-    for (UMaterialInstanceDynamic* MID : DynamicMaterials)
-    {
-        if (MID)
-        {
-            MID->SetScalarParameterValue(TEXT("Metallic"), LastMetallic);
-        }
-    }
+    WriteScalarParam(ERshipMaterialParam::Metallic, LastMetallic);
     OnMetallicChanged.Broadcast(LastMetallic);
 }
 
 void URshipMaterialController::SetSpecular(float Specular)
 {
     LastSpecular = FMath::Clamp(Specular, 0.0f, 1.0f);
-    for (UMaterialInstanceDynamic* MID : DynamicMaterials)
-    {
-        if (MID)
-        {
-            MID->SetScalarParameterValue(TEXT("Specular"), LastSpecular);
-        }
-    }
+    WriteScalarParam(ERshipMaterialParam::Specular, LastSpecular);
     OnSpecularChanged.Broadcast(LastSpecular);
 }
 
 void URshipMaterialController::SetOpacity(float Opacity)
 {
     LastOpacity = FMath::Clamp(Opacity, 0.0f, 1.0f);
-    for (UMaterialInstanceDynamic* MID : DynamicMaterials)
-    {
-        if (MID)
-        {
-            MID->SetScalarParameterValue(TEXT("Opacity"), LastOpacity);
-        }
-    }
+    WriteScalarParam(ERshipMaterialParam::Opacity, LastOpacity);
     OnOpacityChanged.Broadcast(LastOpacity);
 }
 
 void URshipMaterialController::SetOpacityMask(float Threshold)
 {
     float ClampedThreshold = FMath::Clamp(Threshold, 0.0f, 1.0f);
-    for (UMaterialInstanceDynamic* MID : DynamicMaterials)
-    {
-        if (MID)
-        {
-            MID->SetScalarParameterValue(TEXT("OpacityMask"), ClampedThreshold);
-            MID->SetScalarParameterValue(TEXT("Opacity Mask"), ClampedThreshold);
-            MID->SetScalarParameterValue(TEXT("OpacityMaskClipValue"), ClampedThreshold);
-        }
-    }
+    WriteScalarParam(ERshipMaterialParam::OpacityMask, ClampedThreshold);
 }
 
 void URshipMaterialController::SetAmbientOcclusion(float AO)
 {
     float ClampedAO = FMath::Clamp(AO, 0.0f, 1.0f);
-    for (UMaterialInstanceDynamic* MID : DynamicMaterials)
-    {
-        if (MID)
-        {
-            MID->SetScalarParameterValue(TEXT("AmbientOcclusion"), ClampedAO);
-            MID->SetScalarParameterValue(TEXT("Ambient Occlusion"), ClampedAO);
-            MID->SetScalarParameterValue(TEXT("AO"), ClampedAO);
-        }
-    }
+    WriteScalarParam(ERshipMaterialParam::AmbientOcclusion, ClampedAO);
 }
 
 void URshipMaterialController::SetNormalIntensity(float Intensity)
 {
-    for (UMaterialInstanceDynamic* MID : DynamicMaterials)
-    {
-        if (MID)
-        {
-            MID->SetScalarParameterValue(TEXT("NormalIntensity"), Intensity);
-            MID->SetScalarParameterValue(TEXT("Normal Intensity"), Intensity);
-            MID->SetScalarParameterValue(TEXT("NormalStrength"), Intensity);
-        }
-    }
+    WriteScalarParam(ERshipMaterialParam::NormalIntensity, Intensity);
 }
 
 // ============================================================================
@@ -413,54 +387,26 @@ void URshipMaterialController::SetNormalIntensity(float Intensity)
 
 void URshipMaterialController::SetUVTiling(float TileU, float TileV)
 {
-    for (UMaterialInstanceDynamic* MID : DynamicMaterials)
-    {
-        if (MID)
-        {
-            MID->SetScalarParameterValue(TEXT("TilingU"), TileU);
-            MID->SetScalarParameterValue(TEXT("TilingV"), TileV);
-            MID->SetVectorParameterValue(TEXT("UVTiling"), FLinearColor(TileU, TileV, 0.0f, 0.0f));
-            MID->SetVectorParameterValue(TEXT("UV Tiling"), FLinearColor(TileU, TileV, 0.0f, 0.0f));
-        }
-    }
+    WriteScalarParam(ERshipMaterialParam::TilingU, TileU);
+    WriteScalarParam(ERshipMaterialParam::TilingV, TileV);
+    WriteVectorParam(ERshipMaterialParam::UVTiling, FLinearColor(TileU, TileV, 0.0f, 0.0f));
 }
 
 void URshipMaterialController::SetUVOffset(float OffsetU, float OffsetV)
 {
-    for (UMaterialInstanceDynamic* MID : DynamicMaterials)
-    {
-        if (MID)
-        {
-            MID->SetScalarParameterValue(TEXT("OffsetU"), OffsetU);
-            MID->SetScalarParameterValue(TEXT("OffsetV"), OffsetV);
-            MID->SetVectorParameterValue(TEXT("UVOffset"), FLinearColor(OffsetU, OffsetV, 0.0f, 0.0f));
-            MID->SetVectorParameterValue(TEXT("UV Offset"), FLinearColor(OffsetU, OffsetV, 0.0f, 0.0f));
-        }
-    }
+    WriteScalarParam(ERshipMaterialParam::OffsetU, OffsetU);
+    WriteScalarParam(ERshipMaterialParam::OffsetV, OffsetV);
+    WriteVectorParam(ERshipMaterialParam::UVOffset, FLinearColor(OffsetU, OffsetV, 0.0f, 0.0f));
 }
 
 void URshipMaterialController::SetUVRotation(float Degrees)
 {
-    for (UMaterialInstanceDynamic* MID : DynamicMaterials)
-    {
-        if (MID)
-        {
-            MID->SetScalarParameterValue(TEXT("UVRotation"), Degrees);
-            MID->SetScalarParameterValue(TEXT("UV Rotation"), Degrees);
-        }
-    }
+    WriteScalarParam(ERshipMaterialParam::UVRotation, Degrees);
 }
 
 void URshipMaterialController::SetUVPivot(float PivotU, float PivotV)
 {
-    for (UMaterialInstanceDynamic* MID : DynamicMaterials)
-    {
-        if (MID)
-        {
-            MID->SetVectorParameterValue(TEXT("UVPivot"), FLinearColor(PivotU, PivotV, 0.0f, 0.0f));
-            MID->SetVectorParameterValue(TEXT("UV Pivot"), FLinearColor(PivotU, PivotV, 0.0f, 0.0f));
-        }
-    }
+    WriteVectorParam(ERshipMaterialParam::UVPivot, FLinearColor(PivotU, PivotV, 0.0f, 0.0f));
 }
 
 // ============================================================================
@@ -470,68 +416,29 @@ void URshipMaterialController::SetUVPivot(float PivotU, float PivotV)
 void URshipMaterialController::SetSubsurfaceColor(float R, float G, float B)
 {
     FLinearColor Color(R, G, B);
-    for (UMaterialInstanceDynamic* MID : DynamicMaterials)
-    {
-        if (MID)
-        {
-            MID->SetVectorParameterValue(TEXT("SubsurfaceColor"), Color);
-            MID->SetVectorParameterValue(TEXT("Subsurface Color"), Color);
-        }
-    }
+    WriteVectorParam(ERshipMaterialParam::SubsurfaceColor, Color);
 }
 
 void URshipMaterialController::SetSubsurfaceIntensity(float Intensity)
 {
-    for (UMaterialInstanceDynamic* MID : DynamicMaterials)
-    {
-        if (MID)
-        {
-            MID->SetScalarParameterValue(TEXT("SubsurfaceIntensity"), Intensity);
-            MID->SetScalarParameterValue(TEXT("Subsurface Intensity"), Intensity);
-            MID->SetScalarParameterValue(TEXT("Subsurface"), Intensity);
-        }
-    }
+    WriteScalarParam(ERshipMaterialParam::SubsurfaceIntensity, Intensity);
 }
 
 void URshipMaterialController::SetSheenColor(float R, float G, float B)
 {
     FLinearColor Color(R, G, B);
-    for (UMaterialInstanceDynamic* MID : DynamicMaterials)
-    {
-        if (MID)
-        {
-            MID->SetVectorParameterValue(TEXT("SheenColor"), Color);
-            MID->SetVectorParameterValue(TEXT("Sheen Color"), Color);
-            MID->SetVectorParameterValue(TEXT("ClothColor"), Color);
-            MID->SetVectorParameterValue(TEXT("Fuzz Color"), Color);
-        }
-    }
+    WriteVectorParam(ERshipMaterialParam::SheenColor, Color);
 }
 
 void URshipMaterialController::SetClearCoat(float Intensity)
 {
-    for (UMaterialInstanceDynamic* MID : DynamicMaterials)
-    {
-        if (MID)
-        {
-            MID->SetScalarParameterValue(TEXT("ClearCoat"), Intensity);
-            MID->SetScalarParameterValue(TEXT("Clear Coat"), Intensity);
-            MID->SetScalarParameterValue(TEXT("ClearCoatIntensity"), Intensity);
-        }
-    }
+    WriteScalarParam(ERshipMaterialParam::ClearCoat, Intensity);
 }
 
 void URshipMaterialController::SetClearCoatRoughness(float Roughness)
 {
     float ClampedRoughness = FMath::Clamp(Roughness, 0.0f, 1.0f);
-    for (UMaterialInstanceDynamic* MID : DynamicMaterials)
-    {
-        if (MID)
-        {
-            MID->SetScalarParameterValue(TEXT("ClearCoatRoughness"), ClampedRoughness);
-            MID->SetScalarParameterValue(TEXT("Clear Coat Roughness"), ClampedRoughness);
-        }
-    }
+    WriteScalarParam(ERshipMaterialParam::ClearCoatRoughness, ClampedRoughness);
 }
 
 // ============================================================================
@@ -587,7 +494,13 @@ void URshipMaterialController::BlendToDefaults(float Alpha)
 
 void URshipMaterialController::ForcePublish()
 {
-    ReadAndPublishState();
+    FRshipPublishBatch Batch;
+    GatherPublishState(Batch);
+
+    if (URshipSubsystem* Subsystem = ResolveRshipSubsystem())
+    {
+        Subsystem->PulseEmitterBatch(Batch);
+    }
 }
 
 FString URshipMaterialController::GetMaterialStateJson() const
@@ -621,14 +534,19 @@ FString URshipMaterialController::GetMaterialStateJson() const
     return OutputString;
 }
 
-void URshipMaterialController::ReadAndPublishState()
+void URshipMaterialController::GatherPublishState(FRshipPublishBatch& Batch)
 {
+    static const TCHAR* const RGB[] = { TEXT("R"), TEXT("G"), TEXT("B") };
+
     // Try to read current values from the first dynamic material
     if (DynamicMaterials.Num() == 0) return;
 
     UMaterialInstanceDynamic* MID = DynamicMaterials[0];
     if (!MID) return;
 
+    // Local delegates still fire without a target; only the pulses need one
+    const bool bHasSource = Batch.BeginSource(PublishTargetId);
+
     FLinearColor BaseColor;
     if (MID->GetVectorParameterValue(TEXT("BaseColor"), BaseColor) ||
         MID->GetVectorParameterValue(TEXT("Base Color"), BaseColor))
@@ -637,6 +555,7 @@ void URshipMaterialController::ReadAndPublishState()
         {
             LastBaseColor = BaseColor;
             OnBaseColorChanged.Broadcast(BaseColor.R, BaseColor.G, BaseColor.B);
+            if (bHasSource) Batch.AddColor(TEXT("onBaseColorChanged"), RGB, BaseColor);
         }
     }
 
@@ -648,6 +567,7 @@ void URshipMaterialController::ReadAndPublishState()
         {
             LastEmissiveColor = EmissiveColor;
             OnEmissiveColorChanged.Broadcast(EmissiveColor.R, EmissiveColor.G, EmissiveColor.B);
+            if (bHasSource) Batch.AddColor(TEXT("onEmissiveColorChanged"), RGB, EmissiveColor);
         }
     }
 
@@ -658,6 +578,7 @@ void URshipMaterialController::ReadAndPublishState()
         {
             LastRoughness = Roughness;
             OnRoughnessChanged.Broadcast(Roughness);
+            if (bHasSource) Batch.AddValue(TEXT("onRoughnessChanged"), TEXT("Value"), Roughness);
         }
     }
 
@@ -668,6 +589,7 @@ void URshipMaterialController::ReadAndPublishState()
         {
             LastMetallic = Metallic;
             OnMetallicChanged.Broadcast(Metallic);
+            if (bHasSource) Batch.AddValue(TEXT("onMetallicChanged"), TEXT("Value"), Metallic);
         }
     }
 
@@ -678,6 +600,7 @@ void URshipMaterialController::ReadAndPublishState()
         {
             LastSpecular = Specular;
             OnSpecularChanged.Broadcast(Specular);
+            if (bHasSource) Batch.AddValue(TEXT("onSpecularChanged"), TEXT("Value"), Specular);
         }
     }
 
@@ -688,6 +611,7 @@ void URshipMaterialController::ReadAndPublishState()
         {
             LastOpacity = Opacity;
             OnOpacityChanged.Broadcast(Opacity);
+            if (bHasSource) Batch.AddValue(TEXT("onOpacityChanged"), TEXT("Value"), Opacity);
         }
     }
 }
@@ -0,0 +1,301 @@
+// Rship Material Parameter Cache Implementation
+
+#include "Controllers/RshipMaterialParameterCache.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+namespace
+{
+    struct FRshipMaterialParamAliases
+    {
+        bool bVector = false;
+        TArray<FName, TInlineAllocator<4>> Names;
+    };
+
+    const FRshipMaterialParamAliases& GetAliasEntry(ERshipMaterialParam Param)
+    {
+        // Order must match ERshipMaterialParam
+        static const FRshipMaterialParamAliases Table[] = {
+            { true,  { TEXT("BaseColor"), TEXT("Base Color") } },
+            { true,  { TEXT("EmissiveColor"), TEXT("Emissive Color") } },
+            { true,  { TEXT("UVTiling"), TEXT("UV Tiling") } },
+            { true,  { TEXT("UVOffset"), TEXT("UV Offset") } },
+            { true,  { TEXT("UVPivot"), TEXT("UV Pivot") } },
+            { true,  { TEXT("SubsurfaceColor"), TEXT("Subsurface Color") } },
+            { true,  { TEXT("SheenColor"), TEXT("Sheen Color"), TEXT("ClothColor"), TEXT("Fuzz Color") } },
+
+            { false, { TEXT("EmissiveIntensity"), TEXT("Emissive Intensity") } },
+            { false, { TEXT("Roughness") } },
+            { false, { TEXT("Metallic") } },
+            { false, { TEXT("Specular") } },
+            { false, { TEXT("Opacity") } },
+            { false, { TEXT("OpacityMask"), TEXT("Opacity Mask"), TEXT("OpacityMaskClipValue") } },
+            { false, { TEXT("AmbientOcclusion"), TEXT("Ambient Occlusion"), TEXT("AO") } },
+            { false, { TEXT("NormalIntensity"), TEXT("Normal Intensity"), TEXT("NormalStrength") } },
+            { false, { TEXT("TilingU") } },
+            { false, { TEXT("TilingV") } },
+            { false, { TEXT("OffsetU") } },
+            { false, { TEXT("OffsetV") } },
+            { false, { TEXT("UVRotation"), TEXT("UV Rotation") } },
+            { false, { TEXT("SubsurfaceIntensity"), TEXT("Subsurface Intensity"), TEXT("Subsurface") } },
+            { false, { TEXT("ClearCoat"), TEXT("Clear Coat"), TEXT("ClearCoatIntensity") } },
+            { false, { TEXT("ClearCoatRoughness"), TEXT("Clear Coat Roughness") } },
+        };
+        static_assert(UE_ARRAY_COUNT(Table) == static_cast<int32>(ERshipMaterialParam::Count), "Alias table out of sync with ERshipMaterialParam");
+
+        return Table[static_cast<int32>(Param)];
+    }
+}
+
+TConstArrayView<FName> FRshipMaterialParameterCache::GetAliases(ERshipMaterialParam Param)
+{
+    return GetAliasEntry(Param).Names;
+}
+
+bool FRshipMaterialParameterCache::IsVectorParam(ERshipMaterialParam Param)
+{
+    return GetAliasEntry(Param).bVector;
+}
+
+void FRshipMaterialParameterCache::WriteScalarUncached(UMaterialInstanceDynamic* MID, ERshipMaterialParam Param, float Value)
+{
+    if (!MID) return;
+
+    for (const FName& Alias : GetAliases(Param))
+    {
+        MID->SetScalarParameterValue(Alias, Value);
+    }
+}
+
+void FRshipMaterialParameterCache::WriteVectorUncached(UMaterialInstanceDynamic* MID, ERshipMaterialParam Param, const FLinearColor& Value)
+{
+    if (!MID) return;
+
+    for (const FName& Alias : GetAliases(Param))
+    {
+        MID->SetVectorParameterValue(Alias, Value);
+    }
+}
+
+void FRshipMaterialParameterCache::Invalidate()
+{
+    Parent.Reset();
+    Bindings.Reset();
+    for (FRange& Range : Ranges)
+    {
+        Range = FRange();
+    }
+    ScalarNames.Reset();
+    VectorNames.Reset();
+    ScalarIndexByName.Reset();
+    VectorIndexByName.Reset();
+    bBuilt = false;
+}
+
+bool FRshipMaterialParameterCache::IsValidFor(const UMaterialInstanceDynamic* MID) const
+{
+    return bBuilt && MID && Parent.Get() == MID->Parent;
+}
+
+void FRshipMaterialParameterCache::Build(UMaterialInstanceDynamic* MID)
+{
+    Invalidate();
+    if (!MID) return;
+
+    Parent = MID->Parent;
+
+    // Enumerate what the material actually exposes so absent aliases never reach the MID
+    TArray<FMaterialParameterInfo> Infos;
+    TArray<FGuid> Ids;
+
+    MID->GetAllScalarParameterInfo(Infos, Ids);
+    for (const FMaterialParameterInfo& Info : Infos)
+    {
+        if (Info.Association == EMaterialParameterAssociation::GlobalParameter)
+        {
+            ScalarNames.Add(Info.Name);
+        }
+    }
+
+    Infos.Reset();
+    Ids.Reset();
+    MID->GetAllVectorParameterInfo(Infos, Ids);
+    for (const FMaterialParameterInfo& Info : Infos)
+    {
+        if (Info.Association == EMaterialParameterAssociation::GlobalParameter)
+        {
+            VectorNames.Add(Info.Name);
+        }
+    }
+
+    // Lay out bindings so each logical parameter owns a contiguous range
+    for (int32 ParamIndex = 0; ParamIndex < static_cast<int32>(ERshipMaterialParam::Count); ++ParamIndex)
+    {
+        const ERshipMaterialParam Param = static_cast<ERshipMaterialParam>(ParamIndex);
+        const bool bVector = IsVectorParam(Param);
+
+        FRange& Range = Ranges[ParamIndex];
+        Range.Start = static_cast<uint16>(Bindings.Num());
+
+        for (const FName& Alias : GetAliases(Param))
+        {
+            const int32 SlotIndex = bVector ? ResolveVector(MID, Alias) : ResolveScalar(MID, Alias);
+            if (SlotIndex != INDEX_NONE)
+            {
+                FBinding& Binding = Bindings.AddDefaulted_GetRef();
+                Binding.Info = FMaterialParameterInfo(Alias);
+                Binding.Index = SlotIndex;
+            }
+        }
+
+        Range.Num = static_cast<uint16>(Bindings.Num() - Range.Start);
+    }
+
+    bBuilt = true;
+}
+
+void FRshipMaterialParameterCache::EnsureBuilt(UMaterialInstanceDynamic* MID)
+{
+    if (!IsValidFor(MID))
+    {
+        Build(MID);
+    }
+}
+
+int32 FRshipMaterialParameterCache::ResolveScalar(UMaterialInstanceDynamic* MID, FName ParameterName)
+{
+    if (const int32* Existing = ScalarIndexByName.Find(ParameterName))
+    {
+        return *Existing;
+    }
+
+    int32 SlotIndex = INDEX_NONE;
+    if (ScalarNames.Contains(ParameterName))
+    {
+        // Seed the override slot with the current value so resolving has no visible effect
+        const FMaterialParameterInfo Info(ParameterName);
+        float Current = 0.0f;
+        MID->GetScalarParameterValue(FHashedMaterialParameterInfo(Info), Current);
+        if (!MID->InitializeScalarParameterAndGetIndex(ParameterName, Current, SlotIndex))
+        {
+            SlotIndex = INDEX_NONE;
+        }
+    }
+
+    ScalarIndexByName.Add(ParameterName, SlotIndex);
+    return SlotIndex;
+}
+
+int32 FRshipMaterialParameterCache::ResolveVector(UMaterialInstanceDynamic* MID, FName ParameterName)
+{
+    if (const int32* Existing = VectorIndexByName.Find(ParameterName))
+    {
+        return *Existing;
+    }
+
+    int32 SlotIndex = INDEX_NONE;
+    if (VectorNames.Contains(ParameterName))
+    {
+        const FMaterialParameterInfo Info(ParameterName);
+        FLinearColor Current = FLinearColor::Black;
+        MID->GetVectorParameterValue(FHashedMaterialParameterInfo(Info), Current);
+        if (!MID->InitializeVectorParameterAndGetIndex(ParameterName, Current, SlotIndex))
+        {
+            SlotIndex = INDEX_NONE;
+        }
+    }
+
+    VectorIndexByName.Add(ParameterName, SlotIndex);
+    return SlotIndex;
+}
+
+int32 FRshipMaterialParameterCache::WriteScalar(UMaterialInstanceDynamic* MID, ERshipMaterialParam Param, float Value)
+{
+    if (!MID) return 0;
+    EnsureBuilt(MID);
+
+    const FRange Range = Ranges[static_cast<int32>(Param)];
+    bool bStale = false;
+    for (int32 i = Range.Start; i < Range.Start + Range.Num; ++i)
+    {
+        const FBinding& Binding = Bindings[i];
+        if (!MID->SetScalarParameterByIndex(Binding.Index, Value))
+        {
+            // Override array was reset underneath us; fall back to a named write this time
+            MID->SetScalarParameterValueByInfo(Binding.Info, Value);
+            bStale = true;
+        }
+    }
+
+    if (bStale)
+    {
+        Invalidate();
+    }
+    return Range.Num;
+}
+
+int32 FRshipMaterialParameterCache::WriteVector(UMaterialInstanceDynamic* MID, ERshipMaterialParam Param, const FLinearColor& Value)
+{
+    if (!MID) return 0;
+    EnsureBuilt(MID);
+
+    const FRange Range = Ranges[static_cast<int32>(Param)];
+    bool bStale = false;
+    for (int32 i = Range.Start; i < Range.Start + Range.Num; ++i)
+    {
+        const FBinding& Binding = Bindings[i];
+        if (!MID->SetVectorParameterByIndex(Binding.Index, Value))
+        {
+            MID->SetVectorParameterValueByInfo(Binding.Info, Value);
+            bStale = true;
+        }
+    }
+
+    if (bStale)
+    {
+        Invalidate();
+    }
+    return Range.Num;
+}
+
+int32 FRshipMaterialParameterCache::WriteScalarByName(UMaterialInstanceDynamic* MID, FName ParameterName, float Value)
+{
+    if (!MID) return 0;
+    EnsureBuilt(MID);
+
+    const int32 SlotIndex = ResolveScalar(MID, ParameterName);
+    if (SlotIndex == INDEX_NONE)
+    {
+        return 0;
+    }
+
+    if (!MID->SetScalarParameterByIndex(SlotIndex, Value))
+    {
+        MID->SetScalarParameterValue(ParameterName, Value);
+        Invalidate();
+    }
+    return 1;
+}
+
+int32 FRshipMaterialParameterCache::WriteVectorByName(UMaterialInstanceDynamic* MID, FName ParameterName, const FLinearColor& Value)
+{
+    if (!MID) return 0;
+    EnsureBuilt(MID);
+
+    const int32 SlotIndex = ResolveVector(MID, ParameterName);
+    if (SlotIndex == INDEX_NONE)
+    {
+        return 0;
+    }
+
+    if (!MID->SetVectorParameterByIndex(SlotIndex, Value))
+    {
+        MID->SetVectorParameterValue(ParameterName, Value);
+        Invalidate();
+    }
+    return 1;
+}
+
+int32 FRshipMaterialParameterCache::GetResolvedCount(ERshipMaterialParam Param) const
+{
+    return bBuilt ? Ranges[static_cast<int32>(Param)].Num : 0;
+}
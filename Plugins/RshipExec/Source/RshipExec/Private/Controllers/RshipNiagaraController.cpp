@@ -1,6 +1,8 @@
 // Rship Niagara VFX Controller Implementation
 
 #include "Controllers/RshipNiagaraController.h"
+#include "Controllers/RshipPublishScheduler.h"
+#include "RshipSubsystem.h"
 #include "Logs.h"
 #include "GameFramework/Actor.h"
 #include "NiagaraComponent.h"
@@ -14,8 +16,8 @@
 
 URshipNiagaraController::URshipNiagaraController()
 {
-    PrimaryComponentTick.bCanEverTick = true;
-    PrimaryComponentTick.TickInterval = 0.033f; // ~30Hz
+    // State publishing runs through URshipPublishScheduler instead of a component tick
+    PrimaryComponentTick.bCanEverTick = false;
 }
 
 void URshipNiagaraController::RegisterOrRefreshTarget()
@@ -25,6 +27,7 @@ void URshipNiagaraController::RegisterOrRefreshTarget()
     {
         return;
     }
+    PublishTargetId = Target.GetId();
 
     Target
         .AddAction(this, GET_FUNCTION_NAME_CHECKED(URshipNiagaraController, SetFloatParameter), TEXT("SetFloatParameter"))
@@ -93,8 +96,7 @@ void URshipNiagaraController::BeginPlay()
         return;
     }
 
-    PublishInterval = 1.0 / FMath::Max(1, PublishRateHz);
-    SetComponentTickEnabled(true);
+    SetPublishRate(PublishRateHz);
 
     UE_LOG(LogRshipExec, Log, TEXT("RshipNiagaraController: Initialized on %s"), *GetOwner()->GetName());
 
@@ -106,20 +108,6 @@ void URshipNiagaraController::EndPlay(const EEndPlayReason::Type EndPlayReason)
     Super::EndPlay(EndPlayReason);
 }
 
-void URshipNiagaraController::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
-{
-    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-    if (!NiagaraComponent) return;
-
-    double CurrentTime = FPlatformTime::Seconds();
-    if (CurrentTime - LastPublishTime >= PublishInterval)
-    {
-        ReadAndPublishState();
-        LastPublishTime = CurrentTime;
-    }
-}
-
 void URshipNiagaraController::SetColorValue(FName ParameterName, FLinearColor Color)
 {
     if (NiagaraComponent)
@@ -508,7 +496,13 @@ void URshipNiagaraController::SetScaleXYZ(float X, float Y, float Z)
 
 void URshipNiagaraController::ForcePublish()
 {
-    ReadAndPublishState();
+    FRshipPublishBatch Batch;
+    GatherPublishState(Batch);
+
+    if (URshipSubsystem* Subsystem = ResolveRshipSubsystem())
+    {
+        Subsystem->PulseEmitterBatch(Batch);
+    }
 }
 
 FString URshipNiagaraController::GetNiagaraStateJson() const
@@ -542,16 +536,22 @@ FString URshipNiagaraController::GetNiagaraStateJson() const
     return OutputString;
 }
 
-void URshipNiagaraController::ReadAndPublishState()
+void URshipNiagaraController::GatherPublishState(FRshipPublishBatch& Batch)
 {
+    static const TCHAR* const XYZ[] = { TEXT("X"), TEXT("Y"), TEXT("Z") };
+
     if (!NiagaraComponent) return;
 
+    // Local delegates still fire without a target; only the pulses need one
+    const bool bHasSource = Batch.BeginSource(PublishTargetId);
+
     // Check active state
     bool bCurrentActive = NiagaraComponent->IsActive();
     if (!bOnlyPublishOnChange || bCurrentActive != bLastActive)
     {
         bLastActive = bCurrentActive;
         OnActiveChanged.Broadcast(bCurrentActive);
+        if (bHasSource) Batch.AddBool(TEXT("onActiveChanged"), TEXT("Value"), bCurrentActive);
     }
 
     // Get transform from owner
@@ -563,6 +563,7 @@ void URshipNiagaraController::ReadAndPublishState()
         {
             LastLocation = CurrentLocation;
             OnLocationChanged.Broadcast(CurrentLocation.X, CurrentLocation.Y, CurrentLocation.Z);
+            if (bHasSource) Batch.AddVector(TEXT("onLocationChanged"), XYZ, CurrentLocation.X, CurrentLocation.Y, CurrentLocation.Z);
         }
 
         FRotator CurrentRotation = Owner->GetActorRotation();
@@ -570,6 +571,7 @@ void URshipNiagaraController::ReadAndPublishState()
         {
             LastRotation = CurrentRotation;
             OnRotationChanged.Broadcast(CurrentRotation.Pitch, CurrentRotation.Yaw, CurrentRotation.Roll);
+            if (bHasSource) Batch.AddVector(TEXT("onRotationChanged"), XYZ, CurrentRotation.Pitch, CurrentRotation.Yaw, CurrentRotation.Roll);
         }
     }
 }
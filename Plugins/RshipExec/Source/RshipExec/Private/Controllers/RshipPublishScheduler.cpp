@@ -0,0 +1,365 @@
+#include "Controllers/RshipPublishScheduler.h"
+
+#include "Controllers/RshipControllerComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "RshipSettings.h"
+#include "RshipSubsystem.h"
+
+// ============================================================================
+// FRshipPublishBatch
+// ============================================================================
+
+void FRshipPublishBatch::Reset()
+{
+	TargetIds.Reset();
+	Samples.Reset();
+}
+
+bool FRshipPublishBatch::BeginSource(const FString& TargetId)
+{
+	if (TargetId.IsEmpty())
+	{
+		return false;
+	}
+
+	TargetIds.Add(TargetId);
+	return true;
+}
+
+FRshipPublishSample& FRshipPublishBatch::AddSample(const TCHAR* EmitterName, ERshipPublishValueKind Kind)
+{
+	check(TargetIds.Num() > 0);
+
+	FRshipPublishSample& Sample = Samples.AddDefaulted_GetRef();
+	Sample.SourceIndex = TargetIds.Num() - 1;
+	Sample.EmitterName = EmitterName;
+	Sample.Kind = Kind;
+	return Sample;
+}
+
+void FRshipPublishBatch::AddValue(const TCHAR* EmitterName, const TCHAR* FieldName, double Value)
+{
+	FRshipPublishSample& Sample = AddSample(EmitterName, ERshipPublishValueKind::Number);
+	Sample.FieldNames[0] = FieldName;
+	Sample.Values[0] = Value;
+	Sample.NumValues = 1;
+}
+
+void FRshipPublishBatch::AddBool(const TCHAR* EmitterName, const TCHAR* FieldName, bool bValue)
+{
+	FRshipPublishSample& Sample = AddSample(EmitterName, ERshipPublishValueKind::Bool);
+	Sample.FieldNames[0] = FieldName;
+	Sample.Values[0] = bValue ? 1.0 : 0.0;
+	Sample.NumValues = 1;
+}
+
+void FRshipPublishBatch::AddVector(const TCHAR* EmitterName, const TCHAR* const (&FieldNames)[3], double X, double Y, double Z)
+{
+	FRshipPublishSample& Sample = AddSample(EmitterName, ERshipPublishValueKind::Number);
+	Sample.FieldNames[0] = FieldNames[0];
+	Sample.FieldNames[1] = FieldNames[1];
+	Sample.FieldNames[2] = FieldNames[2];
+	Sample.Values[0] = X;
+	Sample.Values[1] = Y;
+	Sample.Values[2] = Z;
+	Sample.NumValues = 3;
+}
+
+void FRshipPublishBatch::AddColor(const TCHAR* EmitterName, const TCHAR* const (&FieldNames)[3], const FLinearColor& Color)
+{
+	AddVector(EmitterName, FieldNames, Color.R, Color.G, Color.B);
+}
+
+// ============================================================================
+// FRshipPublishSchedule
+// ============================================================================
+
+int32 FRshipPublishSchedule::Add(double RateHz, double NowSeconds)
+{
+	int32 Handle;
+	if (FreeHandles.Num() > 0)
+	{
+		Handle = FreeHandles.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		Handle = Entries.AddDefaulted();
+	}
+
+	FEntry& Entry = Entries[Handle];
+	Entry.IntervalSeconds = 1.0 / FMath::Max(RateHz, UE_DOUBLE_SMALL_NUMBER);
+	Entry.bActive = true;
+	++Entry.Generation;
+
+	// Golden-ratio sequence: successive sources land as far apart as possible within the interval
+	constexpr double GoldenRatioFraction = 0.6180339887498949;
+	const double Phase = FMath::Frac(static_cast<double>(PhaseCounter++) * GoldenRatioFraction);
+	Entry.DueSeconds = NowSeconds + Entry.IntervalSeconds * Phase;
+
+	++NumActive;
+	Push(Handle);
+	return Handle;
+}
+
+void FRshipPublishSchedule::Remove(int32 Handle)
+{
+	if (!IsValidHandle(Handle))
+	{
+		return;
+	}
+
+	// Heap nodes for this handle become stale through the generation bump
+	FEntry& Entry = Entries[Handle];
+	Entry.bActive = false;
+	++Entry.Generation;
+	FreeHandles.Add(Handle);
+	--NumActive;
+}
+
+void FRshipPublishSchedule::SetRate(int32 Handle, double RateHz, double NowSeconds)
+{
+	if (!IsValidHandle(Handle))
+	{
+		return;
+	}
+
+	FEntry& Entry = Entries[Handle];
+	const double NewInterval = 1.0 / FMath::Max(RateHz, UE_DOUBLE_SMALL_NUMBER);
+	if (FMath::IsNearlyEqual(NewInterval, Entry.IntervalSeconds))
+	{
+		return;
+	}
+
+	// Keep the existing phase but never wait longer than one new interval
+	Entry.IntervalSeconds = NewInterval;
+	Entry.DueSeconds = FMath::Min(Entry.DueSeconds, NowSeconds + NewInterval);
+	++Entry.Generation;
+	Push(Handle);
+}
+
+bool FRshipPublishSchedule::IsValidHandle(int32 Handle) const
+{
+	return Entries.IsValidIndex(Handle) && Entries[Handle].bActive;
+}
+
+int32 FRshipPublishSchedule::NumDue(double NowSeconds) const
+{
+	// A heap node that is not due has no due descendants, so only due subtrees are walked
+	int32 Count = 0;
+	TArray<int32, TInlineAllocator<64>> Pending;
+	if (Heap.Num() > 0)
+	{
+		Pending.Add(0);
+	}
+	while (Pending.Num() > 0)
+	{
+		const int32 Index = Pending.Pop(EAllowShrinking::No);
+		const FHeapNode& Node = Heap[Index];
+		if (Node.DueSeconds > NowSeconds)
+		{
+			continue;
+		}
+
+		// Each active source has exactly one current node; the rest are stale
+		if (IsCurrent(Node))
+		{
+			++Count;
+		}
+		for (const int32 Child : { Index * 2 + 1, Index * 2 + 2 })
+		{
+			if (Child < Heap.Num())
+			{
+				Pending.Add(Child);
+			}
+		}
+	}
+	return Count;
+}
+
+void FRshipPublishSchedule::Push(int32 Handle)
+{
+	const FEntry& Entry = Entries[Handle];
+
+	FHeapNode Node;
+	Node.DueSeconds = Entry.DueSeconds;
+	Node.Handle = Handle;
+	Node.Generation = Entry.Generation;
+	Heap.HeapPush(Node);
+}
+
+void FRshipPublishSchedule::Reschedule(int32 Handle, double NowSeconds)
+{
+	FEntry& Entry = Entries[Handle];
+	Entry.DueSeconds += Entry.IntervalSeconds;
+
+	// After a stall, resume from now rather than publishing a burst of missed intervals
+	if (Entry.DueSeconds <= NowSeconds)
+	{
+		Entry.DueSeconds = NowSeconds + Entry.IntervalSeconds;
+	}
+	Push(Handle);
+}
+
+// ============================================================================
+// URshipPublishScheduler
+// ============================================================================
+
+void URshipPublishScheduler::Deinitialize()
+{
+	Schedule = FRshipPublishSchedule();
+	HandleByController.Empty();
+	ControllerByHandle.Empty();
+	Batch.Reset();
+
+	Super::Deinitialize();
+}
+
+bool URshipPublishScheduler::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Controllers only publish while playing, matching the component ticks this replaces
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+TStatId URshipPublishScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URshipPublishScheduler, STATGROUP_Tickables);
+}
+
+void URshipPublishScheduler::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Schedule.Num() > 0)
+	{
+		PublishFrame(FPlatformTime::Seconds());
+	}
+}
+
+void URshipPublishScheduler::RegisterController(URshipControllerComponent* Controller, double RateHz)
+{
+	if (!Controller)
+	{
+		return;
+	}
+
+	if (RateHz <= 0.0)
+	{
+		UnregisterController(Controller);
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (const int32* Existing = HandleByController.Find(Controller))
+	{
+		Schedule.SetRate(*Existing, RateHz, Now);
+		return;
+	}
+
+	const int32 Handle = Schedule.Add(RateHz, Now);
+	if (ControllerByHandle.Num() <= Handle)
+	{
+		ControllerByHandle.SetNum(Handle + 1);
+	}
+	ControllerByHandle[Handle] = Controller;
+	HandleByController.Add(Controller, Handle);
+}
+
+void URshipPublishScheduler::UnregisterController(URshipControllerComponent* Controller)
+{
+	int32 Handle = INDEX_NONE;
+	if (HandleByController.RemoveAndCopyValue(Controller, Handle))
+	{
+		Schedule.Remove(Handle);
+		ControllerByHandle[Handle].Reset();
+	}
+}
+
+double URshipPublishScheduler::GetBudgetMicroseconds() const
+{
+	if (BudgetOverrideMicroseconds > 0.0)
+	{
+		return BudgetOverrideMicroseconds;
+	}
+
+	const URshipSettings* Settings = GetDefault<URshipSettings>();
+	return Settings ? FMath::Max(1, Settings->ControllerPublishBudgetMicroseconds) : 1000.0;
+}
+
+void URshipPublishScheduler::PublishFrame(double NowSeconds)
+{
+	LastFrameStats = FRshipPublishFrameStats();
+	Batch.Reset();
+
+	const double BudgetMicroseconds = GetBudgetMicroseconds();
+	const double GatherStart = FPlatformTime::Seconds();
+
+	// Gather: typed samples only, no JSON. The budget covers gathering plus the
+	// predicted cost of serializing what has been gathered so far.
+	TArray<int32, TInlineAllocator<16>> StaleHandles;
+	LastFrameStats.Published = Schedule.Run(NowSeconds, [this, GatherStart, BudgetMicroseconds, &StaleHandles](int32 Handle)
+	{
+		if (Batch.TargetIds.Num() > 0)
+		{
+			const double ElapsedMicroseconds = (FPlatformTime::Seconds() - GatherStart) * 1e6;
+			const double PredictedMicroseconds = ElapsedMicroseconds + Batch.Samples.Num() * SerializeMicrosecondsPerSample;
+			if (PredictedMicroseconds >= BudgetMicroseconds)
+			{
+				return false;
+			}
+		}
+
+		URshipControllerComponent* Controller = ControllerByHandle[Handle].Get();
+		if (IsValid(Controller))
+		{
+			Controller->GatherPublishState(Batch);
+		}
+		else
+		{
+			StaleHandles.Add(Handle);
+		}
+		return true;
+	});
+
+	for (const int32 Handle : StaleHandles)
+	{
+		Schedule.Remove(Handle);
+		ControllerByHandle[Handle].Reset();
+	}
+	if (StaleHandles.Num() > 0)
+	{
+		for (auto It = HandleByController.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	const double SerializeStart = FPlatformTime::Seconds();
+	LastFrameStats.GatherMicroseconds = static_cast<float>((SerializeStart - GatherStart) * 1e6);
+	LastFrameStats.Published -= StaleHandles.Num();
+	LastFrameStats.Deferred = Schedule.NumDue(NowSeconds);
+	LastFrameStats.Samples = Batch.Samples.Num();
+
+	if (Batch.Samples.Num() == 0)
+	{
+		return;
+	}
+
+	// Serialize: one pass, one event batch for the whole frame
+	if (URshipSubsystem* Subsystem = GEngine ? GEngine->GetEngineSubsystem<URshipSubsystem>() : nullptr)
+	{
+		Subsystem->PulseEmitterBatch(Batch);
+	}
+
+	const double SerializeMicroseconds = (FPlatformTime::Seconds() - SerializeStart) * 1e6;
+	LastFrameStats.SerializeMicroseconds = static_cast<float>(SerializeMicroseconds);
+
+	// Smoothed per-sample cost feeds the next frame's budget prediction
+	const double PerSample = SerializeMicroseconds / Batch.Samples.Num();
+	SerializeMicrosecondsPerSample = FMath::Lerp(SerializeMicrosecondsPerSample, PerSample, 0.2);
+}
@@ -5,10 +5,12 @@
 #include "IControlRigObjectBinding.h"
 #include "GameFramework/Actor.h"
 #include "Logs.h"
+#include "Misc/ScopeExit.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Animation/AnimInstance.h"
 #include "AnimNode_ControlRigBase.h"
 #include "Rigs/RigHierarchy.h"
+#include "Rigs/RigHierarchyCache.h"
 #include "Rigs/RigHierarchyController.h"
 #include "Rigs/RigHierarchyElements.h"
 
@@ -129,7 +131,10 @@ URshipRigController::URshipRigController()
 void URshipRigController::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-	LastTickDeltaTime = DeltaTime;
+	LastTickDeltaTime.store(DeltaTime, std::memory_order_relaxed);
+
+	// One snapshot per frame, however many overrides the frame's actions changed
+	PublishOverrides();
 }
 
 void URshipRigController::OnBeforeRegisterRshipTargets()
@@ -160,6 +165,16 @@ void URshipRigController::ConfigureControlRigComponent()
 		return;
 	}
 
+	// Tick first so this frame's overrides are published before the rig evaluates
+	if (SkeletalMeshComponent)
+	{
+		SkeletalMeshComponent->PrimaryComponentTick.AddPrerequisite(this, PrimaryComponentTick);
+	}
+	if (RigComponent)
+	{
+		RigComponent->PrimaryComponentTick.AddPrerequisite(this, PrimaryComponentTick);
+	}
+
 	const bool bRigChanged = !CachedControlRig.IsValid() || CachedControlRig.Get() != CurrentRig;
 	if (bRigChanged)
 	{
@@ -425,15 +440,8 @@ void URshipRigController::RegisterOrRefreshTarget()
 
 void URshipRigController::RotateElementInSocket(const FName& ElementName, ERigElementType ElementType, const FRotator& Rotation)
 {
-	FScopeLock Lock(&RigStateMutex);
-	if (ElementType == ERigElementType::Control)
-	{
-		ControlRotationOverrides.Add(ElementName, Rotation.Quaternion());
-	}
-	else
-	{
-		BoneRotationOverrides.Add(ElementName, Rotation.Quaternion());
-	}
+	const ERigElementType KeyType = ElementType == ERigElementType::Control ? ERigElementType::Control : ERigElementType::Bone;
+	SetRotationOverride(FRigElementKey(ElementName, KeyType), Rotation.Quaternion());
 	UE_LOG(LogRshipExec, Verbose, TEXT("RotateBoneInSocket queued: element=%s type=%d rot=%s"),
 		*ElementName.ToString(),
 		static_cast<int32>(ElementType),
@@ -485,44 +493,16 @@ void URshipRigController::AttachBoneToParent(const FName& BoneName, const FName&
 	NewTarget.ParentElement = ParentKey;
 	NewTarget.LocalOffset = ChildDesiredGlobal.GetRelativeTransform(ParentDesiredGlobal);
 
-	{
-		FScopeLock Lock(&RigStateMutex);
-		FRshipRigAttachState& State = BoneAttachStates.FindOrAdd(BoneName);
-		const bool bAlreadyAttachedToParent =
-			!State.bBlendActive &&
-			State.Active.Mode == FRshipRigAttachTarget::EMode::ParentRelative &&
-			State.Active.ParentElement == ParentKey;
-		const bool bAlreadyBlendingToParent =
-			State.bBlendActive &&
-			State.BlendTo.Mode == FRshipRigAttachTarget::EMode::ParentRelative &&
-			State.BlendTo.ParentElement == ParentKey;
-		if (bAlreadyAttachedToParent || bAlreadyBlendingToParent)
-		{
-			return;
-		}
-
-		if (State.Active.ParentElement.IsValid() && State.Active.ParentElement != ParentKey)
-		{
-			State.BlendFrom = State.Active;
-			State.BlendTo = NewTarget;
-			State.BlendAlpha = 0.0f;
-			State.BlendDuration = FMath::Max(EffectiveBlendSeconds, 0.0f);
-			State.bBlendActive = State.BlendDuration > KINDA_SMALL_NUMBER;
-
-			if (!State.bBlendActive)
-			{
-				State.Active = NewTarget;
-			}
-		}
-		else
-		{
-			State.Active = NewTarget;
-			State.bBlendActive = false;
-		}
-	}
+	// The evaluation thread owns attach state; it applies the transition on its next run
+	FRshipRigAttachCommand Command;
+	Command.Type = FRshipRigAttachCommand::EType::Attach;
+	Command.BoneName = BoneName;
+	Command.Target = NewTarget;
+	Command.BlendSeconds = EffectiveBlendSeconds;
+	PendingAttachCommands.Enqueue(MoveTemp(Command));
 
 	UE_LOG(LogRshipExec, Verbose,
-		TEXT("AttachBoneToParent set constraint: child=%s parent=%s blend=%.3fs parentLoc=%s parentRot=%s childLoc=%s childRot=%s"),
+		TEXT("AttachBoneToParent queued constraint: child=%s parent=%s blend=%.3fs parentLoc=%s parentRot=%s childLoc=%s childRot=%s"),
 		*BoneName.ToString(),
 		*ParentKey.Name.ToString(),
 		EffectiveBlendSeconds,
@@ -534,95 +514,12 @@ void URshipRigController::AttachBoneToParent(const FName& BoneName, const FName&
 
 void URshipRigController::RemoveBoneConstraints(const FName& BoneName, float BlendSeconds)
 {
-	FScopeLock Lock(&RigStateMutex);
-	FRshipRigAttachState* ExistingState = BoneAttachStates.Find(BoneName);
-	if (!ExistingState)
-	{
-		return;
-	}
-
-	const float EffectiveBlendSeconds = FMath::Max(BlendSeconds, 0.0f);
-	if (EffectiveBlendSeconds <= KINDA_SMALL_NUMBER)
-	{
-		BoneAttachStates.Remove(BoneName);
-		return;
-	}
-
-	URigHierarchy* Hierarchy = ResolveRigHierarchy();
-	if (!Hierarchy)
-	{
-		return;
-	}
-
-	const FRigElementKey ChildKey(BoneName, ERigElementType::Bone);
-	if (!Hierarchy->Contains(ChildKey))
-	{
-		BoneAttachStates.Remove(BoneName);
-		return;
-	}
-
-	auto EvaluateTargetAtRemoval = [Hierarchy, ChildKey](const FRshipRigAttachTarget& Target, FTransform& OutChildGlobal) -> bool
-	{
-		if (Target.Mode == FRshipRigAttachTarget::EMode::WorldSpace)
-		{
-			OutChildGlobal = Target.WorldTransform;
-			return true;
-		}
-
-		if (Target.Mode == FRshipRigAttachTarget::EMode::UnconstrainedPose)
-		{
-			OutChildGlobal = Hierarchy->GetGlobalTransform(ChildKey, false);
-			return true;
-		}
-
-		if (!Target.ParentElement.IsValid())
-		{
-			return false;
-		}
-
-		const FRigElementKey ParentKey = Target.ParentElement;
-		if (!Hierarchy->Contains(ParentKey))
-		{
-			return false;
-		}
-
-		const FTransform ParentGlobal = Hierarchy->GetGlobalTransform(ParentKey, false);
-		OutChildGlobal = Target.LocalOffset * ParentGlobal;
-		return true;
-	};
-
-	FTransform CurrentConstrainedGlobal = Hierarchy->GetGlobalTransform(ChildKey, false);
-	if (ExistingState->bBlendActive)
-	{
-		FTransform FromGlobal = FTransform::Identity;
-		FTransform ToGlobal = FTransform::Identity;
-		if (EvaluateTargetAtRemoval(ExistingState->BlendFrom, FromGlobal) && EvaluateTargetAtRemoval(ExistingState->BlendTo, ToGlobal))
-		{
-			CurrentConstrainedGlobal = BlendTransforms(FromGlobal, ToGlobal, ExistingState->BlendAlpha);
-		}
-	}
-	else
-	{
-		FTransform ActiveGlobal = FTransform::Identity;
-		if (EvaluateTargetAtRemoval(ExistingState->Active, ActiveGlobal))
-		{
-			CurrentConstrainedGlobal = ActiveGlobal;
-		}
-	}
-
-	FRshipRigAttachTarget BlendFromTarget;
-	BlendFromTarget.Mode = FRshipRigAttachTarget::EMode::WorldSpace;
-	BlendFromTarget.WorldTransform = CurrentConstrainedGlobal;
-
-	FRshipRigAttachTarget BlendToTarget;
-	BlendToTarget.Mode = FRshipRigAttachTarget::EMode::UnconstrainedPose;
-
-	ExistingState->BlendFrom = BlendFromTarget;
-	ExistingState->BlendTo = BlendToTarget;
-	ExistingState->BlendAlpha = 0.0f;
-	ExistingState->BlendDuration = EffectiveBlendSeconds;
-	ExistingState->bBlendActive = true;
-	ExistingState->Active = BlendToTarget;
+	// The blend-out start pose depends on solver state, so it is resolved during evaluation
+	FRshipRigAttachCommand Command;
+	Command.Type = FRshipRigAttachCommand::EType::Remove;
+	Command.BoneName = BoneName;
+	Command.BlendSeconds = FMath::Max(BlendSeconds, 0.0f);
+	PendingAttachCommands.Enqueue(MoveTemp(Command));
 }
 
 void URshipRigController::ResetBoneToInitialWorld(const FName& BoneName)
@@ -640,16 +537,19 @@ void URshipRigController::ResetBoneToInitialWorld(const FName& BoneName)
 		return;
 	}
 
+	ClearRotationOverride(BoneName);
 	{
-		FScopeLock Lock(&RigStateMutex);
-		BoneRotationOverrides.Remove(BoneName);
-		ControlRotationOverrides.Remove(BoneName);
-		BoneAttachStates.Remove(BoneName);
+		FRshipRigAttachCommand Command;
+		Command.Type = FRshipRigAttachCommand::EType::Clear;
+		Command.BoneName = BoneName;
+		PendingAttachCommands.Enqueue(MoveTemp(Command));
 	}
 
 	const FTransform InitialGlobal = Hierarchy->GetGlobalTransform(BoneKey, true);
 	Hierarchy->SetGlobalTransform(BoneKey, InitialGlobal, false, true, false);
 
+	// The rig updates right away, so the cleared override can't wait for the tick
+	PublishOverrides();
 	if (UControlRigComponent* RigComponent = ResolveControlRigComponent())
 	{
 		if (RigComponent->CanExecute())
@@ -676,11 +576,11 @@ void URshipRigController::ResetAllBonesToInitialWorld()
 		return;
 	}
 
+	ClearAllRotationOverrides();
 	{
-		FScopeLock Lock(&RigStateMutex);
-		BoneRotationOverrides.Reset();
-		ControlRotationOverrides.Reset();
-		BoneAttachStates.Reset();
+		FRshipRigAttachCommand Command;
+		Command.Type = FRshipRigAttachCommand::EType::ClearAll;
+		PendingAttachCommands.Enqueue(MoveTemp(Command));
 	}
 
 	int32 ResetCount = 0;
@@ -704,6 +604,7 @@ void URshipRigController::ResetAllBonesToInitialWorld()
 		++ResetCount;
 	}
 
+	PublishOverrides();
 	if (UControlRigComponent* RigComponent = ResolveControlRigComponent())
 	{
 		if (RigComponent->CanExecute())
@@ -860,134 +761,295 @@ URshipRigController* URshipRigController::FindForControlRig(const UControlRig* I
 	return nullptr;
 }
 
-void URshipRigController::CopyPendingRigState(
-	TMap<FName, FQuat>& OutBoneRotations,
-	TMap<FName, FQuat>& OutControlRotations,
-	TMap<FName, FRshipRigAttachState>& OutAttachStates,
-	float& OutDeltaTime)
+
+void URshipRigController::SetRotationOverride(const FRigElementKey& Key, const FQuat& Rotation)
 {
-	FScopeLock Lock(&RigStateMutex);
-	OutBoneRotations = BoneRotationOverrides;
-	OutControlRotations = ControlRotationOverrides;
-	OutAttachStates = BoneAttachStates;
-	OutDeltaTime = LastTickDeltaTime;
+	int32* SlotIndex = OverrideSlotByKey.Find(Key);
+	if (!SlotIndex)
+	{
+		// Slots are append-only so cached rig elements on the evaluation side stay addressable
+		const int32 NewIndex = GameThreadOverrides.Slots.AddDefaulted();
+		GameThreadOverrides.Slots[NewIndex].Key = Key;
+		++GameThreadOverrides.LayoutVersion;
+		SlotIndex = &OverrideSlotByKey.Add(Key, NewIndex);
+	}
+
+	FRshipRigOverrideSlot& Slot = GameThreadOverrides.Slots[*SlotIndex];
+	Slot.Rotation = Rotation;
+	Slot.bActive = true;
+	bOverridesDirty = true;
 }
 
-void URshipRigController::CommitPendingAttachStates(
-	const TMap<FName, FRshipRigAttachState>& UpdatedStates,
-	const TArray<FName>& ChildrenToRemove,
-	const TArray<FName>& ChildrenToPersist)
+void URshipRigController::ClearRotationOverride(const FName& ElementName)
 {
-	FScopeLock Lock(&RigStateMutex);
-	for (const FName Child : ChildrenToRemove)
+	bool bChanged = false;
+	for (const ERigElementType Type : { ERigElementType::Bone, ERigElementType::Control })
 	{
-		BoneAttachStates.Remove(Child);
+		if (const int32* SlotIndex = OverrideSlotByKey.Find(FRigElementKey(ElementName, Type)))
+		{
+			FRshipRigOverrideSlot& Slot = GameThreadOverrides.Slots[*SlotIndex];
+			bChanged |= Slot.bActive;
+			Slot.bActive = false;
+		}
 	}
-	for (const FName Child : ChildrenToPersist)
+
+	bOverridesDirty |= bChanged;
+}
+
+void URshipRigController::ClearAllRotationOverrides()
+{
+	GameThreadOverrides.Slots.Reset();
+	OverrideSlotByKey.Reset();
+	++GameThreadOverrides.LayoutVersion;
+	bOverridesDirty = true;
+}
+
+void URshipRigController::PublishOverrides()
+{
+	if (!bOverridesDirty)
 	{
-		if (const FRshipRigAttachState* UpdatedState = UpdatedStates.Find(Child))
+		return;
+	}
+	bOverridesDirty = false;
+
+	// Single writer: actions are dispatched on the game thread
+	PublishedOverrides.GetWriteBuffer() = GameThreadOverrides;
+	PublishedOverrides.Publish();
+}
+
+void URshipRigController::ApplyPendingRigStateToHierarchy(URigHierarchy* Hierarchy)
+{
+	EvaluatePendingRigState(Hierarchy, ResolveControlRig());
+}
+
+void URshipRigController::RefreshEvaluationCache(URigHierarchy* Hierarchy, const FRshipRigOverrideSnapshot& Overrides)
+{
+	FRshipRigEvaluationState& State = EvaluationState;
+	State.Hierarchy = Hierarchy;
+	State.TopologyVersion = Hierarchy->GetTopologyVersion();
+	State.LayoutVersion = Overrides.LayoutVersion;
+
+	State.OverrideElements.SetNum(Overrides.Slots.Num());
+	for (int32 SlotIndex = 0; SlotIndex < Overrides.Slots.Num(); ++SlotIndex)
+	{
+		const FRigElementKey& Key = Overrides.Slots[SlotIndex].Key;
+		FCachedRigElement& Cached = State.OverrideElements[SlotIndex];
+		Cached.Reset();
+		if (!Cached.UpdateCache(Key, Hierarchy))
 		{
-			BoneAttachStates.FindOrAdd(Child) = *UpdatedState;
+			UE_LOG(LogRshipExec, Warning, TEXT("ApplyPendingRigState missing rotation target: element=%s type=%d"),
+				*Key.Name.ToString(),
+				static_cast<int32>(Key.Type));
 		}
 	}
 }
 
-void URshipRigController::ApplyPendingRigStateToHierarchy(URigHierarchy* Hierarchy)
+void URshipRigController::ApplyAttachCommand(URigHierarchy* Hierarchy, const FRshipRigAttachCommand& Command)
 {
-	if (!Hierarchy)
+	TMap<FName, FRshipRigAttachState>& AttachStates = EvaluationState.AttachStates;
+
+	switch (Command.Type)
 	{
+	case FRshipRigAttachCommand::EType::ClearAll:
+		AttachStates.Reset();
 		return;
-	}
 
-	const float DeltaTime = LastTickDeltaTime;
+	case FRshipRigAttachCommand::EType::Clear:
+		AttachStates.Remove(Command.BoneName);
+		return;
 
-	TMap<FName, FQuat> RotationOverridesCopy;
-	TMap<FName, FQuat> ControlRotationOverridesCopy;
-	TMap<FName, FRshipRigAttachState> AttachStatesCopy;
+	case FRshipRigAttachCommand::EType::Attach:
 	{
-		FScopeLock Lock(&RigStateMutex);
-		RotationOverridesCopy = BoneRotationOverrides;
-		ControlRotationOverridesCopy = ControlRotationOverrides;
-		AttachStatesCopy = BoneAttachStates;
-	}
+		const FRshipRigAttachTarget& NewTarget = Command.Target;
+		FRshipRigAttachState& State = AttachStates.FindOrAdd(Command.BoneName);
+		const bool bAlreadyAttachedToParent =
+			!State.bBlendActive &&
+			State.Active.Mode == FRshipRigAttachTarget::EMode::ParentRelative &&
+			State.Active.ParentElement == NewTarget.ParentElement;
+		const bool bAlreadyBlendingToParent =
+			State.bBlendActive &&
+			State.BlendTo.Mode == FRshipRigAttachTarget::EMode::ParentRelative &&
+			State.BlendTo.ParentElement == NewTarget.ParentElement;
+		if (bAlreadyAttachedToParent || bAlreadyBlendingToParent)
+		{
+			return;
+		}
 
-	UE_LOG(LogRshipExec, Log, TEXT("ApplyPendingRigState boneRotations=%d controlRotations=%d attachments=%d delta=%.4f"),
-		RotationOverridesCopy.Num(),
-		ControlRotationOverridesCopy.Num(),
-		AttachStatesCopy.Num(),
-		DeltaTime);
+		if (State.Active.ParentElement.IsValid() && State.Active.ParentElement != NewTarget.ParentElement)
+		{
+			State.BlendFrom = State.Active;
+			State.BlendTo = NewTarget;
+			State.BlendAlpha = 0.0f;
+			State.BlendDuration = FMath::Max(Command.BlendSeconds, 0.0f);
+			State.bBlendActive = State.BlendDuration > KINDA_SMALL_NUMBER;
 
-	for (const TPair<FName, FQuat>& Pair : RotationOverridesCopy)
+			if (!State.bBlendActive)
+			{
+				State.Active = NewTarget;
+			}
+		}
+		else
+		{
+			State.Active = NewTarget;
+			State.bBlendActive = false;
+		}
+		return;
+	}
+
+	case FRshipRigAttachCommand::EType::Remove:
 	{
-		const FRigElementKey BoneKey(Pair.Key, ERigElementType::Bone);
-		if (!Hierarchy->Contains(BoneKey))
+		FRshipRigAttachState* ExistingState = AttachStates.Find(Command.BoneName);
+		if (!ExistingState)
 		{
-			UE_LOG(LogRshipExec, Warning, TEXT("ApplyPendingRigState missing bone rotation target: bone=%s"), *Pair.Key.ToString());
-			continue;
+			return;
 		}
 
-		const FTransform InitialLocal = Hierarchy->GetLocalTransform(BoneKey, true);
-		const FTransform InitialGlobal = Hierarchy->GetGlobalTransform(BoneKey, true);
-		const FTransform BeforeLocal = Hierarchy->GetLocalTransform(BoneKey);
-		const FTransform BeforeGlobal = Hierarchy->GetGlobalTransform(BoneKey);
-		FTransform DesiredGlobal = InitialGlobal;
-		DesiredGlobal.SetRotation((Pair.Value * InitialLocal.GetRotation()).GetNormalized());
-		Hierarchy->SetGlobalTransform(BoneKey, DesiredGlobal, true);
-		const FTransform AfterLocal = Hierarchy->GetLocalTransform(BoneKey);
-		const FTransform AfterGlobal = Hierarchy->GetGlobalTransform(BoneKey);
-		UE_LOG(LogRshipExec, Log,
-			TEXT("ApplyPendingRigState bone rotation: bone=%s initialLocalRot=%s beforeLocalRot=%s afterLocalRot=%s beforeGlobalRot=%s afterGlobalRot=%s"),
-			*Pair.Key.ToString(),
-			*InitialLocal.Rotator().ToString(),
-			*BeforeLocal.Rotator().ToString(),
-			*AfterLocal.Rotator().ToString(),
-			*BeforeGlobal.Rotator().ToString(),
-			*AfterGlobal.Rotator().ToString());
+		const FRigElementKey ChildKey(Command.BoneName, ERigElementType::Bone);
+		if (Command.BlendSeconds <= KINDA_SMALL_NUMBER || !Hierarchy->Contains(ChildKey))
+		{
+			AttachStates.Remove(Command.BoneName);
+			return;
+		}
+
+		auto EvaluateTargetAtRemoval = [Hierarchy, ChildKey](const FRshipRigAttachTarget& Target, FTransform& OutChildGlobal) -> bool
+		{
+			if (Target.Mode == FRshipRigAttachTarget::EMode::WorldSpace)
+			{
+				OutChildGlobal = Target.WorldTransform;
+				return true;
+			}
+
+			if (Target.Mode == FRshipRigAttachTarget::EMode::UnconstrainedPose)
+			{
+				OutChildGlobal = Hierarchy->GetGlobalTransform(ChildKey, false);
+				return true;
+			}
+
+			if (!Target.ParentElement.IsValid() || !Hierarchy->Contains(Target.ParentElement))
+			{
+				return false;
+			}
+
+			const FTransform ParentGlobal = Hierarchy->GetGlobalTransform(Target.ParentElement, false);
+			OutChildGlobal = Target.LocalOffset * ParentGlobal;
+			return true;
+		};
+
+		FTransform CurrentConstrainedGlobal = Hierarchy->GetGlobalTransform(ChildKey, false);
+		if (ExistingState->bBlendActive)
+		{
+			FTransform FromGlobal = FTransform::Identity;
+			FTransform ToGlobal = FTransform::Identity;
+			if (EvaluateTargetAtRemoval(ExistingState->BlendFrom, FromGlobal) && EvaluateTargetAtRemoval(ExistingState->BlendTo, ToGlobal))
+			{
+				CurrentConstrainedGlobal = BlendTransforms(FromGlobal, ToGlobal, ExistingState->BlendAlpha);
+			}
+		}
+		else
+		{
+			FTransform ActiveGlobal = FTransform::Identity;
+			if (EvaluateTargetAtRemoval(ExistingState->Active, ActiveGlobal))
+			{
+				CurrentConstrainedGlobal = ActiveGlobal;
+			}
+		}
+
+		FRshipRigAttachTarget BlendFromTarget;
+		BlendFromTarget.Mode = FRshipRigAttachTarget::EMode::WorldSpace;
+		BlendFromTarget.WorldTransform = CurrentConstrainedGlobal;
+
+		FRshipRigAttachTarget BlendToTarget;
+		BlendToTarget.Mode = FRshipRigAttachTarget::EMode::UnconstrainedPose;
+
+		ExistingState->BlendFrom = BlendFromTarget;
+		ExistingState->BlendTo = BlendToTarget;
+		ExistingState->BlendAlpha = 0.0f;
+		ExistingState->BlendDuration = Command.BlendSeconds;
+		ExistingState->bBlendActive = true;
+		ExistingState->Active = BlendToTarget;
+		return;
+	}
 	}
+}
 
-	for (const TPair<FName, FQuat>& Pair : ControlRotationOverridesCopy)
+void URshipRigController::EvaluatePendingRigState(URigHierarchy* Hierarchy, UControlRig* EvaluatingRig)
+{
+	if (!Hierarchy)
 	{
-		const FRigElementKey ControlKey(Pair.Key, ERigElementType::Control);
-		if (!Hierarchy->Contains(ControlKey))
+		return;
+	}
+
+	// Evaluation state has a single owner; a concurrent evaluation of the same controller skips rather than blocks
+	bool bExpected = false;
+	if (!bEvaluating.compare_exchange_strong(bExpected, true, std::memory_order_acquire))
+	{
+		return;
+	}
+	ON_SCOPE_EXIT
+	{
+		bEvaluating.store(false, std::memory_order_release);
+	};
+
+	const float DeltaTime = LastTickDeltaTime.load(std::memory_order_relaxed);
+
+	FRshipRigAttachCommand Command;
+	while (PendingAttachCommands.Dequeue(Command))
+	{
+		ApplyAttachCommand(Hierarchy, Command);
+	}
+
+	PublishedOverrides.Acquire();
+	const FRshipRigOverrideSnapshot& Overrides = PublishedOverrides.GetReadBuffer();
+
+	FRshipRigEvaluationState& State = EvaluationState;
+	if (State.Hierarchy != Hierarchy
+		|| State.TopologyVersion != Hierarchy->GetTopologyVersion()
+		|| State.LayoutVersion != Overrides.LayoutVersion)
+	{
+		RefreshEvaluationCache(Hierarchy, Overrides);
+	}
+
+	for (int32 SlotIndex = 0; SlotIndex < Overrides.Slots.Num(); ++SlotIndex)
+	{
+		const FRshipRigOverrideSlot& Slot = Overrides.Slots[SlotIndex];
+		const FCachedRigElement& Cached = State.OverrideElements[SlotIndex];
+		if (!Slot.bActive || !Cached.IsValid())
 		{
-			UE_LOG(LogRshipExec, Warning, TEXT("ApplyPendingRigState missing control rotation target: control=%s"), *Pair.Key.ToString());
 			continue;
 		}
 
-		const FTransform BeforeLocal = Hierarchy->GetLocalTransform(ControlKey);
-		FTransform LocalTransform = BeforeLocal;
-		LocalTransform.SetRotation(Pair.Value);
-		if (UControlRig* ActiveControlRig = ResolveControlRig())
+		if (Slot.Key.Type == ERigElementType::Control)
 		{
-			ActiveControlRig->SetControlLocalTransform(Pair.Key, LocalTransform, true, FRigControlModifiedContext(), false, true);
+			FTransform LocalTransform = Hierarchy->GetLocalTransform(Cached.GetIndex(), false);
+			LocalTransform.SetRotation(Slot.Rotation);
+			if (EvaluatingRig)
+			{
+				EvaluatingRig->SetControlLocalTransform(Slot.Key.Name, LocalTransform, true, FRigControlModifiedContext(), false, true);
+			}
+			else
+			{
+				Hierarchy->SetLocalTransform(Cached, LocalTransform, true);
+			}
 		}
 		else
 		{
-			Hierarchy->SetLocalTransform(ControlKey, LocalTransform, true);
+			FTransform DesiredLocal = Hierarchy->GetLocalTransform(Cached.GetIndex(), true);
+			DesiredLocal.SetRotation((Slot.Rotation * DesiredLocal.GetRotation()).GetNormalized());
+			Hierarchy->SetLocalTransform(Cached, DesiredLocal, true);
 		}
-		const FTransform AfterLocal = Hierarchy->GetLocalTransform(ControlKey);
-		UE_LOG(LogRshipExec, Log,
-			TEXT("ApplyPendingRigState control rotation: control=%s beforeLocalRot=%s afterLocalRot=%s"),
-			*Pair.Key.ToString(),
-			*BeforeLocal.Rotator().ToString(),
-			*AfterLocal.Rotator().ToString());
 	}
 
-	if (AttachStatesCopy.Num() == 0)
+	if (State.AttachStates.Num() == 0)
 	{
 		return;
 	}
 
-	TArray<FName> ChildrenToRemove;
-	TArray<FName> ChildrenToPersist;
-	ChildrenToRemove.Reserve(AttachStatesCopy.Num());
-	ChildrenToPersist.Reserve(AttachStatesCopy.Num());
+	TArray<FName, TInlineAllocator<8>> ChildrenToRemove;
 
-	for (TPair<FName, FRshipRigAttachState>& Pair : AttachStatesCopy)
+	for (TPair<FName, FRshipRigAttachState>& Pair : State.AttachStates)
 	{
 		const FName ChildBone = Pair.Key;
-		FRshipRigAttachState& State = Pair.Value;
-
+		FRshipRigAttachState& AttachState = Pair.Value;
 		const FRigElementKey ChildKey(ChildBone, ERigElementType::Bone);
 		if (!Hierarchy->Contains(ChildKey))
 		{
@@ -1010,91 +1072,64 @@ void URshipRigController::ApplyPendingRigStateToHierarchy(URigHierarchy* Hierarc
 				return true;
 			}
 
-		if (!Target.ParentElement.IsValid())
-		{
-			return false;
-		}
-
-		const FRigElementKey ParentKey = Target.ParentElement;
-		if (!Hierarchy->Contains(ParentKey))
-		{
-			return false;
+			if (!Target.ParentElement.IsValid() || !Hierarchy->Contains(Target.ParentElement))
+			{
+				return false;
 			}
 
-			const FTransform ParentGlobal = Hierarchy->GetGlobalTransform(ParentKey, false);
+			const FTransform ParentGlobal = Hierarchy->GetGlobalTransform(Target.ParentElement, false);
 			OutChildGlobal = Target.LocalOffset * ParentGlobal;
 			return true;
 		};
 
 		FTransform DesiredGlobal = FTransform::Identity;
-		if (State.bBlendActive)
+		if (AttachState.bBlendActive)
 		{
 			FTransform FromGlobal = FTransform::Identity;
 			FTransform ToGlobal = FTransform::Identity;
-
-			if (!EvaluateTarget(State.BlendFrom, FromGlobal) || !EvaluateTarget(State.BlendTo, ToGlobal))
+			if (!EvaluateTarget(AttachState.BlendFrom, FromGlobal) || !EvaluateTarget(AttachState.BlendTo, ToGlobal))
 			{
 				UE_LOG(LogRshipExec, Error, TEXT("Attach solver dropped blend for child '%s': source parent missing."), *ChildBone.ToString());
 				ChildrenToRemove.Add(ChildBone);
 				continue;
 			}
 
-			if (State.BlendDuration <= KINDA_SMALL_NUMBER)
+			if (AttachState.BlendDuration <= KINDA_SMALL_NUMBER)
 			{
-				State.BlendAlpha = 1.0f;
+				AttachState.BlendAlpha = 1.0f;
 			}
 			else
 			{
-				State.BlendAlpha = FMath::Clamp(State.BlendAlpha + (DeltaTime / State.BlendDuration), 0.0f, 1.0f);
+				AttachState.BlendAlpha = FMath::Clamp(AttachState.BlendAlpha + (DeltaTime / AttachState.BlendDuration), 0.0f, 1.0f);
 			}
 
-			DesiredGlobal = BlendTransforms(FromGlobal, ToGlobal, State.BlendAlpha);
+			DesiredGlobal = BlendTransforms(FromGlobal, ToGlobal, AttachState.BlendAlpha);
 
-			if (State.BlendAlpha >= 1.0f - KINDA_SMALL_NUMBER)
+			if (AttachState.BlendAlpha >= 1.0f - KINDA_SMALL_NUMBER)
 			{
-				if (State.BlendTo.Mode == FRshipRigAttachTarget::EMode::UnconstrainedPose)
+				if (AttachState.BlendTo.Mode == FRshipRigAttachTarget::EMode::UnconstrainedPose)
 				{
 					ChildrenToRemove.Add(ChildBone);
 				}
 				else
 				{
-					State.Active = State.BlendTo;
-					State.bBlendActive = false;
+					AttachState.Active = AttachState.BlendTo;
+					AttachState.bBlendActive = false;
 				}
 			}
 		}
-		else
+		else if (!EvaluateTarget(AttachState.Active, DesiredGlobal))
 		{
-			if (!EvaluateTarget(State.Active, DesiredGlobal))
-			{
-				UE_LOG(LogRshipExec, Error, TEXT("Attach solver dropped child '%s': active parent missing."), *ChildBone.ToString());
-				ChildrenToRemove.Add(ChildBone);
-				continue;
-			}
+			UE_LOG(LogRshipExec, Error, TEXT("Attach solver dropped child '%s': active parent missing."), *ChildBone.ToString());
+			ChildrenToRemove.Add(ChildBone);
+			continue;
 		}
 
 		Hierarchy->SetGlobalTransform(ChildKey, DesiredGlobal, false, true, false);
-		const FTransform AppliedGlobal = Hierarchy->GetGlobalTransform(ChildKey);
-		UE_LOG(LogRshipExec, Log,
-			TEXT("ApplyPendingRigState attachment: child=%s appliedGlobalLoc=%s appliedGlobalRot=%s"),
-			*ChildBone.ToString(),
-			*AppliedGlobal.GetTranslation().ToString(),
-			*AppliedGlobal.Rotator().ToString());
-		ChildrenToPersist.Add(ChildBone);
 	}
 
+	for (const FName Child : ChildrenToRemove)
 	{
-		FScopeLock Lock(&RigStateMutex);
-		for (const FName Child : ChildrenToRemove)
-		{
-			BoneAttachStates.Remove(Child);
-		}
-		for (const FName Child : ChildrenToPersist)
-		{
-			if (const FRshipRigAttachState* UpdatedState = AttachStatesCopy.Find(Child))
-			{
-				BoneAttachStates.FindOrAdd(Child) = *UpdatedState;
-			}
-		}
+		State.AttachStates.Remove(Child);
 	}
 }
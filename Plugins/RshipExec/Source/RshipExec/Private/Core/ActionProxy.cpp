@@ -1,10 +1,32 @@
 #include "Core/ActionProxy.h"
 
+#include "Components/ActorComponent.h"
+#include "Core/RshipRenderStateDirtySet.h"
+#include "Engine/Engine.h"
 #include "GameFramework/Actor.h"
 #include "Logs.h"
 #include "Misc/OutputDeviceNull.h"
+#include "RshipSubsystem.h"
 #include "SchemaHelpers.h"
 
+namespace
+{
+	/** Import Text into Value, succeeding only if the whole string parsed. */
+	bool ImportWholeText(const FProperty* Property, const FString& Text, void* Value, UObject* OwnerObject)
+	{
+		const TCHAR* Rest = Property->ImportText_Direct(*Text, Value, OwnerObject, 0);
+		if (!Rest)
+		{
+			return false;
+		}
+		while (FChar::IsWhitespace(*Rest))
+		{
+			++Rest;
+		}
+		return *Rest == TEXT('\0');
+	}
+}
+
 FRshipActionProxy FRshipActionProxy::FromFunction(const FString& InId, const FString& InName, UFunction* InFunction, UObject* InOwner)
 {
 	FRshipActionProxy Proxy;
@@ -31,16 +53,61 @@ FRshipActionProxy FRshipActionProxy::FromProperty(const FString& InId, const FSt
 	{
 		Proxy.FunctionName = InProperty->GetName();
 		BuildSchemaPropsFromFProperty(InProperty, *Proxy.Props);
+		Proxy.Setter = InOwner ? FindPropertySetter(InOwner->GetClass(), InProperty) : nullptr;
 	}
 	return Proxy;
 }
 
+UFunction* FRshipActionProxy::FindPropertySetter(const UClass* Class, const FProperty* Property)
+{
+	if (!Class || !Property)
+	{
+		return nullptr;
+	}
+
+	const FString PropertyName = Property->GetName();
+	FString SetterName = TEXT("Set") + PropertyName;
+	if (Property->IsA<FBoolProperty>() && PropertyName.Len() > 1 && PropertyName[0] == TEXT('b') && FChar::IsUpper(PropertyName[1]))
+	{
+		SetterName = TEXT("Set") + PropertyName.Mid(1);
+	}
+
+	UFunction* Function = Class->FindFunctionByName(FName(*SetterName));
+	if (!Function)
+	{
+		return nullptr;
+	}
+
+	// Only exact one-argument setters; anything else (extra flags, conversions) keeps the direct write
+	const FProperty* Param = nullptr;
+	for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+	{
+		if (It->HasAnyPropertyFlags(CPF_ReturnParm))
+		{
+			continue;
+		}
+		if (Param)
+		{
+			return nullptr;
+		}
+		Param = *It;
+	}
+
+	return Param && Param->SameType(Property) ? Function : nullptr;
+}
+
 TSharedPtr<FJsonObject> FRshipActionProxy::GetSchema() const
 {
 	return Props.IsValid() ? PropsToSchema(Props.Get()) : nullptr;
 }
 
 bool FRshipActionProxy::Take(AActor* Actor, const TSharedRef<FJsonObject>& Data) const
+{
+	URshipSubsystem* Subsystem = GEngine ? GEngine->GetEngineSubsystem<URshipSubsystem>() : nullptr;
+	return Take(Actor, Data, Subsystem ? &Subsystem->GetRenderStateDirtySet() : nullptr);
+}
+
+bool FRshipActionProxy::Take(AActor* Actor, const TSharedRef<FJsonObject>& Data, FRshipRenderStateDirtySet* RenderStateDirtySet) const
 {
 	(void)Actor;
 
@@ -54,17 +121,7 @@ bool FRshipActionProxy::Take(AActor* Actor, const TSharedRef<FJsonObject>& Data)
 	if (Property)
 	{
 		const FString ArgList = BuildArgStringFromJson(*Props, Data, false);
-		void* PropAddress = Property->ContainerPtrToValuePtr<void>(OwnerObject);
-		const TCHAR* Result = Property->ImportText_Direct(*ArgList, PropAddress, OwnerObject, 0);
-		if (Result != nullptr && FCString::Strlen(Result) > 0)
-		{
-			UE_LOG(LogRshipExec, Error, TEXT("Action '%s' failed to import property '%s' on '%s'. Parse error: %s"),
-				*Id,
-				*Property->GetName(),
-				*GetNameSafe(OwnerObject),
-				Result);
-		}
-		return Result == nullptr || FCString::Strlen(Result) == 0;
+		return Setter ? CallSetter(OwnerObject, ArgList) : WriteProperty(OwnerObject, ArgList, RenderStateDirtySet);
 	}
 
 	const FString ArgList = BuildArgStringFromJson(*Props, Data, true);
@@ -87,3 +144,67 @@ bool FRshipActionProxy::Take(AActor* Actor, const TSharedRef<FJsonObject>& Data)
 	}
 	return bCalled;
 }
+
+bool FRshipActionProxy::CallSetter(UObject* OwnerObject, const FString& ArgList) const
+{
+	// Same frame layout ProcessEvent expects: parameters only, never the function's locals
+	uint8* Params = static_cast<uint8*>(FMemory_Alloca_Aligned(Setter->ParmsSize, Setter->GetMinAlignment()));
+	FMemory::Memzero(Params, Setter->ParmsSize);
+
+	FProperty* Param = nullptr;
+	for (TFieldIterator<FProperty> It(Setter); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+	{
+		It->InitializeValue_InContainer(Params);
+		if (!Param && !It->HasAnyPropertyFlags(CPF_ReturnParm))
+		{
+			Param = *It;
+		}
+	}
+
+	const bool bImported = Param && ImportWholeText(Param, ArgList, Param->ContainerPtrToValuePtr<void>(Params), OwnerObject);
+	if (bImported)
+	{
+		OwnerObject->ProcessEvent(Setter, Params);
+	}
+	else
+	{
+		UE_LOG(LogRshipExec, Error, TEXT("Action '%s' failed to import argument for setter '%s' on '%s'."),
+			*Id,
+			*Setter->GetName(),
+			*GetNameSafe(OwnerObject));
+	}
+
+	for (TFieldIterator<FProperty> It(Setter); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+	{
+		It->DestroyValue_InContainer(Params);
+	}
+	return bImported;
+}
+
+bool FRshipActionProxy::WriteProperty(UObject* OwnerObject, const FString& ArgList, FRshipRenderStateDirtySet* RenderStateDirtySet) const
+{
+	void* PropAddress = Property->ContainerPtrToValuePtr<void>(OwnerObject);
+	if (!ImportWholeText(Property, ArgList, PropAddress, OwnerObject))
+	{
+		UE_LOG(LogRshipExec, Error, TEXT("Action '%s' failed to import property '%s' on '%s' from '%s'."),
+			*Id,
+			*Property->GetName(),
+			*GetNameSafe(OwnerObject),
+			*ArgList);
+		return false;
+	}
+
+	// A direct write skips whatever the setter would have pushed to the render thread
+	if (UActorComponent* Component = Cast<UActorComponent>(OwnerObject))
+	{
+		if (RenderStateDirtySet)
+		{
+			RenderStateDirtySet->Add(Component);
+		}
+		else
+		{
+			Component->MarkRenderStateDirty();
+		}
+	}
+	return true;
+}
@@ -0,0 +1,134 @@
+#include "Core/RshipRegistrationQueue.h"
+
+bool FRshipRegistrationQueue::Enqueue(UObject* Object, const FString& TargetId, TArray<FString> ParentTargetIds)
+{
+	if (!Object)
+	{
+		return false;
+	}
+
+	bOrderDirty = true;
+
+	const FObjectKey Key(Object);
+	if (const int32* ExistingSlot = SlotByKey.Find(Key))
+	{
+		// Keep the original queue position; only the dependencies can change
+		FEntry& Existing = Entries[*ExistingSlot];
+		Existing.TargetId = TargetId;
+		Existing.ParentTargetIds = MoveTemp(ParentTargetIds);
+		Progress.Deduplicated++;
+		return false;
+	}
+
+	FEntry Entry;
+	Entry.Key = Key;
+	Entry.Object = Object;
+	Entry.TargetId = TargetId;
+	Entry.ParentTargetIds = MoveTemp(ParentTargetIds);
+	Entry.Sequence = ++NextSequence;
+
+	const int32 Slot = Entries.Add(MoveTemp(Entry));
+	SlotByKey.Add(Key, Slot);
+	return true;
+}
+
+bool FRshipRegistrationQueue::Remove(const UObject* Object)
+{
+	int32 Slot = INDEX_NONE;
+	if (!SlotByKey.RemoveAndCopyValue(FObjectKey(Object), Slot))
+	{
+		return false;
+	}
+
+	// Order nodes for the slot go stale through the sequence check
+	Entries.RemoveAt(Slot);
+	return true;
+}
+
+void FRshipRegistrationQueue::Reset()
+{
+	Entries.Empty();
+	SlotByKey.Empty();
+	Order.Empty();
+	bOrderDirty = false;
+	ResetProgress();
+}
+
+void FRshipRegistrationQueue::ResetProgress()
+{
+	Progress = FRshipRegistrationProgress();
+}
+
+FRshipRegistrationProgress FRshipRegistrationQueue::GetProgress() const
+{
+	FRshipRegistrationProgress Result = Progress;
+	Result.Pending = SlotByKey.Num();
+	return Result;
+}
+
+void FRshipRegistrationQueue::ReleaseSlot(int32 Slot)
+{
+	SlotByKey.Remove(Entries[Slot].Key);
+	Entries.RemoveAt(Slot);
+}
+
+int32 FRshipRegistrationQueue::ResolveDepth(int32 Slot, const TMap<FString, int32>& SlotByTargetId, TMap<int32, int32>& DepthBySlot) const
+{
+	if (const int32* Known = DepthBySlot.Find(Slot))
+	{
+		// INDEX_NONE marks a slot still being resolved: a parent cycle, which is broken here
+		return FMath::Max(*Known, 0);
+	}
+
+	DepthBySlot.Add(Slot, INDEX_NONE);
+
+	int32 Depth = 0;
+	for (const FString& ParentId : Entries[Slot].ParentTargetIds)
+	{
+		const int32* ParentSlot = SlotByTargetId.Find(ParentId);
+		if (ParentSlot && *ParentSlot != Slot)
+		{
+			Depth = FMath::Max(Depth, ResolveDepth(*ParentSlot, SlotByTargetId, DepthBySlot) + 1);
+		}
+	}
+
+	DepthBySlot.Add(Slot, Depth);
+	return Depth;
+}
+
+void FRshipRegistrationQueue::RebuildOrder()
+{
+	bOrderDirty = false;
+
+	// Only parents that are themselves pending constrain the order
+	TMap<FString, int32> SlotByTargetId;
+	SlotByTargetId.Reserve(Entries.Num());
+	for (auto It = Entries.CreateConstIterator(); It; ++It)
+	{
+		if (!It->TargetId.IsEmpty())
+		{
+			SlotByTargetId.Add(It->TargetId, It.GetIndex());
+		}
+	}
+
+	TMap<int32, int32> DepthBySlot;
+	DepthBySlot.Reserve(Entries.Num());
+
+	Order.Reset(Entries.Num());
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		It->Depth = ResolveDepth(It.GetIndex(), SlotByTargetId, DepthBySlot);
+
+		FOrderNode& Node = Order.AddDefaulted_GetRef();
+		Node.Slot = It.GetIndex();
+		Node.Sequence = It->Sequence;
+	}
+
+	// Shallowest first, then first-come first-served
+	Order.Sort([this](const FOrderNode& A, const FOrderNode& B)
+	{
+		const int32 DepthA = Entries[A.Slot].Depth;
+		const int32 DepthB = Entries[B.Slot].Depth;
+		return DepthA != DepthB ? DepthA < DepthB : A.Sequence < B.Sequence;
+	});
+}
@@ -0,0 +1,31 @@
+#include "Core/RshipRenderStateDirtySet.h"
+
+#include "Components/ActorComponent.h"
+
+void FRshipRenderStateDirtySet::Add(UActorComponent* Component)
+{
+	if (Component)
+	{
+		Pending.Add(Component);
+	}
+}
+
+int32 FRshipRenderStateDirtySet::Flush()
+{
+	if (Pending.Num() == 0)
+	{
+		return 0;
+	}
+
+	int32 Flushed = 0;
+	for (const TWeakObjectPtr<UActorComponent>& WeakComponent : Pending)
+	{
+		if (UActorComponent* Component = WeakComponent.Get())
+		{
+			Component->MarkRenderStateDirty();
+			++Flushed;
+		}
+	}
+	Pending.Reset();
+	return Flushed;
+}
@@ -14,7 +14,16 @@ void URshipActorRegistrationComponent::OnRegister()
 	Super::OnRegister();
 	PrimaryComponentTick.bCanEverTick = false;
 	SetComponentTickEnabled(false);
-	Register();
+
+	// Registration is time-sliced across frames; a level load queues every component at once
+	if (URshipSubsystem* Subsystem = GEngine ? GEngine->GetEngineSubsystem<URshipSubsystem>() : nullptr)
+	{
+		Subsystem->QueueTargetRegistration(this);
+	}
+	else
+	{
+		Register();
+	}
 }
 
 void URshipActorRegistrationComponent::OnComponentDestroyed(bool bDestoryHierarchy)
@@ -101,6 +110,12 @@ FString URshipActorRegistrationComponent::GetFullTargetId() const
 	return targetName;
 }
 
+TArray<FString> URshipActorRegistrationComponent::GetFullParentTargetIds() const
+{
+	URshipSubsystem* Subsystem = GEngine ? GEngine->GetEngineSubsystem<URshipSubsystem>() : nullptr;
+	return Subsystem ? BuildFullParentTargetIds(Subsystem->GetServiceId()) : ParentTargetIds;
+}
+
 FRshipTargetProxy URshipActorRegistrationComponent::GetTargetProxy() const
 {
 	if (!GEngine)
@@ -123,25 +138,14 @@ FRshipTargetProxy URshipActorRegistrationComponent::GetTargetProxy() const
 	return FullTargetId.IsEmpty() ? FRshipTargetProxy() : FRshipTargetProxy(Subsystem, FullTargetId);
 }
 
-void URshipActorRegistrationComponent::Register()
+void URshipActorRegistrationComponent::ResolveDefaultTargetId()
 {
-	UWorld* World = GetWorld();
-	if (World && World->WorldType == EWorldType::EditorPreview)
+	const AActor* Parent = GetOwner();
+	if (!Parent)
 	{
-		UE_LOG(LogRshipExec, Verbose, TEXT("Skipping registration for blueprint preview actor: %s"), *targetName);
 		return;
 	}
 
-	URshipSubsystem* Subsystem = GEngine ? GEngine->GetEngineSubsystem<URshipSubsystem>() : nullptr;
-	AActor* Parent = GetOwner();
-	if (!Subsystem || !Parent)
-	{
-		UE_LOG(LogRshipExec, Warning, TEXT("Register failed: missing subsystem or owner"));
-		return;
-	}
-
-	Subsystem->BeginRegistrationBatch();
-
 	FString OutlinerName = Parent->GetName();
 #if WITH_EDITOR
 	OutlinerName = Parent->GetActorLabel();
@@ -170,6 +174,28 @@ void URshipActorRegistrationComponent::Register()
 	{
 		AutoGeneratedTargetNameBaseline = targetName;
 	}
+}
+
+void URshipActorRegistrationComponent::Register()
+{
+	UWorld* World = GetWorld();
+	if (World && World->WorldType == EWorldType::EditorPreview)
+	{
+		UE_LOG(LogRshipExec, Verbose, TEXT("Skipping registration for blueprint preview actor: %s"), *targetName);
+		return;
+	}
+
+	URshipSubsystem* Subsystem = GEngine ? GEngine->GetEngineSubsystem<URshipSubsystem>() : nullptr;
+	AActor* Parent = GetOwner();
+	if (!Subsystem || !Parent)
+	{
+		UE_LOG(LogRshipExec, Warning, TEXT("Register failed: missing subsystem or owner"));
+		return;
+	}
+
+	Subsystem->BeginRegistrationBatch();
+
+	ResolveDefaultTargetId();
 
 	const FString FullTargetId = Subsystem->GetServiceId() + TEXT(":") + targetName;
 	const TArray<FString> FullParentTargetIds = BuildFullParentTargetIds(Subsystem->GetServiceId());
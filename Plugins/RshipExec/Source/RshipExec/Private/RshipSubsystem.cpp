@@ -27,6 +27,8 @@
 #include "Engine/Engine.h"
 #include "Engine/World.h"
 #include "Core/Target.h"
+#include "Controllers/RshipControllerComponent.h"
+#include "Controllers/RshipPublishScheduler.h"
 #include "Core/RshipEntityRecords.h"
 #include "Core/RshipEntitySerializer.h"
 #include "Transport/RshipMykoTransport.h"
@@ -1177,6 +1179,9 @@ void URshipSubsystem::TickSubsystems()
     // Apply coalesced target actions once per frame.
     ProcessPendingExecTargetActions();
 
+    // One render state rebuild per component for all property writes this frame.
+    RenderStateDirtySet.Flush();
+
     // Fire OnRshipData once per target/component at end-of-frame for all successful Take() calls.
     FlushPendingOnDataReceived();
 
@@ -1197,6 +1202,7 @@ bool URshipSubsystem::OnDeferredOnDataReceivedTick(float DeltaTime)
         return false;
     }
 
+    RenderStateDirtySet.Flush();
     FlushPendingOnDataReceived();
     DeferredOnDataReceivedTickerHandle.Reset();
     return false; // one-shot
@@ -1219,6 +1225,135 @@ void URshipSubsystem::QueueOnDataReceived(URshipActorRegistrationComponent* Comp
     }
 }
 
+void URshipSubsystem::QueueTargetRegistration(URshipActorRegistrationComponent* Component)
+{
+    if (!Component)
+    {
+        return;
+    }
+
+    // Key the entry on the id Register will use, so unnamed targets don't all queue as "<service>:"
+    Component->ResolveDefaultTargetId();
+    RegistrationQueue.Enqueue(Component, Component->GetFullTargetId(), Component->GetFullParentTargetIds());
+    EnsureRegistrationTicker();
+}
+
+void URshipSubsystem::QueueTargetRegistration(URshipControllerComponent* Controller)
+{
+    if (!Controller)
+    {
+        return;
+    }
+
+    // Controller targets hang under the owner's target, so the owner registers first
+    TArray<FString> ParentTargetIds;
+    const AActor* Owner = Controller->GetOwner();
+    if (URshipActorRegistrationComponent* Registration = Owner ? Owner->FindComponentByClass<URshipActorRegistrationComponent>() : nullptr)
+    {
+        Registration->ResolveDefaultTargetId();
+        ParentTargetIds.Add(Registration->GetFullTargetId());
+    }
+
+    RegistrationQueue.Enqueue(Controller, FString(), MoveTemp(ParentTargetIds));
+    EnsureRegistrationTicker();
+}
+
+void URshipSubsystem::EnsureRegistrationTicker()
+{
+    if (!RegistrationTickerHandle.IsValid())
+    {
+        RegistrationTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateUObject(this, &URshipSubsystem::OnRegistrationTick),
+            0.0f
+        );
+    }
+}
+
+bool URshipSubsystem::OnRegistrationTick(float DeltaTime)
+{
+    if (!IsValid(this))
+    {
+        return false;
+    }
+
+    const URshipSettings* Settings = GetDefault<URshipSettings>();
+    const double BudgetMilliseconds = Settings ? Settings->RegistrationBudgetMilliseconds : 4.0;
+    ProcessRegistrationSlice(BudgetMilliseconds / 1000.0);
+
+    if (RegistrationQueue.Num() > 0)
+    {
+        return true;  // Keep ticking until the queue drains
+    }
+
+    RegistrationTickerHandle.Reset();
+    return false;
+}
+
+int32 URshipSubsystem::ProcessRegistrationSlice(double BudgetSeconds)
+{
+    if (RegistrationQueue.Num() == 0)
+    {
+        return 0;
+    }
+
+    // One registration batch per slice: everything served this frame goes out as one event batch
+    BeginRegistrationBatch();
+    const int32 Served = RegistrationQueue.ProcessSlice(BudgetSeconds, [this](UObject* Object)
+    {
+        ServeQueuedRegistration(Object);
+    });
+    EndRegistrationBatch();
+
+    UE_LOG(LogRshipExec, Verbose, TEXT("Registration slice: %d registered, %d pending"), Served, RegistrationQueue.Num());
+    return Served;
+}
+
+void URshipSubsystem::ServeQueuedRegistration(UObject* Object)
+{
+    if (URshipActorRegistrationComponent* Registration = Cast<URshipActorRegistrationComponent>(Object))
+    {
+        AActor* Owner = Registration->GetOwner();
+        if (!IsValid(Owner) || Owner->IsActorBeingDestroyed())
+        {
+            return;
+        }
+
+        Registration->Register();
+
+        // Register() rebinds every sibling controller, so their pending entries are already served
+        TArray<URshipControllerComponent*> Controllers;
+        Owner->GetComponents(Controllers);
+        for (URshipControllerComponent* Controller : Controllers)
+        {
+            RegistrationQueue.Remove(Controller);
+        }
+        return;
+    }
+
+    if (URshipControllerComponent* Controller = Cast<URshipControllerComponent>(Object))
+    {
+        if (IsValid(Controller))
+        {
+            Controller->RegisterRshipTargets();
+        }
+    }
+}
+
+int32 URshipSubsystem::GetPendingRegistrationCount() const
+{
+    return RegistrationQueue.Num();
+}
+
+FRshipRegistrationProgress URshipSubsystem::GetRegistrationProgress() const
+{
+    return RegistrationQueue.GetProgress();
+}
+
+void URshipSubsystem::ResetRegistrationProgress()
+{
+    RegistrationQueue.ResetProgress();
+}
+
 void URshipSubsystem::FlushPendingOnDataReceived()
 {
     if (PendingOnDataReceivedComponents.Num() == 0)
@@ -2394,6 +2529,11 @@ void URshipSubsystem::Deinitialize()
         FTSTicker::GetCoreTicker().RemoveTicker(DeferredOnDataReceivedTickerHandle);
         DeferredOnDataReceivedTickerHandle.Reset();
     }
+    if (RegistrationTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(RegistrationTickerHandle);
+        RegistrationTickerHandle.Reset();
+    }
     PendingOutboundMessages.Reset();
     PendingOutboundBytes = 0;
     RateLimiter.Reset();
@@ -2407,6 +2547,7 @@ void URshipSubsystem::Deinitialize()
 
     ManagedTargetSnapshots.Reset();
     RegisteredTargetsById.Reset();
+    RegistrationQueue.Reset();
 
 #if WITH_EDITOR
     UnregisterEditorDelegates();
@@ -2449,6 +2590,11 @@ void URshipSubsystem::BeginDestroy()
         FTSTicker::GetCoreTicker().RemoveTicker(DeferredOnDataReceivedTickerHandle);
         DeferredOnDataReceivedTickerHandle.Reset();
     }
+    if (RegistrationTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(RegistrationTickerHandle);
+        RegistrationTickerHandle.Reset();
+    }
 
     // Clean up WebSocket connection without callbacks (object is being destroyed)
     if (WebSocket.IsValid())
@@ -2498,6 +2644,11 @@ void URshipSubsystem::PrepareForHotReload()
         FTSTicker::GetCoreTicker().RemoveTicker(DeferredOnDataReceivedTickerHandle);
         DeferredOnDataReceivedTickerHandle.Reset();
     }
+    if (RegistrationTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(RegistrationTickerHandle);
+        RegistrationTickerHandle.Reset();
+    }
 
 #if WITH_EDITOR
     UnregisterEditorDelegates();
@@ -2543,6 +2694,12 @@ void URshipSubsystem::ReinitializeAfterHotReload()
         UE_LOG(LogRshipExec, Log, TEXT("Restarted subsystem ticker"));
     }
 
+    // Resume deferred registration interrupted by the reload
+    if (RegistrationQueue.Num() > 0)
+    {
+        EnsureRegistrationTicker();
+    }
+
     RateLimiter.Reset();
 
     // Reconnect to server
@@ -3403,7 +3560,9 @@ FRshipTargetProxy URshipSubsystem::EnsureActorIdentity(AActor* Actor)
 		// Do not fall back to ad-hoc identity generation from actor labels/names.
 		if (!Registration->TargetData)
 		{
+			// Registering on demand serves any queued initial registration for this component
 			Registration->Register();
+			RegistrationQueue.Remove(Registration);
 		}
 
 		if (Registration->TargetData)
@@ -4064,6 +4223,60 @@ void URshipSubsystem::PulseEmitter(FString targetId, FString emitterId, TSharedP
 
 }
 
+void URshipSubsystem::PulseEmitterBatch(const FRshipPublishBatch& Batch)
+{
+    TArray<TSharedPtr<FJsonObject>> Events;
+    BuildPulseEvents(Batch, MachineId, Events);
+
+    // One frame of controller state travels as one event batch instead of a message per pulse
+    QueueEventBatch(Events, ERshipMessagePriority::Normal, ERshipMessageType::EmitterPulse, TEXT("PulseBatch"));
+}
+
+void URshipSubsystem::BuildPulseEvents(const FRshipPublishBatch& Batch, const FString& SourceId, TArray<TSharedPtr<FJsonObject>>& OutEvents)
+{
+    if (Batch.Samples.Num() == 0)
+    {
+        return;
+    }
+
+    const FDateTime Now = FDateTime::UtcNow();
+    const double TimestampMs = static_cast<double>(Now.ToUnixTimestamp() * 1000LL + Now.GetMillisecond());
+
+    OutEvents.Reserve(OutEvents.Num() + Batch.Samples.Num());
+
+    for (const FRshipPublishSample& Sample : Batch.Samples)
+    {
+        if (!Batch.TargetIds.IsValidIndex(Sample.SourceIndex) || !Sample.EmitterName)
+        {
+            continue;
+        }
+
+        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+        for (int32 ValueIndex = 0; ValueIndex < Sample.NumValues; ++ValueIndex)
+        {
+            if (Sample.Kind == ERshipPublishValueKind::Bool)
+            {
+                Data->SetBoolField(Sample.FieldNames[ValueIndex], Sample.Values[ValueIndex] != 0.0);
+            }
+            else
+            {
+                Data->SetNumberField(Sample.FieldNames[ValueIndex], Sample.Values[ValueIndex]);
+            }
+        }
+
+        const FString FullEmitterId = Batch.TargetIds[Sample.SourceIndex] + TEXT(":") + Sample.EmitterName;
+
+        FRshipPulseRecord PulseRecord;
+        PulseRecord.EmitterId = FullEmitterId;
+        PulseRecord.Id = FullEmitterId;
+        PulseRecord.Data = Data;
+        PulseRecord.TimestampMs = TimestampMs;
+        PulseRecord.Hash = FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphensLower);
+
+        OutEvents.Add(FRshipMykoTransport::MakeSet(TEXT("Pulse"), FRshipEntitySerializer::ToJson(PulseRecord), SourceId));
+    }
+}
+
 const FRshipEmitterProxy* URshipSubsystem::GetEmitterInfo(FString fullTargetId, FString emitterId)
 {
     TArray<Target*> MatchingTargets;
@@ -0,0 +1,185 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "Core/ActionProxy.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Components/PointLightComponent.h"
+#include "Core/RshipRenderStateDirtySet.h"
+#include "Dom/JsonObject.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/ScopeExit.h"
+#include "UObject/Package.h"
+
+namespace RshipActionProxyTests
+{
+	/** Point light registered with a scene, so MarkRenderStateDirty has a visible effect */
+	UPointLightComponent* SpawnLight(UWorld* World)
+	{
+		AActor* Actor = World->SpawnActor<AActor>();
+		UPointLightComponent* Light = NewObject<UPointLightComponent>(Actor);
+		Light->RegisterComponent();
+		return Light;
+	}
+
+	FRshipActionProxy MakePropertyAction(UObject* Owner, const TCHAR* PropertyName)
+	{
+		FProperty* Property = Owner->GetClass()->FindPropertyByName(PropertyName);
+		return FRshipActionProxy::FromProperty(FString::Printf(TEXT("svc:light:%s"), PropertyName), PropertyName, Property, Owner);
+	}
+
+	TSharedRef<FJsonObject> MakeNumber(const TCHAR* Field, double Value)
+	{
+		TSharedRef<FJsonObject> Data = MakeShared<FJsonObject>();
+		Data->SetNumberField(Field, Value);
+		return Data;
+	}
+
+	TSharedRef<FJsonObject> MakeColor(const TCHAR* Field, uint8 R, uint8 G, uint8 B)
+	{
+		TSharedRef<FJsonObject> Color = MakeShared<FJsonObject>();
+		Color->SetNumberField(TEXT("R"), R);
+		Color->SetNumberField(TEXT("G"), G);
+		Color->SetNumberField(TEXT("B"), B);
+		Color->SetNumberField(TEXT("A"), 255);
+
+		TSharedRef<FJsonObject> Data = MakeShared<FJsonObject>();
+		Data->SetObjectField(Field, Color);
+		return Data;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRshipActionProxySetterResolutionTest,
+	"Rship.Exec.ActionProxy.SetterResolution",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipActionProxySetterResolutionTest::RunTest(const FString& Parameters)
+{
+	const UClass* Class = UPointLightComponent::StaticClass();
+	auto SetterName = [Class](const TCHAR* PropertyName) -> FString
+	{
+		const UFunction* Setter = FRshipActionProxy::FindPropertySetter(Class, Class->FindPropertyByName(PropertyName));
+		return Setter ? Setter->GetName() : FString();
+	};
+
+	TestEqual(TEXT("Intensity"), SetterName(TEXT("Intensity")), FString(TEXT("SetIntensity")));
+	TestEqual(TEXT("Temperature"), SetterName(TEXT("Temperature")), FString(TEXT("SetTemperature")));
+	TestEqual(TEXT("Bool prefix stripped"), SetterName(TEXT("bUseTemperature")), FString(TEXT("SetUseTemperature")));
+	TestEqual(TEXT("Inherited setter"), SetterName(TEXT("AttenuationRadius")), FString(TEXT("SetAttenuationRadius")));
+
+	// SetLightColor takes an FLinearColor plus an sRGB flag: not an exact setter for the FColor property
+	TestTrue(TEXT("Mismatched setter rejected"), SetterName(TEXT("LightColor")).IsEmpty());
+	TestNull(TEXT("Null property"), FRshipActionProxy::FindPropertySetter(Class, nullptr));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRshipActionProxyApplyTest,
+	"Rship.Exec.ActionProxy.ApplyValue",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipActionProxyApplyTest::RunTest(const FString& Parameters)
+{
+	using namespace RshipActionProxyTests;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	UPointLightComponent* Light = SpawnLight(World);
+	TestFalse(TEXT("Light starts clean"), Light->IsRenderStateDirty());
+	FRshipRenderStateDirtySet DirtySet;
+
+	const FRshipActionProxy Intensity = MakePropertyAction(Light, TEXT("Intensity"));
+	TestNotNull(TEXT("Intensity routes through its setter"), Intensity.Setter);
+	TestTrue(TEXT("Setter call succeeds"), Intensity.Take(nullptr, MakeNumber(TEXT("Intensity"), 1234.0), &DirtySet));
+	TestEqual(TEXT("Intensity applied"), Light->Intensity, 1234.0f);
+	TestFalse(TEXT("Setter path leaves render state to the setter"), Light->IsRenderStateDirty());
+	TestEqual(TEXT("Setter path queues nothing"), DirtySet.Num(), 0);
+
+	const FRshipActionProxy Color = MakePropertyAction(Light, TEXT("LightColor"));
+	TestNull(TEXT("LightColor is written directly"), Color.Setter);
+	TestTrue(TEXT("Direct write succeeds"), Color.Take(nullptr, MakeColor(TEXT("LightColor"), 10, 20, 30), &DirtySet));
+	TestEqual(TEXT("LightColor applied"), Light->LightColor, FColor(10, 20, 30, 255));
+	TestFalse(TEXT("Direct write defers the render state update"), Light->IsRenderStateDirty());
+
+	DirtySet.Flush();
+	TestTrue(TEXT("Flush marks the render state dirty"), Light->IsRenderStateDirty());
+	TestEqual(TEXT("Flush empties the set"), DirtySet.Num(), 0);
+
+	// Without a dirty set the write marks the component itself
+	Light->DoDeferredRenderUpdates_Concurrent();
+	TestFalse(TEXT("Render state rebuilt"), Light->IsRenderStateDirty());
+	TestTrue(TEXT("Unbatched direct write succeeds"), Color.Take(nullptr, MakeColor(TEXT("LightColor"), 40, 50, 60), nullptr));
+	TestTrue(TEXT("Unbatched direct write marks the render state dirty"), Light->IsRenderStateDirty());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRshipActionProxyBatchRenderStateTest,
+	"Rship.Exec.ActionProxy.BatchedRenderState",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipActionProxyBatchRenderStateTest::RunTest(const FString& Parameters)
+{
+	using namespace RshipActionProxyTests;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	// A 20-action cue over two lights: ten setter calls, ten direct color writes
+	UPointLightComponent* Lights[] = { SpawnLight(World), SpawnLight(World) };
+
+	FRshipRenderStateDirtySet DirtySet;
+	int32 DirectWrites = 0;
+	for (int32 Step = 0; Step < 5; ++Step)
+	{
+		for (UPointLightComponent* Light : Lights)
+		{
+			MakePropertyAction(Light, TEXT("Intensity")).Take(nullptr, MakeNumber(TEXT("Intensity"), 100.0 * (Step + 1)), &DirtySet);
+			MakePropertyAction(Light, TEXT("Temperature")).Take(nullptr, MakeNumber(TEXT("Temperature"), 3000.0 + Step), &DirtySet);
+			if (MakePropertyAction(Light, TEXT("LightColor")).Take(nullptr, MakeColor(TEXT("LightColor"), Step, Step, Step), &DirtySet))
+			{
+				++DirectWrites;
+			}
+		}
+	}
+
+	TestEqual(TEXT("Direct writes in the cue"), DirectWrites, 10);
+	for (UPointLightComponent* Light : Lights)
+	{
+		TestEqual(TEXT("Last intensity wins"), Light->Intensity, 500.0f);
+		TestEqual(TEXT("Last temperature wins"), Light->Temperature, 3004.0f);
+		TestEqual(TEXT("Last color wins"), Light->LightColor, FColor(4, 4, 4, 255));
+
+		// Direct writes only queue the component; nothing is marked until the set flushes
+		TestFalse(TEXT("No render state update during the cue"), Light->IsRenderStateDirty());
+	}
+
+	DirtySet.Flush();
+	for (UPointLightComponent* Light : Lights)
+	{
+		TestTrue(TEXT("Each light marked after the flush"), Light->IsRenderStateDirty());
+		Light->DoDeferredRenderUpdates_Concurrent();
+	}
+
+	DirtySet.Flush();
+	for (UPointLightComponent* Light : Lights)
+	{
+		TestFalse(TEXT("Nothing left for the next tick"), Light->IsRenderStateDirty());
+	}
+
+	return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
@@ -0,0 +1,163 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "Controllers/RshipMaterialParameterCache.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS && WITH_EDITOR
+
+#include "HAL/PlatformTime.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Materials/MaterialExpressionScalarParameter.h"
+#include "Materials/MaterialExpressionVectorParameter.h"
+#include "UObject/Package.h"
+
+namespace RshipMaterialCacheTests
+{
+    /** Build a transient material exposing the first CoveredAliases aliases of every logical parameter. */
+    UMaterial* CreateMaterialWithAliasCoverage(int32 CoveredAliases)
+    {
+        UMaterial* Material = NewObject<UMaterial>(GetTransientPackage(), NAME_None, RF_Transient);
+
+        for (int32 ParamIndex = 0; ParamIndex < static_cast<int32>(ERshipMaterialParam::Count); ++ParamIndex)
+        {
+            const ERshipMaterialParam Param = static_cast<ERshipMaterialParam>(ParamIndex);
+            const TConstArrayView<FName> Aliases = FRshipMaterialParameterCache::GetAliases(Param);
+            const int32 NumToAdd = FMath::Min(CoveredAliases, Aliases.Num());
+
+            for (int32 AliasIndex = 0; AliasIndex < NumToAdd; ++AliasIndex)
+            {
+                if (FRshipMaterialParameterCache::IsVectorParam(Param))
+                {
+                    UMaterialExpressionVectorParameter* Expr = NewObject<UMaterialExpressionVectorParameter>(Material);
+                    Expr->ParameterName = Aliases[AliasIndex];
+                    Material->GetExpressionCollection().AddExpression(Expr);
+                }
+                else
+                {
+                    UMaterialExpressionScalarParameter* Expr = NewObject<UMaterialExpressionScalarParameter>(Material);
+                    Expr->ParameterName = Aliases[AliasIndex];
+                    Material->GetExpressionCollection().AddExpression(Expr);
+                }
+            }
+        }
+
+        Material->PostEditChange();
+        return Material;
+    }
+
+    TArray<UMaterialInstanceDynamic*> CreateMIDs(UMaterial* Material, int32 Count)
+    {
+        TArray<UMaterialInstanceDynamic*> MIDs;
+        for (int32 i = 0; i < Count; ++i)
+        {
+            MIDs.Add(UMaterialInstanceDynamic::Create(Material, GetTransientPackage()));
+        }
+        return MIDs;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipMaterialParameterCacheResolveTest,
+    "Rship.Exec.MaterialParameterCache.ResolvesOnlyPresentAliases",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipMaterialParameterCacheResolveTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipMaterialCacheTests;
+
+    UMaterial* Material = CreateMaterialWithAliasCoverage(1);
+    UMaterialInstanceDynamic* MID = UMaterialInstanceDynamic::Create(Material, GetTransientPackage());
+
+    FRshipMaterialParameterCache Cache;
+    Cache.Build(MID);
+
+    TestTrue(TEXT("Cache valid for its MID"), Cache.IsValidFor(MID));
+    TestEqual(TEXT("BaseColor resolves one alias"), Cache.GetResolvedCount(ERshipMaterialParam::BaseColor), 1);
+    TestEqual(TEXT("SheenColor resolves one alias"), Cache.GetResolvedCount(ERshipMaterialParam::SheenColor), 1);
+
+    Cache.WriteVector(MID, ERshipMaterialParam::BaseColor, FLinearColor(0.25f, 0.5f, 0.75f, 1.0f));
+    FLinearColor ReadBack = FLinearColor::Black;
+    MID->GetVectorParameterValue(FHashedMaterialParameterInfo(FMaterialParameterInfo(TEXT("BaseColor"))), ReadBack);
+    TestEqual(TEXT("Cached vector write lands on the MID"), ReadBack, FLinearColor(0.25f, 0.5f, 0.75f, 1.0f));
+
+    Cache.WriteScalar(MID, ERshipMaterialParam::Roughness, 0.3f);
+    float Roughness = 0.0f;
+    MID->GetScalarParameterValue(FHashedMaterialParameterInfo(FMaterialParameterInfo(TEXT("Roughness"))), Roughness);
+    TestEqual(TEXT("Cached scalar write lands on the MID"), Roughness, 0.3f);
+
+    TestEqual(TEXT("Absent name writes nothing"), Cache.WriteScalarByName(MID, TEXT("DoesNotExist"), 1.0f), 0);
+    TestEqual(TEXT("Present name writes once"), Cache.WriteScalarByName(MID, TEXT("Metallic"), 1.0f), 1);
+
+    // A different parent material invalidates the cache and rebuilds on the next write
+    UMaterial* Other = CreateMaterialWithAliasCoverage(0);
+    UMaterialInstanceDynamic* OtherMID = UMaterialInstanceDynamic::Create(Other, GetTransientPackage());
+    TestFalse(TEXT("Cache is not valid for a different parent"), Cache.IsValidFor(OtherMID));
+    TestEqual(TEXT("Rebuilt cache sees no aliases"), Cache.WriteScalar(OtherMID, ERshipMaterialParam::Roughness, 0.5f), 0);
+    TestTrue(TEXT("Cache now tracks the new parent"), Cache.IsValidFor(OtherMID));
+
+    Cache.Invalidate();
+    TestFalse(TEXT("Explicit invalidation"), Cache.IsValidFor(OtherMID));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipMaterialParameterCacheBenchmark,
+    "Rship.Exec.MaterialParameterCache.Benchmark",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FRshipMaterialParameterCacheBenchmark::RunTest(const FString& Parameters)
+{
+    using namespace RshipMaterialCacheTests;
+
+    constexpr int32 NumMIDs = 20;
+    constexpr int32 Iterations = 500;
+
+    // 0 = no aliases present, 1 = canonical name only, 4 = every alias present
+    for (const int32 Coverage : { 0, 1, 4 })
+    {
+        UMaterial* Material = CreateMaterialWithAliasCoverage(Coverage);
+        TArray<UMaterialInstanceDynamic*> Uncached = CreateMIDs(Material, NumMIDs);
+        TArray<UMaterialInstanceDynamic*> Cached = CreateMIDs(Material, NumMIDs);
+
+        TArray<FRshipMaterialParameterCache> Caches;
+        Caches.SetNum(NumMIDs);
+        for (int32 i = 0; i < NumMIDs; ++i)
+        {
+            Caches[i].Build(Cached[i]);
+        }
+
+        // One "action" = a color write plus an emissive update, as issued by SetEmissive
+        double Start = FPlatformTime::Seconds();
+        for (int32 Iter = 0; Iter < Iterations; ++Iter)
+        {
+            const FLinearColor Color(Iter * 0.001f, 0.5f, 0.5f, 1.0f);
+            for (UMaterialInstanceDynamic* MID : Uncached)
+            {
+                FRshipMaterialParameterCache::WriteVectorUncached(MID, ERshipMaterialParam::EmissiveColor, Color);
+                FRshipMaterialParameterCache::WriteScalarUncached(MID, ERshipMaterialParam::EmissiveIntensity, Color.R);
+            }
+        }
+        const double UncachedUs = (FPlatformTime::Seconds() - Start) * 1e6 / Iterations;
+
+        Start = FPlatformTime::Seconds();
+        for (int32 Iter = 0; Iter < Iterations; ++Iter)
+        {
+            const FLinearColor Color(Iter * 0.001f, 0.5f, 0.5f, 1.0f);
+            for (int32 i = 0; i < NumMIDs; ++i)
+            {
+                Caches[i].WriteVector(Cached[i], ERshipMaterialParam::EmissiveColor, Color);
+                Caches[i].WriteScalar(Cached[i], ERshipMaterialParam::EmissiveIntensity, Color.R);
+            }
+        }
+        const double CachedUs = (FPlatformTime::Seconds() - Start) * 1e6 / Iterations;
+
+        AddInfo(FString::Printf(TEXT("Alias coverage %d, %d MIDs: uncached %.2f us/action, cached %.2f us/action (%.1fx)"),
+            Coverage, NumMIDs, UncachedUs, CachedUs, CachedUs > 0.0 ? UncachedUs / CachedUs : 0.0));
+    }
+
+    return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS && WITH_EDITOR
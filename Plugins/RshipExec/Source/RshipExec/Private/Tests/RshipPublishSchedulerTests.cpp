@@ -0,0 +1,352 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "Controllers/RshipPublishScheduler.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/PlatformTime.h"
+#include "RshipSubsystem.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Transport/RshipMykoTransport.h"
+
+namespace RshipPublishSchedulerTests
+{
+	constexpr double FrameSeconds = 1.0 / 60.0;
+
+	/** Stand-in for a camera controller: the state URshipCameraController publishes. */
+	struct FFakeCamera
+	{
+		FString TargetId;
+		FVector Location = FVector::ZeroVector;
+		FRotator Rotation = FRotator::ZeroRotator;
+		float FocalLength = 35.0f;
+		float Aperture = 2.8f;
+		float FocusDistance = 1000.0f;
+		float HorizontalFov = 60.0f;
+		float VerticalFov = 40.0f;
+		double LastPublishSeconds = 0.0;
+
+		void Animate(int32 Frame, int32 Index)
+		{
+			Location = FVector(Frame + Index, Index, 100.0);
+			Rotation = FRotator(0.0, Frame * 0.5, 0.0);
+			FocalLength = 35.0f + (Frame % 10);
+		}
+
+		void Gather(FRshipPublishBatch& Batch) const
+		{
+			static const TCHAR* const XYZ[] = { TEXT("x"), TEXT("y"), TEXT("z") };
+
+			if (!Batch.BeginSource(TargetId))
+			{
+				return;
+			}
+			Batch.AddVector(TEXT("location"), XYZ, Location.X, Location.Y, Location.Z);
+			Batch.AddVector(TEXT("rotation"), XYZ, Rotation.Pitch, Rotation.Yaw, Rotation.Roll);
+			Batch.AddValue(TEXT("focalLength"), TEXT("value"), FocalLength);
+			Batch.AddValue(TEXT("aperture"), TEXT("value"), Aperture);
+			Batch.AddValue(TEXT("focusDistance"), TEXT("value"), FocusDistance);
+			Batch.AddValue(TEXT("horizontalFov"), TEXT("value"), HorizontalFov);
+			Batch.AddValue(TEXT("verticalFov"), TEXT("value"), VerticalFov);
+		}
+	};
+
+	TArray<FFakeCamera> MakeCameras(int32 Count)
+	{
+		TArray<FFakeCamera> Cameras;
+		Cameras.SetNum(Count);
+		for (int32 i = 0; i < Count; ++i)
+		{
+			Cameras[i].TargetId = FString::Printf(TEXT("service:camera_%d"), i);
+		}
+		return Cameras;
+	}
+
+	FString Serialize(const TSharedPtr<FJsonObject>& Object)
+	{
+		FString Output;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+		FJsonSerializer::Serialize(Object.ToSharedRef(), Writer);
+		return Output;
+	}
+
+	/** Previous scheme: one pulse object and one message per emitter, built inside each component tick. */
+	int32 PublishPerPulse(const FFakeCamera& Camera)
+	{
+		FRshipPublishBatch Single;
+		Camera.Gather(Single);
+
+		int32 Bytes = 0;
+		for (const FRshipPublishSample& Sample : Single.Samples)
+		{
+			FRshipPublishBatch One;
+			One.TargetIds = Single.TargetIds;
+			One.Samples.Add(Sample);
+			One.Samples[0].SourceIndex = 0;
+
+			TArray<TSharedPtr<FJsonObject>> Events;
+			URshipSubsystem::BuildPulseEvents(One, TEXT("bench"), Events);
+			Bytes += Serialize(Events[0]).Len();
+		}
+		return Bytes;
+	}
+
+	/** Current scheme: the frame's samples become one event batch frame. */
+	int32 PublishBatch(const FRshipPublishBatch& Batch)
+	{
+		TArray<TSharedPtr<FJsonObject>> Events;
+		URshipSubsystem::BuildPulseEvents(Batch, TEXT("bench"), Events);
+
+		TArray<TSharedPtr<FJsonValue>> Values;
+		Values.Reserve(Events.Num());
+		for (const TSharedPtr<FJsonObject>& Event : Events)
+		{
+			Values.Add(MakeShared<FJsonValueObject>(Event));
+		}
+
+		TSharedPtr<FJsonObject> Wrapper = MakeShared<FJsonObject>();
+		Wrapper->SetStringField(TEXT("event"), RshipMykoEventNames::EventBatch);
+		Wrapper->SetArrayField(TEXT("data"), Values);
+		return Serialize(Wrapper).Len();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRshipPublishScheduleRateTest,
+	"Rship.Exec.PublishScheduler.RateAndPhaseSpread",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipPublishScheduleRateTest::RunTest(const FString& Parameters)
+{
+	using namespace RshipPublishSchedulerTests;
+
+	constexpr int32 NumSources = 100;
+	constexpr int32 NumFrames = 120;
+
+	FRshipPublishSchedule Schedule;
+	TArray<int32> Handles;
+	for (int32 i = 0; i < NumSources; ++i)
+	{
+		Handles.Add(Schedule.Add(30.0, 0.0));
+	}
+	TestEqual(TEXT("All sources registered"), Schedule.Num(), NumSources);
+
+	TArray<int32> VisitsPerSource;
+	VisitsPerSource.SetNumZeroed(NumSources);
+	int32 MaxPerFrame = 0;
+	int32 MinPerFrame = MAX_int32;
+
+	for (int32 Frame = 1; Frame <= NumFrames; ++Frame)
+	{
+		int32 ThisFrame = 0;
+		Schedule.Run(Frame * FrameSeconds, [&](int32 Handle)
+		{
+			++VisitsPerSource[Handle];
+			++ThisFrame;
+			return true;
+		});
+		MaxPerFrame = FMath::Max(MaxPerFrame, ThisFrame);
+		MinPerFrame = FMath::Min(MinPerFrame, ThisFrame);
+	}
+
+	// 30 Hz over two seconds
+	for (int32 i = 0; i < NumSources; ++i)
+	{
+		if (!TestTrue(FString::Printf(TEXT("Source %d published about 60 times (%d)"), i, VisitsPerSource[i]),
+			FMath::Abs(VisitsPerSource[i] - 60) <= 1))
+		{
+			break;
+		}
+	}
+
+	// Without phase offsets all 100 would fire on one frame and none on the next
+	TestTrue(FString::Printf(TEXT("Load is spread across frames (max %d, min %d)"), MaxPerFrame, MinPerFrame),
+		MaxPerFrame <= 60 && MinPerFrame >= 40);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRshipPublishScheduleBudgetTest,
+	"Rship.Exec.PublishScheduler.BudgetDefersOldestFirst",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipPublishScheduleBudgetTest::RunTest(const FString& Parameters)
+{
+	FRshipPublishSchedule Schedule;
+	for (int32 i = 0; i < 10; ++i)
+	{
+		Schedule.Add(10.0, 0.0);
+	}
+
+	// Everything is due after one interval; the "budget" allows four per frame
+	const double Now = 0.1;
+	TArray<int32> FirstFrame;
+	int32 Served = Schedule.Run(Now, [&FirstFrame](int32 Handle)
+	{
+		if (FirstFrame.Num() == 4)
+		{
+			return false;
+		}
+		FirstFrame.Add(Handle);
+		return true;
+	});
+	TestEqual(TEXT("Budget stops after four"), Served, 4);
+	TestEqual(TEXT("Six remain due"), Schedule.NumDue(Now), 6);
+
+	TArray<int32> SecondFrame;
+	Served = Schedule.Run(Now + 0.001, [&SecondFrame](int32 Handle)
+	{
+		SecondFrame.Add(Handle);
+		return true;
+	});
+	TestEqual(TEXT("Deferred sources go next frame"), Served, 6);
+	for (const int32 Handle : SecondFrame)
+	{
+		TestFalse(TEXT("Served sources are not repeated before their next interval"), FirstFrame.Contains(Handle));
+	}
+
+	// Removed handles are never visited and their slot is reused
+	const int32 Removed = SecondFrame[0];
+	Schedule.Remove(Removed);
+	TestFalse(TEXT("Removed handle is invalid"), Schedule.IsValidHandle(Removed));
+	bool bVisitedRemoved = false;
+	Schedule.Run(1.0, [&bVisitedRemoved, Removed](int32 Handle)
+	{
+		bVisitedRemoved |= Handle == Removed;
+		return true;
+	});
+	TestFalse(TEXT("Removed source is not visited"), bVisitedRemoved);
+	TestEqual(TEXT("Freed slot is reused"), Schedule.Add(10.0, 1.0), Removed);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRshipPublishBatchEventsTest,
+	"Rship.Exec.PublishScheduler.BatchBuildsPulseEvents",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipPublishBatchEventsTest::RunTest(const FString& Parameters)
+{
+	static const TCHAR* const XYZ[] = { TEXT("x"), TEXT("y"), TEXT("z") };
+
+	FRshipPublishBatch Batch;
+	TestFalse(TEXT("Empty target id is rejected"), Batch.BeginSource(FString()));
+
+	TestTrue(TEXT("Source accepted"), Batch.BeginSource(TEXT("svc:cam")));
+	Batch.AddVector(TEXT("location"), XYZ, 1.0, 2.0, 3.0);
+	Batch.AddBool(TEXT("onActiveChanged"), TEXT("Value"), true);
+
+	TArray<TSharedPtr<FJsonObject>> Events;
+	URshipSubsystem::BuildPulseEvents(Batch, TEXT("machine"), Events);
+	if (!TestEqual(TEXT("One event per sample"), Events.Num(), 2))
+	{
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> EventData;
+	TestTrue(TEXT("Event is a Myko event"), FRshipMykoTransport::TryGetMykoEventData(Events[0], EventData));
+	const TSharedPtr<FJsonObject> Item = EventData->GetObjectField(TEXT("item"));
+	TestEqual(TEXT("Item type"), EventData->GetStringField(TEXT("itemType")), FString(TEXT("Pulse")));
+	TestEqual(TEXT("Emitter id joins target and emitter"), Item->GetStringField(TEXT("emitterId")), FString(TEXT("svc:cam:location")));
+	TestEqual(TEXT("Vector field"), Item->GetObjectField(TEXT("data"))->GetNumberField(TEXT("z")), 3.0);
+
+	FRshipMykoTransport::TryGetMykoEventData(Events[1], EventData);
+	TestTrue(TEXT("Bool samples serialize as bool"),
+		EventData->GetObjectField(TEXT("item"))->GetObjectField(TEXT("data"))->GetBoolField(TEXT("Value")));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRshipPublishSchedulerBenchmark,
+	"Rship.Exec.PublishScheduler.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FRshipPublishSchedulerBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace RshipPublishSchedulerTests;
+
+	// Two seconds of a 60 fps world with cameras publishing at 30 Hz
+	constexpr int32 NumFrames = 120;
+	constexpr double RateHz = 30.0;
+
+	for (const int32 NumCameras : { 250, 1000, 3000 })
+	{
+		TArray<FFakeCamera> Cameras = MakeCameras(NumCameras);
+
+		// Previous scheme: every controller ticks, checks its own interval and
+		// builds and serializes a message per emitter
+		double TotalBefore = 0.0;
+		double WorstBefore = 0.0;
+		int64 BytesBefore = 0;
+		for (int32 Frame = 1; Frame <= NumFrames; ++Frame)
+		{
+			const double Now = Frame * FrameSeconds;
+			const double Start = FPlatformTime::Seconds();
+			for (int32 i = 0; i < Cameras.Num(); ++i)
+			{
+				FFakeCamera& Camera = Cameras[i];
+				Camera.Animate(Frame, i);
+				if (Now - Camera.LastPublishSeconds < 1.0 / RateHz)
+				{
+					continue;
+				}
+				Camera.LastPublishSeconds = Now;
+				BytesBefore += PublishPerPulse(Camera);
+			}
+			const double FrameUs = (FPlatformTime::Seconds() - Start) * 1e6;
+			TotalBefore += FrameUs;
+			WorstBefore = FMath::Max(WorstBefore, FrameUs);
+		}
+
+		// Current scheme: due controllers are gathered into one batch and
+		// serialized once per frame
+		FRshipPublishSchedule Schedule;
+		for (int32 i = 0; i < NumCameras; ++i)
+		{
+			Schedule.Add(RateHz, 0.0);
+		}
+
+		FRshipPublishBatch Batch;
+		double TotalAfter = 0.0;
+		double WorstAfter = 0.0;
+		int64 BytesAfter = 0;
+		for (int32 Frame = 1; Frame <= NumFrames; ++Frame)
+		{
+			const double Now = Frame * FrameSeconds;
+			const double Start = FPlatformTime::Seconds();
+			Batch.Reset();
+			Schedule.Run(Now, [&Cameras, &Batch, Frame](int32 Handle)
+			{
+				FFakeCamera& Camera = Cameras[Handle];
+				Camera.Animate(Frame, Handle);
+				Camera.Gather(Batch);
+				return true;
+			});
+			if (Batch.Samples.Num() > 0)
+			{
+				BytesAfter += PublishBatch(Batch);
+			}
+			const double FrameUs = (FPlatformTime::Seconds() - Start) * 1e6;
+			TotalAfter += FrameUs;
+			WorstAfter = FMath::Max(WorstAfter, FrameUs);
+		}
+
+		AddInfo(FString::Printf(
+			TEXT("%d cameras @ %.0f Hz: per-component %.0f us/frame (worst %.0f, %lld bytes), scheduled batch %.0f us/frame (worst %.0f, %lld bytes)"),
+			NumCameras, RateHz,
+			TotalBefore / NumFrames, WorstBefore, BytesBefore,
+			TotalAfter / NumFrames, WorstAfter, BytesAfter));
+	}
+
+	AddInfo(TEXT("Per-component figures exclude the engine's tick-function dispatch, which the scheduler also removes."));
+	return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
@@ -0,0 +1,383 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "Core/RshipRegistrationQueue.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Dom/JsonObject.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeExit.h"
+#include "RshipActorRegistrationComponent.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Transport/RshipMykoTransport.h"
+#include "UObject/Package.h"
+
+namespace RshipRegistrationQueueTests
+{
+	UObject* MakeObject()
+	{
+		return NewObject<UObject>(GetTransientPackage());
+	}
+
+	AActor* SpawnLabeled(UWorld* World, const TCHAR* Label)
+	{
+		AActor* Actor = World->SpawnActor<AActor>();
+#if WITH_EDITOR
+		Actor->SetActorLabel(Label);
+#endif
+		return Actor;
+	}
+
+	FString GetOutlinerName(const AActor* Actor)
+	{
+#if WITH_EDITOR
+		return Actor->GetActorLabel();
+#else
+		return Actor->GetName();
+#endif
+	}
+
+	/** Enqueue a registration component the way URshipSubsystem::QueueTargetRegistration does. */
+	void EnqueueTarget(FRshipRegistrationQueue& Queue, URshipActorRegistrationComponent* Component)
+	{
+		Component->ResolveDefaultTargetId();
+		Queue.Enqueue(Component, Component->GetFullTargetId(), Component->GetFullParentTargetIds());
+	}
+
+	void Spin(double Seconds)
+	{
+		const double End = FPlatformTime::Seconds() + Seconds;
+		while (FPlatformTime::Seconds() < End)
+		{
+		}
+	}
+
+	/**
+	 * Generated stand-in for a loaded level: actors arranged in a parent tree,
+	 * each with one registration entry and a number of controllers under it.
+	 */
+	struct FGeneratedLevel
+	{
+		TArray<UObject*> Objects;
+		TArray<FString> TargetIds;
+		TArray<FString> ParentIds;
+		TMap<UObject*, int32> IndexByObject;
+
+		void Generate(int32 NumActors, int32 ControllersPerActor, int32 Fanout)
+		{
+			for (int32 Actor = 0; Actor < NumActors; ++Actor)
+			{
+				const FString ActorId = FString::Printf(TEXT("svc:actor-%d"), Actor);
+				const FString ParentId = Actor > 0 ? FString::Printf(TEXT("svc:actor-%d"), (Actor - 1) / Fanout) : FString();
+				Add(ActorId, ParentId);
+
+				for (int32 Controller = 0; Controller < ControllersPerActor; ++Controller)
+				{
+					Add(FString(), ActorId);
+				}
+			}
+		}
+
+		/** Enqueue in reverse, the worst case for dependency order: children arrive before parents. */
+		void EnqueueAll(FRshipRegistrationQueue& Queue) const
+		{
+			for (int32 Index = Objects.Num() - 1; Index >= 0; --Index)
+			{
+				TArray<FString> Parents;
+				if (!ParentIds[Index].IsEmpty())
+				{
+					Parents.Add(ParentIds[Index]);
+				}
+				Queue.Enqueue(Objects[Index], TargetIds[Index], MoveTemp(Parents));
+			}
+		}
+
+	private:
+		void Add(const FString& TargetId, const FString& ParentId)
+		{
+			UObject* Object = MakeObject();
+			IndexByObject.Add(Object, Objects.Num());
+			Objects.Add(Object);
+			TargetIds.Add(TargetId);
+			ParentIds.Add(ParentId);
+		}
+	};
+
+	/** Representative registration cost: the target, action and emitter envelopes a controller sends. */
+	int32 SimulateRegistration(const FString& TargetId)
+	{
+		TArray<TSharedPtr<FJsonValue>> Events;
+		for (int32 Item = 0; Item < 6; ++Item)
+		{
+			TSharedPtr<FJsonObject> Record = MakeShared<FJsonObject>();
+			Record->SetStringField(TEXT("id"), FString::Printf(TEXT("%s:item-%d"), *TargetId, Item));
+			Record->SetStringField(TEXT("targetId"), TargetId);
+			Record->SetStringField(TEXT("name"), TEXT("Item"));
+			Record->SetObjectField(TEXT("schema"), MakeShared<FJsonObject>());
+			Events.Add(MakeShared<FJsonValueObject>(FRshipMykoTransport::MakeSet(TEXT("Action"), Record, TEXT("machine"))));
+		}
+
+		TSharedRef<FJsonObject> Batch = MakeShared<FJsonObject>();
+		Batch->SetArrayField(TEXT("events"), Events);
+
+		FString Json;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		FJsonSerializer::Serialize(Batch, Writer);
+		return Json.Len();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRshipRegistrationQueueDedupeTest,
+	"Rship.Exec.RegistrationQueue.Dedupe",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipRegistrationQueueDedupeTest::RunTest(const FString& Parameters)
+{
+	using namespace RshipRegistrationQueueTests;
+
+	FRshipRegistrationQueue Queue;
+	UObject* A = MakeObject();
+	UObject* B = MakeObject();
+
+	TestTrue(TEXT("First enqueue adds"), Queue.Enqueue(A, TEXT("svc:a"), {}));
+	TestFalse(TEXT("Second enqueue folds"), Queue.Enqueue(A, TEXT("svc:a"), {}));
+	TestTrue(TEXT("Other object adds"), Queue.Enqueue(B, FString(), { TEXT("svc:a") }));
+	TestEqual(TEXT("Two pending"), Queue.Num(), 2);
+
+	TArray<UObject*> Served;
+	Queue.ProcessSlice(1.0, [&Served](UObject* Object) { Served.Add(Object); });
+	TestEqual(TEXT("Each object served once"), Served.Num(), 2);
+	TestEqual(TEXT("Queue drained"), Queue.Num(), 0);
+
+	const FRshipRegistrationProgress Progress = Queue.GetProgress();
+	TestEqual(TEXT("Completed counter"), Progress.Completed, 2);
+	TestEqual(TEXT("Deduplicated counter"), Progress.Deduplicated, 1);
+	TestEqual(TEXT("One slice"), Progress.Slices, 1);
+	TestEqual(TEXT("Nothing pending"), Progress.Pending, 0);
+
+	// Removal drops a pending entry; re-enqueue from inside Register is served on a later slice
+	Queue.Enqueue(A, TEXT("svc:a"), {});
+	Queue.Enqueue(B, FString(), {});
+	TestTrue(TEXT("Remove pending"), Queue.Remove(B));
+	TestFalse(TEXT("Remove twice"), Queue.Remove(B));
+
+	int32 ServedA = 0;
+	Queue.ProcessSlice(1.0, [&Queue, &ServedA, A](UObject* Object)
+	{
+		if (Object == A && ++ServedA == 1)
+		{
+			Queue.Enqueue(A, TEXT("svc:a"), {});
+		}
+	});
+	TestEqual(TEXT("Re-enqueued object served once this slice"), ServedA, 1);
+	TestEqual(TEXT("Re-enqueued object pending"), Queue.Num(), 1);
+	Queue.ProcessSlice(1.0, [&ServedA](UObject*) { ++ServedA; });
+	TestEqual(TEXT("Re-enqueued object served next slice"), ServedA, 2);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRshipRegistrationQueueOrderTest,
+	"Rship.Exec.RegistrationQueue.ParentBeforeChild",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipRegistrationQueueOrderTest::RunTest(const FString& Parameters)
+{
+	using namespace RshipRegistrationQueueTests;
+
+	FGeneratedLevel Level;
+	Level.Generate(200, 3, 3);
+
+	FRshipRegistrationQueue Queue;
+	Level.EnqueueAll(Queue);
+
+	TSet<FString> Registered;
+	int32 Violations = 0;
+	int32 Served = 0;
+	while (Queue.Num() > 0)
+	{
+		Served += Queue.ProcessSlice(1.0, [&](UObject* Object)
+		{
+			const int32 Index = Level.IndexByObject.FindChecked(Object);
+			const FString& ParentId = Level.ParentIds[Index];
+			if (!ParentId.IsEmpty() && !Registered.Contains(ParentId))
+			{
+				++Violations;
+			}
+			if (!Level.TargetIds[Index].IsEmpty())
+			{
+				Registered.Add(Level.TargetIds[Index]);
+			}
+		});
+	}
+
+	TestEqual(TEXT("Every entry served"), Served, Level.Objects.Num());
+	TestEqual(TEXT("No child served before its parent"), Violations, 0);
+
+	// A parent cycle must not stall the queue
+	UObject* A = MakeObject();
+	UObject* B = MakeObject();
+	Queue.Enqueue(A, TEXT("svc:a"), { TEXT("svc:b") });
+	Queue.Enqueue(B, TEXT("svc:b"), { TEXT("svc:a") });
+	TestEqual(TEXT("Cycle drains"), Queue.ProcessSlice(1.0, [](UObject*) {}), 2);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRshipRegistrationQueueDefaultTargetIdTest,
+	"Rship.Exec.RegistrationQueue.DefaultTargetIds",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipRegistrationQueueDefaultTargetIdTest::RunTest(const FString& Parameters)
+{
+	using namespace RshipRegistrationQueueTests;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	// Two owners with no Target Id set, and a child that names one of them by label
+	AActor* StageLeft = SpawnLabeled(World, TEXT("Stage Left"));
+	AActor* StageRight = SpawnLabeled(World, TEXT("Stage Right"));
+	AActor* Fixture = SpawnLabeled(World, TEXT("Fixture"));
+
+	URshipActorRegistrationComponent* Left = NewObject<URshipActorRegistrationComponent>(StageLeft);
+	URshipActorRegistrationComponent* Right = NewObject<URshipActorRegistrationComponent>(StageRight);
+	URshipActorRegistrationComponent* Child = NewObject<URshipActorRegistrationComponent>(Fixture);
+	Child->ParentTargetIds.Add(GetOutlinerName(StageLeft));
+
+	// Children arrive first; the controller stands in for one on Stage Left, keyed like the subsystem keys it
+	FRshipRegistrationQueue Queue;
+	EnqueueTarget(Queue, Child);
+	UObject* LeftController = MakeObject();
+	Left->ResolveDefaultTargetId();
+	Queue.Enqueue(LeftController, FString(), { Left->GetFullTargetId() });
+	EnqueueTarget(Queue, Left);
+	EnqueueTarget(Queue, Right);
+
+	TestNotEqual(TEXT("Unnamed owners get distinct ids"), Left->GetFullTargetId(), Right->GetFullTargetId());
+	TestTrue(TEXT("Default id is the outliner label"), Left->GetFullTargetId().EndsWith(TEXT(":") + GetOutlinerName(StageLeft)));
+	TestEqual(TEXT("Child parent id matches the owner's id"), Child->GetFullParentTargetIds(), TArray<FString>{ Left->GetFullTargetId() });
+
+	TArray<UObject*> Served;
+	while (Queue.Num() > 0)
+	{
+		Queue.ProcessSlice(1.0, [&Served](UObject* Object) { Served.Add(Object); });
+	}
+
+	TestEqual(TEXT("Every entry served"), Served.Num(), 4);
+	TestTrue(TEXT("Labelled parent before its child"), Served.IndexOfByKey(Left) < Served.IndexOfByKey(Child));
+	TestTrue(TEXT("Owner before its controller"), Served.IndexOfByKey(Left) < Served.IndexOfByKey(LeftController));
+	TestTrue(TEXT("Unrelated owner not held back"), Served.IndexOfByKey(Right) < Served.IndexOfByKey(Child));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRshipRegistrationQueueBudgetTest,
+	"Rship.Exec.RegistrationQueue.BudgetSlicing",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipRegistrationQueueBudgetTest::RunTest(const FString& Parameters)
+{
+	using namespace RshipRegistrationQueueTests;
+
+	constexpr int32 NumObjects = 60;
+	constexpr double CostSeconds = 0.0002;
+	constexpr double BudgetSeconds = 0.001;
+
+	FRshipRegistrationQueue Queue;
+	for (int32 i = 0; i < NumObjects; ++i)
+	{
+		Queue.Enqueue(MakeObject(), FString(), {});
+	}
+
+	int32 Slices = 0;
+	int32 MaxPerSlice = 0;
+	int32 Total = 0;
+	while (Queue.Num() > 0)
+	{
+		const int32 Served = Queue.ProcessSlice(BudgetSeconds, [](UObject*) { Spin(CostSeconds); });
+		TestTrue(TEXT("Every slice makes progress"), Served > 0);
+		MaxPerSlice = FMath::Max(MaxPerSlice, Served);
+		Total += Served;
+		++Slices;
+	}
+
+	// A slice stops once the budget is spent, so it can overrun by at most one entry
+	const int32 MaxExpected = FMath::CeilToInt(BudgetSeconds / CostSeconds);
+	TestEqual(TEXT("All entries served"), Total, NumObjects);
+	TestTrue(TEXT("Work spread over several slices"), Slices >= NumObjects / MaxExpected);
+	TestTrue(TEXT("No slice exceeds the budget by more than one entry"), MaxPerSlice <= MaxExpected);
+	TestEqual(TEXT("Slice counter"), Queue.GetProgress().Slices, Slices);
+
+	// Even a zero budget serves one entry per slice
+	Queue.Enqueue(MakeObject(), FString(), {});
+	Queue.Enqueue(MakeObject(), FString(), {});
+	TestEqual(TEXT("Zero budget still progresses"), Queue.ProcessSlice(0.0, [](UObject*) {}), 1);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRshipRegistrationQueueLevelBenchmark,
+	"Rship.Exec.RegistrationQueue.LevelLoadBenchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FRshipRegistrationQueueLevelBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace RshipRegistrationQueueTests;
+
+	constexpr int32 ControllersPerActor = 2;
+	constexpr double BudgetSeconds = 0.004;
+
+	for (const int32 NumControllers : { 300, 3000, 9000 })
+	{
+		FGeneratedLevel Level;
+		Level.Generate(NumControllers / ControllersPerActor, ControllersPerActor, 4);
+
+		// Previous scheme: one deferred ticker per component, all firing on the first frame
+		int32 Checksum = 0;
+		double Start = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < Level.Objects.Num(); ++Index)
+		{
+			Checksum += SimulateRegistration(Level.TargetIds[Index]);
+		}
+		const double BurstMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+
+		// Current scheme: one queue served in budgeted slices
+		FRshipRegistrationQueue Queue;
+		Start = FPlatformTime::Seconds();
+		Level.EnqueueAll(Queue);
+		const double EnqueueMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+
+		double WorstFrameMs = 0.0;
+		int32 Frames = 0;
+		while (Queue.Num() > 0)
+		{
+			const double FrameStart = FPlatformTime::Seconds();
+			Queue.ProcessSlice(BudgetSeconds, [&Level, &Checksum](UObject* Object)
+			{
+				Checksum += SimulateRegistration(Level.TargetIds[Level.IndexByObject.FindChecked(Object)]);
+			});
+			WorstFrameMs = FMath::Max(WorstFrameMs, (FPlatformTime::Seconds() - FrameStart) * 1000.0);
+			++Frames;
+		}
+
+		AddInfo(FString::Printf(TEXT("%d controllers (%d entries): single-frame burst %.2f ms; sliced worst frame %.2f ms over %d frames, enqueue %.2f ms (checksum %d)"),
+			NumControllers, Level.Objects.Num(), BurstMs, WorstFrameMs, Frames, EnqueueMs, Checksum));
+	}
+
+	return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
@@ -0,0 +1,205 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "Controllers/RshipRigStateBuffer.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Async/Async.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+namespace RshipRigStateBufferTests
+{
+	/** Snapshot where every slot carries the publish sequence number, so a torn read is detectable. */
+	void FillSnapshot(FRshipRigOverrideSnapshot& Snapshot, int32 NumSlots, uint32 Sequence)
+	{
+		Snapshot.LayoutVersion = Sequence;
+		Snapshot.Slots.SetNum(NumSlots);
+		for (int32 i = 0; i < NumSlots; ++i)
+		{
+			FRshipRigOverrideSlot& Slot = Snapshot.Slots[i];
+			Slot.Key = FRigElementKey(FName(TEXT("bone"), i), ERigElementType::Bone);
+			Slot.Rotation = FQuat(static_cast<float>(Sequence), 0.0f, 0.0f, 1.0f);
+			Slot.bActive = true;
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRshipRigTripleBufferBasicTest,
+	"Rship.Exec.RigStateBuffer.PublishAndAcquire",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipRigTripleBufferBasicTest::RunTest(const FString& Parameters)
+{
+	TRshipTripleBuffer<int32> Buffer;
+
+	TestFalse(TEXT("Nothing pending initially"), Buffer.Acquire());
+
+	Buffer.GetWriteBuffer() = 1;
+	Buffer.Publish();
+	Buffer.GetWriteBuffer() = 2;
+	Buffer.Publish();
+
+	TestTrue(TEXT("Pending after publish"), Buffer.Acquire());
+	TestEqual(TEXT("Reader sees newest snapshot"), Buffer.GetReadBuffer(), 2);
+	TestFalse(TEXT("No new snapshot after acquire"), Buffer.Acquire());
+	TestEqual(TEXT("Read buffer is stable"), Buffer.GetReadBuffer(), 2);
+
+	Buffer.GetWriteBuffer() = 3;
+	Buffer.Publish();
+	TestTrue(TEXT("Third publish visible"), Buffer.Acquire());
+	TestEqual(TEXT("Reader sees third snapshot"), Buffer.GetReadBuffer(), 3);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRshipRigTripleBufferStressTest,
+	"Rship.Exec.RigStateBuffer.MultithreadedStress",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipRigTripleBufferStressTest::RunTest(const FString& Parameters)
+{
+	using namespace RshipRigStateBufferTests;
+
+	constexpr int32 NumSlots = 64;
+	constexpr uint32 NumPublishes = 200000;
+
+	TRshipTripleBuffer<FRshipRigOverrideSnapshot> Buffer;
+	std::atomic<bool> bWriterDone { false };
+
+	// Writer: game thread stand-in publishing as fast as possible
+	TFuture<void> Writer = Async(EAsyncExecution::Thread, [&Buffer, &bWriterDone]()
+	{
+		for (uint32 Sequence = 1; Sequence <= NumPublishes; ++Sequence)
+		{
+			FillSnapshot(Buffer.GetWriteBuffer(), NumSlots, Sequence);
+			Buffer.Publish();
+		}
+		bWriterDone.store(true, std::memory_order_release);
+	});
+
+	// Reader: rig evaluation stand-in; every snapshot must be complete and never go backwards
+	uint32 LastSeen = 0;
+	int32 TornReads = 0;
+	int32 Regressions = 0;
+	int32 Acquired = 0;
+	for (;;)
+	{
+		const bool bDone = bWriterDone.load(std::memory_order_acquire);
+		if (Buffer.Acquire())
+		{
+			++Acquired;
+			const FRshipRigOverrideSnapshot& Snapshot = Buffer.GetReadBuffer();
+			const uint32 Sequence = Snapshot.LayoutVersion;
+			if (Sequence < LastSeen)
+			{
+				++Regressions;
+			}
+			LastSeen = Sequence;
+
+			if (Snapshot.Slots.Num() != NumSlots)
+			{
+				++TornReads;
+				continue;
+			}
+			for (const FRshipRigOverrideSlot& Slot : Snapshot.Slots)
+			{
+				if (static_cast<uint32>(Slot.Rotation.X) != Sequence)
+				{
+					++TornReads;
+					break;
+				}
+			}
+		}
+		else if (bDone)
+		{
+			break;
+		}
+	}
+
+	Writer.Wait();
+
+	TestEqual(TEXT("No torn snapshots"), TornReads, 0);
+	TestEqual(TEXT("Snapshots never go backwards"), Regressions, 0);
+	TestEqual(TEXT("Reader ends on the final snapshot"), LastSeen, NumPublishes);
+	AddInfo(FString::Printf(TEXT("Reader acquired %d of %u published snapshots"), Acquired, NumPublishes));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRshipRigStateBufferBenchmark,
+	"Rship.Exec.RigStateBuffer.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FRshipRigStateBufferBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace RshipRigStateBufferTests;
+
+	// 20 characters at 120 Hz for ten seconds, with a changing override every evaluation
+	constexpr int32 NumCharacters = 20;
+	constexpr int32 NumEvaluations = 1200;
+
+	for (const int32 NumOverrides : { 8, 64, 256 })
+	{
+		// Previous scheme: map under a mutex, copied out on every evaluation
+		FCriticalSection Mutex;
+		TMap<FName, FQuat> Overrides;
+		for (int32 i = 0; i < NumOverrides; ++i)
+		{
+			Overrides.Add(FName(TEXT("bone"), i), FQuat::Identity);
+		}
+
+		double Checksum = 0.0;
+		double Start = FPlatformTime::Seconds();
+		for (int32 Eval = 0; Eval < NumEvaluations * NumCharacters; ++Eval)
+		{
+			{
+				FScopeLock Lock(&Mutex);
+				Overrides.Add(FName(TEXT("bone"), Eval % NumOverrides), FQuat(static_cast<float>(Eval), 0.0f, 0.0f, 1.0f));
+			}
+
+			TMap<FName, FQuat> Copy;
+			{
+				FScopeLock Lock(&Mutex);
+				Copy = Overrides;
+			}
+			for (const TPair<FName, FQuat>& Pair : Copy)
+			{
+				Checksum += Pair.Value.X;
+			}
+		}
+		const double MapUs = (FPlatformTime::Seconds() - Start) * 1e6 / (NumEvaluations * NumCharacters);
+
+		// Current scheme: flat slots published through the triple buffer, read in place
+		TRshipTripleBuffer<FRshipRigOverrideSnapshot> Buffer;
+		FRshipRigOverrideSnapshot Authoritative;
+		FillSnapshot(Authoritative, NumOverrides, 0);
+
+		Start = FPlatformTime::Seconds();
+		for (int32 Eval = 0; Eval < NumEvaluations * NumCharacters; ++Eval)
+		{
+			Authoritative.Slots[Eval % NumOverrides].Rotation = FQuat(static_cast<float>(Eval), 0.0f, 0.0f, 1.0f);
+			Buffer.GetWriteBuffer() = Authoritative;
+			Buffer.Publish();
+
+			Buffer.Acquire();
+			for (const FRshipRigOverrideSlot& Slot : Buffer.GetReadBuffer().Slots)
+			{
+				Checksum += Slot.Rotation.X;
+			}
+		}
+		const double BufferUs = (FPlatformTime::Seconds() - Start) * 1e6 / (NumEvaluations * NumCharacters);
+
+		AddInfo(FString::Printf(TEXT("%d overrides: locked map copy %.3f us/eval, triple buffer %.3f us/eval (checksum %.0f)"),
+			NumOverrides, MapUs, BufferUs, Checksum));
+	}
+
+	return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
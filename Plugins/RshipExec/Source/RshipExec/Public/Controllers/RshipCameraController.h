@@ -16,7 +16,18 @@ class RSHIPEXEC_API URshipCameraController : public URshipControllerComponent
 	GENERATED_BODY()
 
 public:
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void BeginPlay() override;
+	virtual void GatherPublishState(FRshipPublishBatch& Batch) override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	UFUNCTION(BlueprintCallable, Category = "Rship|Camera")
+	void SetPublishStateEmitters(bool bEnable);
+
+	UFUNCTION(BlueprintCallable, Category = "Rship|Camera")
+	void SetPublishRateHz(int32 RateHz);
 
 	UFUNCTION()
 	void SetFieldOfViewAction(float Value);
@@ -36,10 +47,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Camera")
 	bool bIncludeCineCameraProperties = true;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Camera")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetPublishStateEmitters, Category = "Rship|Camera")
 	bool bPublishStateEmitters = true;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Camera", meta = (ClampMin = "1", ClampMax = "120"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetPublishRateHz, Category = "Rship|Camera", meta = (ClampMin = "1", ClampMax = "120"))
 	int32 PublishRateHz = 30;
 
 	UPROPERTY(BlueprintAssignable, Category = "Rship|Camera|Emitters")
@@ -64,12 +75,12 @@ public:
 	FRshipCameraVectorEmitter OnRotationChanged;
 
 private:
-	virtual void OnBeforeRegisterRshipTargets() override;
 	virtual void RegisterOrRefreshTarget() override;
 	FString GetTargetId() const;
 	UCameraComponent* ResolveCameraComponent() const;
 	UCineCameraComponent* ResolveCineCameraComponent() const;
-	void PublishState();
+	void ApplyPublishRate();
 
-	double LastPublishTimeSeconds = 0.0;
+	// Parent target id captured at registration so publishing never re-resolves identity
+	FString PublishTargetId;
 };
@@ -7,6 +7,7 @@
 #include "RshipControllerComponent.generated.h"
 
 class URshipSubsystem;
+struct FRshipPublishBatch;
 
 UCLASS(Abstract)
 class RSHIPEXEC_API URshipControllerComponent : public UActorComponent, public IRshipTargetContributor
@@ -16,8 +17,12 @@ class RSHIPEXEC_API URshipControllerComponent : public UActorComponent, public I
 public:
 	virtual void OnRegister() override;
 	virtual void OnUnregister() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void RegisterRshipTargets() override;
 
+	/** Append emitter state to Batch. Called by URshipPublishScheduler at the rate set with SetPublishRate. */
+	virtual void GatherPublishState(FRshipPublishBatch& Batch) {}
+
 protected:
 	virtual void OnBeforeRegisterRshipTargets();
 	virtual void RegisterOrRefreshTarget() PURE_VIRTUAL(URshipControllerComponent::RegisterOrRefreshTarget, );
@@ -25,7 +30,9 @@ protected:
 	FRshipTargetProxy ResolveParentTarget() const;
 	FRshipTargetProxy ResolveChildTarget(const FString& RequestedSuffix, const FString& DefaultSuffix) const;
 
+	/** Publish through the world's URshipPublishScheduler at RateHz; 0 stops publishing. */
+	void SetPublishRate(double RateHz);
+
 private:
-	void ScheduleDeferredRegisterRshipTargets();
-	void ScheduleOwnerRegistrationRefresh();
+	void QueueOwnerRegistrationRefresh();
 };
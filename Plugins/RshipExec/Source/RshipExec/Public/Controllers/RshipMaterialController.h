@@ -5,6 +5,7 @@
 
 #include "CoreMinimal.h"
 #include "Controllers/RshipControllerComponent.h"
+#include "Controllers/RshipMaterialParameterCache.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "RshipMaterialController.generated.h"
 
@@ -41,7 +42,7 @@ public:
     // UActorComponent interface
     virtual void BeginPlay() override;
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
-    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+    virtual void GatherPublishState(FRshipPublishBatch& Batch) override;
 
     // ========================================================================
     // CONFIGURATION
@@ -63,7 +64,7 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Material")
     bool bAutoCreateDynamicMaterials = true;
 
-    /** Enable tick for smoothed parameters */
+    /** Publish material state through the world's publish scheduler */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Material")
     bool bEnableTick = true;
 
@@ -75,6 +76,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Material")
     bool bOnlyPublishOnChange = true;
 
+    /** Resolve parameter aliases once per material and write through cached slots (disable to write every alias by name) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Material", AdvancedDisplay)
+    bool bUseParameterCache = true;
+
     // ========================================================================
     //  ACTIONS - Generic Parameter Control
     // ========================================================================
@@ -264,6 +269,10 @@ public:
     UFUNCTION()
     void RefreshMaterials();
 
+    /** Drop resolved parameter slots (call after changing a controlled material's parent) */
+    UFUNCTION()
+    void InvalidateParameterCache();
+
     /** Get all dynamic material instances being controlled */
     UFUNCTION()
     TArray<UMaterialInstanceDynamic*> GetDynamicMaterials() const { return DynamicMaterials; }
@@ -292,9 +301,13 @@ private:
     UPROPERTY()
     TArray<UMaterialInstanceDynamic*> DynamicMaterials;
 
+    // Parameter resolution per entry in DynamicMaterials (same indexing)
+    TArray<FRshipMaterialParameterCache> ParameterCaches;
+
+    // Target id captured at registration so publishing never re-resolves identity
+    FString PublishTargetId;
+
     // State tracking for change detection
-    double LastPublishTime = 0.0;
-    double PublishInterval = 0.1;
     FLinearColor LastBaseColor = FLinearColor::Black;
     FLinearColor LastEmissiveColor = FLinearColor::Black;
     float LastEmissiveIntensity = 0.0f;
@@ -311,7 +324,9 @@ private:
 
     void SetupMaterials();
 
-    void ReadAndPublishState();
+    void WriteScalarParam(ERshipMaterialParam Param, float Value);
+    void WriteVectorParam(ERshipMaterialParam Param, const FLinearColor& Value);
+
     bool HasColorChanged(const FLinearColor& OldColor, const FLinearColor& NewColor, float Threshold = 0.001f) const;
     bool HasValueChanged(float OldValue, float NewValue, float Threshold = 0.001f) const;
     void CacheDefaultValues();
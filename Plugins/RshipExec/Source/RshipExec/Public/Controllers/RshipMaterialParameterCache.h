@@ -0,0 +1,125 @@
+// Rship Material Parameter Cache
+// Per-MID resolution of logical material parameters to concrete parameter slots
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MaterialTypes.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UMaterialInstanceDynamic;
+class UMaterialInterface;
+
+/**
+ * Logical parameters written by URshipMaterialController actions.
+ * Each one maps to a list of alias names ("BaseColor", "Base Color", ...)
+ * that different material authors use for the same input.
+ */
+enum class ERshipMaterialParam : uint8
+{
+    // Vector parameters
+    BaseColor,
+    EmissiveColor,
+    UVTiling,
+    UVOffset,
+    UVPivot,
+    SubsurfaceColor,
+    SheenColor,
+
+    // Scalar parameters
+    EmissiveIntensity,
+    Roughness,
+    Metallic,
+    Specular,
+    Opacity,
+    OpacityMask,
+    AmbientOcclusion,
+    NormalIntensity,
+    TilingU,
+    TilingV,
+    OffsetU,
+    OffsetV,
+    UVRotation,
+    SubsurfaceIntensity,
+    ClearCoat,
+    ClearCoatRoughness,
+
+    Count
+};
+
+/**
+ * Resolution cache for one dynamic material instance.
+ *
+ * Built once per MID: every alias of every logical parameter is checked
+ * against the parameters the material actually exposes, and the ones that
+ * exist are bound to their override slot index. Setters then write through
+ * SetScalarParameterByIndex/SetVectorParameterByIndex and never search for
+ * names the material does not have.
+ *
+ * The cache is keyed on the MID's parent material; a parent change or a
+ * rejected indexed write rebuilds it on the next access.
+ */
+class RSHIPEXEC_API FRshipMaterialParameterCache
+{
+public:
+    /** Alias names written for a logical parameter, in write order. */
+    static TConstArrayView<FName> GetAliases(ERshipMaterialParam Param);
+
+    /** True if the logical parameter is a vector (color) parameter. */
+    static bool IsVectorParam(ERshipMaterialParam Param);
+
+    /** Reference path without a cache: writes every alias by name. */
+    static void WriteScalarUncached(UMaterialInstanceDynamic* MID, ERshipMaterialParam Param, float Value);
+    static void WriteVectorUncached(UMaterialInstanceDynamic* MID, ERshipMaterialParam Param, const FLinearColor& Value);
+
+    /** Resolve all logical parameters against MID. */
+    void Build(UMaterialInstanceDynamic* MID);
+
+    /** Drop all bindings; the next write rebuilds. */
+    void Invalidate();
+
+    /** True if the cache was built for MID's current parent material. */
+    bool IsValidFor(const UMaterialInstanceDynamic* MID) const;
+
+    /** Write a logical parameter through its cached slots. Returns the number of slots written. */
+    int32 WriteScalar(UMaterialInstanceDynamic* MID, ERshipMaterialParam Param, float Value);
+    int32 WriteVector(UMaterialInstanceDynamic* MID, ERshipMaterialParam Param, const FLinearColor& Value);
+
+    /** Write an arbitrary named parameter; names are resolved lazily and remembered, including absence. */
+    int32 WriteScalarByName(UMaterialInstanceDynamic* MID, FName ParameterName, float Value);
+    int32 WriteVectorByName(UMaterialInstanceDynamic* MID, FName ParameterName, const FLinearColor& Value);
+
+    /** Number of aliases of Param present on the material this cache was built for. */
+    int32 GetResolvedCount(ERshipMaterialParam Param) const;
+
+private:
+    struct FBinding
+    {
+        FMaterialParameterInfo Info;
+        int32 Index = INDEX_NONE;
+    };
+
+    struct FRange
+    {
+        uint16 Start = 0;
+        uint16 Num = 0;
+    };
+
+    void EnsureBuilt(UMaterialInstanceDynamic* MID);
+    int32 ResolveScalar(UMaterialInstanceDynamic* MID, FName ParameterName);
+    int32 ResolveVector(UMaterialInstanceDynamic* MID, FName ParameterName);
+
+    TWeakObjectPtr<UMaterialInterface> Parent;
+    TArray<FBinding> Bindings;
+    FRange Ranges[static_cast<int32>(ERshipMaterialParam::Count)];
+
+    // Parameter names the material exposes (global association only)
+    TSet<FName> ScalarNames;
+    TSet<FName> VectorNames;
+
+    // Resolved override slot per name; INDEX_NONE records a known-absent name
+    TMap<FName, int32> ScalarIndexByName;
+    TMap<FName, int32> VectorIndexByName;
+
+    bool bBuilt = false;
+};
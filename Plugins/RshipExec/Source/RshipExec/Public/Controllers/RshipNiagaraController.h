@@ -33,9 +33,10 @@ public:
 protected:
     virtual void BeginPlay() override;
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
-    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 public:
+    virtual void GatherPublishState(FRshipPublishBatch& Batch) override;
+
     // ========================================================================
     // CONFIGURATION
     // ========================================================================
@@ -288,9 +289,10 @@ public:
 private:
     virtual void RegisterOrRefreshTarget() override;
 
+    // Target id captured at registration so publishing never re-resolves identity
+    FString PublishTargetId;
+
     // State tracking for change detection and emitter publishing
-    double LastPublishTime = 0.0;
-    double PublishInterval = 0.1;
     float GlobalIntensityMultiplier = 1.0f;
     float LastSpawnRate = 1.0f;
     float LastLifetime = 1.0f;
@@ -303,7 +305,6 @@ private:
     bool bLastActive = false;
     int32 LastParticleCount = 0;
 
-    void ReadAndPublishState();
     bool HasValueChanged(float OldValue, float NewValue, float Threshold = 0.001f) const;
     bool HasColorChanged(const FLinearColor& OldColor, const FLinearColor& NewColor, float Threshold = 0.001f) const;
 };
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RshipPublishScheduler.generated.h"
+
+class URshipControllerComponent;
+
+/** How the values of a gathered sample are written into the pulse payload. */
+enum class ERshipPublishValueKind : uint8
+{
+	Number,
+	Bool
+};
+
+/**
+ * One emitter pulse gathered from a controller, kept as plain values until the
+ * batch is serialized. Emitter and field names point at static literals so
+ * gathering allocates nothing beyond the batch arrays.
+ */
+struct FRshipPublishSample
+{
+	static constexpr int32 MaxValues = 4;
+
+	int32 SourceIndex = INDEX_NONE;
+	const TCHAR* EmitterName = nullptr;
+	const TCHAR* FieldNames[MaxValues] = {};
+	double Values[MaxValues] = {};
+	uint8 NumValues = 0;
+	ERshipPublishValueKind Kind = ERshipPublishValueKind::Number;
+};
+
+/**
+ * Emitter state gathered from all controllers due in one frame.
+ *
+ * Controllers call BeginSource() once with their target id and then add one
+ * sample per emitter; the scheduler hands the whole batch to
+ * URshipSubsystem::PulseEmitterBatch, which serializes it as one event batch.
+ */
+struct RSHIPEXEC_API FRshipPublishBatch
+{
+	TArray<FString> TargetIds;
+	TArray<FRshipPublishSample> Samples;
+
+	void Reset();
+
+	/** Start adding samples for TargetId. Returns false (and adds nothing) if TargetId is empty. */
+	bool BeginSource(const FString& TargetId);
+
+	void AddValue(const TCHAR* EmitterName, const TCHAR* FieldName, double Value);
+	void AddBool(const TCHAR* EmitterName, const TCHAR* FieldName, bool bValue);
+	void AddVector(const TCHAR* EmitterName, const TCHAR* const (&FieldNames)[3], double X, double Y, double Z);
+	void AddColor(const TCHAR* EmitterName, const TCHAR* const (&FieldNames)[3], const FLinearColor& Color);
+
+private:
+	FRshipPublishSample& AddSample(const TCHAR* EmitterName, ERshipPublishValueKind Kind);
+};
+
+/**
+ * Publish deadlines for a set of sources, independent of any UObject.
+ *
+ * Each source has an interval and a next-due time kept in a min-heap, so a
+ * frame only touches sources that are actually due. New sources start at a
+ * golden-ratio phase within their interval, which spreads controllers that
+ * share a rate evenly across frames instead of firing them together.
+ */
+class RSHIPEXEC_API FRshipPublishSchedule
+{
+public:
+	/** Add a source publishing at RateHz. Returns a handle for Remove/SetRate. */
+	int32 Add(double RateHz, double NowSeconds);
+
+	void Remove(int32 Handle);
+	void SetRate(int32 Handle, double RateHz, double NowSeconds);
+
+	bool IsValidHandle(int32 Handle) const;
+	int32 Num() const { return NumActive; }
+
+	/** Number of sources whose deadline is at or before NowSeconds. Walks only the due part of the heap. */
+	int32 NumDue(double NowSeconds) const;
+
+	/**
+	 * Visit due sources, most overdue first. Visit(Handle) returns false to
+	 * leave that source due and stop for this frame (e.g. budget exhausted).
+	 * @return Number of sources served.
+	 */
+	template<typename FunctorType>
+	int32 Run(double NowSeconds, FunctorType&& Visit)
+	{
+		int32 Served = 0;
+		while (Heap.Num() > 0 && Heap.HeapTop().DueSeconds <= NowSeconds)
+		{
+			FHeapNode Node;
+			Heap.HeapPop(Node, EAllowShrinking::No);
+			if (!IsCurrent(Node))
+			{
+				continue;
+			}
+
+			if (!Visit(Node.Handle))
+			{
+				Heap.HeapPush(Node);
+				break;
+			}
+
+			// The visitor may have removed or re-rated its own source
+			if (IsCurrent(Node))
+			{
+				Reschedule(Node.Handle, NowSeconds);
+			}
+			++Served;
+		}
+		return Served;
+	}
+
+private:
+	struct FEntry
+	{
+		double IntervalSeconds = 0.0;
+		double DueSeconds = 0.0;
+		uint32 Generation = 0;
+		bool bActive = false;
+	};
+
+	struct FHeapNode
+	{
+		double DueSeconds = 0.0;
+		int32 Handle = INDEX_NONE;
+		uint32 Generation = 0;
+
+		bool operator<(const FHeapNode& Other) const { return DueSeconds < Other.DueSeconds; }
+	};
+
+	bool IsCurrent(const FHeapNode& Node) const
+	{
+		const FEntry& Entry = Entries[Node.Handle];
+		return Entry.bActive && Entry.Generation == Node.Generation;
+	}
+
+	void Push(int32 Handle);
+	void Reschedule(int32 Handle, double NowSeconds);
+
+	TArray<FEntry> Entries;
+	TArray<int32> FreeHandles;
+	TArray<FHeapNode> Heap;
+	int32 NumActive = 0;
+	uint32 PhaseCounter = 0;
+};
+
+/** Counters from the most recent publish frame. */
+USTRUCT(BlueprintType)
+struct RSHIPEXEC_API FRshipPublishFrameStats
+{
+	GENERATED_BODY()
+
+	/** Controllers that published this frame */
+	UPROPERTY(BlueprintReadOnly, Category = "Rship|Publish")
+	int32 Published = 0;
+
+	/** Controllers that were due but pushed to the next frame by the budget */
+	UPROPERTY(BlueprintReadOnly, Category = "Rship|Publish")
+	int32 Deferred = 0;
+
+	/** Emitter samples serialized this frame */
+	UPROPERTY(BlueprintReadOnly, Category = "Rship|Publish")
+	int32 Samples = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Rship|Publish")
+	float GatherMicroseconds = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Rship|Publish")
+	float SerializeMicroseconds = 0.0f;
+};
+
+/**
+ * Publishes emitter state for all controllers in a world from a single tick.
+ *
+ * Controllers register with a publish rate instead of ticking themselves.
+ * Every frame the scheduler gathers state from the controllers that are due
+ * into one FRshipPublishBatch and serializes it in one pass, stopping early
+ * when the frame's publish budget (URshipSettings::ControllerPublishBudgetMicroseconds)
+ * is spent. Controllers skipped by the budget stay due and go first next frame.
+ */
+UCLASS()
+class RSHIPEXEC_API URshipPublishScheduler : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Add or update a controller's publish rate. RateHz <= 0 unregisters it. */
+	void RegisterController(URshipControllerComponent* Controller, double RateHz);
+	void UnregisterController(URshipControllerComponent* Controller);
+
+	/** Gather and send one frame at NowSeconds (Tick uses the platform clock). */
+	void PublishFrame(double NowSeconds);
+
+	/** Override the settings budget (0 = use settings). */
+	void SetBudgetMicroseconds(double InBudgetMicroseconds) { BudgetOverrideMicroseconds = InBudgetMicroseconds; }
+
+	UFUNCTION(BlueprintCallable, Category = "Rship|Publish")
+	int32 GetRegisteredControllerCount() const { return Schedule.Num(); }
+
+	UFUNCTION(BlueprintCallable, Category = "Rship|Publish")
+	FRshipPublishFrameStats GetLastFrameStats() const { return LastFrameStats; }
+
+private:
+	double GetBudgetMicroseconds() const;
+
+	FRshipPublishSchedule Schedule;
+	TMap<TWeakObjectPtr<URshipControllerComponent>, int32> HandleByController;
+	TArray<TWeakObjectPtr<URshipControllerComponent>> ControllerByHandle;
+
+	FRshipPublishBatch Batch;
+	FRshipPublishFrameStats LastFrameStats;
+	double SerializeMicrosecondsPerSample = 1.0;
+	double BudgetOverrideMicroseconds = 0.0;
+};
@@ -1,9 +1,12 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "HAL/CriticalSection.h"
+#include "Containers/Queue.h"
 #include "Controllers/RshipControllerComponent.h"
+#include "Controllers/RshipRigStateBuffer.h"
+#include "Rigs/RigHierarchyCache.h"
 #include "Rigs/RigHierarchyElements.h"
+#include <atomic>
 #include "RshipRigController.generated.h"
 
 class UControlRigComponent;
@@ -138,21 +141,58 @@ private:
 	bool bRigComponentConfigured = false;
 
 	UPROPERTY(Transient)
-	TMap<FName, FQuat> BoneRotationOverrides;
+	TSet<FName> LoggedDiagnosticElements;
 
-	UPROPERTY(Transient)
-	TMap<FName, FQuat> ControlRotationOverrides;
+	// Attach/remove requests from the game thread, consumed by the rig evaluation
+	struct FRshipRigAttachCommand
+	{
+		enum class EType : uint8
+		{
+			Attach,
+			Remove,
+			Clear,
+			ClearAll
+		};
 
-	UPROPERTY(Transient)
-	TSet<FName> LoggedDiagnosticElements;
+		EType Type = EType::Attach;
+		FName BoneName;
+		FRshipRigAttachTarget Target;
+		float BlendSeconds = 0.0f;
+	};
+
+	// State owned by whichever thread evaluates the rig; never touched by the game thread
+	struct FRshipRigEvaluationState
+	{
+		const URigHierarchy* Hierarchy = nullptr;
+		uint32 TopologyVersion = MAX_uint32;
+		uint32 LayoutVersion = MAX_uint32;
+		TArray<FCachedRigElement> OverrideElements;
+		TMap<FName, FRshipRigAttachState> AttachStates;
+	};
+
+	// Game thread: authoritative overrides and their slot lookup
+	FRshipRigOverrideSnapshot GameThreadOverrides;
+	TMap<FRigElementKey, int32> OverrideSlotByKey;
+	bool bOverridesDirty = false;
+
+	// Game thread -> evaluation thread
+	TRshipTripleBuffer<FRshipRigOverrideSnapshot> PublishedOverrides;
+	TQueue<FRshipRigAttachCommand, EQueueMode::Mpsc> PendingAttachCommands;
+	std::atomic<float> LastTickDeltaTime { 0.0f };
 
-	mutable FCriticalSection RigStateMutex;
-	TMap<FName, FRshipRigAttachState> BoneAttachStates;
-	float LastTickDeltaTime = 0.0f;
+	// Evaluation thread
+	FRshipRigEvaluationState EvaluationState;
+	std::atomic<bool> bEvaluating { false };
 
 	friend class URshipRigBoneActionProxy;
 	friend struct FRigUnit_RshipApplyPendingRigState;
-	void CopyPendingRigState(TMap<FName, FQuat>& OutBoneRotations, TMap<FName, FQuat>& OutControlRotations, TMap<FName, FRshipRigAttachState>& OutAttachStates, float& OutDeltaTime);
-	void CommitPendingAttachStates(const TMap<FName, FRshipRigAttachState>& UpdatedStates, const TArray<FName>& ChildrenToRemove, const TArray<FName>& ChildrenToPersist);
+	void SetRotationOverride(const FRigElementKey& Key, const FQuat& Rotation);
+	void ClearRotationOverride(const FName& ElementName);
+	void ClearAllRotationOverrides();
+	/** Copy GameThreadOverrides to the evaluation side if they changed since the last publish. */
+	void PublishOverrides();
+	void EvaluatePendingRigState(URigHierarchy* Hierarchy, UControlRig* EvaluatingRig);
+	void ApplyAttachCommand(URigHierarchy* Hierarchy, const FRshipRigAttachCommand& Command);
+	void RefreshEvaluationCache(URigHierarchy* Hierarchy, const FRshipRigOverrideSnapshot& Overrides);
 
 };
@@ -0,0 +1,103 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Rigs/RigHierarchyDefines.h"
+#include <atomic>
+
+/**
+ * Lock-free triple buffer for publishing whole snapshots from one thread to another.
+ *
+ * The writer fills GetWriteBuffer() and calls Publish(); the reader calls Acquire()
+ * and then reads GetReadBuffer(), which always holds the most recent complete
+ * snapshot. Neither side ever blocks, and a snapshot is never torn.
+ *
+ * Thread Safety:
+ * - Exactly one thread may call GetWriteBuffer()/Publish() (writer)
+ * - Exactly one thread at a time may call Acquire()/GetReadBuffer() (reader)
+ *
+ * After Publish() the writer receives a stale buffer, so each publish must
+ * overwrite the write buffer completely.
+ */
+template<typename T>
+class TRshipTripleBuffer
+{
+public:
+	TRshipTripleBuffer()
+		: Shared(2)
+	{
+	}
+
+	/** Buffer the writer fills before the next Publish() (writer thread only). */
+	T& GetWriteBuffer()
+	{
+		return Buffers[WriteIndex];
+	}
+
+	/** Make the write buffer the latest snapshot (writer thread only). */
+	void Publish()
+	{
+		// Release makes the buffer contents visible before the reader can claim it
+		const uint32 Previous = Shared.exchange(WriteIndex | DirtyBit, std::memory_order_acq_rel);
+		WriteIndex = Previous & IndexMask;
+	}
+
+	/**
+	 * Adopt the newest published snapshot (reader thread only).
+	 * @return True if a new snapshot was published since the last call.
+	 */
+	bool Acquire()
+	{
+		if ((Shared.load(std::memory_order_relaxed) & DirtyBit) == 0)
+		{
+			return false;
+		}
+
+		const uint32 Previous = Shared.exchange(ReadIndex, std::memory_order_acq_rel);
+		ReadIndex = Previous & IndexMask;
+		return true;
+	}
+
+	/** Snapshot adopted by the last Acquire() (reader thread only). */
+	const T& GetReadBuffer() const
+	{
+		return Buffers[ReadIndex];
+	}
+
+	/** True if a snapshot is waiting for the reader. */
+	bool HasPending() const
+	{
+		return (Shared.load(std::memory_order_acquire) & DirtyBit) != 0;
+	}
+
+private:
+	static constexpr uint32 IndexMask = 0x3;
+	static constexpr uint32 DirtyBit = 0x4;
+
+	T Buffers[3];
+	alignas(64) std::atomic<uint32> Shared;  // Index of the middle buffer + dirty flag
+	alignas(64) uint32 WriteIndex = 0;       // Owned by writer
+	alignas(64) uint32 ReadIndex = 1;        // Owned by reader
+};
+
+/** One rotation override for a bone or control, addressed by a stable slot index. */
+struct FRshipRigOverrideSlot
+{
+	FRigElementKey Key;
+	FQuat Rotation = FQuat::Identity;
+	bool bActive = false;
+};
+
+/**
+ * Flat snapshot of all rotation overrides published by the game thread.
+ *
+ * Slots are append-only between resets so a slot index stays valid for the
+ * reader's cached rig elements; LayoutVersion changes whenever slots are added
+ * or cleared, which tells the reader to re-resolve its element cache.
+ */
+struct FRshipRigOverrideSnapshot
+{
+	uint32 LayoutVersion = 0;
+	TArray<FRshipRigOverrideSlot> Slots;
+};
@@ -6,6 +6,7 @@
 class AActor;
 class UFunction;
 class FProperty;
+class FRshipRenderStateDirtySet;
 
 struct RSHIPEXEC_API FRshipActionProxy
 {
@@ -14,6 +15,9 @@ struct RSHIPEXEC_API FRshipActionProxy
 	FString FunctionName;
 	TWeakObjectPtr<UObject> Owner;
 	FProperty* Property = nullptr;
+
+	/** Native setter for Property (e.g. SetIntensity for Intensity), called instead of writing the property. */
+	UFunction* Setter = nullptr;
 	TSharedPtr<TDoubleLinkedList<SchemaNode>> Props = MakeShared<TDoubleLinkedList<SchemaNode>>();
 
 	static FRshipActionProxy FromFunction(const FString& InId, const FString& InName, UFunction* InFunction, UObject* InOwner);
@@ -23,4 +27,20 @@ struct RSHIPEXEC_API FRshipActionProxy
 	UObject* GetOwnerObject() const { return Owner.Get(); }
 	TSharedPtr<FJsonObject> GetSchema() const;
 	bool Take(AActor* Actor, const TSharedRef<FJsonObject>& Data) const;
+
+	/**
+	 * Apply the action. Property writes that have no setter mark the owning component
+	 * in RenderStateDirtySet, or immediately when it is null.
+	 */
+	bool Take(AActor* Actor, const TSharedRef<FJsonObject>& Data, FRshipRenderStateDirtySet* RenderStateDirtySet) const;
+
+	/**
+	 * Find the setter for Property on Class: a UFunction named Set<Name> (Set<Name without b>
+	 * for bools) taking exactly one parameter of the property's type.
+	 */
+	static UFunction* FindPropertySetter(const UClass* Class, const FProperty* Property);
+
+private:
+	bool CallSetter(UObject* OwnerObject, const FString& ArgList) const;
+	bool WriteProperty(UObject* OwnerObject, const FString& ArgList, FRshipRenderStateDirtySet* RenderStateDirtySet) const;
 };
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/SparseArray.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtr.h"
+#include "RshipRegistrationQueue.generated.h"
+
+/** Progress counters for deferred target registration. */
+USTRUCT(BlueprintType)
+struct RSHIPEXEC_API FRshipRegistrationProgress
+{
+	GENERATED_BODY()
+
+	/** Components waiting to register */
+	UPROPERTY(BlueprintReadOnly, Category = "Rship|Registration")
+	int32 Pending = 0;
+
+	/** Components registered since the last reset */
+	UPROPERTY(BlueprintReadOnly, Category = "Rship|Registration")
+	int32 Completed = 0;
+
+	/** Requests folded into an entry that was already pending */
+	UPROPERTY(BlueprintReadOnly, Category = "Rship|Registration")
+	int32 Deduplicated = 0;
+
+	/** Frames that registered at least one component */
+	UPROPERTY(BlueprintReadOnly, Category = "Rship|Registration")
+	int32 Slices = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Rship|Registration")
+	float LastSliceMilliseconds = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Rship|Registration")
+	float WorstSliceMilliseconds = 0.0f;
+};
+
+/**
+ * Deduplicated, dependency-ordered queue of objects waiting to register rship targets.
+ *
+ * Each entry names the target it provides and the targets it hangs under.
+ * Entries are served parent before child: an entry whose parent target is
+ * also pending waits until that parent has been served. Enqueuing an object
+ * that is already pending updates its dependencies instead of adding a second
+ * entry. ProcessSlice serves entries until a time budget is spent, so a level
+ * full of components registers over several frames instead of one.
+ */
+class RSHIPEXEC_API FRshipRegistrationQueue
+{
+public:
+	/**
+	 * Add Object, or update it if already pending.
+	 * @param TargetId Full id of the target Object provides (may be empty).
+	 * @param ParentTargetIds Full ids of targets that must register first.
+	 * @return False if Object was already pending.
+	 */
+	bool Enqueue(UObject* Object, const FString& TargetId, TArray<FString> ParentTargetIds);
+
+	/** Drop Object if pending (e.g. it was registered through another path). */
+	bool Remove(const UObject* Object);
+
+	bool Contains(const UObject* Object) const { return SlotByKey.Contains(FObjectKey(Object)); }
+	int32 Num() const { return SlotByKey.Num(); }
+
+	/** Drop all pending entries and clear the counters. */
+	void Reset();
+
+	/** Clear the counters, keeping pending entries. */
+	void ResetProgress();
+
+	FRshipRegistrationProgress GetProgress() const;
+
+	/**
+	 * Serve pending entries in dependency order until BudgetSeconds have elapsed.
+	 * At least one entry is served per call. Register(UObject*) may enqueue or
+	 * remove entries, including the one being served. Objects that were
+	 * garbage collected while pending are dropped without counting.
+	 * @return Number of entries served.
+	 */
+	template<typename FunctorType>
+	int32 ProcessSlice(double BudgetSeconds, FunctorType&& Register)
+	{
+		if (SlotByKey.Num() == 0)
+		{
+			return 0;
+		}
+
+		const double StartSeconds = FPlatformTime::Seconds();
+		if (bOrderDirty)
+		{
+			RebuildOrder();
+		}
+
+		int32 Served = 0;
+		int32 Cursor = 0;
+		while (Cursor < Order.Num())
+		{
+			const FOrderNode Node = Order[Cursor++];
+			if (!IsCurrent(Node))
+			{
+				continue;
+			}
+
+			// Release the slot before serving so Register can re-enqueue the same object
+			const TWeakObjectPtr<UObject> WeakObject = Entries[Node.Slot].Object;
+			ReleaseSlot(Node.Slot);
+
+			if (UObject* Object = WeakObject.Get())
+			{
+				Register(Object);
+				++Served;
+			}
+
+			if (FPlatformTime::Seconds() - StartSeconds >= BudgetSeconds)
+			{
+				break;
+			}
+		}
+		Order.RemoveAt(0, Cursor, EAllowShrinking::No);
+
+		if (Served > 0)
+		{
+			const float SliceMilliseconds = static_cast<float>((FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+			Progress.Completed += Served;
+			Progress.Slices++;
+			Progress.LastSliceMilliseconds = SliceMilliseconds;
+			Progress.WorstSliceMilliseconds = FMath::Max(Progress.WorstSliceMilliseconds, SliceMilliseconds);
+		}
+		return Served;
+	}
+
+private:
+	struct FEntry
+	{
+		FObjectKey Key;
+		TWeakObjectPtr<UObject> Object;
+		FString TargetId;
+		TArray<FString> ParentTargetIds;
+		int32 Depth = 0;
+		uint32 Sequence = 0;
+	};
+
+	/** Order holds sequence-stamped slots so entries removed (and slots reused) mid-slice are skipped. */
+	struct FOrderNode
+	{
+		int32 Slot = INDEX_NONE;
+		uint32 Sequence = 0;
+	};
+
+	bool IsCurrent(const FOrderNode& Node) const
+	{
+		return Entries.IsValidIndex(Node.Slot) && Entries[Node.Slot].Sequence == Node.Sequence;
+	}
+
+	void ReleaseSlot(int32 Slot);
+	void RebuildOrder();
+	int32 ResolveDepth(int32 Slot, const TMap<FString, int32>& SlotByTargetId, TMap<int32, int32>& DepthBySlot) const;
+
+	TSparseArray<FEntry> Entries;
+	TMap<FObjectKey, int32> SlotByKey;
+	TArray<FOrderNode> Order;
+	uint32 NextSequence = 0;
+	bool bOrderDirty = false;
+	FRshipRegistrationProgress Progress;
+};
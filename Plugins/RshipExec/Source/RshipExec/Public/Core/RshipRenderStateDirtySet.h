@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UActorComponent;
+
+/**
+ * Components whose properties were written directly (no setter) and need their
+ * render state rebuilt. Writes are collected over a frame and flushed once, so
+ * a cue that changes ten light parameters recreates render state once instead
+ * of ten times.
+ */
+class RSHIPEXEC_API FRshipRenderStateDirtySet
+{
+public:
+	void Add(UActorComponent* Component);
+
+	int32 Num() const { return Pending.Num(); }
+
+	/**
+	 * Call MarkRenderStateDirty once on every pending component that is still alive.
+	 * @return Number of components flushed.
+	 */
+	int32 Flush();
+
+private:
+	TSet<TWeakObjectPtr<UActorComponent>> Pending;
+};
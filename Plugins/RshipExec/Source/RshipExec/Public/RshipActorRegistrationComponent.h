@@ -42,6 +42,12 @@ public:
 	UFUNCTION(BlueprintPure, Category = "RshipActorRegistration")
 	FString GetFullTargetId() const;
 
+	/** ParentTargetIds qualified with the service id, as sent with the target. */
+	TArray<FString> GetFullParentTargetIds() const;
+
+	/** Default an unset (or still auto-generated) Target Id to the owner's outliner label, as Register does. */
+	void ResolveDefaultTargetId();
+
 	FRshipTargetProxy GetTargetProxy() const;
 
 	UFUNCTION(BlueprintPure, Category = "RshipActorRegistration")
@@ -253,4 +253,14 @@ public:
         ClampMin = "0.001", ClampMax = "1.0",
         ToolTip = "How often to process the message queue. Lower values = more responsive but higher CPU. Default 0.016 (~60Hz)."))
     float QueueProcessInterval = 0.016f;
+
+    UPROPERTY(EditAnywhere, config, Category = "Processing", meta = (DisplayName = "Controller Publish Budget (Microseconds)",
+        ClampMin = "50", ClampMax = "16000",
+        ToolTip = "Per-frame time budget for gathering and serializing controller emitter state. Controllers that do not fit are published first on the next frame."))
+    int32 ControllerPublishBudgetMicroseconds = 1000;
+
+    UPROPERTY(EditAnywhere, config, Category = "Processing", meta = (DisplayName = "Registration Budget (Milliseconds)",
+        ClampMin = "0.5", ClampMax = "50.0",
+        ToolTip = "Per-frame time budget for deferred target registration. Components that do not fit register on following frames, parents before children."))
+    float RegistrationBudgetMilliseconds = 4.0f;
 };
@@ -12,6 +12,8 @@
 
 // Forward declaration for optional SpatialAudio plugin
 class URshipSpatialAudioManager;
+struct FRshipPublishBatch;
+class URshipControllerComponent;
 #if RSHIP_HAS_DISPLAY_CLUSTER
 class UPrimitiveComponent;
 class USceneComponent;
@@ -19,6 +21,8 @@ class ADisplayClusterRootActor;
 #endif
 #include "Containers/List.h"
 #include "Containers/Ticker.h"
+#include "Core/RshipRegistrationQueue.h"
+#include "Core/RshipRenderStateDirtySet.h"
 #include "Core/Target.h"
 #include "Network/RshipRateLimiter.h"
 #include "Network/RshipWebSocket.h"
@@ -170,9 +174,12 @@ class RSHIPEXEC_API URshipSubsystem : public UEngineSubsystem
     FTSTicker::FDelegateHandle SubsystemTickerHandle;
     FTSTicker::FDelegateHandle ConnectionTimeoutTickerHandle;
     FTSTicker::FDelegateHandle DeferredOnDataReceivedTickerHandle;
+    FTSTicker::FDelegateHandle RegistrationTickerHandle;
     double LastTickTime;
     // Components that had successful Take() calls this frame; flushed once per tick.
     TSet<TWeakObjectPtr<URshipActorRegistrationComponent>> PendingOnDataReceivedComponents;
+    // Components written by property actions without a setter; render state rebuilt once per tick.
+    FRshipRenderStateDirtySet RenderStateDirtySet;
     TMap<FString, FRshipPendingExecTargetAction> PendingExecTargetActions;
     TArray<FRshipPendingBatchTargetAction> PendingBatchTargetActions;
 
@@ -219,6 +226,7 @@ class RSHIPEXEC_API URshipSubsystem : public UEngineSubsystem
     bool OnSubsystemTick(float DeltaTime);
     bool OnConnectionTimeoutTick(float DeltaTime);
     bool OnDeferredOnDataReceivedTick(float DeltaTime);
+    bool OnRegistrationTick(float DeltaTime);
 
     // Internal message handling
     void SetItem(FString itemType, TSharedPtr<FJsonObject> data, ERshipMessagePriority Priority = ERshipMessagePriority::Normal, const FString& CoalesceKey = TEXT(""));
@@ -282,6 +290,11 @@ class RSHIPEXEC_API URshipSubsystem : public UEngineSubsystem
     int32 RegistrationBatchDepth = 0;
     TArray<TSharedPtr<FJsonObject>> PendingRegistrationEvents;
 
+    // Components waiting for deferred registration, served parent-first within a per-frame budget
+    FRshipRegistrationQueue RegistrationQueue;
+    void EnsureRegistrationTicker();
+    void ServeQueuedRegistration(UObject* Object);
+
     // Rolling websocket send stats for diagnosing replay/backpressure behavior.
     double LastWebSocketSendStatsLogTime = 0.0;
     int64 WebSocketSendAttemptsSinceLastLog = 0;
@@ -350,6 +363,10 @@ public:
     void RefreshTargetCache();
 
     void PulseEmitter(FString TargetId, FString EmitterId, TSharedPtr<FJsonObject> data);
+    // Pulse every sample in Batch as a single event batch (used by URshipPublishScheduler).
+    void PulseEmitterBatch(const FRshipPublishBatch& Batch);
+    // Build the Myko "Pulse" set events for Batch without queueing them.
+    static void BuildPulseEvents(const FRshipPublishBatch& Batch, const FString& SourceId, TArray<TSharedPtr<FJsonObject>>& OutEvents);
 	void SendAll();
 
 	const FRshipEmitterProxy* GetEmitterInfo(FString targetId, FString emitterId);
@@ -395,6 +412,18 @@ public:
     // Queue OnRshipData broadcast for end-of-frame dispatch.
     void QueueOnDataReceived(URshipActorRegistrationComponent* Component);
 
+    // Components awaiting the end-of-frame MarkRenderStateDirty after direct property writes.
+    FRshipRenderStateDirtySet& GetRenderStateDirtySet() { return RenderStateDirtySet; }
+
+    // Queue deferred target registration. Duplicate requests for a pending component are folded
+    // together; the queue is served parent-first, one registration batch per frame, within
+    // URshipSettings::RegistrationBudgetMilliseconds.
+    void QueueTargetRegistration(URshipActorRegistrationComponent* Component);
+    void QueueTargetRegistration(URshipControllerComponent* Controller);
+
+    // Serve one budgeted registration slice now. Returns the number of components registered.
+    int32 ProcessRegistrationSlice(double BudgetSeconds);
+
     FString GetServiceId();
     FString GetInstanceId();
     /** Get the Spatial Audio manager for loudspeaker management and spatialization.
@@ -492,6 +521,16 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Rship|Diagnostics")
     void ResetRateLimiterStats();
 
+    // Deferred registration progress
+    UFUNCTION(BlueprintCallable, Category = "Rship|Diagnostics")
+    int32 GetPendingRegistrationCount() const;
+
+    UFUNCTION(BlueprintCallable, Category = "Rship|Diagnostics")
+    FRshipRegistrationProgress GetRegistrationProgress() const;
+
+    UFUNCTION(BlueprintCallable, Category = "Rship|Diagnostics")
+    void ResetRegistrationProgress();
+
     // Registration batching (for multi-target component registration)
     void BeginRegistrationBatch();
     void EndRegistrationBatch();
@@ -1,13 +1,18 @@
 #include "RshipFieldComponent.h"
 
+#include "RshipFieldRecording.h"
 #include "RshipFieldSubsystem.h"
 
 #include "DrawDebugHelpers.h"
+#include "Dom/JsonValue.h"
 #include "Engine/Engine.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "Engine/World.h"
+#include "GameFramework/Actor.h"
 #include "NiagaraComponent.h"
 #include "NiagaraSystem.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogRshipFieldComponent, Log, All);
 
@@ -31,7 +36,8 @@ void URshipFieldComponent::OnRegister()
         }
     }
 
-    UE_LOG(LogRshipFieldComponent, Log, TEXT("Field '%s' registered: %d waves, %d noise, %d attractors"), *FieldId, WaveEffectors.Num(), NoiseEffectors.Num(), AttractorEffectors.Num());
+    UE_LOG(LogRshipFieldComponent, Log, TEXT("Field '%s' registered: %d waves, %d noise, %d attractors, %d splines, %d rings"),
+        *FieldId, WaveEffectors.Num(), NoiseEffectors.Num(), AttractorEffectors.Num(), SplineEffectors.Num(), RingEffectors.Num());
 }
 
 void URshipFieldComponent::OnUnregister()
@@ -100,6 +106,28 @@ void URshipFieldComponent::TickComponent(float DeltaTime, ELevelTick TickType, F
             const FColor Color = Attractor.Strength >= 0.0f ? FColor::Orange : FColor::Red;
             DrawDebugSphere(World, Attractor.PositionCm, Attractor.bInfiniteRange ? 50.0f : Attractor.RadiusCm, 12, Color, false, -1.0f, 0, 1.5f);
         }
+
+        for (int32 i = 0; i < SplineEffectors.Num() && i < SplinePolylines.Num(); ++i)
+        {
+            if (!SplineEffectors[i].bEnabled) continue;
+            const FBox3f Bounds = SplinePolylines[i].GetBounds();
+            if (Bounds.IsValid)
+            {
+                const FBox PathBounds = FBox(FVector(Bounds.Min), FVector(Bounds.Max)).ExpandBy(SplineEffectors[i].RadiusCm);
+                DrawDebugBox(World, PathBounds.GetCenter(), PathBounds.GetExtent(), FColor::Emerald, false, -1.0f, 0, 1.5f);
+            }
+        }
+
+        for (const FRshipFieldRingEffector& Ring : RingEffectors)
+        {
+            if (!Ring.bEnabled) continue;
+            const FVector Axis = Ring.Axis.IsNearlyZero() ? FVector::UpVector : Ring.Axis.GetSafeNormal();
+            FVector U;
+            FVector V;
+            Axis.FindBestAxisVectors(U, V);
+            DrawDebugCircle(World, Ring.CenterCm, Ring.RingRadiusCm, 48, FColor::Turquoise, false, -1.0f, 0, 2.0f, U, V, false);
+            DrawDebugDirectionalArrow(World, Ring.CenterCm, Ring.CenterCm + Axis * 100.0f, 20.0f, FColor::Turquoise, false, -1.0f, 0, 2.0f);
+        }
     }
 
     // Niagara visualizer
@@ -124,9 +152,19 @@ void URshipFieldComponent::RegisterOrRefreshTarget()
 
     Target
         .AddAction(this, GET_FUNCTION_NAME_CHECKED(URshipFieldComponent, SetBpmAction), TEXT("SetBpm"))
-        .AddAction(this, GET_FUNCTION_NAME_CHECKED(URshipFieldComponent, SetTransportAction), TEXT("SetTransport"));
+        .AddAction(this, GET_FUNCTION_NAME_CHECKED(URshipFieldComponent, SetTransportAction), TEXT("SetTransport"))
+        .AddAction(this, GET_FUNCTION_NAME_CHECKED(URshipFieldComponent, SetNamedTransportAction), TEXT("SetNamedTransport"))
+        .AddAction(this, GET_FUNCTION_NAME_CHECKED(URshipFieldComponent, SyncTransport), TEXT("SyncTransport"));
 
     Target.AddAction(this, GET_FUNCTION_NAME_CHECKED(URshipFieldComponent, SetFieldState), TEXT("SetFieldState"));
+
+    Target
+        .AddAction(this, GET_FUNCTION_NAME_CHECKED(URshipFieldComponent, SetSplineEffectorAction), TEXT("SetSplineEffector"))
+        .AddAction(this, GET_FUNCTION_NAME_CHECKED(URshipFieldComponent, SetSplinePointsAction), TEXT("SetSplinePoints"))
+        .AddAction(this, GET_FUNCTION_NAME_CHECKED(URshipFieldComponent, SetRingEffectorAction), TEXT("SetRingEffector"))
+        .AddAction(this, GET_FUNCTION_NAME_CHECKED(URshipFieldComponent, SetRingTransformAction), TEXT("SetRingTransform"));
+
+    Target.AddEmitter(this, GET_MEMBER_NAME_CHECKED(URshipFieldComponent, OnProbeSample), TEXT("probeSample"));
 }
 
 bool URshipFieldComponent::EnsureAtlasTextures()
@@ -223,12 +261,114 @@ void URshipFieldComponent::SetTransportAction(float Phase, bool Playing)
     bPlaying = Playing;
 }
 
+void URshipFieldComponent::SetNamedTransportAction(const FString& TransportId, float InBpm, bool Playing)
+{
+    if (FRshipFieldTransport* Transport = Transports.FindByPredicate([&TransportId](const FRshipFieldTransport& Candidate) { return Candidate.Id == TransportId; }))
+    {
+        Transport->Bpm = FMath::Clamp(InBpm, 1.0f, 400.0f);
+        Transport->bPlaying = Playing;
+    }
+}
+
+void URshipFieldComponent::SyncTransport(const FString& TransportId, float Beat, float InBpm)
+{
+    if (FRshipFieldTransport* Transport = Transports.FindByPredicate([&TransportId](const FRshipFieldTransport& Candidate) { return Candidate.Id == TransportId; }))
+    {
+        // Written like any locate; the next step anchors the clock here
+        Transport->BeatPhase = Beat;
+        Transport->Bpm = FMath::Clamp(InBpm, 1.0f, 400.0f);
+        Transport->bPlaying = true;
+        ++Transport->SyncCount;
+    }
+}
+
 void URshipFieldComponent::SetFieldState(const FString& StateJson)
 {
     LastFieldStateError.Reset();
     // TODO(ms): parse JSON into local properties
 }
 
+void URshipFieldComponent::SetSplineEffectorAction(int32 Index, bool Enabled, float Amplitude, float WavelengthCm, float FrequencyHz, float RadiusCm)
+{
+    if (!SplineEffectors.IsValidIndex(Index))
+    {
+        return;
+    }
+
+    FRshipFieldSplineEffector& Spline = SplineEffectors[Index];
+    Spline.bEnabled = Enabled;
+    Spline.Amplitude = Amplitude;
+    Spline.WavelengthCm = FMath::Max(WavelengthCm, 0.001f);
+    Spline.FrequencyHz = FrequencyHz;
+    Spline.RadiusCm = FMath::Max(RadiusCm, 0.0f);
+}
+
+void URshipFieldComponent::SetSplinePointsAction(int32 Index, const FString& PointsJson, bool ClosedLoop)
+{
+    if (!SplineEffectors.IsValidIndex(Index))
+    {
+        return;
+    }
+
+    // [[x, y, z], ...] in world centimeters
+    TArray<TSharedPtr<FJsonValue>> Values;
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(PointsJson);
+    if (!FJsonSerializer::Deserialize(Reader, Values))
+    {
+        UE_LOG(LogRshipFieldComponent, Warning, TEXT("SetSplinePoints: field '%s' effector %d: invalid JSON"), *FieldId, Index);
+        return;
+    }
+
+    TArray<FVector> Points;
+    Points.Reserve(Values.Num());
+    for (const TSharedPtr<FJsonValue>& Value : Values)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Coords = nullptr;
+        if (!Value.IsValid() || !Value->TryGetArray(Coords) || Coords->Num() != 3)
+        {
+            UE_LOG(LogRshipFieldComponent, Warning, TEXT("SetSplinePoints: field '%s' effector %d: expected [x, y, z] points"), *FieldId, Index);
+            return;
+        }
+        Points.Add(FVector((*Coords)[0]->AsNumber(), (*Coords)[1]->AsNumber(), (*Coords)[2]->AsNumber()));
+    }
+
+    FRshipFieldSplineEffector& Spline = SplineEffectors[Index];
+    Spline.PointsCm = MoveTemp(Points);
+    Spline.bClosedLoop = ClosedLoop;
+}
+
+void URshipFieldComponent::SetRingEffectorAction(int32 Index, bool Enabled, float Amplitude, float RingRadiusCm, int32 LobeCount, float Speed, float RadiusCm)
+{
+    if (!RingEffectors.IsValidIndex(Index))
+    {
+        return;
+    }
+
+    FRshipFieldRingEffector& Ring = RingEffectors[Index];
+    Ring.bEnabled = Enabled;
+    Ring.Amplitude = Amplitude;
+    Ring.RingRadiusCm = FMath::Max(RingRadiusCm, 0.0f);
+    Ring.LobeCount = FMath::Max(LobeCount, 0);
+    Ring.Speed = Speed;
+    Ring.RadiusCm = FMath::Max(RadiusCm, 0.0f);
+}
+
+void URshipFieldComponent::SetRingTransformAction(int32 Index, float CenterX, float CenterY, float CenterZ, float AxisX, float AxisY, float AxisZ)
+{
+    if (!RingEffectors.IsValidIndex(Index))
+    {
+        return;
+    }
+
+    FRshipFieldRingEffector& Ring = RingEffectors[Index];
+    Ring.CenterCm = FVector(CenterX, CenterY, CenterZ);
+    const FVector Axis(AxisX, AxisY, AxisZ);
+    if (!Axis.IsNearlyZero())
+    {
+        Ring.Axis = Axis.GetSafeNormal();
+    }
+}
+
 void URshipFieldComponent::EmitAllWavefronts()
 {
     for (int32 i = 0; i < WaveEffectors.Num(); ++i)
@@ -237,6 +377,58 @@ void URshipFieldComponent::EmitAllWavefronts()
     }
 }
 
+void URshipFieldComponent::StartRecording()
+{
+    Recorder = MakeShared<FRshipFieldRecorder>(*this);
+}
+
+bool URshipFieldComponent::StopRecording(const FString& FilePath)
+{
+    const TSharedPtr<FRshipFieldRecorder> Stopped = MoveTemp(Recorder);
+    if (!Stopped.IsValid())
+    {
+        return false;
+    }
+
+    if (!Stopped->GetRecording().SaveToFile(FilePath))
+    {
+        UE_LOG(LogRshipFieldComponent, Warning, TEXT("StopRecording: could not write '%s' for field '%s'"), *FilePath, *FieldId);
+        return false;
+    }
+    UE_LOG(LogRshipFieldComponent, Log, TEXT("Recorded %d steps of field '%s' to '%s'"), Stopped->GetRecording().GetNumSteps(), *FieldId, *FilePath);
+    return true;
+}
+
+void URshipFieldComponent::GetProbePositions(TArray<FVector>& OutPositionsCm) const
+{
+    OutPositionsCm.Reset(Probes.Num());
+    for (const FRshipFieldProbe& Probe : Probes)
+    {
+        const AActor* ProbeActor = Probe.Actor.Get();
+        OutPositionsCm.Add(ProbeActor ? ProbeActor->GetActorLocation() : Probe.PositionCm);
+    }
+}
+
+void URshipFieldComponent::PublishProbeSamples(TConstArrayView<FString> Names, const FRshipFieldQueryResult& Result)
+{
+    if (!Result.bValid)
+    {
+        return;
+    }
+
+    for (int32 i = 0; i < Names.Num() && i < Result.Num(); ++i)
+    {
+        const FVector4f Sample(Result.Vector[i], Result.Scalar[i]);
+        FVector4f* Published = PublishedProbeSamples.Find(Names[i]);
+        if (Published && *Published == Sample)
+        {
+            continue;
+        }
+        PublishedProbeSamples.Add(Names[i], Sample);
+        OnProbeSample.Broadcast(Names[i], Sample.W, Sample.X, Sample.Y, Sample.Z);
+    }
+}
+
 void URshipFieldComponent::EmitWavefront(int32 WaveEffectorIndex)
 {
     if (!WaveEffectors.IsValidIndex(WaveEffectorIndex))
@@ -250,25 +442,21 @@ void URshipFieldComponent::EmitWavefront(int32 WaveEffectorIndex)
         return;
     }
 
+    if (Recorder.IsValid())
+    {
+        Recorder->RecordEmitWavefront(*this, WaveEffectorIndex);
+    }
+
     // Ensure state array is sized
     if (WaveEffectorStates.Num() != WaveEffectors.Num())
     {
         WaveEffectorStates.SetNum(WaveEffectors.Num());
     }
 
+    // Evicts the oldest if over cap
     FRshipFieldWaveEffectorState& State = WaveEffectorStates[WaveEffectorIndex];
-
-    FRshipFieldWavefront WF;
-    WF.BirthTime = SimulationTimeSeconds;
-    WF.BirthPositionCm = Wave.PositionCm;
-    State.Wavefronts.Add(WF);
+    State.Wavefronts.Emit(SimulationTimeSeconds, Wave.PositionCm, Wave.MaxWavefronts);
     State.LastEmitTime = SimulationTimeSeconds;
-
-    // Evict oldest if over cap
-    while (State.Wavefronts.Num() > Wave.MaxWavefronts)
-    {
-        State.Wavefronts.RemoveAt(0);
-    }
 }
 
 void URshipFieldComponent::UpdateVisualizer()
@@ -0,0 +1,933 @@
+#include "RshipFieldCpuEvaluator.h"
+
+#include "Async/ParallelFor.h"
+#include "RshipFieldPolyline.h"
+
+namespace
+{
+constexpr float TwoPi = 6.28318530718f;
+
+FORCEINLINE VectorRegister4Float Splat(float Value)
+{
+    return VectorSetFloat1(Value);
+}
+
+FORCEINLINE float FirstLane(const VectorRegister4Float& Value)
+{
+    float Result;
+    VectorStoreFloat1(Value, &Result);
+    return Result;
+}
+
+// HLSL frac: x - floor(x), also for negative x.
+FORCEINLINE VectorRegister4Float Frac(const VectorRegister4Float& Value)
+{
+    return VectorSubtract(Value, VectorFloor(Value));
+}
+
+FORCEINLINE VectorRegister4Float Saturate(const VectorRegister4Float& Value)
+{
+    return VectorMin(VectorMax(Value, GlobalVectorConstants::FloatZero), GlobalVectorConstants::FloatOne);
+}
+
+FORCEINLINE VectorRegister4Float Clamp(const VectorRegister4Float& Value, float Min, float Max)
+{
+    return VectorMin(VectorMax(Value, Splat(Min)), Splat(Max));
+}
+
+// HLSL lerp: A + T * (B - A). Multiply and add are kept separate so no lane gets fused.
+FORCEINLINE VectorRegister4Float Lerp(const VectorRegister4Float& A, const VectorRegister4Float& B, const VectorRegister4Float& T)
+{
+    return VectorAdd(A, VectorMultiply(T, VectorSubtract(B, A)));
+}
+
+FORCEINLINE VectorRegister4Float Dot3(
+    const VectorRegister4Float& X, const VectorRegister4Float& Y, const VectorRegister4Float& Z,
+    float KX, float KY, float KZ)
+{
+    return VectorAdd(VectorAdd(VectorMultiply(X, Splat(KX)), VectorMultiply(Y, Splat(KY))), VectorMultiply(Z, Splat(KZ)));
+}
+
+FORCEINLINE VectorRegister4Float LengthSquared(const VectorRegister4Float& X, const VectorRegister4Float& Y, const VectorRegister4Float& Z)
+{
+    return VectorAdd(VectorAdd(VectorMultiply(X, X), VectorMultiply(Y, Y)), VectorMultiply(Z, Z));
+}
+
+FORCEINLINE VectorRegister4Float Length(const VectorRegister4Float& X, const VectorRegister4Float& Y, const VectorRegister4Float& Z)
+{
+    return VectorSqrt(LengthSquared(X, Y, Z));
+}
+
+FORCEINLINE VectorRegister4Float Pow(const VectorRegister4Float& Base, float Exponent)
+{
+    // Linear and quadratic falloff are the common cases; skip the exp2/log2 round trip for them
+    if (Exponent == 1.0f)
+    {
+        return Base;
+    }
+    if (Exponent == 2.0f)
+    {
+        return VectorMultiply(Base, Base);
+    }
+    return VectorPow(Base, Splat(Exponent));
+}
+
+uint32 DecodeEnum(float Packed)
+{
+    return static_cast<uint32>(FMath::Max(0.0f, FMath::FloorToFloat(Packed + 0.5f)));
+}
+
+int32 DecodeIndex(float Packed)
+{
+    return static_cast<int32>(FMath::FloorToFloat(Packed + 0.5f));
+}
+
+VectorRegister4Float Hash31(const VectorRegister4Float& X, const VectorRegister4Float& Y, const VectorRegister4Float& Z)
+{
+    return Frac(VectorMultiply(VectorSin(Dot3(X, Y, Z, 12.9898f, 78.233f, 37.719f)), Splat(43758.5453f)));
+}
+
+VectorRegister4Float ValueNoise(const VectorRegister4Float& X, const VectorRegister4Float& Y, const VectorRegister4Float& Z)
+{
+    const VectorRegister4Float One = GlobalVectorConstants::FloatOne;
+    const VectorRegister4Float Two = GlobalVectorConstants::FloatTwo;
+    const VectorRegister4Float Three = Splat(3.0f);
+
+    const VectorRegister4Float IX = VectorFloor(X);
+    const VectorRegister4Float IY = VectorFloor(Y);
+    const VectorRegister4Float IZ = VectorFloor(Z);
+    const VectorRegister4Float IX1 = VectorAdd(IX, One);
+    const VectorRegister4Float IY1 = VectorAdd(IY, One);
+    const VectorRegister4Float IZ1 = VectorAdd(IZ, One);
+
+    auto Smooth = [&](const VectorRegister4Float& F)
+    {
+        return VectorMultiply(VectorMultiply(F, F), VectorSubtract(Three, VectorMultiply(Two, F)));
+    };
+    const VectorRegister4Float FX = Smooth(Frac(X));
+    const VectorRegister4Float FY = Smooth(Frac(Y));
+    const VectorRegister4Float FZ = Smooth(Frac(Z));
+
+    const VectorRegister4Float N000 = Hash31(IX, IY, IZ);
+    const VectorRegister4Float N100 = Hash31(IX1, IY, IZ);
+    const VectorRegister4Float N010 = Hash31(IX, IY1, IZ);
+    const VectorRegister4Float N110 = Hash31(IX1, IY1, IZ);
+    const VectorRegister4Float N001 = Hash31(IX, IY, IZ1);
+    const VectorRegister4Float N101 = Hash31(IX1, IY, IZ1);
+    const VectorRegister4Float N011 = Hash31(IX, IY1, IZ1);
+    const VectorRegister4Float N111 = Hash31(IX1, IY1, IZ1);
+
+    const VectorRegister4Float NX00 = Lerp(N000, N100, FX);
+    const VectorRegister4Float NX10 = Lerp(N010, N110, FX);
+    const VectorRegister4Float NX01 = Lerp(N001, N101, FX);
+    const VectorRegister4Float NX11 = Lerp(N011, N111, FX);
+    const VectorRegister4Float NXY0 = Lerp(NX00, NX10, FY);
+    const VectorRegister4Float NXY1 = Lerp(NX01, NX11, FY);
+    return VectorSubtract(VectorMultiply(Lerp(NXY0, NXY1, FZ), Two), One);
+}
+
+VectorRegister4Float SimplexLikeNoise(const VectorRegister4Float& X, const VectorRegister4Float& Y, const VectorRegister4Float& Z)
+{
+    auto Octave = [&](float Scale, float Offset)
+    {
+        return ValueNoise(
+            VectorAdd(VectorMultiply(X, Splat(Scale)), Splat(Offset)),
+            VectorAdd(VectorMultiply(Y, Splat(Scale)), Splat(Offset)),
+            VectorAdd(VectorMultiply(Z, Splat(Scale)), Splat(Offset)));
+    };
+
+    const VectorRegister4Float A = ValueNoise(X, Y, Z);
+    const VectorRegister4Float B = VectorMultiply(Octave(2.07f, 13.1f), Splat(0.5f));
+    const VectorRegister4Float C = VectorMultiply(Octave(4.03f, 31.7f), Splat(0.25f));
+    return VectorDivide(VectorAdd(VectorAdd(A, B), C), Splat(1.75f));
+}
+
+void CurlLikeNoise(
+    const VectorRegister4Float& X, const VectorRegister4Float& Y, const VectorRegister4Float& Z,
+    VectorRegister4Float& OutX, VectorRegister4Float& OutY, VectorRegister4Float& OutZ)
+{
+    const VectorRegister4Float E = Splat(0.05f);
+    const VectorRegister4Float TwoE = Splat(2.0f * 0.05f);
+
+    const VectorRegister4Float NX0 = SimplexLikeNoise(VectorSubtract(X, E), Y, Z);
+    const VectorRegister4Float NX1 = SimplexLikeNoise(VectorAdd(X, E), Y, Z);
+    const VectorRegister4Float NY0 = SimplexLikeNoise(X, VectorSubtract(Y, E), Z);
+    const VectorRegister4Float NY1 = SimplexLikeNoise(X, VectorAdd(Y, E), Z);
+    const VectorRegister4Float NZ0 = SimplexLikeNoise(X, Y, VectorSubtract(Z, E));
+    const VectorRegister4Float NZ1 = SimplexLikeNoise(X, Y, VectorAdd(Z, E));
+
+    const VectorRegister4Float DX = VectorDivide(VectorSubtract(NX1, NX0), TwoE);
+    const VectorRegister4Float DY = VectorDivide(VectorSubtract(NY1, NY0), TwoE);
+    const VectorRegister4Float DZ = VectorDivide(VectorSubtract(NZ1, NZ0), TwoE);
+
+    OutX = VectorSubtract(DY, DZ);
+    OutY = VectorSubtract(DZ, DX);
+    OutZ = VectorSubtract(DX, DY);
+}
+
+VectorRegister4Float EvaluateWaveform(uint32 Waveform, const VectorRegister4Float& Phase)
+{
+    // 0 = Sine, 1 = Cosine, 2 = Triangle, 3 = Saw, 4 = Square
+    if (Waveform == 1u)
+    {
+        return VectorCos(Phase);
+    }
+    const VectorRegister4Float One = GlobalVectorConstants::FloatOne;
+    const VectorRegister4Float Two = GlobalVectorConstants::FloatTwo;
+    const VectorRegister4Float T = Frac(VectorDivide(Phase, Splat(TwoPi)));
+    if (Waveform == 2u)
+    {
+        return VectorSubtract(One, VectorMultiply(VectorAbs(VectorSubtract(VectorMultiply(Two, T), One)), Two));
+    }
+    if (Waveform == 3u)
+    {
+        return VectorSubtract(VectorMultiply(Two, T), One);
+    }
+    if (Waveform == 4u)
+    {
+        return VectorSelect(VectorCompareLT(T, GlobalVectorConstants::FloatOneHalf), One, GlobalVectorConstants::FloatMinusOne);
+    }
+    return VectorSin(Phase);
+}
+
+// ApplyBlendScalar for one component; bFirst is the kernel's !bInitialized.
+FORCEINLINE void ApplyBlend(VectorRegister4Float& Acc, const VectorRegister4Float& Value, uint32 BlendOp, bool bFirst)
+{
+    if (bFirst)
+    {
+        Acc = (BlendOp == 2u || BlendOp == 3u || BlendOp == 4u) ? Value : VectorZeroFloat();
+    }
+
+    if (BlendOp == 0u)
+    {
+        Acc = VectorAdd(Acc, Value);
+    }
+    else if (BlendOp == 1u)
+    {
+        Acc = VectorSubtract(Acc, Value);
+    }
+    else if (BlendOp == 2u)
+    {
+        Acc = VectorMin(Acc, Value);
+    }
+    else if (BlendOp == 3u)
+    {
+        Acc = VectorMax(Acc, Value);
+    }
+    else if (BlendOp == 4u)
+    {
+        Acc = VectorMultiply(Acc, VectorAdd(GlobalVectorConstants::FloatOne, Value));
+    }
+}
+} // namespace
+
+void FRshipFieldPointBatch::Reset()
+{
+    PositionX.Reset();
+    PositionY.Reset();
+    PositionZ.Reset();
+    Scalar.Reset();
+    VectorX.Reset();
+    VectorY.Reset();
+    VectorZ.Reset();
+}
+
+int32 FRshipFieldPointBatch::Add(const FVector& PositionCm)
+{
+    PositionY.Add(static_cast<float>(PositionCm.Y));
+    PositionZ.Add(static_cast<float>(PositionCm.Z));
+    return PositionX.Add(static_cast<float>(PositionCm.X));
+}
+
+void FRshipFieldCpuAtlas::Allocate(int32 InFieldResolution, int32 InTilesPerRow)
+{
+    FieldResolution = FMath::Max(InFieldResolution, 0);
+    TilesPerRow = FMath::Max(InTilesPerRow, 0);
+
+    const int32 AtlasSize = GetAtlasSize();
+    Scalar.SetNumZeroed(AtlasSize * AtlasSize);
+    Vector.SetNumZeroed(AtlasSize * AtlasSize);
+}
+
+FRshipFieldCpuEvaluator::FRshipFieldCpuEvaluator(const RshipFieldRDG::FGlobalDispatchInputs& Inputs)
+    : FieldResolution(Inputs.FieldResolution)
+    , TilesPerRow(Inputs.TilesPerRow)
+    , TimeSeconds(Inputs.TimeSeconds)
+    , TransportPhase(Inputs.TransportPhase)
+    , MasterScalarGain(Inputs.MasterScalarGain)
+    , MasterVectorGain(Inputs.MasterVectorGain)
+    , DomainMinCm(Inputs.DomainMinCm.X, Inputs.DomainMinCm.Y, Inputs.DomainMinCm.Z)
+    , DomainMaxCm(Inputs.DomainMaxCm.X, Inputs.DomainMaxCm.Y, Inputs.DomainMaxCm.Z)
+    , DebugMode(Inputs.DebugMode)
+    , DebugSelectionIndex(Inputs.DebugSelectionIndex)
+{
+    SyncGroupData.Append(Inputs.SyncGroupData.GetData(), FMath::Min<int32>(Inputs.SyncGroupCount, Inputs.SyncGroupData.Num()));
+    WavefrontData = Inputs.WavefrontData;
+    SplineNodeData = Inputs.SplineNodeData;
+    SplineSegmentData = Inputs.SplineSegmentData;
+    if (Inputs.EffectorTiles.IsBuiltFor(FieldResolution))
+    {
+        EffectorTiles = Inputs.EffectorTiles;
+    }
+
+    const int32 LayerCount = FMath::Min3<int32>(Inputs.LayerCount, Inputs.LayerDataA.Num(), Inputs.LayerDataB.Num());
+    Layers.Reserve(LayerCount);
+    for (int32 LayerIndex = 0; LayerIndex < LayerCount; ++LayerIndex)
+    {
+        const FVector4f& L0 = Inputs.LayerDataA[LayerIndex];
+        const FVector4f& L1 = Inputs.LayerDataB[LayerIndex];
+
+        FLayer& Layer = Layers.AddDefaulted_GetRef();
+        Layer.Weight = L0.X;
+        Layer.ClampMin = L0.Y;
+        Layer.ClampMax = L0.Z;
+        Layer.BlendOp = DecodeEnum(L0.W);
+        Layer.bEnabled = L1.X >= 0.5f;
+    }
+
+    const TArray<FVector4f>* EffectorBuffers[] = {
+        &Inputs.EffectorData0, &Inputs.EffectorData1, &Inputs.EffectorData2, &Inputs.EffectorData3,
+        &Inputs.EffectorData4, &Inputs.EffectorData5, &Inputs.EffectorData6, &Inputs.EffectorData7
+    };
+    int32 EffectorCount = Inputs.EffectorCount;
+    for (const TArray<FVector4f>* Buffer : EffectorBuffers)
+    {
+        EffectorCount = FMath::Min(EffectorCount, Buffer->Num());
+    }
+
+    Effectors.Reserve(EffectorCount);
+    AllEffectorIndices.SetNumUninitialized(EffectorCount);
+    for (int32 EffectorIndex = 0; EffectorIndex < EffectorCount; ++EffectorIndex)
+    {
+        const FVector4f& E0 = Inputs.EffectorData0[EffectorIndex];
+        const FVector4f& E1 = Inputs.EffectorData1[EffectorIndex];
+        const FVector4f& E2 = Inputs.EffectorData2[EffectorIndex];
+        const FVector4f& E3 = Inputs.EffectorData3[EffectorIndex];
+        const FVector4f& E4 = Inputs.EffectorData4[EffectorIndex];
+        const FVector4f& E5 = Inputs.EffectorData5[EffectorIndex];
+        const FVector4f& E6 = Inputs.EffectorData6[EffectorIndex];
+        const FVector4f& E7 = Inputs.EffectorData7[EffectorIndex];
+        AllEffectorIndices[EffectorIndex] = static_cast<uint32>(EffectorIndex);
+
+        FEffector& Eff = Effectors.AddDefaulted_GetRef();
+        Eff.PositionCm = FVector3f(E0.X, E0.Y, E0.Z);
+        Eff.RadiusCm = FMath::Max(E0.W, 0.001f);
+        Eff.Amplitude = E1.W;
+        Eff.WavelengthCm = FMath::Max(E2.X, 0.001f);
+        Eff.EnvelopeWidthCm = FMath::Max(E2.Z, 1.0f);
+        Eff.PhaseOffset = E2.W;
+        Eff.Fade = FMath::Clamp(E3.X, 0.0f, 1.0f);
+        Eff.FalloffExponent = E3.Y;
+        Eff.Type = DecodeEnum(E3.Z);
+        Eff.WaveMode = DecodeEnum(E3.W);
+        Eff.ClampMin = E4.X;
+        Eff.ClampMax = E4.Y;
+        Eff.BlendOp = DecodeEnum(E4.Z);
+        Eff.Waveform = DecodeEnum(E4.W);
+        Eff.NoiseType = DecodeEnum(E5.Y);
+        Eff.NoiseScale = FMath::Max(E5.Z, 0.0f);
+        Eff.NoiseAmplitude = E5.W;
+        Eff.bEnabled = E6.X >= 0.5f;
+        Eff.bInfiniteRange = E6.Y > 0.5f;
+        Eff.bAffectsScalar = E6.Z > 0.5f;
+        Eff.bAffectsVector = E6.W > 0.5f;
+        Eff.WavefrontOffset = DecodeIndex(E7.X);
+        Eff.WavefrontCount = DecodeIndex(E7.Y);
+        Eff.WaveSpeedCmPerSec = FMath::Max(E7.Z, 0.1f);
+
+        const float DirLenSq = E1.X * E1.X + E1.Y * E1.Y + E1.Z * E1.Z;
+        Eff.Direction = (DirLenSq > 1e-10f) ? FVector3f(E1.X, E1.Y, E1.Z) * (1.0f / FMath::Sqrt(DirLenSq)) : FVector3f::ZeroVector;
+
+        if (Eff.Type == 3u)
+        {
+            Eff.SplineNodeOffset = DecodeIndex(E7.X);
+            Eff.SplineSegmentOffset = DecodeIndex(E7.Y);
+        }
+        else if (Eff.Type == 4u)
+        {
+            if (DirLenSq >= 1e-10f)
+            {
+                Eff.RingAxis = Eff.Direction;
+            }
+            const FVector3f Reference = (FMath::Abs(Eff.RingAxis.Z) > 0.999f) ? FVector3f(0.0f, 1.0f, 0.0f) : FVector3f(0.0f, 0.0f, 1.0f);
+            Eff.RingU = FVector3f::CrossProduct(Reference, Eff.RingAxis).GetUnsafeNormal();
+            Eff.RingV = FVector3f::CrossProduct(Eff.RingAxis, Eff.RingU);
+            Eff.LobeCount = E7.X;
+            Eff.RingRadiusCm = E7.Y;
+        }
+
+        // The temporal phase has no spatial term: evaluate it once per dispatch. Spline and
+        // ring frequencies are signed, wave frequencies are not.
+        const int32 SyncGroupIndex = DecodeIndex(E5.X);
+        if (SyncGroupIndex >= 0 && SyncGroupIndex < SyncGroupData.Num() && SyncGroupData[SyncGroupIndex].X > 0.5f)
+        {
+            Eff.TemporalPhase = ComputeSyncGroupOffset(SyncGroupIndex);
+        }
+        else
+        {
+            Eff.TemporalPhase = TimeSeconds * (TwoPi * (Eff.Type >= 3u ? E2.Y : FMath::Max(E2.Y, 0.0f)));
+        }
+        Eff.Temporal = FirstLane(EvaluateWaveform(Eff.Waveform, Splat(Eff.TemporalPhase + TwoPi * 0.25f)));
+    }
+}
+
+float FRshipFieldCpuEvaluator::ComputeSyncGroupOffset(int32 SyncGroupIndex) const
+{
+    if (!SyncGroupData.IsValidIndex(SyncGroupIndex))
+    {
+        return 0.0f;
+    }
+
+    const FVector4f& Group = SyncGroupData[SyncGroupIndex];
+    float PhaseOffset = Group.Z;
+    if (Group.X > 0.5f)
+    {
+        PhaseOffset += TransportPhase * TwoPi * FMath::Max(Group.Y, 0.0f);
+    }
+    return PhaseOffset;
+}
+
+void FRshipFieldCpuEvaluator::FindClosestOnSpline(const FEffector& Eff, const FVectorLanes& Position, float MaxDistanceCm,
+    VectorRegister4Float& OutDistanceCm, VectorRegister4Float& OutArcCm, FVectorLanes& OutTangent) const
+{
+    const VectorRegister4Float Zero = VectorZeroFloat();
+
+    VectorRegister4Float BestDistSq = Splat(MaxDistanceCm * MaxDistanceCm);
+    VectorRegister4Float Found = VectorZeroFloat();
+    OutArcCm = Zero;
+    OutTangent = { Zero, Zero, Zero };
+
+    int32 Stack[FRshipFieldPolyline::MaxDepth];
+    int32 StackSize = 0;
+    Stack[StackSize++] = 0;
+    while (StackSize > 0)
+    {
+        // Out of range structured buffer loads return zero on the GPU: an empty leaf
+        const int32 Node = Eff.SplineNodeOffset + Stack[--StackSize];
+        if (Node < 0 || !SplineNodeData.IsValidIndex(Node * 2 + 1))
+        {
+            continue;
+        }
+        const FVector4f& N0 = SplineNodeData[Node * 2];
+        const FVector4f& N1 = SplineNodeData[Node * 2 + 1];
+
+        const VectorRegister4Float OutsideX = VectorMax(VectorMax(VectorSubtract(Splat(N0.X), Position.X), VectorSubtract(Position.X, Splat(N1.X))), Zero);
+        const VectorRegister4Float OutsideY = VectorMax(VectorMax(VectorSubtract(Splat(N0.Y), Position.Y), VectorSubtract(Position.Y, Splat(N1.Y))), Zero);
+        const VectorRegister4Float OutsideZ = VectorMax(VectorMax(VectorSubtract(Splat(N0.Z), Position.Z), VectorSubtract(Position.Z, Splat(N1.Z))), Zero);
+        if (VectorMaskBits(VectorCompareLT(LengthSquared(OutsideX, OutsideY, OutsideZ), BestDistSq)) == 0)
+        {
+            continue;
+        }
+
+        const int32 First = static_cast<int32>(N0.W);
+        const int32 Count = static_cast<int32>(N1.W);
+        if (Count == 0)
+        {
+            if (StackSize + 2 <= FRshipFieldPolyline::MaxDepth)
+            {
+                Stack[StackSize++] = First + 1;
+                Stack[StackSize++] = First;
+            }
+            continue;
+        }
+
+        for (int32 Seg = First; Seg < First + Count; ++Seg)
+        {
+            const int32 Index = (Eff.SplineSegmentOffset + Seg) * 2;
+            if (Index < 0 || !SplineSegmentData.IsValidIndex(Index + 1))
+            {
+                continue;
+            }
+            const FVector4f& S0 = SplineSegmentData[Index];
+            const FVector4f& S1 = SplineSegmentData[Index + 1];
+            const FVector3f Delta(S1.X - S0.X, S1.Y - S0.Y, S1.Z - S0.Z);
+
+            const VectorRegister4Float RelX = VectorSubtract(Position.X, Splat(S0.X));
+            const VectorRegister4Float RelY = VectorSubtract(Position.Y, Splat(S0.Y));
+            const VectorRegister4Float RelZ = VectorSubtract(Position.Z, Splat(S0.Z));
+            const VectorRegister4Float T = Saturate(VectorDivide(Dot3(RelX, RelY, RelZ, Delta.X, Delta.Y, Delta.Z), Splat(Delta.SizeSquared())));
+
+            const VectorRegister4Float DiffX = VectorSubtract(Position.X, VectorAdd(Splat(S0.X), VectorMultiply(Splat(Delta.X), T)));
+            const VectorRegister4Float DiffY = VectorSubtract(Position.Y, VectorAdd(Splat(S0.Y), VectorMultiply(Splat(Delta.Y), T)));
+            const VectorRegister4Float DiffZ = VectorSubtract(Position.Z, VectorAdd(Splat(S0.Z), VectorMultiply(Splat(Delta.Z), T)));
+            const VectorRegister4Float DistSq = LengthSquared(DiffX, DiffY, DiffZ);
+
+            const VectorRegister4Float Closer = VectorCompareLT(DistSq, BestDistSq);
+            if (VectorMaskBits(Closer) == 0)
+            {
+                continue;
+            }
+
+            const FVector3f Tangent = Delta / S1.W;
+            BestDistSq = VectorSelect(Closer, DistSq, BestDistSq);
+            OutArcCm = VectorSelect(Closer, VectorAdd(Splat(S0.W), VectorMultiply(T, Splat(S1.W))), OutArcCm);
+            OutTangent.X = VectorSelect(Closer, Splat(Tangent.X), OutTangent.X);
+            OutTangent.Y = VectorSelect(Closer, Splat(Tangent.Y), OutTangent.Y);
+            OutTangent.Z = VectorSelect(Closer, Splat(Tangent.Z), OutTangent.Z);
+            Found = VectorBitwiseOr(Found, Closer);
+        }
+    }
+
+    OutDistanceCm = VectorSelect(Found, VectorSqrt(BestDistSq), Splat(MaxDistanceCm));
+}
+
+FRshipFieldCpuEvaluator::FVectorLanes FRshipFieldCpuEvaluator::VoxelCenterLanes(int32 X, int32 Y, int32 Z) const
+{
+    const VectorRegister4Float Half = GlobalVectorConstants::FloatOneHalf;
+    const VectorRegister4Float Resolution = Splat(FMath::Max(static_cast<float>(FieldResolution), 1.0f));
+
+    const VectorRegister4Float VoxelX = MakeVectorRegisterFloat(
+        static_cast<float>(X), static_cast<float>(X + 1), static_cast<float>(X + 2), static_cast<float>(X + 3));
+    const VectorRegister4Float U = VectorDivide(VectorAdd(VoxelX, Half), Resolution);
+    const VectorRegister4Float V = VectorDivide(VectorAdd(Splat(static_cast<float>(Y)), Half), Resolution);
+    const VectorRegister4Float W = VectorDivide(VectorAdd(Splat(static_cast<float>(Z)), Half), Resolution);
+
+    FVectorLanes Position;
+    Position.X = Lerp(Splat(DomainMinCm.X), Splat(DomainMaxCm.X), U);
+    Position.Y = Lerp(Splat(DomainMinCm.Y), Splat(DomainMaxCm.Y), V);
+    Position.Z = Lerp(Splat(DomainMinCm.Z), Splat(DomainMaxCm.Z), W);
+    return Position;
+}
+
+FVector3f FRshipFieldCpuEvaluator::GetVoxelCenter(int32 X, int32 Y, int32 Z) const
+{
+    const FVectorLanes Position = VoxelCenterLanes(X, Y, Z);
+    return FVector3f(FirstLane(Position.X), FirstLane(Position.Y), FirstLane(Position.Z));
+}
+
+void FRshipFieldCpuEvaluator::EvaluateAtPosition(const FVector3f& WorldPosCm, bool bIncludeInfiniteEffectors, float& OutScalar, FVector3f& OutVector) const
+{
+    FVectorLanes Position;
+    Position.X = Splat(WorldPosCm.X);
+    Position.Y = Splat(WorldPosCm.Y);
+    Position.Z = Splat(WorldPosCm.Z);
+
+    VectorRegister4Float Scalar;
+    FVectorLanes Vector;
+    EvaluateLanes(Position, bIncludeInfiniteEffectors, AllEffectorIndices, Scalar, Vector);
+
+    OutScalar = FirstLane(Scalar);
+    OutVector = FVector3f(FirstLane(Vector.X), FirstLane(Vector.Y), FirstLane(Vector.Z));
+}
+
+void FRshipFieldCpuEvaluator::EvaluateLanes(const FVectorLanes& Position, bool bIncludeInfiniteEffectors, TConstArrayView<uint32> EffectorIndices,
+    VectorRegister4Float& OutScalar, FVectorLanes& OutVector) const
+{
+    const VectorRegister4Float Zero = VectorZeroFloat();
+    const VectorRegister4Float One = GlobalVectorConstants::FloatOne;
+
+    OutScalar = Zero;
+    OutVector = { Zero, Zero, Zero };
+
+    bool bScalarInitialized = false;
+    bool bVectorInitialized = false;
+
+    for (int32 LayerIndex = 0; LayerIndex < Layers.Num(); ++LayerIndex)
+    {
+        const FLayer& Layer = Layers[LayerIndex];
+        if (!Layer.bEnabled)
+        {
+            continue;
+        }
+
+        // The kernel only feeds effectors into layer 0 (single layer MVP) and debug mode 5
+        // drops every effector of unselected layers; either way such a layer stays empty.
+        if (LayerIndex > 0 || (DebugMode == 5 && DebugSelectionIndex >= 0 && LayerIndex != DebugSelectionIndex))
+        {
+            continue;
+        }
+
+        VectorRegister4Float LayerScalar = Zero;
+        FVectorLanes LayerVector = { Zero, Zero, Zero };
+        bool bLayerScalarInitialized = false;
+        bool bLayerVectorInitialized = false;
+
+        for (const uint32 ListedIndex : EffectorIndices)
+        {
+            const int32 EffectorIndex = static_cast<int32>(ListedIndex);
+            const FEffector& Eff = Effectors[EffectorIndex];
+            if (!Eff.bEnabled || Eff.bInfiniteRange != bIncludeInfiniteEffectors)
+            {
+                continue;
+            }
+            if (DebugMode == 4 && DebugSelectionIndex >= 0 && EffectorIndex != DebugSelectionIndex)
+            {
+                continue;
+            }
+
+            const VectorRegister4Float ToX = VectorSubtract(Position.X, Splat(Eff.PositionCm.X));
+            const VectorRegister4Float ToY = VectorSubtract(Position.Y, Splat(Eff.PositionCm.Y));
+            const VectorRegister4Float ToZ = VectorSubtract(Position.Z, Splat(Eff.PositionCm.Z));
+            VectorRegister4Float DistanceCm = Length(ToX, ToY, ToZ);
+
+            // Spline and ring effectors fall off with distance from their path, not their position
+            VectorRegister4Float PathPhase = Zero;
+            FVectorLanes PathDirection = { Zero, Zero, Zero };
+            if (Eff.Type == 3u)
+            {
+                VectorRegister4Float ArcCm;
+                FindClosestOnSpline(Eff, Position, Eff.bInfiniteRange ? 1e18f : Eff.RadiusCm, DistanceCm, ArcCm, PathDirection);
+                PathPhase = VectorMultiply(VectorDivide(ArcCm, Splat(Eff.WavelengthCm)), Splat(TwoPi));
+            }
+            else if (Eff.Type == 4u)
+            {
+                const VectorRegister4Float Height = Dot3(ToX, ToY, ToZ, Eff.RingAxis.X, Eff.RingAxis.Y, Eff.RingAxis.Z);
+                const VectorRegister4Float InPlaneX = VectorSubtract(ToX, VectorMultiply(Splat(Eff.RingAxis.X), Height));
+                const VectorRegister4Float InPlaneY = VectorSubtract(ToY, VectorMultiply(Splat(Eff.RingAxis.Y), Height));
+                const VectorRegister4Float InPlaneZ = VectorSubtract(ToZ, VectorMultiply(Splat(Eff.RingAxis.Z), Height));
+                const VectorRegister4Float PlaneDistSq = LengthSquared(InPlaneX, InPlaneY, InPlaneZ);
+                const VectorRegister4Float PlaneDist = VectorSqrt(PlaneDistSq);
+                const VectorRegister4Float FromRing = VectorSubtract(PlaneDist, Splat(Eff.RingRadiusCm));
+                DistanceCm = VectorSqrt(VectorAdd(VectorMultiply(Height, Height), VectorMultiply(FromRing, FromRing)));
+
+                // On the axis the angle is undefined; take the U direction
+                const VectorRegister4Float Azimuth = VectorATan2(
+                    Dot3(InPlaneX, InPlaneY, InPlaneZ, Eff.RingV.X, Eff.RingV.Y, Eff.RingV.Z),
+                    Dot3(InPlaneX, InPlaneY, InPlaneZ, Eff.RingU.X, Eff.RingU.Y, Eff.RingU.Z));
+                PathPhase = VectorSelect(VectorCompareGT(PlaneDist, Splat(1e-5f)), VectorMultiply(Splat(Eff.LobeCount), Azimuth), Zero);
+
+                // SafeNormalize(InPlane, U)
+                const VectorRegister4Float Degenerate = VectorCompareLT(PlaneDistSq, Splat(1e-10f));
+                const VectorRegister4Float InvLen = VectorDivide(One, PlaneDist);
+                PathDirection.X = VectorSelect(Degenerate, Splat(Eff.RingU.X), VectorMultiply(InPlaneX, InvLen));
+                PathDirection.Y = VectorSelect(Degenerate, Splat(Eff.RingU.Y), VectorMultiply(InPlaneY, InvLen));
+                PathDirection.Z = VectorSelect(Degenerate, Splat(Eff.RingU.Z), VectorMultiply(InPlaneZ, InvLen));
+            }
+
+            VectorRegister4Float Falloff = One;
+            if (!Eff.bInfiniteRange)
+            {
+                const VectorRegister4Float NormDist = Saturate(VectorDivide(DistanceCm, Splat(Eff.RadiusCm)));
+                const VectorRegister4Float Inside = (Eff.FalloffExponent <= 0.0f) ? One : Pow(VectorSubtract(One, NormDist), Eff.FalloffExponent);
+                Falloff = VectorSelect(VectorCompareGE(NormDist, One), Zero, Inside);
+            }
+
+            VectorRegister4Float Signal;
+            FVectorLanes NoiseVec = { Zero, Zero, Zero };
+            FVectorLanes Direction;
+
+            if (Eff.Type == 2u)
+            {
+                // Attractor: pure unmodulated radial force
+                Signal = VectorMultiply(VectorMultiply(Falloff, Splat(Eff.Fade)), Splat(Eff.Amplitude));
+                Signal = Clamp(Signal, Eff.ClampMin, Eff.ClampMax);
+
+                // SafeNormalize(Effector - Position, +Z)
+                const VectorRegister4Float DX = VectorSubtract(Splat(Eff.PositionCm.X), Position.X);
+                const VectorRegister4Float DY = VectorSubtract(Splat(Eff.PositionCm.Y), Position.Y);
+                const VectorRegister4Float DZ = VectorSubtract(Splat(Eff.PositionCm.Z), Position.Z);
+                const VectorRegister4Float LenSq = LengthSquared(DX, DY, DZ);
+                const VectorRegister4Float Degenerate = VectorCompareLT(LenSq, Splat(1e-10f));
+                const VectorRegister4Float InvLen = VectorDivide(One, VectorSqrt(LenSq));
+                Direction.X = VectorSelect(Degenerate, Zero, VectorMultiply(DX, InvLen));
+                Direction.Y = VectorSelect(Degenerate, Zero, VectorMultiply(DY, InvLen));
+                Direction.Z = VectorSelect(Degenerate, One, VectorMultiply(DZ, InvLen));
+            }
+            else if (Eff.Type >= 3u)
+            {
+                // Spline: waves along the path, W(2π·s/λ - ωt + φ). Ring: orbiting lobes, W(n·θ - ωt + φ)
+                const VectorRegister4Float Phase = VectorAdd(VectorSubtract(PathPhase, Splat(Eff.TemporalPhase)), Splat(Eff.PhaseOffset));
+                Signal = VectorMultiply(VectorMultiply(VectorMultiply(EvaluateWaveform(Eff.Waveform, Phase), Falloff), Splat(Eff.Fade)), Splat(Eff.Amplitude));
+                Signal = Clamp(Signal, Eff.ClampMin, Eff.ClampMax);
+
+                // Ring: away from the axis. Spline: polarization, or along the path when there is none
+                if (Eff.Type == 3u && !Eff.Direction.IsZero())
+                {
+                    Direction.X = Splat(Eff.Direction.X);
+                    Direction.Y = Splat(Eff.Direction.Y);
+                    Direction.Z = Splat(Eff.Direction.Z);
+                }
+                else
+                {
+                    Direction = PathDirection;
+                }
+            }
+            else
+            {
+                const VectorRegister4Float WavelengthCm = Splat(Eff.WavelengthCm);
+                VectorRegister4Float Wave = Zero;
+
+                if (Eff.WaveMode == 1u)
+                {
+                    // Traveling wave: expanding wavefront shells under Gaussian envelopes
+                    const VectorRegister4Float InvEnvelope = Splat(1.0f / Eff.EnvelopeWidthCm);
+                    const VectorRegister4Float MinusHalf = Splat(-0.5f);
+
+                    for (int32 WavefrontIndex = 0; WavefrontIndex < Eff.WavefrontCount; ++WavefrontIndex)
+                    {
+                        // Out of range structured buffer loads return zero on the GPU
+                        const int32 DataIndex = Eff.WavefrontOffset + WavefrontIndex;
+                        const FVector4f Wavefront = WavefrontData.IsValidIndex(DataIndex) ? WavefrontData[DataIndex] : FVector4f::Zero();
+                        const float Age = TimeSeconds - Wavefront.X;
+                        if (Age < 0.0f)
+                        {
+                            continue;
+                        }
+
+                        const VectorRegister4Float DistFromSource = Length(
+                            VectorSubtract(Position.X, Splat(Wavefront.Y)),
+                            VectorSubtract(Position.Y, Splat(Wavefront.Z)),
+                            VectorSubtract(Position.Z, Splat(Wavefront.W)));
+                        const VectorRegister4Float DistFromFront = VectorSubtract(DistFromSource, Splat(Age * Eff.WaveSpeedCmPerSec));
+
+                        const VectorRegister4Float EnvArg = VectorMultiply(DistFromFront, InvEnvelope);
+                        const VectorRegister4Float Envelope = VectorExp(VectorMultiply(VectorMultiply(MinusHalf, EnvArg), EnvArg));
+
+                        const VectorRegister4Float Phase = VectorMultiply(VectorDivide(DistFromFront, WavelengthCm), Splat(TwoPi));
+                        Wave = VectorAdd(Wave, VectorMultiply(EvaluateWaveform(Eff.Waveform, Phase), Envelope));
+                    }
+                }
+                else
+                {
+                    // Standing wave: W(kx) · W(wt + π/2)
+                    const VectorRegister4Float SpatialPhase = VectorMultiply(VectorDivide(DistanceCm, WavelengthCm), Splat(TwoPi));
+                    const VectorRegister4Float Spatial = EvaluateWaveform(Eff.Waveform, VectorAdd(SpatialPhase, Splat(Eff.PhaseOffset)));
+                    Wave = VectorMultiply(Spatial, Splat(Eff.Temporal));
+                }
+
+                Signal = VectorMultiply(VectorMultiply(VectorMultiply(Wave, Falloff), Splat(Eff.Fade)), Splat(Eff.Amplitude));
+
+                if (Eff.NoiseType != 0u && FMath::Abs(Eff.NoiseAmplitude) > 1e-5f)
+                {
+                    const VectorRegister4Float NoiseScale = Splat(Eff.NoiseScale);
+                    const VectorRegister4Float NX = VectorAdd(VectorMultiply(Position.X, NoiseScale), Splat(TimeSeconds));
+                    const VectorRegister4Float NY = VectorAdd(VectorMultiply(Position.Y, NoiseScale), Splat(TimeSeconds * 0.33f));
+                    const VectorRegister4Float NZ = VectorAdd(VectorMultiply(Position.Z, NoiseScale), Splat(TimeSeconds * 0.77f));
+                    const VectorRegister4Float NoiseFactor = VectorMultiply(VectorMultiply(Splat(Eff.NoiseAmplitude), Falloff), Splat(Eff.Fade));
+
+                    if (Eff.NoiseType == 1u)
+                    {
+                        Signal = VectorAdd(Signal, VectorMultiply(ValueNoise(NX, NY, NZ), NoiseFactor));
+                    }
+                    else if (Eff.NoiseType == 2u)
+                    {
+                        Signal = VectorAdd(Signal, VectorMultiply(SimplexLikeNoise(NX, NY, NZ), NoiseFactor));
+                    }
+                    else if (Eff.NoiseType == 3u)
+                    {
+                        CurlLikeNoise(NX, NY, NZ, NoiseVec.X, NoiseVec.Y, NoiseVec.Z);
+                        NoiseVec.X = VectorMultiply(NoiseVec.X, NoiseFactor);
+                        NoiseVec.Y = VectorMultiply(NoiseVec.Y, NoiseFactor);
+                        NoiseVec.Z = VectorMultiply(NoiseVec.Z, NoiseFactor);
+                        Signal = VectorAdd(Signal, VectorMultiply(Length(NoiseVec.X, NoiseVec.Y, NoiseVec.Z), Splat(0.577f)));
+                    }
+                }
+
+                Signal = Clamp(Signal, Eff.ClampMin, Eff.ClampMax);
+
+                Direction.X = Splat(Eff.Direction.X);
+                Direction.Y = Splat(Eff.Direction.Y);
+                Direction.Z = Splat(Eff.Direction.Z);
+            }
+
+            if (Eff.bAffectsScalar)
+            {
+                ApplyBlend(LayerScalar, Signal, Eff.BlendOp, !bLayerScalarInitialized);
+                bLayerScalarInitialized = true;
+            }
+            if (Eff.bAffectsVector)
+            {
+                ApplyBlend(LayerVector.X, VectorAdd(VectorMultiply(Direction.X, Signal), NoiseVec.X), Eff.BlendOp, !bLayerVectorInitialized);
+                ApplyBlend(LayerVector.Y, VectorAdd(VectorMultiply(Direction.Y, Signal), NoiseVec.Y), Eff.BlendOp, !bLayerVectorInitialized);
+                ApplyBlend(LayerVector.Z, VectorAdd(VectorMultiply(Direction.Z, Signal), NoiseVec.Z), Eff.BlendOp, !bLayerVectorInitialized);
+                bLayerVectorInitialized = true;
+            }
+        }
+
+        if (!bLayerScalarInitialized && !bLayerVectorInitialized)
+        {
+            continue;
+        }
+
+        const VectorRegister4Float Weight = Splat(Layer.Weight);
+        LayerScalar = VectorMultiply(Clamp(LayerScalar, Layer.ClampMin, Layer.ClampMax), Weight);
+        LayerVector.X = VectorMultiply(Clamp(LayerVector.X, Layer.ClampMin, Layer.ClampMax), Weight);
+        LayerVector.Y = VectorMultiply(Clamp(LayerVector.Y, Layer.ClampMin, Layer.ClampMax), Weight);
+        LayerVector.Z = VectorMultiply(Clamp(LayerVector.Z, Layer.ClampMin, Layer.ClampMax), Weight);
+
+        ApplyBlend(OutScalar, LayerScalar, Layer.BlendOp, !bScalarInitialized);
+        bScalarInitialized = true;
+        ApplyBlend(OutVector.X, LayerVector.X, Layer.BlendOp, !bVectorInitialized);
+        ApplyBlend(OutVector.Y, LayerVector.Y, Layer.BlendOp, !bVectorInitialized);
+        ApplyBlend(OutVector.Z, LayerVector.Z, Layer.BlendOp, !bVectorInitialized);
+        bVectorInitialized = true;
+    }
+}
+
+void FRshipFieldCpuEvaluator::EvaluateRow(int32 FirstX, int32 EndX, int32 Y, int32 Z, float* OutScalar, FVector4f* OutVector) const
+{
+    const VectorRegister4Float ScalarGain = Splat(MasterScalarGain);
+    const VectorRegister4Float VectorGain = Splat(MasterVectorGain);
+
+    alignas(16) float Scalar[4];
+    alignas(16) float VectorX[4];
+    alignas(16) float VectorY[4];
+    alignas(16) float VectorZ[4];
+
+    const bool bTiled = EffectorTiles.GetNumTiles() > 0;
+    for (int32 X = FirstX; X < EndX; X += 4)
+    {
+        // Four lanes never straddle a tile, as a thread group doesn't on the GPU
+        const TConstArrayView<uint32> EffectorIndices = bTiled
+            ? EffectorTiles.GetTileEffectors(EffectorTiles.GetTileIndex(X, Y, Z))
+            : TConstArrayView<uint32>(AllEffectorIndices);
+
+        VectorRegister4Float ScalarLanes;
+        FVectorLanes VectorLanes;
+        EvaluateLanes(VoxelCenterLanes(X, Y, Z), false, EffectorIndices, ScalarLanes, VectorLanes);
+
+        VectorStoreAligned(VectorMultiply(ScalarLanes, ScalarGain), Scalar);
+        VectorStoreAligned(VectorMultiply(VectorLanes.X, VectorGain), VectorX);
+        VectorStoreAligned(VectorMultiply(VectorLanes.Y, VectorGain), VectorY);
+        VectorStoreAligned(VectorMultiply(VectorLanes.Z, VectorGain), VectorZ);
+
+        // Resolutions are multiples of four; lanes past the row end are dropped otherwise
+        const int32 LaneCount = FMath::Min(4, EndX - X);
+        for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+        {
+            OutScalar[X + Lane] = Scalar[Lane];
+            OutVector[X + Lane] = FVector4f(VectorX[Lane], VectorY[Lane], VectorZ[Lane], 1.0f);
+        }
+    }
+}
+
+void FRshipFieldCpuEvaluator::EvaluateSlice(int32 Z, float* OutScalar, FVector4f* OutVector, int32 RowStride) const
+{
+    for (int32 Y = 0; Y < FieldResolution; ++Y)
+    {
+        EvaluateRow(0, FieldResolution, Y, Z, OutScalar + static_cast<int64>(Y) * RowStride, OutVector + static_cast<int64>(Y) * RowStride);
+    }
+}
+
+void FRshipFieldCpuEvaluator::EvaluatePoints(FRshipFieldPointBatch& Batch) const
+{
+    const int32 NumPoints = Batch.Num();
+    Batch.Scalar.SetNumUninitialized(NumPoints);
+    Batch.VectorX.SetNumUninitialized(NumPoints);
+    Batch.VectorY.SetNumUninitialized(NumPoints);
+    Batch.VectorZ.SetNumUninitialized(NumPoints);
+    if (NumPoints == 0)
+    {
+        return;
+    }
+
+    const VectorRegister4Float ScalarGain = Splat(MasterScalarGain);
+    const VectorRegister4Float VectorGain = Splat(MasterVectorGain);
+
+    // Full groups of four load and store in place; the tail goes through padded scratch
+    auto EvaluateGroup = [&](int32 First)
+    {
+        const int32 Count = FMath::Min(4, NumPoints - First);
+
+        alignas(16) float Lanes[7][4];
+        FVectorLanes Position;
+        if (Count == 4)
+        {
+            Position.X = VectorLoad(Batch.PositionX.GetData() + First);
+            Position.Y = VectorLoad(Batch.PositionY.GetData() + First);
+            Position.Z = VectorLoad(Batch.PositionZ.GetData() + First);
+        }
+        else
+        {
+            for (int32 Lane = 0; Lane < 4; ++Lane)
+            {
+                const int32 Source = First + FMath::Min(Lane, Count - 1);
+                Lanes[0][Lane] = Batch.PositionX[Source];
+                Lanes[1][Lane] = Batch.PositionY[Source];
+                Lanes[2][Lane] = Batch.PositionZ[Source];
+            }
+            Position.X = VectorLoadAligned(Lanes[0]);
+            Position.Y = VectorLoadAligned(Lanes[1]);
+            Position.Z = VectorLoadAligned(Lanes[2]);
+        }
+
+        VectorRegister4Float ScalarLanes;
+        FVectorLanes VectorLanes;
+        EvaluateLanes(Position, false, AllEffectorIndices, ScalarLanes, VectorLanes);
+        ScalarLanes = VectorMultiply(ScalarLanes, ScalarGain);
+        VectorLanes.X = VectorMultiply(VectorLanes.X, VectorGain);
+        VectorLanes.Y = VectorMultiply(VectorLanes.Y, VectorGain);
+        VectorLanes.Z = VectorMultiply(VectorLanes.Z, VectorGain);
+
+        if (Count == 4)
+        {
+            VectorStore(ScalarLanes, Batch.Scalar.GetData() + First);
+            VectorStore(VectorLanes.X, Batch.VectorX.GetData() + First);
+            VectorStore(VectorLanes.Y, Batch.VectorY.GetData() + First);
+            VectorStore(VectorLanes.Z, Batch.VectorZ.GetData() + First);
+            return;
+        }
+
+        VectorStoreAligned(ScalarLanes, Lanes[3]);
+        VectorStoreAligned(VectorLanes.X, Lanes[4]);
+        VectorStoreAligned(VectorLanes.Y, Lanes[5]);
+        VectorStoreAligned(VectorLanes.Z, Lanes[6]);
+        for (int32 Lane = 0; Lane < Count; ++Lane)
+        {
+            Batch.Scalar[First + Lane] = Lanes[3][Lane];
+            Batch.VectorX[First + Lane] = Lanes[4][Lane];
+            Batch.VectorY[First + Lane] = Lanes[5][Lane];
+            Batch.VectorZ[First + Lane] = Lanes[6][Lane];
+        }
+    };
+
+    // A few hundred light samplers finish faster than a task dispatch; split larger batches
+    constexpr int32 PointsPerTask = 1024;
+    const int32 NumTasks = FMath::DivideAndRoundUp(NumPoints, PointsPerTask);
+    ParallelFor(NumTasks, [&](int32 Task)
+    {
+        const int32 End = FMath::Min(NumPoints, (Task + 1) * PointsPerTask);
+        for (int32 First = Task * PointsPerTask; First < End; First += 4)
+        {
+            EvaluateGroup(First);
+        }
+    }, NumTasks == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
+
+void FRshipFieldCpuEvaluator::BuildAtlas(FRshipFieldCpuAtlas& OutAtlas) const
+{
+    OutAtlas.Allocate(FieldResolution, TilesPerRow);
+    if (FieldResolution <= 0 || TilesPerRow <= 0)
+    {
+        return;
+    }
+
+    // Slices without a tile are dropped, as the GPU drops out of bounds UAV writes
+    const int32 SliceCount = FMath::Min(FieldResolution, TilesPerRow * TilesPerRow);
+    const int32 AtlasSize = OutAtlas.GetAtlasSize();
+    ParallelFor(SliceCount, [this, &OutAtlas, AtlasSize](int32 Z)
+    {
+        const int32 TileOrigin = OutAtlas.GetAtlasIndex(0, 0, Z);
+        EvaluateSlice(Z, OutAtlas.Scalar.GetData() + TileOrigin, OutAtlas.Vector.GetData() + TileOrigin, AtlasSize);
+    });
+}
+
+void FRshipFieldCpuEvaluator::UpdateAtlasTiles(FRshipFieldCpuAtlas& InOutAtlas, TConstArrayView<uint32> Tiles) const
+{
+    if (InOutAtlas.FieldResolution != FieldResolution || InOutAtlas.TilesPerRow != TilesPerRow || InOutAtlas.Scalar.Num() == 0)
+    {
+        BuildAtlas(InOutAtlas);
+        return;
+    }
+
+    constexpr int32 TileSize = FRshipFieldEffectorTiles::TileSize;
+    const int32 TilesPerAxis = FMath::DivideAndRoundUp(FieldResolution, TileSize);
+    const int32 SliceCount = FMath::Min(FieldResolution, TilesPerRow * TilesPerRow);
+    ParallelFor(Tiles.Num(), [&](int32 ListIndex)
+    {
+        const int32 Tile = static_cast<int32>(Tiles[ListIndex]);
+        const int32 TileX = (Tile % TilesPerAxis) * TileSize;
+        const int32 TileY = ((Tile / TilesPerAxis) % TilesPerAxis) * TileSize;
+        const int32 TileZ = (Tile / (TilesPerAxis * TilesPerAxis)) * TileSize;
+        for (int32 Z = TileZ; Z < FMath::Min(TileZ + TileSize, SliceCount); ++Z)
+        {
+            for (int32 Y = TileY; Y < FMath::Min(TileY + TileSize, FieldResolution); ++Y)
+            {
+                // Row Y of slice Z, shifted so EvaluateRow can index it by X
+                const int32 RowOrigin = InOutAtlas.GetAtlasIndex(0, Y, Z);
+                EvaluateRow(TileX, FMath::Min(TileX + TileSize, FieldResolution), Y, Z,
+                    InOutAtlas.Scalar.GetData() + RowOrigin, InOutAtlas.Vector.GetData() + RowOrigin);
+            }
+        }
+    });
+}
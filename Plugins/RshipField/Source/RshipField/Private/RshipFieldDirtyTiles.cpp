@@ -0,0 +1,211 @@
+#include "RshipFieldDirtyTiles.h"
+
+#include "Hash/CityHash.h"
+#include "RshipFieldShaders.h"
+
+namespace
+{
+// (uint)max(0, floor(x + 0.5)), as the kernel decodes packed enums and indices.
+int32 DecodeIndex(float Value)
+{
+    return FMath::Max(FMath::FloorToInt32(Value + 0.5f), 0);
+}
+
+struct FHasher
+{
+    uint64 Hash = 0;
+
+    template <typename T>
+    void Add(const T& Value)
+    {
+        Hash = CityHash64WithSeed(reinterpret_cast<const char*>(&Value), sizeof(T), Hash);
+    }
+
+    // Out of range entries read as zero on the GPU and never change, so only the valid part counts.
+    void AddRange(const TArray<FVector4f>& Buffer, int32 First, int32 Count)
+    {
+        const int32 Begin = FMath::Clamp(First, 0, Buffer.Num());
+        const int32 End = FMath::Clamp(First + Count, Begin, Buffer.Num());
+        Add(End - Begin);
+        Hash = CityHash64WithSeed(reinterpret_cast<const char*>(Buffer.GetData() + Begin), (End - Begin) * sizeof(FVector4f), Hash);
+    }
+};
+
+uint64 HashShared(const RshipFieldRDG::FGlobalDispatchInputs& Inputs, int32 EffectorCount)
+{
+    FHasher Hasher;
+    Hasher.Add(Inputs.FieldResolution);
+    Hasher.Add(Inputs.TilesPerRow);
+    Hasher.Add(Inputs.DomainMinCm);
+    Hasher.Add(Inputs.DomainMaxCm);
+    Hasher.Add(Inputs.MasterScalarGain);
+    Hasher.Add(Inputs.MasterVectorGain);
+    Hasher.Add(Inputs.DebugMode);
+    Hasher.Add(Inputs.DebugSelectionIndex);
+    Hasher.Add(EffectorCount);
+    Hasher.AddRange(Inputs.LayerDataA, 0, Inputs.LayerDataA.Num());
+    Hasher.AddRange(Inputs.LayerDataB, 0, Inputs.LayerDataB.Num());
+
+    // A new render target starts out cleared, not with last step's field
+    Hasher.Add(Inputs.OutScalarFieldAtlasTexture.GetReference());
+    Hasher.Add(Inputs.OutVectorFieldAtlasTexture.GetReference());
+    return Hasher.Hash;
+}
+
+// Everything effector EffectorIndex's atlas contribution depends on this step. The clock only
+// goes in where the kernel reads it, so static effectors hash the same from step to step.
+uint64 HashEffector(const RshipFieldRDG::FGlobalDispatchInputs& Inputs, int32 EffectorIndex, uint64 SplineDataHash)
+{
+    const FVector4f& E1 = Inputs.EffectorData1[EffectorIndex];
+    const FVector4f& E2 = Inputs.EffectorData2[EffectorIndex];
+    const FVector4f& E3 = Inputs.EffectorData3[EffectorIndex];
+    const FVector4f& E5 = Inputs.EffectorData5[EffectorIndex];
+    const FVector4f& E7 = Inputs.EffectorData7[EffectorIndex];
+
+    FHasher Hasher;
+    Hasher.Add(Inputs.EffectorData0[EffectorIndex]);
+    Hasher.Add(E1);
+    Hasher.Add(E2);
+    Hasher.Add(E3);
+    Hasher.Add(Inputs.EffectorData4[EffectorIndex]);
+    Hasher.Add(E5);
+    Hasher.Add(Inputs.EffectorData6[EffectorIndex]);
+    Hasher.Add(E7);
+
+    const ERshipFieldEffectorType Type = static_cast<ERshipFieldEffectorType>(DecodeIndex(E3.Z));
+    const bool bPath = DecodeIndex(E3.Z) >= static_cast<int32>(ERshipFieldEffectorType::Spline);
+    const bool bTraveling = !bPath && Type != ERshipFieldEffectorType::Attractor && DecodeIndex(E3.W) == static_cast<int32>(ERshipFieldWaveMode::Traveling);
+    // Fade and amplitude scale the whole wave term; either at zero silences it for good
+    const bool bSilent = E1.W == 0.0f || E3.X == 0.0f;
+
+    if (Type == ERshipFieldEffectorType::Spline)
+    {
+        Hasher.Add(SplineDataHash);
+    }
+
+    // Standing waves, paths and rings: the temporal phase, from the sync group or the clock
+    if (!bSilent && Type != ERshipFieldEffectorType::Attractor && !bTraveling)
+    {
+        const int32 SyncGroupIndex = DecodeIndex(E5.X);
+        if (Inputs.SyncGroupData.IsValidIndex(SyncGroupIndex) && Inputs.SyncGroupData[SyncGroupIndex].X > 0.5f)
+        {
+            const FVector4f& Group = Inputs.SyncGroupData[SyncGroupIndex];
+            Hasher.Add(Group);
+            if (Group.Y > 0.0f)
+            {
+                Hasher.Add(Inputs.TransportPhase);
+            }
+        }
+        else if ((bPath ? E2.Y : FMath::Max(E2.Y, 0.0f)) != 0.0f)
+        {
+            Hasher.Add(Inputs.TimeSeconds);
+        }
+    }
+
+    // Traveling waves: every live wavefront moves with the clock
+    if (!bSilent && bTraveling && DecodeIndex(E7.Y) > 0)
+    {
+        Hasher.Add(Inputs.TimeSeconds);
+        Hasher.AddRange(Inputs.WavefrontData, DecodeIndex(E7.X), DecodeIndex(E7.Y));
+    }
+
+    // Noise scrolls with the clock
+    const bool bNoise = !bPath && Type != ERshipFieldEffectorType::Attractor
+        && DecodeIndex(E5.Y) != 0 && FMath::Abs(E5.W) > 1e-5f && E3.X != 0.0f;
+    if (bNoise)
+    {
+        Hasher.Add(Inputs.TimeSeconds);
+    }
+    return Hasher.Hash;
+}
+} // namespace
+
+void FRshipFieldDirtyTiles::Invalidate()
+{
+    Effectors.Reset();
+    bHasPrevious = false;
+}
+
+void FRshipFieldDirtyTiles::Update(const RshipFieldRDG::FGlobalDispatchInputs& Inputs)
+{
+    FieldResolution = FMath::Max(Inputs.FieldResolution, 0);
+    TilesPerAxis = FMath::DivideAndRoundUp(FieldResolution, TileSize);
+    DirtyTiles.Reset();
+
+    // Bounds clip the effector count to the shortest packed buffer, as the kernel reads them
+    const TArray<FRshipFieldEffectorTiles::FEffectorBounds> Bounds = FRshipFieldEffectorTiles::ComputeBounds(Inputs);
+    const int32 EffectorCount = Bounds.Num();
+
+    const uint64 NewSharedHash = HashShared(Inputs, EffectorCount);
+    bFullUpdate = !bHasPrevious || NewSharedHash != SharedHash || FieldResolution == 0;
+    if (!bFullUpdate)
+    {
+        DirtyMask.Init(false, GetNumTiles());
+    }
+
+    // Paths are rarely edited; one hash over all of them keeps this linear
+    FHasher SplineHasher;
+    SplineHasher.AddRange(Inputs.SplineNodeData, 0, Inputs.SplineNodeData.Num());
+    SplineHasher.AddRange(Inputs.SplineSegmentData, 0, Inputs.SplineSegmentData.Num());
+
+    auto MarkDirty = [this, &Inputs](const FRshipFieldEffectorTiles::FEffectorBounds& EffectorBounds)
+    {
+        if (EffectorBounds.Cull == FRshipFieldEffectorTiles::ECull::Global)
+        {
+            bFullUpdate = true;
+            return;
+        }
+        FRshipFieldEffectorTiles::ForEachOverlappedTile(Inputs, EffectorBounds, [this](int32 Tile) { DirtyMask[Tile] = true; });
+    };
+
+    Effectors.SetNum(EffectorCount);
+    for (int32 EffectorIndex = 0; EffectorIndex < EffectorCount; ++EffectorIndex)
+    {
+        FEffectorState& State = Effectors[EffectorIndex];
+        const uint64 Hash = HashEffector(Inputs, EffectorIndex, SplineHasher.Hash);
+
+        // Where it was and where it is now
+        if (!bFullUpdate && Hash != State.Hash)
+        {
+            MarkDirty(State.Bounds);
+            MarkDirty(Bounds[EffectorIndex]);
+        }
+        State.Hash = Hash;
+        State.Bounds = Bounds[EffectorIndex];
+    }
+    SharedHash = NewSharedHash;
+    bHasPrevious = true;
+
+    NumDirtyVoxels = 0;
+    if (!bFullUpdate)
+    {
+        for (TConstSetBitIterator<> It(DirtyMask); It; ++It)
+        {
+            DirtyTiles.Add(static_cast<uint32>(It.GetIndex()));
+            NumDirtyVoxels += GetTileVoxelCount(It.GetIndex());
+        }
+        bFullUpdate = DirtyTiles.Num() == GetNumTiles();
+    }
+    if (bFullUpdate)
+    {
+        DirtyTiles.Reset();
+        NumDirtyVoxels = static_cast<int64>(FieldResolution) * FieldResolution * FieldResolution;
+    }
+}
+
+float FRshipFieldDirtyTiles::GetDirtyVoxelFraction() const
+{
+    const int64 NumVoxels = static_cast<int64>(FieldResolution) * FieldResolution * FieldResolution;
+    return NumVoxels > 0 ? static_cast<float>(static_cast<double>(NumDirtyVoxels) / static_cast<double>(NumVoxels)) : 0.0f;
+}
+
+int64 FRshipFieldDirtyTiles::GetTileVoxelCount(int32 Tile) const
+{
+    const int32 Coords[3] = { Tile % TilesPerAxis, (Tile / TilesPerAxis) % TilesPerAxis, Tile / (TilesPerAxis * TilesPerAxis) };
+    int64 Count = 1;
+    for (const int32 Coord : Coords)
+    {
+        Count *= FMath::Min(TileSize, FieldResolution - Coord * TileSize);
+    }
+    return Count;
+}
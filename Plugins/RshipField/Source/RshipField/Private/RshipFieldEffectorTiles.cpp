@@ -0,0 +1,255 @@
+#include "RshipFieldEffectorTiles.h"
+
+#include "RshipFieldShaders.h"
+
+namespace
+{
+// (uint)max(0, floor(x + 0.5)), as the kernel decodes packed enums and indices.
+int32 DecodeIndex(float Value)
+{
+    return FMath::Max(FMath::FloorToInt32(Value + 0.5f), 0);
+}
+
+FVector3f XYZ(const FVector4f& Value)
+{
+    return FVector3f(Value.X, Value.Y, Value.Z);
+}
+} // namespace
+
+bool FRshipFieldEffectorTiles::FEffectorBounds::Overlaps(const FBox3f& RegionCm) const
+{
+    if (Cull != ECull::Bounded)
+    {
+        return Cull == ECull::Global;
+    }
+    if (SphereRadiusCm > 0.0f)
+    {
+        return RegionCm.ComputeSquaredDistanceToPoint(CenterCm) < FMath::Square(SphereRadiusCm);
+    }
+    return BoxCm.Intersect(RegionCm);
+}
+
+TArray<FRshipFieldEffectorTiles::FEffectorBounds> FRshipFieldEffectorTiles::ComputeBounds(const RshipFieldRDG::FGlobalDispatchInputs& Inputs)
+{
+    const TArray<FVector4f>* EffectorBuffers[] = {
+        &Inputs.EffectorData0, &Inputs.EffectorData1, &Inputs.EffectorData2, &Inputs.EffectorData3,
+        &Inputs.EffectorData4, &Inputs.EffectorData5, &Inputs.EffectorData6, &Inputs.EffectorData7
+    };
+    int32 EffectorCount = Inputs.EffectorCount;
+    for (const TArray<FVector4f>* Buffer : EffectorBuffers)
+    {
+        EffectorCount = FMath::Min(EffectorCount, Buffer->Num());
+    }
+
+    TArray<FEffectorBounds> Bounds;
+    Bounds.SetNum(EffectorCount);
+    int32 FirstOrderSensitive = INDEX_NONE;
+    for (int32 EffectorIndex = 0; EffectorIndex < EffectorCount; ++EffectorIndex)
+    {
+        const FVector4f& E0 = Inputs.EffectorData0[EffectorIndex];
+        const FVector4f& E1 = Inputs.EffectorData1[EffectorIndex];
+        const FVector4f& E3 = Inputs.EffectorData3[EffectorIndex];
+        const FVector4f& E4 = Inputs.EffectorData4[EffectorIndex];
+        const FVector4f& E6 = Inputs.EffectorData6[EffectorIndex];
+        const FVector4f& E7 = Inputs.EffectorData7[EffectorIndex];
+
+        FEffectorBounds& Effector = Bounds[EffectorIndex];
+        if (E6.X < 0.5f || E6.Y > 0.5f)
+        {
+            continue;
+        }
+
+        // Out of range the signal is clamp(0, min, max); blended by Add or Subtract that is only a no-op if it stays zero
+        const int32 BlendOp = DecodeIndex(E4.Z);
+        const bool bAdditive = BlendOp == static_cast<int32>(ERshipFieldBlendOp::Add) || BlendOp == static_cast<int32>(ERshipFieldBlendOp::Subtract);
+        if (!bAdditive || E4.X > 0.0f || E4.Y < 0.0f)
+        {
+            Effector.Cull = ECull::Global;
+            if (FirstOrderSensitive == INDEX_NONE)
+            {
+                FirstOrderSensitive = EffectorIndex;
+            }
+            continue;
+        }
+
+        // Kernel distances are rounded differently from these bounds; pad well past that
+        const float RadiusCm = FMath::Max(E0.W, 0.001f);
+        const float ReachCm = RadiusCm + 1.0f + RadiusCm * 1e-3f;
+
+        Effector.Cull = ECull::Bounded;
+        switch (static_cast<ERshipFieldEffectorType>(DecodeIndex(E3.Z)))
+        {
+        case ERshipFieldEffectorType::Wave:
+        case ERshipFieldEffectorType::Noise:
+        case ERshipFieldEffectorType::Attractor:
+            // Wavefront envelopes are Gaussian and never reach zero; only the falloff radius bounds a wave
+            Effector.CenterCm = XYZ(E0);
+            Effector.SphereRadiusCm = ReachCm;
+            Effector.BoxCm = FBox3f(Effector.CenterCm - FVector3f(ReachCm), Effector.CenterCm + FVector3f(ReachCm));
+            break;
+        case ERshipFieldEffectorType::Spline:
+        {
+            // Root node bounds the whole path
+            const int32 Node = DecodeIndex(E7.X) * 2;
+            if (Node + 1 >= Inputs.SplineNodeData.Num())
+            {
+                Effector.Cull = ECull::Global;
+                break;
+            }
+            Effector.BoxCm = FBox3f(XYZ(Inputs.SplineNodeData[Node]), XYZ(Inputs.SplineNodeData[Node + 1])).ExpandBy(ReachCm);
+            break;
+        }
+        case ERshipFieldEffectorType::Ring:
+        {
+            // Torus: the ring circle spans RingRadius * sqrt(1 - axis_i^2) along each world axis
+            const FVector3f AxisIn = XYZ(E1);
+            const FVector3f Axis = AxisIn.SizeSquared() < 1e-10f ? FVector3f(0.0f, 0.0f, 1.0f) : AxisIn.GetUnsafeNormal();
+            const float RingRadiusCm = FMath::Abs(E7.Y);
+            const FVector3f Extent(
+                RingRadiusCm * FMath::Sqrt(FMath::Max(1.0f - Axis.X * Axis.X, 0.0f)) + ReachCm,
+                RingRadiusCm * FMath::Sqrt(FMath::Max(1.0f - Axis.Y * Axis.Y, 0.0f)) + ReachCm,
+                RingRadiusCm * FMath::Sqrt(FMath::Max(1.0f - Axis.Z * Axis.Z, 0.0f)) + ReachCm);
+            Effector.CenterCm = XYZ(E0);
+            Effector.BoxCm = FBox3f(Effector.CenterCm - Extent, Effector.CenterCm + Extent);
+            break;
+        }
+        default:
+            Effector.Cull = ECull::Global;
+            break;
+        }
+    }
+
+    // Until the first order-sensitive effector, the first additive one to blend initializes
+    // the layer; culling it would hand that to the order-sensitive one and change the result.
+    // With no order-sensitive effector at all, a zero additive term is a no-op everywhere.
+    for (int32 EffectorIndex = 0; EffectorIndex < FirstOrderSensitive; ++EffectorIndex)
+    {
+        if (Bounds[EffectorIndex].Cull == ECull::Bounded)
+        {
+            Bounds[EffectorIndex].Cull = ECull::Global;
+        }
+    }
+    return Bounds;
+}
+
+void FRshipFieldEffectorTiles::Reset()
+{
+    Offsets.Reset();
+    Indices.Reset();
+    FieldResolution = 0;
+    TilesPerAxis = 0;
+}
+
+void FRshipFieldEffectorTiles::ForEachOverlappedTile(const RshipFieldRDG::FGlobalDispatchInputs& Inputs, const FEffectorBounds& Effector, TFunctionRef<void(int32)> Visit)
+{
+    const int32 FieldResolution = Inputs.FieldResolution;
+    if (FieldResolution <= 0 || Effector.Cull == ECull::Skipped)
+    {
+        return;
+    }
+
+    const int32 TilesPerAxis = FMath::DivideAndRoundUp(FieldResolution, TileSize);
+    if (Effector.Cull == ECull::Global)
+    {
+        const int32 NumTiles = TilesPerAxis * TilesPerAxis * TilesPerAxis;
+        for (int32 Tile = 0; Tile < NumTiles; ++Tile)
+        {
+            Visit(Tile);
+        }
+        return;
+    }
+
+    const FVector3f DomainMin = XYZ(Inputs.DomainMinCm);
+    const FVector3f DomainMax = XYZ(Inputs.DomainMaxCm);
+
+    // Tiles span whole voxel cells, so the voxel centers the kernel evaluates sit half a voxel inside
+    auto TileBoundary = [&](int32 Axis, int32 Tile)
+    {
+        const float Alpha = static_cast<float>(FMath::Min(Tile * TileSize, FieldResolution)) / static_cast<float>(FieldResolution);
+        return FMath::Lerp(DomainMin[Axis], DomainMax[Axis], Alpha);
+    };
+
+    // Candidate tiles along one axis; the exact overlap test runs per tile afterwards
+    int32 First[3];
+    int32 Last[3];
+    for (int32 Axis = 0; Axis < 3; ++Axis)
+    {
+        const float SizeCm = DomainMax[Axis] - DomainMin[Axis];
+        if (FMath::Abs(SizeCm) <= UE_SMALL_NUMBER)
+        {
+            First[Axis] = 0;
+            Last[Axis] = TilesPerAxis - 1;
+            continue;
+        }
+
+        const float TilesPerCm = static_cast<float>(FieldResolution) / (SizeCm * TileSize);
+        float Low = (Effector.BoxCm.Min[Axis] - DomainMin[Axis]) * TilesPerCm;
+        float High = (Effector.BoxCm.Max[Axis] - DomainMin[Axis]) * TilesPerCm;
+        if (Low > High)
+        {
+            Swap(Low, High);
+        }
+        if (High < 0.0f || Low > static_cast<float>(TilesPerAxis))
+        {
+            return;
+        }
+        First[Axis] = FMath::Clamp(FMath::FloorToInt32(Low), 0, TilesPerAxis - 1);
+        Last[Axis] = FMath::Clamp(FMath::FloorToInt32(High), 0, TilesPerAxis - 1);
+    }
+
+    for (int32 Z = First[2]; Z <= Last[2]; ++Z)
+    {
+        for (int32 Y = First[1]; Y <= Last[1]; ++Y)
+        {
+            for (int32 X = First[0]; X <= Last[0]; ++X)
+            {
+                FBox3f TileBox(ForceInit);
+                TileBox += FVector3f(TileBoundary(0, X), TileBoundary(1, Y), TileBoundary(2, Z));
+                TileBox += FVector3f(TileBoundary(0, X + 1), TileBoundary(1, Y + 1), TileBoundary(2, Z + 1));
+                if (Effector.Overlaps(TileBox))
+                {
+                    Visit((Z * TilesPerAxis + Y) * TilesPerAxis + X);
+                }
+            }
+        }
+    }
+}
+
+void FRshipFieldEffectorTiles::Build(const RshipFieldRDG::FGlobalDispatchInputs& Inputs)
+{
+    Reset();
+    if (Inputs.FieldResolution <= 0)
+    {
+        return;
+    }
+
+    FieldResolution = Inputs.FieldResolution;
+    TilesPerAxis = FMath::DivideAndRoundUp(FieldResolution, TileSize);
+    const int32 NumTiles = TilesPerAxis * TilesPerAxis * TilesPerAxis;
+    const TArray<FEffectorBounds> Bounds = ComputeBounds(Inputs);
+
+    // Count, prefix sum, then fill in effector order so every list comes out ascending
+    TArray<uint32> Counts;
+    Counts.SetNumZeroed(NumTiles);
+    for (const FEffectorBounds& Effector : Bounds)
+    {
+        ForEachOverlappedTile(Inputs, Effector, [&Counts](int32 Tile) { ++Counts[Tile]; });
+    }
+
+    Offsets.SetNumUninitialized(NumTiles + 1);
+    Offsets[0] = 0;
+    for (int32 Tile = 0; Tile < NumTiles; ++Tile)
+    {
+        Offsets[Tile + 1] = Offsets[Tile] + Counts[Tile];
+    }
+
+    Indices.SetNumUninitialized(Offsets[NumTiles]);
+    TArray<uint32> Cursor(Offsets.GetData(), NumTiles);
+    for (int32 EffectorIndex = 0; EffectorIndex < Bounds.Num(); ++EffectorIndex)
+    {
+        ForEachOverlappedTile(Inputs, Bounds[EffectorIndex], [this, &Cursor, EffectorIndex](int32 Tile)
+        {
+            Indices[Cursor[Tile]++] = static_cast<uint32>(EffectorIndex);
+        });
+    }
+}
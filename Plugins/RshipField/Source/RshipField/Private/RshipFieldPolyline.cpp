@@ -0,0 +1,262 @@
+#include "RshipFieldPolyline.h"
+
+#include "Components/SplineComponent.h"
+
+namespace
+{
+float BoxDistanceSquared(const FBox3f& Box, const FVector3f& Position)
+{
+    const FVector3f Below = Box.Min - Position;
+    const FVector3f Above = Position - Box.Max;
+    const FVector3f Outside(
+        FMath::Max3(Below.X, Above.X, 0.0f),
+        FMath::Max3(Below.Y, Above.Y, 0.0f),
+        FMath::Max3(Below.Z, Above.Z, 0.0f));
+    return Outside.SizeSquared();
+}
+} // namespace
+
+void FRshipFieldPolyline::Reset()
+{
+    Nodes.Reset();
+    SegmentStart.Reset();
+    SegmentEnd.Reset();
+    SegmentArcStart.Reset();
+    LengthCm = 0.0f;
+    bClosed = false;
+}
+
+void FRshipFieldPolyline::Build(TConstArrayView<FVector3f> PointsCm, bool bClosedLoop)
+{
+    Reset();
+    bClosed = bClosedLoop;
+
+    // Segments in path order first; they are reordered into leaf order once the tree exists
+    TArray<FVector3f> Starts;
+    TArray<FVector3f> Ends;
+    TArray<float> ArcStarts;
+    Starts.Reserve(PointsCm.Num());
+    Ends.Reserve(PointsCm.Num());
+    ArcStarts.Reserve(PointsCm.Num());
+
+    auto AddSegment = [&](const FVector3f& Start, const FVector3f& End)
+    {
+        const float Length = FVector3f::Distance(Start, End);
+        if (Length <= UE_KINDA_SMALL_NUMBER)
+        {
+            return;
+        }
+        Starts.Add(Start);
+        Ends.Add(End);
+        ArcStarts.Add(LengthCm);
+        LengthCm += Length;
+    };
+
+    for (int32 i = 1; i < PointsCm.Num(); ++i)
+    {
+        AddSegment(PointsCm[i - 1], PointsCm[i]);
+    }
+    if (bClosedLoop && PointsCm.Num() > 2)
+    {
+        AddSegment(PointsCm.Last(), PointsCm[0]);
+    }
+
+    const int32 NumSegments = Starts.Num();
+    if (NumSegments == 0)
+    {
+        return;
+    }
+
+    TArray<FVector3f> Centroids;
+    TArray<int32> Order;
+    Centroids.SetNumUninitialized(NumSegments);
+    Order.SetNumUninitialized(NumSegments);
+    for (int32 i = 0; i < NumSegments; ++i)
+    {
+        Centroids[i] = (Starts[i] + Ends[i]) * 0.5f;
+        Order[i] = i;
+    }
+
+    SegmentStart = MoveTemp(Starts);
+    SegmentEnd = MoveTemp(Ends);
+    SegmentArcStart = MoveTemp(ArcStarts);
+
+    Nodes.Reserve(2 * FMath::DivideAndRoundUp(NumSegments, LeafSize));
+    Nodes.AddDefaulted();
+    BuildNode(0, 0, NumSegments, Order, Centroids);
+
+    TArray<FVector3f> LeafStarts;
+    TArray<FVector3f> LeafEnds;
+    TArray<float> LeafArcStarts;
+    LeafStarts.SetNumUninitialized(NumSegments);
+    LeafEnds.SetNumUninitialized(NumSegments);
+    LeafArcStarts.SetNumUninitialized(NumSegments);
+    for (int32 i = 0; i < NumSegments; ++i)
+    {
+        LeafStarts[i] = SegmentStart[Order[i]];
+        LeafEnds[i] = SegmentEnd[Order[i]];
+        LeafArcStarts[i] = SegmentArcStart[Order[i]];
+    }
+    SegmentStart = MoveTemp(LeafStarts);
+    SegmentEnd = MoveTemp(LeafEnds);
+    SegmentArcStart = MoveTemp(LeafArcStarts);
+}
+
+void FRshipFieldPolyline::GetPathPoints(TArray<FVector3f>& OutPointsCm) const
+{
+    OutPointsCm.Reset();
+    const int32 NumSegments = SegmentStart.Num();
+    if (NumSegments == 0)
+    {
+        return;
+    }
+
+    // Segments are in leaf order; arc length puts them back in path order
+    TArray<int32> Order;
+    Order.SetNumUninitialized(NumSegments);
+    for (int32 i = 0; i < NumSegments; ++i)
+    {
+        Order[i] = i;
+    }
+    Order.Sort([this](int32 A, int32 B) { return SegmentArcStart[A] < SegmentArcStart[B]; });
+
+    OutPointsCm.Reserve(NumSegments + 1);
+    for (const int32 Segment : Order)
+    {
+        OutPointsCm.Add(SegmentStart[Segment]);
+    }
+
+    // A loop's last segment ends where the first starts, and Build adds it back
+    const FVector3f& LastEnd = SegmentEnd[Order.Last()];
+    if (!bClosed || LastEnd != OutPointsCm[0])
+    {
+        OutPointsCm.Add(LastEnd);
+    }
+}
+
+void FRshipFieldPolyline::BuildNode(int32 NodeIndex, int32 First, int32 Count, TArray<int32>& Order, const TArray<FVector3f>& Centroids)
+{
+    FBox3f Bounds(ForceInit);
+    FBox3f CentroidBounds(ForceInit);
+    for (int32 i = First; i < First + Count; ++i)
+    {
+        Bounds += SegmentStart[Order[i]];
+        Bounds += SegmentEnd[Order[i]];
+        CentroidBounds += Centroids[Order[i]];
+    }
+    Nodes[NodeIndex].Bounds = Bounds;
+
+    if (Count <= LeafSize)
+    {
+        Nodes[NodeIndex].First = First;
+        Nodes[NodeIndex].Count = Count;
+        return;
+    }
+
+    const FVector3f Extent = CentroidBounds.GetSize();
+    const int32 Axis = (Extent.X >= Extent.Y && Extent.X >= Extent.Z) ? 0 : (Extent.Y >= Extent.Z ? 1 : 2);
+    TArrayView<int32>(Order.GetData() + First, Count).Sort([&Centroids, Axis](int32 A, int32 B)
+    {
+        return Centroids[A][Axis] < Centroids[B][Axis] || (Centroids[A][Axis] == Centroids[B][Axis] && A < B);
+    });
+
+    // Children are allocated as a pair so the shader only needs the first index
+    const int32 Left = Nodes.AddDefaulted(2);
+    Nodes[NodeIndex].First = Left;
+    Nodes[NodeIndex].Count = 0;
+
+    const int32 Half = Count / 2;
+    BuildNode(Left, First, Half, Order, Centroids);
+    BuildNode(Left + 1, First + Half, Count - Half, Order, Centroids);
+}
+
+void FRshipFieldPolyline::BuildFromSpline(const USplineComponent& Spline, float ToleranceCm)
+{
+    TArray<FVector> Points;
+    Spline.ConvertSplineToPolyLine(ESplineCoordinateSpace::World, FMath::Square(FMath::Max(ToleranceCm, 0.1f)), Points);
+
+    TArray<FVector3f> PointsCm;
+    PointsCm.Reserve(Points.Num());
+    for (const FVector& Point : Points)
+    {
+        PointsCm.Add(FVector3f(Point));
+    }
+
+    // A closed spline's polyline may already end on its first point; Build skips the empty closing segment
+    Build(PointsCm, Spline.IsClosedLoop());
+}
+
+FRshipFieldPolylineHit FRshipFieldPolyline::FindClosest(const FVector3f& PositionCm, float MaxDistanceCm) const
+{
+    FRshipFieldPolylineHit Hit;
+    if (Nodes.Num() == 0)
+    {
+        return Hit;
+    }
+
+    float BestDistanceSq = MaxDistanceCm < UE_BIG_NUMBER ? FMath::Square(MaxDistanceCm) : MAX_flt;
+    float BestT = 0.0f;
+
+    int32 Stack[MaxDepth * 2];
+    int32 StackSize = 0;
+    Stack[StackSize++] = 0;
+    while (StackSize > 0)
+    {
+        const FNode& Node = Nodes[Stack[--StackSize]];
+        if (BoxDistanceSquared(Node.Bounds, PositionCm) >= BestDistanceSq)
+        {
+            continue;
+        }
+
+        if (Node.Count == 0)
+        {
+            // Right first so the left child is visited first
+            Stack[StackSize++] = Node.First + 1;
+            Stack[StackSize++] = Node.First;
+            continue;
+        }
+
+        for (int32 Segment = Node.First; Segment < Node.First + Node.Count; ++Segment)
+        {
+            const FVector3f Delta = SegmentEnd[Segment] - SegmentStart[Segment];
+            const float T = FMath::Clamp(FVector3f::DotProduct(PositionCm - SegmentStart[Segment], Delta) / Delta.SizeSquared(), 0.0f, 1.0f);
+            const float DistanceSq = FVector3f::DistSquared(PositionCm, SegmentStart[Segment] + Delta * T);
+            if (DistanceSq < BestDistanceSq)
+            {
+                BestDistanceSq = DistanceSq;
+                BestT = T;
+                Hit.SegmentIndex = Segment;
+            }
+        }
+    }
+
+    if (Hit.IsValid())
+    {
+        const FVector3f Delta = SegmentEnd[Hit.SegmentIndex] - SegmentStart[Hit.SegmentIndex];
+        const float SegmentLength = Delta.Size();
+        Hit.DistanceCm = FMath::Sqrt(BestDistanceSq);
+        Hit.ClosestPointCm = SegmentStart[Hit.SegmentIndex] + Delta * BestT;
+        Hit.ArcLengthCm = SegmentArcStart[Hit.SegmentIndex] + BestT * SegmentLength;
+        Hit.Tangent = Delta / SegmentLength;
+    }
+    return Hit;
+}
+
+void FRshipFieldPolyline::Pack(TArray<FVector4f>& OutNodeData, TArray<FVector4f>& OutSegmentData) const
+{
+    OutNodeData.Reserve(OutNodeData.Num() + Nodes.Num() * 2);
+    for (const FNode& Node : Nodes)
+    {
+        OutNodeData.Add(FVector4f(Node.Bounds.Min.X, Node.Bounds.Min.Y, Node.Bounds.Min.Z, static_cast<float>(Node.First)));
+        OutNodeData.Add(FVector4f(Node.Bounds.Max.X, Node.Bounds.Max.Y, Node.Bounds.Max.Z, static_cast<float>(Node.Count)));
+    }
+
+    OutSegmentData.Reserve(OutSegmentData.Num() + SegmentStart.Num() * 2);
+    for (int32 Segment = 0; Segment < SegmentStart.Num(); ++Segment)
+    {
+        const FVector3f& Start = SegmentStart[Segment];
+        const FVector3f& End = SegmentEnd[Segment];
+        OutSegmentData.Add(FVector4f(Start.X, Start.Y, Start.Z, SegmentArcStart[Segment]));
+        OutSegmentData.Add(FVector4f(End.X, End.Y, End.Z, FVector3f::Distance(Start, End)));
+    }
+}
@@ -0,0 +1,77 @@
+#include "RshipFieldQuery.h"
+
+#include "RshipFieldCpuEvaluator.h"
+
+#include "Tasks/Task.h"
+
+FRshipFieldQueryQueue::~FRshipFieldQueryQueue()
+{
+    Cancel();
+}
+
+TFuture<FRshipFieldQueryResult> FRshipFieldQueryQueue::Submit(TArray<FVector> PositionsCm)
+{
+    FQuery& Query = Pending.AddDefaulted_GetRef();
+    Query.PositionsCm = MoveTemp(PositionsCm);
+    return Query.Promise.GetFuture();
+}
+
+int32 FRshipFieldQueryQueue::Flush(TSharedPtr<const FRshipFieldCpuEvaluator> Evaluator)
+{
+    if (Pending.Num() == 0 || !Evaluator.IsValid())
+    {
+        return 0;
+    }
+
+    int32 NumPoints = 0;
+    for (const FQuery& Query : Pending)
+    {
+        NumPoints += Query.PositionsCm.Num();
+    }
+
+    UE::Tasks::Launch(UE_SOURCE_LOCATION,
+        [Evaluator = MoveTemp(Evaluator), Queries = MoveTemp(Pending), NumPoints]() mutable
+        {
+            // One batch for the frame, so every query shares the SIMD groups and task split
+            FRshipFieldPointBatch Batch;
+            Batch.PositionX.Reserve(NumPoints);
+            Batch.PositionY.Reserve(NumPoints);
+            Batch.PositionZ.Reserve(NumPoints);
+            for (const FQuery& Query : Queries)
+            {
+                for (const FVector& PositionCm : Query.PositionsCm)
+                {
+                    Batch.Add(PositionCm);
+                }
+            }
+            Evaluator->EvaluatePoints(Batch);
+
+            int32 First = 0;
+            for (FQuery& Query : Queries)
+            {
+                const int32 Count = Query.PositionsCm.Num();
+                FRshipFieldQueryResult Result;
+                Result.bValid = true;
+                Result.Scalar.Append(Batch.Scalar.GetData() + First, Count);
+                Result.Vector.SetNumUninitialized(Count);
+                for (int32 i = 0; i < Count; ++i)
+                {
+                    Result.Vector[i] = FVector3f(Batch.VectorX[First + i], Batch.VectorY[First + i], Batch.VectorZ[First + i]);
+                }
+                Query.Promise.SetValue(MoveTemp(Result));
+                First += Count;
+            }
+        });
+
+    Pending.Reset();
+    return NumPoints;
+}
+
+void FRshipFieldQueryQueue::Cancel()
+{
+    for (FQuery& Query : Pending)
+    {
+        Query.Promise.SetValue(FRshipFieldQueryResult());
+    }
+    Pending.Reset();
+}
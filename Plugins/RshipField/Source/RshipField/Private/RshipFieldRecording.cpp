@@ -0,0 +1,484 @@
+#include "RshipFieldRecording.h"
+
+#include "RshipFieldComponent.h"
+#include "RshipFieldCpuEvaluator.h"
+#include "RshipFieldShaders.h"
+#include "RshipFieldSimulation.h"
+
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "Serialization/StructuredArchive.h"
+#include "UObject/Package.h"
+#include "UObject/UnrealType.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogRshipFieldRecording, Log, All);
+
+// A recorded URshipFieldComponent property. Values are serialized against a default instance
+// of the element type and loaded over one, so fields left at their defaults cost nothing and
+// fields missing from an older recording read back as defaults.
+class FRshipFieldRecordedProperty
+{
+public:
+    explicit FRshipFieldRecordedProperty(const FProperty& InProperty)
+        : Property(InProperty)
+        , ArrayProperty(CastField<FArrayProperty>(&InProperty))
+        , Element(ArrayProperty ? *ArrayProperty->Inner : InProperty)
+    {
+        Defaults = FMemory::Malloc(Element.GetSize(), Element.GetMinAlignment());
+        Element.InitializeValue(Defaults);
+    }
+
+    ~FRshipFieldRecordedProperty()
+    {
+        Element.DestroyValue(Defaults);
+        FMemory::Free(Defaults);
+    }
+
+    UE_NONCOPYABLE(FRshipFieldRecordedProperty);
+
+    FName GetName() const { return Property.GetFName(); }
+    bool IsArray() const { return ArrayProperty != nullptr; }
+
+    // Elements for arrays, otherwise the one value.
+    int32 Num(const URshipFieldComponent& Field) const
+    {
+        return ArrayProperty ? GetArray(Field).Num() : 1;
+    }
+
+    // New elements are default constructed.
+    void SetNum(URshipFieldComponent& Field, int32 NewNum) const
+    {
+        if (ArrayProperty)
+        {
+            GetArray(Field).Resize(FMath::Max(NewNum, 0));
+        }
+    }
+
+    void* GetValue(const URshipFieldComponent& Field, int32 Index) const
+    {
+        void* Value = Property.ContainerPtrToValuePtr<void>(const_cast<URshipFieldComponent*>(&Field));
+        return ArrayProperty ? FScriptArrayHelper(ArrayProperty, Value).GetRawPtr(Index) : Value;
+    }
+
+    TArray<uint8> Save(const void* Value) const
+    {
+        TArray<uint8> Bytes;
+        FMemoryWriter Writer(Bytes);
+        FObjectAndNameAsStringProxyArchive Ar(Writer, false);
+        FStructuredArchiveFromArchive Structured(Ar);
+        Element.SerializeItem(Structured.GetSlot(), const_cast<void*>(Value), Defaults);
+        return Bytes;
+    }
+
+    void Load(void* Value, TConstArrayView<uint8> Bytes) const
+    {
+        Element.CopySingleValue(Value, Defaults);
+
+        FMemoryReaderView Reader(MakeMemoryView(Bytes));
+        FObjectAndNameAsStringProxyArchive Ar(Reader, true);
+        FStructuredArchiveFromArchive Structured(Ar);
+        Element.SerializeItem(Structured.GetSlot(), Value, Defaults);
+    }
+
+private:
+    FScriptArrayHelper GetArray(const URshipFieldComponent& Field) const
+    {
+        return FScriptArrayHelper(ArrayProperty, Property.ContainerPtrToValuePtr<void>(const_cast<URshipFieldComponent*>(&Field)));
+    }
+
+    const FProperty& Property;
+    const FArrayProperty* ArrayProperty;
+    const FProperty& Element;
+    void* Defaults = nullptr;
+};
+
+namespace
+{
+enum class EEvent : uint8
+{
+    // int32 Property, int32 Element, TArray<uint8> Value. Element is 0 for non-arrays.
+    Value,
+    // int32 Property, int32 Num
+    Num,
+    // int32 WaveEffectorIndex
+    EmitWavefront,
+};
+
+// Everything that decides the atlas. Debug and presentation settings are left out.
+TArray<FName> GetRecordedPropertyNames()
+{
+    return {
+        GET_MEMBER_NAME_CHECKED(URshipFieldComponent, UpdateHz),
+        GET_MEMBER_NAME_CHECKED(URshipFieldComponent, FieldResolution),
+        GET_MEMBER_NAME_CHECKED(URshipFieldComponent, MasterScalarGain),
+        GET_MEMBER_NAME_CHECKED(URshipFieldComponent, MasterVectorGain),
+        GET_MEMBER_NAME_CHECKED(URshipFieldComponent, DomainCenterCm),
+        GET_MEMBER_NAME_CHECKED(URshipFieldComponent, DomainSizeCm),
+        GET_MEMBER_NAME_CHECKED(URshipFieldComponent, Bpm),
+        GET_MEMBER_NAME_CHECKED(URshipFieldComponent, BeatPhase),
+        GET_MEMBER_NAME_CHECKED(URshipFieldComponent, bPlaying),
+        GET_MEMBER_NAME_CHECKED(URshipFieldComponent, SyncGroups),
+        GET_MEMBER_NAME_CHECKED(URshipFieldComponent, Transports),
+        GET_MEMBER_NAME_CHECKED(URshipFieldComponent, WaveEffectors),
+        GET_MEMBER_NAME_CHECKED(URshipFieldComponent, NoiseEffectors),
+        GET_MEMBER_NAME_CHECKED(URshipFieldComponent, AttractorEffectors),
+        GET_MEMBER_NAME_CHECKED(URshipFieldComponent, SplineEffectors),
+        GET_MEMBER_NAME_CHECKED(URshipFieldComponent, RingEffectors),
+    };
+}
+
+TArray<TSharedPtr<const FRshipFieldRecordedProperty>> ResolveProperties(TConstArrayView<FName> Names)
+{
+    TArray<TSharedPtr<const FRshipFieldRecordedProperty>> Properties;
+    for (const FName Name : Names)
+    {
+        const FProperty* Property = URshipFieldComponent::StaticClass()->FindPropertyByName(Name);
+        if (!Property)
+        {
+            UE_LOG(LogRshipFieldRecording, Warning, TEXT("Recorded property '%s' no longer exists on the field component; it will not replay"), *Name.ToString());
+        }
+        TSharedPtr<const FRshipFieldRecordedProperty>& Recorded = Properties.AddDefaulted_GetRef();
+        if (Property)
+        {
+            Recorded = MakeShared<FRshipFieldRecordedProperty>(*Property);
+        }
+    }
+    return Properties;
+}
+
+// Simulation state that is not a property: the clock, the transport clocks and the live wavefronts.
+void SerializeSimulationState(FArchive& Ar, URshipFieldComponent& Field)
+{
+    Ar << Field.SimulationTimeSeconds;
+    Ar << Field.SimulationFrame;
+    Ar << Field.TransportClock;
+    Ar << Field.TransportClocks;
+
+    int32 NumStates = Field.WaveEffectorStates.Num();
+    Ar << NumStates;
+    if (Ar.IsLoading())
+    {
+        Field.WaveEffectorStates.Reset();
+        Field.WaveEffectorStates.SetNum(FMath::Max(NumStates, 0));
+    }
+
+    for (FRshipFieldWaveEffectorState& State : Field.WaveEffectorStates)
+    {
+        Ar << State.LastEmitTime;
+
+        int32 NumWavefronts = State.Wavefronts.Num();
+        Ar << NumWavefronts;
+        for (int32 i = 0; i < NumWavefronts; ++i)
+        {
+            FRshipFieldWavefront Wavefront = Ar.IsLoading() ? FRshipFieldWavefront() : State.Wavefronts[i];
+            FVector3f BirthPositionCm(Wavefront.BirthPositionCm);
+            Ar << Wavefront.BirthTime;
+            Ar << BirthPositionCm;
+            if (Ar.IsLoading())
+            {
+                State.Wavefronts.Emit(Wavefront.BirthTime, FVector(BirthPositionCm), FRshipFieldWavefrontRing::Capacity);
+            }
+        }
+    }
+}
+} // namespace
+
+FArchive& operator<<(FArchive& Ar, FRshipFieldRecording& Recording)
+{
+    uint32 Magic = FRshipFieldRecording::Magic;
+    int32 Version = FRshipFieldRecording::Version;
+    Ar << Magic;
+    Ar << Version;
+    if (Ar.IsLoading() && (Magic != FRshipFieldRecording::Magic || Version != FRshipFieldRecording::Version))
+    {
+        Ar.SetError();
+        return Ar;
+    }
+
+    Ar << Recording.PropertyNames;
+    Ar << Recording.KeyframeInterval;
+    Ar << Recording.StepEvents;
+    Ar << Recording.Keyframes;
+    return Ar;
+}
+
+bool FRshipFieldRecording::SaveToFile(const FString& FilePath) const
+{
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes, true);
+    Writer << const_cast<FRshipFieldRecording&>(*this);
+    return FFileHelper::SaveArrayToFile(Bytes, *FilePath);
+}
+
+bool FRshipFieldRecording::LoadFromFile(const FString& FilePath)
+{
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+    {
+        return false;
+    }
+
+    FRshipFieldRecording Loaded;
+    FMemoryReader Reader(Bytes, true);
+    Reader << Loaded;
+    if (Reader.IsError() || Loaded.KeyframeInterval <= 0 || Loaded.Keyframes.Num() == 0)
+    {
+        return false;
+    }
+    *this = MoveTemp(Loaded);
+    return true;
+}
+
+FRshipFieldRecorder::FRshipFieldRecorder(URshipFieldComponent& Field, int32 KeyframeInterval)
+{
+    Recording.PropertyNames = GetRecordedPropertyNames();
+    Recording.KeyframeInterval = FMath::Max(KeyframeInterval, 1);
+    Properties = ResolveProperties(Recording.PropertyNames);
+    Values.SetNum(Properties.Num());
+
+    CaptureChanges(Field, nullptr);
+    AddKeyframe(Field);
+}
+
+void FRshipFieldRecorder::BeginStep(URshipFieldComponent& Field)
+{
+    CaptureChanges(Field, &PendingEvents);
+    Recording.StepEvents.Add(MoveTemp(PendingEvents));
+    PendingEvents.Reset();
+    bInStep = true;
+}
+
+void FRshipFieldRecorder::EndStep(URshipFieldComponent& Field)
+{
+    bInStep = false;
+    CaptureChanges(Field, nullptr);
+
+    if (Recording.GetNumSteps() % Recording.KeyframeInterval == 0)
+    {
+        AddKeyframe(Field);
+    }
+}
+
+void FRshipFieldRecorder::AddKeyframe(URshipFieldComponent& Field)
+{
+    // Values is current after CaptureChanges, spline actors already baked
+    TArray<uint8>& Keyframe = Recording.Keyframes.AddDefaulted_GetRef();
+    FMemoryWriter Writer(Keyframe);
+    Writer << Values;
+    SerializeSimulationState(Writer, Field);
+}
+
+void FRshipFieldRecorder::RecordEmitWavefront(URshipFieldComponent& Field, int32 WaveEffectorIndex)
+{
+    if (bInStep)
+    {
+        return;
+    }
+
+    // The wavefront is born at the effector's current position, so that goes in first
+    CaptureChanges(Field, &PendingEvents);
+
+    FMemoryWriter Writer(PendingEvents, false, true);
+    EEvent Event = EEvent::EmitWavefront;
+    Writer << Event;
+    Writer << WaveEffectorIndex;
+}
+
+void FRshipFieldRecorder::CaptureChanges(URshipFieldComponent& Field, TArray<uint8>* Events)
+{
+    // Spline actors are recorded as the path the next dispatch will use
+    RshipFieldSimulation::UpdateSplinePaths(Field);
+
+    TOptional<FMemoryWriter> Writer;
+    if (Events)
+    {
+        Writer.Emplace(*Events, false, true);
+    }
+
+    for (int32 PropertyIndex = 0; PropertyIndex < Properties.Num(); ++PropertyIndex)
+    {
+        if (!Properties[PropertyIndex].IsValid())
+        {
+            continue;
+        }
+
+        TArray<TArray<uint8>>& Recorded = Values[PropertyIndex];
+        int32 Num = Properties[PropertyIndex]->Num(Field);
+        if (Writer && Properties[PropertyIndex]->IsArray() && Num != Recorded.Num())
+        {
+            EEvent Event = EEvent::Num;
+            *Writer << Event;
+            *Writer << PropertyIndex;
+            *Writer << Num;
+        }
+        Recorded.SetNum(Num);
+
+        for (int32 Element = 0; Element < Num; ++Element)
+        {
+            TArray<uint8> Value = SaveElement(Field, PropertyIndex, Element);
+            if (Value == Recorded[Element])
+            {
+                continue;
+            }
+            if (Writer)
+            {
+                EEvent Event = EEvent::Value;
+                *Writer << Event;
+                *Writer << PropertyIndex;
+                *Writer << Element;
+                *Writer << Value;
+            }
+            Recorded[Element] = MoveTemp(Value);
+        }
+    }
+}
+
+TArray<uint8> FRshipFieldRecorder::SaveElement(const URshipFieldComponent& Field, int32 PropertyIndex, int32 Element) const
+{
+    const FRshipFieldRecordedProperty& Property = *Properties[PropertyIndex];
+    const void* Value = Property.GetValue(Field, Element);
+
+    if (Property.GetName() == GET_MEMBER_NAME_CHECKED(URshipFieldComponent, SplineEffectors)
+        && Field.SplinePolylines.IsValidIndex(Element) && Field.SplinePolylines[Element].GetNumSegments() > 0)
+    {
+        const FRshipFieldSplineEffector& Spline = *static_cast<const FRshipFieldSplineEffector*>(Value);
+        if (!Spline.SplineActor.IsNull())
+        {
+            const FRshipFieldPolyline& Polyline = Field.SplinePolylines[Element];
+            TArray<FVector3f> PathPoints;
+            Polyline.GetPathPoints(PathPoints);
+
+            FRshipFieldSplineEffector Baked = Spline;
+            Baked.SplineActor.Reset();
+            Baked.bClosedLoop = Polyline.IsClosedLoop();
+            Baked.PointsCm.Reset(PathPoints.Num());
+            for (const FVector3f& Point : PathPoints)
+            {
+                Baked.PointsCm.Add(FVector(Point));
+            }
+            return Property.Save(&Baked);
+        }
+    }
+    return Property.Save(Value);
+}
+
+FRshipFieldReplayer::FRshipFieldReplayer(FRshipFieldRecording InRecording)
+    : Recording(MoveTemp(InRecording))
+    , Field(NewObject<URshipFieldComponent>(GetTransientPackage(), NAME_None, RF_Transient))
+{
+    Recording.KeyframeInterval = FMath::Max(Recording.KeyframeInterval, 1);
+    Properties = ResolveProperties(Recording.PropertyNames);
+    ApplyKeyframe(0);
+}
+
+FRshipFieldReplayer::~FRshipFieldReplayer() = default;
+
+void FRshipFieldReplayer::Seek(int32 Step)
+{
+    Step = FMath::Clamp(Step, 0, GetNumSteps());
+    const int32 Keyframe = FMath::Min(Step / Recording.KeyframeInterval, Recording.Keyframes.Num() - 1);
+    if (Step < CurrentStep || Keyframe * Recording.KeyframeInterval > CurrentStep)
+    {
+        ApplyKeyframe(Keyframe);
+    }
+    while (CurrentStep < Step && StepForward())
+    {
+    }
+}
+
+bool FRshipFieldReplayer::StepForward()
+{
+    if (CurrentStep >= GetNumSteps())
+    {
+        return false;
+    }
+    ApplyEvents(Recording.StepEvents[CurrentStep]);
+    RshipFieldSimulation::Step(*Field);
+    ++CurrentStep;
+    return true;
+}
+
+void FRshipFieldReplayer::BuildGlobalInputs(RshipFieldRDG::FGlobalDispatchInputs& OutInputs)
+{
+    RshipFieldSimulation::BuildGlobalInputs(*Field, OutInputs);
+}
+
+void FRshipFieldReplayer::BuildAtlas(FRshipFieldCpuAtlas& OutAtlas)
+{
+    RshipFieldRDG::FGlobalDispatchInputs Inputs;
+    BuildGlobalInputs(Inputs);
+    FRshipFieldCpuEvaluator(Inputs).BuildAtlas(OutAtlas);
+}
+
+void FRshipFieldReplayer::ApplyKeyframe(int32 Keyframe)
+{
+    if (!Recording.Keyframes.IsValidIndex(Keyframe))
+    {
+        return;
+    }
+
+    TArray<TArray<TArray<uint8>>> Values;
+    FMemoryReader Reader(Recording.Keyframes[Keyframe]);
+    Reader << Values;
+
+    for (int32 PropertyIndex = 0; PropertyIndex < FMath::Min(Values.Num(), Properties.Num()); ++PropertyIndex)
+    {
+        const FRshipFieldRecordedProperty* Property = Properties[PropertyIndex].Get();
+        if (!Property)
+        {
+            continue;
+        }
+        Property->SetNum(*Field, Values[PropertyIndex].Num());
+        for (int32 Element = 0; Element < Property->Num(*Field); ++Element)
+        {
+            Property->Load(Property->GetValue(*Field, Element), Values[PropertyIndex][Element]);
+        }
+    }
+
+    SerializeSimulationState(Reader, *Field);
+    Field->SplinePolylines.Reset();
+    CurrentStep = Keyframe * Recording.KeyframeInterval;
+}
+
+void FRshipFieldReplayer::ApplyEvents(TConstArrayView<uint8> Events)
+{
+    FMemoryReaderView Reader(MakeMemoryView(Events));
+    while (!Reader.AtEnd() && !Reader.IsError())
+    {
+        EEvent Event;
+        Reader << Event;
+        if (Event == EEvent::EmitWavefront)
+        {
+            int32 WaveEffectorIndex = INDEX_NONE;
+            Reader << WaveEffectorIndex;
+            Field->EmitWavefront(WaveEffectorIndex);
+            continue;
+        }
+
+        int32 PropertyIndex = INDEX_NONE;
+        Reader << PropertyIndex;
+        const FRshipFieldRecordedProperty* Property = Properties.IsValidIndex(PropertyIndex) ? Properties[PropertyIndex].Get() : nullptr;
+        if (Event == EEvent::Num)
+        {
+            int32 Num = 0;
+            Reader << Num;
+            if (Property)
+            {
+                Property->SetNum(*Field, Num);
+            }
+        }
+        else
+        {
+            int32 Element = 0;
+            TArray<uint8> Value;
+            Reader << Element;
+            Reader << Value;
+            if (Property && Element >= 0 && Element < Property->Num(*Field))
+            {
+                Property->Load(Property->GetValue(*Field, Element), Value);
+            }
+        }
+    }
+}
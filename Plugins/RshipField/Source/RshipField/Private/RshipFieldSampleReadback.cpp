@@ -0,0 +1,135 @@
+#include "RshipFieldSampleReadback.h"
+
+FRshipFieldSampleSlots::FRshipFieldSampleSlots(int32 InMinCapacity)
+    : Capacity(static_cast<int32>(FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max(InMinCapacity, 1)))))
+{
+}
+
+void FRshipFieldSampleSlots::BeginFrame()
+{
+    ++Frame;
+}
+
+int32 FRshipFieldSampleSlots::Acquire(FObjectKey Sampler)
+{
+    int32 Slot = INDEX_NONE;
+    if (const int32* Existing = SlotByOwner.Find(Sampler))
+    {
+        Slot = *Existing;
+    }
+    else
+    {
+        if (FreeSlots.Num() > 0)
+        {
+            Slot = FreeSlots.Pop(EAllowShrinking::No);
+        }
+        else
+        {
+            Slot = Slots.AddDefaulted();
+            while (Capacity < Slots.Num())
+            {
+                Capacity *= 2;
+            }
+        }
+
+        // A readback submitted while the slot was free sampled the previous owner's stale position
+        FSlot& NewSlot = Slots[Slot];
+        NewSlot.Owner = Sampler;
+        NewSlot.bUsed = true;
+        ++NewSlot.Generation;
+        SlotByOwner.Add(Sampler, Slot);
+    }
+
+    Slots[Slot].LastFrame = Frame;
+    return Slot;
+}
+
+int32 FRshipFieldSampleSlots::EndFrame()
+{
+    int32 NumReleased = 0;
+    for (int32 Slot = 0; Slot < Slots.Num(); ++Slot)
+    {
+        if (Slots[Slot].bUsed && Slots[Slot].LastFrame != Frame)
+        {
+            ReleaseSlot(Slot);
+            ++NumReleased;
+        }
+    }
+    return NumReleased;
+}
+
+bool FRshipFieldSampleSlots::Release(FObjectKey Sampler)
+{
+    const int32 Slot = Find(Sampler);
+    if (Slot == INDEX_NONE)
+    {
+        return false;
+    }
+    ReleaseSlot(Slot);
+    return true;
+}
+
+int32 FRshipFieldSampleSlots::Find(FObjectKey Sampler) const
+{
+    const int32* Slot = SlotByOwner.Find(Sampler);
+    return Slot ? *Slot : INDEX_NONE;
+}
+
+void FRshipFieldSampleSlots::ReleaseSlot(int32 Slot)
+{
+    FSlot& Released = Slots[Slot];
+    SlotByOwner.Remove(Released.Owner);
+    Released.Owner = FObjectKey();
+    Released.bUsed = false;
+    ++Released.Generation;
+    FreeSlots.Add(Slot);
+}
+
+FRshipFieldReadbackRing::FRshipFieldReadbackRing(int32 InDepth)
+{
+    Entries.SetNum(FMath::Max(InDepth, 1));
+}
+
+int32 FRshipFieldReadbackRing::Submit(uint64 Frame, const FRshipFieldSampleSlots& Slots)
+{
+    if (NumInFlight == Entries.Num())
+    {
+        ++NumDropped;
+        return INDEX_NONE;
+    }
+
+    const int32 Index = (OldestIndex + NumInFlight) % Entries.Num();
+    FEntry& Entry = Entries[Index];
+    Entry.SubmitFrame = Frame;
+    Entry.Generations.SetNumUninitialized(Slots.GetNumSlots(), EAllowShrinking::No);
+    for (int32 Slot = 0; Slot < Slots.GetNumSlots(); ++Slot)
+    {
+        Entry.Generations[Slot] = Slots.GetGeneration(Slot);
+    }
+
+    ++NumInFlight;
+    return Index;
+}
+
+int32 FRshipFieldReadbackRing::GetOldest() const
+{
+    return NumInFlight > 0 ? OldestIndex : INDEX_NONE;
+}
+
+bool FRshipFieldReadbackRing::IsSlotCurrent(int32 Index, int32 Slot, const FRshipFieldSampleSlots& Slots) const
+{
+    const FEntry& Entry = Entries[Index];
+    return Entry.Generations.IsValidIndex(Slot)
+        && Slots.IsUsed(Slot)
+        && Slots.GetGeneration(Slot) == Entry.Generations[Slot];
+}
+
+int32 FRshipFieldReadbackRing::Complete(int32 Index, uint64 Frame)
+{
+    check(NumInFlight > 0 && Index == OldestIndex);
+
+    LastLatency = static_cast<int32>(Frame - Entries[Index].SubmitFrame);
+    OldestIndex = (OldestIndex + 1) % Entries.Num();
+    --NumInFlight;
+    return LastLatency;
+}
@@ -3,6 +3,7 @@
 #include "GlobalShader.h"
 #include "RenderGraphBuilder.h"
 #include "RenderGraphUtils.h"
+#include "RHIGPUReadback.h"
 #include "ShaderParameterStruct.h"
 
 namespace
@@ -13,6 +14,11 @@ constexpr uint32 FieldGroupSizeZ = 4;
 constexpr uint32 TargetGroupSizeX = 8;
 constexpr uint32 TargetGroupSizeY = 8;
 
+static_assert(FRshipFieldEffectorTiles::TileSize % FieldGroupSizeX == 0
+    && FRshipFieldEffectorTiles::TileSize % FieldGroupSizeY == 0
+    && FRshipFieldEffectorTiles::TileSize % FieldGroupSizeZ == 0,
+    "A field thread group must not straddle two effector tiles");
+
 class FRshipFieldBuildGlobalCS : public FGlobalShader
 {
     DECLARE_GLOBAL_SHADER(FRshipFieldBuildGlobalCS);
@@ -47,6 +53,15 @@ public:
         SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, EffectorData6)
         SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, EffectorData7)
         SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, WavefrontData)
+        SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, SplineNodeData)
+        SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, SplineSegmentData)
+        SHADER_PARAMETER(int32, EffectorTilesPerAxis)
+        SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<uint>, TileEffectorOffsets)
+        SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<uint>, TileEffectorIndices)
+        SHADER_PARAMETER(uint32, DirtyTileCount)
+        SHADER_PARAMETER(uint32, DirtyTileRowLength)
+        SHADER_PARAMETER(int32, DirtyTilesPerAxis)
+        SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<uint>, DirtyTileIndices)
 
         SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float>, OutScalarFieldAtlasTex)
         SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, OutVectorFieldAtlasTex)
@@ -63,6 +78,7 @@ public:
         OutEnvironment.SetDefine(TEXT("FIELD_GROUP_SIZE_X"), FieldGroupSizeX);
         OutEnvironment.SetDefine(TEXT("FIELD_GROUP_SIZE_Y"), FieldGroupSizeY);
         OutEnvironment.SetDefine(TEXT("FIELD_GROUP_SIZE_Z"), FieldGroupSizeZ);
+        OutEnvironment.SetDefine(TEXT("EFFECTOR_TILE_SIZE"), FRshipFieldEffectorTiles::TileSize);
     }
 };
 
@@ -100,6 +116,11 @@ public:
         SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, EffectorData6)
         SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, EffectorData7)
         SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, WavefrontData)
+        SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, SplineNodeData)
+        SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, SplineSegmentData)
+        SHADER_PARAMETER(int32, EffectorTilesPerAxis)
+        SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<uint>, TileEffectorOffsets)
+        SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<uint>, TileEffectorIndices)
 
         SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float>, OutScalarFieldAtlasTex)
         SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, OutVectorFieldAtlasTex)
@@ -228,7 +249,7 @@ public:
         SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float>, ScalarFieldAtlasTex)
         SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float4>, VectorFieldAtlasTex)
         SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, SamplePositions)
-        SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, OutSampleResults)
+        SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<float4>, OutSampleResults)
     END_SHADER_PARAMETER_STRUCT()
 
     static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
@@ -245,6 +266,93 @@ IMPLEMENT_GLOBAL_SHADER(FRshipFieldRecomputeNormalsCS, "/Plugin/RshipField/Priva
 IMPLEMENT_GLOBAL_SHADER(FRshipFieldDebugViewCS, "/Plugin/RshipField/Private/RshipFieldCS.usf", "DebugViewCS", SF_Compute);
 IMPLEMENT_GLOBAL_SHADER(FRshipFieldSampleAtPointsCS, "/Plugin/RshipField/Private/RshipFieldCS.usf", "SampleFieldAtPointsCS", SF_Compute);
 
+void RshipFieldRDG::PackEffectorInputs(
+    FGlobalDispatchInputs& GlobalInputs,
+    const TArray<FRshipFieldSyncGroup>& SyncGroups,
+    const TArray<FRshipFieldEffectorDesc>& Effectors,
+    TConstArrayView<double> SyncGroupBeats)
+{
+    // Build phase groups
+    TMap<FString, int32> SyncGroupIndexById;
+    GlobalInputs.SyncGroupData.Reset();
+    GlobalInputs.SyncGroupData.Add(FVector4f(0.0f, 1.0f, 0.0f, 0.0f));
+    SyncGroupIndexById.Add(TEXT(""), 0);
+
+    for (int32 GroupIndex = 0; GroupIndex < SyncGroups.Num(); ++GroupIndex)
+    {
+        const FRshipFieldSyncGroup& Group = SyncGroups[GroupIndex];
+        if (Group.Id.IsEmpty())
+        {
+            continue;
+        }
+        SyncGroupIndexById.Add(Group.Id, GlobalInputs.SyncGroupData.Num());
+        if (SyncGroupBeats.IsValidIndex(GroupIndex))
+        {
+            // Only the fraction of a cycle reaches the GPU, so the phase is as precise after
+            // hours as at the start; a zero multiplier leaves just the offset
+            const double Cycles = SyncGroupBeats[GroupIndex] * FMath::Max(Group.TempoMultiplier, 0.0f);
+            GlobalInputs.SyncGroupData.Add(FVector4f(
+                1.0f,
+                0.0f,
+                Group.PhaseOffset + UE_TWO_PI * static_cast<float>(FMath::Frac(Cycles)),
+                0.0f));
+            continue;
+        }
+        GlobalInputs.SyncGroupData.Add(FVector4f(
+            1.0f,
+            Group.TempoMultiplier,
+            Group.PhaseOffset,
+            0.0f));
+    }
+
+    // Single default layer
+    GlobalInputs.LayerDataA.Reset();
+    GlobalInputs.LayerDataB.Reset();
+    GlobalInputs.LayerDataA.Add(FVector4f(1.0f, -100.0f, 100.0f, 0.0f));
+    GlobalInputs.LayerDataB.Add(FVector4f(1.0f, -1.0f, 0.0f, 0.0f));
+
+    TArray<FVector4f>* EffectorBuffers[] = {
+        &GlobalInputs.EffectorData0, &GlobalInputs.EffectorData1, &GlobalInputs.EffectorData2, &GlobalInputs.EffectorData3,
+        &GlobalInputs.EffectorData4, &GlobalInputs.EffectorData5, &GlobalInputs.EffectorData6, &GlobalInputs.EffectorData7
+    };
+    for (TArray<FVector4f>* Buffer : EffectorBuffers)
+    {
+        Buffer->Reset(Effectors.Num());
+    }
+
+    for (const FRshipFieldEffectorDesc& Eff : Effectors)
+    {
+        const int32* SyncGroupIndexPtr = SyncGroupIndexById.Find(Eff.SyncGroup);
+        const int32 SyncGroupIndex = SyncGroupIndexPtr ? *SyncGroupIndexPtr : 0;
+
+        GlobalInputs.EffectorData0.Add(FVector4f(FVector3f(Eff.PositionCm), Eff.RadiusCm));
+        GlobalInputs.EffectorData1.Add(FVector4f(FVector3f(Eff.Polarization), Eff.Amplitude));
+        GlobalInputs.EffectorData2.Add(FVector4f(Eff.WavelengthCm, Eff.FrequencyHz, Eff.EnvelopeWidthCm, Eff.PhaseOffset));
+        GlobalInputs.EffectorData3.Add(FVector4f(Eff.FadeWeight, Eff.FalloffExponent, static_cast<float>(static_cast<uint8>(Eff.Type)), static_cast<float>(static_cast<uint8>(Eff.WaveMode))));
+        GlobalInputs.EffectorData4.Add(FVector4f(Eff.ClampMin, Eff.ClampMax, static_cast<float>(static_cast<uint8>(Eff.BlendOp)), static_cast<float>(static_cast<uint8>(Eff.Waveform))));
+        // Noise type 0 means no noise in the kernel, so modes are packed one up
+        const float NoiseType = static_cast<float>(static_cast<uint8>(Eff.NoiseMode) + 1);
+        GlobalInputs.EffectorData5.Add(FVector4f(static_cast<float>(SyncGroupIndex), NoiseType, Eff.NoiseScale, Eff.NoiseAmplitude));
+        GlobalInputs.EffectorData6.Add(FVector4f(Eff.bEnabled ? 1.0f : 0.0f, Eff.bInfiniteRange ? 1.0f : 0.0f, Eff.bAffectsScalar ? 1.0f : 0.0f, Eff.bAffectsVector ? 1.0f : 0.0f));
+        switch (Eff.Type)
+        {
+        case ERshipFieldEffectorType::Spline:
+            GlobalInputs.EffectorData7.Add(FVector4f(static_cast<float>(Eff.SplineNodeOffset), static_cast<float>(Eff.SplineSegmentOffset), 0.0f, 0.0f));
+            break;
+        case ERshipFieldEffectorType::Ring:
+            GlobalInputs.EffectorData7.Add(FVector4f(static_cast<float>(Eff.LobeCount), Eff.RingRadiusCm, 0.0f, 0.0f));
+            break;
+        default:
+            GlobalInputs.EffectorData7.Add(FVector4f(static_cast<float>(Eff.WavefrontOffset), static_cast<float>(Eff.WavefrontCount), Eff.WaveSpeedCmPerSec, 0.0f));
+            break;
+        }
+    }
+
+    GlobalInputs.LayerCount = GlobalInputs.LayerDataA.Num();
+    GlobalInputs.SyncGroupCount = GlobalInputs.SyncGroupData.Num();
+    GlobalInputs.EffectorCount = Effectors.Num();
+}
+
 void RshipFieldRDG::AddFieldPasses(
     FRDGBuilder& GraphBuilder,
     const FGlobalDispatchInputs& GlobalInputs,
@@ -275,6 +383,16 @@ void RshipFieldRDG::AddFieldPasses(
         return GraphBuilder.CreateSRV(Buffer);
     };
 
+    auto MakeIndexBufferSRV = [&GraphBuilder](const TCHAR* Name, const TArray<uint32>& Source) -> FRDGBufferSRVRef
+    {
+        static const uint32 Empty = 0;
+        FRDGBufferRef Buffer = CreateStructuredBuffer(
+            GraphBuilder,
+            Name,
+            Source.Num() > 0 ? TConstArrayView<uint32>(Source) : TConstArrayView<uint32>(&Empty, 1));
+        return GraphBuilder.CreateSRV(Buffer);
+    };
+
     FRDGBufferSRVRef LayerDataASRV = MakePackedBufferSRV(TEXT("RshipField.LayerDataA"), GlobalInputs.LayerDataA);
     FRDGBufferSRVRef LayerDataBSRV = MakePackedBufferSRV(TEXT("RshipField.LayerDataB"), GlobalInputs.LayerDataB);
     FRDGBufferSRVRef SyncGroupDataSRV = MakePackedBufferSRV(TEXT("RshipField.SyncGroupData"), GlobalInputs.SyncGroupData);
@@ -288,12 +406,31 @@ void RshipFieldRDG::AddFieldPasses(
     FRDGBufferSRVRef EffectorData6SRV = MakePackedBufferSRV(TEXT("RshipField.EffectorData6"), GlobalInputs.EffectorData6);
     FRDGBufferSRVRef EffectorData7SRV = MakePackedBufferSRV(TEXT("RshipField.EffectorData7"), GlobalInputs.EffectorData7);
     FRDGBufferSRVRef WavefrontDataSRV = MakePackedBufferSRV(TEXT("RshipField.WavefrontData"), GlobalInputs.WavefrontData);
+    FRDGBufferSRVRef SplineNodeDataSRV = MakePackedBufferSRV(TEXT("RshipField.SplineNodeData"), GlobalInputs.SplineNodeData);
+    FRDGBufferSRVRef SplineSegmentDataSRV = MakePackedBufferSRV(TEXT("RshipField.SplineSegmentData"), GlobalInputs.SplineSegmentData);
+
+    const bool bEffectorTiles = GlobalInputs.EffectorTiles.IsBuiltFor(GlobalInputs.FieldResolution);
+    FRDGBufferSRVRef TileEffectorOffsetsSRV = MakeIndexBufferSRV(TEXT("RshipField.TileEffectorOffsets"), GlobalInputs.EffectorTiles.GetOffsets());
+    FRDGBufferSRVRef TileEffectorIndicesSRV = MakeIndexBufferSRV(TEXT("RshipField.TileEffectorIndices"), GlobalInputs.EffectorTiles.GetIndices());
 
     const FIntVector FieldVoxelCount(GlobalInputs.FieldResolution, GlobalInputs.FieldResolution, GlobalInputs.FieldResolution);
-    const FIntVector FieldGroupCount = FComputeShaderUtils::GetGroupCount(
+    FIntVector FieldGroupCount = FComputeShaderUtils::GetGroupCount(
         FieldVoxelCount,
         FIntVector(FieldGroupSizeX, FieldGroupSizeY, FieldGroupSizeZ));
 
+    // Incremental: group X walks the blocks of one tile, Y and Z walk the dirty list in rows
+    // short enough for the dispatch limit
+    const int32 DirtyTileCount = GlobalInputs.bDirtyTilesOnly ? GlobalInputs.DirtyTiles.Num() : 0;
+    const int32 DirtyTileRowLength = FMath::Clamp(DirtyTileCount, 1, static_cast<int32>(GRHIMaxDispatchThreadGroupsPerDimension.Y));
+    if (DirtyTileCount > 0)
+    {
+        constexpr int32 GroupsPerTile = (FRshipFieldEffectorTiles::TileSize / FieldGroupSizeX)
+            * (FRshipFieldEffectorTiles::TileSize / FieldGroupSizeY)
+            * (FRshipFieldEffectorTiles::TileSize / FieldGroupSizeZ);
+        FieldGroupCount = FIntVector(GroupsPerTile, DirtyTileRowLength, FMath::DivideAndRoundUp(DirtyTileCount, DirtyTileRowLength));
+    }
+
+    if (!GlobalInputs.bDirtyTilesOnly || DirtyTileCount > 0)
     {
         TShaderMapRef<FRshipFieldBuildGlobalCS> ComputeShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
         FRshipFieldBuildGlobalCS::FParameters* PassParameters = GraphBuilder.AllocParameters<FRshipFieldBuildGlobalCS::FParameters>();
@@ -323,6 +460,15 @@ void RshipFieldRDG::AddFieldPasses(
         PassParameters->EffectorData6 = EffectorData6SRV;
         PassParameters->EffectorData7 = EffectorData7SRV;
         PassParameters->WavefrontData = WavefrontDataSRV;
+        PassParameters->SplineNodeData = SplineNodeDataSRV;
+        PassParameters->SplineSegmentData = SplineSegmentDataSRV;
+        PassParameters->EffectorTilesPerAxis = bEffectorTiles ? GlobalInputs.EffectorTiles.GetTilesPerAxis() : 0;
+        PassParameters->TileEffectorOffsets = TileEffectorOffsetsSRV;
+        PassParameters->TileEffectorIndices = TileEffectorIndicesSRV;
+        PassParameters->DirtyTileCount = DirtyTileCount;
+        PassParameters->DirtyTileRowLength = DirtyTileRowLength;
+        PassParameters->DirtyTilesPerAxis = FMath::DivideAndRoundUp(GlobalInputs.FieldResolution, FRshipFieldEffectorTiles::TileSize);
+        PassParameters->DirtyTileIndices = MakeIndexBufferSRV(TEXT("RshipField.DirtyTiles"), GlobalInputs.DirtyTiles);
         PassParameters->OutScalarFieldAtlasTex = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(ScalarAtlasTex));
         PassParameters->OutVectorFieldAtlasTex = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(VectorAtlasTex));
 
@@ -415,9 +561,10 @@ void RshipFieldRDG::AddFieldPasses(
 
 void RshipFieldRDG::AddPointSamplePass(
     FRDGBuilder& GraphBuilder,
-    const FPointSampleInputs& Inputs)
+    const FPointSampleInputs& Inputs,
+    FRDGBufferRef OutResults)
 {
-    if (Inputs.NumSamples == 0 || !Inputs.ScalarAtlasTexture.IsValid() || !Inputs.VectorAtlasTexture.IsValid() || !Inputs.OutResultsTexture.IsValid())
+    if (!Inputs.IsValid() || !OutResults)
     {
         return;
     }
@@ -426,19 +573,11 @@ void RshipFieldRDG::AddPointSamplePass(
         CreateRenderTarget(Inputs.ScalarAtlasTexture, TEXT("RshipField.ScalarAtlas.PointSample")));
     FRDGTextureRef VectorAtlasTex = GraphBuilder.RegisterExternalTexture(
         CreateRenderTarget(Inputs.VectorAtlasTexture, TEXT("RshipField.VectorAtlas.PointSample")));
-    FRDGTextureRef ResultsTex = GraphBuilder.RegisterExternalTexture(
-        CreateRenderTarget(Inputs.OutResultsTexture, TEXT("RshipField.PointSampleResults")));
-
-    TArray<FVector4f> SafePositions = Inputs.Positions;
-    if (SafePositions.Num() == 0)
-    {
-        SafePositions.Add(FVector4f::Zero());
-    }
 
     FRDGBufferRef PositionBuffer = CreateStructuredBuffer(
         GraphBuilder,
         TEXT("RshipField.SamplePositions"),
-        TConstArrayView<FVector4f>(SafePositions));
+        TConstArrayView<FVector4f>(Inputs.Positions));
     FRDGBufferSRVRef PositionSRV = GraphBuilder.CreateSRV(PositionBuffer);
 
     TShaderMapRef<FRshipFieldSampleAtPointsCS> ComputeShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
@@ -451,7 +590,7 @@ void RshipFieldRDG::AddPointSamplePass(
     PassParameters->ScalarFieldAtlasTex = ScalarAtlasTex;
     PassParameters->VectorFieldAtlasTex = VectorAtlasTex;
     PassParameters->SamplePositions = PositionSRV;
-    PassParameters->OutSampleResults = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(ResultsTex));
+    PassParameters->OutSampleResults = GraphBuilder.CreateUAV(OutResults);
 
     const FIntVector GroupCount = FComputeShaderUtils::GetGroupCount(FIntVector(Inputs.NumSamples, 1, 1), FIntVector(64, 1, 1));
 
@@ -463,3 +602,80 @@ void RshipFieldRDG::AddPointSamplePass(
         PassParameters,
         GroupCount);
 }
+
+RshipFieldRDG::FPointSampleReadbackQueue::FPointSampleReadbackQueue(int32 NumReadbacks)
+{
+    for (int32 Index = 0; Index < NumReadbacks; ++Index)
+    {
+        Readbacks.Add(MakeUnique<FRHIGPUBufferReadback>(*FString::Printf(TEXT("RshipField.PointSampleReadback%d"), Index)));
+    }
+}
+
+RshipFieldRDG::FPointSampleReadbackQueue::~FPointSampleReadbackQueue() = default;
+
+void RshipFieldRDG::FPointSampleReadbackQueue::Submit(FRDGBuilder& GraphBuilder, const FPointSampleInputs& Inputs, int32 Capacity, int32 Index)
+{
+    check(IsInRenderingThread());
+    check(Readbacks.IsValidIndex(Index));
+
+    if (!Inputs.IsValid())
+    {
+        // Retire the entry anyway so the game thread's ring keeps moving
+        FCompleted Skipped;
+        Skipped.Index = Index;
+        AddCompleted(MoveTemp(Skipped));
+        return;
+    }
+
+    FRDGBufferRef Results = nullptr;
+    if (!ResultsBuffer.IsValid() || ResultsCapacity < Capacity)
+    {
+        Results = GraphBuilder.CreateBuffer(FRDGBufferDesc::CreateStructuredDesc(sizeof(FVector4f), Capacity), TEXT("RshipField.PointSampleResults"));
+        ResultsBuffer = GraphBuilder.ConvertToExternalBuffer(Results);
+        ResultsCapacity = Capacity;
+    }
+    else
+    {
+        Results = GraphBuilder.RegisterExternalBuffer(ResultsBuffer);
+    }
+
+    AddPointSamplePass(GraphBuilder, Inputs, Results);
+    AddEnqueueCopyPass(GraphBuilder, Readbacks[Index].Get(), Results, Inputs.NumSamples * sizeof(FVector4f));
+    Pending.Add({ Index, static_cast<int32>(Inputs.NumSamples) });
+}
+
+void RshipFieldRDG::FPointSampleReadbackQueue::Poll()
+{
+    check(IsInRenderingThread());
+
+    // Readbacks finish in submission order; stop at the first one still in flight
+    while (Pending.Num() > 0 && Readbacks[Pending[0].Index]->IsReady())
+    {
+        const FPending Ready = Pending[0];
+        Pending.RemoveAt(0, EAllowShrinking::No);
+
+        FCompleted Done;
+        Done.Index = Ready.Index;
+        Done.Results.SetNumUninitialized(Ready.NumSamples);
+
+        const uint32 NumBytes = Ready.NumSamples * sizeof(FVector4f);
+        FRHIGPUBufferReadback& Readback = *Readbacks[Ready.Index];
+        FMemory::Memcpy(Done.Results.GetData(), Readback.Lock(NumBytes), NumBytes);
+        Readback.Unlock();
+
+        AddCompleted(MoveTemp(Done));
+    }
+}
+
+void RshipFieldRDG::FPointSampleReadbackQueue::TakeCompleted(TArray<FCompleted>& OutCompleted)
+{
+    FScopeLock Lock(&CompletedLock);
+    OutCompleted = MoveTemp(Completed);
+    Completed.Reset();
+}
+
+void RshipFieldRDG::FPointSampleReadbackQueue::AddCompleted(FCompleted&& Done)
+{
+    FScopeLock Lock(&CompletedLock);
+    Completed.Add(MoveTemp(Done));
+}
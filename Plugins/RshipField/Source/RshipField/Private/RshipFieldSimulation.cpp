@@ -0,0 +1,290 @@
+#include "RshipFieldSimulation.h"
+
+#include "RshipFieldComponent.h"
+#include "RshipFieldShaders.h"
+
+#include "Components/SplineComponent.h"
+#include "GameFramework/Actor.h"
+
+namespace
+{
+// Everything a spline effector's polyline is built from; the polyline is only resampled when this changes.
+uint32 HashSplineSource(const FRshipFieldSplineEffector& Effector, const USplineComponent* Spline)
+{
+    uint32 Hash = HashCombineFast(GetTypeHash(Effector.ToleranceCm), GetTypeHash(Spline != nullptr));
+    if (Spline)
+    {
+        Hash = HashCombineFast(Hash, GetTypeHash(Spline->IsClosedLoop()));
+        for (int32 Point = 0; Point < Spline->GetNumberOfSplinePoints(); ++Point)
+        {
+            Hash = HashCombineFast(Hash, GetTypeHash(Spline->GetLocationAtSplinePoint(Point, ESplineCoordinateSpace::World)));
+            Hash = HashCombineFast(Hash, GetTypeHash(Spline->GetArriveTangentAtSplinePoint(Point, ESplineCoordinateSpace::World)));
+            Hash = HashCombineFast(Hash, GetTypeHash(Spline->GetLeaveTangentAtSplinePoint(Point, ESplineCoordinateSpace::World)));
+        }
+        return Hash;
+    }
+
+    Hash = HashCombineFast(Hash, GetTypeHash(Effector.bClosedLoop));
+    for (const FVector& Point : Effector.PointsCm)
+    {
+        Hash = HashCombineFast(Hash, GetTypeHash(Point));
+    }
+    return Hash;
+}
+
+void UpdateSplinePolyline(const FRshipFieldSplineEffector& Effector, FRshipFieldPolyline& Polyline)
+{
+    const AActor* SplineActor = Effector.SplineActor.Get();
+    const USplineComponent* Spline = SplineActor ? SplineActor->FindComponentByClass<USplineComponent>() : nullptr;
+
+    const uint32 SourceHash = HashSplineSource(Effector, Spline);
+    if (SourceHash != 0 && SourceHash == Polyline.SourceHash)
+    {
+        return;
+    }
+
+    if (Spline)
+    {
+        Polyline.BuildFromSpline(*Spline, Effector.ToleranceCm);
+    }
+    else
+    {
+        TArray<FVector3f> PointsCm;
+        PointsCm.Reserve(Effector.PointsCm.Num());
+        for (const FVector& Point : Effector.PointsCm)
+        {
+            PointsCm.Add(FVector3f(Point));
+        }
+        Polyline.Build(PointsCm, Effector.bClosedLoop);
+    }
+    Polyline.SourceHash = SourceHash;
+}
+
+// Runs Clock for one step and writes its position back to BeatPhase. A BeatPhase or SyncCount
+// written since the last step is a locate and re-anchors the clock first.
+void StepTransport(FRshipFieldTransportClock& Clock, float StepSeconds, float Bpm, bool bPlaying,
+    float MaxFreewheelSeconds, int32 SyncCount, float& BeatPhase)
+{
+    if (Clock.WasMoved(BeatPhase, SyncCount))
+    {
+        Clock.Locate(BeatPhase);
+    }
+    Clock.Configure(StepSeconds, Bpm, bPlaying, MaxFreewheelSeconds);
+    Clock.Advance();
+    BeatPhase = Clock.Publish(SyncCount);
+}
+} // namespace
+
+float RshipFieldSimulation::GetStepSeconds(const URshipFieldComponent& Field)
+{
+    return 1.0f / FMath::Max(Field.UpdateHz, 1.0f);
+}
+
+void RshipFieldSimulation::Step(URshipFieldComponent& Field)
+{
+    const float StepSeconds = GetStepSeconds(Field);
+    ++Field.SimulationFrame;
+    Field.SimulationTimeSeconds += StepSeconds;
+    StepTransport(Field.TransportClock, StepSeconds, Field.Bpm, Field.bPlaying, -1.0f, 0, Field.BeatPhase);
+
+    TSet<FString> TransportIds;
+    for (FRshipFieldTransport& Transport : Field.Transports)
+    {
+        bool bDuplicate = false;
+        TransportIds.Add(Transport.Id, &bDuplicate);
+        if (Transport.Id.IsEmpty() || bDuplicate)
+        {
+            continue;
+        }
+        const bool bExternal = Transport.ClockSource == ERshipFieldClockSource::External;
+        StepTransport(Field.TransportClocks.FindOrAdd(Transport.Id), StepSeconds, Transport.Bpm, Transport.bPlaying,
+            bExternal ? FMath::Max(Transport.ExternalTimeoutSeconds, 0.0f) : -1.0f, Transport.SyncCount, Transport.BeatPhase);
+    }
+    for (auto It = Field.TransportClocks.CreateIterator(); It; ++It)
+    {
+        if (!TransportIds.Contains(It.Key()))
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    // Ensure wavefront state array matches wave effectors
+    if (Field.WaveEffectorStates.Num() != Field.WaveEffectors.Num())
+    {
+        Field.WaveEffectorStates.SetNum(Field.WaveEffectors.Num());
+    }
+
+    for (int32 i = 0; i < Field.WaveEffectors.Num(); ++i)
+    {
+        FRshipFieldWaveEffector& Wave = Field.WaveEffectors[i];
+        FRshipFieldWaveEffectorState& State = Field.WaveEffectorStates[i];
+
+        // Keep dispersion values in sync so switching Derive doesn't jump.
+        Wave.SyncDispersion();
+
+        if (Wave.WaveMode == ERshipFieldWaveMode::Traveling && Wave.bEnabled)
+        {
+            // Manual emit-once trigger
+            if (Wave.bEmitOnce)
+            {
+                Field.EmitWavefront(i);
+                Wave.bEmitOnce = false;
+            }
+
+            // Auto-emit
+            if (Wave.bAutoEmit)
+            {
+                const float EmitInterval = 1.0f / FMath::Max(Wave.RepeatHz, 0.01f);
+                if ((Field.SimulationTimeSeconds - State.LastEmitTime) >= EmitInterval)
+                {
+                    State.Wavefronts.Emit(Field.SimulationTimeSeconds, Wave.PositionCm, Wave.MaxWavefronts);
+                    State.LastEmitTime = Field.SimulationTimeSeconds;
+                }
+            }
+
+            // Cull wavefronts that have traveled beyond the effector radius
+            State.Wavefronts.Expire(Field.SimulationTimeSeconds, Wave.GetMaxWavefrontAge());
+        }
+    }
+}
+
+double RshipFieldSimulation::GetTransportBeat(const URshipFieldComponent& Field, const FString& TransportId)
+{
+    if (!TransportId.IsEmpty())
+    {
+        const FRshipFieldTransport* Transport = Field.Transports.FindByPredicate(
+            [&TransportId](const FRshipFieldTransport& Candidate) { return Candidate.Id == TransportId; });
+        const FRshipFieldTransportClock* Clock = Field.TransportClocks.Find(TransportId);
+        if (Transport && Clock)
+        {
+            return Clock->WasMoved(Transport->BeatPhase, Transport->SyncCount) ? Transport->BeatPhase : Clock->GetBeat();
+        }
+        if (Transport)
+        {
+            return Transport->BeatPhase;
+        }
+    }
+    return Field.TransportClock.WasMoved(Field.BeatPhase) ? Field.BeatPhase : Field.TransportClock.GetBeat();
+}
+
+void RshipFieldSimulation::UpdateSplinePaths(URshipFieldComponent& Field)
+{
+    if (Field.SplinePolylines.Num() != Field.SplineEffectors.Num())
+    {
+        Field.SplinePolylines.SetNum(Field.SplineEffectors.Num());
+    }
+    for (int32 i = 0; i < Field.SplineEffectors.Num(); ++i)
+    {
+        UpdateSplinePolyline(Field.SplineEffectors[i], Field.SplinePolylines[i]);
+    }
+}
+
+void RshipFieldSimulation::BuildGlobalInputs(URshipFieldComponent& Field, RshipFieldRDG::FGlobalDispatchInputs& OutInputs,
+    TArray<FRshipFieldEffectorDesc>* OutEffectors)
+{
+    const int32 Resolution = GetFieldResolutionValue(Field.FieldResolution);
+    const int32 TilesPerRow = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Resolution))));
+
+    const FVector DomainHalfExtent = FVector(Field.DomainSizeCm * 0.5f);
+    const FVector DomainMin = Field.DomainCenterCm - DomainHalfExtent;
+    const FVector DomainMax = Field.DomainCenterCm + DomainHalfExtent;
+
+    OutInputs.FieldResolution = Resolution;
+    OutInputs.TilesPerRow = TilesPerRow;
+    OutInputs.TimeSeconds = Field.SimulationTimeSeconds;
+    OutInputs.BPM = Field.Bpm;
+    OutInputs.TransportPhase = Field.BeatPhase;
+    OutInputs.MasterScalarGain = Field.MasterScalarGain;
+    OutInputs.MasterVectorGain = Field.MasterVectorGain;
+    OutInputs.DomainMinCm = FVector4f(FVector3f(DomainMin), 0.0f);
+    OutInputs.DomainMaxCm = FVector4f(FVector3f(DomainMax), 0.0f);
+    OutInputs.DebugMode = 0;
+    OutInputs.DebugSelectionIndex = INDEX_NONE;
+
+    // Flatten typed effectors into internal format
+    TArray<FRshipFieldEffectorDesc> AllEffectors;
+    AllEffectors.Reserve(Field.WaveEffectors.Num() + Field.NoiseEffectors.Num() + Field.AttractorEffectors.Num()
+        + Field.SplineEffectors.Num() + Field.RingEffectors.Num());
+
+    if (Field.WaveEffectorStates.Num() != Field.WaveEffectors.Num())
+    {
+        Field.WaveEffectorStates.SetNum(Field.WaveEffectors.Num());
+    }
+    for (const FRshipFieldWaveEffector& Wave : Field.WaveEffectors)
+    {
+        AllEffectors.Add(FRshipFieldEffectorDesc::FromWave(Wave));
+    }
+    for (const FRshipFieldNoiseEffector& Noise : Field.NoiseEffectors)
+    {
+        AllEffectors.Add(FRshipFieldEffectorDesc::FromNoise(Noise));
+    }
+    for (const FRshipFieldAttractorEffector& Attractor : Field.AttractorEffectors)
+    {
+        AllEffectors.Add(FRshipFieldEffectorDesc::FromAttractor(Attractor));
+    }
+
+    // Spline paths are packed back to back; each effector addresses its own range by offset
+    UpdateSplinePaths(Field);
+    TArray<FVector4f> SplineNodeData;
+    TArray<FVector4f> SplineSegmentData;
+    for (int32 i = 0; i < Field.SplineEffectors.Num(); ++i)
+    {
+        const FRshipFieldSplineEffector& Spline = Field.SplineEffectors[i];
+        const FRshipFieldPolyline& Polyline = Field.SplinePolylines[i];
+
+        FRshipFieldEffectorDesc Desc = FRshipFieldEffectorDesc::FromSpline(Spline);
+        Desc.SplineNodeOffset = SplineNodeData.Num() / 2;
+        Desc.SplineSegmentOffset = SplineSegmentData.Num() / 2;
+        if (Polyline.GetNumSegments() == 0)
+        {
+            Desc.bEnabled = false;
+        }
+        else if (Polyline.IsClosedLoop())
+        {
+            // Snap to a whole number of wavelengths around the loop so the seam doesn't show
+            const float LengthCm = Polyline.GetLengthCm();
+            Desc.WavelengthCm = LengthCm / FMath::Max(1.0f, FMath::RoundToFloat(LengthCm / Desc.WavelengthCm));
+        }
+        Polyline.Pack(SplineNodeData, SplineSegmentData);
+        AllEffectors.Add(Desc);
+    }
+    OutInputs.SplineNodeData = MoveTemp(SplineNodeData);
+    OutInputs.SplineSegmentData = MoveTemp(SplineSegmentData);
+
+    for (const FRshipFieldRingEffector& Ring : Field.RingEffectors)
+    {
+        AllEffectors.Add(FRshipFieldEffectorDesc::FromRing(Ring));
+    }
+
+    // Build flat wavefront buffer and assign offsets to wave effectors
+    TArray<FVector4f> FlatWavefronts;
+    FlatWavefronts.Reserve(Field.WaveEffectors.Num() * FRshipFieldWavefrontRing::Capacity);
+    for (int32 i = 0; i < Field.WaveEffectors.Num(); ++i)
+    {
+        FRshipFieldEffectorDesc& Eff = AllEffectors[i];
+        const FRshipFieldWaveEffectorState& State = Field.WaveEffectorStates[i];
+
+        Eff.WavefrontOffset = FlatWavefronts.Num();
+        Eff.WavefrontCount = State.Wavefronts.Num();
+        FlatWavefronts.Append(State.Wavefronts.GetUploadView());
+    }
+    OutInputs.WavefrontData = MoveTemp(FlatWavefronts);
+
+    TArray<double> SyncGroupBeats;
+    SyncGroupBeats.Reserve(Field.SyncGroups.Num());
+    for (const FRshipFieldSyncGroup& Group : Field.SyncGroups)
+    {
+        SyncGroupBeats.Add(GetTransportBeat(Field, Group.Transport));
+    }
+
+    RshipFieldRDG::PackEffectorInputs(OutInputs, Field.SyncGroups, AllEffectors, SyncGroupBeats);
+    if (Field.bCullEffectorsByTile)
+    {
+        OutInputs.EffectorTiles.Build(OutInputs);
+    }
+
+    if (OutEffectors)
+    {
+        *OutEffectors = MoveTemp(AllEffectors);
+    }
+}
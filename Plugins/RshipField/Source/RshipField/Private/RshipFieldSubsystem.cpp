@@ -2,7 +2,10 @@
 
 #include "RshipFieldComponent.h"
 #include "RshipFieldLightSampler.h"
+#include "RshipFieldRecording.h"
+#include "RshipFieldSampleReadback.h"
 #include "RshipFieldShaders.h"
+#include "RshipFieldSimulation.h"
 
 #include "Engine/TextureRenderTarget2D.h"
 #include "Engine/World.h"
@@ -13,6 +16,20 @@
 
 DEFINE_LOG_CATEGORY_STATIC(LogRshipField, Log, All);
 
+struct FRshipFieldGpuLightSampling
+{
+    FRshipFieldSampleSlots Slots;
+    FRshipFieldReadbackRing Ring;
+
+    // Indexed by slot; released slots keep their last position and are ignored on readback.
+    TArray<FVector4f> Positions;
+
+    // Shared with render commands. ReleaseGpuLightSampling moves it into one, so the
+    // readbacks are always destroyed on the render thread.
+    TSharedPtr<RshipFieldRDG::FPointSampleReadbackQueue, ESPMode::ThreadSafe> Readbacks =
+        MakeShared<RshipFieldRDG::FPointSampleReadbackQueue, ESPMode::ThreadSafe>(FRshipFieldReadbackRing::DefaultDepth);
+};
+
 void URshipFieldSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
     Super::Initialize(Collection);
@@ -22,7 +39,16 @@ void URshipFieldSubsystem::Deinitialize()
 {
     RegisteredFields.Reset();
     RegisteredLightSamplers.Reset();
-    PointSampleRT = nullptr;
+    TArray<TObjectKey<URshipFieldComponent>> GpuFields;
+    GpuLightSampling.GetKeys(GpuFields);
+    for (const TObjectKey<URshipFieldComponent>& Field : GpuFields)
+    {
+        ReleaseGpuLightSampling(Field);
+    }
+    GpuLightSampling.Reset();
+    CpuEvaluators.Reset();
+    Queries.Reset();
+    DirtyTiles.Reset();
     Super::Deinitialize();
 }
 
@@ -37,6 +63,10 @@ void URshipFieldSubsystem::RegisterField(URshipFieldComponent* Field)
 void URshipFieldSubsystem::UnregisterField(URshipFieldComponent* Field)
 {
     RegisteredFields.Remove(Field);
+    CpuEvaluators.Remove(Field);
+    Queries.Remove(Field);
+    DirtyTiles.Remove(Field);
+    ReleaseGpuLightSampling(Field);
 }
 
 void URshipFieldSubsystem::RegisterLightSampler(URshipFieldLightSampler* Sampler)
@@ -67,18 +97,23 @@ URshipFieldComponent* URshipFieldSubsystem::FindFieldById(const FString& InField
 
 void URshipFieldSubsystem::TickField(URshipFieldComponent* Field, float DeltaTime)
 {
-    const float Step = 1.0f / FMath::Max(Field->UpdateHz, 1.0f);
+    const float Step = RshipFieldSimulation::GetStepSeconds(*Field);
     Field->TickAccumulator += DeltaTime;
 
     bool bDidStep = false;
     while (Field->TickAccumulator + KINDA_SMALL_NUMBER >= Step)
     {
         Field->TickAccumulator -= Step;
-        ++Field->SimulationFrame;
-        Field->SimulationTimeSeconds += Step;
-        if (Field->bPlaying)
+
+        // The recorder sees every change made since the last step, then closes this one
+        if (Field->Recorder.IsValid())
         {
-            Field->BeatPhase += Step * Field->Bpm / 60.0f;
+            Field->Recorder->BeginStep(*Field);
+        }
+        RshipFieldSimulation::Step(*Field);
+        if (Field->Recorder.IsValid())
+        {
+            Field->Recorder->EndStep(*Field);
         }
         bDidStep = true;
     }
@@ -93,48 +128,22 @@ void URshipFieldSubsystem::TickField(URshipFieldComponent* Field, float DeltaTim
     {
         DistributeLightSamplerResults(Field);
     }
-}
-
-
-
-void URshipFieldSubsystem::DispatchFieldPasses(URshipFieldComponent* Field)
-{
-    if (!Field->EnsureAtlasTextures())
-    {
-        UE_LOG(LogRshipField, Warning, TEXT("DispatchFieldPasses: EnsureAtlasTextures failed for field '%s'"), *Field->FieldId);
-        return;
-    }
 
-    const int32 Resolution = GetFieldResolutionValue(Field->FieldResolution);
-    const int32 TilesPerRow = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Resolution))));
+    UpdateProbes(Field);
 
-    FTextureRenderTargetResource* ScalarResource = Field->GetScalarAtlas() ? Field->GetScalarAtlas()->GameThread_GetRenderTargetResource() : nullptr;
-    FTextureRenderTargetResource* VectorResource = Field->GetVectorAtlas() ? Field->GetVectorAtlas()->GameThread_GetRenderTargetResource() : nullptr;
-
-    if (!ScalarResource || !VectorResource)
+    // Everything queried against this field since its last tick goes out as one batch
+    FRshipFieldQueryQueue* FieldQueries = Queries.Find(Field);
+    const TSharedPtr<const FRshipFieldCpuEvaluator>* Evaluator = CpuEvaluators.Find(Field);
+    if (FieldQueries && Evaluator)
     {
-        return;
+        FieldQueries->Flush(*Evaluator);
     }
+}
 
-    const FVector DomainHalfExtent = FVector(Field->DomainSizeCm * 0.5f);
-    const FVector DomainMin = Field->DomainCenterCm - DomainHalfExtent;
-    const FVector DomainMax = Field->DomainCenterCm + DomainHalfExtent;
 
-    RshipFieldRDG::FGlobalDispatchInputs GlobalInputs;
-    GlobalInputs.FieldResolution = Resolution;
-    GlobalInputs.TilesPerRow = TilesPerRow;
-    GlobalInputs.TimeSeconds = Field->SimulationTimeSeconds;
-    GlobalInputs.BPM = Field->Bpm;
-    GlobalInputs.TransportPhase = Field->BeatPhase;
-    GlobalInputs.MasterScalarGain = Field->MasterScalarGain;
-    GlobalInputs.MasterVectorGain = Field->MasterVectorGain;
-    GlobalInputs.DomainMinCm = FVector4f(FVector3f(DomainMin), 0.0f);
-    GlobalInputs.DomainMaxCm = FVector4f(FVector3f(DomainMax), 0.0f);
-    GlobalInputs.DebugMode = 0;
-    GlobalInputs.DebugSelectionIndex = INDEX_NONE;
-    GlobalInputs.OutScalarFieldAtlasTexture = ScalarResource->GetRenderTargetTexture();
-    GlobalInputs.OutVectorFieldAtlasTexture = VectorResource->GetRenderTargetTexture();
 
+void URshipFieldSubsystem::DispatchFieldPasses(URshipFieldComponent* Field)
+{
     if (GEngine && Field->bShowDebugText)
     {
         GEngine->AddOnScreenDebugMessage(
@@ -145,156 +154,19 @@ void URshipFieldSubsystem::DispatchFieldPasses(URshipFieldComponent* Field)
                 *Field->FieldId, Field->SimulationTimeSeconds, Field->BeatPhase, Field->Bpm, Field->bPlaying ? TEXT("Y") : TEXT("N")));
     }
 
-    // Build phase groups
-    TMap<FString, int32> SyncGroupIndexById;
-    GlobalInputs.SyncGroupData.Add(FVector4f(0.0f, 1.0f, 0.0f, 0.0f));
-    SyncGroupIndexById.Add(TEXT(""), 0);
-
-    for (int32 GroupIndex = 0; GroupIndex < Field->SyncGroups.Num(); ++GroupIndex)
-    {
-        const FRshipFieldSyncGroup& Group = Field->SyncGroups[GroupIndex];
-        if (Group.Id.IsEmpty())
-        {
-            continue;
-        }
-        SyncGroupIndexById.Add(Group.Id, GlobalInputs.SyncGroupData.Num());
-        GlobalInputs.SyncGroupData.Add(FVector4f(
-            1.0f,
-            Group.TempoMultiplier,
-            Group.PhaseOffset,
-            0.0f));
-    }
-
-    // Single default layer
-    GlobalInputs.LayerDataA.Add(FVector4f(1.0f, -100.0f, 100.0f, 0.0f));
-    GlobalInputs.LayerDataB.Add(FVector4f(1.0f, -1.0f, 0.0f, 0.0f));
-
-    // Flatten typed effectors into internal format
+    RshipFieldRDG::FGlobalDispatchInputs GlobalInputs;
     TArray<FRshipFieldEffectorDesc> AllEffectors;
-    AllEffectors.Reserve(Field->WaveEffectors.Num() + Field->NoiseEffectors.Num() + Field->AttractorEffectors.Num());
+    RshipFieldSimulation::BuildGlobalInputs(*Field, GlobalInputs, &AllEffectors);
 
-    // Ensure wavefront state array matches wave effectors
-    if (Field->WaveEffectorStates.Num() != Field->WaveEffectors.Num())
-    {
-        Field->WaveEffectorStates.SetNum(Field->WaveEffectors.Num());
-    }
-
-    // Auto-emit and cull wavefronts, then flatten into internal format
-    for (int32 i = 0; i < Field->WaveEffectors.Num(); ++i)
-    {
-        const FRshipFieldWaveEffector& Wave = Field->WaveEffectors[i];
-        FRshipFieldWaveEffectorState& State = Field->WaveEffectorStates[i];
-
-        // Keep dispersion values in sync so switching Derive doesn't jump.
-        if (Wave.WaveMode == ERshipFieldWaveMode::Traveling)
-        {
-            FRshipFieldWaveEffector& MutableWave = Field->WaveEffectors[i];
-            float Wl = FMath::Max(MutableWave.WavelengthCm, 0.001f);
-            float Fr = FMath::Max(MutableWave.FrequencyHz, 0.001f);
-            float Sp = FMath::Max(MutableWave.WaveSpeedCmPerSec, 0.1f);
-            switch (MutableWave.Derive)
-            {
-            case ERshipFieldDerive::Speed:
-                MutableWave.WaveSpeedCmPerSec = Fr * Wl;
-                break;
-            case ERshipFieldDerive::Wavelength:
-                MutableWave.WavelengthCm = Sp / Fr;
-                break;
-            default: // LockFrequency
-                MutableWave.FrequencyHz = Sp / Wl;
-                break;
-            }
-        }
-
-        if (Wave.WaveMode == ERshipFieldWaveMode::Traveling && Wave.bEnabled)
-        {
-            // Manual emit-once trigger
-            if (Field->WaveEffectors[i].bEmitOnce)
-            {
-                Field->EmitWavefront(i);
-                Field->WaveEffectors[i].bEmitOnce = false;
-            }
-
-            // Auto-emit
-            if (Wave.bAutoEmit)
-            {
-                const float EmitInterval = 1.0f / FMath::Max(Wave.RepeatHz, 0.01f);
-                if ((Field->SimulationTimeSeconds - State.LastEmitTime) >= EmitInterval)
-                {
-                    FRshipFieldWavefront WF;
-                    WF.BirthTime = Field->SimulationTimeSeconds;
-                    WF.BirthPositionCm = Wave.PositionCm;
-                    State.Wavefronts.Add(WF);
-                    State.LastEmitTime = Field->SimulationTimeSeconds;
-
-                    while (State.Wavefronts.Num() > Wave.MaxWavefronts)
-                    {
-                        State.Wavefronts.RemoveAt(0);
-                    }
-                }
-            }
-
-            // Cull wavefronts that have traveled beyond the effector radius
-            const float MaxAge = Wave.RadiusCm / FMath::Max(Wave.WaveSpeedCmPerSec, 0.1f);
-            for (int32 j = State.Wavefronts.Num() - 1; j >= 0; --j)
-            {
-                if ((Field->SimulationTimeSeconds - State.Wavefronts[j].BirthTime) > MaxAge)
-                {
-                    State.Wavefronts.RemoveAt(j);
-                }
-            }
-        }
+    // Light samplers and queries evaluate this step on the CPU, independent of the atlas textures below
+    CpuEvaluators.Add(Field, MakeShared<FRshipFieldCpuEvaluator>(GlobalInputs));
 
-        AllEffectors.Add(FRshipFieldEffectorDesc::FromWave(Wave));
-    }
-
-    for (const FRshipFieldNoiseEffector& Noise : Field->NoiseEffectors)
-    {
-        AllEffectors.Add(FRshipFieldEffectorDesc::FromNoise(Noise));
-    }
-    for (const FRshipFieldAttractorEffector& Attractor : Field->AttractorEffectors)
-    {
-        AllEffectors.Add(FRshipFieldEffectorDesc::FromAttractor(Attractor));
-    }
-
-    // Build flat wavefront buffer and assign offsets to wave effectors
-    TArray<FVector4f> FlatWavefronts;
-    for (int32 i = 0; i < Field->WaveEffectors.Num(); ++i)
-    {
-        FRshipFieldEffectorDesc& Eff = AllEffectors[i];
-        const FRshipFieldWaveEffectorState& State = Field->WaveEffectorStates[i];
-
-        Eff.WavefrontOffset = FlatWavefronts.Num();
-        Eff.WavefrontCount = State.Wavefronts.Num();
-
-        for (const FRshipFieldWavefront& WF : State.Wavefronts)
-        {
-            FlatWavefronts.Add(FVector4f(
-                WF.BirthTime,
-                static_cast<float>(WF.BirthPositionCm.X),
-                static_cast<float>(WF.BirthPositionCm.Y),
-                static_cast<float>(WF.BirthPositionCm.Z)));
-        }
-    }
-    GlobalInputs.WavefrontData = MoveTemp(FlatWavefronts);
-
-    GlobalInputs.EffectorData0.Reserve(AllEffectors.Num());
-    GlobalInputs.EffectorData1.Reserve(AllEffectors.Num());
-    GlobalInputs.EffectorData2.Reserve(AllEffectors.Num());
-    GlobalInputs.EffectorData3.Reserve(AllEffectors.Num());
-    GlobalInputs.EffectorData4.Reserve(AllEffectors.Num());
-    GlobalInputs.EffectorData5.Reserve(AllEffectors.Num());
-    GlobalInputs.EffectorData6.Reserve(AllEffectors.Num());
-    GlobalInputs.EffectorData7.Reserve(AllEffectors.Num());
-
-    int32 EffectorDebugIndex = 0;
-    for (const FRshipFieldEffectorDesc& Eff : AllEffectors)
+    if (GEngine && Field->bShowDebugText)
     {
-        const int32* SyncGroupIndexPtr = SyncGroupIndexById.Find(Eff.SyncGroup);
-        const int32 SyncGroupIndex = SyncGroupIndexPtr ? *SyncGroupIndexPtr : 0;
-
-        if (GEngine && Field->bShowDebugText)
+        for (int32 EffectorDebugIndex = 0; EffectorDebugIndex < AllEffectors.Num(); ++EffectorDebugIndex)
         {
+            const FRshipFieldEffectorDesc& Eff = AllEffectors[EffectorDebugIndex];
+            const int32 SyncGroupIndex = static_cast<int32>(GlobalInputs.EffectorData5[EffectorDebugIndex].X);
             GEngine->AddOnScreenDebugMessage(
                 static_cast<uint64>(Field->GetUniqueID()) + 1000 + EffectorDebugIndex,
                 0.0f,
@@ -305,28 +177,50 @@ void URshipFieldSubsystem::DispatchFieldPasses(URshipFieldComponent* Field)
                     Eff.RadiusCm, Eff.FrequencyHz, Eff.WavelengthCm,
                     Eff.PhaseOffset, SyncGroupIndex, *Eff.SyncGroup));
         }
-        ++EffectorDebugIndex;
-
-        GlobalInputs.EffectorData0.Add(FVector4f(FVector3f(Eff.PositionCm), Eff.RadiusCm));
-        GlobalInputs.EffectorData1.Add(FVector4f(FVector3f(Eff.Polarization), Eff.Amplitude));
-        GlobalInputs.EffectorData2.Add(FVector4f(Eff.WavelengthCm, Eff.FrequencyHz, Eff.EnvelopeWidthCm, Eff.PhaseOffset));
-        GlobalInputs.EffectorData3.Add(FVector4f(Eff.FadeWeight, Eff.FalloffExponent, static_cast<float>(static_cast<uint8>(Eff.Type)), static_cast<float>(static_cast<uint8>(Eff.WaveMode))));
-        GlobalInputs.EffectorData4.Add(FVector4f(Eff.ClampMin, Eff.ClampMax, static_cast<float>(static_cast<uint8>(Eff.BlendOp)), static_cast<float>(static_cast<uint8>(Eff.Waveform))));
-        GlobalInputs.EffectorData5.Add(FVector4f(static_cast<float>(SyncGroupIndex), static_cast<float>(static_cast<uint8>(Eff.NoiseMode)), Eff.NoiseScale, Eff.NoiseAmplitude));
-        GlobalInputs.EffectorData6.Add(FVector4f(Eff.bEnabled ? 1.0f : 0.0f, Eff.bInfiniteRange ? 1.0f : 0.0f, Eff.bAffectsScalar ? 1.0f : 0.0f, Eff.bAffectsVector ? 1.0f : 0.0f));
-        GlobalInputs.EffectorData7.Add(FVector4f(static_cast<float>(Eff.WavefrontOffset), static_cast<float>(Eff.WavefrontCount), Eff.WaveSpeedCmPerSec, 0.0f));
     }
 
-    GlobalInputs.LayerCount = 1;
-    GlobalInputs.SyncGroupCount = GlobalInputs.SyncGroupData.Num();
-    GlobalInputs.EffectorCount = AllEffectors.Num();
+    if (!Field->EnsureAtlasTextures())
+    {
+        UE_LOG(LogRshipField, Warning, TEXT("DispatchFieldPasses: EnsureAtlasTextures failed for field '%s'"), *Field->FieldId);
+        return;
+    }
+
+    FTextureRenderTargetResource* ScalarResource = Field->GetScalarAtlas() ? Field->GetScalarAtlas()->GameThread_GetRenderTargetResource() : nullptr;
+    FTextureRenderTargetResource* VectorResource = Field->GetVectorAtlas() ? Field->GetVectorAtlas()->GameThread_GetRenderTargetResource() : nullptr;
+
+    if (!ScalarResource || !VectorResource)
+    {
+        return;
+    }
+
+    GlobalInputs.OutScalarFieldAtlasTexture = ScalarResource->GetRenderTargetTexture();
+    GlobalInputs.OutVectorFieldAtlasTexture = VectorResource->GetRenderTargetTexture();
 
     if (!GlobalInputs.IsValid())
     {
         return;
     }
 
-    UE_LOG(LogRshipField, Verbose, TEXT("Dispatching field '%s': %d effectors, %d layers, %d phasegroups, res=%d, t=%.2f"), *Field->FieldId, GlobalInputs.EffectorCount, GlobalInputs.LayerCount, GlobalInputs.SyncGroupCount, GlobalInputs.FieldResolution, GlobalInputs.TimeSeconds);
+    // Diff against the last dispatch; the textures are part of it, so a recreated atlas rebuilds fully
+    float DirtyFraction = 1.0f;
+    if (Field->bIncrementalUpdates)
+    {
+        FRshipFieldDirtyTiles& FieldDirtyTiles = DirtyTiles.FindOrAdd(Field);
+        FieldDirtyTiles.Update(GlobalInputs);
+        if (FieldDirtyTiles.IsClean())
+        {
+            return;
+        }
+        GlobalInputs.bDirtyTilesOnly = !FieldDirtyTiles.IsFullUpdate();
+        GlobalInputs.DirtyTiles = FieldDirtyTiles.GetDirtyTiles();
+        DirtyFraction = FieldDirtyTiles.GetDirtyVoxelFraction();
+    }
+    else
+    {
+        DirtyTiles.Remove(Field);
+    }
+
+    UE_LOG(LogRshipField, Verbose, TEXT("Dispatching field '%s': %d effectors, %d layers, %d phasegroups, res=%d, t=%.2f, dirty=%.1f%%"), *Field->FieldId, GlobalInputs.EffectorCount, GlobalInputs.LayerCount, GlobalInputs.SyncGroupCount, GlobalInputs.FieldResolution, GlobalInputs.TimeSeconds, DirtyFraction * 100.0f);
 
     TArray<RshipFieldRDG::FTargetDispatchInputs> EmptyTargets;
 
@@ -342,13 +236,8 @@ void URshipFieldSubsystem::DispatchFieldPasses(URshipFieldComponent* Field)
 void URshipFieldSubsystem::DistributeLightSamplerResults(URshipFieldComponent* Field)
 {
     // Collect sampler positions for this field
-    struct FSamplerEntry
-    {
-        URshipFieldLightSampler* Sampler;
-        FVector WorldPos;
-    };
-
-    TArray<FSamplerEntry> Entries;
+    LightSampleTargets.Reset();
+    LightSampleBatch.Reset();
     for (int32 i = RegisteredLightSamplers.Num() - 1; i >= 0; --i)
     {
         URshipFieldLightSampler* Sampler = RegisteredLightSamplers[i];
@@ -365,88 +254,165 @@ void URshipFieldSubsystem::DistributeLightSamplerResults(URshipFieldComponent* F
         if ((Sampler->bDriveIntensity && Sampler->IntensityFieldId == Field->FieldId) ||
             (Sampler->bDriveColor && Sampler->ColorFieldId == Field->FieldId))
         {
-            Entries.Add({ Sampler, Sampler->GetOwner()->GetActorLocation() });
+            LightSampleTargets.Add(Sampler);
+            LightSampleBatch.Add(Sampler->GetOwner()->GetActorLocation());
         }
     }
 
-    if (Entries.Num() == 0)
+    if (LightSampleTargets.Num() > 0)
     {
-        return;
+        if (Field->LightSampleMode == ERshipFieldSampleMode::Gpu)
+        {
+            SampleLightSamplersOnGpu(Field);
+        }
+        else if (const TSharedPtr<const FRshipFieldCpuEvaluator>* Evaluator = CpuEvaluators.Find(Field))
+        {
+            ReleaseGpuLightSampling(Field);
+            (*Evaluator)->EvaluatePoints(LightSampleBatch);
+            for (int32 i = 0; i < LightSampleTargets.Num(); ++i)
+            {
+                LightSampleTargets[i]->ApplyFieldSample(Field->FieldId, LightSampleBatch.Scalar[i], LightSampleBatch.GetVector(i));
+            }
+        }
     }
 
-    // Ensure tiny Nx1 render target
-    const int32 NumSamples = Entries.Num();
-    if (!PointSampleRT || PointSampleRT->SizeX != NumSamples || PointSampleRT->SizeY != 1)
+    LightSampleTargets.Reset();
+}
+
+TFuture<FRshipFieldQueryResult> URshipFieldSubsystem::QueryField(URshipFieldComponent* Field, TArray<FVector> PositionsCm)
+{
+    if (!Field || !RegisteredFields.Contains(Field))
     {
-        PointSampleRT = NewObject<UTextureRenderTarget2D>(GetTransientPackage(), NAME_None, RF_Transient);
-        PointSampleRT->RenderTargetFormat = RTF_RGBA16f;
-        PointSampleRT->bCanCreateUAV = true;
-        PointSampleRT->bAutoGenerateMips = false;
-        PointSampleRT->InitAutoFormat(NumSamples, 1);
-        PointSampleRT->UpdateResourceImmediate(true);
+        return MakeFulfilledPromise<FRshipFieldQueryResult>().GetFuture();
     }
+    return Queries.FindOrAdd(Field).Submit(MoveTemp(PositionsCm));
+}
 
-    FTextureRenderTargetResource* ResultResource = PointSampleRT->GameThread_GetRenderTargetResource();
-    if (!ResultResource)
+void URshipFieldSubsystem::UpdateProbes(URshipFieldComponent* Field)
+{
+    // One query in flight per field; results land a frame later, like GPU light sampling
+    if (Field->ProbeQuery.IsValid())
     {
-        return;
+        if (!Field->ProbeQuery.IsReady())
+        {
+            return;
+        }
+        const FRshipFieldQueryResult Result = Field->ProbeQuery.Consume();
+        Field->PublishProbeSamples(Field->ProbeQueryNames, Result);
     }
 
-    FTextureRenderTargetResource* ScalarResource = Field->GetScalarAtlas() ? Field->GetScalarAtlas()->GameThread_GetRenderTargetResource() : nullptr;
-    FTextureRenderTargetResource* VectorResource = Field->GetVectorAtlas() ? Field->GetVectorAtlas()->GameThread_GetRenderTargetResource() : nullptr;
-    if (!ScalarResource || !VectorResource)
+    if (!Field->bPublishProbes || Field->Probes.Num() == 0)
     {
         return;
     }
 
-    const int32 Resolution = GetFieldResolutionValue(Field->FieldResolution);
-    const int32 TilesPerRow = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Resolution))));
-    const FVector DomainHalfExtent = FVector(Field->DomainSizeCm * 0.5f);
+    TArray<FVector> PositionsCm;
+    Field->GetProbePositions(PositionsCm);
+    Field->ProbeQueryNames.Reset(Field->Probes.Num());
+    for (const FRshipFieldProbe& Probe : Field->Probes)
+    {
+        Field->ProbeQueryNames.Add(Probe.Name);
+    }
+    Field->ProbeQuery = QueryField(Field, MoveTemp(PositionsCm));
+}
 
-    RshipFieldRDG::FPointSampleInputs SampleInputs;
-    SampleInputs.FieldResolution = Resolution;
-    SampleInputs.TilesPerRow = TilesPerRow;
-    SampleInputs.DomainMinCm = FVector4f(FVector3f(Field->DomainCenterCm - DomainHalfExtent), 0.0f);
-    SampleInputs.DomainMaxCm = FVector4f(FVector3f(Field->DomainCenterCm + DomainHalfExtent), 0.0f);
-    SampleInputs.NumSamples = NumSamples;
-    SampleInputs.ScalarAtlasTexture = ScalarResource->GetRenderTargetTexture();
-    SampleInputs.VectorAtlasTexture = VectorResource->GetRenderTargetTexture();
-    SampleInputs.OutResultsTexture = ResultResource->GetRenderTargetTexture();
-
-    SampleInputs.Positions.Reserve(NumSamples);
-    for (const FSamplerEntry& Entry : Entries)
+void URshipFieldSubsystem::SampleLightSamplersOnGpu(URshipFieldComponent* Field)
+{
+    TSharedPtr<FRshipFieldGpuLightSampling>& State = GpuLightSampling.FindOrAdd(Field);
+    if (!State.IsValid())
     {
-        SampleInputs.Positions.Add(FVector4f(FVector3f(Entry.WorldPos), 0.0f));
+        State = MakeShared<FRshipFieldGpuLightSampling>();
     }
 
-    // Dispatch GPU point sample pass
-    ENQUEUE_RENDER_COMMAND(RshipFieldPointSample)(
-        [SampleInputs](FRHICommandListImmediate& RHICmdList)
+    // Sync slots before applying results: samplers that were removed or moved to another
+    // field since the readback was submitted lose their slot, and their results are dropped
+    FRshipFieldSampleSlots& Slots = State->Slots;
+    Slots.BeginFrame();
+    for (int32 i = 0; i < LightSampleTargets.Num(); ++i)
+    {
+        const int32 Slot = Slots.Acquire(LightSampleTargets[i]);
+        if (Slot >= State->Positions.Num())
         {
-            FRDGBuilder GraphBuilder(RHICmdList);
-            RshipFieldRDG::AddPointSamplePass(GraphBuilder, SampleInputs);
-            GraphBuilder.Execute();
-        });
+            State->Positions.SetNumZeroed(Slot + 1);
+        }
+        State->Positions[Slot] = FVector4f(LightSampleBatch.PositionX[i], LightSampleBatch.PositionY[i], LightSampleBatch.PositionZ[i], 0.0f);
+    }
+    Slots.EndFrame();
 
-    // Read tiny Nx1 result — previous frame's data (GPU hasn't finished this frame's yet)
-    FRenderTarget* ResultRT = PointSampleRT->GameThread_GetRenderTargetResource();
-    if (!ResultRT)
+    // Apply everything the GPU finished since last tick, oldest first
+    TArray<RshipFieldRDG::FPointSampleReadbackQueue::FCompleted> Completed;
+    State->Readbacks->TakeCompleted(Completed);
+    for (const RshipFieldRDG::FPointSampleReadbackQueue::FCompleted& Done : Completed)
     {
-        return;
+        if (!ensure(Done.Index == State->Ring.GetOldest()))
+        {
+            continue;
+        }
+
+        for (int32 Slot = 0; Slot < Done.Results.Num(); ++Slot)
+        {
+            if (!State->Ring.IsSlotCurrent(Done.Index, Slot, Slots))
+            {
+                continue;
+            }
+            if (URshipFieldLightSampler* Sampler = Cast<URshipFieldLightSampler>(Slots.GetOwner(Slot).ResolveObjectPtr()))
+            {
+                const FVector4f& Result = Done.Results[Slot];
+                Sampler->ApplyFieldSample(Field->FieldId, Result.X, FVector(Result.Y, Result.Z, Result.W));
+            }
+        }
+        State->Ring.Complete(Done.Index, GFrameCounter);
     }
 
-    TArray<FLinearColor> ResultPixels;
-    ResultRT->ReadLinearColorPixels(ResultPixels);
+    FTextureRenderTargetResource* ScalarResource = Field->GetScalarAtlas() ? Field->GetScalarAtlas()->GameThread_GetRenderTargetResource() : nullptr;
+    FTextureRenderTargetResource* VectorResource = Field->GetVectorAtlas() ? Field->GetVectorAtlas()->GameThread_GetRenderTargetResource() : nullptr;
 
-    if (ResultPixels.Num() < NumSamples)
+    // With every readback still in flight this tick only polls; the GPU is never waited on
+    int32 ReadbackIndex = INDEX_NONE;
+    RshipFieldRDG::FPointSampleInputs SampleInputs;
+    if (ScalarResource && VectorResource)
     {
-        return;
+        ReadbackIndex = State->Ring.Submit(GFrameCounter, Slots);
+    }
+    if (ReadbackIndex != INDEX_NONE)
+    {
+        const int32 Resolution = GetFieldResolutionValue(Field->FieldResolution);
+        const FVector DomainHalfExtent = FVector(Field->DomainSizeCm * 0.5f);
+
+        SampleInputs.FieldResolution = Resolution;
+        SampleInputs.TilesPerRow = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Resolution))));
+        SampleInputs.DomainMinCm = FVector4f(FVector3f(Field->DomainCenterCm - DomainHalfExtent), 0.0f);
+        SampleInputs.DomainMaxCm = FVector4f(FVector3f(Field->DomainCenterCm + DomainHalfExtent), 0.0f);
+        SampleInputs.NumSamples = Slots.GetNumSlots();
+        SampleInputs.ScalarAtlasTexture = ScalarResource->GetRenderTargetTexture();
+        SampleInputs.VectorAtlasTexture = VectorResource->GetRenderTargetTexture();
+        SampleInputs.Positions = State->Positions;
     }
 
-    // Distribute results
-    for (int32 i = 0; i < Entries.Num(); ++i)
+    ENQUEUE_RENDER_COMMAND(RshipFieldPointSample)(
+        [Readbacks = State->Readbacks, SampleInputs = MoveTemp(SampleInputs), Capacity = Slots.GetCapacity(), ReadbackIndex](FRHICommandListImmediate& RHICmdList)
+        {
+            Readbacks->Poll();
+            if (ReadbackIndex != INDEX_NONE)
+            {
+                FRDGBuilder GraphBuilder(RHICmdList);
+                Readbacks->Submit(GraphBuilder, SampleInputs, Capacity, ReadbackIndex);
+                GraphBuilder.Execute();
+            }
+        });
+}
+
+void URshipFieldSubsystem::ReleaseGpuLightSampling(TObjectKey<URshipFieldComponent> Field)
+{
+    TSharedPtr<FRshipFieldGpuLightSampling> State;
+    if (!GpuLightSampling.RemoveAndCopyValue(Field, State) || !State.IsValid())
     {
-        const FLinearColor& Result = ResultPixels[i];
-        Entries[i].Sampler->ApplyFieldSample(Field->FieldId, Result.R, FVector(Result.G, Result.B, Result.A));
+        return;
     }
+
+    ENQUEUE_RENDER_COMMAND(RshipFieldReleasePointSample)(
+        [Readbacks = MoveTemp(State->Readbacks)](FRHICommandListImmediate&)
+        {
+            // Last reference; the readbacks are destroyed with this command
+        });
 }
@@ -1,5 +1,147 @@
 #include "RshipFieldTypes.h"
 
+void FRshipFieldWaveEffector::SyncDispersion()
+{
+    if (WaveMode != ERshipFieldWaveMode::Traveling)
+    {
+        return;
+    }
+
+    const float Wl = FMath::Max(WavelengthCm, 0.001f);
+    const float Fr = FMath::Max(FrequencyHz, 0.001f);
+    const float Sp = FMath::Max(WaveSpeedCmPerSec, 0.1f);
+    switch (Derive)
+    {
+    case ERshipFieldDerive::Speed:
+        WaveSpeedCmPerSec = Fr * Wl;
+        break;
+    case ERshipFieldDerive::Wavelength:
+        WavelengthCm = Sp / Fr;
+        break;
+    default: // LockFrequency
+        FrequencyHz = Sp / Wl;
+        break;
+    }
+}
+
+void FRshipFieldWavefrontRing::Emit(float BirthTime, const FVector& BirthPositionCm, int32 MaxWavefronts)
+{
+    if (Count > 0 && BirthTime < Packed[Head + Count - 1].X)
+    {
+        Reset();
+    }
+
+    const int32 Limit = FMath::Clamp(MaxWavefronts, 1, Capacity);
+    while (Count >= Limit)
+    {
+        Head = (Head + 1) % Capacity;
+        --Count;
+    }
+
+    const int32 Slot = (Head + Count) % Capacity;
+    Packed[Slot] = FVector4f(
+        BirthTime,
+        static_cast<float>(BirthPositionCm.X),
+        static_cast<float>(BirthPositionCm.Y),
+        static_cast<float>(BirthPositionCm.Z));
+    Packed[Slot + Capacity] = Packed[Slot];
+    ++Count;
+}
+
+int32 FRshipFieldWavefrontRing::Expire(float Now, float MaxAgeSeconds)
+{
+    int32 NumExpired = 0;
+    while (Count > 0 && (Now - Packed[Head].X) > MaxAgeSeconds)
+    {
+        Head = (Head + 1) % Capacity;
+        --Count;
+        ++NumExpired;
+    }
+    return NumExpired;
+}
+
+float FRshipFieldWavefrontRing::GetNextExpiryTime(float MaxAgeSeconds) const
+{
+    return Count > 0 ? Packed[Head].X + MaxAgeSeconds : MAX_flt;
+}
+
+void FRshipFieldWavefrontRing::Reset()
+{
+    Head = 0;
+    Count = 0;
+}
+
+FRshipFieldWavefront FRshipFieldWavefrontRing::operator[](int32 Index) const
+{
+    check(Index >= 0 && Index < Count);
+    const FVector4f& Entry = Packed[Head + Index];
+
+    FRshipFieldWavefront Wavefront;
+    Wavefront.BirthTime = Entry.X;
+    Wavefront.BirthPositionCm = FVector(Entry.Y, Entry.Z, Entry.W);
+    return Wavefront;
+}
+
+void FRshipFieldTransportClock::Configure(double InStepSeconds, double InBpm, bool bInPlaying, double InMaxFreewheelSeconds)
+{
+    if (InStepSeconds == StepSeconds && InBpm == Bpm && bInPlaying == bPlaying && InMaxFreewheelSeconds == MaxFreewheelSeconds)
+    {
+        return;
+    }
+    Rebase();
+    StepSeconds = InStepSeconds;
+    Bpm = InBpm;
+    bPlaying = bInPlaying;
+    MaxFreewheelSeconds = InMaxFreewheelSeconds;
+}
+
+void FRshipFieldTransportClock::Locate(double Beat)
+{
+    AnchorBeat = Beat;
+    AnchorTick = Tick;
+}
+
+double FRshipFieldTransportClock::GetBeat() const
+{
+    if (!bPlaying)
+    {
+        return AnchorBeat;
+    }
+
+    double ElapsedSeconds = static_cast<double>(Tick - AnchorTick) * StepSeconds;
+    if (MaxFreewheelSeconds >= 0.0)
+    {
+        ElapsedSeconds = FMath::Min(ElapsedSeconds, MaxFreewheelSeconds);
+    }
+    return AnchorBeat + ElapsedSeconds * Bpm / 60.0;
+}
+
+float FRshipFieldTransportClock::Publish(int32 SyncCount)
+{
+    PublishedBeat = static_cast<float>(GetBeat());
+    PublishedSyncCount = SyncCount;
+    return PublishedBeat;
+}
+
+void FRshipFieldTransportClock::Rebase()
+{
+    Locate(GetBeat());
+}
+
+FArchive& operator<<(FArchive& Ar, FRshipFieldTransportClock& Clock)
+{
+    Ar << Clock.AnchorBeat;
+    Ar << Clock.AnchorTick;
+    Ar << Clock.Tick;
+    Ar << Clock.StepSeconds;
+    Ar << Clock.Bpm;
+    Ar << Clock.MaxFreewheelSeconds;
+    Ar << Clock.bPlaying;
+    Ar << Clock.PublishedBeat;
+    Ar << Clock.PublishedSyncCount;
+    return Ar;
+}
+
 FRshipFieldEffectorDesc FRshipFieldEffectorDesc::FromWave(const FRshipFieldWaveEffector& Wave)
 {
     FRshipFieldEffectorDesc Desc;
@@ -80,3 +222,40 @@ FRshipFieldEffectorDesc FRshipFieldEffectorDesc::FromAttractor(const FRshipField
     Desc.SyncGroup = Attractor.SyncGroup;
     return Desc;
 }
+
+FRshipFieldEffectorDesc FRshipFieldEffectorDesc::FromSpline(const FRshipFieldSplineEffector& Spline)
+{
+    FRshipFieldEffectorDesc Desc;
+    Desc.Type = ERshipFieldEffectorType::Spline;
+    Desc.bEnabled = Spline.bEnabled;
+    Desc.Polarization = Spline.Polarization;
+    Desc.RadiusCm = Spline.RadiusCm;
+    Desc.FalloffExponent = Spline.FalloffExponent;
+    Desc.Amplitude = Spline.Amplitude;
+    Desc.WavelengthCm = FMath::Max(Spline.WavelengthCm, 0.001f);
+    Desc.FrequencyHz = Spline.FrequencyHz;
+    Desc.PhaseOffset = Spline.PhaseOffset;
+    Desc.Waveform = Spline.Waveform;
+    Desc.SyncGroup = Spline.SyncGroup;
+    return Desc;
+}
+
+FRshipFieldEffectorDesc FRshipFieldEffectorDesc::FromRing(const FRshipFieldRingEffector& Ring)
+{
+    FRshipFieldEffectorDesc Desc;
+    Desc.Type = ERshipFieldEffectorType::Ring;
+    Desc.bEnabled = Ring.bEnabled;
+    Desc.PositionCm = Ring.CenterCm;
+    Desc.Polarization = Ring.Axis.IsNearlyZero() ? FVector::UpVector : Ring.Axis;
+    Desc.RadiusCm = Ring.RadiusCm;
+    Desc.FalloffExponent = Ring.FalloffExponent;
+    Desc.Amplitude = Ring.Amplitude;
+    // The kernel advances temporal phase at 2π·f; Speed is already in radians
+    Desc.FrequencyHz = Ring.Speed / UE_TWO_PI;
+    Desc.PhaseOffset = Ring.PhaseOffset;
+    Desc.Waveform = Ring.Waveform;
+    Desc.RingRadiusCm = FMath::Max(Ring.RingRadiusCm, 0.0f);
+    Desc.LobeCount = FMath::Max(Ring.LobeCount, 0);
+    Desc.SyncGroup = Ring.SyncGroup;
+    return Desc;
+}
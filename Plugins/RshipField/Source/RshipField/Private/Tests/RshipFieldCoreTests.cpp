@@ -1,2 +1,485 @@
-// Tests temporarily disabled during architecture refactor.
-// TODO(ms): rewrite tests for new multi-field architecture.
+// Copyright Rocketship. All Rights Reserved.
+
+#include "RshipFieldCpuEvaluator.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "RshipFieldTestInputs.h"
+
+namespace RshipFieldCoreTests
+{
+    constexpr float TwoPi = 6.28318530718f;
+    constexpr float Tolerance = 1e-4f;
+
+    RshipFieldRDG::FGlobalDispatchInputs MakeInputs(
+        const TArray<FRshipFieldEffectorDesc>& Effectors,
+        const TArray<FRshipFieldSyncGroup>& SyncGroups = TArray<FRshipFieldSyncGroup>(),
+        ERshipFieldResolution Resolution = ERshipFieldResolution::Res64)
+    {
+        RshipFieldRDG::FGlobalDispatchInputs Inputs = RshipFieldTestInputs::MakeEmptyInputs(Resolution, RshipFieldTestInputs::RoomHalfExtentCm);
+        RshipFieldRDG::PackEffectorInputs(Inputs, SyncGroups, Effectors);
+        return Inputs;
+    }
+
+    // Hard-edged standing wave at the origin, polarized along +Z.
+    FRshipFieldEffectorDesc MakeStandingWave(ERshipFieldWaveform Waveform)
+    {
+        FRshipFieldWaveEffector Wave;
+        Wave.Waveform = Waveform;
+        Wave.Polarization = FVector::UpVector;
+        Wave.RadiusCm = 1000.0f;
+        Wave.FalloffExponent = 0.0f;
+        Wave.Amplitude = 1.0f;
+        Wave.WavelengthCm = 400.0f;
+        Wave.FrequencyHz = 0.5f;
+        Wave.PhaseOffset = 0.4f;
+        return FRshipFieldEffectorDesc::FromWave(Wave);
+    }
+
+    // Reaches the whole room domain.
+    FRshipFieldEffectorDesc MakeAttractor(const FVector& PositionCm, float Strength, float FalloffExponent)
+    {
+        return RshipFieldTestInputs::MakeAttractor(PositionCm, RshipFieldTestInputs::RoomHalfExtentCm, Strength, FalloffExponent);
+    }
+
+    // Scalar reference for EvaluateWaveform in RshipFieldCS.usf.
+    float ReferenceWaveform(ERshipFieldWaveform Waveform, float Phase)
+    {
+        const float T = Phase / TwoPi - FMath::FloorToFloat(Phase / TwoPi);
+        switch (Waveform)
+        {
+        case ERshipFieldWaveform::Cosine:   return FMath::Cos(Phase);
+        case ERshipFieldWaveform::Triangle: return 1.0f - FMath::Abs(2.0f * T - 1.0f) * 2.0f;
+        case ERshipFieldWaveform::Saw:      return 2.0f * T - 1.0f;
+        case ERshipFieldWaveform::Square:   return T < 0.5f ? 1.0f : -1.0f;
+        default:                            return FMath::Sin(Phase);
+        }
+    }
+
+    float SampleScalar(const FRshipFieldCpuEvaluator& Evaluator, const FVector3f& PositionCm, FVector3f* OutVector = nullptr)
+    {
+        float Scalar = 0.0f;
+        FVector3f Vector = FVector3f::ZeroVector;
+        Evaluator.EvaluateAtPosition(PositionCm, false, Scalar, Vector);
+        if (OutVector)
+        {
+            *OutVector = Vector;
+        }
+        return Scalar;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldCpuStandingWaveTest,
+    "Rship.Field.CpuEvaluator.StandingWaveforms",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldCpuStandingWaveTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldCoreTests;
+
+    const ERshipFieldWaveform Waveforms[] = {
+        ERshipFieldWaveform::Sine, ERshipFieldWaveform::Cosine, ERshipFieldWaveform::Triangle,
+        ERshipFieldWaveform::Saw, ERshipFieldWaveform::Square
+    };
+    // Distances chosen so no spatial or temporal phase lands on a saw/square edge
+    const float Distances[] = { 0.0f, 37.0f, 150.0f, 290.0f };
+
+    for (const ERshipFieldWaveform Waveform : Waveforms)
+    {
+        const FRshipFieldEffectorDesc Desc = MakeStandingWave(Waveform);
+        RshipFieldRDG::FGlobalDispatchInputs Inputs = MakeInputs({ Desc });
+        Inputs.TimeSeconds = 0.3f;
+        const FRshipFieldCpuEvaluator Evaluator(Inputs);
+
+        const float Temporal = ReferenceWaveform(Waveform, Inputs.TimeSeconds * (TwoPi * Desc.FrequencyHz) + TwoPi * 0.25f);
+        for (const float Distance : Distances)
+        {
+            const float Spatial = ReferenceWaveform(Waveform, (Distance / Desc.WavelengthCm) * TwoPi + Desc.PhaseOffset);
+
+            FVector3f Vector;
+            const float Scalar = SampleScalar(Evaluator, FVector3f(Distance, 0.0f, 0.0f), &Vector);
+            const FString What = FString::Printf(TEXT("%s at %.0f cm"), *UEnum::GetValueAsString(Waveform), Distance);
+            TestEqual(*What, Scalar, Spatial * Temporal, Tolerance);
+            TestTrue(*(What + TEXT(" follows the polarization")), Vector.Equals(FVector3f(0.0f, 0.0f, Scalar), Tolerance));
+        }
+
+        TestEqual(TEXT("Nothing past the radius"), SampleScalar(Evaluator, FVector3f(0.0f, 1001.0f, 0.0f)), 0.0f);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldCpuTravelingWaveTest,
+    "Rship.Field.CpuEvaluator.TravelingWaveDispersion",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldCpuTravelingWaveTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldCoreTests;
+
+    // v = f · λ: whichever parameter Derive names is recomputed from the other two
+    FRshipFieldWaveEffector Wave;
+    Wave.WaveMode = ERshipFieldWaveMode::Traveling;
+    Wave.WavelengthCm = 300.0f;
+    Wave.FrequencyHz = 2.0f;
+    Wave.WaveSpeedCmPerSec = 900.0f;
+
+    Wave.Derive = ERshipFieldDerive::Speed;
+    TestEqual(TEXT("Derived speed"), FRshipFieldEffectorDesc::FromWave(Wave).WaveSpeedCmPerSec, 600.0f, Tolerance);
+    Wave.Derive = ERshipFieldDerive::Frequency;
+    TestEqual(TEXT("Derived frequency"), FRshipFieldEffectorDesc::FromWave(Wave).FrequencyHz, 3.0f, Tolerance);
+    Wave.Derive = ERshipFieldDerive::Wavelength;
+    Wave.WaveSpeedCmPerSec = 800.0f;
+    TestEqual(TEXT("Derived wavelength"), FRshipFieldEffectorDesc::FromWave(Wave).WavelengthCm, 400.0f, Tolerance);
+
+    // The kernel has to pick up the derived wavelength: one shell born at t=1, sampled at t=1.5
+    Wave.Waveform = ERshipFieldWaveform::Cosine;
+    Wave.RadiusCm = 5000.0f;
+    Wave.FalloffExponent = 0.0f;
+    Wave.EnvelopeWidthCm = 500.0f;
+    FRshipFieldEffectorDesc Desc = FRshipFieldEffectorDesc::FromWave(Wave);
+    Desc.WavefrontOffset = 0;
+    Desc.WavefrontCount = 2;
+
+    RshipFieldRDG::FGlobalDispatchInputs Inputs = MakeInputs({ Desc });
+    Inputs.TimeSeconds = 1.5f;
+    Inputs.WavefrontData = {
+        FVector4f(1.0f, 0.0f, 0.0f, 0.0f),
+        FVector4f(2.0f, 0.0f, 0.0f, 0.0f) // not born yet
+    };
+    const FRshipFieldCpuEvaluator Evaluator(Inputs);
+
+    const float ShellRadius = 0.5f * Desc.WaveSpeedCmPerSec;
+    TestEqual(TEXT("Crest on the shell"), SampleScalar(Evaluator, FVector3f(ShellRadius, 0.0f, 0.0f)), 1.0f, Tolerance);
+
+    const float Behind = 0.5f * Desc.WavelengthCm;
+    const float Envelope = FMath::Exp(-0.5f * FMath::Square(Behind / Wave.EnvelopeWidthCm));
+    TestEqual(TEXT("Trough half a wavelength out"), SampleScalar(Evaluator, FVector3f(0.0f, ShellRadius + Behind, 0.0f)), -Envelope, Tolerance);
+    TestEqual(TEXT("Trough half a wavelength in"), SampleScalar(Evaluator, FVector3f(0.0f, 0.0f, ShellRadius - Behind)), -Envelope, Tolerance);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldCpuAttractorTest,
+    "Rship.Field.CpuEvaluator.AttractorFalloff",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldCpuAttractorTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldCoreTests;
+
+    FRshipFieldEffectorDesc Desc = MakeAttractor(FVector(100.0f, 0.0f, 0.0f), 3.0f, 2.0f);
+    {
+        const FRshipFieldCpuEvaluator Evaluator(MakeInputs({ Desc }));
+
+        FVector3f Vector;
+        TestEqual(TEXT("Quadratic falloff at half radius"), SampleScalar(Evaluator, FVector3f(600.0f, 0.0f, 0.0f), &Vector), 0.75f, Tolerance);
+        TestTrue(TEXT("Pulls toward the attractor"), Vector.Equals(FVector3f(-0.75f, 0.0f, 0.0f), Tolerance));
+
+        TestEqual(TEXT("Full strength at the center"), SampleScalar(Evaluator, FVector3f(100.0f, 0.0f, 0.0f), &Vector), 3.0f, Tolerance);
+        TestTrue(TEXT("Degenerate direction falls back to +Z"), Vector.Equals(FVector3f(0.0f, 0.0f, 3.0f), Tolerance));
+
+        TestEqual(TEXT("Zero on the radius"), SampleScalar(Evaluator, FVector3f(1100.0f, 0.0f, 0.0f)), 0.0f);
+        TestEqual(TEXT("Zero outside"), SampleScalar(Evaluator, FVector3f(100.0f, -1500.0f, 0.0f)), 0.0f);
+    }
+
+    Desc.ClampMax = 2.0f;
+    Desc.Amplitude = -3.0f;
+    Desc.ClampMin = -1.0f;
+    {
+        const FRshipFieldCpuEvaluator Evaluator(MakeInputs({ Desc }));
+        TestEqual(TEXT("Clamped to the effector range"), SampleScalar(Evaluator, FVector3f(100.0f, 0.0f, 0.0f)), -1.0f, Tolerance);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldCpuNoiseTest,
+    "Rship.Field.CpuEvaluator.NoiseModes",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldCpuNoiseTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldCoreTests;
+
+    const ERshipFieldNoiseMode Modes[] = { ERshipFieldNoiseMode::Value, ERshipFieldNoiseMode::Simplex, ERshipFieldNoiseMode::Curl };
+    constexpr int32 NumModes = UE_ARRAY_COUNT(Modes);
+    TArray<float> ScalarsByMode[NumModes];
+
+    for (int32 ModeIndex = 0; ModeIndex < NumModes; ++ModeIndex)
+    {
+        FRshipFieldNoiseEffector Noise;
+        Noise.NoiseMode = Modes[ModeIndex];
+        Noise.RadiusCm = 5000.0f;
+        Noise.Amplitude = 1.0f;
+        Noise.Scale = 0.013f;
+
+        RshipFieldRDG::FGlobalDispatchInputs Inputs = MakeInputs({ FRshipFieldEffectorDesc::FromNoise(Noise) });
+        Inputs.TimeSeconds = 2.25f;
+        const FRshipFieldCpuEvaluator Evaluator(Inputs);
+        const FRshipFieldCpuEvaluator Repeat(Inputs);
+
+        const FString ModeName = UEnum::GetValueAsString(Modes[ModeIndex]);
+        float Min = TNumericLimits<float>::Max();
+        float Max = TNumericLimits<float>::Lowest();
+        bool bDeterministic = true;
+        bool bCurlBalanced = true;
+        bool bCurlScalarMatches = true;
+
+        for (int32 Step = 0; Step < 96; ++Step)
+        {
+            const FVector3f Position(Step * 11.0f - 500.0f, Step * 3.0f, 40.0f - Step * 7.0f);
+
+            FVector3f Vector;
+            const float Scalar = SampleScalar(Evaluator, Position, &Vector);
+            ScalarsByMode[ModeIndex].Add(Scalar);
+            Min = FMath::Min(Min, Scalar);
+            Max = FMath::Max(Max, Scalar);
+            bDeterministic &= SampleScalar(Repeat, Position) == Scalar;
+
+            if (Modes[ModeIndex] == ERshipFieldNoiseMode::Curl)
+            {
+                // The kernel's curl is (dy - dz, dz - dx, dx - dy): its components always sum to zero
+                const float Magnitude = Vector.Size();
+                bCurlBalanced &= FMath::Abs(Vector.X + Vector.Y + Vector.Z) <= Tolerance * FMath::Max(1.0f, Magnitude);
+                bCurlScalarMatches &= FMath::IsNearlyEqual(Scalar, FMath::Min(Magnitude * 0.577f, 100.0f), Tolerance * FMath::Max(1.0f, Magnitude));
+            }
+            else
+            {
+                TestTrue(*(ModeName + TEXT(" leaves the vector alone without polarization")), Vector.IsNearlyZero());
+            }
+        }
+
+        TestTrue(*(ModeName + TEXT(" produces a signal")), Max - Min > 0.05f);
+        TestTrue(*(ModeName + TEXT(" is deterministic")), bDeterministic);
+        if (Modes[ModeIndex] == ERshipFieldNoiseMode::Curl)
+        {
+            TestTrue(TEXT("Curl components sum to zero"), bCurlBalanced);
+            TestTrue(TEXT("Curl scalar is 0.577 |curl|"), bCurlScalarMatches);
+        }
+        else
+        {
+            TestTrue(*(ModeName + TEXT(" stays in [-1, 1]")), Min >= -1.0f - Tolerance && Max <= 1.0f + Tolerance);
+        }
+    }
+
+    TestTrue(TEXT("Simplex adds octaves on top of value noise"), ScalarsByMode[0] != ScalarsByMode[1]);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldCpuSyncGroupTest,
+    "Rship.Field.CpuEvaluator.SyncGroupPhase",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldCpuSyncGroupTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldCoreTests;
+
+    FRshipFieldSyncGroup Beat;
+    Beat.Id = TEXT("beat");
+    Beat.TempoMultiplier = 2.0f;
+    Beat.PhaseOffset = 0.3f;
+
+    FRshipFieldSyncGroup Held;
+    Held.Id = TEXT("held");
+    Held.TempoMultiplier = 0.0f;
+    Held.PhaseOffset = 1.1f;
+
+    auto SampleCenter = [&](const TCHAR* SyncGroup)
+    {
+        FRshipFieldEffectorDesc Desc = MakeStandingWave(ERshipFieldWaveform::Cosine);
+        Desc.PhaseOffset = 0.0f;
+        Desc.SyncGroup = SyncGroup;
+
+        RshipFieldRDG::FGlobalDispatchInputs Inputs = MakeInputs({ Desc }, { Beat, Held });
+        Inputs.TimeSeconds = 7.0f;
+        Inputs.TransportPhase = 0.125f;
+        return SampleScalar(FRshipFieldCpuEvaluator(Inputs), FVector3f::ZeroVector);
+    };
+
+    // At the source the spatial term is cos(0) = 1, leaving only the temporal phase
+    const float Quarter = TwoPi * 0.25f;
+    TestEqual(TEXT("Free running follows wall time"), SampleCenter(TEXT("")), FMath::Cos(7.0f * (TwoPi * 0.5f) + Quarter), Tolerance);
+    TestEqual(TEXT("Grouped follows the transport"), SampleCenter(TEXT("beat")), FMath::Cos(0.3f + 0.125f * TwoPi * 2.0f + Quarter), Tolerance);
+    TestEqual(TEXT("Zero tempo holds the group offset"), SampleCenter(TEXT("held")), FMath::Cos(1.1f + Quarter), Tolerance);
+    TestEqual(TEXT("Unknown group runs free"), SampleCenter(TEXT("missing")), SampleCenter(TEXT("")));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldCpuBlendTest,
+    "Rship.Field.CpuEvaluator.BlendOps",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldCpuBlendTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldCoreTests;
+
+    const float A = 0.5f;
+    const float B = -0.25f;
+    auto Blend = [&](ERshipFieldBlendOp Op)
+    {
+        FRshipFieldEffectorDesc First = MakeAttractor(FVector::ZeroVector, A, 0.0f);
+        FRshipFieldEffectorDesc Second = MakeAttractor(FVector::ZeroVector, B, 0.0f);
+        First.BlendOp = Op;
+        Second.BlendOp = Op;
+        return SampleScalar(FRshipFieldCpuEvaluator(MakeInputs({ First, Second })), FVector3f(10.0f, 20.0f, 30.0f));
+    };
+
+    // The first contribution seeds Min/Max/Multiply and is then combined with itself, as in the kernel
+    TestEqual(TEXT("Add"), Blend(ERshipFieldBlendOp::Add), A + B, Tolerance);
+    TestEqual(TEXT("Subtract"), Blend(ERshipFieldBlendOp::Subtract), -A - B, Tolerance);
+    TestEqual(TEXT("Min"), Blend(ERshipFieldBlendOp::Min), FMath::Min(A, B), Tolerance);
+    TestEqual(TEXT("Max"), Blend(ERshipFieldBlendOp::Max), FMath::Max(A, B), Tolerance);
+    TestEqual(TEXT("Multiply"), Blend(ERshipFieldBlendOp::Multiply), A * (1.0f + A) * (1.0f + B), Tolerance);
+
+    FRshipFieldEffectorDesc Disabled = MakeAttractor(FVector::ZeroVector, 10.0f, 0.0f);
+    Disabled.bEnabled = false;
+    FRshipFieldEffectorDesc VectorOnly = MakeAttractor(FVector::ZeroVector, 20.0f, 0.0f);
+    VectorOnly.bAffectsScalar = false;
+    FVector3f Vector;
+    const FRshipFieldCpuEvaluator Evaluator(MakeInputs({ MakeAttractor(FVector::ZeroVector, A, 0.0f), Disabled, VectorOnly }));
+    TestEqual(TEXT("Disabled and vector-only effectors leave the scalar alone"), SampleScalar(Evaluator, FVector3f(0.0f, 0.0f, -100.0f), &Vector), A, Tolerance);
+    TestTrue(TEXT("Vector-only effector still pushes"), Vector.Equals(FVector3f(0.0f, 0.0f, A + 20.0f), Tolerance));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldCpuAtlasTest,
+    "Rship.Field.CpuEvaluator.AtlasLayout",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldCpuAtlasTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldCoreTests;
+
+    FRshipFieldNoiseEffector Noise;
+    Noise.NoiseMode = ERshipFieldNoiseMode::Value;
+    Noise.Scale = 0.01f;
+
+    FRshipFieldAttractorEffector Infinite;
+    Infinite.Strength = 50.0f;
+    Infinite.bInfiniteRange = true;
+
+    RshipFieldRDG::FGlobalDispatchInputs Inputs = MakeInputs({
+        MakeStandingWave(ERshipFieldWaveform::Triangle),
+        MakeAttractor(FVector(300.0f, -200.0f, 100.0f), 2.0f, 1.0f),
+        FRshipFieldEffectorDesc::FromNoise(Noise),
+        FRshipFieldEffectorDesc::FromAttractor(Infinite) });
+    Inputs.TimeSeconds = 0.8f;
+    Inputs.MasterScalarGain = 2.0f;
+    Inputs.MasterVectorGain = 0.5f;
+
+    const FRshipFieldCpuEvaluator Evaluator(Inputs);
+    FRshipFieldCpuAtlas Atlas;
+    Evaluator.BuildAtlas(Atlas);
+
+    TestEqual(TEXT("64^3 packs into 8x8 tiles"), Atlas.TilesPerRow, 8);
+    TestEqual(TEXT("Atlas texels"), Atlas.Scalar.Num(), 512 * 512);
+    TestEqual(TEXT("Tile 9 starts one tile across and one down"), Atlas.GetAtlasCoord(1, 2, 9), FIntPoint(65, 66));
+
+    const FIntVector Voxels[] = { FIntVector(0, 0, 0), FIntVector(1, 2, 9), FIntVector(37, 5, 22), FIntVector(62, 63, 40), FIntVector(63, 63, 63) };
+    for (const FIntVector& Voxel : Voxels)
+    {
+        const FVector3f Center = Evaluator.GetVoxelCenter(Voxel.X, Voxel.Y, Voxel.Z);
+        const FString What = FString::Printf(TEXT("Voxel (%d, %d, %d)"), Voxel.X, Voxel.Y, Voxel.Z);
+        TestTrue(*(What + TEXT(" center")), Center.Equals(FVector3f(-1000.0f) + (FVector3f(Voxel) + 0.5f) / 64.0f * 2000.0f, 1e-2f));
+
+        float Scalar = 0.0f;
+        FVector3f Vector;
+        Evaluator.EvaluateAtPosition(Center, false, Scalar, Vector);
+
+        // SIMD rows and a broadcast single point run the same lanes: exact agreement
+        const int32 Index = Atlas.GetAtlasIndex(Voxel.X, Voxel.Y, Voxel.Z);
+        TestEqual(*(What + TEXT(" scalar")), Atlas.Scalar[Index], Scalar * 2.0f, 0.0f);
+        TestTrue(*(What + TEXT(" vector")), Atlas.Vector[Index] == FVector4f(Vector * 0.5f, 1.0f));
+    }
+
+    // The GPU infinite-range pass is disabled, so the atlas leaves those effectors out
+    float WithInfinite = 0.0f;
+    FVector3f Unused;
+    Evaluator.EvaluateAtPosition(Evaluator.GetVoxelCenter(0, 0, 0), true, WithInfinite, Unused);
+    TestEqual(TEXT("Infinite-range effectors evaluate without falloff"), WithInfinite, 50.0f, Tolerance);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldCpuEvaluatorBenchmark,
+    "Rship.Field.CpuEvaluator.Benchmark",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FRshipFieldCpuEvaluatorBenchmark::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldCoreTests;
+
+    // A representative show field: standing wave, traveling wave with four live shells, simplex noise, attractor
+    FRshipFieldWaveEffector Traveling;
+    Traveling.WaveMode = ERshipFieldWaveMode::Traveling;
+    Traveling.RadiusCm = 1500.0f;
+    FRshipFieldEffectorDesc TravelingDesc = FRshipFieldEffectorDesc::FromWave(Traveling);
+    TravelingDesc.WavefrontCount = 4;
+
+    FRshipFieldNoiseEffector Noise;
+    Noise.RadiusCm = 1500.0f;
+
+    const TArray<FRshipFieldEffectorDesc> Effectors = {
+        MakeStandingWave(ERshipFieldWaveform::Sine),
+        TravelingDesc,
+        FRshipFieldEffectorDesc::FromNoise(Noise),
+        MakeAttractor(FVector(200.0f, 0.0f, -300.0f), 1.0f, 2.0f)
+    };
+
+    // Whole volumes at 512 would need several GB of atlas; time a fixed set of slices instead
+    constexpr int32 SampledSlices = 16;
+    const ERshipFieldResolution Resolutions[] = {
+        ERshipFieldResolution::Res64, ERshipFieldResolution::Res128, ERshipFieldResolution::Res192, ERshipFieldResolution::Res256,
+        ERshipFieldResolution::Res320, ERshipFieldResolution::Res384, ERshipFieldResolution::Res512
+    };
+
+    for (const ERshipFieldResolution Resolution : Resolutions)
+    {
+        RshipFieldRDG::FGlobalDispatchInputs Inputs = MakeInputs(Effectors, TArray<FRshipFieldSyncGroup>(), Resolution);
+        Inputs.TimeSeconds = 3.0f;
+        Inputs.WavefrontData = {
+            FVector4f(2.9f, 0.0f, 0.0f, 0.0f), FVector4f(2.4f, 0.0f, 0.0f, 0.0f),
+            FVector4f(1.9f, 0.0f, 0.0f, 0.0f), FVector4f(1.4f, 0.0f, 0.0f, 0.0f)
+        };
+        const FRshipFieldCpuEvaluator Evaluator(Inputs);
+
+        const int32 Res = Evaluator.GetFieldResolution();
+        TArray<float> Scalar;
+        TArray<FVector4f> Vector;
+        Scalar.SetNumUninitialized(SampledSlices * Res * Res);
+        Vector.SetNumUninitialized(SampledSlices * Res * Res);
+
+        const double StartSeconds = FPlatformTime::Seconds();
+        ParallelFor(SampledSlices, [&](int32 Slice)
+        {
+            const int32 Z = Slice * Res / SampledSlices;
+            Evaluator.EvaluateSlice(Z, Scalar.GetData() + Slice * Res * Res, Vector.GetData() + Slice * Res * Res, Res);
+        });
+        const double ElapsedSeconds = FMath::Max(FPlatformTime::Seconds() - StartSeconds, 1e-9);
+
+        const double VoxelsPerSecond = static_cast<double>(SampledSlices) * Res * Res / ElapsedSeconds;
+        const double FullVolumeMs = static_cast<double>(Res) * Res * Res / VoxelsPerSecond * 1000.0;
+        TestTrue(TEXT("Evaluated voxels"), VoxelsPerSecond > 0.0);
+        AddInfo(FString::Printf(TEXT("%d^3, %d effectors: %.1f Mvoxels/s, full volume %.1f ms (checksum %.3f)"),
+            Res, Effectors.Num(), VoxelsPerSecond / 1.0e6, FullVolumeMs, Scalar[Res * Res / 2]));
+    }
+
+    return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
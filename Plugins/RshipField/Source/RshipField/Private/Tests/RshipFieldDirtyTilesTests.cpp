@@ -0,0 +1,407 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "RshipFieldDirtyTiles.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "HAL/PlatformTime.h"
+#include "RshipFieldCpuEvaluator.h"
+#include "RshipFieldTestInputs.h"
+
+namespace RshipFieldDirtyTilesTests
+{
+    using namespace RshipFieldTestInputs;
+
+    // Effector descs plus the clock and wavefronts they are packed with.
+    struct FScene
+    {
+        TArray<FRshipFieldEffectorDesc> Effectors;
+        TArray<FVector4f> Wavefronts;
+        float TimeSeconds = 0.0f;
+        float MasterScalarGain = 1.0f;
+    };
+
+    RshipFieldRDG::FGlobalDispatchInputs Pack(const FScene& Scene, ERshipFieldResolution Resolution, bool bCullEffectors)
+    {
+        RshipFieldRDG::FGlobalDispatchInputs Inputs = MakeEmptyInputs(Resolution);
+        Inputs.TimeSeconds = Scene.TimeSeconds;
+        Inputs.MasterScalarGain = Scene.MasterScalarGain;
+        Inputs.WavefrontData = Scene.Wavefronts;
+        RshipFieldRDG::PackEffectorInputs(Inputs, {}, Scene.Effectors);
+        if (bCullEffectors)
+        {
+            Inputs.EffectorTiles.Build(Inputs);
+        }
+        return Inputs;
+    }
+
+    FRshipFieldEffectorDesc MakeTravelingWave(const FVector& PositionCm, float RadiusCm, int32 WavefrontOffset, int32 WavefrontCount)
+    {
+        FRshipFieldWaveEffector Wave;
+        Wave.WaveMode = ERshipFieldWaveMode::Traveling;
+        Wave.PositionCm = PositionCm;
+        Wave.RadiusCm = RadiusCm;
+        FRshipFieldEffectorDesc Desc = FRshipFieldEffectorDesc::FromWave(Wave);
+        Desc.WavefrontOffset = WavefrontOffset;
+        Desc.WavefrontCount = WavefrontCount;
+        return Desc;
+    }
+
+    // A show's worth of static dressing: attractors and frozen standing patterns.
+    void AddStaticDressing(FScene& Scene, FRandomStream& Random, int32 NumEffectors)
+    {
+        for (int32 i = 0; i < NumEffectors; ++i)
+        {
+            const FVector PositionCm = RandomPosition(Random, 1800.0f);
+            const float RadiusCm = Random.FRandRange(150.0f, 350.0f);
+            Scene.Effectors.Add(i % 2 == 0 ? MakeAttractor(PositionCm, RadiusCm) : MakeStandingWave(PositionCm, RadiusCm, 0.0f));
+        }
+    }
+
+    bool ContainsTile(const FRshipFieldDirtyTiles& Tracker, int32 Tile)
+    {
+        return Tracker.GetDirtyTiles().Contains(static_cast<uint32>(Tile));
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldDirtyTilesTrackingTest,
+    "Rship.Field.DirtyTiles.Tracking",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldDirtyTilesTrackingTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldDirtyTilesTests;
+
+    // 64^3 over 4000 cm: 8 tiles per axis, 500 cm each
+    FScene Scene;
+    Scene.TimeSeconds = 1.0f;
+    Scene.Effectors = {
+        MakeAttractor(FVector(-1250.0f, -1250.0f, -1250.0f), 200.0f),
+        MakeStandingWave(FVector(1250.0f, 1250.0f, 1250.0f), 200.0f, 0.0f),
+        MakeStandingWave(FVector(-1250.0f, 1250.0f, -1250.0f), 200.0f, 2.0f, 0.0f),
+        MakeAttractor(FVector(1250.0f, -1250.0f, 250.0f), 200.0f),
+    };
+
+    FRshipFieldDirtyTiles Tracker;
+    FRshipFieldEffectorTiles Tiles;
+    Tiles.Build(Pack(Scene, ERshipFieldResolution::Res64, false));
+    auto TileAt = [&Tiles](const FVector& PositionCm)
+    {
+        const FVector Voxel = (PositionCm + FVector(StageHalfExtentCm)) * (64.0 / (2.0 * StageHalfExtentCm));
+        return Tiles.GetTileIndex(FMath::FloorToInt32(Voxel.X), FMath::FloorToInt32(Voxel.Y), FMath::FloorToInt32(Voxel.Z));
+    };
+
+    Tracker.Update(Pack(Scene, ERshipFieldResolution::Res64, false));
+    TestTrue(TEXT("First update is full"), Tracker.IsFullUpdate());
+    TestEqual(TEXT("Full covers the volume"), Tracker.GetDirtyVoxelFraction(), 1.0f);
+    TestEqual(TEXT("8 tiles per axis"), Tracker.GetTilesPerAxis(), 8);
+
+    // Nothing here reads the clock: frozen standing wave, silent wave, attractors
+    Scene.TimeSeconds += 1.0f / 60.0f;
+    Tracker.Update(Pack(Scene, ERshipFieldResolution::Res64, false));
+    TestTrue(TEXT("Static scene is clean as time passes"), Tracker.IsClean());
+    TestEqual(TEXT("No voxels"), Tracker.GetNumDirtyVoxels(), static_cast<int64>(0));
+
+    // Moving one effector dirties where it was and where it is
+    const FVector From(1250.0f, -1250.0f, 250.0f);
+    const FVector To(1250.0f, -250.0f, 250.0f);
+    Scene.Effectors[3] = MakeAttractor(To, 200.0f);
+    Tracker.Update(Pack(Scene, ERshipFieldResolution::Res64, false));
+    TestFalse(TEXT("Move is not full"), Tracker.IsFullUpdate());
+    TestTrue(TEXT("Old tile dirty"), ContainsTile(Tracker, TileAt(From)));
+    TestTrue(TEXT("New tile dirty"), ContainsTile(Tracker, TileAt(To)));
+    TestFalse(TEXT("Other effectors' tiles clean"), ContainsTile(Tracker, TileAt(FVector(-1250.0f, -1250.0f, -1250.0f))));
+    TestEqual(TEXT("Old and new tile only"), Tracker.GetDirtyTiles().Num(), 2);
+    TestEqual(TEXT("Two tiles of voxels"), Tracker.GetNumDirtyVoxels(), static_cast<int64>(2 * 8 * 8 * 8));
+
+    int32 Unordered = 0;
+    for (int32 i = 1; i < Tracker.GetDirtyTiles().Num(); ++i)
+    {
+        Unordered += Tracker.GetDirtyTiles()[i] <= Tracker.GetDirtyTiles()[i - 1] ? 1 : 0;
+    }
+    TestEqual(TEXT("Tiles ascend"), Unordered, 0);
+
+    // A standing wave with a frequency is dirty every step, and only there
+    Scene.Effectors[1] = MakeStandingWave(FVector(1250.0f, 1250.0f, 1250.0f), 200.0f, 0.5f);
+    Tracker.Update(Pack(Scene, ERshipFieldResolution::Res64, false));
+    for (int32 Step = 0; Step < 3; ++Step)
+    {
+        Scene.TimeSeconds += 1.0f / 60.0f;
+        Tracker.Update(Pack(Scene, ERshipFieldResolution::Res64, false));
+        TestEqual(TEXT("Animating wave keeps its tile dirty"), Tracker.GetDirtyTiles().Num(), 1);
+        TestTrue(TEXT("Its tile"), ContainsTile(Tracker, TileAt(FVector(1250.0f, 1250.0f, 1250.0f))));
+    }
+    Scene.Effectors[1] = MakeStandingWave(FVector(1250.0f, 1250.0f, 1250.0f), 200.0f, 0.0f);
+    Tracker.Update(Pack(Scene, ERshipFieldResolution::Res64, false));
+    Scene.TimeSeconds += 1.0f / 60.0f;
+    Tracker.Update(Pack(Scene, ERshipFieldResolution::Res64, false));
+    TestTrue(TEXT("Clean again once frozen"), Tracker.IsClean());
+
+    // Traveling waves animate while they have wavefronts
+    Scene.Wavefronts = { FVector4f(0.5f, 1250.0f, 1250.0f, -1250.0f) };
+    Scene.Effectors.Add(MakeTravelingWave(FVector(1250.0f, 1250.0f, -1250.0f), 200.0f, 0, 0));
+    Tracker.Update(Pack(Scene, ERshipFieldResolution::Res64, false));
+    TestTrue(TEXT("Adding an effector is full"), Tracker.IsFullUpdate());
+    Scene.TimeSeconds += 1.0f / 60.0f;
+    Tracker.Update(Pack(Scene, ERshipFieldResolution::Res64, false));
+    TestTrue(TEXT("No wavefronts, nothing moves"), Tracker.IsClean());
+    Scene.Effectors.Last().WavefrontCount = 1;
+    Tracker.Update(Pack(Scene, ERshipFieldResolution::Res64, false));
+    Scene.TimeSeconds += 1.0f / 60.0f;
+    Tracker.Update(Pack(Scene, ERshipFieldResolution::Res64, false));
+    TestTrue(TEXT("Live wavefront dirties its tile"), ContainsTile(Tracker, TileAt(FVector(1250.0f, 1250.0f, -1250.0f))));
+    TestEqual(TEXT("Only its tile"), Tracker.GetDirtyTiles().Num(), 1);
+    Scene.Effectors.Last().WavefrontCount = 0;
+    Tracker.Update(Pack(Scene, ERshipFieldResolution::Res64, false));
+
+    // Shared state and global effectors rebuild everything
+    Scene.MasterScalarGain = 2.0f;
+    Tracker.Update(Pack(Scene, ERshipFieldResolution::Res64, false));
+    TestTrue(TEXT("Gain change is full"), Tracker.IsFullUpdate());
+    Tracker.Update(Pack(Scene, ERshipFieldResolution::Res64, false));
+    TestTrue(TEXT("Then clean"), Tracker.IsClean());
+
+    Scene.Effectors[3].BlendOp = ERshipFieldBlendOp::Max;
+    Tracker.Update(Pack(Scene, ERshipFieldResolution::Res64, false));
+    TestTrue(TEXT("Turning global is full"), Tracker.IsFullUpdate());
+    Scene.Effectors[3].Amplitude = 0.5f;
+    Tracker.Update(Pack(Scene, ERshipFieldResolution::Res64, false));
+    TestTrue(TEXT("Changing a global effector is full"), Tracker.IsFullUpdate());
+    Scene.Effectors[3].BlendOp = ERshipFieldBlendOp::Add;
+    Tracker.Update(Pack(Scene, ERshipFieldResolution::Res64, false));
+    TestTrue(TEXT("Leaving global is full"), Tracker.IsFullUpdate());
+    Tracker.Update(Pack(Scene, ERshipFieldResolution::Res64, false));
+    TestTrue(TEXT("Then clean"), Tracker.IsClean());
+
+    Tracker.Update(Pack(Scene, ERshipFieldResolution::Res128, false));
+    TestTrue(TEXT("Resolution change is full"), Tracker.IsFullUpdate());
+    TestEqual(TEXT("16 tiles per axis"), Tracker.GetTilesPerAxis(), 16);
+
+    Tracker.Invalidate();
+    Tracker.Update(Pack(Scene, ERshipFieldResolution::Res128, false));
+    TestTrue(TEXT("Invalidate is full"), Tracker.IsFullUpdate());
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldDirtyTilesBoundedMoveTest,
+    "Rship.Field.DirtyTiles.BoundedMove",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldDirtyTilesBoundedMoveTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldDirtyTilesTests;
+
+    // All-additive show: none of the dressing is order-sensitive, so every effector stays bounded
+    FRandomStream Random(3);
+    FScene Scene;
+    Scene.TimeSeconds = 1.0f;
+    AddStaticDressing(Scene, Random, 32);
+    const int32 Moving = Scene.Effectors.Add(MakeAttractor(FVector(-600.0f, 300.0f, 0.0f), 250.0f));
+
+    FRshipFieldDirtyTiles Tracker;
+    const RshipFieldRDG::FGlobalDispatchInputs Before = Pack(Scene, ERshipFieldResolution::Res64, false);
+    Tracker.Update(Before);
+    Tracker.Update(Before);
+    TestTrue(TEXT("Settled"), Tracker.IsClean());
+
+    int32 Global = 0;
+    for (const FRshipFieldEffectorTiles::FEffectorBounds& Bounds : FRshipFieldEffectorTiles::ComputeBounds(Before))
+    {
+        Global += Bounds.Cull == FRshipFieldEffectorTiles::ECull::Global ? 1 : 0;
+    }
+    TestEqual(TEXT("No additive effector is global"), Global, 0);
+
+    Scene.Effectors[Moving].PositionCm = FVector(700.0f, -300.0f, 400.0f);
+    const RshipFieldRDG::FGlobalDispatchInputs After = Pack(Scene, ERshipFieldResolution::Res64, false);
+    Tracker.Update(After);
+    TestFalse(TEXT("Moving one bounded effector is not full"), Tracker.IsFullUpdate());
+
+    // Exactly the tiles its old and new bounds reach
+    TArray<uint32> Expected;
+    auto AddTiles = [&Expected](const RshipFieldRDG::FGlobalDispatchInputs& Inputs, int32 EffectorIndex)
+    {
+        FRshipFieldEffectorTiles::ForEachOverlappedTile(Inputs, FRshipFieldEffectorTiles::ComputeBounds(Inputs)[EffectorIndex],
+            [&Expected](int32 Tile) { Expected.AddUnique(static_cast<uint32>(Tile)); });
+    };
+    AddTiles(Before, Moving);
+    AddTiles(After, Moving);
+    Expected.Sort();
+    TestTrue(TEXT("Reaches a few tiles"), Expected.Num() > 0 && Expected.Num() < 32);
+    TestTrue(TEXT("Dirty tiles are its old and new tiles only"), Tracker.GetDirtyTiles() == Expected);
+    TestTrue(*FString::Printf(TEXT("Small share of the volume (%.1f%%)"), 100.0f * Tracker.GetDirtyVoxelFraction()), Tracker.GetDirtyVoxelFraction() < 0.1f);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldDirtyTilesIncrementalTest,
+    "Rship.Field.DirtyTiles.IncrementalMatchesFull",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldDirtyTilesIncrementalTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldDirtyTilesTests;
+
+    for (const bool bCullEffectors : { false, true })
+    {
+        FRandomStream Random(7);
+        FScene Scene;
+        Scene.TimeSeconds = 2.0f;
+        AddStaticDressing(Scene, Random, 24);
+        const int32 Moving = Scene.Effectors.Add(MakeAttractor(FVector(0.0f, 0.0f, 0.0f), 300.0f));
+        const int32 Breathing = Scene.Effectors.Add(MakeStandingWave(FVector(-800.0f, 600.0f, 0.0f), 400.0f, 0.7f));
+        Scene.Wavefronts = { FVector4f(1.5f, 900.0f, -900.0f, 300.0f) };
+        Scene.Effectors.Add(MakeTravelingWave(FVector(900.0f, -900.0f, 300.0f), 500.0f, 0, 1));
+        const int32 Toggled = 3;
+
+        FRshipFieldDirtyTiles Tracker;
+        FRshipFieldCpuAtlas Incremental;
+
+        int32 Partial = 0;
+        int32 Mismatches = 0;
+        float FractionSum = 0.0f;
+        constexpr int32 NumSteps = 12;
+        for (int32 Step = 0; Step < NumSteps; ++Step)
+        {
+            Scene.TimeSeconds += 1.0f / 30.0f;
+            Scene.Effectors[Moving].PositionCm = FVector(FMath::Cos(Step * 0.4f), FMath::Sin(Step * 0.4f), 0.0f) * 1000.0f;
+            if (Step % 4 == 2)
+            {
+                Scene.Effectors[Toggled].bEnabled = !Scene.Effectors[Toggled].bEnabled;
+            }
+            // One step of order-sensitive blending forces a full rebuild and back
+            Scene.Effectors[Breathing].BlendOp = Step == 7 ? ERshipFieldBlendOp::Max : ERshipFieldBlendOp::Add;
+
+            const RshipFieldRDG::FGlobalDispatchInputs Inputs = Pack(Scene, ERshipFieldResolution::Res64, bCullEffectors);
+            Tracker.Update(Inputs);
+            const FRshipFieldCpuEvaluator Evaluator(Inputs);
+            if (Tracker.IsFullUpdate())
+            {
+                Evaluator.BuildAtlas(Incremental);
+            }
+            else
+            {
+                Evaluator.UpdateAtlasTiles(Incremental, Tracker.GetDirtyTiles());
+                ++Partial;
+                FractionSum += Tracker.GetDirtyVoxelFraction();
+            }
+
+            FRshipFieldCpuAtlas Full;
+            Evaluator.BuildAtlas(Full);
+            for (int32 i = 0; i < Full.Scalar.Num(); ++i)
+            {
+                Mismatches += (Full.Scalar[i] != Incremental.Scalar[i] || Full.Vector[i] != Incremental.Vector[i]) ? 1 : 0;
+            }
+        }
+
+        TestTrue(TEXT("Most steps were partial"), Partial >= NumSteps - 3);
+        TestTrue(*FString::Printf(TEXT("Partial steps rebuild a small share (%.1f%%)"), 100.0f * FractionSum / FMath::Max(Partial, 1)),
+            FractionSum / FMath::Max(Partial, 1) < 0.25f);
+        TestEqual(*FString::Printf(TEXT("Incremental atlas equals full rebuild (culled %d)"), bCullEffectors ? 1 : 0), Mismatches, 0);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldDirtyTilesBenchmark,
+    "Rship.Field.DirtyTiles.Benchmark",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FRshipFieldDirtyTilesBenchmark::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldDirtyTilesTests;
+
+    enum class EShow : uint8 { StaticInstall, FollowSpots, RippleCues, BreathingStage, GlobalWash };
+    const TPair<EShow, const TCHAR*> Shows[] = {
+        { EShow::StaticInstall, TEXT("Static install") },
+        { EShow::FollowSpots, TEXT("Four follow spots") },
+        { EShow::RippleCues, TEXT("Three ripple cues") },
+        { EShow::BreathingStage, TEXT("Breathing stage") },
+        { EShow::GlobalWash, TEXT("Global Max wash") },
+    };
+
+    constexpr int32 NumSteps = 240;
+    for (const TPair<EShow, const TCHAR*>& Show : Shows)
+    {
+        FRandomStream Random(11);
+        FScene Scene;
+        AddStaticDressing(Scene, Random, 48);
+
+        TArray<int32> Animated;
+        switch (Show.Key)
+        {
+        case EShow::FollowSpots:
+            for (int32 i = 0; i < 4; ++i)
+            {
+                Animated.Add(Scene.Effectors.Add(MakeAttractor(FVector::ZeroVector, 250.0f)));
+            }
+            break;
+        case EShow::RippleCues:
+            for (int32 i = 0; i < 3; ++i)
+            {
+                const FVector Source = RandomPosition(Random, 1200.0f);
+                Scene.Wavefronts.Add(FVector4f(0.0f, Source.X, Source.Y, Source.Z));
+                Scene.Effectors.Add(MakeTravelingWave(Source, 600.0f, i, 1));
+            }
+            break;
+        case EShow::BreathingStage:
+            for (FRshipFieldEffectorDesc& Effector : Scene.Effectors)
+            {
+                Effector.FrequencyHz = 0.5f;
+            }
+            break;
+        case EShow::GlobalWash:
+            Animated.Add(Scene.Effectors.Add(MakeAttractor(FVector::ZeroVector, 2500.0f)));
+            Scene.Effectors.Last().BlendOp = ERshipFieldBlendOp::Max;
+            break;
+        default:
+            break;
+        }
+
+        FRshipFieldDirtyTiles Tracker;
+        double UpdateSeconds = 0.0;
+        double FractionSum = 0.0;
+        float MaxFraction = 0.0f;
+        for (int32 Step = 0; Step <= NumSteps; ++Step)
+        {
+            Scene.TimeSeconds = Step / 60.0f;
+            for (int32 i = 0; i < Animated.Num(); ++i)
+            {
+                FRshipFieldEffectorDesc& Effector = Scene.Effectors[Animated[i]];
+                if (Effector.BlendOp == ERshipFieldBlendOp::Max)
+                {
+                    Effector.Amplitude = 0.5f + 0.5f * FMath::Sin(Scene.TimeSeconds);
+                }
+                else
+                {
+                    const float Angle = Scene.TimeSeconds * 0.5f + i * UE_HALF_PI;
+                    Effector.PositionCm = FVector(FMath::Cos(Angle) * 1200.0f, FMath::Sin(Angle) * 1200.0f, 0.0f);
+                }
+            }
+
+            const RshipFieldRDG::FGlobalDispatchInputs Inputs = Pack(Scene, ERshipFieldResolution::Res128, false);
+            const double StartSeconds = FPlatformTime::Seconds();
+            Tracker.Update(Inputs);
+            if (Step == 0)
+            {
+                continue;
+            }
+            UpdateSeconds += FPlatformTime::Seconds() - StartSeconds;
+            FractionSum += Tracker.GetDirtyVoxelFraction();
+            MaxFraction = FMath::Max(MaxFraction, Tracker.GetDirtyVoxelFraction());
+        }
+
+        TestTrue(TEXT("Tracked"), UpdateSeconds >= 0.0);
+        AddInfo(FString::Printf(TEXT("%s, %d effectors at 128^3: recomputed %.1f%% of voxels on average, %.1f%% at most; tracking %.3f ms per step"),
+            Show.Value, Scene.Effectors.Num(), 100.0 * FractionSum / NumSteps, 100.0f * MaxFraction, UpdateSeconds * 1000.0 / NumSteps));
+    }
+
+    return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
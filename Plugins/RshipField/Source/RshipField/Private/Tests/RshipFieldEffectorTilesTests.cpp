@@ -0,0 +1,311 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "RshipFieldEffectorTiles.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "HAL/PlatformTime.h"
+#include "RshipFieldCpuEvaluator.h"
+#include "RshipFieldPolyline.h"
+#include "RshipFieldTestInputs.h"
+
+namespace RshipFieldEffectorTilesTests
+{
+    using namespace RshipFieldTestInputs;
+    using ECull = FRshipFieldEffectorTiles::ECull;
+
+    // Many small effectors of every kind scattered through the domain, plus a spline and a ring.
+    // A Multiply effector partway through makes everything before it order-sensitive.
+    RshipFieldRDG::FGlobalDispatchInputs MakeSparseInputs(ERshipFieldResolution Resolution, int32 NumEffectors, int32 MultiplyIndex)
+    {
+        FRandomStream Random(NumEffectors);
+        RshipFieldRDG::FGlobalDispatchInputs Inputs = MakeEmptyInputs(Resolution);
+        Inputs.TimeSeconds = 1.7f;
+        Inputs.TransportPhase = 0.4f;
+
+        TArray<FRshipFieldEffectorDesc> Descs;
+        for (int32 i = 0; i < NumEffectors; ++i)
+        {
+            FRshipFieldEffectorDesc Desc;
+            switch (i % 4)
+            {
+            case 0:
+            {
+                FRshipFieldWaveEffector Wave;
+                Wave.PositionCm = RandomPosition(Random, 1800.0f);
+                Wave.RadiusCm = Random.FRandRange(150.0f, 400.0f);
+                Wave.Polarization = FVector(0.0f, 0.0f, 1.0f);
+                Desc = FRshipFieldEffectorDesc::FromWave(Wave);
+                break;
+            }
+            case 1:
+            {
+                FRshipFieldWaveEffector Wave;
+                Wave.WaveMode = ERshipFieldWaveMode::Traveling;
+                Wave.PositionCm = RandomPosition(Random, 1800.0f);
+                Wave.RadiusCm = Random.FRandRange(150.0f, 400.0f);
+                Desc = FRshipFieldEffectorDesc::FromWave(Wave);
+                Desc.WavefrontOffset = 0;
+                Desc.WavefrontCount = 1;
+                break;
+            }
+            case 2:
+            {
+                FRshipFieldNoiseEffector Noise;
+                Noise.NoiseMode = ERshipFieldNoiseMode::Curl;
+                Noise.PositionCm = RandomPosition(Random, 1800.0f);
+                Noise.RadiusCm = Random.FRandRange(150.0f, 400.0f);
+                Noise.Scale = 0.01f;
+                Desc = FRshipFieldEffectorDesc::FromNoise(Noise);
+                break;
+            }
+            default:
+            {
+                FRshipFieldAttractorEffector Attractor;
+                Attractor.PositionCm = RandomPosition(Random, 1800.0f);
+                Attractor.RadiusCm = Random.FRandRange(150.0f, 400.0f);
+                Desc = FRshipFieldEffectorDesc::FromAttractor(Attractor);
+                break;
+            }
+            }
+            if (i == MultiplyIndex)
+            {
+                Desc.BlendOp = ERshipFieldBlendOp::Multiply;
+            }
+            Descs.Add(Desc);
+        }
+
+        const FVector3f PathPoints[] = { FVector3f(-1500.0f, -1500.0f, 0.0f), FVector3f(-500.0f, -1200.0f, 200.0f), FVector3f(0.0f, -1500.0f, -100.0f) };
+        FRshipFieldPolyline Path;
+        Path.Build(PathPoints, false);
+        Path.Pack(Inputs.SplineNodeData, Inputs.SplineSegmentData);
+        FRshipFieldSplineEffector Spline;
+        Spline.RadiusCm = 250.0f;
+        Descs.Add(FRshipFieldEffectorDesc::FromSpline(Spline));
+
+        FRshipFieldRingEffector Ring;
+        Ring.CenterCm = FVector(900.0f, 900.0f, 600.0f);
+        Ring.Axis = FVector(1.0f, 1.0f, 0.0f);
+        Ring.RingRadiusCm = 600.0f;
+        Ring.RadiusCm = 150.0f;
+        Descs.Add(FRshipFieldEffectorDesc::FromRing(Ring));
+
+        Inputs.WavefrontData = { FVector4f(1.2f, 0.0f, 0.0f, 0.0f) };
+        RshipFieldRDG::PackEffectorInputs(Inputs, {}, Descs);
+        Inputs.EffectorTiles.Build(Inputs);
+        return Inputs;
+    }
+
+    RshipFieldRDG::FGlobalDispatchInputs WithoutTiles(const RshipFieldRDG::FGlobalDispatchInputs& Inputs)
+    {
+        RshipFieldRDG::FGlobalDispatchInputs Unculled = Inputs;
+        Unculled.EffectorTiles.Reset();
+        return Unculled;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldEffectorTilesBoundsTest,
+    "Rship.Field.EffectorTiles.Bounds",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldEffectorTilesBoundsTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldEffectorTilesTests;
+
+    FRshipFieldAttractorEffector Attractor;
+    Attractor.PositionCm = FVector(100.0f, 200.0f, 300.0f);
+    Attractor.RadiusCm = 300.0f;
+
+    FRshipFieldWaveEffector Disabled;
+    Disabled.bEnabled = false;
+
+    FRshipFieldNoiseEffector Infinite;
+    Infinite.bInfiniteRange = true;
+
+    FRshipFieldRingEffector Ring;
+    Ring.CenterCm = FVector(0.0f, 0.0f, 500.0f);
+    Ring.RingRadiusCm = 500.0f;
+    Ring.RadiusCm = 100.0f;
+
+    FRshipFieldEffectorDesc Clamped = FRshipFieldEffectorDesc::FromAttractor(Attractor);
+    Clamped.ClampMin = 0.25f;
+
+    FRshipFieldEffectorDesc MaxBlend = FRshipFieldEffectorDesc::FromAttractor(Attractor);
+    MaxBlend.BlendOp = ERshipFieldBlendOp::Max;
+
+    FRshipFieldEffectorDesc Subtract = FRshipFieldEffectorDesc::FromAttractor(Attractor);
+    Subtract.BlendOp = ERshipFieldBlendOp::Subtract;
+
+    const FVector3f PathPoints[] = { FVector3f(-800.0f, 0.0f, 0.0f), FVector3f(800.0f, 400.0f, 0.0f) };
+    FRshipFieldPolyline Path;
+    Path.Build(PathPoints, false);
+    FRshipFieldSplineEffector Spline;
+    Spline.RadiusCm = 200.0f;
+
+    RshipFieldRDG::FGlobalDispatchInputs Inputs = MakeEmptyInputs(ERshipFieldResolution::Res64);
+    Path.Pack(Inputs.SplineNodeData, Inputs.SplineSegmentData);
+    RshipFieldRDG::PackEffectorInputs(Inputs, {}, {
+        FRshipFieldEffectorDesc::FromAttractor(Attractor),
+        FRshipFieldEffectorDesc::FromWave(Disabled),
+        FRshipFieldEffectorDesc::FromNoise(Infinite),
+        FRshipFieldEffectorDesc::FromRing(Ring),
+        FRshipFieldEffectorDesc::FromSpline(Spline),
+        Clamped,
+        MaxBlend,
+        Subtract });
+
+    const TArray<FRshipFieldEffectorTiles::FEffectorBounds> Bounds = FRshipFieldEffectorTiles::ComputeBounds(Inputs);
+    TestEqual(TEXT("One entry per effector"), Bounds.Num(), 8);
+
+    // Everything before the first order-sensitive effector stays global
+    TestTrue(TEXT("Additive before the first order-sensitive effector is global"), Bounds[0].Cull == ECull::Global);
+    TestTrue(TEXT("Disabled is skipped"), Bounds[1].Cull == ECull::Skipped);
+    TestTrue(TEXT("Infinite range is skipped"), Bounds[2].Cull == ECull::Skipped);
+    TestTrue(TEXT("Ring before it is global"), Bounds[3].Cull == ECull::Global);
+    TestTrue(TEXT("Clamp range without zero is global"), Bounds[5].Cull == ECull::Global);
+    TestTrue(TEXT("Max blend is global"), Bounds[6].Cull == ECull::Global);
+    TestTrue(TEXT("Subtract after it is bounded"), Bounds[7].Cull == ECull::Bounded);
+    TestEqual(TEXT("Sphere around the position"), Bounds[7].CenterCm, FVector3f(Attractor.PositionCm));
+    TestTrue(TEXT("Padded radius"), Bounds[7].SphereRadiusCm >= 300.0f && Bounds[7].SphereRadiusCm < 302.0f);
+
+    const FBox3f NearCorner(FVector3f(300.0f, 400.0f, 500.0f), FVector3f(400.0f, 500.0f, 600.0f));
+    TestFalse(TEXT("Sphere test is tighter than its box at the corner"), Bounds[7].Overlaps(NearCorner));
+    TestTrue(TEXT("Box would have overlapped"), Bounds[7].BoxCm.Intersect(NearCorner));
+    TestTrue(TEXT("Global overlaps anything"), Bounds[0].Overlaps(FBox3f(FVector3f(1e6f), FVector3f(1e6f + 1.0f))));
+    TestFalse(TEXT("Skipped overlaps nothing"), Bounds[1].Overlaps(FBox3f(FVector3f(-1e6f), FVector3f(1e6f))));
+
+    // Without the order-sensitive effectors, paths and rings get boxes
+    RshipFieldRDG::FGlobalDispatchInputs Additive = MakeEmptyInputs(ERshipFieldResolution::Res64);
+    Path.Pack(Additive.SplineNodeData, Additive.SplineSegmentData);
+    RshipFieldRDG::PackEffectorInputs(Additive, {}, { FRshipFieldEffectorDesc::FromRing(Ring), FRshipFieldEffectorDesc::FromSpline(Spline) });
+    const TArray<FRshipFieldEffectorTiles::FEffectorBounds> PathBounds = FRshipFieldEffectorTiles::ComputeBounds(Additive);
+
+    TestTrue(TEXT("Ring is bounded"), PathBounds[0].Cull == ECull::Bounded);
+    const FVector3f RingExtent = PathBounds[0].BoxCm.GetExtent();
+    TestTrue(TEXT("Ring box spans ring + tube in its plane"), RingExtent.X >= 600.0f && RingExtent.X < 605.0f && RingExtent.Y >= 600.0f && RingExtent.Y < 605.0f);
+    TestTrue(TEXT("Ring box is only the tube along its axis"), RingExtent.Z >= 100.0f && RingExtent.Z < 105.0f);
+
+    TestTrue(TEXT("Spline is bounded"), PathBounds[1].Cull == ECull::Bounded);
+    TestTrue(TEXT("Spline box is the path expanded by its radius"),
+        PathBounds[1].BoxCm.IsInside(FVector3f(-1000.0f, -200.0f, -200.0f)) && !PathBounds[1].BoxCm.IsInside(FVector3f(-1010.0f, 0.0f, 0.0f)));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldEffectorTilesBinningTest,
+    "Rship.Field.EffectorTiles.CulledMatchesUnculled",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldEffectorTilesBinningTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldEffectorTilesTests;
+
+    for (const int32 MultiplyIndex : { INDEX_NONE, 20 })
+    {
+        const RshipFieldRDG::FGlobalDispatchInputs Inputs = MakeSparseInputs(ERshipFieldResolution::Res64, 48, MultiplyIndex);
+        const FRshipFieldEffectorTiles& Tiles = Inputs.EffectorTiles;
+        TestTrue(TEXT("Built"), Tiles.IsBuiltFor(64));
+        TestEqual(TEXT("8 tiles per axis at 64^3"), Tiles.GetTilesPerAxis(), 8);
+        TestEqual(TEXT("Voxel to tile"), Tiles.GetTileIndex(63, 8, 17), (2 * 8 + 1) * 8 + 7);
+
+        int32 Unordered = 0;
+        for (int32 Tile = 0; Tile < Tiles.GetNumTiles(); ++Tile)
+        {
+            const TConstArrayView<uint32> List = Tiles.GetTileEffectors(Tile);
+            for (int32 i = 1; i < List.Num(); ++i)
+            {
+                Unordered += List[i] <= List[i - 1] ? 1 : 0;
+            }
+        }
+        TestEqual(TEXT("Lists ascend, so blend order is kept"), Unordered, 0);
+
+        const float AverageList = static_cast<float>(Tiles.GetIndices().Num()) / Tiles.GetNumTiles();
+        if (MultiplyIndex == INDEX_NONE)
+        {
+            TestTrue(*FString::Printf(TEXT("Sparse scene culls most effectors (%.1f of 50 per tile)"), AverageList), AverageList < 12.0f);
+        }
+        else
+        {
+            TestTrue(*FString::Printf(TEXT("Effectors before the Multiply are everywhere (%.1f per tile)"), AverageList), AverageList >= 21.0f);
+        }
+
+        // Bit-identical atlas with and without culling
+        const FRshipFieldCpuEvaluator Culled(Inputs);
+        const FRshipFieldCpuEvaluator Unculled(WithoutTiles(Inputs));
+        FRshipFieldCpuAtlas CulledAtlas;
+        FRshipFieldCpuAtlas UnculledAtlas;
+        Culled.BuildAtlas(CulledAtlas);
+        Unculled.BuildAtlas(UnculledAtlas);
+
+        int32 Mismatches = 0;
+        int32 NonZero = 0;
+        for (int32 i = 0; i < CulledAtlas.Scalar.Num(); ++i)
+        {
+            Mismatches += (CulledAtlas.Scalar[i] != UnculledAtlas.Scalar[i] || CulledAtlas.Vector[i] != UnculledAtlas.Vector[i]) ? 1 : 0;
+            NonZero += UnculledAtlas.Scalar[i] != 0.0f ? 1 : 0;
+        }
+        TestTrue(TEXT("Scene has signal"), NonZero > 1000);
+        TestEqual(*FString::Printf(TEXT("Culled atlas equals unculled (Multiply at %d)"), MultiplyIndex), Mismatches, 0);
+    }
+
+    // Tiles built for another resolution are ignored, not misread
+    RshipFieldRDG::FGlobalDispatchInputs Stale = MakeSparseInputs(ERshipFieldResolution::Res128, 16, INDEX_NONE);
+    Stale.FieldResolution = GetFieldResolutionValue(ERshipFieldResolution::Res64);
+    TestFalse(TEXT("Stale tiles"), Stale.EffectorTiles.IsBuiltFor(Stale.FieldResolution));
+    FRshipFieldCpuAtlas StaleAtlas;
+    FRshipFieldCpuAtlas FreshAtlas;
+    FRshipFieldCpuEvaluator(Stale).BuildAtlas(StaleAtlas);
+    FRshipFieldCpuEvaluator(WithoutTiles(Stale)).BuildAtlas(FreshAtlas);
+    TestTrue(TEXT("Falls back to every effector"), StaleAtlas.Scalar == FreshAtlas.Scalar);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldEffectorTilesBenchmark,
+    "Rship.Field.EffectorTiles.Benchmark",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FRshipFieldEffectorTilesBenchmark::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldEffectorTilesTests;
+
+    const ERshipFieldResolution Resolutions[] = { ERshipFieldResolution::Res64, ERshipFieldResolution::Res128 };
+    for (const ERshipFieldResolution Resolution : Resolutions)
+    {
+        for (const int32 NumEffectors : { 16, 64, 128 })
+        {
+            RshipFieldRDG::FGlobalDispatchInputs Inputs = MakeSparseInputs(Resolution, NumEffectors, INDEX_NONE);
+
+            double StartSeconds = FPlatformTime::Seconds();
+            Inputs.EffectorTiles.Build(Inputs);
+            const double BinMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+
+            const FRshipFieldCpuEvaluator Culled(Inputs);
+            const FRshipFieldCpuEvaluator Unculled(WithoutTiles(Inputs));
+            FRshipFieldCpuAtlas Atlas;
+
+            StartSeconds = FPlatformTime::Seconds();
+            Culled.BuildAtlas(Atlas);
+            const double CulledMs = FMath::Max(FPlatformTime::Seconds() - StartSeconds, 1e-9) * 1000.0;
+            const float Checksum = Atlas.Scalar[Atlas.Scalar.Num() / 2];
+
+            StartSeconds = FPlatformTime::Seconds();
+            Unculled.BuildAtlas(Atlas);
+            const double UnculledMs = FMath::Max(FPlatformTime::Seconds() - StartSeconds, 1e-9) * 1000.0;
+
+            TestTrue(TEXT("Built atlas"), CulledMs > 0.0);
+            AddInfo(FString::Printf(TEXT("%d^3, %d effectors: %.1f per tile, bin %.3f ms, culled %.2f ms, unculled %.2f ms (%.1fx) (checksum %.3f)"),
+                Inputs.FieldResolution, static_cast<int32>(Inputs.EffectorCount),
+                static_cast<float>(Inputs.EffectorTiles.GetIndices().Num()) / Inputs.EffectorTiles.GetNumTiles(),
+                BinMs, CulledMs, UnculledMs, UnculledMs / CulledMs, Checksum));
+        }
+    }
+
+    return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
@@ -0,0 +1,194 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "RshipFieldCpuEvaluator.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "RshipFieldTestInputs.h"
+
+namespace RshipFieldPointSampleTests
+{
+    // Every effector kind, plus a traveling wave with live shells and a named sync group.
+    RshipFieldRDG::FGlobalDispatchInputs MakeShowInputs()
+    {
+        FRshipFieldSyncGroup Group;
+        Group.Id = TEXT("half");
+        Group.TempoMultiplier = 0.5f;
+        Group.PhaseOffset = 0.25f;
+
+        FRshipFieldWaveEffector Standing;
+        Standing.Waveform = ERshipFieldWaveform::Triangle;
+        Standing.RadiusCm = 1200.0f;
+        Standing.SyncGroup = Group.Id;
+
+        FRshipFieldWaveEffector Traveling;
+        Traveling.WaveMode = ERshipFieldWaveMode::Traveling;
+        Traveling.PositionCm = FVector(200.0f, -100.0f, 0.0f);
+        Traveling.RadiusCm = 1500.0f;
+        FRshipFieldEffectorDesc TravelingDesc = FRshipFieldEffectorDesc::FromWave(Traveling);
+        TravelingDesc.WavefrontCount = 2;
+
+        FRshipFieldNoiseEffector Noise;
+        Noise.NoiseMode = ERshipFieldNoiseMode::Curl;
+        Noise.RadiusCm = 1500.0f;
+        Noise.Scale = 0.004f;
+
+        FRshipFieldAttractorEffector Attractor;
+        Attractor.PositionCm = FVector(-300.0f, 250.0f, 100.0f);
+        Attractor.RadiusCm = 900.0f;
+        Attractor.FalloffExponent = 2.0f;
+
+        RshipFieldRDG::FGlobalDispatchInputs Inputs = RshipFieldTestInputs::MakeEmptyInputs(ERshipFieldResolution::Res64, RshipFieldTestInputs::RoomHalfExtentCm);
+        Inputs.TimeSeconds = 2.0f;
+        Inputs.TransportPhase = 1.3f;
+        Inputs.MasterScalarGain = 1.5f;
+        Inputs.MasterVectorGain = 0.75f;
+        Inputs.WavefrontData = { FVector4f(1.8f, 200.0f, -100.0f, 0.0f), FVector4f(1.2f, 200.0f, -100.0f, 0.0f) };
+        RshipFieldRDG::PackEffectorInputs(Inputs, { Group }, {
+            FRshipFieldEffectorDesc::FromWave(Standing),
+            TravelingDesc,
+            FRshipFieldEffectorDesc::FromNoise(Noise),
+            FRshipFieldEffectorDesc::FromAttractor(Attractor) });
+        return Inputs;
+    }
+
+    void AddRandomPositions(FRshipFieldPointBatch& Batch, int32 Count, int32 Seed)
+    {
+        FRandomStream Random(Seed);
+        for (int32 i = 0; i < Count; ++i)
+        {
+            Batch.Add(RshipFieldTestInputs::RandomPosition(Random, RshipFieldTestInputs::RoomHalfExtentCm));
+        }
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldPointSampleAtlasTest,
+    "Rship.Field.PointSample.MatchesAtlas",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldPointSampleAtlasTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldPointSampleTests;
+
+    const FRshipFieldCpuEvaluator Evaluator(MakeShowInputs());
+    FRshipFieldCpuAtlas Atlas;
+    Evaluator.BuildAtlas(Atlas);
+
+    // Odd count so the last group runs through the padded tail
+    FRandomStream Random(7);
+    TArray<FIntVector> Voxels;
+    FRshipFieldPointBatch Batch;
+    for (int32 i = 0; i < 1001; ++i)
+    {
+        const FIntVector& Voxel = Voxels.Add_GetRef(FIntVector(Random.RandHelper(64), Random.RandHelper(64), Random.RandHelper(64)));
+        Batch.Add(FVector(Evaluator.GetVoxelCenter(Voxel.X, Voxel.Y, Voxel.Z)));
+    }
+    Evaluator.EvaluatePoints(Batch);
+
+    TestEqual(TEXT("One result per point"), Batch.Scalar.Num(), Batch.Num());
+
+    int32 Mismatches = 0;
+    for (int32 i = 0; i < Voxels.Num(); ++i)
+    {
+        const int32 Index = Atlas.GetAtlasIndex(Voxels[i].X, Voxels[i].Y, Voxels[i].Z);
+        const FVector4f Expected = Atlas.Vector[Index];
+        if (Batch.Scalar[i] != Atlas.Scalar[Index]
+            || Batch.VectorX[i] != Expected.X
+            || Batch.VectorY[i] != Expected.Y
+            || Batch.VectorZ[i] != Expected.Z)
+        {
+            ++Mismatches;
+        }
+    }
+    TestEqual(TEXT("Point samples at voxel centers equal the atlas exactly"), Mismatches, 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldPointSampleOffGridTest,
+    "Rship.Field.PointSample.OffGrid",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldPointSampleOffGridTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldPointSampleTests;
+
+    const FRshipFieldCpuEvaluator Evaluator(MakeShowInputs());
+
+    // Every tail length, and batches large enough to split across tasks
+    const int32 Counts[] = { 1, 2, 3, 4, 5, 4099 };
+    for (const int32 Count : Counts)
+    {
+        FRshipFieldPointBatch Batch;
+        AddRandomPositions(Batch, Count, Count);
+        Evaluator.EvaluatePoints(Batch);
+
+        int32 Mismatches = 0;
+        for (int32 i = 0; i < Count; ++i)
+        {
+            float Scalar = 0.0f;
+            FVector3f Vector;
+            Evaluator.EvaluateAtPosition(FVector3f(Batch.PositionX[i], Batch.PositionY[i], Batch.PositionZ[i]), false, Scalar, Vector);
+            if (Batch.Scalar[i] != Scalar * 1.5f || Batch.GetVector(i) != FVector(Vector * 0.75f))
+            {
+                ++Mismatches;
+            }
+        }
+        TestEqual(*FString::Printf(TEXT("%d points match single-point evaluation"), Count), Mismatches, 0);
+    }
+
+    // Reset keeps capacity for the next tick's samplers
+    FRshipFieldPointBatch Batch;
+    AddRandomPositions(Batch, 64, 1);
+    Evaluator.EvaluatePoints(Batch);
+    const float* Storage = Batch.Scalar.GetData();
+    Batch.Reset();
+    TestEqual(TEXT("Reset empties the batch"), Batch.Num(), 0);
+    AddRandomPositions(Batch, 64, 2);
+    Evaluator.EvaluatePoints(Batch);
+    TestTrue(TEXT("Results reuse their allocation"), Batch.Scalar.GetData() == Storage);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldPointSampleBenchmark,
+    "Rship.Field.PointSample.Benchmark",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FRshipFieldPointSampleBenchmark::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldPointSampleTests;
+
+    const FRshipFieldCpuEvaluator Evaluator(MakeShowInputs());
+
+    constexpr int32 Iterations = 20;
+    const int32 SamplerCounts[] = { 1000, 5000, 10000, 25000, 50000 };
+    for (const int32 NumSamplers : SamplerCounts)
+    {
+        FRshipFieldPointBatch Batch;
+        AddRandomPositions(Batch, NumSamplers, NumSamplers);
+        Evaluator.EvaluatePoints(Batch);
+
+        const double StartSeconds = FPlatformTime::Seconds();
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            Evaluator.EvaluatePoints(Batch);
+        }
+        const double ElapsedSeconds = FMath::Max(FPlatformTime::Seconds() - StartSeconds, 1e-9);
+
+        const double TickMs = ElapsedSeconds / Iterations * 1000.0;
+        TestTrue(TEXT("Evaluated samplers"), TickMs > 0.0);
+        AddInfo(FString::Printf(TEXT("%d samplers: %.3f ms per tick, %.1f Msamples/s (checksum %.3f)"),
+            NumSamplers, TickMs, NumSamplers / (TickMs * 1000.0), Batch.Scalar[NumSamplers / 2]));
+    }
+
+    return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
@@ -0,0 +1,167 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "RshipFieldQuery.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Math/RandomStream.h"
+#include "RshipFieldComponent.h"
+#include "RshipFieldCpuEvaluator.h"
+#include "RshipFieldShaders.h"
+#include "RshipFieldSimulation.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace RshipFieldQueryTests
+{
+    constexpr float ScalarGain = 0.75f;
+    constexpr float VectorGain = 1.5f;
+
+    // A few stepped effectors of every kind, with gains so results are checked gains applied.
+    TSharedPtr<const FRshipFieldCpuEvaluator> MakeEvaluator()
+    {
+        TStrongObjectPtr<URshipFieldComponent> Field(NewObject<URshipFieldComponent>(GetTransientPackage(), NAME_None, RF_Transient));
+        Field->FieldResolution = ERshipFieldResolution::Res32;
+        Field->DomainSizeCm = 3000.0f;
+        Field->MasterScalarGain = ScalarGain;
+        Field->MasterVectorGain = VectorGain;
+
+        FRshipFieldWaveEffector& Traveling = Field->WaveEffectors.AddDefaulted_GetRef();
+        Traveling.WaveMode = ERshipFieldWaveMode::Traveling;
+        Traveling.RepeatHz = 6.0f;
+        Traveling.RadiusCm = 1200.0f;
+        Field->WaveEffectors.AddDefaulted_GetRef().PositionCm = FVector(-500.0, 300.0, 100.0);
+        Field->NoiseEffectors.AddDefaulted_GetRef().RadiusCm = 900.0f;
+        Field->AttractorEffectors.AddDefaulted_GetRef().PositionCm = FVector(400.0, -400.0, 0.0);
+        Field->SplineEffectors.AddDefaulted_GetRef().PointsCm = { FVector(-1000.0, -1000.0, 0.0), FVector(1000.0, -800.0, 0.0) };
+        Field->RingEffectors.AddDefaulted_GetRef().RingRadiusCm = 700.0f;
+
+        for (int32 Step = 0; Step < 20; ++Step)
+        {
+            RshipFieldSimulation::Step(*Field);
+        }
+
+        RshipFieldRDG::FGlobalDispatchInputs Inputs;
+        RshipFieldSimulation::BuildGlobalInputs(*Field, Inputs);
+        return MakeShared<FRshipFieldCpuEvaluator>(Inputs);
+    }
+
+    FVector3f GetAtlasVector(const FRshipFieldCpuAtlas& Atlas, int32 X, int32 Y, int32 Z)
+    {
+        const FVector4f& Texel = Atlas.Vector[Atlas.GetAtlasIndex(X, Y, Z)];
+        return FVector3f(Texel.X, Texel.Y, Texel.Z);
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldQueryBatchTest,
+    "Rship.Field.Query.BatchMatchesAtlas",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldQueryBatchTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldQueryTests;
+
+    const TSharedPtr<const FRshipFieldCpuEvaluator> Evaluator = MakeEvaluator();
+    FRshipFieldCpuAtlas Atlas;
+    Evaluator->BuildAtlas(Atlas);
+    const int32 Resolution = Atlas.FieldResolution;
+
+    // Voxel centers, read back where the GPU atlas stores them (AtlasCoordFromVoxel)
+    TArray<FIntVector> Voxels;
+    FRandomStream Random(40);
+    for (int32 i = 0; i < 61; ++i)
+    {
+        Voxels.Add(FIntVector(Random.RandHelper(Resolution), Random.RandHelper(Resolution), Random.RandHelper(Resolution)));
+    }
+    Voxels.Add(FIntVector(0, 0, 0));
+    Voxels.Add(FIntVector(Resolution - 1, Resolution - 1, Resolution - 1));
+    TArray<FVector> VoxelCenters;
+    for (const FIntVector& Voxel : Voxels)
+    {
+        VoxelCenters.Add(FVector(Evaluator->GetVoxelCenter(Voxel.X, Voxel.Y, Voxel.Z)));
+    }
+
+    // Arbitrary points, between voxels and outside the domain
+    TArray<FVector> Points;
+    for (int32 i = 0; i < 37; ++i)
+    {
+        Points.Add(FVector(Random.FRandRange(-2000.0f, 2000.0f), Random.FRandRange(-2000.0f, 2000.0f), Random.FRandRange(-2000.0f, 2000.0f)));
+    }
+
+    // Queries of any size, an empty one among them, share one batch
+    FRshipFieldQueryQueue Queue;
+    TFuture<FRshipFieldQueryResult> VoxelQuery = Queue.Submit(VoxelCenters);
+    TFuture<FRshipFieldQueryResult> EmptyQuery = Queue.Submit(TArray<FVector>());
+    TFuture<FRshipFieldQueryResult> PointQuery = Queue.Submit(Points);
+    TestEqual(TEXT("Queued until flushed"), Queue.GetNumPending(), 3);
+    TestFalse(TEXT("Nothing evaluated before the flush"), VoxelQuery.IsReady());
+
+    TestEqual(TEXT("No evaluator, nothing launched"), Queue.Flush(nullptr), 0);
+    TestEqual(TEXT("Still queued"), Queue.GetNumPending(), 3);
+
+    TestEqual(TEXT("Every point launched"), Queue.Flush(Evaluator), VoxelCenters.Num() + Points.Num());
+    TestEqual(TEXT("Queue emptied"), Queue.GetNumPending(), 0);
+
+    const FRshipFieldQueryResult VoxelResult = VoxelQuery.Get();
+    const FRshipFieldQueryResult EmptyResult = EmptyQuery.Get();
+    const FRshipFieldQueryResult PointResult = PointQuery.Get();
+    TestTrue(TEXT("Empty query fulfilled"), EmptyResult.bValid && EmptyResult.Num() == 0);
+
+    if (!TestTrue(TEXT("Voxel query results"), VoxelResult.bValid && VoxelResult.Num() == VoxelCenters.Num()))
+    {
+        return false;
+    }
+    for (int32 i = 0; i < Voxels.Num(); ++i)
+    {
+        const FIntVector& Voxel = Voxels[i];
+        TestEqual(FString::Printf(TEXT("Scalar at voxel (%d, %d, %d) matches its atlas texel"), Voxel.X, Voxel.Y, Voxel.Z),
+            VoxelResult.Scalar[i], Atlas.Scalar[Atlas.GetAtlasIndex(Voxel.X, Voxel.Y, Voxel.Z)]);
+        TestTrue(FString::Printf(TEXT("Vector at voxel (%d, %d, %d) matches its atlas texel"), Voxel.X, Voxel.Y, Voxel.Z),
+            VoxelResult.Vector[i] == GetAtlasVector(Atlas, Voxel.X, Voxel.Y, Voxel.Z));
+    }
+
+    if (!TestTrue(TEXT("Point query results"), PointResult.bValid && PointResult.Num() == Points.Num()))
+    {
+        return false;
+    }
+    for (int32 i = 0; i < Points.Num(); ++i)
+    {
+        float Scalar = 0.0f;
+        FVector3f Vector = FVector3f::ZeroVector;
+        Evaluator->EvaluateAtPosition(FVector3f(Points[i]), false, Scalar, Vector);
+        TestEqual(TEXT("Scalar at an arbitrary point"), PointResult.Scalar[i], Scalar * ScalarGain, 1e-4f);
+        TestTrue(TEXT("Vector at an arbitrary point"), PointResult.Vector[i].Equals(Vector * VectorGain, 1e-4f));
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldQueryCancelTest,
+    "Rship.Field.Query.Cancel",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldQueryCancelTest::RunTest(const FString& Parameters)
+{
+    TFuture<FRshipFieldQueryResult> Cancelled;
+    TFuture<FRshipFieldQueryResult> Dropped;
+    {
+        FRshipFieldQueryQueue Queue;
+        Cancelled = Queue.Submit({ FVector::ZeroVector });
+        Queue.Cancel();
+        TestTrue(TEXT("Cancel fulfils the query"), Cancelled.IsReady());
+        TestFalse(TEXT("Cancelled result is invalid"), Cancelled.Get().bValid);
+
+        // A queue destroyed with queries pending, as when a field is unregistered
+        Dropped = Queue.Submit({ FVector::ZeroVector, FVector::OneVector });
+    }
+    TestTrue(TEXT("Dropped query fulfilled"), Dropped.IsReady());
+    TestFalse(TEXT("Dropped result is invalid"), Dropped.Get().bValid);
+    TestEqual(TEXT("Dropped result is empty"), Dropped.Get().Num(), 0);
+
+    return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
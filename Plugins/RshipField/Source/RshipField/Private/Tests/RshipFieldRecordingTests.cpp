@@ -0,0 +1,246 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "RshipFieldRecording.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/Crc.h"
+#include "RshipFieldComponent.h"
+#include "RshipFieldCpuEvaluator.h"
+#include "RshipFieldShaders.h"
+#include "RshipFieldSimulation.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/Package.h"
+
+namespace RshipFieldRecordingTests
+{
+    constexpr int32 NumSteps = 24;
+    constexpr int32 KeyframeInterval = 8;
+
+    uint32 HashAtlas(const FRshipFieldCpuAtlas& Atlas)
+    {
+        const uint32 ScalarHash = FCrc::MemCrc32(Atlas.Scalar.GetData(), Atlas.Scalar.Num() * static_cast<int32>(sizeof(float)));
+        return FCrc::MemCrc32(Atlas.Vector.GetData(), Atlas.Vector.Num() * static_cast<int32>(sizeof(FVector4f)), ScalarHash);
+    }
+
+    bool AtlasesIdentical(const FRshipFieldCpuAtlas& A, const FRshipFieldCpuAtlas& B)
+    {
+        return A.Scalar.Num() == B.Scalar.Num() && A.Vector.Num() == B.Vector.Num()
+            && FMemory::Memcmp(A.Scalar.GetData(), B.Scalar.GetData(), A.Scalar.Num() * sizeof(float)) == 0
+            && FMemory::Memcmp(A.Vector.GetData(), B.Vector.GetData(), A.Vector.Num() * sizeof(FVector4f)) == 0;
+    }
+
+    uint32 HashLiveAtlas(URshipFieldComponent& Field)
+    {
+        RshipFieldRDG::FGlobalDispatchInputs Inputs;
+        RshipFieldSimulation::BuildGlobalInputs(Field, Inputs);
+        FRshipFieldCpuAtlas Atlas;
+        FRshipFieldCpuEvaluator(Inputs).BuildAtlas(Atlas);
+        return HashAtlas(Atlas);
+    }
+
+    // A short show: every effector type, auto-emitting and manually triggered traveling waves,
+    // a tempo-synced wave, and edits, transport changes and effectors added and removed between
+    // steps, the way the subsystem would run it. LiveHashes[S] is the atlas of state S.
+    struct FRecordedShow
+    {
+        FRshipFieldRecording Recording;
+        TArray<uint32> LiveHashes;
+    };
+
+    FRecordedShow RecordShow()
+    {
+        TStrongObjectPtr<URshipFieldComponent> Field(NewObject<URshipFieldComponent>(GetTransientPackage(), NAME_None, RF_Transient));
+        Field->FieldResolution = ERshipFieldResolution::Res64;
+        Field->DomainSizeCm = 4000.0f;
+        Field->UpdateHz = 30.0f;
+        Field->SyncGroups.AddDefaulted_GetRef().Id = TEXT("Beat");
+
+        FRshipFieldWaveEffector& AutoWave = Field->WaveEffectors.AddDefaulted_GetRef();
+        AutoWave.WaveMode = ERshipFieldWaveMode::Traveling;
+        AutoWave.RepeatHz = 4.0f;
+        AutoWave.WaveSpeedCmPerSec = 1500.0f;
+        AutoWave.RadiusCm = 1500.0f;
+
+        FRshipFieldWaveEffector& ManualWave = Field->WaveEffectors.AddDefaulted_GetRef();
+        ManualWave.WaveMode = ERshipFieldWaveMode::Traveling;
+        ManualWave.bAutoEmit = false;
+        ManualWave.PositionCm = FVector(-800.0, 400.0, 0.0);
+        ManualWave.WaveSpeedCmPerSec = 2000.0f;
+
+        FRshipFieldWaveEffector& SyncedWave = Field->WaveEffectors.AddDefaulted_GetRef();
+        SyncedWave.PositionCm = FVector(600.0, -600.0, 300.0);
+        SyncedWave.SyncGroup = TEXT("Beat");
+
+        FRshipFieldNoiseEffector& Noise = Field->NoiseEffectors.AddDefaulted_GetRef();
+        Noise.PositionCm = FVector(0.0, 900.0, -400.0);
+        Noise.RadiusCm = 700.0f;
+
+        FRshipFieldAttractorEffector& Attractor = Field->AttractorEffectors.AddDefaulted_GetRef();
+        Attractor.PositionCm = FVector(500.0, 500.0, 0.0);
+        Attractor.RadiusCm = 800.0f;
+
+        FRshipFieldSplineEffector& Spline = Field->SplineEffectors.AddDefaulted_GetRef();
+        Spline.PointsCm = { FVector(-1500.0, -1500.0, 0.0), FVector(0.0, -1000.0, 200.0), FVector(1500.0, -1500.0, 0.0) };
+
+        FRecordedShow Show;
+        Field->Recorder = MakeShared<FRshipFieldRecorder>(*Field, KeyframeInterval);
+        Show.LiveHashes.Add(HashLiveAtlas(*Field));
+
+        for (int32 Step = 0; Step < NumSteps; ++Step)
+        {
+            switch (Step)
+            {
+            case 3:
+                Field->EmitWavefront(1);
+                break;
+            case 5:
+                Field->AttractorEffectors[0].PositionCm += FVector(-300.0, 100.0, 50.0);
+                Field->EmitWavefront(1);
+                break;
+            case 7:
+                Field->SetTransportAction(0.25f, false);
+                break;
+            case 10:
+                Field->SetBpmAction(128.0f);
+                Field->SetTransportAction(0.5f, true);
+                break;
+            case 12:
+                Field->RingEffectors.AddDefaulted_GetRef().RingRadiusCm = 900.0f;
+                Field->WaveEffectors[1].bEmitOnce = true;
+                break;
+            case 15:
+                // Moved then triggered: the wavefront must be born at the new position
+                Field->WaveEffectors[1].PositionCm = FVector(700.0, 0.0, -200.0);
+                Field->EmitWavefront(1);
+                Field->SplineEffectors[0].bClosedLoop = true;
+                break;
+            case 18:
+                Field->NoiseEffectors.RemoveAt(0);
+                Field->SetMasterScalarGainAction(0.5f);
+                break;
+            default:
+                break;
+            }
+
+            Field->Recorder->BeginStep(*Field);
+            RshipFieldSimulation::Step(*Field);
+            Field->Recorder->EndStep(*Field);
+            Show.LiveHashes.Add(HashLiveAtlas(*Field));
+        }
+
+        Show.Recording = Field->Recorder->GetRecording();
+        Field->Recorder.Reset();
+        return Show;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldRecordingReplayTest,
+    "Rship.Field.Recording.ReplayIsBitIdentical",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldRecordingReplayTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldRecordingTests;
+
+    const FRecordedShow Show = RecordShow();
+    TestEqual(TEXT("Every step recorded"), Show.Recording.GetNumSteps(), NumSteps);
+    TestEqual(TEXT("Keyframes at state 0 and every interval"), Show.Recording.Keyframes.Num(), NumSteps / KeyframeInterval + 1);
+
+    FRshipFieldReplayer First(Show.Recording);
+    FRshipFieldReplayer Second(Show.Recording);
+    FRshipFieldCpuAtlas FirstAtlas;
+    FRshipFieldCpuAtlas SecondAtlas;
+
+    for (int32 Step = 0; Step <= NumSteps; ++Step)
+    {
+        if (Step > 0)
+        {
+            TestTrue(TEXT("First replay steps"), First.StepForward());
+            TestTrue(TEXT("Second replay steps"), Second.StepForward());
+        }
+        First.BuildAtlas(FirstAtlas);
+        Second.BuildAtlas(SecondAtlas);
+
+        TestTrue(FString::Printf(TEXT("Replays bit-identical at step %d"), Step), AtlasesIdentical(FirstAtlas, SecondAtlas));
+        TestEqual(FString::Printf(TEXT("Replay matches the live run at step %d"), Step), HashAtlas(FirstAtlas), Show.LiveHashes[Step]);
+    }
+    TestFalse(TEXT("Stops at the end of the recording"), First.StepForward());
+    TestEqual(TEXT("Ring added mid-show"), First.GetField().RingEffectors.Num(), 1);
+    TestEqual(TEXT("Noise removed mid-show"), First.GetField().NoiseEffectors.Num(), 0);
+    TestTrue(TEXT("Manual wavefronts replayed"), First.GetField().WaveEffectorStates[1].Wavefronts.Num() > 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldRecordingSeekTest,
+    "Rship.Field.Recording.Seek",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldRecordingSeekTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldRecordingTests;
+
+    const FRecordedShow Show = RecordShow();
+    FRshipFieldReplayer Replayer(Show.Recording);
+    FRshipFieldCpuAtlas Atlas;
+
+    // Forward within an interval, back across keyframes, onto a keyframe, and past the end
+    const int32 Targets[] = { 5, 19, 2, KeyframeInterval * 2, 23, 0, NumSteps + 10 };
+    for (const int32 Target : Targets)
+    {
+        Replayer.Seek(Target);
+        const int32 Expected = FMath::Min(Target, NumSteps);
+        TestEqual(TEXT("Lands on the target step"), Replayer.GetCurrentStep(), Expected);
+
+        Replayer.BuildAtlas(Atlas);
+        TestEqual(FString::Printf(TEXT("Seek to %d matches sequential replay"), Target), HashAtlas(Atlas), Show.LiveHashes[Expected]);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldRecordingSerializeTest,
+    "Rship.Field.Recording.Serialize",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldRecordingSerializeTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldRecordingTests;
+
+    FRecordedShow Show = RecordShow();
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes, true);
+    Writer << Show.Recording;
+
+    FRshipFieldRecording Loaded;
+    FMemoryReader Reader(Bytes, true);
+    Reader << Loaded;
+    TestFalse(TEXT("Loads"), Reader.IsError());
+    TestTrue(TEXT("Property names"), Loaded.PropertyNames == Show.Recording.PropertyNames);
+    TestEqual(TEXT("Keyframe interval"), Loaded.KeyframeInterval, KeyframeInterval);
+    TestTrue(TEXT("Events"), Loaded.StepEvents == Show.Recording.StepEvents);
+    TestTrue(TEXT("Keyframes"), Loaded.Keyframes == Show.Recording.Keyframes);
+
+    FRshipFieldReplayer Replayer(MoveTemp(Loaded));
+    Replayer.Seek(NumSteps);
+    FRshipFieldCpuAtlas Atlas;
+    Replayer.BuildAtlas(Atlas);
+    TestEqual(TEXT("Loaded recording replays to the live atlas"), HashAtlas(Atlas), Show.LiveHashes[NumSteps]);
+
+    // Anything but a recording is rejected
+    Bytes[0] ^= 0xFF;
+    FRshipFieldRecording Corrupt;
+    FMemoryReader CorruptReader(Bytes, true);
+    CorruptReader << Corrupt;
+    TestTrue(TEXT("Bad magic fails the archive"), CorruptReader.IsError());
+
+    return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
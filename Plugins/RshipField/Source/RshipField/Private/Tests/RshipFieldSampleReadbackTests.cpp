@@ -0,0 +1,208 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "RshipFieldSampleReadback.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "UObject/Package.h"
+
+namespace RshipFieldSampleReadbackTests
+{
+    TArray<FObjectKey> MakeSamplers(int32 Count)
+    {
+        TArray<FObjectKey> Samplers;
+        for (int32 i = 0; i < Count; ++i)
+        {
+            Samplers.Add(FObjectKey(NewObject<UObject>(GetTransientPackage())));
+        }
+        return Samplers;
+    }
+
+    void SyncFrame(FRshipFieldSampleSlots& Slots, TConstArrayView<FObjectKey> Live)
+    {
+        Slots.BeginFrame();
+        for (const FObjectKey& Sampler : Live)
+        {
+            Slots.Acquire(Sampler);
+        }
+        Slots.EndFrame();
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldSampleSlotsTest,
+    "Rship.Field.SampleReadback.StableSlots",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldSampleSlotsTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldSampleReadbackTests;
+
+    const TArray<FObjectKey> Samplers = MakeSamplers(4);
+    FRshipFieldSampleSlots Slots(4);
+
+    SyncFrame(Slots, { Samplers[0], Samplers[1], Samplers[2] });
+    TestEqual(TEXT("First sampler"), Slots.Find(Samplers[0]), 0);
+    TestEqual(TEXT("Third sampler"), Slots.Find(Samplers[2]), 2);
+
+    // Registration order changes and a sampler disappears: the survivors keep their slots
+    const uint32 HeldGeneration = Slots.GetGeneration(1);
+    const int32 Released = [&]
+    {
+        Slots.BeginFrame();
+        Slots.Acquire(Samplers[2]);
+        Slots.Acquire(Samplers[0]);
+        return Slots.EndFrame();
+    }();
+    TestEqual(TEXT("Missing sampler released"), Released, 1);
+    TestEqual(TEXT("Survivor keeps slot 0"), Slots.Find(Samplers[0]), 0);
+    TestEqual(TEXT("Survivor keeps slot 2"), Slots.Find(Samplers[2]), 2);
+    TestFalse(TEXT("Released slot is free"), Slots.IsUsed(1));
+    TestEqual(TEXT("Released slot bumps its generation"), Slots.GetGeneration(1), HeldGeneration + 1);
+
+    // A new sampler reuses the hole instead of growing the dispatch
+    SyncFrame(Slots, { Samplers[0], Samplers[2], Samplers[3] });
+    TestEqual(TEXT("Hole reused"), Slots.Find(Samplers[3]), 1);
+    TestEqual(TEXT("Dispatch size unchanged"), Slots.GetNumSlots(), 3);
+    TestTrue(TEXT("New owner"), Slots.GetOwner(1) == Samplers[3]);
+    TestEqual(TEXT("Reuse bumps it again"), Slots.GetGeneration(1), HeldGeneration + 2);
+
+    TestTrue(TEXT("Explicit release"), Slots.Release(Samplers[3]));
+    TestFalse(TEXT("Releasing twice is a no-op"), Slots.Release(Samplers[3]));
+    TestEqual(TEXT("Used slots"), Slots.GetNumUsed(), 2);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldSampleCapacityTest,
+    "Rship.Field.SampleReadback.CapacityDoubling",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldSampleCapacityTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldSampleReadbackTests;
+
+    const TArray<FObjectKey> Samplers = MakeSamplers(200);
+    FRshipFieldSampleSlots Slots(64);
+    TestEqual(TEXT("Minimum capacity"), Slots.GetCapacity(), 64);
+
+    // Growing one sampler at a time reallocates only at powers of two
+    int32 Reallocations = 0;
+    int32 LastCapacity = Slots.GetCapacity();
+    for (int32 Count = 1; Count <= Samplers.Num(); ++Count)
+    {
+        SyncFrame(Slots, TConstArrayView<FObjectKey>(Samplers.GetData(), Count));
+        if (Slots.GetCapacity() != LastCapacity)
+        {
+            ++Reallocations;
+            LastCapacity = Slots.GetCapacity();
+        }
+    }
+    TestEqual(TEXT("Capacity after 200 samplers"), Slots.GetCapacity(), 256);
+    TestEqual(TEXT("Reallocations: 64 -> 128 -> 256"), Reallocations, 2);
+
+    // Shrinking the sampler set keeps the buffer
+    SyncFrame(Slots, TConstArrayView<FObjectKey>(Samplers.GetData(), 10));
+    TestEqual(TEXT("Capacity never shrinks"), Slots.GetCapacity(), 256);
+    TestEqual(TEXT("Used slots"), Slots.GetNumUsed(), 10);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldReadbackRingTest,
+    "Rship.Field.SampleReadback.RingLatency",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldReadbackRingTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldSampleReadbackTests;
+
+    const TArray<FObjectKey> Samplers = MakeSamplers(2);
+    FRshipFieldSampleSlots Slots;
+    SyncFrame(Slots, Samplers);
+
+    FRshipFieldReadbackRing Ring;
+    TestEqual(TEXT("Three readbacks"), Ring.GetDepth(), 3);
+    TestEqual(TEXT("Nothing in flight"), Ring.GetOldest(), INDEX_NONE);
+
+    TestEqual(TEXT("Frame 10 submit"), Ring.Submit(10, Slots), 0);
+    TestEqual(TEXT("Frame 11 submit"), Ring.Submit(11, Slots), 1);
+    TestEqual(TEXT("Frame 12 submit"), Ring.Submit(12, Slots), 2);
+    TestEqual(TEXT("Ring full: frame 13 skips instead of stalling"), Ring.Submit(13, Slots), INDEX_NONE);
+    TestEqual(TEXT("Dropped submits"), Ring.GetNumDropped(), 1);
+    TestEqual(TEXT("Samples per entry"), Ring.GetNumSamples(0), 2);
+
+    // GPU finishes the first readback two frames later
+    TestEqual(TEXT("Oldest first"), Ring.GetOldest(), 0);
+    TestEqual(TEXT("Latency"), Ring.Complete(0, 12), 2);
+    TestEqual(TEXT("In flight"), Ring.GetNumInFlight(), 2);
+
+    // The freed entry is reused after the ones still in flight
+    TestEqual(TEXT("Wraps to entry 0"), Ring.Submit(13, Slots), 0);
+    TestEqual(TEXT("Next oldest"), Ring.GetOldest(), 1);
+    TestEqual(TEXT("One frame late"), Ring.Complete(1, 12), 1);
+    TestEqual(TEXT("Then entry 2"), Ring.GetOldest(), 2);
+    Ring.Complete(2, 14);
+    TestEqual(TEXT("Then the wrapped entry"), Ring.GetOldest(), 0);
+    TestEqual(TEXT("Last latency"), Ring.Complete(0, 15), 2);
+    TestEqual(TEXT("Drained"), Ring.GetNumInFlight(), 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldReadbackChurnTest,
+    "Rship.Field.SampleReadback.RegistrationChurn",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldReadbackChurnTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldSampleReadbackTests;
+
+    const TArray<FObjectKey> Samplers = MakeSamplers(5);
+    FRshipFieldSampleSlots Slots;
+    FRshipFieldReadbackRing Ring;
+
+    SyncFrame(Slots, { Samplers[0], Samplers[1], Samplers[2] });
+    const int32 Before = Ring.Submit(1, Slots);
+
+    // Between submit and readback: sampler 1 unregisters and sampler 3 takes its slot
+    SyncFrame(Slots, { Samplers[0], Samplers[2], Samplers[3] });
+    const int32 After = Ring.Submit(2, Slots);
+    TestEqual(TEXT("Sampler 3 reuses slot 1"), Slots.Find(Samplers[3]), 1);
+
+    TestTrue(TEXT("Untouched sampler applies"), Ring.IsSlotCurrent(Before, 0, Slots));
+    TestTrue(TEXT("Untouched sampler applies"), Ring.IsSlotCurrent(Before, 2, Slots));
+    TestFalse(TEXT("Old result for the reused slot is dropped"), Ring.IsSlotCurrent(Before, 1, Slots));
+    Ring.Complete(Before, 3);
+
+    TestTrue(TEXT("Newer readback belongs to the new owner"), Ring.IsSlotCurrent(After, 1, Slots));
+
+    // Sampler 2 goes away entirely: its pending result has nowhere to land
+    SyncFrame(Slots, { Samplers[0], Samplers[3] });
+    TestFalse(TEXT("Removed sampler's result is dropped"), Ring.IsSlotCurrent(After, 2, Slots));
+
+    // A slot added after submission was never sampled by that readback
+    SyncFrame(Slots, { Samplers[0], Samplers[3], Samplers[1], Samplers[2] });
+    TestEqual(TEXT("Dispatch grew"), Slots.GetNumSlots(), 4);
+    TestFalse(TEXT("Slot beyond the submitted range"), Ring.IsSlotCurrent(After, 3, Slots));
+    Ring.Complete(After, 4);
+
+    // Sampler 2 releases and a readback goes out the same frame, sampling its stale position
+    TestTrue(TEXT("Release"), Slots.Release(Samplers[2]));
+    const int32 WhileFree = Ring.Submit(5, Slots);
+
+    // Next frame a different sampler takes the free slot before that readback lands
+    SyncFrame(Slots, { Samplers[0], Samplers[3], Samplers[1], Samplers[4] });
+    TestEqual(TEXT("Sampler 4 reuses slot 3"), Slots.Find(Samplers[4]), 3);
+    TestTrue(TEXT("Untouched sampler applies"), Ring.IsSlotCurrent(WhileFree, 0, Slots));
+    TestFalse(TEXT("Result sampled while the slot was free is dropped"), Ring.IsSlotCurrent(WhileFree, 3, Slots));
+    Ring.Complete(WhileFree, 6);
+
+    return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
@@ -0,0 +1,298 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "RshipFieldPolyline.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "RshipFieldCpuEvaluator.h"
+#include "RshipFieldTestInputs.h"
+
+namespace RshipFieldSplineTests
+{
+    // A wandering path: each point a short random step from the last, so segments cluster
+    // and overlap the way a hand-drawn spline does.
+    TArray<FVector3f> MakeRandomWalk(int32 NumPoints, int32 Seed)
+    {
+        FRandomStream Random(Seed);
+        TArray<FVector3f> Points;
+        FVector3f Point = FVector3f::ZeroVector;
+        for (int32 i = 0; i < NumPoints; ++i)
+        {
+            Points.Add(Point);
+            Point += FVector3f(Random.FRandRange(-50.0f, 60.0f), Random.FRandRange(-50.0f, 50.0f), Random.FRandRange(-20.0f, 20.0f));
+        }
+        return Points;
+    }
+
+    // Reference query: every segment in path order, strictly-closer wins.
+    FRshipFieldPolylineHit BruteForceClosest(TConstArrayView<FVector3f> Points, bool bClosedLoop, const FVector3f& Position)
+    {
+        FRshipFieldPolylineHit Hit;
+        float ArcCm = 0.0f;
+        const int32 NumSegments = Points.Num() - 1 + ((bClosedLoop && Points.Num() > 2) ? 1 : 0);
+        for (int32 i = 0; i < NumSegments; ++i)
+        {
+            const FVector3f Start = Points[i];
+            const FVector3f End = Points[(i + 1) % Points.Num()];
+            const FVector3f Delta = End - Start;
+            const float Length = Delta.Size();
+            const float T = FMath::Clamp(FVector3f::DotProduct(Position - Start, Delta) / Delta.SizeSquared(), 0.0f, 1.0f);
+            const float Distance = FVector3f::Distance(Position, Start + Delta * T);
+            if (Distance < Hit.DistanceCm)
+            {
+                Hit.SegmentIndex = i;
+                Hit.DistanceCm = Distance;
+                Hit.ArcLengthCm = ArcCm + T * Length;
+            }
+            ArcCm += Length;
+        }
+        return Hit;
+    }
+
+    RshipFieldRDG::FGlobalDispatchInputs MakeInputs()
+    {
+        RshipFieldRDG::FGlobalDispatchInputs Inputs = RshipFieldTestInputs::MakeEmptyInputs(ERshipFieldResolution::Res64);
+        Inputs.TimeSeconds = 0.75f;
+        Inputs.MasterScalarGain = 1.0f;
+        Inputs.MasterVectorGain = 1.0f;
+        return Inputs;
+    }
+
+    float ScalarAt(const FRshipFieldCpuEvaluator& Evaluator, const FVector3f& PositionCm)
+    {
+        float Scalar = 0.0f;
+        FVector3f Vector;
+        Evaluator.EvaluateAtPosition(PositionCm, false, Scalar, Vector);
+        return Scalar;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldSplineClosestTest,
+    "Rship.Field.Spline.ClosestMatchesBruteForce",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldSplineClosestTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldSplineTests;
+
+    FRshipFieldPolyline Empty;
+    TestFalse(TEXT("Empty path has no closest point"), Empty.FindClosest(FVector3f::ZeroVector).IsValid());
+
+    // Duplicate points are dropped, not turned into zero-length segments
+    FRshipFieldPolyline Line;
+    const FVector3f LinePoints[] = { FVector3f(0.0f), FVector3f(100.0f, 0.0f, 0.0f), FVector3f(100.0f, 0.0f, 0.0f), FVector3f(100.0f, 50.0f, 0.0f) };
+    Line.Build(LinePoints, false);
+    TestEqual(TEXT("Duplicate point skipped"), Line.GetNumSegments(), 2);
+    TestEqual(TEXT("Length"), Line.GetLengthCm(), 150.0f);
+    const FRshipFieldPolylineHit Corner = Line.FindClosest(FVector3f(120.0f, 30.0f, 0.0f));
+    TestEqual(TEXT("Arc length past the corner"), Corner.ArcLengthCm, 130.0f, 1e-3f);
+    TestEqual(TEXT("Distance to the second leg"), Corner.DistanceCm, 20.0f, 1e-3f);
+    TestTrue(TEXT("Tangent follows the leg"), Corner.Tangent.Equals(FVector3f(0.0f, 1.0f, 0.0f)));
+    TestFalse(TEXT("Nothing within a short max distance"), Line.FindClosest(FVector3f(120.0f, 30.0f, 0.0f), 10.0f).IsValid());
+
+    for (const bool bClosedLoop : { false, true })
+    {
+        const TArray<FVector3f> Points = MakeRandomWalk(997, bClosedLoop ? 3 : 2);
+        FRshipFieldPolyline Polyline;
+        Polyline.Build(Points, bClosedLoop);
+        TestEqual(TEXT("Closed loops add the closing segment"), Polyline.GetNumSegments(), bClosedLoop ? 997 : 996);
+        TestTrue(TEXT("Every leaf holds at least two segments"), Polyline.GetNumNodes() < Polyline.GetNumSegments());
+
+        FRandomStream Random(11);
+        const FBox3f Bounds = Polyline.GetBounds().ExpandBy(200.0f);
+        int32 Mismatches = 0;
+        for (int32 i = 0; i < 2000; ++i)
+        {
+            // Half near the path, half anywhere around it
+            const FVector3f Position = (i % 2 == 0)
+                ? Points[Random.RandHelper(Points.Num())] + FVector3f(Random.FRandRange(-30.0f, 30.0f), Random.FRandRange(-30.0f, 30.0f), Random.FRandRange(-30.0f, 30.0f))
+                : FVector3f(Random.FRandRange(Bounds.Min.X, Bounds.Max.X), Random.FRandRange(Bounds.Min.Y, Bounds.Max.Y), Random.FRandRange(Bounds.Min.Z, Bounds.Max.Z));
+
+            const FRshipFieldPolylineHit Expected = BruteForceClosest(Points, bClosedLoop, Position);
+            const FRshipFieldPolylineHit Hit = Polyline.FindClosest(Position);
+            if (!Hit.IsValid()
+                || !FMath::IsNearlyEqual(Hit.DistanceCm, Expected.DistanceCm, 1e-2f)
+                || !FMath::IsNearlyEqual(Hit.ArcLengthCm, Expected.ArcLengthCm, 0.5f))
+            {
+                ++Mismatches;
+            }
+        }
+        TestEqual(*FString::Printf(TEXT("BVH matches brute force (%s)"), bClosedLoop ? TEXT("closed") : TEXT("open")), Mismatches, 0);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldSplineEvaluateTest,
+    "Rship.Field.Spline.RingAndPathWaves",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldSplineEvaluateTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldSplineTests;
+
+    // Ring: three lobes around an off-origin center
+    {
+        FRshipFieldRingEffector Ring;
+        Ring.CenterCm = FVector(100.0f, -50.0f, 20.0f);
+        Ring.Axis = FVector(0.0f, 0.0f, 1.0f);
+        Ring.RingRadiusCm = 800.0f;
+        Ring.RadiusCm = 200.0f;
+        Ring.LobeCount = 3;
+        Ring.Speed = 1.0f;
+
+        RshipFieldRDG::FGlobalDispatchInputs Inputs = MakeInputs();
+        RshipFieldRDG::PackEffectorInputs(Inputs, {}, { FRshipFieldEffectorDesc::FromRing(Ring) });
+        const FRshipFieldCpuEvaluator Evaluator(Inputs);
+
+        const FVector3f Center(Ring.CenterCm);
+        int32 Mismatches = 0;
+        for (int32 Step = 0; Step < 24; ++Step)
+        {
+            const float Azimuth = Step * UE_TWO_PI / 24.0f;
+            const FVector3f OnRing = Center + FVector3f(FMath::Cos(Azimuth), FMath::Sin(Azimuth), 0.0f) * Ring.RingRadiusCm;
+            const FVector3f NextLobe = Center + FVector3f(FMath::Cos(Azimuth + UE_TWO_PI / 3.0f), FMath::Sin(Azimuth + UE_TWO_PI / 3.0f), 0.0f) * Ring.RingRadiusCm;
+            if (!FMath::IsNearlyEqual(ScalarAt(Evaluator, OnRing), ScalarAt(Evaluator, NextLobe), 1e-3f))
+            {
+                ++Mismatches;
+            }
+        }
+        TestEqual(TEXT("Pattern repeats every 1/LobeCount turn"), Mismatches, 0);
+
+        // Full falloff on the ring itself: the peak lobe reaches the amplitude
+        float Peak = 0.0f;
+        for (int32 Step = 0; Step < 360; ++Step)
+        {
+            const float Azimuth = Step * UE_TWO_PI / 360.0f;
+            Peak = FMath::Max(Peak, ScalarAt(Evaluator, Center + FVector3f(FMath::Cos(Azimuth), FMath::Sin(Azimuth), 0.0f) * Ring.RingRadiusCm));
+        }
+        TestEqual(TEXT("Distance to the ring is zero on it"), Peak, Ring.Amplitude, 1e-3f);
+        TestEqual(TEXT("Center is beyond the tube radius"), ScalarAt(Evaluator, Center), 0.0f);
+        TestEqual(TEXT("So is a point above the ring"), ScalarAt(Evaluator, Center + FVector3f(800.0f, 0.0f, 250.0f)), 0.0f);
+    }
+
+    // Spline: phase follows arc length around an L-shaped path
+    {
+        const FVector3f PathPoints[] = { FVector3f(-1000.0f, 0.0f, 0.0f), FVector3f(0.0f, 0.0f, 0.0f), FVector3f(0.0f, 1000.0f, 0.0f) };
+        FRshipFieldPolyline Polyline;
+        Polyline.Build(PathPoints, false);
+
+        FRshipFieldSplineEffector Spline;
+        Spline.WavelengthCm = 400.0f;
+        Spline.FrequencyHz = -0.5f;
+        Spline.RadiusCm = 300.0f;
+
+        FRshipFieldEffectorDesc Desc = FRshipFieldEffectorDesc::FromSpline(Spline);
+        RshipFieldRDG::FGlobalDispatchInputs Inputs = MakeInputs();
+        Polyline.Pack(Inputs.SplineNodeData, Inputs.SplineSegmentData);
+
+        // A second effector's range after the first exercises the offsets; kept clear of the L
+        TArray<FVector3f> SecondPoints = MakeRandomWalk(40, 5);
+        for (FVector3f& Point : SecondPoints)
+        {
+            Point += FVector3f(1200.0f, -1200.0f, 0.0f);
+        }
+        FRshipFieldPolyline Second;
+        Second.Build(SecondPoints, true);
+        FRshipFieldEffectorDesc SecondDesc = Desc;
+        SecondDesc.SplineNodeOffset = Inputs.SplineNodeData.Num() / 2;
+        SecondDesc.SplineSegmentOffset = Inputs.SplineSegmentData.Num() / 2;
+        Second.Pack(Inputs.SplineNodeData, Inputs.SplineSegmentData);
+
+        RshipFieldRDG::PackEffectorInputs(Inputs, {}, { Desc, SecondDesc });
+        const FRshipFieldCpuEvaluator Evaluator(Inputs);
+
+        // Points one wavelength apart along the path agree, including across the corner
+        const FVector3f Along[] = { FVector3f(-900.0f, 0.0f, 0.0f), FVector3f(-500.0f, 0.0f, 0.0f), FVector3f(-100.0f, 0.0f, 0.0f), FVector3f(0.0f, 300.0f, 0.0f) };
+        for (int32 i = 1; i < UE_ARRAY_COUNT(Along); ++i)
+        {
+            TestEqual(TEXT("Phase advances one cycle per wavelength of arc"), ScalarAt(Evaluator, Along[i]), ScalarAt(Evaluator, Along[0]), 1e-3f);
+        }
+        TestNotEqual(TEXT("Half a wavelength is out of phase"), ScalarAt(Evaluator, FVector3f(-700.0f, 0.0f, 0.0f)), ScalarAt(Evaluator, Along[0]));
+
+        // Offset from the path falls off with distance but keeps the phase of the closest point
+        const float OnPath = ScalarAt(Evaluator, FVector3f(-600.0f, 0.0f, 0.0f));
+        const float Offset = ScalarAt(Evaluator, FVector3f(-600.0f, 150.0f, 0.0f));
+        TestEqual(TEXT("Linear falloff halfway out"), Offset, OnPath * 0.5f, 1e-3f);
+        TestEqual(TEXT("Nothing past the radius"), ScalarAt(Evaluator, FVector3f(-600.0f, -400.0f, 0.0f)), 0.0f);
+
+        FVector3f Vector;
+        float Scalar = 0.0f;
+        Evaluator.EvaluateAtPosition(FVector3f(-600.0f, 0.0f, 0.0f), false, Scalar, Vector);
+        TestTrue(TEXT("Vector runs along the path without a polarization"), FMath::IsNearlyZero(Vector.Y) && FMath::IsNearlyZero(Vector.Z));
+
+        // The batched path walks the same tree as single-point evaluation
+        FRshipFieldPointBatch Batch;
+        FRandomStream Random(17);
+        for (int32 i = 0; i < 1003; ++i)
+        {
+            Batch.Add(FVector(Random.FRandRange(-1200.0f, 1800.0f), Random.FRandRange(-1800.0f, 1200.0f), Random.FRandRange(-300.0f, 300.0f)));
+        }
+        Evaluator.EvaluatePoints(Batch);
+        int32 Mismatches = 0;
+        for (int32 i = 0; i < Batch.Num(); ++i)
+        {
+            Evaluator.EvaluateAtPosition(FVector3f(Batch.PositionX[i], Batch.PositionY[i], Batch.PositionZ[i]), false, Scalar, Vector);
+            if (Batch.Scalar[i] != Scalar || Batch.GetVector(i) != FVector(Vector))
+            {
+                ++Mismatches;
+            }
+        }
+        TestEqual(TEXT("Point batches match single-point evaluation"), Mismatches, 0);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldSplineBenchmark,
+    "Rship.Field.Spline.Benchmark",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FRshipFieldSplineBenchmark::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldSplineTests;
+
+    const TArray<FVector3f> Points = MakeRandomWalk(10000, 1);
+
+    double StartSeconds = FPlatformTime::Seconds();
+    FRshipFieldPolyline Polyline;
+    Polyline.Build(Points, false);
+    const double BuildMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+
+    FRandomStream Random(3);
+    const FBox3f Bounds = Polyline.GetBounds();
+    TArray<FVector3f> Queries;
+    for (int32 i = 0; i < 1000; ++i)
+    {
+        Queries.Add(FVector3f(Random.FRandRange(Bounds.Min.X, Bounds.Max.X), Random.FRandRange(Bounds.Min.Y, Bounds.Max.Y), Random.FRandRange(Bounds.Min.Z, Bounds.Max.Z)));
+    }
+
+    float Checksum = 0.0f;
+    StartSeconds = FPlatformTime::Seconds();
+    for (const FVector3f& Query : Queries)
+    {
+        Checksum += Polyline.FindClosest(Query).ArcLengthCm;
+    }
+    const double TreeUs = FMath::Max(FPlatformTime::Seconds() - StartSeconds, 1e-9) * 1e6 / Queries.Num();
+
+    StartSeconds = FPlatformTime::Seconds();
+    for (const FVector3f& Query : Queries)
+    {
+        Checksum -= BruteForceClosest(Points, false, Query).ArcLengthCm;
+    }
+    const double BruteUs = FMath::Max(FPlatformTime::Seconds() - StartSeconds, 1e-9) * 1e6 / Queries.Num();
+
+    TestTrue(TEXT("Queried"), TreeUs > 0.0);
+    AddInfo(FString::Printf(TEXT("%d segments, %d nodes: build %.2f ms, query %.2f us (brute force %.2f us, %.0fx) (checksum %.3f)"),
+        Polyline.GetNumSegments(), Polyline.GetNumNodes(), BuildMs, TreeUs, BruteUs, BruteUs / TreeUs, Checksum));
+
+    return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
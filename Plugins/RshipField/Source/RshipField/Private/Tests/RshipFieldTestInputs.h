@@ -0,0 +1,58 @@
+// Copyright Rocketship. All Rights Reserved.
+// Field Test Inputs
+//
+// Dispatch inputs and effector fixtures shared by the field tests, so the atlas
+// layout and the domains the tests place effectors in are defined once.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include "RshipFieldShaders.h"
+#include "RshipFieldTypes.h"
+
+namespace RshipFieldTestInputs
+{
+    // Half extents of the cube domains the tests use, centered on the origin.
+    // Room: single effectors and point samples. Stage: scattered scenes; 8 tiles of 500 cm per axis at 64^3.
+    constexpr float RoomHalfExtentCm = 1000.0f;
+    constexpr float StageHalfExtentCm = 2000.0f;
+
+    // No effectors yet; the atlas packed the way the field component allocates it.
+    inline RshipFieldRDG::FGlobalDispatchInputs MakeEmptyInputs(ERshipFieldResolution Resolution, float HalfExtentCm = StageHalfExtentCm)
+    {
+        RshipFieldRDG::FGlobalDispatchInputs Inputs;
+        Inputs.FieldResolution = GetFieldResolutionValue(Resolution);
+        Inputs.TilesPerRow = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Inputs.FieldResolution))));
+        Inputs.DomainMinCm = FVector4f(-HalfExtentCm, -HalfExtentCm, -HalfExtentCm, 0.0f);
+        Inputs.DomainMaxCm = FVector4f(HalfExtentCm, HalfExtentCm, HalfExtentCm, 0.0f);
+        return Inputs;
+    }
+
+    inline FVector RandomPosition(FRandomStream& Random, float ExtentCm)
+    {
+        return FVector(Random.FRandRange(-ExtentCm, ExtentCm), Random.FRandRange(-ExtentCm, ExtentCm), Random.FRandRange(-ExtentCm, ExtentCm));
+    }
+
+    inline FRshipFieldEffectorDesc MakeAttractor(const FVector& PositionCm, float RadiusCm, float Strength = 1.0f, float FalloffExponent = 2.0f)
+    {
+        FRshipFieldAttractorEffector Attractor;
+        Attractor.PositionCm = PositionCm;
+        Attractor.RadiusCm = RadiusCm;
+        Attractor.Strength = Strength;
+        Attractor.FalloffExponent = FalloffExponent;
+        return FRshipFieldEffectorDesc::FromAttractor(Attractor);
+    }
+
+    // 150 cm standing wave; FrequencyHz 0 freezes it in time.
+    inline FRshipFieldEffectorDesc MakeStandingWave(const FVector& PositionCm, float RadiusCm, float FrequencyHz, float Amplitude = 1.0f)
+    {
+        FRshipFieldWaveEffector Wave;
+        Wave.PositionCm = PositionCm;
+        Wave.RadiusCm = RadiusCm;
+        Wave.FrequencyHz = FrequencyHz;
+        Wave.Amplitude = Amplitude;
+        Wave.WavelengthCm = 150.0f;
+        return FRshipFieldEffectorDesc::FromWave(Wave);
+    }
+}
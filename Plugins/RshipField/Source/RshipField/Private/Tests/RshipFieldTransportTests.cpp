@@ -0,0 +1,261 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "RshipFieldTypes.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "RshipFieldComponent.h"
+#include "RshipFieldShaders.h"
+#include "RshipFieldSimulation.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace RshipFieldTransportTests
+{
+    constexpr double StepSeconds = 1.0 / 60.0;
+
+    TStrongObjectPtr<URshipFieldComponent> MakeField()
+    {
+        TStrongObjectPtr<URshipFieldComponent> Field(NewObject<URshipFieldComponent>(GetTransientPackage(), NAME_None, RF_Transient));
+        Field->UpdateHz = 60.0f;
+        return Field;
+    }
+
+    FRshipFieldTransport& AddTransport(URshipFieldComponent& Field, const TCHAR* Id, float Bpm)
+    {
+        FRshipFieldTransport& Transport = Field.Transports.AddDefaulted_GetRef();
+        Transport.Id = Id;
+        Transport.Bpm = Bpm;
+        return Transport;
+    }
+
+    void RunSteps(URshipFieldComponent& Field, int32 NumSteps)
+    {
+        for (int32 Step = 0; Step < NumSteps; ++Step)
+        {
+            RshipFieldSimulation::Step(Field);
+        }
+    }
+
+    // Beats covered by NumSteps field steps at Bpm, computed in one go from the step length
+    // the simulation actually uses.
+    double ExpectedBeats(const URshipFieldComponent& Field, int64 NumSteps, double Bpm)
+    {
+        return static_cast<double>(NumSteps) * RshipFieldSimulation::GetStepSeconds(Field) * Bpm / 60.0;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldTransportDriftTest,
+    "Rship.Field.Transport.NoDriftOverHours",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldTransportDriftTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldTransportTests;
+
+    // Ten hours at 60 Hz and 120 BPM, against the 72000 beats that makes exactly. Summing the
+    // step in float loses whole beats over this span
+    FRshipFieldTransportClock Clock;
+    Clock.Configure(StepSeconds, 120.0, true);
+    constexpr int64 NumSteps = 10 * 60 * 60 * 60;
+    float Accumulated = 0.0f;
+    for (int64 Step = 0; Step < NumSteps; ++Step)
+    {
+        Clock.Advance();
+        Accumulated += static_cast<float>(StepSeconds * 2.0);
+    }
+    TestEqual(TEXT("Ten hours land on the exact beat"), Clock.GetBeat(), 72000.0, 1e-6);
+    TestTrue(TEXT("Summing in float drifts"), FMath::Abs(Accumulated - 72000.0f) > 1.0f);
+
+    // An hour of whole field steps; the group phase packed for the GPU is the exact one
+    TStrongObjectPtr<URshipFieldComponent> Field = MakeField();
+    Field->Bpm = 128.0f;
+    AddTransport(*Field, TEXT("Slow"), 93.0f);
+    FRshipFieldSyncGroup& Group = Field->SyncGroups.AddDefaulted_GetRef();
+    Group.Id = TEXT("Triplets");
+    Group.Transport = TEXT("Slow");
+    Group.TempoMultiplier = 1.5f;
+
+    constexpr int32 NumFieldSteps = 60 * 60 * 60;
+    RunSteps(*Field, NumFieldSteps);
+
+    const double MainBeat = RshipFieldSimulation::GetTransportBeat(*Field, FString());
+    const double SlowBeat = RshipFieldSimulation::GetTransportBeat(*Field, TEXT("Slow"));
+    TestEqual(TEXT("Field transport after an hour"), MainBeat, ExpectedBeats(*Field, NumFieldSteps, 128.0), 1e-6);
+    TestEqual(TEXT("Named transport after an hour"), SlowBeat, ExpectedBeats(*Field, NumFieldSteps, 93.0), 1e-6);
+
+    RshipFieldRDG::FGlobalDispatchInputs Inputs;
+    RshipFieldSimulation::BuildGlobalInputs(*Field, Inputs);
+    const double ExpectedPhase = UE_DOUBLE_TWO_PI * FMath::Frac(ExpectedBeats(*Field, NumFieldSteps, 93.0) * 1.5);
+    TestEqual(TEXT("Group phase resolved on the CPU"), static_cast<double>(Inputs.SyncGroupData[1].Z), ExpectedPhase, 1e-4);
+    TestEqual(TEXT("GPU does not scale the transport phase again"), Inputs.SyncGroupData[1].Y, 0.0f);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldTransportTempoChangeTest,
+    "Rship.Field.Transport.TempoChangeIsContinuous",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldTransportTempoChangeTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldTransportTests;
+
+    FRshipFieldTransportClock Clock;
+    Clock.Configure(StepSeconds, 120.0, true);
+    for (int32 Step = 0; Step < 100; ++Step)
+    {
+        Clock.Advance();
+    }
+    const double BeatAtChange = Clock.GetBeat();
+    TestEqual(TEXT("Before the change"), BeatAtChange, 100.0 / 60.0 * 2.0, 1e-9);
+
+    Clock.Configure(StepSeconds, 90.0, true);
+    TestEqual(TEXT("No jump at the tempo change"), Clock.GetBeat(), BeatAtChange);
+    for (int32 Step = 0; Step < 60; ++Step)
+    {
+        Clock.Advance();
+    }
+    TestEqual(TEXT("New tempo from the change on"), Clock.GetBeat(), BeatAtChange + 1.5, 1e-9);
+
+    // Stopping holds the position, playing resumes from it
+    Clock.Configure(StepSeconds, 90.0, false);
+    const double BeatAtStop = Clock.GetBeat();
+    for (int32 Step = 0; Step < 30; ++Step)
+    {
+        Clock.Advance();
+    }
+    TestEqual(TEXT("Holds while stopped"), Clock.GetBeat(), BeatAtStop);
+    Clock.Configure(StepSeconds, 90.0, true);
+    for (int32 Step = 0; Step < 40; ++Step)
+    {
+        Clock.Advance();
+    }
+    TestEqual(TEXT("Resumes from the held beat"), Clock.GetBeat(), BeatAtStop + 1.0, 1e-9);
+
+    // The same through the component: SetBpm mid-run changes the slope, not the position
+    TStrongObjectPtr<URshipFieldComponent> Field = MakeField();
+    RunSteps(*Field, 30);
+    const float BeforeChange = Field->BeatPhase;
+    Field->SetBpmAction(150.0f);
+    RunSteps(*Field, 60);
+    TestEqual(TEXT("Field transport continues at the new tempo"), static_cast<double>(Field->BeatPhase),
+        BeforeChange + ExpectedBeats(*Field, 60, 150.0), 1e-5);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldTransportLocateTest,
+    "Rship.Field.Transport.Locate",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldTransportLocateTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldTransportTests;
+
+    TStrongObjectPtr<URshipFieldComponent> Field = MakeField();
+    AddTransport(*Field, TEXT("B"), 90.0f);
+    RunSteps(*Field, 45);
+
+    // Writing BeatPhase between steps is a locate, visible before the next step runs
+    Field->SetTransportAction(4.0f, true);
+    Field->Transports[0].BeatPhase = 16.0f;
+    TestEqual(TEXT("Field locate resolves as written"), RshipFieldSimulation::GetTransportBeat(*Field, FString()), 4.0);
+    TestEqual(TEXT("Named locate resolves as written"), RshipFieldSimulation::GetTransportBeat(*Field, TEXT("B")), 16.0);
+    TestEqual(TEXT("Unknown transports follow the field's"), RshipFieldSimulation::GetTransportBeat(*Field, TEXT("Missing")), 4.0);
+
+    RunSteps(*Field, 60);
+    TestEqual(TEXT("Field runs on from the locate"), static_cast<double>(Field->BeatPhase), 4.0 + ExpectedBeats(*Field, 60, Field->Bpm), 1e-5);
+    TestEqual(TEXT("Named runs on from the locate"), static_cast<double>(Field->Transports[0].BeatPhase), 16.0 + ExpectedBeats(*Field, 60, 90.0), 1e-5);
+
+    // Transports that go away take their clocks with them
+    Field->Transports.Reset();
+    RunSteps(*Field, 1);
+    TestEqual(TEXT("Clock pruned"), Field->TransportClocks.Num(), 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldTransportExternalTest,
+    "Rship.Field.Transport.ExternalClock",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldTransportExternalTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldTransportTests;
+
+    TStrongObjectPtr<URshipFieldComponent> Field = MakeField();
+    FRshipFieldTransport& External = AddTransport(*Field, TEXT("Timecode"), 120.0f);
+    External.ClockSource = ERshipFieldClockSource::External;
+    External.ExternalTimeoutSeconds = 0.5f;
+
+    // Free-runs from a report at its tempo, then holds once reports stop for the timeout
+    Field->SyncTransport(TEXT("Timecode"), 8.0f, 120.0f);
+    RunSteps(*Field, 15);
+    TestEqual(TEXT("Free-runs between reports"), static_cast<double>(Field->Transports[0].BeatPhase), 8.0 + ExpectedBeats(*Field, 15, 120.0), 1e-5);
+    RunSteps(*Field, 60);
+    TestEqual(TEXT("Holds after the timeout"), Field->Transports[0].BeatPhase, 9.0f);
+
+    // A report at the beat it is holding still counts as a report and restarts it
+    Field->SyncTransport(TEXT("Timecode"), 9.0f, 60.0f);
+    RunSteps(*Field, 12);
+    TestEqual(TEXT("Same-beat report restarts the clock"), static_cast<double>(Field->Transports[0].BeatPhase), 9.0 + ExpectedBeats(*Field, 12, 60.0), 1e-5);
+    TestEqual(TEXT("Reports counted"), Field->Transports[0].SyncCount, 2);
+
+    // Reports for transports that do not exist are ignored
+    Field->SyncTransport(TEXT("Missing"), 1.0f, 120.0f);
+    TestEqual(TEXT("No transport added"), Field->Transports.Num(), 1);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldTransportPolyrhythmTest,
+    "Rship.Field.Transport.Polyrhythm",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldTransportPolyrhythmTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldTransportTests;
+
+    TStrongObjectPtr<URshipFieldComponent> Field = MakeField();
+    AddTransport(*Field, TEXT("Drums"), 120.0f);
+    AddTransport(*Field, TEXT("Pads"), 80.0f);
+
+    FRshipFieldSyncGroup& Drums = Field->SyncGroups.AddDefaulted_GetRef();
+    Drums.Id = TEXT("Drums");
+    Drums.Transport = TEXT("Drums");
+    Drums.PhaseOffset = 0.25f;
+
+    FRshipFieldSyncGroup& Pads = Field->SyncGroups.AddDefaulted_GetRef();
+    Pads.Id = TEXT("Pads");
+    Pads.Transport = TEXT("Pads");
+    Pads.TempoMultiplier = 0.5f;
+
+    FRshipFieldSyncGroup& Main = Field->SyncGroups.AddDefaulted_GetRef();
+    Main.Id = TEXT("Main");
+
+    Field->Bpm = 100.0f;
+    RunSteps(*Field, 37);
+
+    RshipFieldRDG::FGlobalDispatchInputs Inputs;
+    RshipFieldSimulation::BuildGlobalInputs(*Field, Inputs);
+    TestEqual(TEXT("Free-running group and three sync groups"), Inputs.SyncGroupData.Num(), 4);
+
+    const auto ExpectedPhase = [&Field](double Bpm, double Multiplier, double Offset)
+    {
+        return Offset + UE_DOUBLE_TWO_PI * FMath::Frac(ExpectedBeats(*Field, 37, Bpm) * Multiplier);
+    };
+    TestEqual(TEXT("Drums at their own tempo"), static_cast<double>(Inputs.SyncGroupData[1].Z), ExpectedPhase(120.0, 1.0, 0.25), 1e-5);
+    TestEqual(TEXT("Pads at theirs, half-time"), static_cast<double>(Inputs.SyncGroupData[2].Z), ExpectedPhase(80.0, 0.5, 0.0), 1e-5);
+    TestEqual(TEXT("Ungrouped transport follows the field"), static_cast<double>(Inputs.SyncGroupData[3].Z), ExpectedPhase(100.0, 1.0, 0.0), 1e-5);
+
+    return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
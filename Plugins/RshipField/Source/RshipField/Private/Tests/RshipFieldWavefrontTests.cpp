@@ -0,0 +1,178 @@
+// Copyright Rocketship. All Rights Reserved.
+
+#include "RshipFieldTypes.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+namespace RshipFieldWavefrontTests
+{
+    // Birth times of the live wavefronts as the shader sees them.
+    TArray<float> UploadedBirthTimes(const FRshipFieldWavefrontRing& Ring)
+    {
+        TArray<float> Times;
+        for (const FVector4f& Wavefront : Ring.GetUploadView())
+        {
+            Times.Add(Wavefront.X);
+        }
+        return Times;
+    }
+
+    bool IsAscending(const TArray<float>& Times)
+    {
+        for (int32 i = 1; i < Times.Num(); ++i)
+        {
+            if (Times[i] <= Times[i - 1])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldWavefrontBurstTest,
+    "Rship.Field.Wavefronts.EmissionBurst",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldWavefrontBurstTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldWavefrontTests;
+
+    FRshipFieldWavefrontRing Ring;
+    TestTrue(TEXT("Starts empty"), Ring.IsEmpty());
+    TestEqual(TEXT("Empty upload"), Ring.GetUploadView().Num(), 0);
+
+    // A 40-wavefront burst wraps the ring more than twice; only the newest 16 survive
+    for (int32 i = 0; i < 40; ++i)
+    {
+        Ring.Emit(i * 0.01f, FVector(i, 0.0, 0.0), 16);
+    }
+    TestEqual(TEXT("Capped at capacity"), Ring.Num(), FRshipFieldWavefrontRing::Capacity);
+
+    const TArray<float> Times = UploadedBirthTimes(Ring);
+    TestEqual(TEXT("Upload view covers every live wavefront"), Times.Num(), 16);
+    TestEqual(TEXT("Oldest survivor"), Times[0], 24 * 0.01f);
+    TestEqual(TEXT("Newest"), Times.Last(), 39 * 0.01f);
+    TestTrue(TEXT("Upload stays in birth order across the wrap"), IsAscending(Times));
+
+    const TConstArrayView<FVector4f> View = Ring.GetUploadView();
+    for (int32 i = 0; i < Ring.Num(); ++i)
+    {
+        const FRshipFieldWavefront Wavefront = Ring[i];
+        TestEqual(TEXT("Indexed birth time matches upload"), Wavefront.BirthTime, View[i].X);
+        TestEqual(TEXT("Birth position packed into yzw"), Wavefront.BirthPositionCm.X, static_cast<double>(24 + i));
+    }
+
+    // A lower cap evicts down to it on the next emit
+    Ring.Emit(0.5f, FVector::ZeroVector, 4);
+    TestEqual(TEXT("Lowered cap"), Ring.Num(), 4);
+    TestEqual(TEXT("Keeps the newest"), Ring[0].BirthTime, 37 * 0.01f);
+    Ring.Emit(0.6f, FVector::ZeroVector, 64);
+    TestEqual(TEXT("Caps above capacity are clamped, not evicting"), Ring.Num(), 5);
+
+    // Simulation clock reset: older birth time restarts the ring
+    Ring.Emit(0.0f, FVector::ZeroVector, 16);
+    TestEqual(TEXT("Clock reset clears"), Ring.Num(), 1);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldWavefrontExpiryTest,
+    "Rship.Field.Wavefronts.ExpiryOrdering",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldWavefrontExpiryTest::RunTest(const FString& Parameters)
+{
+    using namespace RshipFieldWavefrontTests;
+
+    FRshipFieldWaveEffector Wave;
+    Wave.WaveMode = ERshipFieldWaveMode::Traveling;
+    Wave.RadiusCm = 1000.0f;
+    Wave.WaveSpeedCmPerSec = 500.0f;
+    const float MaxAge = Wave.GetMaxWavefrontAge();
+    TestEqual(TEXT("Radius / speed"), MaxAge, 2.0f);
+
+    FRshipFieldWavefrontRing Ring;
+    TestEqual(TEXT("Nothing to expire"), Ring.GetNextExpiryTime(MaxAge), MAX_flt);
+
+    // Emit at 4 Hz for two seconds, expiring as the simulation steps
+    int32 Expired = 0;
+    for (int32 Step = 0; Step <= 8; ++Step)
+    {
+        const float Now = Step * 0.25f;
+        Ring.Emit(Now, FVector::ZeroVector, 16);
+        Expired += Ring.Expire(Now, MaxAge);
+    }
+    TestEqual(TEXT("Nothing has reached the radius yet"), Expired, 0);
+    TestEqual(TEXT("Live wavefronts"), Ring.Num(), 9);
+    TestEqual(TEXT("Oldest expires analytically at birth + radius / speed"), Ring.GetNextExpiryTime(MaxAge), 2.0f);
+
+    // Expiry pops strictly from the front
+    TestEqual(TEXT("At the boundary nothing expires"), Ring.Expire(2.0f, MaxAge), 0);
+    TestEqual(TEXT("Just past it the oldest goes"), Ring.Expire(2.01f, MaxAge), 1);
+    TestEqual(TEXT("Next oldest is now first"), Ring[0].BirthTime, 0.25f);
+    TestEqual(TEXT("Three more a second later"), Ring.Expire(2.8f, MaxAge), 3);
+    TestEqual(TEXT("Survivors"), Ring.Num(), 5);
+    TestTrue(TEXT("Survivors stay in birth order"), IsAscending(UploadedBirthTimes(Ring)));
+
+    // Emitting after expiry keeps filling the ring contiguously
+    Ring.Emit(3.0f, FVector::ZeroVector, 16);
+    TestEqual(TEXT("Newest appended"), UploadedBirthTimes(Ring).Last(), 3.0f);
+    TestEqual(TEXT("Everything expires eventually"), Ring.Expire(10.0f, MaxAge), 6);
+    TestTrue(TEXT("Empty"), Ring.IsEmpty());
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FRshipFieldWavefrontDispersionTest,
+    "Rship.Field.Wavefronts.DispersionLockChange",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRshipFieldWavefrontDispersionTest::RunTest(const FString& Parameters)
+{
+    FRshipFieldWaveEffector Wave;
+    Wave.WaveMode = ERshipFieldWaveMode::Traveling;
+    Wave.RadiusCm = 1000.0f;
+    Wave.WavelengthCm = 500.0f;
+    Wave.FrequencyHz = 1.0f;
+    Wave.WaveSpeedCmPerSec = 500.0f;
+    Wave.Derive = ERshipFieldDerive::Frequency;
+    Wave.SyncDispersion();
+    TestEqual(TEXT("Locked frequency = speed / wavelength"), Wave.FrequencyHz, 1.0f);
+
+    FRshipFieldWavefrontRing Ring;
+    for (int32 i = 0; i < 6; ++i)
+    {
+        Ring.Emit(i * 0.25f, FVector::ZeroVector, 16);
+    }
+    TestEqual(TEXT("Slow waves: nothing expired at t=1.5"), Ring.Expire(1.5f, Wave.GetMaxWavefrontAge()), 0);
+
+    // Mid-flight the operator switches to deriving speed and doubles the frequency:
+    // every wavefront now travels twice as fast, so the expiry horizon halves
+    Wave.Derive = ERshipFieldDerive::Speed;
+    Wave.FrequencyHz = 2.0f;
+    Wave.SyncDispersion();
+    TestEqual(TEXT("Derived speed"), Wave.WaveSpeedCmPerSec, 1000.0f);
+    TestEqual(TEXT("Wavelength held"), Wave.WavelengthCm, 500.0f);
+    TestEqual(TEXT("Horizon halves"), Wave.GetMaxWavefrontAge(), 1.0f);
+
+    // Births 0.0 and 0.25 are now past the new horizon; the rest stay, still ordered
+    TestEqual(TEXT("Two oldest expire immediately"), Ring.Expire(1.5f, Wave.GetMaxWavefrontAge()), 2);
+    TestEqual(TEXT("Oldest survivor"), Ring[0].BirthTime, 0.5f);
+    TestEqual(TEXT("Next expiry uses the new speed"), Ring.GetNextExpiryTime(Wave.GetMaxWavefrontAge()), 1.5f);
+
+    // Switching to derive wavelength keeps the current speed and frequency
+    Wave.Derive = ERshipFieldDerive::Wavelength;
+    Wave.SyncDispersion();
+    TestEqual(TEXT("No jump when switching lock"), Wave.WaveSpeedCmPerSec, 1000.0f);
+    TestEqual(TEXT("Wavelength rederived"), Wave.WavelengthCm, 500.0f);
+    TestEqual(TEXT("No extra expiry from the switch"), Ring.Expire(1.5f, Wave.GetMaxWavefrontAge()), 0);
+
+    return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
@@ -2,14 +2,19 @@
 
 #include "CoreMinimal.h"
 #include "Controllers/RshipControllerComponent.h"
+#include "RshipFieldPolyline.h"
+#include "RshipFieldQuery.h"
 #include "RshipFieldTypes.h"
 #include "RshipFieldComponent.generated.h"
 
+class FRshipFieldRecorder;
 class UNiagaraComponent;
 class UNiagaraSystem;
 class URshipFieldSubsystem;
 class UTextureRenderTarget2D;
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FiveParams(FRshipFieldProbeEmitter, FString, Probe, float, Scalar, float, X, float, Y, float, Z);
+
 UCLASS(ClassGroup = (Rship), meta = (BlueprintSpawnableComponent, DisplayName = "Rship Field"))
 class RSHIPFIELD_API URshipFieldComponent : public URshipControllerComponent
 {
@@ -52,6 +57,20 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field", meta = (ClampMin = "1.0"))
     float DomainSizeCm = 10000.0f;
 
+    // How light samplers bound to this field get their values.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    ERshipFieldSampleMode LightSampleMode = ERshipFieldSampleMode::Cpu;
+
+    // Bin effectors into voxel tiles so the atlas pass skips the ones out of reach. The
+    // result is identical either way; turn off to compare.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field", AdvancedDisplay)
+    bool bCullEffectorsByTile = true;
+
+    // Only rebuild the atlas tiles an effector change or animation can reach since the last
+    // step; the rest keep their values. Anything global still rebuilds the whole volume.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field", AdvancedDisplay)
+    bool bIncrementalUpdates = true;
+
     // Transport clock — drives all phase groups in this field.
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field|Transport")
     float Bpm = 60.0f;
@@ -66,6 +85,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field|Transport")
     TArray<FRshipFieldSyncGroup> SyncGroups;
 
+    // Further transports, each with its own tempo and position, that sync groups can follow.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field|Transport")
+    TArray<FRshipFieldTransport> Transports;
+
     // Effectors
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field|Effectors")
     TArray<FRshipFieldWaveEffector> WaveEffectors;
@@ -76,9 +99,22 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field|Effectors")
     TArray<FRshipFieldAttractorEffector> AttractorEffectors;
 
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field|Effectors")
+    TArray<FRshipFieldSplineEffector> SplineEffectors;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field|Effectors")
+    TArray<FRshipFieldRingEffector> RingEffectors;
+
     // Traveling wave state — parallel to WaveEffectors, managed by subsystem.
     TArray<FRshipFieldWaveEffectorState> WaveEffectorStates;
 
+    // Sampled spline paths — parallel to SplineEffectors, rebuilt by subsystem when the source changes.
+    TArray<FRshipFieldPolyline> SplinePolylines;
+
+    // Clocks behind Bpm/BeatPhase and behind each of Transports, by Id. Managed by the simulation.
+    FRshipFieldTransportClock TransportClock;
+    TMap<FString, FRshipFieldTransportClock> TransportClocks;
+
     // Emit a wavefront from the given wave effector index. No-op if not in Traveling mode.
     UFUNCTION(BlueprintCallable, Category = "Rship|Field")
     void EmitWavefront(int32 WaveEffectorIndex);
@@ -87,6 +123,43 @@ public:
     UFUNCTION(CallInEditor, Category = "Rship|Field")
     void EmitAllWavefronts();
 
+    // Record every simulation step from now on, replacing a recording in progress.
+    UFUNCTION(BlueprintCallable, Category = "Rship|Field|Recording")
+    void StartRecording();
+
+    // Stop recording and write the recording to FilePath. False if nothing was being recorded
+    // or the file could not be written; the recording is dropped either way.
+    UFUNCTION(BlueprintCallable, Category = "Rship|Field|Recording")
+    bool StopRecording(const FString& FilePath);
+
+    UFUNCTION(BlueprintPure, Category = "Rship|Field|Recording")
+    bool IsRecording() const { return Recorder.IsValid(); }
+
+    // Set while recording; the subsystem reports each step to it.
+    TSharedPtr<FRshipFieldRecorder> Recorder;
+
+    // Probes: named points sampled every step and published to rship through OnProbeSample.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field|Probes")
+    bool bPublishProbes = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field|Probes")
+    TArray<FRshipFieldProbe> Probes;
+
+    // Pulsed for each probe whose value changed: the probe's name, the scalar value and the vector.
+    UPROPERTY(BlueprintAssignable, Category = "Rship|Field|Emitters")
+    FRshipFieldProbeEmitter OnProbeSample;
+
+    // Probe query in flight and the probe names it was submitted for. Managed by subsystem.
+    TFuture<FRshipFieldQueryResult> ProbeQuery;
+    TArray<FString> ProbeQueryNames;
+
+    // World positions of Probes, in order.
+    void GetProbePositions(TArray<FVector>& OutPositionsCm) const;
+
+    // Pulses OnProbeSample for every probe in Names, parallel to Result, whose value differs
+    // from the last one published under that name.
+    void PublishProbeSamples(TConstArrayView<FString> Names, const FRshipFieldQueryResult& Result);
+
     // Debug
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field|Debug")
     bool bShowWireframes = false;
@@ -122,9 +195,30 @@ public:
     UFUNCTION()
     void SetTransportAction(float Phase, bool Playing);
 
+    // Tempo and play state of one of Transports.
+    UFUNCTION()
+    void SetNamedTransportAction(const FString& TransportId, float InBpm, bool Playing);
+
+    // Position report for one of Transports, from rship or an external clock bridge. External
+    // transports run from the latest report at its tempo.
+    UFUNCTION(BlueprintCallable, Category = "Rship|Field|Transport")
+    void SyncTransport(const FString& TransportId, float Beat, float InBpm);
+
     UFUNCTION()
     void SetFieldState(const FString& StateJson);
 
+    UFUNCTION()
+    void SetSplineEffectorAction(int32 Index, bool Enabled, float Amplitude, float WavelengthCm, float FrequencyHz, float RadiusCm);
+
+    UFUNCTION()
+    void SetSplinePointsAction(int32 Index, const FString& PointsJson, bool ClosedLoop);
+
+    UFUNCTION()
+    void SetRingEffectorAction(int32 Index, bool Enabled, float Amplitude, float RingRadiusCm, int32 LobeCount, float Speed, float RadiusCm);
+
+    UFUNCTION()
+    void SetRingTransformAction(int32 Index, float CenterX, float CenterY, float CenterZ, float AxisX, float AxisY, float AxisZ);
+
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Rship|Field|Debug", AdvancedDisplay)
     FString LastFieldStateError;
 
@@ -151,4 +245,7 @@ private:
 
     UPROPERTY(Transient)
     TObjectPtr<UNiagaraComponent> VisualizerComponent = nullptr;
+
+    // Last value published per probe name: scalar in W, vector in XYZ.
+    TMap<FString, FVector4f> PublishedProbeSamples;
 };
@@ -0,0 +1,199 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RshipFieldShaders.h"
+
+// CPU copy of the scalar/vector field atlases. Same layout as the render targets:
+// voxel (X, Y, Z) lives in tile Z, tiles laid out TilesPerRow across.
+struct RSHIPFIELD_API FRshipFieldCpuAtlas
+{
+    int32 FieldResolution = 0;
+    int32 TilesPerRow = 0;
+
+    // AtlasSize x AtlasSize, row-major.
+    TArray<float> Scalar;
+    TArray<FVector4f> Vector;
+
+    void Allocate(int32 InFieldResolution, int32 InTilesPerRow);
+
+    int32 GetAtlasSize() const { return FieldResolution * TilesPerRow; }
+
+    // AtlasCoordFromVoxel in RshipFieldCS.usf.
+    FIntPoint GetAtlasCoord(int32 X, int32 Y, int32 Z) const
+    {
+        return FIntPoint((Z % TilesPerRow) * FieldResolution + X, (Z / TilesPerRow) * FieldResolution + Y);
+    }
+
+    int32 GetAtlasIndex(int32 X, int32 Y, int32 Z) const
+    {
+        const FIntPoint Coord = GetAtlasCoord(X, Y, Z);
+        return Coord.Y * GetAtlasSize() + Coord.X;
+    }
+};
+
+// Sample positions and results for FRshipFieldCpuEvaluator::EvaluatePoints, stored as
+// structure of arrays so four samples load straight into one SIMD register per axis.
+struct RSHIPFIELD_API FRshipFieldPointBatch
+{
+    TArray<float> PositionX;
+    TArray<float> PositionY;
+    TArray<float> PositionZ;
+
+    // Filled by EvaluatePoints, master gains applied.
+    TArray<float> Scalar;
+    TArray<float> VectorX;
+    TArray<float> VectorY;
+    TArray<float> VectorZ;
+
+    int32 Num() const { return PositionX.Num(); }
+
+    // Clears positions and results, keeping the allocations.
+    void Reset();
+
+    int32 Add(const FVector& PositionCm);
+
+    FVector GetVector(int32 Index) const { return FVector(VectorX[Index], VectorY[Index], VectorZ[Index]); }
+};
+
+// CPU implementation of BuildGlobalFieldCS (RshipFieldCS.usf).
+//
+// Reads the same packed buffers as the GPU pass and follows the kernel operation for
+// operation in single precision, so it serves as the test oracle for the field math and as
+// a fallback where no GPU is available. Voxels are evaluated four at a time along X with
+// VectorRegister4Float; effector parameters are uniform across the four lanes, so every
+// branch in the kernel stays a scalar branch. Transcendentals use the CPU vector
+// implementations, which differ from GPU intrinsics in the last few ulps.
+//
+// EvaluateAtPosition runs the same lane kernel with the position broadcast, so it returns
+// exactly what BuildAtlas writes for a voxel center (before master gains). When the inputs
+// carry effector tiles, slices loop over each tile's list like the kernel does; point
+// queries always loop over every effector.
+class RSHIPFIELD_API FRshipFieldCpuEvaluator
+{
+public:
+    explicit FRshipFieldCpuEvaluator(const RshipFieldRDG::FGlobalDispatchInputs& Inputs);
+
+    // EvaluateFieldAtPosition: raw field value, master gains not applied.
+    void EvaluateAtPosition(const FVector3f& WorldPosCm, bool bIncludeInfiniteEffectors, float& OutScalar, FVector3f& OutVector) const;
+
+    // World position of a voxel center, computed exactly as the atlas pass does.
+    FVector3f GetVoxelCenter(int32 X, int32 Y, int32 Z) const;
+
+    // BuildGlobalFieldCS for the Resolution x Resolution tile of slice Z, gains applied.
+    // Row Y of the tile starts at OutScalar/OutVector + Y * RowStride.
+    void EvaluateSlice(int32 Z, float* OutScalar, FVector4f* OutVector, int32 RowStride) const;
+
+    // Evaluate the field directly at every position in Batch, gains applied. Unlike the atlas
+    // this is not quantized to voxels; at a voxel center it returns exactly the atlas value.
+    void EvaluatePoints(FRshipFieldPointBatch& Batch) const;
+
+    // BuildGlobalFieldCS over the whole volume, one ParallelFor task per tile.
+    // Like the GPU path, infinite-range effectors are not accumulated.
+    void BuildAtlas(FRshipFieldCpuAtlas& OutAtlas) const;
+
+    // BuildGlobalFieldCS over the listed FRshipFieldEffectorTiles tiles only, as the incremental
+    // dispatch does; the rest of InOutAtlas is left as it is. Rebuilds everything if InOutAtlas
+    // has another layout.
+    void UpdateAtlasTiles(FRshipFieldCpuAtlas& InOutAtlas, TConstArrayView<uint32> Tiles) const;
+
+    int32 GetFieldResolution() const { return FieldResolution; }
+    int32 GetTilesPerRow() const { return TilesPerRow; }
+
+private:
+    // One decoded EffectorData0..7 entry. Everything here is uniform for the dispatch.
+    struct FEffector
+    {
+        FVector3f PositionCm = FVector3f::ZeroVector;
+        float RadiusCm = 0.0f;
+        FVector3f Direction = FVector3f::ZeroVector;
+        float Amplitude = 0.0f;
+        float WavelengthCm = 0.0f;
+        float EnvelopeWidthCm = 0.0f;
+        float PhaseOffset = 0.0f;
+        float Fade = 0.0f;
+        float FalloffExponent = 0.0f;
+        float ClampMin = 0.0f;
+        float ClampMax = 0.0f;
+        float NoiseScale = 0.0f;
+        float NoiseAmplitude = 0.0f;
+        float WaveSpeedCmPerSec = 0.0f;
+        float TemporalPhase = 0.0f;
+        float Temporal = 0.0f;
+        int32 WavefrontOffset = 0;
+        int32 WavefrontCount = 0;
+        // Spline
+        int32 SplineNodeOffset = 0;
+        int32 SplineSegmentOffset = 0;
+        // Ring: axis and in-plane basis, as ComputeRingBasis builds them
+        FVector3f RingAxis = FVector3f::UpVector;
+        FVector3f RingU = FVector3f::ForwardVector;
+        FVector3f RingV = FVector3f::RightVector;
+        float RingRadiusCm = 0.0f;
+        float LobeCount = 0.0f;
+        uint32 Type = 0;
+        uint32 WaveMode = 0;
+        uint32 Waveform = 0;
+        uint32 BlendOp = 0;
+        uint32 NoiseType = 0;
+        bool bEnabled = false;
+        bool bInfiniteRange = false;
+        bool bAffectsScalar = false;
+        bool bAffectsVector = false;
+    };
+
+    struct FLayer
+    {
+        float Weight = 1.0f;
+        float ClampMin = 0.0f;
+        float ClampMax = 0.0f;
+        uint32 BlendOp = 0;
+        bool bEnabled = false;
+    };
+
+    // Four voxels' worth of a float3, one lane each.
+    struct FVectorLanes
+    {
+        VectorRegister4Float X;
+        VectorRegister4Float Y;
+        VectorRegister4Float Z;
+    };
+
+    // EvaluateFieldAtPosition for four positions at once, over the listed effectors.
+    void EvaluateLanes(const FVectorLanes& Position, bool bIncludeInfiniteEffectors, TConstArrayView<uint32> EffectorIndices,
+        VectorRegister4Float& OutScalar, FVectorLanes& OutVector) const;
+
+    // FindClosestOnSpline for four positions: one traversal, descending wherever any lane
+    // could still improve. Lanes with nothing in range get MaxDistanceCm, zero arc and tangent.
+    void FindClosestOnSpline(const FEffector& Eff, const FVectorLanes& Position, float MaxDistanceCm,
+        VectorRegister4Float& OutDistanceCm, VectorRegister4Float& OutArcCm, FVectorLanes& OutTangent) const;
+
+    // BuildGlobalFieldCS for voxels [FirstX, EndX) of row Y in slice Z, gains applied.
+    // Voxel X is written to OutScalar[X] and OutVector[X]; FirstX is a multiple of four.
+    void EvaluateRow(int32 FirstX, int32 EndX, int32 Y, int32 Z, float* OutScalar, FVector4f* OutVector) const;
+
+    // Centers of voxels (X..X+3, Y, Z).
+    FVectorLanes VoxelCenterLanes(int32 X, int32 Y, int32 Z) const;
+
+    float ComputeSyncGroupOffset(int32 SyncGroupIndex) const;
+
+    TArray<FEffector> Effectors;
+    // 0..N-1, the list for unculled evaluation.
+    TArray<uint32> AllEffectorIndices;
+    FRshipFieldEffectorTiles EffectorTiles;
+    TArray<FLayer> Layers;
+    TArray<FVector4f> SyncGroupData;
+    TArray<FVector4f> WavefrontData;
+    TArray<FVector4f> SplineNodeData;
+    TArray<FVector4f> SplineSegmentData;
+
+    int32 FieldResolution = 0;
+    int32 TilesPerRow = 0;
+    float TimeSeconds = 0.0f;
+    float TransportPhase = 0.0f;
+    float MasterScalarGain = 1.0f;
+    float MasterVectorGain = 1.0f;
+    FVector3f DomainMinCm = FVector3f::ZeroVector;
+    FVector3f DomainMaxCm = FVector3f::ZeroVector;
+    int32 DebugMode = 0;
+    int32 DebugSelectionIndex = INDEX_NONE;
+};
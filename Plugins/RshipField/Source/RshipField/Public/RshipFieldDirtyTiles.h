@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RshipFieldEffectorTiles.h"
+
+namespace RshipFieldRDG
+{
+struct FGlobalDispatchInputs;
+}
+
+// Tracks which voxel tiles of the field atlas can have changed since the last dispatch.
+//
+// Each Update hashes every effector's packed parameters together with whatever makes it
+// animate this step (the clock for a moving temporal phase, live wavefronts or noise, its
+// spline path), and compares against the previous Update. Tiles reached by a changed
+// effector's previous or current bounds are dirty; everything else would come out of
+// BuildGlobalFieldCS bit for bit as it already is in the atlas. Tiles are the 8^3 tiles of
+// FRshipFieldEffectorTiles and use its bounds, so the same exactness argument applies.
+//
+// The whole volume is dirty on the first Update, after Invalidate, when anything shared
+// changes (resolution, domain, gains, layers, effector count, the atlas textures), and when
+// a changed effector is global, since it reaches every tile.
+class RSHIPFIELD_API FRshipFieldDirtyTiles
+{
+public:
+    static constexpr int32 TileSize = FRshipFieldEffectorTiles::TileSize;
+
+    // Diffs Inputs against the previous Update and collects the dirty tiles.
+    void Update(const RshipFieldRDG::FGlobalDispatchInputs& Inputs);
+
+    // Forget the previous state, e.g. when the atlas contents were lost. The next Update is full.
+    void Invalidate();
+
+    // Every voxel must be rebuilt; GetDirtyTiles is empty.
+    bool IsFullUpdate() const { return bFullUpdate; }
+
+    // Nothing to rebuild: the atlas is already current.
+    bool IsClean() const { return !bFullUpdate && DirtyTiles.Num() == 0; }
+
+    // Ascending tile indices, FRshipFieldEffectorTiles::GetTileIndex layout.
+    const TArray<uint32>& GetDirtyTiles() const { return DirtyTiles; }
+
+    int32 GetTilesPerAxis() const { return TilesPerAxis; }
+    int32 GetNumTiles() const { return TilesPerAxis * TilesPerAxis * TilesPerAxis; }
+
+    // Voxels the last Update asks to rebuild, clipped to the volume, and their share of it.
+    int64 GetNumDirtyVoxels() const { return NumDirtyVoxels; }
+    float GetDirtyVoxelFraction() const;
+
+private:
+    struct FEffectorState
+    {
+        uint64 Hash = 0;
+        FRshipFieldEffectorTiles::FEffectorBounds Bounds;
+    };
+
+    // Voxels in tile Tile, fewer than TileSize^3 along the far faces.
+    int64 GetTileVoxelCount(int32 Tile) const;
+
+    TArray<FEffectorState> Effectors;
+    TArray<uint32> DirtyTiles;
+    TBitArray<> DirtyMask;
+    uint64 SharedHash = 0;
+    int32 FieldResolution = 0;
+    int32 TilesPerAxis = 0;
+    int64 NumDirtyVoxels = 0;
+    bool bHasPrevious = false;
+    bool bFullUpdate = true;
+};
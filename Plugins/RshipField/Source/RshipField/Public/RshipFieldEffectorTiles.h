@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace RshipFieldRDG
+{
+struct FGlobalDispatchInputs;
+}
+
+// Per-tile effector lists for BuildGlobalFieldCS.
+//
+// The field volume is cut into TileSize^3 voxel tiles and every effector is binned into the
+// tiles its bounds reach, so each voxel only loops over effectors that can touch it. Culling
+// never changes the atlas: an effector is left out of a tile only where its contribution is
+// an exact no-op (zero falloff, an additive blend and a clamp range containing zero) and
+// dropping it cannot change which effector initializes the layer. Everything else is global
+// and listed in every tile. Disabled and infinite-range effectors are never listed, since
+// the atlas pass skips them anyway.
+//
+// Lists are stored compressed: tile T's effectors are Indices[Offsets[T], Offsets[T + 1]),
+// in ascending effector order so blending runs in the same order as the unculled loop.
+class RSHIPFIELD_API FRshipFieldEffectorTiles
+{
+public:
+    // Voxels per tile side. A multiple of the field thread group size, so a group never
+    // straddles two tiles and its effector loop stays uniform.
+    static constexpr int32 TileSize = 8;
+
+    enum class ECull : uint8
+    {
+        // Not evaluated by the atlas pass: disabled or infinite range.
+        Skipped,
+        // Listed in every tile.
+        Global,
+        // Listed in the tiles its bounds overlap.
+        Bounded,
+    };
+
+    // World-space reach of one effector: a sphere for point effectors, a box for paths and rings.
+    struct FEffectorBounds
+    {
+        ECull Cull = ECull::Skipped;
+        FBox3f BoxCm = FBox3f(ForceInit);
+        FVector3f CenterCm = FVector3f::ZeroVector;
+        // Non-zero for point effectors: the sphere around CenterCm, tighter than BoxCm.
+        float SphereRadiusCm = 0.0f;
+
+        bool Overlaps(const FBox3f& RegionCm) const;
+    };
+
+    // Classifies and bounds every effector in Inputs' packed buffers.
+    static TArray<FEffectorBounds> ComputeBounds(const RshipFieldRDG::FGlobalDispatchInputs& Inputs);
+
+    // Calls Visit with every tile of Inputs' resolution and domain that Effector reaches:
+    // all of them for a global effector, none for a skipped one.
+    static void ForEachOverlappedTile(const RshipFieldRDG::FGlobalDispatchInputs& Inputs, const FEffectorBounds& Effector, TFunctionRef<void(int32)> Visit);
+
+    // Bins the effectors of Inputs for its resolution and domain.
+    void Build(const RshipFieldRDG::FGlobalDispatchInputs& Inputs);
+
+    void Reset();
+
+    bool IsBuiltFor(int32 InFieldResolution) const { return FieldResolution == InFieldResolution && Offsets.Num() > 0; }
+
+    int32 GetTilesPerAxis() const { return TilesPerAxis; }
+    int32 GetNumTiles() const { return Offsets.Num() > 0 ? Offsets.Num() - 1 : 0; }
+
+    // Tile holding voxel (X, Y, Z); EffectorTileIndex in RshipFieldCS.usf.
+    int32 GetTileIndex(int32 X, int32 Y, int32 Z) const
+    {
+        return ((Z / TileSize) * TilesPerAxis + Y / TileSize) * TilesPerAxis + X / TileSize;
+    }
+
+    TConstArrayView<uint32> GetTileEffectors(int32 TileIndex) const
+    {
+        return TConstArrayView<uint32>(Indices.GetData() + Offsets[TileIndex], Offsets[TileIndex + 1] - Offsets[TileIndex]);
+    }
+
+    // Shader layout: TileEffectorOffsets and TileEffectorIndices.
+    const TArray<uint32>& GetOffsets() const { return Offsets; }
+    const TArray<uint32>& GetIndices() const { return Indices; }
+
+private:
+    TArray<uint32> Offsets;
+    TArray<uint32> Indices;
+    int32 FieldResolution = 0;
+    int32 TilesPerAxis = 0;
+};
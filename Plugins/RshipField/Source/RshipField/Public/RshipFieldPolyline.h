@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USplineComponent;
+
+// Closest point on a polyline, as returned by FRshipFieldPolyline::FindClosest.
+struct FRshipFieldPolylineHit
+{
+    int32 SegmentIndex = INDEX_NONE;
+    float DistanceCm = MAX_flt;
+    // Distance along the path from its first point to the closest point.
+    float ArcLengthCm = 0.0f;
+    FVector3f ClosestPointCm = FVector3f::ZeroVector;
+    // Unit direction of the closest segment.
+    FVector3f Tangent = FVector3f::ZeroVector;
+
+    bool IsValid() const { return SegmentIndex != INDEX_NONE; }
+};
+
+// Piecewise-linear path with a bounding volume hierarchy over its segments, for
+// distance-to-path and arc-length queries from spline effectors.
+//
+// Segments are stored in leaf order; each knows its arc length at the start, so a hit
+// reports how far along the path it is regardless of where the segment ended up. The tree
+// is built by median split on the longest centroid axis, which keeps it balanced and its
+// depth at log2(segments / LeafSize), and is traversed in a fixed order so ties between
+// equally close segments always resolve the same way. Pack writes the same tree into the
+// SplineNodeData/SplineSegmentData layout read by RshipFieldCS.usf.
+class RSHIPFIELD_API FRshipFieldPolyline
+{
+public:
+    static constexpr int32 LeafSize = 4;
+
+    // Deep enough for any tree Build produces: 2^32 leaves would be needed to exceed it.
+    static constexpr int32 MaxDepth = 32;
+
+    // Replaces the path. Consecutive duplicate points are skipped; bClosedLoop adds a
+    // segment from the last point back to the first.
+    void Build(TConstArrayView<FVector3f> PointsCm, bool bClosedLoop);
+
+    // Samples Spline in world space with curvature-adaptive steps: no point of the curve is
+    // farther than ToleranceCm from the resulting polyline.
+    void BuildFromSpline(const USplineComponent& Spline, float ToleranceCm);
+
+    void Reset();
+
+    // Closest segment to PositionCm within MaxDistanceCm. An invalid hit when there is none.
+    FRshipFieldPolylineHit FindClosest(const FVector3f& PositionCm, float MaxDistanceCm = MAX_flt) const;
+
+    int32 GetNumSegments() const { return SegmentStart.Num(); }
+    int32 GetNumNodes() const { return Nodes.Num(); }
+    float GetLengthCm() const { return LengthCm; }
+    bool IsClosedLoop() const { return bClosed; }
+    FBox3f GetBounds() const { return Nodes.Num() > 0 ? Nodes[0].Bounds : FBox3f(ForceInit); }
+
+    // The path's points in path order, without the closing point of a loop. Build on them with
+    // IsClosedLoop reproduces this polyline exactly.
+    void GetPathPoints(TArray<FVector3f>& OutPointsCm) const;
+
+    // Appends the tree and segments in shader layout. Child and segment indices are relative
+    // to the effector's own range, so several polylines can share the two buffers.
+    //   Node: (Min.xyz, First), (Max.xyz, Count). Count 0: children at First and First + 1.
+    //   Segment: (Start.xyz, ArcStart), (End.xyz, Length)
+    void Pack(TArray<FVector4f>& OutNodeData, TArray<FVector4f>& OutSegmentData) const;
+
+    // Hash of the source the polyline was built from, set by the owner to skip rebuilds.
+    uint32 SourceHash = 0;
+
+private:
+    struct FNode
+    {
+        FBox3f Bounds = FBox3f(ForceInit);
+        int32 First = 0;
+        // Segments in a leaf; 0 for interior nodes.
+        int32 Count = 0;
+    };
+
+    void BuildNode(int32 NodeIndex, int32 First, int32 Count, TArray<int32>& Order, const TArray<FVector3f>& Centroids);
+
+    TArray<FNode> Nodes;
+    TArray<FVector3f> SegmentStart;
+    TArray<FVector3f> SegmentEnd;
+    TArray<float> SegmentArcStart;
+    float LengthCm = 0.0f;
+    bool bClosed = false;
+};
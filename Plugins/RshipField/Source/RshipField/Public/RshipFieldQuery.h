@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+
+class FRshipFieldCpuEvaluator;
+
+// Field values for one query, parallel to its positions, master gains applied.
+struct RSHIPFIELD_API FRshipFieldQueryResult
+{
+    TArray<float> Scalar;
+    TArray<FVector3f> Vector;
+
+    // False when the query was dropped before it could be evaluated (the field went away);
+    // the arrays are empty then.
+    bool bValid = false;
+
+    int32 Num() const { return Scalar.Num(); }
+};
+
+// Point queries against one field, collected over a frame and evaluated as one batch.
+//
+// Flush packs every query submitted since the last flush into a single FRshipFieldPointBatch
+// and evaluates it with FRshipFieldCpuEvaluator::EvaluatePoints on a worker thread, then
+// fulfils each query's future with its own slice of the results. The task keeps the evaluator
+// alive, so the owner can replace its own on the next step without waiting. Submit and Flush
+// are game thread only; the futures can be polled or waited on from any thread.
+class RSHIPFIELD_API FRshipFieldQueryQueue
+{
+public:
+    FRshipFieldQueryQueue() = default;
+    FRshipFieldQueryQueue(FRshipFieldQueryQueue&&) = default;
+    FRshipFieldQueryQueue& operator=(FRshipFieldQueryQueue&&) = default;
+
+    // Pending queries are cancelled.
+    ~FRshipFieldQueryQueue();
+
+    TFuture<FRshipFieldQueryResult> Submit(TArray<FVector> PositionsCm);
+
+    // Launches the pending queries against Evaluator. Without an evaluator they stay pending.
+    // Returns the number of points launched.
+    int32 Flush(TSharedPtr<const FRshipFieldCpuEvaluator> Evaluator);
+
+    // Fulfils every pending query with an invalid result.
+    void Cancel();
+
+    int32 GetNumPending() const { return Pending.Num(); }
+
+private:
+    struct FQuery
+    {
+        TArray<FVector> PositionsCm;
+        TPromise<FRshipFieldQueryResult> Promise;
+    };
+
+    TArray<FQuery> Pending;
+};
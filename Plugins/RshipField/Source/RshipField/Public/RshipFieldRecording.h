@@ -0,0 +1,130 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/StrongObjectPtr.h"
+
+class FRshipFieldRecordedProperty;
+class URshipFieldComponent;
+struct FRshipFieldCpuAtlas;
+
+namespace RshipFieldRDG
+{
+struct FGlobalDispatchInputs;
+}
+
+// A recorded stretch of a field's simulation that can be replayed step for step.
+//
+// State S is the field after S recorded steps: state 0 is the field when recording started, and
+// state S + 1 is state S with StepEvents[S] applied and then one RshipFieldSimulation::Step.
+// Events are changes to the recorded component properties, the effector arrays per element,
+// and EmitWavefront triggers, in the order they happened. Keyframe K is the whole of state
+// K * KeyframeInterval, including live wavefronts, so a seek replays at most KeyframeInterval
+// steps. Values are tagged-property serialized, so adding a field to an effector struct keeps
+// old recordings loadable.
+struct RSHIPFIELD_API FRshipFieldRecording
+{
+    static constexpr uint32 Magic = 0x52534652; // "RSFR"
+    static constexpr int32 Version = 2;
+
+    // URshipFieldComponent properties the recording tracks; events and keyframes address them by index.
+    TArray<FName> PropertyNames;
+
+    int32 KeyframeInterval = 60;
+
+    TArray<TArray<uint8>> StepEvents;
+    TArray<TArray<uint8>> Keyframes;
+
+    int32 GetNumSteps() const { return StepEvents.Num(); }
+
+    bool SaveToFile(const FString& FilePath) const;
+    bool LoadFromFile(const FString& FilePath);
+
+    // Sets the archive's error flag when loading a file with the wrong magic or version.
+    friend RSHIPFIELD_API FArchive& operator<<(FArchive& Ar, FRshipFieldRecording& Recording);
+};
+
+// Records a field while it runs. The subsystem calls BeginStep and EndStep around each
+// simulation step, and URshipFieldComponent::EmitWavefront reports its triggers.
+//
+// Changes are found by diffing the serialized properties against the last step, so whatever
+// changed them (rship actions, Blueprint, the editor) is recorded the same way. Spline effectors
+// that follow a SplineActor are recorded as the sampled path in PointsCm, so a replay needs
+// neither the actor nor a world.
+class RSHIPFIELD_API FRshipFieldRecorder
+{
+public:
+    static constexpr int32 DefaultKeyframeInterval = 60;
+
+    // Starts recording at Field's current state, which becomes keyframe 0.
+    explicit FRshipFieldRecorder(URshipFieldComponent& Field, int32 KeyframeInterval = DefaultKeyframeInterval);
+
+    // Records what changed since the previous step as this step's events.
+    void BeginStep(URshipFieldComponent& Field);
+
+    // Takes in the step's own changes (clock, emit-once triggers) without recording them, and
+    // adds a keyframe when one is due.
+    void EndStep(URshipFieldComponent& Field);
+
+    // Called before the wavefront is emitted. Triggers from inside a step are the step's own and
+    // replay by themselves.
+    void RecordEmitWavefront(URshipFieldComponent& Field, int32 WaveEffectorIndex);
+
+    const FRshipFieldRecording& GetRecording() const { return Recording; }
+
+private:
+    // Serializes every property into Values, writing an event for each difference to Events
+    // when given.
+    void CaptureChanges(URshipFieldComponent& Field, TArray<uint8>* Events);
+
+    void AddKeyframe(URshipFieldComponent& Field);
+
+    TArray<uint8> SaveElement(const URshipFieldComponent& Field, int32 PropertyIndex, int32 Element) const;
+
+    FRshipFieldRecording Recording;
+    TArray<TSharedPtr<const FRshipFieldRecordedProperty>> Properties;
+
+    // Last recorded value of each property, one entry per element for arrays.
+    TArray<TArray<TArray<uint8>>> Values;
+
+    // Events for the next step, written ahead of it by wavefront triggers.
+    TArray<uint8> PendingEvents;
+    bool bInStep = false;
+};
+
+// Replays a recording on a transient field component of its own, which is never registered, so
+// nothing but the replayer steps it. Built and used on the game thread.
+class RSHIPFIELD_API FRshipFieldReplayer
+{
+public:
+    // Starts at state 0.
+    explicit FRshipFieldReplayer(FRshipFieldRecording InRecording);
+    ~FRshipFieldReplayer();
+
+    int32 GetNumSteps() const { return Recording.GetNumSteps(); }
+    int32 GetCurrentStep() const { return CurrentStep; }
+
+    // Moves to state Step, clamped to the recording, from the nearest keyframe before it or
+    // from the current state when that is nearer.
+    void Seek(int32 Step);
+
+    // Applies the next step's events and runs it. False once every step has been replayed.
+    bool StepForward();
+
+    // The current state as the subsystem would dispatch it, and that dispatch evaluated on the CPU.
+    void BuildGlobalInputs(RshipFieldRDG::FGlobalDispatchInputs& OutInputs);
+    void BuildAtlas(FRshipFieldCpuAtlas& OutAtlas);
+
+    const URshipFieldComponent& GetField() const { return *Field; }
+
+private:
+    void ApplyKeyframe(int32 Keyframe);
+    void ApplyEvents(TConstArrayView<uint8> Events);
+
+    FRshipFieldRecording Recording;
+
+    // By recording property index; null for properties the component no longer has.
+    TArray<TSharedPtr<const FRshipFieldRecordedProperty>> Properties;
+
+    TStrongObjectPtr<URshipFieldComponent> Field;
+    int32 CurrentStep = 0;
+};
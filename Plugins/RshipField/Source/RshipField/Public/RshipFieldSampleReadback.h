@@ -0,0 +1,108 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+// Stable sampler -> slot assignment for the GPU point-sample buffer.
+//
+// A sampler keeps its slot for as long as it is acquired every frame, so results read back
+// a frame or two later still land on the right sampler. Released slots are reused. The
+// slot's generation is bumped on release and again on reuse, so readbacks submitted under
+// the previous owner or while the slot was free can tell.
+// Capacity only grows, doubling, so the GPU results buffer is reallocated rarely.
+class RSHIPFIELD_API FRshipFieldSampleSlots
+{
+public:
+    explicit FRshipFieldSampleSlots(int32 InMinCapacity = 64);
+
+    // Starts a sync pass: samplers not acquired before EndFrame lose their slot.
+    void BeginFrame();
+
+    // Slot of Sampler, assigning one if it has none.
+    int32 Acquire(FObjectKey Sampler);
+
+    // Releases every slot not acquired since BeginFrame. Returns how many were released.
+    int32 EndFrame();
+
+    bool Release(FObjectKey Sampler);
+
+    int32 Find(FObjectKey Sampler) const;
+
+    bool IsUsed(int32 Slot) const { return Slots.IsValidIndex(Slot) && Slots[Slot].bUsed; }
+    FObjectKey GetOwner(int32 Slot) const { return IsUsed(Slot) ? Slots[Slot].Owner : FObjectKey(); }
+    uint32 GetGeneration(int32 Slot) const { return Slots[Slot].Generation; }
+
+    // Slots ever handed out; the sample pass dispatches this many.
+    int32 GetNumSlots() const { return Slots.Num(); }
+    int32 GetNumUsed() const { return SlotByOwner.Num(); }
+
+    // Power of two >= GetNumSlots(), never shrinks.
+    int32 GetCapacity() const { return Capacity; }
+
+private:
+    struct FSlot
+    {
+        FObjectKey Owner;
+        uint32 Generation = 0;
+        uint32 LastFrame = 0;
+        bool bUsed = false;
+    };
+
+    void ReleaseSlot(int32 Slot);
+
+    TArray<FSlot> Slots;
+    TMap<FObjectKey, int32> SlotByOwner;
+    TArray<int32> FreeSlots;
+    int32 Capacity = 0;
+    uint32 Frame = 0;
+};
+
+// Latency bookkeeping for a ring of in-flight GPU readbacks.
+//
+// Entries are claimed on submit and retired in submission order once their data arrives.
+// When every entry is still in flight a submit is refused rather than waiting on the GPU.
+// Each entry remembers the slot generations it was submitted with, so a result whose slot
+// changed owner in between is dropped instead of applied to the wrong sampler.
+class RSHIPFIELD_API FRshipFieldReadbackRing
+{
+public:
+    static constexpr int32 DefaultDepth = 3;
+
+    explicit FRshipFieldReadbackRing(int32 InDepth = DefaultDepth);
+
+    // Claims the next entry for a readback of every slot, submitted on Frame.
+    // INDEX_NONE when the ring is full.
+    int32 Submit(uint64 Frame, const FRshipFieldSampleSlots& Slots);
+
+    // Oldest in-flight entry, INDEX_NONE when nothing is in flight.
+    int32 GetOldest() const;
+
+    // Whether Slot still belongs to the sampler that owned it when Index was submitted.
+    bool IsSlotCurrent(int32 Index, int32 Slot, const FRshipFieldSampleSlots& Slots) const;
+
+    int32 GetNumSamples(int32 Index) const { return Entries[Index].Generations.Num(); }
+
+    // Retires Index, which must be the oldest entry. Returns its latency in frames.
+    int32 Complete(int32 Index, uint64 Frame);
+
+    int32 GetDepth() const { return Entries.Num(); }
+    int32 GetNumInFlight() const { return NumInFlight; }
+
+    // Submits refused because the ring was full.
+    int32 GetNumDropped() const { return NumDropped; }
+
+    int32 GetLastLatency() const { return LastLatency; }
+
+private:
+    struct FEntry
+    {
+        uint64 SubmitFrame = 0;
+        TArray<uint32> Generations;
+    };
+
+    TArray<FEntry> Entries;
+    int32 OldestIndex = 0;
+    int32 NumInFlight = 0;
+    int32 NumDropped = 0;
+    int32 LastLatency = 0;
+};
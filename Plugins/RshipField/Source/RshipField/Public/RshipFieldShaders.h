@@ -2,8 +2,12 @@
 
 #include "CoreMinimal.h"
 #include "RHIResources.h"
+#include "RenderGraphResources.h"
+#include "RshipFieldEffectorTiles.h"
+#include "RshipFieldTypes.h"
 
 class FRDGBuilder;
+class FRHIGPUBufferReadback;
 
 namespace RshipFieldRDG
 {
@@ -41,12 +45,27 @@ struct FGlobalDispatchInputs
     TArray<FVector4f> EffectorData4;
     TArray<FVector4f> EffectorData5;
     TArray<FVector4f> EffectorData6;
-    TArray<FVector4f> EffectorData7; // WavefrontOffset, WavefrontCount, WaveSpeedCmPerSec, EnvelopeWidthCm (WaveMode is in E3.w)
+    TArray<FVector4f> EffectorData7; // Wave: WavefrontOffset, WavefrontCount, WaveSpeedCmPerSec. Spline/Ring: see RshipFieldCS.usf
 
     // Flat wavefront buffer — all effectors' wavefronts packed sequentially.
     // Per wavefront: (BirthTime, BirthPosX, BirthPosY, BirthPosZ)
     TArray<FVector4f> WavefrontData;
 
+    // Flat spline effector paths, FRshipFieldPolyline::Pack layout. Each spline effector's
+    // E7 holds its first node and segment.
+    TArray<FVector4f> SplineNodeData;
+    TArray<FVector4f> SplineSegmentData;
+
+    // Effectors binned per voxel tile, built after packing. When not built for FieldResolution
+    // every voxel loops over every effector.
+    FRshipFieldEffectorTiles EffectorTiles;
+
+    // Incremental update from FRshipFieldDirtyTiles. When set, the atlas pass only rebuilds
+    // DirtyTiles (ascending, FRshipFieldEffectorTiles::GetTileIndex layout) and the rest of the
+    // atlas keeps what the previous dispatch wrote; no tiles means no atlas pass at all.
+    bool bDirtyTilesOnly = false;
+    TArray<uint32> DirtyTiles;
+
     bool IsValid() const
     {
         return FieldResolution > 0
@@ -104,17 +123,84 @@ struct FPointSampleInputs
 
     FTextureRHIRef ScalarAtlasTexture;
     FTextureRHIRef VectorAtlasTexture;
-    FTextureRHIRef OutResultsTexture;
 
     TArray<FVector4f> Positions;
+
+    bool IsValid() const
+    {
+        return NumSamples > 0
+            && static_cast<int32>(NumSamples) <= Positions.Num()
+            && ScalarAtlasTexture.IsValid()
+            && VectorAtlasTexture.IsValid();
+    }
 };
 
+// Render-thread side of GPU light sampling. Point samples are written into a persistent
+// results buffer that grows by doubling, then copied into one of a fixed set of staging
+// readbacks. Finished readbacks are handed to the game thread through TakeCompleted,
+// oldest first; nothing here ever waits on the GPU.
+class RSHIPFIELD_API FPointSampleReadbackQueue
+{
+public:
+    struct FCompleted
+    {
+        int32 Index = INDEX_NONE;
+        // (scalar, vector) per sample, empty if the pass could not run.
+        TArray<FVector4f> Results;
+    };
+
+    explicit FPointSampleReadbackQueue(int32 NumReadbacks);
+    ~FPointSampleReadbackQueue();
+
+    // Render thread. Samples Inputs into the results buffer, sized for at least Capacity
+    // samples, and queues a copy into readback Index.
+    void Submit(FRDGBuilder& GraphBuilder, const FPointSampleInputs& Inputs, int32 Capacity, int32 Index);
+
+    // Render thread. Moves readbacks the GPU has finished into the completed list.
+    void Poll();
+
+    // Game thread.
+    void TakeCompleted(TArray<FCompleted>& OutCompleted);
+
+private:
+    struct FPending
+    {
+        int32 Index = INDEX_NONE;
+        int32 NumSamples = 0;
+    };
+
+    void AddCompleted(FCompleted&& Completed);
+
+    TArray<TUniquePtr<FRHIGPUBufferReadback>> Readbacks;
+    TArray<FPending> Pending;
+    TRefCountPtr<FRDGPooledBuffer> ResultsBuffer;
+    int32 ResultsCapacity = 0;
+
+    FCriticalSection CompletedLock;
+    TArray<FCompleted> Completed;
+};
+
+// Fill the sync group, layer and effector buffers of GlobalInputs from typed inputs.
+// Index 0 is the free-running sync group; effectors whose SyncGroup id is unknown use it.
+// Wavefront and spline offsets are taken from the descs as-is; WavefrontData and the spline
+// buffers are left untouched.
+// SyncGroupBeats, parallel to SyncGroups, is each group's transport position in beats. Groups
+// that have one get their phase resolved here in double precision; the rest follow
+// GlobalInputs.TransportPhase on the GPU.
+RSHIPFIELD_API void PackEffectorInputs(
+    FGlobalDispatchInputs& GlobalInputs,
+    const TArray<FRshipFieldSyncGroup>& SyncGroups,
+    const TArray<FRshipFieldEffectorDesc>& Effectors,
+    TConstArrayView<double> SyncGroupBeats = TConstArrayView<double>());
+
 void AddFieldPasses(
     FRDGBuilder& GraphBuilder,
     const FGlobalDispatchInputs& GlobalInputs,
     const TArray<FTargetDispatchInputs>& TargetInputs);
 
+// Writes float4(scalar, vector) per position into OutResults, which holds at least NumSamples elements.
 void AddPointSamplePass(
     FRDGBuilder& GraphBuilder,
-    const FPointSampleInputs& Inputs);
+    const FPointSampleInputs& Inputs,
+    FRDGBufferRef OutResults);
 }
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class URshipFieldComponent;
+struct FRshipFieldEffectorDesc;
+
+namespace RshipFieldRDG
+{
+struct FGlobalDispatchInputs;
+}
+
+// The fixed-timestep simulation of a field, shared by the subsystem and recording replay so
+// a replayed step runs exactly the code the live one did. Only the field's own state is read
+// or written; nothing here needs a world.
+namespace RshipFieldSimulation
+{
+// Length of one simulation step at the field's UpdateHz.
+RSHIPFIELD_API float GetStepSeconds(const URshipFieldComponent& Field);
+
+// Advances Field by one step: the clock, the field's transport and each of Transports, and
+// traveling wavefronts (dispersion sync, emit-once triggers, auto-emit and expiry).
+RSHIPFIELD_API void Step(URshipFieldComponent& Field);
+
+// Current position in beats of the transport with TransportId, at full precision. An empty or
+// unknown Id is the field's own transport. A BeatPhase written since the last step is returned
+// as written.
+RSHIPFIELD_API double GetTransportBeat(const URshipFieldComponent& Field, const FString& TransportId);
+
+// Resamples the SplinePolylines of spline effectors whose path source changed since the last
+// call, and sizes SplinePolylines to match SplineEffectors.
+RSHIPFIELD_API void UpdateSplinePaths(URshipFieldComponent& Field);
+
+// Packs Field's current state for BuildGlobalFieldCS: effectors, sync groups at their
+// transports' beats, wavefronts, spline paths (through UpdateSplinePaths) and, with
+// bCullEffectorsByTile, the effector tiles. The atlas textures are left for the caller.
+// OutEffectors, when given, receives the flattened effectors in packed order.
+RSHIPFIELD_API void BuildGlobalInputs(URshipFieldComponent& Field, RshipFieldRDG::FGlobalDispatchInputs& OutInputs,
+    TArray<FRshipFieldEffectorDesc>* OutEffectors = nullptr);
+}
@@ -2,12 +2,16 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "RshipFieldCpuEvaluator.h"
+#include "RshipFieldDirtyTiles.h"
+#include "RshipFieldQuery.h"
 #include "RshipFieldTypes.h"
+#include "UObject/ObjectKey.h"
 #include "RshipFieldSubsystem.generated.h"
 
 class URshipFieldComponent;
 class URshipFieldLightSampler;
-class UTextureRenderTarget2D;
+struct FRshipFieldGpuLightSampling;
 
 UCLASS()
 class RSHIPFIELD_API URshipFieldSubsystem : public UWorldSubsystem
@@ -29,21 +33,48 @@ public:
     // Called by field components each tick.
     void TickField(URshipFieldComponent* Field, float DeltaTime);
 
-    // Dispatch point sample pass and distribute results to light samplers.
+    // Sample the field at every light sampler bound to it and apply the results.
     void DistributeLightSamplerResults(URshipFieldComponent* Field);
 
+    // Samples Field at every position, master gains applied, against its latest simulation
+    // step. Queries made in one frame are evaluated together on a worker thread once the field
+    // has ticked, and the future is fulfilled there. The result is invalid if Field is not
+    // registered or is unregistered before then.
+    TFuture<FRshipFieldQueryResult> QueryField(URshipFieldComponent* Field, TArray<FVector> PositionsCm);
+
 private:
     void DispatchFieldPasses(URshipFieldComponent* Field);
 
+    // ERshipFieldSampleMode::Gpu: point-sample pass over the atlas. Results come back through
+    // a readback ring and are applied one to two frames late.
+    void SampleLightSamplersOnGpu(URshipFieldComponent* Field);
+
+    // Hands the field's readbacks to the render thread for destruction.
+    void ReleaseGpuLightSampling(TObjectKey<URshipFieldComponent> Field);
+
+    // Publishes the field's finished probe query and queries the probes again.
+    void UpdateProbes(URshipFieldComponent* Field);
+
     UPROPERTY(Transient)
     TArray<TObjectPtr<URshipFieldComponent>> RegisteredFields;
 
     UPROPERTY(Transient)
     TArray<TObjectPtr<URshipFieldLightSampler>> RegisteredLightSamplers;
 
-    // Tiny Nx1 render target for point sample results
-    UPROPERTY(Transient)
-    TObjectPtr<UTextureRenderTarget2D> PointSampleRT = nullptr;
+    // Per-field GPU sampling state, only for fields in ERshipFieldSampleMode::Gpu.
+    TMap<TObjectKey<URshipFieldComponent>, TSharedPtr<FRshipFieldGpuLightSampling>> GpuLightSampling;
+
+    // Effector inputs from each field's last step, evaluated on the CPU for light samplers and
+    // queries. Shared with the query tasks still running on a previous step.
+    TMap<TObjectKey<URshipFieldComponent>, TSharedPtr<const FRshipFieldCpuEvaluator>> CpuEvaluators;
+
+    // Point queries made against each field since its last tick.
+    TMap<TObjectKey<URshipFieldComponent>, FRshipFieldQueryQueue> Queries;
+
+    // Atlas tiles each incrementally updated field needs rebuilt, diffed against its last dispatch.
+    TMap<TObjectKey<URshipFieldComponent>, FRshipFieldDirtyTiles> DirtyTiles;
 
-    TArray<FColor> PointSamplePixels;
+    // Reused across ticks: samplers bound to the field being distributed, parallel to LightSampleBatch.
+    TArray<URshipFieldLightSampler*> LightSampleTargets;
+    FRshipFieldPointBatch LightSampleBatch;
 };
@@ -58,6 +58,25 @@ enum class ERshipFieldResolution : uint8
     Res512 UMETA(DisplayName = "512")
 };
 
+UENUM(BlueprintType)
+enum class ERshipFieldSampleMode : uint8
+{
+    // Effectors are evaluated on the CPU at each sampler's exact position.
+    Cpu UMETA(DisplayName = "CPU"),
+    // Samplers read the GPU atlas through a point-sample pass.
+    Gpu UMETA(DisplayName = "GPU Atlas")
+};
+
+UENUM(BlueprintType)
+enum class ERshipFieldClockSource : uint8
+{
+    // Runs at the transport's Bpm.
+    Internal UMETA(DisplayName = "Internal"),
+    // Follows positions reported from outside (rship, a timecode or MIDI clock bridge) and
+    // free-runs at the reported tempo between reports, up to ExternalTimeoutSeconds.
+    External UMETA(DisplayName = "External")
+};
+
 inline int32 GetFieldResolutionValue(ERshipFieldResolution Res)
 {
     switch (Res)
@@ -164,9 +183,18 @@ struct RSHIPFIELD_API FRshipFieldWaveEffector
     float EnvelopeWidthCm = 500.0f;
 
     // Max concurrent wavefronts. Higher = more ripples in flight, more GPU cost per voxel.
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field", meta = (ClampMin = "1", ClampMax = "64", EditCondition = "WaveMode == ERshipFieldWaveMode::Traveling"))
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field", meta = (ClampMin = "1", ClampMax = "16", EditCondition = "WaveMode == ERshipFieldWaveMode::Traveling"))
     int32 MaxWavefronts = 16;
 
+    // Traveling: rewrite the derived member of (speed, frequency, wavelength) so switching
+    // Derive doesn't jump.
+    void SyncDispersion();
+
+    // Seconds until a wavefront has traveled past RadiusCm at the current speed.
+    float GetMaxWavefrontAge() const
+    {
+        return RadiusCm / FMath::Max(WaveSpeedCmPerSec, 0.1f);
+    }
 };
 
 USTRUCT(BlueprintType)
@@ -230,6 +258,114 @@ struct RSHIPFIELD_API FRshipFieldAttractorEffector
     FString SyncGroup;
 };
 
+// Waves running along a path: W(2π·s/λ - ωt), s = distance along the path to the closest
+// point, fading with distance from the path. Closed paths round the wavelength so a whole
+// number of waves fits around the loop.
+USTRUCT(BlueprintType)
+struct RSHIPFIELD_API FRshipFieldSplineEffector
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    bool bEnabled = true;
+
+    // Actor whose first spline component defines the path. Takes precedence over PointsCm.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    TSoftObjectPtr<AActor> SplineActor;
+
+    // World-space path used when there is no spline actor.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    TArray<FVector> PointsCm;
+
+    // PointsCm only; spline actors use the spline's own closed-loop setting.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    bool bClosedLoop = false;
+
+    // Max distance between the spline and its sampled polyline.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field", meta = (ClampMin = "0.1"))
+    float ToleranceCm = 1.0f;
+
+    // Distance from the path at which the effect reaches zero.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field", meta = (ClampMin = "0.0"))
+    float RadiusCm = 300.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field", meta = (ClampMin = "0.0"))
+    float FalloffExponent = 1.0f;
+
+    // Vector field direction. Zero = along the path.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    FVector Polarization = FVector::ZeroVector;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    ERshipFieldWaveform Waveform = ERshipFieldWaveform::Sine;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    float Amplitude = 1.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    float PhaseOffset = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field", meta = (ClampMin = "0.001"))
+    float WavelengthCm = 500.0f;
+
+    // Waves travel along the path at FrequencyHz × WavelengthCm. Negative runs backwards.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    float FrequencyHz = 1.0f;
+
+    // Sync group for tempo-locked travel. Empty = free-running.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    FString SyncGroup;
+};
+
+// Lobes orbiting an axis: W(n·θ - ωt), θ = angle around the axis, fading with distance
+// from the ring. Same pattern as the rotunda deformer's orbital field. The vector field
+// points away from the axis.
+USTRUCT(BlueprintType)
+struct RSHIPFIELD_API FRshipFieldRingEffector
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    bool bEnabled = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    FVector CenterCm = FVector::ZeroVector;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    FVector Axis = FVector::UpVector;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field", meta = (ClampMin = "0.0"))
+    float RingRadiusCm = 1000.0f;
+
+    // Distance from the ring at which the effect reaches zero.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field", meta = (ClampMin = "0.0"))
+    float RadiusCm = 300.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field", meta = (ClampMin = "0.0"))
+    float FalloffExponent = 1.0f;
+
+    // Wave crests around the ring. 0 = the whole ring pulses together.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field", meta = (ClampMin = "0"))
+    int32 LobeCount = 3;
+
+    // Phase advance in radians per second. The lobes orbit at Speed / LobeCount rad/s.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    float Speed = 1.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    ERshipFieldWaveform Waveform = ERshipFieldWaveform::Sine;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    float Amplitude = 1.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    float PhaseOffset = 0.0f;
+
+    // Sync group for tempo-locked orbiting. Empty = free-running.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    FString SyncGroup;
+};
+
 // ============================================================================
 // Internal effector (GPU pipeline, not directly artist-facing)
 // ============================================================================
@@ -239,7 +375,9 @@ enum class ERshipFieldEffectorType : uint8
 {
     Wave,
     Noise,
-    Attractor
+    Attractor,
+    Spline,
+    Ring
 };
 
 // Single active wavefront for a traveling-mode effector.
@@ -249,10 +387,99 @@ struct FRshipFieldWavefront
     FVector BirthPositionCm = FVector::ZeroVector;
 };
 
+// Live wavefronts of one traveling effector, oldest first, in a fixed inline ring.
+//
+// Every wavefront is stored already packed for WavefrontData (birth time, birth position)
+// and written twice, at its slot and one capacity further on, so the live range is always
+// contiguous and can be uploaded without reordering. Emit and expire are O(1) per wavefront.
+// All wavefronts of an effector share the current wave speed, so age order is expiry order:
+// expiry only ever looks at the front.
+class RSHIPFIELD_API FRshipFieldWavefrontRing
+{
+public:
+    static constexpr int32 Capacity = 16;
+
+    // Appends a wavefront, evicting the oldest ones so at most MaxWavefronts (clamped to
+    // Capacity) remain. A birth time earlier than the newest wavefront means the simulation
+    // clock was reset; the ring is cleared first so it stays in birth order.
+    void Emit(float BirthTime, const FVector& BirthPositionCm, int32 MaxWavefronts);
+
+    // Drops every wavefront older than MaxAgeSeconds at Now. Returns how many were dropped.
+    int32 Expire(float Now, float MaxAgeSeconds);
+
+    // When the oldest wavefront will reach MaxAgeSeconds, or MAX_flt when empty.
+    float GetNextExpiryTime(float MaxAgeSeconds) const;
+
+    void Reset();
+
+    int32 Num() const { return Count; }
+    bool IsEmpty() const { return Count == 0; }
+
+    // Index 0 is the oldest wavefront.
+    FRshipFieldWavefront operator[](int32 Index) const;
+
+    // Live wavefronts in WavefrontData layout, oldest first.
+    TConstArrayView<FVector4f> GetUploadView() const
+    {
+        return TConstArrayView<FVector4f>(Packed + Head, Count);
+    }
+
+private:
+    FVector4f Packed[Capacity * 2];
+    int32 Head = 0;
+    int32 Count = 0;
+};
+
+// Beat position of a transport, resolved without accumulating rounding error.
+//
+// The beat is never summed step by step. It is AnchorBeat plus the steps since AnchorTick
+// times the beats per step, in double precision, so hours of runtime land on the same beat a
+// single multiplication would give. A change of step length, tempo or play state re-anchors
+// at the current beat first, so the position stays continuous and only its slope changes.
+class RSHIPFIELD_API FRshipFieldTransportClock
+{
+public:
+    // Settings for the following steps. MaxFreewheelSeconds < 0 runs without limit; otherwise
+    // the clock holds once that long has passed since the last anchor.
+    void Configure(double InStepSeconds, double InBpm, bool bInPlaying, double InMaxFreewheelSeconds = -1.0);
+
+    // Jumps to Beat and anchors there.
+    void Locate(double Beat);
+
+    void Advance() { ++Tick; }
+
+    double GetBeat() const;
+    double GetBpm() const { return Bpm; }
+    bool IsPlaying() const { return bPlaying; }
+
+    // The beat rounded for a float BeatPhase property, with the transport's report count.
+    float Publish(int32 SyncCount = 0);
+    float GetPublishedBeat() const { return PublishedBeat; }
+
+    // The property was written from outside since the last Publish: it holds another beat, or
+    // a new report arrived, possibly at the beat the clock already had.
+    bool WasMoved(float BeatPhase, int32 SyncCount = 0) const { return BeatPhase != PublishedBeat || SyncCount != PublishedSyncCount; }
+
+    friend RSHIPFIELD_API FArchive& operator<<(FArchive& Ar, FRshipFieldTransportClock& Clock);
+
+private:
+    void Rebase();
+
+    double AnchorBeat = 0.0;
+    int64 AnchorTick = 0;
+    int64 Tick = 0;
+    double StepSeconds = 0.0;
+    double Bpm = 0.0;
+    double MaxFreewheelSeconds = -1.0;
+    bool bPlaying = false;
+    float PublishedBeat = 0.0f;
+    int32 PublishedSyncCount = 0;
+};
+
 // Per-effector runtime state for traveling wave management.
 struct FRshipFieldWaveEffectorState
 {
-    TArray<FRshipFieldWavefront> Wavefronts;
+    FRshipFieldWavefrontRing Wavefronts;
     float LastEmitTime = -1e6f;
 };
 
@@ -292,10 +519,21 @@ struct RSHIPFIELD_API FRshipFieldEffectorDesc
     int32 WavefrontOffset = 0;
     int32 WavefrontCount = 0;
 
+    // Spline: set by subsystem at dispatch time — first node/segment in the flat spline buffers.
+    int32 SplineNodeOffset = 0;
+    int32 SplineSegmentOffset = 0;
+
+    // Ring. The ring axis travels in Polarization.
+    float RingRadiusCm = 0.0f;
+    int32 LobeCount = 0;
+
     // Conversion from typed effectors
     static FRshipFieldEffectorDesc FromWave(const FRshipFieldWaveEffector& Wave);
     static FRshipFieldEffectorDesc FromNoise(const FRshipFieldNoiseEffector& Noise);
     static FRshipFieldEffectorDesc FromAttractor(const FRshipFieldAttractorEffector& Attractor);
+    // Offsets and the closed-loop wavelength are filled in once the path is known.
+    static FRshipFieldEffectorDesc FromSpline(const FRshipFieldSplineEffector& Spline);
+    static FRshipFieldEffectorDesc FromRing(const FRshipFieldRingEffector& Ring);
 };
 
 // ============================================================================
@@ -316,6 +554,60 @@ struct RSHIPFIELD_API FRshipFieldSyncGroup
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
     float PhaseOffset = 0.0f;
+
+    // Transport the group follows, by Id. Empty follows the field's own Bpm and BeatPhase.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    FString Transport;
+};
+
+// An independent transport clock that sync groups can follow, for polyrhythms and sections
+// at different tempi.
+USTRUCT(BlueprintType)
+struct RSHIPFIELD_API FRshipFieldTransport
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    FString Id;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field", meta = (ClampMin = "1.0"))
+    float Bpm = 120.0f;
+
+    // Position in beats. Advanced every step; writing it locates the transport there.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    float BeatPhase = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    bool bPlaying = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    ERshipFieldClockSource ClockSource = ERshipFieldClockSource::Internal;
+
+    // How long an external transport keeps running without a report before it holds.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field", meta = (ClampMin = "0.0", EditCondition = "ClockSource == ERshipFieldClockSource::External"))
+    float ExternalTimeoutSeconds = 0.5f;
+
+    // Position reports received through URshipFieldComponent::SyncTransport.
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Rship|Field", AdvancedDisplay)
+    int32 SyncCount = 0;
+};
+
+// A named point whose field value the field component publishes to rship.
+USTRUCT(BlueprintType)
+struct RSHIPFIELD_API FRshipFieldProbe
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    FString Name;
+
+    // Actor whose location is sampled. Takes precedence over PositionCm.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    TSoftObjectPtr<AActor> Actor;
+
+    // World-space position used when there is no actor.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rship|Field")
+    FVector PositionCm = FVector::ZeroVector;
 };
 
 // ============================================================================